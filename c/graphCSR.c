@@ -0,0 +1,408 @@
+/*
+Planarity-Related Graph Algorithms Project
+Copyright (c) 1997-2012, John M. Boyer
+All rights reserved. Includes a reference implementation of the following:
+
+* John M. Boyer. "Subgraph Homeomorphism via the Edge Addition Planarity Algorithm".
+  Journal of Graph Algorithms and Applications, Vol. 16, no. 2, pp. 381-410, 2012.
+  http://www.jgaa.info/16/268.html
+
+* John M. Boyer. "A New Method for Efficiently Generating Planar Graph
+  Visibility Representations". In P. Eades and P. Healy, editors,
+  Proceedings of the 13th International Conference on Graph Drawing 2005,
+  Lecture Notes Comput. Sci., Volume 3843, pp. 508-511, Springer-Verlag, 2006.
+
+* John M. Boyer and Wendy J. Myrvold. "On the Cutting Edge: Simplified O(n)
+  Planarity by Edge Addition". Journal of Graph Algorithms and Applications,
+  Vol. 8, No. 3, pp. 241-273, 2004.
+  http://www.jgaa.info/08/91.html
+
+* John M. Boyer. "Simplified O(n) Algorithms for Planar Graph Embedding,
+  Kuratowski Subgraph Isolation, and Related Problems". Ph.D. Dissertation,
+  University of Victoria, 2001.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+  list of conditions and the following disclaimer in the documentation and/or
+  other materials provided with the distribution.
+
+* Neither the name of the Planarity-Related Graph Algorithms Project nor the names
+  of its contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdlib.h>
+
+#include "graph.h"
+
+/* Private functions */
+
+int  _EnsureCSRCapacity(int **pArray, int *pCapacity, int requiredCapacity);
+int  _PairCSREntries(int N, int *offsets, int *neighbors, int *entryArc, int firstArc);
+
+/********************************************************************
+ gp_NewCSR()
+
+ Returns a new, empty compressed sparse row structure, or NULL on
+ allocation failure
+ ********************************************************************/
+
+adjacencyCSRP gp_NewCSR(void)
+{
+     adjacencyCSRP theCSR = (adjacencyCSRP) malloc(sizeof(adjacencyCSR));
+
+     if (theCSR != NULL)
+     {
+         theCSR->N = theCSR->numArcs = 0;
+         theCSR->offsets = theCSR->neighbors = theCSR->arcs = NULL;
+         theCSR->offsetsCapacity = theCSR->neighborsCapacity = theCSR->arcsCapacity = 0;
+     }
+
+     return theCSR;
+}
+
+/********************************************************************
+ gp_FreeCSR()
+
+ Frees the compressed sparse row structure and sets the pointer to it
+ to NULL
+ ********************************************************************/
+
+void gp_FreeCSR(adjacencyCSRP *pCSR)
+{
+     if (pCSR == NULL || *pCSR == NULL)
+         return;
+
+     if ((*pCSR)->offsets != NULL)
+         free((*pCSR)->offsets);
+     if ((*pCSR)->neighbors != NULL)
+         free((*pCSR)->neighbors);
+     if ((*pCSR)->arcs != NULL)
+         free((*pCSR)->arcs);
+
+     free(*pCSR);
+     *pCSR = NULL;
+}
+
+/********************************************************************
+ _EnsureCSRCapacity()
+
+ Grows one of the arrays of a compressed sparse row structure to at
+ least the required capacity.  The contents are not preserved since
+ every array is fully rewritten by gp_ExportCSR().
+
+ Returns OK on success, NOTOK on allocation failure
+ ********************************************************************/
+
+int  _EnsureCSRCapacity(int **pArray, int *pCapacity, int requiredCapacity)
+{
+     if (*pCapacity >= requiredCapacity && *pArray != NULL)
+         return OK;
+
+     if (*pArray != NULL)
+         free(*pArray);
+
+     *pArray = (int *) malloc((requiredCapacity > 0 ? requiredCapacity : 1) * sizeof(int));
+     *pCapacity = *pArray == NULL ? 0 : requiredCapacity;
+
+     return *pArray == NULL ? NOTOK : OK;
+}
+
+/********************************************************************
+ gp_ExportCSR()
+
+ Copies the adjacency lists of theGraph into theCSR, one row per vertex,
+ with the entries of each row in adjacency list order.  For an embedding,
+ such as results when gp_Embed() returns OK, each row is therefore the
+ rotation at its vertex.  theCSR->arcs gives the arc behind each entry,
+ so callers can index edge data of theGraph from a row entry.
+
+ If flags includes CSR_ORIGINALLABELS and theGraph is sorted by DFI, as
+ after gp_Embed(), then the rows and neighbors are given by the original
+ vertex numbering, as gp_SortVertices() would restore it, without
+ modifying theGraph.  Otherwise, they are given by the current one.
+
+ Without relabeling, the rows are filled in vertex order in one pass
+ over the adjacency lists.  With it, a first pass obtains the degrees.
+
+ Returns OK on success, NOTOK on allocation failure
+ ********************************************************************/
+
+int  gp_ExportCSR(graphP theGraph, int flags, adjacencyCSRP theCSR)
+{
+int  N, first, relabel, v, r, e, k, bound;
+int  *offsets, *neighbors, *arcs;
+
+     if (theGraph == NULL || theCSR == NULL)
+         return NOTOK;
+
+     N = theGraph->N;
+     first = gp_GetFirstVertex(theGraph);
+     relabel = (flags & CSR_ORIGINALLABELS) && (theGraph->internalFlags & FLAGS_SORTEDBYDFI);
+
+     // Every entry is an arc in use, so the arcs in use bound the entries
+     bound = gp_EdgeInUseIndexBound(theGraph) - gp_GetFirstEdge(theGraph);
+     if (_EnsureCSRCapacity(&theCSR->offsets, &theCSR->offsetsCapacity, N+1) != OK ||
+         _EnsureCSRCapacity(&theCSR->neighbors, &theCSR->neighborsCapacity, bound) != OK ||
+         _EnsureCSRCapacity(&theCSR->arcs, &theCSR->arcsCapacity, bound) != OK)
+         return NOTOK;
+
+     offsets = theCSR->offsets;
+     neighbors = theCSR->neighbors;
+     arcs = theCSR->arcs;
+
+     if (relabel)
+     {
+         offsets[0] = 0;
+         for (v = first; gp_VertexInRange(theGraph, v); v++)
+              offsets[gp_GetVertexIndex(theGraph, v) - first + 1] = gp_GetVertexDegree(theGraph, v);
+         for (r = 0; r < N; r++)
+              offsets[r+1] += offsets[r];
+
+         for (v = first; gp_VertexInRange(theGraph, v); v++)
+         {
+              k = offsets[gp_GetVertexIndex(theGraph, v) - first];
+              e = gp_GetFirstArc(theGraph, v);
+              while (gp_IsArc(e))
+              {
+                  neighbors[k] = gp_GetVertexIndex(theGraph, gp_GetNeighbor(theGraph, e)) - first;
+                  arcs[k++] = e;
+                  e = gp_GetNextArc(theGraph, e);
+              }
+         }
+     }
+     else
+     {
+         for (v = first, k = 0; gp_VertexInRange(theGraph, v); v++)
+         {
+              offsets[v - first] = k;
+              e = gp_GetFirstArc(theGraph, v);
+              while (gp_IsArc(e))
+              {
+                  neighbors[k] = gp_GetNeighbor(theGraph, e) - first;
+                  arcs[k++] = e;
+                  e = gp_GetNextArc(theGraph, e);
+              }
+         }
+         offsets[N] = k;
+     }
+
+     theCSR->N = N;
+     theCSR->numArcs = offsets[N];
+
+     return OK;
+}
+
+/********************************************************************
+ gp_InitGraphFromCSR()
+
+ Initializes theGraph with N vertices and the adjacency lists given in
+ compressed sparse row form, as produced by gp_ExportCSR(): row r, the
+ entries from offsets[r] to offsets[r+1]-1 of neighbors, becomes the
+ adjacency list of vertex gp_GetFirstVertex() + r, in the same order.
+ So, exporting and importing an embedding preserves its rotations.
+ theGraph must be a new graph as from gp_New(), possibly with extensions
+ attached, that has not been initialized.
+
+ Each edge (u, v) must appear once in row u and once in row v; the k-th
+ entry for v in row u is paired with the k-th entry for u in row v, and a
+ self-loop must appear twice in its row.  Rather than making M calls to
+ gp_AddEdge(), the entries are paired by bucketing them, and then a
+ single pass over the entries sets each arc and links each list.  Edge k
+ is arcs gp_GetFirstEdge() + 2k and its twin, with the edges numbered in
+ the order of their first entries.
+
+ Returns OK on success, NOTOK on allocation failure or if the rows are
+         not the adjacency lists of an undirected graph
+ ********************************************************************/
+
+int  gp_InitGraphFromCSR(graphP theGraph, int N, int *offsets, int *neighbors)
+{
+int  numArcs, first, r, i, e, end, Result = OK;
+int  *entryArc = NULL;
+
+     if (theGraph == NULL || offsets == NULL || N <= 0 || theGraph->N != 0 || offsets[0] != 0)
+         return NOTOK;
+
+     for (r = 0; r < N; r++)
+          if (offsets[r+1] < offsets[r])
+              return NOTOK;
+
+     numArcs = offsets[N];
+     if (numArcs > 0 && neighbors == NULL)
+         return NOTOK;
+
+     for (i = 0; i < numArcs; i++)
+          if (neighbors[i] < 0 || neighbors[i] >= N)
+              return NOTOK;
+
+     if (numArcs % 2 != 0 ||
+         gp_InitGraph(theGraph, N) != OK ||
+         (numArcs > 0 && gp_EnsureArcCapacity(theGraph, numArcs) != OK) ||
+         (entryArc = (int *) malloc((numArcs+1) * sizeof(int))) == NULL)
+         Result = NOTOK;
+
+     if (Result == OK)
+         Result = _PairCSREntries(N, offsets, neighbors, entryArc, gp_GetFirstEdge(theGraph));
+
+     // Set the neighbor of each arc and link the arcs of each row in order
+     if (Result == OK)
+     {
+         first = gp_GetFirstVertex(theGraph);
+         for (r = 0; r < N; r++)
+         {
+              end = offsets[r+1];
+              if (offsets[r] == end)
+                  continue;
+
+              gp_SetFirstArc(theGraph, first + r, entryArc[offsets[r]]);
+              gp_SetLastArc(theGraph, first + r, entryArc[end-1]);
+              for (i = offsets[r]; i < end; i++)
+              {
+                   e = entryArc[i];
+                   gp_SetNeighbor(theGraph, e, first + neighbors[i]);
+                   gp_SetPrevArc(theGraph, e, i > offsets[r] ? entryArc[i-1] : NIL);
+                   gp_SetNextArc(theGraph, e, i+1 < end ? entryArc[i+1] : NIL);
+              }
+         }
+
+         theGraph->M = numArcs / 2;
+     }
+
+     if (entryArc != NULL)
+         free(entryArc);
+
+     return Result;
+}
+
+/********************************************************************
+ _PairCSREntries()
+
+ Pairs the entries of the rows into edges and gives each entry its arc.
+ The edges are numbered in the order of their entries in the lesser of
+ their two rows, and these entries are bucketed by the greater row, in
+ which their order is by lesser row.  So, for each row v, marking the
+ first bucket entry for each lesser vertex u lets each entry for u in
+ row v take the next bucket entry for u, pairing the k-th entry for v
+ in row u with the k-th entry for u in row v.  The two entries for a
+ self-loop are consecutive among the entries for the vertex in its row.
+
+ Returns OK on success, NOTOK on allocation failure or unpaired entries
+ ********************************************************************/
+
+int  _PairCSREntries(int N, int *offsets, int *neighbors, int *entryArc, int firstArc)
+{
+int  numArcs = offsets[N], r, v, u, i, pos, end, pending, numMatched, numEdges = 0, Result = OK;
+int  *bucketStart = NULL, *bucketRow = NULL, *bucketArc = NULL, *mark = NULL;
+
+     if ((bucketStart = (int *) calloc(N+1, sizeof(int))) == NULL ||
+         (bucketRow = (int *) malloc((numArcs/2+1) * sizeof(int))) == NULL ||
+         (bucketArc = (int *) malloc((numArcs/2+1) * sizeof(int))) == NULL ||
+         (mark = (int *) malloc((N+1) * sizeof(int))) == NULL)
+         Result = NOTOK;
+
+     // Number the edges in the lesser row and bucket them by greater row
+     if (Result == OK)
+     {
+         for (r = 0; r < N; r++)
+              for (i = offsets[r]; i < offsets[r+1]; i++)
+                   if (neighbors[i] > r)
+                       bucketStart[neighbors[i]+1]++;
+         for (v = 0; v < N; v++)
+              bucketStart[v+1] += bucketStart[v];
+
+         for (r = 0; r < N && Result == OK; r++)
+         {
+              pending = -1;
+              for (i = offsets[r]; i < offsets[r+1]; i++)
+              {
+                   v = neighbors[i];
+                   if (v > r)
+                   {
+                       entryArc[i] = firstArc + 2*numEdges++;
+                       bucketRow[bucketStart[v]] = r;
+                       bucketArc[bucketStart[v]++] = entryArc[i];
+                   }
+                   else if (v == r)
+                   {
+                       if (pending < 0)
+                           pending = i;
+                       else
+                       {
+                           entryArc[pending] = firstArc + 2*numEdges;
+                           entryArc[i] = firstArc + 2*numEdges++ + 1;
+                           pending = -1;
+                       }
+                   }
+              }
+              if (pending >= 0)
+                  Result = NOTOK;
+         }
+
+         // The filling advanced each start to the next one
+         for (v = N; v > 0; v--)
+              bucketStart[v] = bucketStart[v-1];
+         bucketStart[0] = 0;
+     }
+
+     // Match the entries for lesser vertices in each row to its bucket
+     if (Result == OK)
+     {
+         for (u = 0; u < N; u++)
+              mark[u] = -1;
+
+         for (v = 0; v < N && Result == OK; v++)
+         {
+              end = bucketStart[v+1];
+              for (pos = end - 1; pos >= bucketStart[v]; pos--)
+                   mark[bucketRow[pos]] = pos;
+
+              numMatched = 0;
+              for (i = offsets[v]; i < offsets[v+1] && Result == OK; i++)
+              {
+                   u = neighbors[i];
+                   if (u >= v)
+                       continue;
+
+                   pos = mark[u];
+                   if (pos < 0 || pos >= end || bucketRow[pos] != u)
+                       Result = NOTOK;
+                   else
+                   {
+                       entryArc[i] = bucketArc[pos] ^ 1;
+                       mark[u] = pos + 1;
+                       numMatched++;
+                   }
+              }
+
+              if (numMatched != end - bucketStart[v])
+                  Result = NOTOK;
+
+              for (pos = bucketStart[v]; pos < end; pos++)
+                   mark[bucketRow[pos]] = -1;
+         }
+     }
+
+     if (bucketStart != NULL) free(bucketStart);
+     if (bucketRow != NULL) free(bucketRow);
+     if (bucketArc != NULL) free(bucketArc);
+     if (mark != NULL) free(mark);
+
+     return Result;
+}
@@ -0,0 +1,767 @@
+/*
+Planarity-Related Graph Algorithms Project
+Copyright (c) 1997-2012, John M. Boyer
+All rights reserved. Includes a reference implementation of the following:
+
+* John M. Boyer. "Subgraph Homeomorphism via the Edge Addition Planarity Algorithm".
+  Journal of Graph Algorithms and Applications, Vol. 16, no. 2, pp. 381-410, 2012.
+  http://www.jgaa.info/16/268.html
+
+* John M. Boyer. "A New Method for Efficiently Generating Planar Graph
+  Visibility Representations". In P. Eades and P. Healy, editors,
+  Proceedings of the 13th International Conference on Graph Drawing 2005,
+  Lecture Notes Comput. Sci., Volume 3843, pp. 508-511, Springer-Verlag, 2006.
+
+* John M. Boyer and Wendy J. Myrvold. "On the Cutting Edge: Simplified O(n)
+  Planarity by Edge Addition". Journal of Graph Algorithms and Applications,
+  Vol. 8, No. 3, pp. 241-273, 2004.
+  http://www.jgaa.info/08/91.html
+
+* John M. Boyer. "Simplified O(n) Algorithms for Planar Graph Embedding,
+  Kuratowski Subgraph Isolation, and Related Problems". Ph.D. Dissertation,
+  University of Victoria, 2001.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+  list of conditions and the following disclaimer in the documentation and/or
+  other materials provided with the distribution.
+
+* Neither the name of the Planarity-Related Graph Algorithms Project nor the names
+  of its contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "graph.h"
+
+/* Private definitions */
+
+// The symbols of the contour walk of a spanning forest, two bits each.
+// DOWN and UP step along a tree edge, from the virtual root of the forest
+// to the root of each connected component, or from a vertex to its child.
+// OPEN and CLOSE give the first and second ends of an edge not in the
+// forest, which nest like parentheses if and only if the embedding is
+// planar.
+#define CE_DOWN     0
+#define CE_UP       1
+#define CE_OPEN     2
+#define CE_CLOSE    3
+
+// The most bytes in a variable length integer of 32 bits
+#define CE_MAXVARINT    5
+
+/* Private functions */
+
+int  _CE_EnsureCapacity(compressedEmbeddingP theCode, int requiredCapacity);
+int  _CE_PutVarint(compressedEmbeddingP theCode, unsigned int x);
+int  _CE_GetVarint(unsigned char *bytes, int length, int *pPos, int *pValue);
+int  _CE_ReadVarint(FILE *Infile, compressedEmbeddingP theCode, int *pValue);
+int  _CE_LabelWidth(int N);
+int  _CE_PayloadLength(int N, int M, int C, int flags);
+int  _CE_WalkContour(graphP theGraph, unsigned char *symbols, int *order, int *pC);
+void _CE_PutSymbol(unsigned char *symbols, int index, int symbol);
+int  _CE_GetSymbol(unsigned char *symbols, int index);
+
+/********************************************************************
+ gp_NewCompressedEmbedding()
+
+ Returns a new, empty compressed embedding container, or NULL on
+ allocation failure
+ ********************************************************************/
+
+compressedEmbeddingP gp_NewCompressedEmbedding(void)
+{
+     compressedEmbeddingP theCode = (compressedEmbeddingP) malloc(sizeof(compressedEmbedding));
+
+     if (theCode != NULL)
+     {
+         theCode->bytes = NULL;
+         theCode->length = theCode->capacity = 0;
+     }
+
+     return theCode;
+}
+
+/********************************************************************
+ gp_FreeCompressedEmbedding()
+
+ Frees the compressed embedding container and sets the pointer to it
+ to NULL
+ ********************************************************************/
+
+void gp_FreeCompressedEmbedding(compressedEmbeddingP *pCode)
+{
+     if (pCode == NULL || *pCode == NULL)
+         return;
+
+     if ((*pCode)->bytes != NULL)
+         free((*pCode)->bytes);
+
+     free(*pCode);
+     *pCode = NULL;
+}
+
+/********************************************************************
+ _CE_EnsureCapacity()
+
+ Grows the container, at least doubling it, so that it can hold
+ requiredCapacity bytes.
+
+ Returns OK on success, NOTOK on allocation failure
+ ********************************************************************/
+
+int  _CE_EnsureCapacity(compressedEmbeddingP theCode, int requiredCapacity)
+{
+     unsigned char *newBytes;
+     int newCapacity;
+
+     if (theCode->capacity >= requiredCapacity)
+         return OK;
+
+     newCapacity = 2*theCode->capacity > requiredCapacity ? 2*theCode->capacity : requiredCapacity;
+     if ((newBytes = (unsigned char *) realloc(theCode->bytes, newCapacity)) == NULL)
+         return NOTOK;
+
+     theCode->bytes = newBytes;
+     theCode->capacity = newCapacity;
+     return OK;
+}
+
+/********************************************************************
+ _CE_PutVarint()
+
+ Appends x as a variable length integer of seven bits per byte, least
+ significant first, with the high bit set on all but the last byte.
+
+ Returns OK on success, NOTOK on allocation failure
+ ********************************************************************/
+
+int  _CE_PutVarint(compressedEmbeddingP theCode, unsigned int x)
+{
+     if (_CE_EnsureCapacity(theCode, theCode->length + CE_MAXVARINT) != OK)
+         return NOTOK;
+
+     do {
+          theCode->bytes[theCode->length++] = (unsigned char) ((x & 0x7f) | (x > 0x7f ? 0x80 : 0));
+          x >>= 7;
+     } while (x > 0);
+
+     return OK;
+}
+
+/********************************************************************
+ _CE_GetVarint()
+
+ Reads a variable length integer from bytes at *pPos, advancing *pPos.
+
+ Returns OK on success, NOTOK if the integer runs past the end of the
+         bytes or does not fit in a non-negative int
+ ********************************************************************/
+
+int  _CE_GetVarint(unsigned char *bytes, int length, int *pPos, int *pValue)
+{
+     unsigned int x = 0;
+     int shift = 0;
+
+     do {
+          if (*pPos >= length || shift >= 7*CE_MAXVARINT)
+              return NOTOK;
+          x |= (unsigned int) (bytes[*pPos] & 0x7f) << shift;
+          shift += 7;
+     } while (bytes[(*pPos)++] & 0x80);
+
+     if (x > 0x7fffffffu)
+         return NOTOK;
+
+     *pValue = (int) x;
+     return OK;
+}
+
+/********************************************************************
+ _CE_LabelWidth()
+
+ Returns the number of bits needed to store a vertex label from 0 to N-1
+ ********************************************************************/
+
+int  _CE_LabelWidth(int N)
+{
+     int width = 0;
+
+     while (width < 31 && (N-1) >> width)
+         width++;
+
+     return width;
+}
+
+/********************************************************************
+ _CE_PayloadLength()
+
+ Returns the number of bytes that follow the header of a compressed
+ embedding with N vertices, M edges and C connected components: two bits
+ per symbol of the contour walk, then the vertex labels if they are kept.
+ ********************************************************************/
+
+int  _CE_PayloadLength(int N, int M, int C, int flags)
+{
+     int length = (2*(M+C) + 3) / 4;
+
+     if (flags & COMPRESS_KEEPLABELS)
+         length += (int) (((long) N * _CE_LabelWidth(N) + 7) / 8);
+
+     return length;
+}
+
+/********************************************************************
+ _CE_WalkContour()
+
+ Walks around a depth first spanning forest of the embedding of
+ theGraph, visiting the arcs around each vertex in the order of its
+ adjacency list, starting after the arc to its parent.  The symbols of
+ the walk are written two bits per symbol, first symbol in the low bits
+ of the first byte, and order receives the vertices in the order they
+ are reached.  The connected components are counted in *pC.
+
+ Each edge not in the forest is seen twice.  The embedding is planar
+ if and only if these edges nest like parentheses, so each second end
+ must close the most recently opened edge that is still open.
+
+ Returns OK on success, NONEMBEDDABLE if the embedding is not planar,
+         NOTOK on allocation failure
+ ********************************************************************/
+
+int  _CE_WalkContour(graphP theGraph, unsigned char *symbols, int *order, int *pC)
+{
+     int N = theGraph->N, first = gp_GetFirstVertex(theGraph), numSymbols = 0, numReached = 0;
+     int *reached = NULL, *frameArc = NULL, *frameStop = NULL, *openEdges = NULL;
+     unsigned char *edgeState = NULL;
+     int depth, numOpen = 0, r, w, a, next, Result = OK;
+
+     if ((reached = (int *) calloc(N + first, sizeof(int))) == NULL ||
+         (frameArc = (int *) malloc((N+1) * sizeof(int))) == NULL ||
+         (frameStop = (int *) malloc((N+1) * sizeof(int))) == NULL ||
+         (openEdges = (int *) malloc((theGraph->M+1) * sizeof(int))) == NULL ||
+         (edgeState = (unsigned char *) calloc(gp_EdgeIndexBound(theGraph)/2 + 1, 1)) == NULL)
+         Result = NOTOK;
+
+     *pC = 0;
+     for (r = first; r < first + N && Result == OK; r++)
+     {
+          if (reached[r])
+              continue;
+
+          // Step down from the virtual root to the root of the component
+          (*pC)++;
+          _CE_PutSymbol(symbols, numSymbols++, CE_DOWN);
+          reached[r] = TRUE;
+          order[numReached++] = r;
+          frameArc[0] = frameStop[0] = gp_GetFirstArc(theGraph, r);
+          depth = 1;
+
+          while (depth > 0 && Result == OK)
+          {
+               if (!gp_IsArc(a = frameArc[depth-1]))
+               {
+                   _CE_PutSymbol(symbols, numSymbols++, CE_UP);
+                   depth--;
+                   continue;
+               }
+
+               next = gp_GetNextArcCircular(theGraph, a);
+               frameArc[depth-1] = next == frameStop[depth-1] ? NIL : next;
+               w = gp_GetNeighbor(theGraph, a);
+
+               if (edgeState[a >> 1] == 0 && !reached[w])
+               {
+                   // Step down a tree edge to a child, whose walk starts
+                   // after the arc back to its parent
+                   _CE_PutSymbol(symbols, numSymbols++, CE_DOWN);
+                   edgeState[a >> 1] = 2;
+                   reached[w] = TRUE;
+                   order[numReached++] = w;
+                   a = gp_GetTwinArc(theGraph, a);
+                   next = gp_GetNextArcCircular(theGraph, a);
+                   frameArc[depth] = next == a ? NIL : next;
+                   frameStop[depth] = a;
+                   depth++;
+               }
+               else if (edgeState[a >> 1] == 0)
+               {
+                   _CE_PutSymbol(symbols, numSymbols++, CE_OPEN);
+                   edgeState[a >> 1] = 1;
+                   openEdges[numOpen++] = a >> 1;
+               }
+               else if (edgeState[a >> 1] == 1 && openEdges[numOpen-1] == (a >> 1))
+               {
+                   _CE_PutSymbol(symbols, numSymbols++, CE_CLOSE);
+                   edgeState[a >> 1] = 2;
+                   numOpen--;
+               }
+               else Result = NONEMBEDDABLE;
+          }
+     }
+
+     if (reached != NULL) free(reached);
+     if (frameArc != NULL) free(frameArc);
+     if (frameStop != NULL) free(frameStop);
+     if (openEdges != NULL) free(openEdges);
+     if (edgeState != NULL) free(edgeState);
+
+     return Result;
+}
+
+/********************************************************************
+ _CE_PutSymbol(), _CE_GetSymbol()
+
+ Write and read the symbol of the given index, two bits per symbol and
+ first symbol in the low bits of the first byte.  The symbols must be
+ zeroed before they are written.
+ ********************************************************************/
+
+void _CE_PutSymbol(unsigned char *symbols, int index, int symbol)
+{
+     symbols[index >> 2] |= (unsigned char) (symbol << (2 * (index & 3)));
+}
+
+int  _CE_GetSymbol(unsigned char *symbols, int index)
+{
+     return (symbols[index >> 2] >> (2 * (index & 3))) & 3;
+}
+
+/********************************************************************
+ gp_CompressEmbedding()
+
+ Appends to theCode a compressed form of the embedding of theGraph, as
+ obtained by gp_Embed() with a planar or outerplanar result, so that a
+ container can hold any number of embeddings one after another.  Set
+ theCode->length to 0 beforehand to start a new container.
+
+ The compressed form is the contour walk of a depth first spanning
+ forest of the embedding, which takes two bits for each end of each
+ edge, or four bits per edge, plus four bits per connected component.
+ It is preceded by a header giving N, M, the number of connected
+ components, the flags and the embedFlags of theGraph.
+
+ The walk numbers the vertices in the order it reaches them.  If flags
+ includes COMPRESS_KEEPLABELS, then the vertex labels of theGraph are
+ also stored, using the fewest bits that hold a label from 0 to N-1,
+ so that the decompressed graph has the same vertex numbering.  As with
+ gp_Write(), the labels are the current vertex numbers, so invoke
+ gp_SortVertices() after gp_Embed() to keep the input numbering.
+ Otherwise, the decompressed graph is numbered in walk order.
+
+ The adjacency list of each vertex is the rotation of the embedding, so
+ the decompressed graph has the same rotation at each vertex, although
+ the arc that is first in each adjacency list can differ.
+
+ Returns OK on success, NONEMBEDDABLE if the adjacency lists of theGraph
+         are not a planar embedding, NOTOK on allocation failure or
+         invalid input
+ ********************************************************************/
+
+int  gp_CompressEmbedding(graphP theGraph, int flags, compressedEmbeddingP theCode)
+{
+     int N, M, C, numBytes, width, k, label, bit, start, Result = OK;
+     unsigned char *symbols = NULL;
+     int *order = NULL;
+
+     if (theGraph == NULL || theCode == NULL || theGraph->N <= 0)
+         return NOTOK;
+
+     N = theGraph->N;
+     M = theGraph->M;
+     start = theCode->length;
+
+     // The number of components is at most N
+     numBytes = (2*(M+N) + 3) / 4;
+     if ((symbols = (unsigned char *) calloc(numBytes + 1, 1)) == NULL ||
+         (order = (int *) malloc((N+1) * sizeof(int))) == NULL)
+         Result = NOTOK;
+
+     if (Result == OK)
+         Result = _CE_WalkContour(theGraph, symbols, order, &C);
+
+     if (Result == OK)
+     {
+         if (_CE_PutVarint(theCode, N) != OK ||
+             _CE_PutVarint(theCode, M) != OK ||
+             _CE_PutVarint(theCode, C) != OK ||
+             _CE_PutVarint(theCode, flags & COMPRESS_KEEPLABELS) != OK ||
+             _CE_PutVarint(theCode, theGraph->embedFlags) != OK ||
+             _CE_EnsureCapacity(theCode, theCode->length + _CE_PayloadLength(N, M, C, flags)) != OK)
+             Result = NOTOK;
+     }
+
+     if (Result == OK)
+     {
+         numBytes = (2*(M+C) + 3) / 4;
+         memcpy(theCode->bytes + theCode->length, symbols, numBytes);
+         theCode->length += numBytes;
+
+         if (flags & COMPRESS_KEEPLABELS)
+         {
+             width = _CE_LabelWidth(N);
+             numBytes = (int) (((long) N * width + 7) / 8);
+             memset(theCode->bytes + theCode->length, 0, numBytes);
+             for (k = 0, bit = 0; k < N; k++)
+             {
+                  label = order[k] - gp_GetFirstVertex(theGraph);
+                  for (bit = k * width; bit < (k+1) * width; bit++, label >>= 1)
+                       theCode->bytes[theCode->length + (bit >> 3)] |= (unsigned char) ((label & 1) << (bit & 7));
+             }
+             theCode->length += numBytes;
+         }
+     }
+
+     // Leave the container as it was if the embedding was not appended
+     if (Result != OK)
+         theCode->length = start;
+
+     if (symbols != NULL)
+         free(symbols);
+     if (order != NULL)
+         free(order);
+     return Result;
+}
+
+/********************************************************************
+ gp_DecompressEmbedding()
+
+ Decompresses the embedding that starts at byte *pOffset of theCode into
+ theGraph, which must be a new graph as from gp_New(), possibly with
+ extensions attached, that has not been initialized.  Advances *pOffset
+ to the next embedding in theCode.
+
+ The adjacency lists of theGraph are built directly in the order of the
+ rotation at each vertex, so theGraph is ready for use as an embedding,
+ for example by gp_GetFaces(), without running gp_Embed().  Its
+ embedFlags are those of the graph that was compressed, and the DFS
+ parent of each vertex is set from the spanning forest of the walk.
+
+ Returns OK on success, NOTOK on allocation failure or if theCode does
+         not hold a valid compressed embedding at *pOffset
+ ********************************************************************/
+
+int  gp_DecompressEmbedding(graphP theGraph, compressedEmbeddingP theCode, int *pOffset)
+{
+     int N, M, C, flags, embedFlags, pos, numSymbols, width, s, k, v, w, bit, label, arc, Result = OK;
+     int depth = 0, numOpen = 0, numReached = 0, numEdges = 0, numEvents = 0;
+     int *edgeU = NULL, *edgeV = NULL, *eventVertex = NULL, *eventArc = NULL;
+     int *path = NULL, *openEdges = NULL, *vertexOf = NULL, *start = NULL, *rotation = NULL;
+     int *parent = NULL;
+     unsigned char *symbols;
+
+     if (theGraph == NULL || theCode == NULL || pOffset == NULL || theGraph->N != 0)
+         return NOTOK;
+
+     pos = *pOffset;
+     if (_CE_GetVarint(theCode->bytes, theCode->length, &pos, &N) != OK ||
+         _CE_GetVarint(theCode->bytes, theCode->length, &pos, &M) != OK ||
+         _CE_GetVarint(theCode->bytes, theCode->length, &pos, &C) != OK ||
+         _CE_GetVarint(theCode->bytes, theCode->length, &pos, &flags) != OK ||
+         _CE_GetVarint(theCode->bytes, theCode->length, &pos, &embedFlags) != OK ||
+         N <= 0 || C <= 0 || C > N || M > 0x3fffffff - C ||
+         theCode->length - pos < _CE_PayloadLength(N, M, C, flags))
+         return NOTOK;
+
+     symbols = theCode->bytes + pos;
+     numSymbols = 2*(M+C);
+
+     if ((M > 0 && gp_EnsureArcCapacity(theGraph, 2*M) != OK) ||
+         gp_InitGraph(theGraph, N) != OK ||
+         (edgeU = (int *) malloc((M+1) * sizeof(int))) == NULL ||
+         (edgeV = (int *) malloc((M+1) * sizeof(int))) == NULL ||
+         (eventVertex = (int *) malloc((2*M+1) * sizeof(int))) == NULL ||
+         (eventArc = (int *) malloc((2*M+1) * sizeof(int))) == NULL ||
+         (rotation = (int *) malloc((2*M+1) * sizeof(int))) == NULL ||
+         (path = (int *) malloc((N+1) * sizeof(int))) == NULL ||
+         (openEdges = (int *) malloc((M+1) * sizeof(int))) == NULL ||
+         (vertexOf = (int *) malloc((N+1) * sizeof(int))) == NULL ||
+         (parent = (int *) malloc((N+1) * sizeof(int))) == NULL ||
+         (start = (int *) calloc(N+2, sizeof(int))) == NULL)
+         Result = NOTOK;
+
+     // Replay the walk, numbering the vertices 0 to N-1 in the order they
+     // are reached.  The end of edge k at the vertex where the walk first
+     // meets it is its first arc in the graph, and the other its twin.
+     for (s = 0; s < numSymbols && Result == OK; s++)
+     {
+          switch (_CE_GetSymbol(symbols, s))
+          {
+              case CE_DOWN :
+                  if (numReached >= N)
+                  {
+                      Result = NOTOK;
+                      break;
+                  }
+                  w = numReached++;
+                  parent[w] = depth > 0 ? path[depth-1] : -1;
+                  if (depth > 0)
+                  {
+                      if (numEdges >= M)
+                      {
+                          Result = NOTOK;
+                          break;
+                      }
+                      k = numEdges++;
+                      edgeU[k] = path[depth-1];
+                      edgeV[k] = w;
+                      eventVertex[numEvents] = edgeU[k];
+                      eventArc[numEvents++] = 2*k;
+                      eventVertex[numEvents] = w;
+                      eventArc[numEvents++] = 2*k+1;
+                  }
+                  path[depth++] = w;
+                  break;
+
+              case CE_UP :
+                  if (depth == 0)
+                      Result = NOTOK;
+                  else depth--;
+                  break;
+
+              case CE_OPEN :
+                  if (depth == 0 || numEdges >= M)
+                  {
+                      Result = NOTOK;
+                      break;
+                  }
+                  k = numEdges++;
+                  edgeU[k] = path[depth-1];
+                  openEdges[numOpen++] = k;
+                  eventVertex[numEvents] = edgeU[k];
+                  eventArc[numEvents++] = 2*k;
+                  break;
+
+              case CE_CLOSE :
+                  if (depth == 0 || numOpen == 0)
+                  {
+                      Result = NOTOK;
+                      break;
+                  }
+                  k = openEdges[--numOpen];
+                  edgeV[k] = path[depth-1];
+                  eventVertex[numEvents] = edgeV[k];
+                  eventArc[numEvents++] = 2*k+1;
+                  break;
+          }
+     }
+
+     if (Result == OK && (numReached != N || numEdges != M || depth != 0 || numOpen != 0))
+         Result = NOTOK;
+
+     // Give each reached vertex its label, checking that the labels are
+     // a permutation
+     if (Result == OK)
+     {
+         pos += (numSymbols + 3) / 4;
+         if (flags & COMPRESS_KEEPLABELS)
+         {
+             width = _CE_LabelWidth(N);
+             for (v = 0; v < N; v++)
+                  path[v] = 0;
+             for (k = 0; k < N && Result == OK; k++)
+             {
+                  for (bit = (k+1) * width - 1, label = 0; bit >= k * width; bit--)
+                       label = (label << 1) | ((theCode->bytes[pos + (bit >> 3)] >> (bit & 7)) & 1);
+                  if (label >= N || path[label])
+                      Result = NOTOK;
+                  else
+                  {
+                      path[label] = 1;
+                      vertexOf[k] = gp_GetFirstVertex(theGraph) + label;
+                  }
+             }
+             pos += (int) (((long) N * width + 7) / 8);
+         }
+         else
+         {
+             for (k = 0; k < N; k++)
+                  vertexOf[k] = gp_GetFirstVertex(theGraph) + k;
+         }
+     }
+
+     // Add the edges, which gp_AddEdge() places in arcs first+2k and its
+     // twin, then relink each adjacency list in the order of its rotation
+     for (k = 0; k < M && Result == OK; k++)
+          Result = gp_AddEdge(theGraph, vertexOf[edgeV[k]], 0, vertexOf[edgeU[k]], 0) == OK ? OK : NOTOK;
+
+     if (Result == OK)
+     {
+         for (s = 0; s < numEvents; s++)
+              start[eventVertex[s] + 1]++;
+         for (v = 0; v < N; v++)
+              start[v+1] += start[v];
+         for (s = 0; s < numEvents; s++)
+              rotation[start[eventVertex[s]]++] = gp_GetFirstEdge(theGraph) + eventArc[s];
+         for (v = N; v > 0; v--)
+              start[v] = start[v-1];
+         start[0] = 0;
+
+         for (v = 0; v < N; v++)
+         {
+              w = vertexOf[v];
+              if (start[v] == start[v+1])
+              {
+                  gp_SetFirstArc(theGraph, w, NIL);
+                  gp_SetLastArc(theGraph, w, NIL);
+                  continue;
+              }
+
+              gp_SetFirstArc(theGraph, w, rotation[start[v]]);
+              gp_SetLastArc(theGraph, w, rotation[start[v+1]-1]);
+              for (s = start[v]; s < start[v+1]; s++)
+              {
+                   arc = rotation[s];
+                   gp_SetPrevArc(theGraph, arc, s > start[v] ? rotation[s-1] : NIL);
+                   gp_SetNextArc(theGraph, arc, s+1 < start[v+1] ? rotation[s+1] : NIL);
+              }
+         }
+
+         // The tree edges of the walk are a spanning forest of theGraph,
+         // so they give each vertex its DFS parent
+         for (v = 0; v < N; v++)
+              gp_SetVertexParent(theGraph, vertexOf[v], parent[v] < 0 ? NIL : vertexOf[parent[v]]);
+
+         theGraph->embedFlags = embedFlags;
+         *pOffset = pos;
+     }
+
+     if (edgeU != NULL) free(edgeU);
+     if (edgeV != NULL) free(edgeV);
+     if (eventVertex != NULL) free(eventVertex);
+     if (eventArc != NULL) free(eventArc);
+     if (rotation != NULL) free(rotation);
+     if (parent != NULL) free(parent);
+     if (path != NULL) free(path);
+     if (openEdges != NULL) free(openEdges);
+     if (vertexOf != NULL) free(vertexOf);
+     if (start != NULL) free(start);
+
+     return Result;
+}
+
+/********************************************************************
+ gp_WriteCompressedEmbedding()
+
+ Writes the compressed form of the embedding of theGraph, as given by
+ gp_CompressEmbedding(), to the open binary stream Outfile.  A stream
+ can hold any number of embeddings one after another.
+
+ Returns OK on success, NONEMBEDDABLE if the adjacency lists of theGraph
+         are not a planar embedding, NOTOK on failure
+ ********************************************************************/
+
+int  gp_WriteCompressedEmbedding(graphP theGraph, FILE *Outfile, int flags)
+{
+     compressedEmbeddingP theCode;
+     int Result;
+
+     if (Outfile == NULL || (theCode = gp_NewCompressedEmbedding()) == NULL)
+         return NOTOK;
+
+     Result = gp_CompressEmbedding(theGraph, flags, theCode);
+
+     if (Result == OK && fwrite(theCode->bytes, 1, theCode->length, Outfile) != (size_t) theCode->length)
+         Result = NOTOK;
+
+     gp_FreeCompressedEmbedding(&theCode);
+     return Result;
+}
+
+/********************************************************************
+ gp_ReadCompressedEmbedding()
+
+ Reads the next compressed embedding from the open binary stream Infile
+ into theGraph, which must be a new graph as for gp_DecompressEmbedding().
+ *pEndOfStream is set to TRUE, and theGraph is not changed, if the
+ stream has no more embeddings.
+
+ Returns OK on success, NOTOK on failure or if the stream does not hold
+         a valid compressed embedding
+ ********************************************************************/
+
+int  gp_ReadCompressedEmbedding(graphP theGraph, FILE *Infile, int *pEndOfStream)
+{
+     compressedEmbeddingP theCode;
+     int header[5], i, Ch, offset = 0, Result = OK;
+
+     if (Infile == NULL || pEndOfStream == NULL)
+         return NOTOK;
+
+     *pEndOfStream = FALSE;
+     if ((Ch = fgetc(Infile)) == EOF)
+     {
+         *pEndOfStream = TRUE;
+         return OK;
+     }
+     ungetc(Ch, Infile);
+
+     if ((theCode = gp_NewCompressedEmbedding()) == NULL)
+         return NOTOK;
+
+     // Read the header, whose length varies, then the rest
+     for (i = 0; i < 5 && Result == OK; i++)
+          Result = _CE_ReadVarint(Infile, theCode, &header[i]);
+
+     if (Result == OK)
+     {
+         if (header[0] <= 0 || header[2] <= 0 || header[2] > header[0] || header[1] > 0x3fffffff - header[2])
+             Result = NOTOK;
+         else
+         {
+             i = _CE_PayloadLength(header[0], header[1], header[2], header[3]);
+             if (_CE_EnsureCapacity(theCode, theCode->length + i) != OK ||
+                 fread(theCode->bytes + theCode->length, 1, i, Infile) != (size_t) i)
+                 Result = NOTOK;
+             else
+                 theCode->length += i;
+         }
+     }
+
+     if (Result == OK)
+         Result = gp_DecompressEmbedding(theGraph, theCode, &offset);
+
+     gp_FreeCompressedEmbedding(&theCode);
+     return Result;
+}
+
+/********************************************************************
+ _CE_ReadVarint()
+
+ Reads a variable length integer from Infile, appending its bytes to
+ theCode.
+
+ Returns OK on success, NOTOK on failure
+ ********************************************************************/
+
+int  _CE_ReadVarint(FILE *Infile, compressedEmbeddingP theCode, int *pValue)
+{
+     int pos = theCode->length, Ch;
+
+     do {
+          if ((Ch = fgetc(Infile)) == EOF || theCode->length - pos >= CE_MAXVARINT ||
+              _CE_EnsureCapacity(theCode, theCode->length + 1) != OK)
+              return NOTOK;
+          theCode->bytes[theCode->length++] = (unsigned char) Ch;
+     } while (Ch & 0x80);
+
+     return _CE_GetVarint(theCode->bytes, theCode->length, &pos, pValue);
+}
@@ -1,496 +1,813 @@
-/*
-Planarity-Related Graph Algorithms Project
-Copyright (c) 1997-2012, John M. Boyer
-All rights reserved. Includes a reference implementation of the following:
-
-* John M. Boyer. "Subgraph Homeomorphism via the Edge Addition Planarity Algorithm".
-  Journal of Graph Algorithms and Applications, Vol. 16, no. 2, pp. 381-410, 2012.
-  http://www.jgaa.info/16/268.html
-
-* John M. Boyer. "A New Method for Efficiently Generating Planar Graph
-  Visibility Representations". In P. Eades and P. Healy, editors,
-  Proceedings of the 13th International Conference on Graph Drawing 2005,
-  Lecture Notes Comput. Sci., Volume 3843, pp. 508-511, Springer-Verlag, 2006.
-
-* John M. Boyer and Wendy J. Myrvold. "On the Cutting Edge: Simplified O(n)
-  Planarity by Edge Addition". Journal of Graph Algorithms and Applications,
-  Vol. 8, No. 3, pp. 241-273, 2004.
-  http://www.jgaa.info/08/91.html
-
-* John M. Boyer. "Simplified O(n) Algorithms for Planar Graph Embedding,
-  Kuratowski Subgraph Isolation, and Related Problems". Ph.D. Dissertation,
-  University of Victoria, 2001.
-
-Redistribution and use in source and binary forms, with or without modification,
-are permitted provided that the following conditions are met:
-
-* Redistributions of source code must retain the above copyright notice, this
-  list of conditions and the following disclaimer.
-
-* Redistributions in binary form must reproduce the above copyright notice, this
-  list of conditions and the following disclaimer in the documentation and/or
-  other materials provided with the distribution.
-
-* Neither the name of the Planarity-Related Graph Algorithms Project nor the names
-  of its contributors may be used to endorse or promote products derived from this
-  software without specific prior written permission.
-
-THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
-AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
-IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
-DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
-ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
-(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
-LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
-ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
-(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
-SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
-*/
-
-#define GRAPHDFSUTILS_C
-
-#include "graph.h"
-
-extern void _ClearVertexVisitedFlags(graphP theGraph, int);
-
-/********************************************************************
- gp_CreateDFSTree
- Assigns Depth First Index (DFI) to each vertex.  Also records parent
- of each vertex in the DFS tree, and marks DFS tree edges that go from
- parent to child.  Forward arc cycle edges are also distinguished from
- edges leading from a DFS tree descendant to an ancestor-- both DFS tree
- edges and back arcs.  The forward arcs are moved to the end of the
- adjacency list to make the set easier to find and process.
-
- NOTE: This is a utility function provided for general use of the graph
- library. The core planarity algorithm uses its own DFS in order to build
- up related data structures at the same time as the DFS tree is created.
- ********************************************************************/
-
-#include "platformTime.h"
-
-int  gp_CreateDFSTree(graphP theGraph)
-{
-stackP theStack;
-int N, DFI, v, uparent, u, e;
-
-#ifdef PROFILE
-platform_time start, end;
-platform_GetTime(start);
-#endif
-
-     if (theGraph==NULL) return NOTOK;
-     if (theGraph->internalFlags & FLAGS_DFSNUMBERED) return OK;
-
-     gp_LogLine("\ngraphDFSUtils.c/gp_CreateDFSTree() start");
-
-     N = theGraph->N;
-     theStack  = theGraph->theStack;
-
-/* There are 2M edge records (arcs) and for each we can push 2 integers,
-        so a stack of 2 * arcCapacity integers suffices.
-        This is already in theGraph structure, so we make sure it's empty,
-        then clear all visited flags in prep for the Depth first search. */
-
-     if (sp_GetCapacity(theStack) < 2*gp_GetArcCapacity(theGraph))
-    	 return NOTOK;
-
-     sp_ClearStack(theStack);
-
-     _ClearVertexVisitedFlags(theGraph, FALSE);
-
-/* This outer loop causes the connected subgraphs of a disconnected
-        graph to be numbered */
-
-     for (DFI = v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, DFI); v++)
-     {
-          if (gp_IsNotDFSTreeRoot(theGraph, v))
-              continue;
-
-          sp_Push2(theStack, NIL, NIL);
-          while (sp_NonEmpty(theStack))
-          {
-              sp_Pop2(theStack, uparent, e);
-              u = gp_IsNotVertex(uparent) ? v : gp_GetNeighbor(theGraph, e);
-
-              if (!gp_GetVertexVisited(theGraph, u))
-              {
-            	  gp_LogLine(gp_MakeLogStr3("V=%d, DFI=%d, Parent=%d", u, DFI, uparent));
-
-            	  gp_SetVertexVisited(theGraph, u);
-                  gp_SetVertexIndex(theGraph, u, DFI++);
-                  gp_SetVertexParent(theGraph, u, uparent);
-                  if (gp_IsArc(e))
-                  {
-                      gp_SetEdgeType(theGraph, e, EDGE_TYPE_CHILD);
-                      gp_SetEdgeType(theGraph, gp_GetTwinArc(theGraph, e), EDGE_TYPE_PARENT);
-                  }
-
-                  /* Push edges to all unvisited neighbors. These will be either
-                        tree edges to children or forward arcs of back edges */
-
-                  e = gp_GetFirstArc(theGraph, u);
-                  while (gp_IsArc(e))
-                  {
-                      if (!gp_GetVertexVisited(theGraph, gp_GetNeighbor(theGraph, e)))
-                          sp_Push2(theStack, u, e);
-                      e = gp_GetNextArc(theGraph, e);
-                  }
-              }
-              else
-              {
-                  // If the edge leads to a visited vertex, then it is
-            	  // the forward arc of a back edge.
-                  gp_SetEdgeType(theGraph, e, EDGE_TYPE_FORWARD);
-                  gp_SetEdgeType(theGraph, gp_GetTwinArc(theGraph, e), EDGE_TYPE_BACK);
-              }
-          }
-     }
-
-     gp_LogLine("graphDFSUtils.c/gp_CreateDFSTree() end\n");
-
-     theGraph->internalFlags |= FLAGS_DFSNUMBERED;
-
-#ifdef PROFILE
-platform_GetTime(end);
-printf("DFS in %.3lf seconds.\n", platform_GetDuration(start,end));
-#endif
-
-     return OK;
-}
-
-/********************************************************************
- gp_SortVertices()
- Once depth first numbering has been applied to the graph, the index
- member of each vertex contains the DFI.  This routine can reorder the
- vertices in linear time so that they appear in ascending order by DFI.
- Note that the index field is then used to store the original number
- of the vertex. Therefore, a second call to this method will put the
- vertices back to the original order and put the DFIs back into the
- index fields of the vertices.
-
- NOTE: This function is used by the core planarity algorithm, once its
- custom DFS has assigned DFIs to the vertices.  Once gp_Embed() has
- finished creating an embedding or obstructing subgraph, this function
- can be called to restore the original vertex numbering, if needed.
- ********************************************************************/
-
-int  gp_SortVertices(graphP theGraph)
-{
-     return theGraph->functions.fpSortVertices(theGraph);
-}
-
-int  _SortVertices(graphP theGraph)
-{
-int  v, EsizeOccupied, e, srcPos, dstPos;
-
-#ifdef PROFILE
-platform_time start, end;
-platform_GetTime(start);
-#endif
-
-     if (theGraph == NULL) return NOTOK;
-     if (!(theGraph->internalFlags&FLAGS_DFSNUMBERED))
-         if (gp_CreateDFSTree(theGraph) != OK)
-             return NOTOK;
-
-     gp_LogLine("\ngraphDFSUtils.c/_SortVertices() start");
-
-     /* Change labels of edges from v to DFI(v)-- or vice versa
-        Also, if any links go back to locations 0 to n-1, then they
-        need to be changed because we are reordering the vertices */
-
-     EsizeOccupied = gp_EdgeInUseIndexBound(theGraph);
-     for (e = gp_GetFirstEdge(theGraph); e < EsizeOccupied; e+=2)
-     {
-    	 if (gp_EdgeInUse(theGraph, e))
-    	 {
-    		 gp_SetNeighbor(theGraph, e, gp_GetVertexIndex(theGraph, gp_GetNeighbor(theGraph, e)));
-    		 gp_SetNeighbor(theGraph, e+1, gp_GetVertexIndex(theGraph, gp_GetNeighbor(theGraph, e+1)));
-    	 }
-     }
-
-     /* Convert DFSParent from v to DFI(v) or vice versa */
-
-     for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
-          if (gp_IsNotDFSTreeRoot(theGraph, v))
-              gp_SetVertexParent(theGraph, v, gp_GetVertexIndex(theGraph, gp_GetVertexParent(theGraph, v)));
-
-     /* Sort by 'v using constant time random access. Move each vertex to its
-        destination 'v', and store its source location in 'v'. */
-
-     /* First we clear the visitation flags.  We need these to help mark
-        visited vertices because we change the 'v' field to be the source
-        location, so we cannot use index==v as a test for whether the
-        correct vertex is in location 'index'. */
-
-     _ClearVertexVisitedFlags(theGraph, FALSE);
-
-     /* We visit each vertex location, skipping those marked as visited since
-        we've already moved the correct vertex into that location. The
-        inner loop swaps the vertex at location v into the correct position,
-        given by the index of the vertex at location v.  Then it marks that
-        location as visited, then sets its index to be the location from
-        whence we obtained the vertex record. */
-
-     for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
-     {
-          srcPos = v;
-          while (!gp_GetVertexVisited(theGraph, v))
-          {
-              dstPos = gp_GetVertexIndex(theGraph, v);
-
-              gp_SwapVertexRec(theGraph, dstPos, theGraph, v);
-              gp_SwapVertexInfo(theGraph, dstPos, theGraph, v);
-
-              gp_SetVertexVisited(theGraph, dstPos);
-              gp_SetVertexIndex(theGraph, dstPos, srcPos);
-
-              srcPos = dstPos;
-          }
-     }
-
-     /* Invert the bit that records the sort order of the graph */
-
-     theGraph->internalFlags ^= FLAGS_SORTEDBYDFI;
-
-	 gp_LogLine("graphDFSUtils.c/_SortVertices() end\n");
-
-#ifdef PROFILE
-platform_GetTime(end);
-printf("SortVertices in %.3lf seconds.\n", platform_GetDuration(start,end));
-#endif
-
-     return OK;
-}
-
-/********************************************************************
- gp_LowpointAndLeastAncestor()
-        leastAncestor(v): min(v, ancestor neighbors of v, excluding parent)
-        Lowpoint(v): min(leastAncestor(v), Lowpoint of DFS children of v)
-
- Lowpoint is computed via a post-order traversal of the DFS tree.
- We push the root of the DFS tree, then we loop while the stack is not empty.
- We pop a vertex; if it is not marked, then we are on our way down the DFS
- tree, so we mark it and push it back on, followed by pushing its
- DFS children.  The next time we pop the node, all of its children
- will have been popped, marked+children pushed, and popped again.  On
- the second pop of the vertex, we can therefore compute the lowpoint
- values based on the childrens' lowpoints and the least ancestor from
- among the edges in the vertex's adjacency list.
-
- If they have not already been performed, gp_CreateDFSTree() and
- gp_SortVertices() are invoked on the graph, and it is left in the
- sorted state on completion of this method.
-
- NOTE: This is a utility function provided for general use of the graph
- library. The core planarity algorithm computes leastAncestor during its
- initial DFS, and it computes the lowpoint of a vertex as it embeds the
- tree edges to its children.
- ********************************************************************/
-
-int  gp_LowpointAndLeastAncestor(graphP theGraph)
-{
-stackP theStack = theGraph->theStack;
-int v, u, uneighbor, e, L, leastAncestor;
-
-	 if (theGraph == NULL) return NOTOK;
-
-	 if (!(theGraph->internalFlags&FLAGS_DFSNUMBERED))
-		 if (gp_CreateDFSTree(theGraph) != OK)
-			 return NOTOK;
-
-     if (!(theGraph->internalFlags & FLAGS_SORTEDBYDFI))
-    	 if (gp_SortVertices(theGraph) != OK)
-    		 return NOTOK;
-
-#ifdef PROFILE
-platform_time start, end;
-platform_GetTime(start);
-#endif
-
-	 gp_LogLine("\ngraphDFSUtils.c/gp_LowpointAndLeastAncestor() start");
-
-	 // A stack of size N suffices because at maximum every vertex is pushed only once
-	 // However, since a larger stack is needed for the main DFS, this is mainly documentation
-	 if (sp_GetCapacity(theStack) < theGraph->N)
-		 return NOTOK;
-
-     sp_ClearStack(theStack);
-
-     _ClearVertexVisitedFlags(theGraph, FALSE);
-
-     // This outer loop causes the connected subgraphs of a disconnected graph to be processed
-     for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v);)
-     {
-          if (gp_GetVertexVisited(theGraph, v))
-          {
-        	  ++v;
-              continue;
-          }
-
-          sp_Push(theStack, v);
-          while (sp_NonEmpty(theStack))
-          {
-              sp_Pop(theStack, u);
-
-              // If not visited, then we're on the pre-order visitation, so push u and its DFS children
-              if (!gp_GetVertexVisited(theGraph, u))
-              {
-                  // Mark u as visited, then push it back on the stack
-                  gp_SetVertexVisited(theGraph, u);
-                  ++v;
-                  sp_Push(theStack, u);
-
-                  // Push the DFS children of u
-                  e = gp_GetFirstArc(theGraph, u);
-                  while (gp_IsArc(e))
-                  {
-                      if (gp_GetEdgeType(theGraph, e) == EDGE_TYPE_CHILD)
-                      {
-                          sp_Push(theStack, gp_GetNeighbor(theGraph, e));
-                      }
-
-                      e = gp_GetNextArc(theGraph, e);
-                  }
-              }
-
-              // If u has been visited before, then this is the post-order visitation
-              else
-              {
-                  // Start with high values because we are doing a min function
-                  leastAncestor = L = u;
-
-                  // Compute leastAncestor and L, the least lowpoint from the DFS children
-                  e = gp_GetFirstArc(theGraph, u);
-                  while (gp_IsArc(e))
-                  {
-                      uneighbor = gp_GetNeighbor(theGraph, e);
-                      if (gp_GetEdgeType(theGraph, e) == EDGE_TYPE_CHILD)
-                      {
-                          if (L > gp_GetVertexLowpoint(theGraph, uneighbor))
-                              L = gp_GetVertexLowpoint(theGraph, uneighbor);
-                      }
-                      else if (gp_GetEdgeType(theGraph, e) == EDGE_TYPE_BACK)
-                      {
-                          if (leastAncestor > uneighbor)
-                              leastAncestor = uneighbor;
-                      }
-
-                      e = gp_GetNextArc(theGraph, e);
-                  }
-
-                  /* Assign leastAncestor and Lowpoint to the vertex */
-                  gp_SetVertexLeastAncestor(theGraph, u, leastAncestor);
-                  gp_SetVertexLowpoint(theGraph, u, leastAncestor < L ? leastAncestor : L);
-              }
-         }
-     }
-
-	 gp_LogLine("graphDFSUtils.c/gp_LowpointAndLeastAncestor() end\n");
-
-#ifdef PROFILE
-platform_GetTime(end);
-printf("Lowpoint in %.3lf seconds.\n", platform_GetDuration(start,end));
-#endif
-
-     return OK;
-}
-
-/********************************************************************
- gp_LeastAncestor()
-
- By simple pre-order visitation, compute the least ancestor of each
- vertex that is directly adjacent to the vertex by a back edge.
-
- If they have not already been performed, gp_CreateDFSTree() and
- gp_SortVertices() are invoked on the graph, and it is left in the
- sorted state on completion of this method.
-
- NOTE: This method is not called by gp_LowpointAndLeastAncestor(),
- which computes both values at the same time.
-
- NOTE: This method is useful in core planarity initialization when
- a graph has already been DFS numbered and sorted by DFI. For example,
- this allows the core planarity embedder to avoid perturbing unit test
- graphs that may be designed and stored in a DFI sorted format.
- ********************************************************************/
-
-int  gp_LeastAncestor(graphP theGraph)
-{
-stackP theStack = theGraph->theStack;
-int v, u, uneighbor, e, leastAncestor;
-
-	 if (theGraph == NULL) return NOTOK;
-
-	 if (!(theGraph->internalFlags&FLAGS_DFSNUMBERED))
-		 if (gp_CreateDFSTree(theGraph) != OK)
-			 return NOTOK;
-
-	 if (!(theGraph->internalFlags & FLAGS_SORTEDBYDFI))
-		 if (gp_SortVertices(theGraph) != OK)
-			 return NOTOK;
-
-#ifdef PROFILE
-platform_time start, end;
-platform_GetTime(start);
-#endif
-
-	 gp_LogLine("\ngraphDFSUtils.c/gp_LeastAncestor() start");
-
-	 // A stack of size N suffices because at maximum every vertex is pushed only once
-	 if (sp_GetCapacity(theStack) < theGraph->N)
-		 return NOTOK;
-
-	 sp_ClearStack(theStack);
-
-	 // This outer loop causes the connected subgraphs of a disconnected graph to be processed
-	 for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v);)
-	 {
-		  if (gp_GetVertexVisited(theGraph, v))
-		  {
-			  ++v;
-			  continue;
-		  }
-
-		  sp_Push(theStack, v);
-		  while (sp_NonEmpty(theStack))
-		  {
-			  sp_Pop(theStack, u);
-
-			  if (!gp_GetVertexVisited(theGraph, u))
-			  {
-				  gp_SetVertexVisited(theGraph, u);
-				  ++v;
-				  leastAncestor = u;
-
-				  e = gp_GetFirstArc(theGraph, u);
-				  while (gp_IsArc(e))
-				  {
-                      uneighbor = gp_GetNeighbor(theGraph, e);
-					  if (gp_GetEdgeType(theGraph, e) == EDGE_TYPE_CHILD)
-					  {
-						  sp_Push(theStack, uneighbor);
-					  }
-					  else if (gp_GetEdgeType(theGraph, e) == EDGE_TYPE_BACK)
-					  {
-						  if (leastAncestor > uneighbor)
-							  leastAncestor = uneighbor;
-					  }
-
-					  e = gp_GetNextArc(theGraph, e);
-				  }
-				  gp_SetVertexLeastAncestor(theGraph, u, leastAncestor);
-			  }
-		 }
-	 }
-
-	 gp_LogLine("graphDFSUtils.c/gp_LeastAncestor() end\n");
-
-#ifdef PROFILE
-platform_GetTime(end);
-printf("LeastAncestor in %.3lf seconds.\n", platform_GetDuration(start,end));
-#endif
-
-	 return OK;
-}
+/*
+Planarity-Related Graph Algorithms Project
+Copyright (c) 1997-2012, John M. Boyer
+All rights reserved. Includes a reference implementation of the following:
+
+* John M. Boyer. "Subgraph Homeomorphism via the Edge Addition Planarity Algorithm".
+  Journal of Graph Algorithms and Applications, Vol. 16, no. 2, pp. 381-410, 2012.
+  http://www.jgaa.info/16/268.html
+
+* John M. Boyer. "A New Method for Efficiently Generating Planar Graph
+  Visibility Representations". In P. Eades and P. Healy, editors,
+  Proceedings of the 13th International Conference on Graph Drawing 2005,
+  Lecture Notes Comput. Sci., Volume 3843, pp. 508-511, Springer-Verlag, 2006.
+
+* John M. Boyer and Wendy J. Myrvold. "On the Cutting Edge: Simplified O(n)
+  Planarity by Edge Addition". Journal of Graph Algorithms and Applications,
+  Vol. 8, No. 3, pp. 241-273, 2004.
+  http://www.jgaa.info/08/91.html
+
+* John M. Boyer. "Simplified O(n) Algorithms for Planar Graph Embedding,
+  Kuratowski Subgraph Isolation, and Related Problems". Ph.D. Dissertation,
+  University of Victoria, 2001.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+  list of conditions and the following disclaimer in the documentation and/or
+  other materials provided with the distribution.
+
+* Neither the name of the Planarity-Related Graph Algorithms Project nor the names
+  of its contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#define GRAPHDFSUTILS_C
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "graph.h"
+#include "graphDFSUtils.private.h"
+#include "graphTrace.private.h"
+
+extern void _ClearVertexVisitedFlags(graphP theGraph, int);
+
+extern int  _SuspendEdgeIndex(graphP theGraph);
+extern int  _RebuildEdgeIndex(graphP theGraph);
+
+extern int  _TransactionSaveGraph(graphP theGraph);
+
+/* Private functions, except exported within library */
+
+void _BlockStack_PushIfSearchable(graphP theGraph, blockStackP blocks, int *blockEdges, int numBlockEdges);
+
+/********************************************************************
+ gp_CreateDFSTree
+ Assigns Depth First Index (DFI) to each vertex.  Also records parent
+ of each vertex in the DFS tree, and marks DFS tree edges that go from
+ parent to child.  Forward arc cycle edges are also distinguished from
+ edges leading from a DFS tree descendant to an ancestor-- both DFS tree
+ edges and back arcs.  The forward arcs are moved to the end of the
+ adjacency list to make the set easier to find and process.
+
+ NOTE: This is a utility function provided for general use of the graph
+ library. The core planarity algorithm uses its own DFS in order to build
+ up related data structures at the same time as the DFS tree is created.
+ ********************************************************************/
+
+#include "platformTime.h"
+
+int  gp_CreateDFSTree(graphP theGraph)
+{
+stackP theStack;
+int N, DFI, v, uparent, u, e;
+
+#ifdef PROFILE
+platform_time start, end;
+platform_GetTime(start);
+#endif
+
+     if (theGraph==NULL) return NOTOK;
+     if (theGraph->internalFlags & FLAGS_DFSNUMBERED) return OK;
+
+     if (gp_TransactionLogging(theGraph) && _TransactionSaveGraph(theGraph) != OK)
+         return NOTOK;
+
+     gp_LogLine("\ngraphDFSUtils.c/gp_CreateDFSTree() start");
+
+     N = theGraph->N;
+     theStack  = theGraph->theStack;
+
+/* There are 2M edge records (arcs) and for each we can push 2 integers,
+        so a stack of 2 * arcCapacity integers suffices.
+        This is already in theGraph structure, so we make sure it's empty,
+        then clear all visited flags in prep for the Depth first search. */
+
+     if (sp_GetCapacity(theStack) < 2*gp_GetArcCapacity(theGraph))
+    	 return NOTOK;
+
+     sp_ClearStack(theStack);
+
+     _ClearVertexVisitedFlags(theGraph, FALSE);
+
+/* This outer loop causes the connected subgraphs of a disconnected
+        graph to be numbered */
+
+     for (DFI = v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, DFI); v++)
+     {
+          if (gp_IsNotDFSTreeRoot(theGraph, v))
+              continue;
+
+          sp_Push2(theStack, NIL, NIL);
+          while (sp_NonEmpty(theStack))
+          {
+              sp_Pop2(theStack, uparent, e);
+              u = gp_IsNotVertex(uparent) ? v : gp_GetNeighbor(theGraph, e);
+
+              if (!gp_GetVertexVisited(theGraph, u))
+              {
+            	  gp_LogLine(gp_MakeLogStr3("V=%d, DFI=%d, Parent=%d", u, DFI, uparent));
+
+            	  gp_SetVertexVisited(theGraph, u);
+                  gp_SetVertexIndex(theGraph, u, DFI++);
+                  gp_SetVertexParent(theGraph, u, uparent);
+                  if (gp_IsArc(e))
+                  {
+                      gp_SetEdgeType(theGraph, e, EDGE_TYPE_CHILD);
+                      gp_SetEdgeType(theGraph, gp_GetTwinArc(theGraph, e), EDGE_TYPE_PARENT);
+                  }
+
+                  /* Push edges to all unvisited neighbors. These will be either
+                        tree edges to children or forward arcs of back edges */
+
+                  e = gp_GetFirstArc(theGraph, u);
+                  while (gp_IsArc(e))
+                  {
+                      if (!gp_GetVertexVisited(theGraph, gp_GetNeighbor(theGraph, e)))
+                          sp_Push2(theStack, u, e);
+                      e = gp_GetNextArc(theGraph, e);
+                  }
+              }
+              else
+              {
+                  // If the edge leads to a visited vertex, then it is
+            	  // the forward arc of a back edge.
+                  gp_SetEdgeType(theGraph, e, EDGE_TYPE_FORWARD);
+                  gp_SetEdgeType(theGraph, gp_GetTwinArc(theGraph, e), EDGE_TYPE_BACK);
+              }
+          }
+     }
+
+     gp_LogLine("graphDFSUtils.c/gp_CreateDFSTree() end\n");
+
+     theGraph->internalFlags |= FLAGS_DFSNUMBERED;
+
+#ifdef PROFILE
+platform_GetTime(end);
+printf("DFS in %.3lf seconds.\n", platform_GetDuration(start,end));
+#endif
+
+     return OK;
+}
+
+/********************************************************************
+ gp_SortVertices()
+ Once depth first numbering has been applied to the graph, the index
+ member of each vertex contains the DFI.  This routine can reorder the
+ vertices in linear time so that they appear in ascending order by DFI.
+ Note that the index field is then used to store the original number
+ of the vertex. Therefore, a second call to this method will put the
+ vertices back to the original order and put the DFIs back into the
+ index fields of the vertices.
+
+ NOTE: This function is used by the core planarity algorithm, once its
+ custom DFS has assigned DFIs to the vertices.  Once gp_Embed() has
+ finished creating an embedding or obstructing subgraph, this function
+ can be called to restore the original vertex numbering, if needed.
+ ********************************************************************/
+
+int  gp_SortVertices(graphP theGraph)
+{
+     int  indexSuspended, Result;
+
+     // Within a transaction, the relabeled graph is saved whole
+     if (gp_TransactionLogging(theGraph) && _TransactionSaveGraph(theGraph) != OK)
+         return NOTOK;
+
+     // The relabeling rekeys every edge, so the edge index, if any, is
+     // rebuilt afterward rather than updated edge by edge
+     indexSuspended = _SuspendEdgeIndex(theGraph);
+     gp_TraceBegin(theGraph, TRACE_SORTVERTICES, NIL);
+     Result = theGraph->functions.fpSortVertices(theGraph);
+     gp_TraceEnd(theGraph, TRACE_SORTVERTICES, NIL);
+
+     if (indexSuspended && _RebuildEdgeIndex(theGraph) != OK)
+         Result = NOTOK;
+
+     return Result;
+}
+
+int  _SortVertices(graphP theGraph)
+{
+int  v, EsizeOccupied, e, srcPos, dstPos;
+
+#ifdef PROFILE
+platform_time start, end;
+platform_GetTime(start);
+#endif
+
+     if (theGraph == NULL) return NOTOK;
+     if (!(theGraph->internalFlags&FLAGS_DFSNUMBERED))
+         if (gp_CreateDFSTree(theGraph) != OK)
+             return NOTOK;
+
+     gp_LogLine("\ngraphDFSUtils.c/_SortVertices() start");
+
+     /* Change labels of edges from v to DFI(v)-- or vice versa
+        Also, if any links go back to locations 0 to n-1, then they
+        need to be changed because we are reordering the vertices */
+
+     EsizeOccupied = gp_EdgeInUseIndexBound(theGraph);
+     for (e = gp_GetFirstEdge(theGraph); e < EsizeOccupied; e+=2)
+     {
+    	 if (gp_EdgeInUse(theGraph, e))
+    	 {
+    		 gp_SetNeighbor(theGraph, e, gp_GetVertexIndex(theGraph, gp_GetNeighbor(theGraph, e)));
+    		 gp_SetNeighbor(theGraph, e+1, gp_GetVertexIndex(theGraph, gp_GetNeighbor(theGraph, e+1)));
+    	 }
+     }
+
+     /* Convert DFSParent from v to DFI(v) or vice versa */
+
+     for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
+          if (gp_IsNotDFSTreeRoot(theGraph, v))
+              gp_SetVertexParent(theGraph, v, gp_GetVertexIndex(theGraph, gp_GetVertexParent(theGraph, v)));
+
+     /* Sort by 'v using constant time random access. Move each vertex to its
+        destination 'v', and store its source location in 'v'. */
+
+     /* First we clear the visitation flags.  We need these to help mark
+        visited vertices because we change the 'v' field to be the source
+        location, so we cannot use index==v as a test for whether the
+        correct vertex is in location 'index'. */
+
+     _ClearVertexVisitedFlags(theGraph, FALSE);
+
+     /* We visit each vertex location, skipping those marked as visited since
+        we've already moved the correct vertex into that location. The
+        inner loop swaps the vertex at location v into the correct position,
+        given by the index of the vertex at location v.  Then it marks that
+        location as visited, then sets its index to be the location from
+        whence we obtained the vertex record. */
+
+     for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
+     {
+          srcPos = v;
+          while (!gp_GetVertexVisited(theGraph, v))
+          {
+              dstPos = gp_GetVertexIndex(theGraph, v);
+
+              gp_SwapVertexRec(theGraph, dstPos, theGraph, v);
+              gp_SwapVertexInfo(theGraph, dstPos, theGraph, v);
+
+              gp_SetVertexVisited(theGraph, dstPos);
+              gp_SetVertexIndex(theGraph, dstPos, srcPos);
+
+              srcPos = dstPos;
+          }
+     }
+
+     /* Invert the bit that records the sort order of the graph */
+
+     theGraph->internalFlags ^= FLAGS_SORTEDBYDFI;
+
+	 gp_LogLine("graphDFSUtils.c/_SortVertices() end\n");
+
+#ifdef PROFILE
+platform_GetTime(end);
+printf("SortVertices in %.3lf seconds.\n", platform_GetDuration(start,end));
+#endif
+
+     return OK;
+}
+
+/********************************************************************
+ gp_LowpointAndLeastAncestor()
+        leastAncestor(v): min(v, ancestor neighbors of v, excluding parent)
+        Lowpoint(v): min(leastAncestor(v), Lowpoint of DFS children of v)
+
+ Lowpoint is computed via a post-order traversal of the DFS tree.
+ We push the root of the DFS tree, then we loop while the stack is not empty.
+ We pop a vertex; if it is not marked, then we are on our way down the DFS
+ tree, so we mark it and push it back on, followed by pushing its
+ DFS children.  The next time we pop the node, all of its children
+ will have been popped, marked+children pushed, and popped again.  On
+ the second pop of the vertex, we can therefore compute the lowpoint
+ values based on the childrens' lowpoints and the least ancestor from
+ among the edges in the vertex's adjacency list.
+
+ If they have not already been performed, gp_CreateDFSTree() and
+ gp_SortVertices() are invoked on the graph, and it is left in the
+ sorted state on completion of this method.
+
+ NOTE: This is a utility function provided for general use of the graph
+ library. The core planarity algorithm computes leastAncestor during its
+ initial DFS, and it computes the lowpoint of a vertex as it embeds the
+ tree edges to its children.
+ ********************************************************************/
+
+int  gp_LowpointAndLeastAncestor(graphP theGraph)
+{
+stackP theStack = theGraph->theStack;
+int v, u, uneighbor, e, L, leastAncestor;
+
+	 if (theGraph == NULL) return NOTOK;
+
+	 if (gp_TransactionLogging(theGraph) && _TransactionSaveGraph(theGraph) != OK)
+		 return NOTOK;
+
+	 if (!(theGraph->internalFlags&FLAGS_DFSNUMBERED))
+		 if (gp_CreateDFSTree(theGraph) != OK)
+			 return NOTOK;
+
+     if (!(theGraph->internalFlags & FLAGS_SORTEDBYDFI))
+    	 if (gp_SortVertices(theGraph) != OK)
+    		 return NOTOK;
+
+#ifdef PROFILE
+platform_time start, end;
+platform_GetTime(start);
+#endif
+
+	 gp_LogLine("\ngraphDFSUtils.c/gp_LowpointAndLeastAncestor() start");
+
+	 // A stack of size N suffices because at maximum every vertex is pushed only once
+	 // However, since a larger stack is needed for the main DFS, this is mainly documentation
+	 if (sp_GetCapacity(theStack) < theGraph->N)
+		 return NOTOK;
+
+     sp_ClearStack(theStack);
+
+     _ClearVertexVisitedFlags(theGraph, FALSE);
+
+     // This outer loop causes the connected subgraphs of a disconnected graph to be processed
+     for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v);)
+     {
+          if (gp_GetVertexVisited(theGraph, v))
+          {
+        	  ++v;
+              continue;
+          }
+
+          sp_Push(theStack, v);
+          while (sp_NonEmpty(theStack))
+          {
+              sp_Pop(theStack, u);
+
+              // If not visited, then we're on the pre-order visitation, so push u and its DFS children
+              if (!gp_GetVertexVisited(theGraph, u))
+              {
+                  // Mark u as visited, then push it back on the stack
+                  gp_SetVertexVisited(theGraph, u);
+                  ++v;
+                  sp_Push(theStack, u);
+
+                  // Push the DFS children of u
+                  e = gp_GetFirstArc(theGraph, u);
+                  while (gp_IsArc(e))
+                  {
+                      if (gp_GetEdgeType(theGraph, e) == EDGE_TYPE_CHILD)
+                      {
+                          sp_Push(theStack, gp_GetNeighbor(theGraph, e));
+                      }
+
+                      e = gp_GetNextArc(theGraph, e);
+                  }
+              }
+
+              // If u has been visited before, then this is the post-order visitation
+              else
+              {
+                  // Start with high values because we are doing a min function
+                  leastAncestor = L = u;
+
+                  // Compute leastAncestor and L, the least lowpoint from the DFS children
+                  e = gp_GetFirstArc(theGraph, u);
+                  while (gp_IsArc(e))
+                  {
+                      uneighbor = gp_GetNeighbor(theGraph, e);
+                      if (gp_GetEdgeType(theGraph, e) == EDGE_TYPE_CHILD)
+                      {
+                          if (L > gp_GetVertexLowpoint(theGraph, uneighbor))
+                              L = gp_GetVertexLowpoint(theGraph, uneighbor);
+                      }
+                      else if (gp_GetEdgeType(theGraph, e) == EDGE_TYPE_BACK)
+                      {
+                          if (leastAncestor > uneighbor)
+                              leastAncestor = uneighbor;
+                      }
+
+                      e = gp_GetNextArc(theGraph, e);
+                  }
+
+                  /* Assign leastAncestor and Lowpoint to the vertex */
+                  gp_SetVertexLeastAncestor(theGraph, u, leastAncestor);
+                  gp_SetVertexLowpoint(theGraph, u, leastAncestor < L ? leastAncestor : L);
+              }
+         }
+     }
+
+	 gp_LogLine("graphDFSUtils.c/gp_LowpointAndLeastAncestor() end\n");
+
+#ifdef PROFILE
+platform_GetTime(end);
+printf("Lowpoint in %.3lf seconds.\n", platform_GetDuration(start,end));
+#endif
+
+     return OK;
+}
+
+/********************************************************************
+ gp_LeastAncestor()
+
+ By simple pre-order visitation, compute the least ancestor of each
+ vertex that is directly adjacent to the vertex by a back edge.
+
+ If they have not already been performed, gp_CreateDFSTree() and
+ gp_SortVertices() are invoked on the graph, and it is left in the
+ sorted state on completion of this method.
+
+ NOTE: This method is not called by gp_LowpointAndLeastAncestor(),
+ which computes both values at the same time.
+
+ NOTE: This method is useful in core planarity initialization when
+ a graph has already been DFS numbered and sorted by DFI. For example,
+ this allows the core planarity embedder to avoid perturbing unit test
+ graphs that may be designed and stored in a DFI sorted format.
+ ********************************************************************/
+
+int  gp_LeastAncestor(graphP theGraph)
+{
+stackP theStack = theGraph->theStack;
+int v, u, uneighbor, e, leastAncestor;
+
+	 if (theGraph == NULL) return NOTOK;
+
+	 if (!(theGraph->internalFlags&FLAGS_DFSNUMBERED))
+		 if (gp_CreateDFSTree(theGraph) != OK)
+			 return NOTOK;
+
+	 if (!(theGraph->internalFlags & FLAGS_SORTEDBYDFI))
+		 if (gp_SortVertices(theGraph) != OK)
+			 return NOTOK;
+
+#ifdef PROFILE
+platform_time start, end;
+platform_GetTime(start);
+#endif
+
+	 gp_LogLine("\ngraphDFSUtils.c/gp_LeastAncestor() start");
+
+	 // A stack of size N suffices because at maximum every vertex is pushed only once
+	 if (sp_GetCapacity(theStack) < theGraph->N)
+		 return NOTOK;
+
+	 sp_ClearStack(theStack);
+
+	 // This outer loop causes the connected subgraphs of a disconnected graph to be processed
+	 for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v);)
+	 {
+		  if (gp_GetVertexVisited(theGraph, v))
+		  {
+			  ++v;
+			  continue;
+		  }
+
+		  sp_Push(theStack, v);
+		  while (sp_NonEmpty(theStack))
+		  {
+			  sp_Pop(theStack, u);
+
+			  if (!gp_GetVertexVisited(theGraph, u))
+			  {
+				  gp_SetVertexVisited(theGraph, u);
+				  ++v;
+				  leastAncestor = u;
+
+				  e = gp_GetFirstArc(theGraph, u);
+				  while (gp_IsArc(e))
+				  {
+                      uneighbor = gp_GetNeighbor(theGraph, e);
+					  if (gp_GetEdgeType(theGraph, e) == EDGE_TYPE_CHILD)
+					  {
+						  sp_Push(theStack, uneighbor);
+					  }
+					  else if (gp_GetEdgeType(theGraph, e) == EDGE_TYPE_BACK)
+					  {
+						  if (leastAncestor > uneighbor)
+							  leastAncestor = uneighbor;
+					  }
+
+					  e = gp_GetNextArc(theGraph, e);
+				  }
+				  gp_SetVertexLeastAncestor(theGraph, u, leastAncestor);
+			  }
+		 }
+	 }
+
+	 gp_LogLine("graphDFSUtils.c/gp_LeastAncestor() end\n");
+
+#ifdef PROFILE
+platform_GetTime(end);
+printf("LeastAncestor in %.3lf seconds.\n", platform_GetDuration(start,end));
+#endif
+
+	 return OK;
+}
+
+/********************************************************************
+ _BlockStack_New()
+
+ Allocates the arrays of the stack of biconnected components for
+ theGraph, and puts one arc of each edge of theGraph other than a
+ self-loop into the arcs of the stack, so that a call to
+ _BlockStack_PushSearchableBlocks() then pushes the biconnected
+ components of the whole graph.  The stack is initially empty.
+
+ Returns OK on success, NOTOK on allocation failure, in which case the
+         arrays allocated are freed
+ ********************************************************************/
+
+int  _BlockStack_New(graphP theGraph, blockStackP blocks, int minBlockEdges, int minBranchVertices)
+{
+     int Vb = gp_PrimaryVertexIndexBound(theGraph), M = theGraph->M;
+     int e, EsizeOccupied;
+
+     memset(blocks, 0, sizeof(blockStack));
+
+     if ((blocks->localIndex = (int *) malloc((Vb+1) * sizeof(int))) == NULL ||
+         (blocks->localVertex = (int *) malloc((Vb+1) * sizeof(int))) == NULL ||
+         (blocks->stamp = (int *) calloc(Vb+1, sizeof(int))) == NULL ||
+         (blocks->adjStart = (int *) malloc((Vb+1) * sizeof(int))) == NULL ||
+         (blocks->adj = (int *) malloc((2*M+1) * sizeof(int))) == NULL ||
+         (blocks->degree = (int *) malloc((Vb+1) * sizeof(int))) == NULL ||
+         (blocks->dfi = (int *) malloc((Vb+1) * sizeof(int))) == NULL ||
+         (blocks->low = (int *) malloc((Vb+1) * sizeof(int))) == NULL ||
+         (blocks->parentEdge = (int *) malloc((Vb+1) * sizeof(int))) == NULL ||
+         (blocks->nextAdj = (int *) malloc((Vb+1) * sizeof(int))) == NULL ||
+         (blocks->vertexStack = (int *) malloc((Vb+1) * sizeof(int))) == NULL ||
+         (blocks->edgeStack = (int *) malloc((M+1) * sizeof(int))) == NULL ||
+         (blocks->arcs = (int *) malloc((M+1) * sizeof(int))) == NULL ||
+         (blocks->blockArcs = (int *) malloc((M+1) * sizeof(int))) == NULL ||
+         (blocks->blockStart = (int *) malloc((M+1) * sizeof(int))) == NULL)
+     {
+         _BlockStack_Free(blocks);
+         return NOTOK;
+     }
+
+     blocks->minBlockEdges = minBlockEdges;
+     blocks->minBranchVertices = minBranchVertices;
+
+     EsizeOccupied = gp_EdgeInUseIndexBound(theGraph);
+     for (e = gp_GetFirstEdge(theGraph); e < EsizeOccupied; e += 2)
+     {
+         if (gp_EdgeInUse(theGraph, e) &&
+             gp_GetNeighbor(theGraph, e) != gp_GetNeighbor(theGraph, gp_GetTwinArc(theGraph, e)))
+             blocks->arcs[blocks->numArcs++] = e;
+     }
+
+     return OK;
+}
+
+/********************************************************************
+ _BlockStack_Free()
+ ********************************************************************/
+
+void _BlockStack_Free(blockStackP blocks)
+{
+     if (blocks->localIndex != NULL) free(blocks->localIndex);
+     if (blocks->localVertex != NULL) free(blocks->localVertex);
+     if (blocks->stamp != NULL) free(blocks->stamp);
+     if (blocks->adjStart != NULL) free(blocks->adjStart);
+     if (blocks->adj != NULL) free(blocks->adj);
+     if (blocks->degree != NULL) free(blocks->degree);
+     if (blocks->dfi != NULL) free(blocks->dfi);
+     if (blocks->low != NULL) free(blocks->low);
+     if (blocks->parentEdge != NULL) free(blocks->parentEdge);
+     if (blocks->nextAdj != NULL) free(blocks->nextAdj);
+     if (blocks->vertexStack != NULL) free(blocks->vertexStack);
+     if (blocks->edgeStack != NULL) free(blocks->edgeStack);
+     if (blocks->arcs != NULL) free(blocks->arcs);
+     if (blocks->blockArcs != NULL) free(blocks->blockArcs);
+     if (blocks->blockStart != NULL) free(blocks->blockStart);
+
+     memset(blocks, 0, sizeof(blockStack));
+}
+
+/********************************************************************
+ _BlockStack_NumberVertices()
+
+ Numbers the endpoints of the given edges from zero, in the order first
+ seen, setting localIndex for each endpoint not yet marked with the
+ stampValue and localVertex for each number.  The arrays are passed
+ rather than taken from a stack so that threads searching different
+ components can each number them with arrays of their own.
+
+ Returns the number of vertices
+ ********************************************************************/
+
+int  _BlockStack_NumberVertices(graphP theGraph, int *arcs, int numArcs,
+                                int *localIndex, int *localVertex, int *stamp, int stampValue)
+{
+     int numVertices = 0, i, j, x;
+
+     for (i = 0; i < numArcs; i++)
+     {
+         for (j = 0; j < 2; j++)
+         {
+             x = gp_GetNeighbor(theGraph, arcs[i] ^ j);
+             if (stamp[x] != stampValue)
+             {
+                 stamp[x] = stampValue;
+                 localIndex[x] = numVertices;
+                 localVertex[numVertices] = x;
+                 numVertices++;
+             }
+         }
+     }
+
+     return numVertices;
+}
+
+/********************************************************************
+ _BlockStack_PushSearchableBlocks()
+
+ Finds the biconnected components of the edges in the arcs of the
+ stack, and pushes the ones that might contain the subgraph being
+ searched for.  The search is an iterative version of the lowpoint
+ computation of gp_LowpointAndLeastAncestor(), which does not need the
+ edges of the subset to be a graph of their own, and which pops the
+ edges of each component from an edge stack as soon as the lowpoint
+ of its first vertex below the cut vertex is known.
+ ********************************************************************/
+
+void _BlockStack_PushSearchableBlocks(graphP theGraph, blockStackP blocks)
+{
+     int numVertices = _BlockStack_NumberVertices(theGraph, blocks->arcs, blocks->numArcs,
+                                                  blocks->localIndex, blocks->localVertex,
+                                                  blocks->stamp, ++blocks->stampValue);
+     int numDFI = 0, vsp = 0, esp = 0;
+     int i, j, r, u, v, w, x;
+
+     // Build the adjacency arrays by counting sort
+     for (v = 0; v <= numVertices; v++)
+         blocks->adjStart[v] = 0;
+
+     for (i = 0; i < blocks->numArcs; i++)
+     {
+         blocks->adjStart[blocks->localIndex[gp_GetNeighbor(theGraph, blocks->arcs[i])]]++;
+         blocks->adjStart[blocks->localIndex[gp_GetNeighbor(theGraph, gp_GetTwinArc(theGraph, blocks->arcs[i]))]]++;
+     }
+
+     for (v = 0, j = 0; v <= numVertices; v++)
+     {
+         x = blocks->adjStart[v];
+         blocks->adjStart[v] = j;
+         j += x;
+     }
+
+     for (v = 0; v < numVertices; v++)
+     {
+         blocks->nextAdj[v] = blocks->adjStart[v];
+         blocks->dfi[v] = 0;
+         blocks->degree[v] = 0;
+     }
+
+     for (i = 0; i < blocks->numArcs; i++)
+     {
+         u = blocks->localIndex[gp_GetNeighbor(theGraph, gp_GetTwinArc(theGraph, blocks->arcs[i]))];
+         w = blocks->localIndex[gp_GetNeighbor(theGraph, blocks->arcs[i])];
+         blocks->adj[blocks->nextAdj[u]++] = 2*i+1;
+         blocks->adj[blocks->nextAdj[w]++] = 2*i;
+     }
+
+     for (v = 0; v < numVertices; v++)
+         blocks->nextAdj[v] = blocks->adjStart[v];
+
+     // Find the biconnected components by depth first search
+     for (r = 0; r < numVertices; r++)
+     {
+         if (blocks->dfi[r] != 0)
+             continue;
+
+         blocks->dfi[r] = blocks->low[r] = ++numDFI;
+         blocks->parentEdge[r] = -1;
+         blocks->vertexStack[vsp++] = r;
+
+         while (vsp > 0)
+         {
+             v = blocks->vertexStack[vsp-1];
+
+             if (blocks->nextAdj[v] < blocks->adjStart[v+1])
+             {
+                 x = blocks->adj[blocks->nextAdj[v]++];
+                 i = x >> 1;
+                 if (i == blocks->parentEdge[v])
+                     continue;
+
+                 w = blocks->localIndex[gp_GetNeighbor(theGraph, (x & 1) ? blocks->arcs[i] : gp_GetTwinArc(theGraph, blocks->arcs[i]))];
+
+                 if (blocks->dfi[w] == 0)
+                 {
+                     blocks->edgeStack[esp++] = i;
+                     blocks->parentEdge[w] = i;
+                     blocks->dfi[w] = blocks->low[w] = ++numDFI;
+                     blocks->vertexStack[vsp++] = w;
+                 }
+                 else if (blocks->dfi[w] < blocks->dfi[v])
+                 {
+                     blocks->edgeStack[esp++] = i;
+                     if (blocks->low[v] > blocks->dfi[w])
+                         blocks->low[v] = blocks->dfi[w];
+                 }
+             }
+             else
+             {
+                 vsp--;
+                 if (blocks->parentEdge[v] == -1)
+                     continue;
+
+                 u = blocks->vertexStack[vsp-1];
+                 if (blocks->low[u] > blocks->low[v])
+                     blocks->low[u] = blocks->low[v];
+
+                 if (blocks->low[v] >= blocks->dfi[u])
+                 {
+                     for (j = esp-1; blocks->edgeStack[j] != blocks->parentEdge[v]; j--)
+                         ;
+
+                     _BlockStack_PushIfSearchable(theGraph, blocks, blocks->edgeStack+j, esp-j);
+                     esp = j;
+                 }
+             }
+         }
+     }
+}
+
+/********************************************************************
+ _BlockStack_PushIfSearchable()
+
+ Pushes the arcs of the given edges of a biconnected component onto the
+ stack, unless the component has fewer than minBlockEdges edges or
+ fewer than minBranchVertices vertices of degree three or more.
+ ********************************************************************/
+
+void _BlockStack_PushIfSearchable(graphP theGraph, blockStackP blocks, int *blockEdges, int numBlockEdges)
+{
+     int numBranchVertices = 0, i, j, x;
+
+     if (numBlockEdges < blocks->minBlockEdges)
+         return;
+
+     for (i = 0; i < numBlockEdges; i++)
+         for (j = 0; j < 2; j++)
+         {
+             x = blocks->localIndex[gp_GetNeighbor(theGraph, blocks->arcs[blockEdges[i]] ^ j)];
+             if (++blocks->degree[x] == 3)
+                 numBranchVertices++;
+         }
+
+     for (i = 0; i < numBlockEdges; i++)
+         for (j = 0; j < 2; j++)
+             blocks->degree[blocks->localIndex[gp_GetNeighbor(theGraph, blocks->arcs[blockEdges[i]] ^ j)]] = 0;
+
+     if (numBranchVertices < blocks->minBranchVertices)
+         return;
+
+     blocks->blockStart[blocks->numBlocks++] = blocks->numBlockArcs;
+     for (i = 0; i < numBlockEdges; i++)
+         blocks->blockArcs[blocks->numBlockArcs++] = blocks->arcs[blockEdges[i]];
+}
+
+/********************************************************************
+ _BlockStack_Pop()
+
+ Pops the component on top of the stack into the arcs of the stack.
+ ********************************************************************/
+
+void _BlockStack_Pop(blockStackP blocks)
+{
+     int e;
+
+     blocks->numBlocks--;
+     blocks->numArcs = 0;
+     for (e = blocks->blockStart[blocks->numBlocks]; e < blocks->numBlockArcs; e++)
+         blocks->arcs[blocks->numArcs++] = blocks->blockArcs[e];
+     blocks->numBlockArcs = blocks->blockStart[blocks->numBlocks];
+}
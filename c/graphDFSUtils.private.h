@@ -0,0 +1,110 @@
+#ifndef GRAPH_DFSUTILS_PRIVATE_H
+#define GRAPH_DFSUTILS_PRIVATE_H
+
+/*
+Planarity-Related Graph Algorithms Project
+Copyright (c) 1997-2012, John M. Boyer
+All rights reserved. Includes a reference implementation of the following:
+
+* John M. Boyer. "Subgraph Homeomorphism via the Edge Addition Planarity Algorithm".
+  Journal of Graph Algorithms and Applications, Vol. 16, no. 2, pp. 381-410, 2012.
+  http://www.jgaa.info/16/268.html
+
+* John M. Boyer. "A New Method for Efficiently Generating Planar Graph
+  Visibility Representations". In P. Eades and P. Healy, editors,
+  Proceedings of the 13th International Conference on Graph Drawing 2005,
+  Lecture Notes Comput. Sci., Volume 3843, pp. 508-511, Springer-Verlag, 2006.
+
+* John M. Boyer and Wendy J. Myrvold. "On the Cutting Edge: Simplified O(n)
+  Planarity by Edge Addition". Journal of Graph Algorithms and Applications,
+  Vol. 8, No. 3, pp. 241-273, 2004.
+  http://www.jgaa.info/08/91.html
+
+* John M. Boyer. "Simplified O(n) Algorithms for Planar Graph Embedding,
+  Kuratowski Subgraph Isolation, and Related Problems". Ph.D. Dissertation,
+  University of Victoria, 2001.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+  list of conditions and the following disclaimer in the documentation and/or
+  other materials provided with the distribution.
+
+* Neither the name of the Planarity-Related Graph Algorithms Project nor the names
+  of its contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "graph.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/********************************************************************
+ The stack of biconnected components of graphDFSUtils.c
+
+ Algorithms that search one biconnected component at a time keep the
+ components that remain to be searched as a stack of segments of
+ blockArcs, which holds one arc of each edge.  The components of a
+ subset of the edges of the graph, given by one arc of each edge in
+ arcs, are found by a depth first search over adjacency arrays built
+ from the subset, in which entry 2i+1 of adj is the arc of edge i from
+ its first to its second endpoint and 2i is the reverse.
+
+ The vertices of the subset are numbered from zero in the order first
+ seen, using localIndex as marked by the stamp, and localVertex gives
+ the vertex of the graph for each number.
+
+ A component is only pushed if it has at least minBlockEdges edges and
+ at least minBranchVertices vertices of degree three or more, so that
+ the components that cannot contain the subgraph being searched for
+ are never searched at all.
+ */
+
+typedef struct
+{
+    int *localIndex, *localVertex, *stamp;
+    int stampValue;
+
+    int *adjStart, *adj, *degree;
+    int *dfi, *low, *parentEdge, *nextAdj, *vertexStack, *edgeStack;
+
+    int *arcs, numArcs;
+
+    int *blockArcs, *blockStart;
+    int numBlockArcs, numBlocks;
+
+    int minBlockEdges, minBranchVertices;
+
+} blockStack;
+
+typedef blockStack * blockStackP;
+
+int  _BlockStack_New(graphP theGraph, blockStackP blocks, int minBlockEdges, int minBranchVertices);
+void _BlockStack_Free(blockStackP blocks);
+int  _BlockStack_NumberVertices(graphP theGraph, int *arcs, int numArcs,
+                                int *localIndex, int *localVertex, int *stamp, int stampValue);
+void _BlockStack_PushSearchableBlocks(graphP theGraph, blockStackP blocks);
+void _BlockStack_Pop(blockStackP blocks);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,419 @@
+/*
+Planarity-Related Graph Algorithms Project
+Copyright (c) 1997-2012, John M. Boyer
+All rights reserved. Includes a reference implementation of the following:
+
+* John M. Boyer. "Subgraph Homeomorphism via the Edge Addition Planarity Algorithm".
+  Journal of Graph Algorithms and Applications, Vol. 16, no. 2, pp. 381-410, 2012.
+  http://www.jgaa.info/16/268.html
+
+* John M. Boyer. "A New Method for Efficiently Generating Planar Graph
+  Visibility Representations". In P. Eades and P. Healy, editors,
+  Proceedings of the 13th International Conference on Graph Drawing 2005,
+  Lecture Notes Comput. Sci., Volume 3843, pp. 508-511, Springer-Verlag, 2006.
+
+* John M. Boyer and Wendy J. Myrvold. "On the Cutting Edge: Simplified O(n)
+  Planarity by Edge Addition". Journal of Graph Algorithms and Applications,
+  Vol. 8, No. 3, pp. 241-273, 2004.
+  http://www.jgaa.info/08/91.html
+
+* John M. Boyer. "Simplified O(n) Algorithms for Planar Graph Embedding,
+  Kuratowski Subgraph Isolation, and Related Problems". Ph.D. Dissertation,
+  University of Victoria, 2001.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+  list of conditions and the following disclaimer in the documentation and/or
+  other materials provided with the distribution.
+
+* Neither the name of the Planarity-Related Graph Algorithms Project nor the names
+  of its contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "graph.h"
+
+/* Private functions, except exported within library */
+
+void _EdgeIndexInsert(graphP theGraph, int e);
+void _EdgeIndexRemove(graphP theGraph, int e);
+int  _EdgeIndexFindArc(constGraphP theGraph, int u, int v, int outOnly);
+int  _SuspendEdgeIndex(graphP theGraph);
+int  _RebuildEdgeIndex(graphP theGraph);
+
+/* Private functions */
+
+int  _EdgeIndexKeySlot(edgeHashIndexP theIndex, int u, int v);
+void _EdgeIndexPlace(edgeHashIndexP theIndex, int e, int u, int v);
+void _EdgeIndexClear(edgeHashIndexP theIndex);
+int  _EdgeIndexSetCapacity(edgeHashIndexP theIndex, int capacity);
+
+/********************************************************************
+ gp_AttachEdgeIndex()
+
+ Attaches an edge hash index to theGraph and fills it with the edges
+ in the adjacency lists, or refills it if one is already attached.
+ While the index is attached, gp_AddEdge(), gp_AddEdges(),
+ gp_InsertEdge(), gp_DeleteEdge(), edge hiding and restoring, and
+ vertex identification and restoration keep it up to date, so that
+ gp_IsNeighbor() and gp_GetNeighborEdgeRecord() answer in expected
+ constant time rather than by walking an adjacency list.  This pays
+ off for vertices of high degree; for a graph whose degrees are all
+ small, walking the short lists is typically faster than the hashing.
+
+ Operations that relabel or relink the adjacency lists wholesale, such
+ as gp_SortVertices() and gp_Embed(), suspend the upkeep and rebuild
+ the index once they finish.  Code that changes neighbor members or
+ list links directly should call this method again afterward.
+
+ The index is owned by theGraph, so gp_CopyGraph() and gp_DupGraph()
+ do not copy it, and gp_ReinitializeGraph() empties it.  It takes six
+ to twelve integers per edge.
+
+ Returns OK on success, NOTOK if theGraph is not initialized or on
+         allocation failure, in which case no index is attached
+ ********************************************************************/
+
+int  gp_AttachEdgeIndex(graphP theGraph)
+{
+     if (theGraph == NULL || theGraph->N == 0)
+         return NOTOK;
+
+     if (theGraph->edgeIndex == NULL)
+     {
+         if ((theGraph->edgeIndex = (edgeHashIndexP) malloc(sizeof(edgeHashIndex))) == NULL)
+             return NOTOK;
+
+         theGraph->edgeIndex->slots = NULL;
+         theGraph->edgeIndex->capacity = theGraph->edgeIndex->size = 0;
+         theGraph->edgeIndex->valid = FALSE;
+     }
+
+     if (_RebuildEdgeIndex(theGraph) != OK)
+     {
+         gp_DetachEdgeIndex(theGraph);
+         return NOTOK;
+     }
+
+     return OK;
+}
+
+/********************************************************************
+ gp_DetachEdgeIndex()
+
+ Frees the edge hash index of theGraph, if any, so that neighbor
+ queries go back to walking the adjacency lists.
+ ********************************************************************/
+
+void gp_DetachEdgeIndex(graphP theGraph)
+{
+     if (theGraph == NULL || theGraph->edgeIndex == NULL)
+         return;
+
+     if (theGraph->edgeIndex->slots != NULL)
+         free(theGraph->edgeIndex->slots);
+
+     free(theGraph->edgeIndex);
+     theGraph->edgeIndex = NULL;
+}
+
+/********************************************************************
+ _EdgeIndexKeySlot()
+
+ Returns the first slot to probe for the edges between u and v.  The
+ pair is ordered so that (u, v) and (v, u) hash alike, and the two
+ multiplicative hashes are mixed so that the low bits, which select
+ the slot, depend on the high bits of both products.
+ ********************************************************************/
+
+int  _EdgeIndexKeySlot(edgeHashIndexP theIndex, int u, int v)
+{
+unsigned int h;
+
+     if (u > v)
+     {
+         h = u; u = v; v = h;
+     }
+
+     h = (unsigned int) u * 2654435761u ^ (unsigned int) v * 2246822519u;
+     h ^= h >> 15;
+
+     return (int) (h & (unsigned int) (theIndex->capacity - 1));
+}
+
+/********************************************************************
+ _EdgeIndexPlace()
+
+ Stores the even arc e, which leads from u to v, in the first empty
+ slot of the probe sequence for u and v.  The caller ensures that the
+ table has an empty slot.
+ ********************************************************************/
+
+void _EdgeIndexPlace(edgeHashIndexP theIndex, int e, int u, int v)
+{
+int  mask = theIndex->capacity - 1;
+int  slot = _EdgeIndexKeySlot(theIndex, u, v);
+
+     while (theIndex->slots[3*slot] != NIL)
+         slot = (slot + 1) & mask;
+
+     theIndex->slots[3*slot] = e;
+     theIndex->slots[3*slot+1] = u;
+     theIndex->slots[3*slot+2] = v;
+     theIndex->size++;
+}
+
+/********************************************************************
+ _EdgeIndexClear()
+
+ Empties all slots of the edge index.
+ ********************************************************************/
+
+void _EdgeIndexClear(edgeHashIndexP theIndex)
+{
+#if NIL == 0
+     memset(theIndex->slots, NIL_CHAR, 3 * theIndex->capacity * sizeof(int));
+#else
+     int  slot;
+
+     for (slot = 0; slot < theIndex->capacity; slot++)
+          theIndex->slots[3*slot] = NIL;
+#endif
+     theIndex->size = 0;
+}
+
+/********************************************************************
+ _EdgeIndexSetCapacity()
+
+ Replaces the slots of the edge index with an empty table of the given
+ capacity, a power of two, then places the previously indexed edges.
+
+ Returns OK on success, NOTOK on allocation failure, in which case the
+         index is unchanged
+ ********************************************************************/
+
+int  _EdgeIndexSetCapacity(edgeHashIndexP theIndex, int capacity)
+{
+int  *oldSlots = theIndex->slots, oldCapacity = theIndex->capacity, slot;
+
+     if ((theIndex->slots = (int *) malloc(3 * capacity * sizeof(int))) == NULL)
+     {
+         theIndex->slots = oldSlots;
+         return NOTOK;
+     }
+
+     theIndex->capacity = capacity;
+     _EdgeIndexClear(theIndex);
+
+     if (oldSlots != NULL)
+     {
+         for (slot = 0; slot < oldCapacity; slot++)
+              if (oldSlots[3*slot] != NIL)
+                  _EdgeIndexPlace(theIndex, oldSlots[3*slot], oldSlots[3*slot+1], oldSlots[3*slot+2]);
+
+         free(oldSlots);
+     }
+
+     return OK;
+}
+
+/********************************************************************
+ _RebuildEdgeIndex()
+
+ Refills the edge index from the adjacency lists of all vertices and
+ virtual vertices, then resumes its upkeep.  Each edge is placed once,
+ from the list holding its even arc, and hidden edges are left out.
+ The table is kept at most half full.
+
+ Returns OK on success, NOTOK on allocation failure, in which case the
+         upkeep stays suspended
+ ********************************************************************/
+
+int  _RebuildEdgeIndex(graphP theGraph)
+{
+edgeHashIndexP theIndex = theGraph->edgeIndex;
+int  capacity = 16, v, e;
+
+     theIndex->valid = FALSE;
+
+     while (capacity < 2 * (theGraph->M + 1))
+         capacity <<= 1;
+
+     if (capacity > theIndex->capacity)
+     {
+         if (theIndex->slots != NULL)
+         {
+             free(theIndex->slots);
+             theIndex->slots = NULL;
+         }
+
+         if (_EdgeIndexSetCapacity(theIndex, capacity) != OK)
+             return NOTOK;
+     }
+     else
+         _EdgeIndexClear(theIndex);
+
+     for (v = gp_GetFirstVertex(theGraph); gp_VirtualVertexInRange(theGraph, v); v++)
+     {
+          e = gp_GetFirstArc(theGraph, v);
+          while (gp_IsArc(e))
+          {
+              if ((e & 1) == 0)
+                  _EdgeIndexPlace(theIndex, e, v, gp_GetNeighbor(theGraph, e));
+              e = gp_GetNextArc(theGraph, e);
+          }
+     }
+
+     theIndex->valid = TRUE;
+     return OK;
+}
+
+/********************************************************************
+ _SuspendEdgeIndex()
+
+ Stops the upkeep of the edge index, if one is attached and up to date,
+ so that an operation can rewrite the adjacency lists wholesale; the
+ neighbor queries walk the lists meanwhile.
+
+ Returns TRUE if the upkeep was suspended by this call, in which case
+         the caller resumes it with _RebuildEdgeIndex(); FALSE if there
+         is no index or an enclosing operation has already suspended it
+ ********************************************************************/
+
+int  _SuspendEdgeIndex(graphP theGraph)
+{
+     if (!gp_EdgeIndexActive(theGraph))
+         return FALSE;
+
+     theGraph->edgeIndex->valid = FALSE;
+     return TRUE;
+}
+
+/********************************************************************
+ _EdgeIndexInsert()
+
+ Adds the edge of arc e to the edge index, keyed by the current neighbor
+ members of e and its twin.  The table is doubled first if it would
+ become more than half full.  If it cannot be grown, the upkeep is
+ suspended rather than failing the edge operation.
+ ********************************************************************/
+
+void _EdgeIndexInsert(graphP theGraph, int e)
+{
+edgeHashIndexP theIndex = theGraph->edgeIndex;
+
+     if (2 * (theIndex->size + 1) > theIndex->capacity &&
+         _EdgeIndexSetCapacity(theIndex, 2 * theIndex->capacity) != OK)
+     {
+         theIndex->valid = FALSE;
+         return;
+     }
+
+     e &= ~1;
+     _EdgeIndexPlace(theIndex, e, gp_GetNeighbor(theGraph, gp_GetTwinArc(theGraph, e)),
+                                  gp_GetNeighbor(theGraph, e));
+}
+
+/********************************************************************
+ _EdgeIndexRemove()
+
+ Removes the edge of arc e from the edge index.  The neighbor members
+ of e and its twin must still be those with which it was indexed.
+ Rather than leave a tombstone, the later entries of the probe cluster
+ are shifted back into the gap whenever their probe sequences pass it.
+ ********************************************************************/
+
+void _EdgeIndexRemove(graphP theGraph, int e)
+{
+edgeHashIndexP theIndex = theGraph->edgeIndex;
+int  mask = theIndex->capacity - 1;
+int  gap = _EdgeIndexKeySlot(theIndex, gp_GetNeighbor(theGraph, e),
+                             gp_GetNeighbor(theGraph, gp_GetTwinArc(theGraph, e)));
+int  slot, home;
+
+     e &= ~1;
+     while (theIndex->slots[3*gap] != e)
+     {
+         if (theIndex->slots[3*gap] == NIL)
+         {
+             // Not indexed as expected, so stop trusting the index
+             theIndex->valid = FALSE;
+             return;
+         }
+         gap = (gap + 1) & mask;
+     }
+
+     slot = gap;
+     for (;;)
+     {
+         slot = (slot + 1) & mask;
+         if (theIndex->slots[3*slot] == NIL)
+             break;
+
+         // The entry can fill the gap unless its home lies cyclically
+         // after the gap and at or before its current slot
+         home = _EdgeIndexKeySlot(theIndex, theIndex->slots[3*slot+1], theIndex->slots[3*slot+2]);
+         if (((slot - home) & mask) >= ((slot - gap) & mask))
+         {
+             memcpy(theIndex->slots + 3*gap, theIndex->slots + 3*slot, 3 * sizeof(int));
+             gap = slot;
+         }
+     }
+
+     theIndex->slots[3*gap] = NIL;
+     theIndex->size--;
+}
+
+/********************************************************************
+ _EdgeIndexFindArc()
+
+ Looks up the edges between u and v and returns an arc in the
+ adjacency list of u whose neighbor is v.  If outOnly is TRUE, then an
+ arc whose direction is INONLY is not returned.  When there are
+ parallel edges, which of them gives the result is unspecified.
+
+ Returns the arc found, or NIL if there is none
+ ********************************************************************/
+
+int  _EdgeIndexFindArc(constGraphP theGraph, int u, int v, int outOnly)
+{
+edgeHashIndexP theIndex = theGraph->edgeIndex;
+int  mask = theIndex->capacity - 1;
+int  slot = _EdgeIndexKeySlot(theIndex, u, v), e;
+int  *entry;
+
+     while ((e = (entry = theIndex->slots + 3*slot)[0]) != NIL)
+     {
+         // The even arc e leads from entry[1] to entry[2]
+         if (entry[1] == u && entry[2] == v &&
+             (!outOnly || gp_GetDirection(theGraph, e) != EDGEFLAG_DIRECTION_INONLY))
+             return e;
+
+         if (entry[2] == u && entry[1] == v &&
+             (!outOnly || gp_GetDirection(theGraph, gp_GetTwinArc(theGraph, e)) != EDGEFLAG_DIRECTION_INONLY))
+             return gp_GetTwinArc(theGraph, e);
+
+         slot = (slot + 1) & mask;
+     }
+
+     return NIL;
+}
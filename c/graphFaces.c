@@ -0,0 +1,374 @@
+/*
+Planarity-Related Graph Algorithms Project
+Copyright (c) 1997-2012, John M. Boyer
+All rights reserved. Includes a reference implementation of the following:
+
+* John M. Boyer. "Subgraph Homeomorphism via the Edge Addition Planarity Algorithm".
+  Journal of Graph Algorithms and Applications, Vol. 16, no. 2, pp. 381-410, 2012.
+  http://www.jgaa.info/16/268.html
+
+* John M. Boyer. "A New Method for Efficiently Generating Planar Graph
+  Visibility Representations". In P. Eades and P. Healy, editors,
+  Proceedings of the 13th International Conference on Graph Drawing 2005,
+  Lecture Notes Comput. Sci., Volume 3843, pp. 508-511, Springer-Verlag, 2006.
+
+* John M. Boyer and Wendy J. Myrvold. "On the Cutting Edge: Simplified O(n)
+  Planarity by Edge Addition". Journal of Graph Algorithms and Applications,
+  Vol. 8, No. 3, pp. 241-273, 2004.
+  http://www.jgaa.info/08/91.html
+
+* John M. Boyer. "Simplified O(n) Algorithms for Planar Graph Embedding,
+  Kuratowski Subgraph Isolation, and Related Problems". Ph.D. Dissertation,
+  University of Victoria, 2001.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+  list of conditions and the following disclaimer in the documentation and/or
+  other materials provided with the distribution.
+
+* Neither the name of the Planarity-Related Graph Algorithms Project nor the names
+  of its contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdlib.h>
+
+#include "graph.h"
+
+/* Imported functions */
+
+extern int  _RebuildEdgeIndex(graphP theGraph);
+
+/* Private functions */
+
+int  _EnsureFacesCapacity(int **pArray, int *pCapacity, int requiredCapacity);
+
+/********************************************************************
+ gp_NewFaces()
+
+ Returns a new, empty face structure, or NULL on allocation failure
+ ********************************************************************/
+
+embeddingFacesP gp_NewFaces(void)
+{
+     embeddingFacesP theFaces = (embeddingFacesP) malloc(sizeof(embeddingFaces));
+
+     if (theFaces != NULL)
+     {
+         theFaces->numFaces = 0;
+         theFaces->outerFace = -1;
+         theFaces->faceStart = theFaces->faceArcs = theFaces->arcFace = NULL;
+         theFaces->faceStartCapacity = theFaces->faceArcsCapacity = theFaces->arcFaceCapacity = 0;
+     }
+
+     return theFaces;
+}
+
+/********************************************************************
+ gp_FreeFaces()
+
+ Frees the face structure and sets the pointer to it to NULL
+ ********************************************************************/
+
+void gp_FreeFaces(embeddingFacesP *pFaces)
+{
+     if (pFaces == NULL || *pFaces == NULL)
+         return;
+
+     if ((*pFaces)->faceStart != NULL)
+         free((*pFaces)->faceStart);
+     if ((*pFaces)->faceArcs != NULL)
+         free((*pFaces)->faceArcs);
+     if ((*pFaces)->arcFace != NULL)
+         free((*pFaces)->arcFace);
+
+     free(*pFaces);
+     *pFaces = NULL;
+}
+
+/********************************************************************
+ _EnsureFacesCapacity()
+
+ Grows one of the arrays of a face structure to at least the required
+ capacity.  The contents are not preserved since every array is fully
+ rewritten by gp_GetFaces().
+
+ Returns OK on success, NOTOK on allocation failure
+ ********************************************************************/
+
+int  _EnsureFacesCapacity(int **pArray, int *pCapacity, int requiredCapacity)
+{
+     if (*pCapacity >= requiredCapacity && *pArray != NULL)
+         return OK;
+
+     if (*pArray != NULL)
+         free(*pArray);
+
+     *pArray = (int *) malloc((requiredCapacity > 0 ? requiredCapacity : 1) * sizeof(int));
+     *pCapacity = *pArray == NULL ? 0 : requiredCapacity;
+
+     return *pArray == NULL ? NOTOK : OK;
+}
+
+/********************************************************************
+ gp_GetFaces()
+
+ Obtains the faces of the rotation system held by theGraph, such as the
+ embedding that results when gp_Embed() returns OK.
+
+ Each face is found by the same walk as _CheckEmbeddingFacialIntegrity()
+ uses: from an arc e, the next arc of the face is the successor of the
+ twin of e in the circular adjacency list of the vertex that e enters.
+ The arcs are scanned once in index order, and each arc not yet assigned
+ to a face starts the walk of a new face.  Since theFaces->arcFace both
+ records the result and marks the arcs already walked, neither the
+ graph's stack nor its edge visited flags are used, and theGraph is not
+ modified.
+
+ The external face of a connected component is the face containing the
+ first arc of its DFS tree root, as in _MarkExternalFaceVertices().  The
+ outerFace member gives this face for the first such component; for the
+ others, it is arcFace[gp_GetFirstArc(theGraph, r)] for each DFS tree
+ root r with a nonzero degree.
+
+ Returns OK on success, NOTOK on allocation failure or if the adjacency
+         lists do not form a rotation system
+ ********************************************************************/
+
+int  gp_GetFaces(constGraphP theGraph, embeddingFacesP theFaces)
+{
+int  EsizeOccupied, e, eStart, v, f, numArcs;
+int  *faceArcs, *arcFace;
+
+     if (theGraph == NULL || theFaces == NULL)
+         return NOTOK;
+
+     EsizeOccupied = gp_EdgeInUseIndexBound(theGraph);
+
+     // There are at most 2M faces, since each one has at least one arc
+     if (_EnsureFacesCapacity(&theFaces->faceStart, &theFaces->faceStartCapacity, 2*theGraph->M+1) != OK ||
+         _EnsureFacesCapacity(&theFaces->faceArcs, &theFaces->faceArcsCapacity, 2*theGraph->M) != OK ||
+         _EnsureFacesCapacity(&theFaces->arcFace, &theFaces->arcFaceCapacity, gp_EdgeIndexBound(theGraph)) != OK)
+         return NOTOK;
+
+     faceArcs = theFaces->faceArcs;
+     arcFace = theFaces->arcFace;
+
+     for (e = 0; e < EsizeOccupied; e++)
+          arcFace[e] = -1;
+
+     // Walk each face starting from its lowest numbered arc
+     f = numArcs = 0;
+     for (eStart = gp_GetFirstEdge(theGraph); eStart < EsizeOccupied; eStart++)
+     {
+          // Skip edge holes and arcs already in a face
+          if (!gp_EdgeInUse(theGraph, eStart) || arcFace[eStart] != -1)
+              continue;
+
+          theFaces->faceStart[f] = numArcs;
+          e = eStart;
+          do {
+               // An arc found twice in the walk, or in another face,
+               // means that the successor relation is not a permutation
+               if (arcFace[e] != -1 || numArcs == 2*theGraph->M)
+                   return NOTOK;
+
+               arcFace[e] = f;
+               faceArcs[numArcs++] = e;
+
+               e = gp_GetNextArcCircular(theGraph, gp_GetTwinArc(theGraph, e));
+          } while (e != eStart);
+
+          f++;
+     }
+
+     // There are M edges, so the faces must contain exactly 2M arcs
+     if (numArcs != 2*theGraph->M)
+         return NOTOK;
+
+     theFaces->faceStart[f] = numArcs;
+     theFaces->numFaces = f;
+
+     // Identify the external face of the first nontrivial component
+     theFaces->outerFace = -1;
+     for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
+     {
+          if (gp_IsDFSTreeRoot(theGraph, v) && gp_IsArc(gp_GetFirstArc(theGraph, v)))
+          {
+              theFaces->outerFace = arcFace[gp_GetFirstArc(theGraph, v)];
+              break;
+          }
+     }
+
+     return OK;
+}
+
+/********************************************************************
+ gp_WalkFace()
+
+ Stores in the caller's faceArcs array the arcs of the face of the
+ rotation system held by theGraph that contains arc e, in walk order
+ starting with e, using the same walk as gp_GetFaces().  Unlike
+ gp_GetFaces(), this answers for one face in time proportional to its
+ size, so it suits callers that want only a few faces, or that keep
+ the embedding shared among threads and each have their own faceArcs.
+
+ If the face has more than maxArcs arcs, then the walk stops once
+ maxArcs arcs are stored, and *pNumArcs is maxArcs.  An array of 2M
+ arcs always suffices.
+
+ Returns OK if the whole face was stored, NOTOK if it has more than
+         maxArcs arcs, or on invalid parameters
+ ********************************************************************/
+
+int  gp_WalkFace(constGraphP theGraph, int e, int *faceArcs, int maxArcs, int *pNumArcs)
+{
+int  eNext = e, numArcs = 0;
+
+     if (theGraph == NULL || faceArcs == NULL || pNumArcs == NULL ||
+         e < gp_GetFirstEdge(theGraph) || e >= gp_EdgeInUseIndexBound(theGraph) ||
+         !gp_EdgeInUse(theGraph, e))
+         return NOTOK;
+
+     do {
+          if (numArcs == maxArcs)
+          {
+              *pNumArcs = numArcs;
+              return NOTOK;
+          }
+
+          faceArcs[numArcs++] = eNext;
+          eNext = gp_GetNextArcCircular(theGraph, gp_GetTwinArc(theGraph, eNext));
+     } while (eNext != e);
+
+     *pNumArcs = numArcs;
+     return OK;
+}
+
+/********************************************************************
+ gp_BuildDualGraph()
+
+ Builds in dual the planar dual of the rotation system held by the
+ embedding graph, such as the embedding that results when gp_Embed()
+ returns OK.  The faces are obtained as by gp_GetFaces(), and face f is
+ dual vertex gp_GetFirstVertex(dual) + f.  Each edge of the embedding is crossed by one edge of
+ the dual, which is a loop if the edge is a bridge, and edges that
+ separate the same two faces give multiple edges in the dual.
+
+ The dual arc for an arc e of the embedding goes from the face containing
+ e to the face containing its twin.  The dual arcs are added to each
+ dual vertex in the walk order of its face, so the dual is itself a
+ rotation system whose faces correspond to the vertices of the embedding.
+
+ Dual edges are numbered in the order of the edges of the embedding, and
+ each dual arc has the parity of its primal arc.  So, if the embedding has
+ no edge holes, the dual arc for each arc e is e itself, and callers can
+ index edge data of the embedding and of the dual with the same arc index.
+ If arcToDualEdge is not NULL, then it receives the dual arc for each arc
+ below gp_EdgeInUseIndexBound(embedding), or NIL for edge holes.
+
+ The dual graph must either be a new graph from gp_New(), or one that was
+ initialized with as many vertices as the embedding has faces, such as
+ the dual of the same embedding from a prior call, in which case it is
+ reinitialized.  The external face of each connected component of the
+ embedding is a separate dual vertex, so the dual of a disconnected
+ embedding is disconnected.
+
+ Returns OK on success, NOTOK if the embedding has no edges, if its
+         adjacency lists do not form a rotation system, if the dual has
+         the wrong number of vertices, or on allocation failure
+ ********************************************************************/
+
+int  gp_BuildDualGraph(graphP embedding, graphP dual, int *arcToDualEdge)
+{
+embeddingFacesP theFaces = NULL;
+int  *dualArc = arcToDualEdge;
+int  EsizeOccupied, e, d, f, k, u, Result = OK;
+
+     if (embedding == NULL || dual == NULL || embedding->M == 0)
+         return NOTOK;
+
+     EsizeOccupied = gp_EdgeInUseIndexBound(embedding);
+
+     if ((theFaces = gp_NewFaces()) == NULL ||
+         gp_GetFaces(embedding, theFaces) != OK ||
+         (dualArc == NULL && (dualArc = (int *) malloc(EsizeOccupied * sizeof(int))) == NULL))
+         Result = NOTOK;
+
+     // Initialize or reinitialize the dual with one vertex per face
+     if (Result == OK)
+     {
+         if (dual->N == 0)
+         {
+             if (gp_EnsureArcCapacity(dual, 2*embedding->M) != OK ||
+                 gp_InitGraph(dual, theFaces->numFaces) != OK)
+                 Result = NOTOK;
+         }
+         else if (dual->N == theFaces->numFaces)
+         {
+             gp_ReinitializeGraph(dual);
+             if (gp_EnsureArcCapacity(dual, 2*embedding->M) != OK)
+                 Result = NOTOK;
+         }
+         else Result = NOTOK;
+     }
+
+     if (Result == OK)
+     {
+         // Number the dual arcs in the order of the edges, skipping edge holes
+         d = gp_GetFirstEdge(dual);
+         for (e = 0; e < gp_GetFirstEdge(embedding); e++)
+              dualArc[e] = NIL;
+         for (e = gp_GetFirstEdge(embedding); e < EsizeOccupied; e += 2)
+         {
+              if (gp_EdgeInUse(embedding, e))
+              {
+                  dualArc[e] = d;
+                  dualArc[e+1] = d+1;
+                  d += 2;
+              }
+              else dualArc[e] = dualArc[e+1] = NIL;
+         }
+
+         // Add the dual arcs to each dual vertex in the walk order of its face
+         for (f = 0; f < theFaces->numFaces; f++)
+         {
+              u = gp_GetFirstVertex(dual) + f;
+              for (k = theFaces->faceStart[f]; k < theFaces->faceStart[f+1]; k++)
+              {
+                   e = theFaces->faceArcs[k];
+                   d = dualArc[e];
+                   gp_SetNeighbor(dual, d, gp_GetFirstVertex(dual) + theFaces->arcFace[gp_GetTwinArc(embedding, e)]);
+                   gp_AttachLastArc(dual, u, d);
+              }
+         }
+
+         dual->M = embedding->M;
+
+         // A reinitialized dual keeps its edge index, if any, so refill it
+         if (gp_EdgeIndexActive(dual) && _RebuildEdgeIndex(dual) != OK)
+             Result = NOTOK;
+     }
+
+     if (dualArc != arcToDualEdge && dualArc != NULL)
+         free(dualArc);
+     gp_FreeFaces(&theFaces);
+
+     return Result;
+}
@@ -1,106 +1,134 @@
-#ifndef GRAPH_K33SEARCH_PRIVATE_H
-#define GRAPH_K33SEARCH_PRIVATE_H
-
-/*
-Planarity-Related Graph Algorithms Project
-Copyright (c) 1997-2012, John M. Boyer
-All rights reserved. Includes a reference implementation of the following:
-
-* John M. Boyer. "Subgraph Homeomorphism via the Edge Addition Planarity Algorithm".
-  Journal of Graph Algorithms and Applications, Vol. 16, no. 2, pp. 381-410, 2012.
-  http://www.jgaa.info/16/268.html
-
-* John M. Boyer. "A New Method for Efficiently Generating Planar Graph
-  Visibility Representations". In P. Eades and P. Healy, editors,
-  Proceedings of the 13th International Conference on Graph Drawing 2005,
-  Lecture Notes Comput. Sci., Volume 3843, pp. 508-511, Springer-Verlag, 2006.
-
-* John M. Boyer and Wendy J. Myrvold. "On the Cutting Edge: Simplified O(n)
-  Planarity by Edge Addition". Journal of Graph Algorithms and Applications,
-  Vol. 8, No. 3, pp. 241-273, 2004.
-  http://www.jgaa.info/08/91.html
-
-* John M. Boyer. "Simplified O(n) Algorithms for Planar Graph Embedding,
-  Kuratowski Subgraph Isolation, and Related Problems". Ph.D. Dissertation,
-  University of Victoria, 2001.
-
-Redistribution and use in source and binary forms, with or without modification,
-are permitted provided that the following conditions are met:
-
-* Redistributions of source code must retain the above copyright notice, this
-  list of conditions and the following disclaimer.
-
-* Redistributions in binary form must reproduce the above copyright notice, this
-  list of conditions and the following disclaimer in the documentation and/or
-  other materials provided with the distribution.
-
-* Neither the name of the Planarity-Related Graph Algorithms Project nor the names
-  of its contributors may be used to endorse or promote products derived from this
-  software without specific prior written permission.
-
-THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
-AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
-IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
-DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
-ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
-(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
-LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
-ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
-(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
-SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
-*/
-
-#include "graph.h"
-
-#ifdef __cplusplus
-extern "C" {
-#endif
-
-// Additional equipment for each EdgeRec
-typedef struct
-{
-     int  noStraddle, pathConnector;
-} K33Search_EdgeRec;
-
-typedef K33Search_EdgeRec * K33Search_EdgeRecP;
-
-// Additional equipment for each primary vertex
-typedef struct
-{
-        int separatedDFSChildList, backArcList, mergeBlocker;
-} K33Search_VertexInfo;
-
-typedef K33Search_VertexInfo * K33Search_VertexInfoP;
-
-
-typedef struct
-{
-    // Helps distinguish initialize from re-initialize
-    int initialized;
-
-    // The graph that this context augments
-    graphP theGraph;
-
-    // Parallel array for additional edge level equipment
-    K33Search_EdgeRecP E;
-
-    // Parallel array for additional vertex info level equipment
-    K33Search_VertexInfoP VI;
-
-    // Storage for the separatedDFSChildLists, and
-    // to help with linear time sorting of same by lowpoints
-    listCollectionP separatedDFSChildLists;
-    int *buckets;
-    listCollectionP bin;
-
-    // Overloaded function pointers
-    graphFunctionTable functions;
-
-} K33SearchContext;
-
-#ifdef __cplusplus
-}
-#endif
-
-#endif
-
+#ifndef GRAPH_K33SEARCH_PRIVATE_H
+#define GRAPH_K33SEARCH_PRIVATE_H
+
+/*
+Planarity-Related Graph Algorithms Project
+Copyright (c) 1997-2012, John M. Boyer
+All rights reserved. Includes a reference implementation of the following:
+
+* John M. Boyer. "Subgraph Homeomorphism via the Edge Addition Planarity Algorithm".
+  Journal of Graph Algorithms and Applications, Vol. 16, no. 2, pp. 381-410, 2012.
+  http://www.jgaa.info/16/268.html
+
+* John M. Boyer. "A New Method for Efficiently Generating Planar Graph
+  Visibility Representations". In P. Eades and P. Healy, editors,
+  Proceedings of the 13th International Conference on Graph Drawing 2005,
+  Lecture Notes Comput. Sci., Volume 3843, pp. 508-511, Springer-Verlag, 2006.
+
+* John M. Boyer and Wendy J. Myrvold. "On the Cutting Edge: Simplified O(n)
+  Planarity by Edge Addition". Journal of Graph Algorithms and Applications,
+  Vol. 8, No. 3, pp. 241-273, 2004.
+  http://www.jgaa.info/08/91.html
+
+* John M. Boyer. "Simplified O(n) Algorithms for Planar Graph Embedding,
+  Kuratowski Subgraph Isolation, and Related Problems". Ph.D. Dissertation,
+  University of Victoria, 2001.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+  list of conditions and the following disclaimer in the documentation and/or
+  other materials provided with the distribution.
+
+* Neither the name of the Planarity-Related Graph Algorithms Project nor the names
+  of its contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "graph.h"
+#include "graphDFSUtils.private.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Additional equipment for each EdgeRec
+typedef struct
+{
+     int  noStraddle, pathConnector;
+} K33Search_EdgeRec;
+
+typedef K33Search_EdgeRec * K33Search_EdgeRecP;
+
+// Additional equipment for each primary vertex
+typedef struct
+{
+        int separatedDFSChildList, backArcList, mergeBlocker;
+} K33Search_VertexInfo;
+
+typedef K33Search_VertexInfo * K33Search_VertexInfoP;
+
+
+typedef struct
+{
+    // Helps distinguish initialize from re-initialize
+    int initialized;
+
+    // The graph that this context augments
+    graphP theGraph;
+
+    // Parallel array for additional edge level equipment
+    K33Search_EdgeRecP E;
+
+    // Parallel array for additional vertex info level equipment
+    K33Search_VertexInfoP VI;
+
+    // Storage for the separatedDFSChildLists, and
+    // to help with linear time sorting of same by lowpoints
+    listCollectionP separatedDFSChildLists;
+    int *buckets;
+    listCollectionP bin;
+
+    // Overloaded function pointers
+    graphFunctionTable functions;
+
+} K33SearchContext;
+
+/* The work of gp_K33Search_SearchInBlocks() shared by its threads.  The
+   threads take the components of the stack of blocks in turn by
+   incrementing nextBlock, and stop taking them once stop is set, which
+   happens when a thread isolates a K3,3 homeomorph or fails.  The first
+   thread to isolate one sets foundBy to its thread number. */
+
+typedef struct
+{
+    graphP theGraph;
+    blockStackP blocks;
+    int nextBlock, stop, foundBy;
+} K33BlockSearchShared;
+
+/* The work of one thread of gp_K33Search_SearchInBlocks().  Each thread
+   numbers the vertices of the components it searches with arrays of its
+   own, and keeps the graph of the last component it searched, which
+   holds the K3,3 homeomorph if the thread found one. */
+
+typedef struct
+{
+    K33BlockSearchShared *shared;
+    int threadNumber;
+    int *localIndex, *localVertex, *stamp, stampValue;
+    graphP blockGraph;
+    int Result;
+} K33BlockSearchThread;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
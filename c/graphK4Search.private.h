@@ -1,103 +1,164 @@
-#ifndef GRAPH_K4SEARCH_PRIVATE_H
-#define GRAPH_K4SEARCH_PRIVATE_H
-
-/*
-Planarity-Related Graph Algorithms Project
-Copyright (c) 1997-2012, John M. Boyer
-All rights reserved. Includes a reference implementation of the following:
-
-* John M. Boyer. "Subgraph Homeomorphism via the Edge Addition Planarity Algorithm".
-  Journal of Graph Algorithms and Applications, Vol. 16, no. 2, pp. 381-410, 2012.
-  http://www.jgaa.info/16/268.html
-
-* John M. Boyer. "A New Method for Efficiently Generating Planar Graph
-  Visibility Representations". In P. Eades and P. Healy, editors,
-  Proceedings of the 13th International Conference on Graph Drawing 2005,
-  Lecture Notes Comput. Sci., Volume 3843, pp. 508-511, Springer-Verlag, 2006.
-
-* John M. Boyer and Wendy J. Myrvold. "On the Cutting Edge: Simplified O(n)
-  Planarity by Edge Addition". Journal of Graph Algorithms and Applications,
-  Vol. 8, No. 3, pp. 241-273, 2004.
-  http://www.jgaa.info/08/91.html
-
-* John M. Boyer. "Simplified O(n) Algorithms for Planar Graph Embedding,
-  Kuratowski Subgraph Isolation, and Related Problems". Ph.D. Dissertation,
-  University of Victoria, 2001.
-
-Redistribution and use in source and binary forms, with or without modification,
-are permitted provided that the following conditions are met:
-
-* Redistributions of source code must retain the above copyright notice, this
-  list of conditions and the following disclaimer.
-
-* Redistributions in binary form must reproduce the above copyright notice, this
-  list of conditions and the following disclaimer in the documentation and/or
-  other materials provided with the distribution.
-
-* Neither the name of the Planarity-Related Graph Algorithms Project nor the names
-  of its contributors may be used to endorse or promote products derived from this
-  software without specific prior written permission.
-
-THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
-AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
-IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
-DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
-ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
-(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
-LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
-ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
-(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
-SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
-*/
-
-#include "graph.h"
-
-#ifdef __cplusplus
-extern "C" {
-#endif
-
-/* Additional equipment for each EdgeRec
-
-   pathConnector:
-      Used in the edge records (arcs) of a reduction edge to indicate the
-      endpoints of a path that has been reduced from (removed from) the
+#ifndef GRAPH_K4SEARCH_PRIVATE_H
+#define GRAPH_K4SEARCH_PRIVATE_H
+
+/*
+Planarity-Related Graph Algorithms Project
+Copyright (c) 1997-2012, John M. Boyer
+All rights reserved. Includes a reference implementation of the following:
+
+* John M. Boyer. "Subgraph Homeomorphism via the Edge Addition Planarity Algorithm".
+  Journal of Graph Algorithms and Applications, Vol. 16, no. 2, pp. 381-410, 2012.
+  http://www.jgaa.info/16/268.html
+
+* John M. Boyer. "A New Method for Efficiently Generating Planar Graph
+  Visibility Representations". In P. Eades and P. Healy, editors,
+  Proceedings of the 13th International Conference on Graph Drawing 2005,
+  Lecture Notes Comput. Sci., Volume 3843, pp. 508-511, Springer-Verlag, 2006.
+
+* John M. Boyer and Wendy J. Myrvold. "On the Cutting Edge: Simplified O(n)
+  Planarity by Edge Addition". Journal of Graph Algorithms and Applications,
+  Vol. 8, No. 3, pp. 241-273, 2004.
+  http://www.jgaa.info/08/91.html
+
+* John M. Boyer. "Simplified O(n) Algorithms for Planar Graph Embedding,
+  Kuratowski Subgraph Isolation, and Related Problems". Ph.D. Dissertation,
+  University of Victoria, 2001.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+  list of conditions and the following disclaimer in the documentation and/or
+  other materials provided with the distribution.
+
+* Neither the name of the Planarity-Related Graph Algorithms Project nor the names
+  of its contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "graph.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Additional equipment for each EdgeRec
+
+   pathConnector:
+      Used in the edge records (arcs) of a reduction edge to indicate the
+      endpoints of a path that has been reduced from (removed from) the
       embedding so that the search for a K4 can continue.
-	  We only need a pathConnector because we reduce subgraphs that are
-	  separable by a 2-cut, so they can contribute at most one path to a
-	  subgraph homeomorphic to K4, if one is indeed found. Thus, we first
-	  delete all edges except for the desired path(s), then we reduce any
-	  retained path to an edge.
- */
-typedef struct
-{
-     int pathConnector;
-} K4Search_EdgeRec;
-
-typedef K4Search_EdgeRec * K4Search_EdgeRecP;
-
-/* Additional equipment for each vertex: None */
-
-typedef struct
-{
-    // Helps distinguish initialize from re-initialize
-    int initialized;
-
-    // The graph that this context augments
-    graphP theGraph;
-
-    // Parallel array for additional edge level equipment
-    K4Search_EdgeRecP E;
-
-    // Overloaded function pointers
-    graphFunctionTable functions;
-
-    // Internal variable for converting a tail recursion into a simple loop
-    int handlingBlockedBicomp;
-
-} K4SearchContext;
-
-#ifdef __cplusplus
-}
-#endif
-
-#endif
+	  We only need a pathConnector because we reduce subgraphs that are
+	  separable by a 2-cut, so they can contribute at most one path to a
+	  subgraph homeomorphic to K4, if one is indeed found. Thus, we first
+	  delete all edges except for the desired path(s), then we reduce any
+	  retained path to an edge.
+ */
+typedef struct
+{
+     int pathConnector;
+} K4Search_EdgeRec;
+
+typedef K4Search_EdgeRec * K4Search_EdgeRecP;
+
+/* The layout of a node of the series-parallel decomposition tree */
+
+#define K4SEARCH_SPNODE_TYPE    0
+#define K4SEARCH_SPNODE_S       1
+#define K4SEARCH_SPNODE_T       2
+#define K4SEARCH_SPNODE_CHILD1  3
+#define K4SEARCH_SPNODE_CHILD2  4
+#define K4SEARCH_SPNODE_SIZE    5
+
+/* Additional equipment for each vertex: None */
+
+/* The working arrays of the series-parallel decomposition of a graph
+   that has no subgraph homeomorphic to K4.
+
+   The biconnected components are found by a depth first search over the
+   adjacency arrays built from the edge list, in which arc 2e goes from
+   endpoint 2e to endpoint 2e+1 of edge e, and arc 2e+1 is its reverse.
+
+   Each biconnected component is reduced to a single virtual edge by
+   series and parallel reductions. Each virtual edge ve has the two half
+   edges 2ve and 2ve+1, held in the incidence lists of its endpoints, and
+   it represents the subtree of the decomposition tree rooted by spNode.
+ */
+typedef struct
+{
+    // Adjacency arrays and the state of the depth first search
+    int *adjStart, *adj;
+    int *dfi, *low, *parentEdge, *nextAdj;
+    int *vertexStack, *edgeStack;
+
+    // Virtual edges and the incidence lists of the vertices
+    int *end, *spNode, *nextHalf, *prevHalf;
+    int *firstHalf, *degree;
+    int numVirtualEdges;
+
+    // The vertices of the current component, the degree two vertices
+    // waiting to be reduced, and vertex markings used to find parallel edges
+    int *blockVertices, *reducible, *stamp, *stampEdge;
+    int stampValue;
+
+} K4SPWorkspace;
+
+typedef struct
+{
+    // Helps distinguish initialize from re-initialize
+    int initialized;
+
+    // The graph that this context augments
+    graphP theGraph;
+
+    // Parallel array for additional edge level equipment
+    K4Search_EdgeRecP E;
+
+    // Overloaded function pointers
+    graphFunctionTable functions;
+
+    // Internal variable for converting a tail recursion into a simple loop
+    int handlingBlockedBicomp;
+
+    // The endpoints of the edges of theGraph, recorded before the K4 search
+    // reduces any of them, and the number of edges
+    int *edgeList;
+    int numEdges;
+
+    // The series-parallel decomposition tree, built when the K4 search
+    // finds no K4 homeomorph. Each node takes K4SEARCH_SPNODE_SIZE ints,
+    // giving its type, its two terminal vertices and its two children.
+    // Node i < numEdges is the edge leaf for edge i of edgeList.
+    // The roots are the nodes representing whole biconnected components.
+    int *spNodes;
+    int numSPNodes;
+    int *spRoots;
+    int numSPRoots;
+
+    // The union of the types of non-outerplanarity minors encountered by
+    // the K4 search. If none were encountered, then the graph is outerplanar,
+    // and if minor A or B was encountered, then the graph has a subgraph
+    // homeomorphic to K_{2,3}
+    int minorTypesFound;
+
+} K4SearchContext;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,1725 @@
+/*
+Planarity-Related Graph Algorithms Project
+Copyright (c) 1997-2012, John M. Boyer
+All rights reserved. Includes a reference implementation of the following:
+
+* John M. Boyer. "Subgraph Homeomorphism via the Edge Addition Planarity Algorithm".
+  Journal of Graph Algorithms and Applications, Vol. 16, no. 2, pp. 381-410, 2012.
+  http://www.jgaa.info/16/268.html
+
+* John M. Boyer. "A New Method for Efficiently Generating Planar Graph
+  Visibility Representations". In P. Eades and P. Healy, editors,
+  Proceedings of the 13th International Conference on Graph Drawing 2005,
+  Lecture Notes Comput. Sci., Volume 3843, pp. 508-511, Springer-Verlag, 2006.
+
+* John M. Boyer and Wendy J. Myrvold. "On the Cutting Edge: Simplified O(n)
+  Planarity by Edge Addition". Journal of Graph Algorithms and Applications,
+  Vol. 8, No. 3, pp. 241-273, 2004.
+  http://www.jgaa.info/08/91.html
+
+* John M. Boyer. "Simplified O(n) Algorithms for Planar Graph Embedding,
+  Kuratowski Subgraph Isolation, and Related Problems". Ph.D. Dissertation,
+  University of Victoria, 2001.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+  list of conditions and the following disclaimer in the documentation and/or
+  other materials provided with the distribution.
+
+* Neither the name of the Planarity-Related Graph Algorithms Project nor the names
+  of its contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdlib.h>
+
+#include "graphK5Search.h"
+#include "graphK5Search.private.h"
+#include "graphSPQRTree.h"
+
+#include "graph.h"
+
+/* Imported functions */
+
+extern int  _IsolateKuratowskiSubgraph(graphP theGraph, int v, int R);
+
+/* Private functions (exported to system) */
+
+int  _SearchForK5InBicomp(graphP theGraph, K5SearchContext *context, int v, int R);
+int  _SearchForK5InGraph(graphP theGraph, K5SearchContext *context);
+
+/* Private functions */
+
+graphP _K5Search_NewSPQRTree(graphP theGraph, K5SearchContext *context);
+int  _K5Search_CreateWorkspace(K5SearchWorkspace *ws, graphP theGraph, K5SearchContext *context, int maxSkeletonEdges);
+void _K5Search_FreeWorkspace(K5SearchWorkspace *ws);
+
+int  _K5Search_GetSkeleton(graphP theTreeGraph, int node, K5SearchWorkspace *ws);
+int  _K5Search_SearchSkeleton(K5SearchWorkspace *ws);
+int  _K5Search_EmbedSkeleton(K5SearchWorkspace *ws);
+void _K5Search_BuildFlowNetwork(K5SearchWorkspace *ws);
+void _K5Search_AddFlowArc(K5SearchWorkspace *ws, int from, int to);
+int  _K5Search_IsLinked(K5SearchWorkspace *ws, int i, int j);
+int  _K5Search_CountDisjointPaths(K5SearchWorkspace *ws, int a, int b, int limit);
+int  _K5Search_CountFanPaths(K5SearchWorkspace *ws, int a, int *targets, int numTargets);
+
+int  _K5Search_TryNearbyBranchVertices(K5SearchWorkspace *ws);
+int  _K5Search_GetNearCandidates(K5SearchWorkspace *ws, int *sources, int numSources, int *near, int maxNear);
+int  _K5Search_NegotiatePaths(K5SearchWorkspace *ws);
+int  _K5Search_FindLeastCostPath(K5SearchWorkspace *ws, int k, long presentFactor);
+void _K5Search_SetPathOccupancy(K5SearchWorkspace *ws, int k, int delta);
+void _K5Search_HeapUp(K5SearchWorkspace *ws, int i);
+void _K5Search_HeapDown(K5SearchWorkspace *ws, int i);
+
+int  _K5Search_TryAllBranchVertices(K5SearchWorkspace *ws);
+void _K5Search_BeginBranchVertices(K5SearchWorkspace *ws);
+void _K5Search_EndBranchVertices(K5SearchWorkspace *ws);
+int  _K5Search_TestBranchVertices(K5SearchWorkspace *ws);
+int  _K5Search_RoutePaths(K5SearchWorkspace *ws, int k);
+int  _K5Search_HasCapacity(K5SearchWorkspace *ws, int k);
+int  _K5Search_HasFans(K5SearchWorkspace *ws, int k);
+int  _K5Search_GetNextPathVertex(K5SearchWorkspace *ws, int u, int b, int *pTried);
+void _K5Search_MarkReachable(K5SearchWorkspace *ws, int b);
+int  _K5Search_GetEdge(K5SearchWorkspace *ws, int u, int w);
+int  _K5Search_IsAdjacent(K5SearchWorkspace *ws, int u, int w);
+
+void _K5Search_AddPathsToWitness(K5SearchWorkspace *ws);
+void _K5Search_AddWitnessEdge(K5SearchWorkspace *ws, int u, int w);
+void _K5Search_AddVirtualEdgePath(K5SearchWorkspace *ws, int a, int b);
+void _K5Search_LabelSplitComponents(K5SearchWorkspace *ws);
+
+int  _K5Search_ReplaceEdges(graphP theGraph, int *edgeList, int numEdges);
+
+/****************************************************************************
+ _SearchForK5InBicomp()
+
+ The Walkdown has been blocked in the bicomp rooted by R, so the core
+ planarity algorithm isolates a K5 or K_{3,3} homeomorph.  If it is a K5,
+ then the search is done.  Otherwise, the context is marked so that the
+ postprocessing of gp_Embed() can search the input graph for a K5.
+
+ Returns NONEMBEDDABLE to terminate the Walkdown, NOTOK on internal error
+ ****************************************************************************/
+
+int  _SearchForK5InBicomp(graphP theGraph, K5SearchContext *context, int v, int R)
+{
+     if (_IsolateKuratowskiSubgraph(theGraph, v, R) != OK)
+         return NOTOK;
+
+     // Only the K5 case of minor E leaves the minor type without any of
+     // the additional bits that indicate the isolation of a K_{3,3}
+     if (theGraph->IC.minorType != MINORTYPE_E)
+         context->k33Isolated = TRUE;
+
+     return NONEMBEDDABLE;
+}
+
+/****************************************************************************
+ _SearchForK5InGraph()
+
+ A K_{3,3} homeomorph was isolated, which proves nonplanarity but does not
+ decide whether the input graph contains a K5 homeomorph.  The input graph,
+ as recorded by _K5Search_EmbeddingInitialize(), is therefore reduced to
+ its triconnected components by gp_SPQRTree(), and the skeleton of each
+ R-node is searched.
+
+ The reduction preserves K5 homeomorphs.  Since K5 is 3-connected, all
+ branch vertices of a K5 homeomorph lie on one side of each separation
+ pair {u, v}, and the other side carries at most one of its paths, which
+ the virtual edge (u, v) replaces.  Conversely, the other side of each
+ virtual edge contains a path joining u and v, so a K5 homeomorph of a
+ skeleton yields one of the input graph.  The skeletons of S-nodes and
+ P-nodes are cycles and bonds, which contain no K5 homeomorph.
+
+ Cost: the reduction takes linear time, and so does the dismissal of each
+ skeleton that is planar or has fewer than five vertices of degree four or
+ more.  The search of the remaining skeletons is described with
+ _K5Search_SearchSkeleton().
+
+ Returns NONEMBEDDABLE if a K5 homeomorph is found, in which case theGraph
+               is reduced to the edges of the K5 homeomorph
+         OK if there is no K5 homeomorph, in which case theGraph is restored
+               to the edges of the input graph
+         NOTOK on internal error
+ ****************************************************************************/
+
+int  _SearchForK5InGraph(graphP theGraph, K5SearchContext *context)
+{
+     K5SearchWorkspace ws;
+     graphP theTreeGraph;
+     int numNodes, maxSkeletonEdges, i, RetVal = OK;
+
+     if ((theTreeGraph = _K5Search_NewSPQRTree(theGraph, context)) == NULL)
+         return NOTOK;
+
+     numNodes = gp_SPQRTree_GetNumNodes(theTreeGraph);
+     maxSkeletonEdges = 0;
+     for (i = 0; i < numNodes; i++)
+     {
+          if (gp_SPQRTree_GetNodeType(theTreeGraph, i) == SPQRTREE_RNODE &&
+              maxSkeletonEdges < gp_SPQRTree_GetNumSkeletonEdges(theTreeGraph, i))
+              maxSkeletonEdges = gp_SPQRTree_GetNumSkeletonEdges(theTreeGraph, i);
+     }
+
+     if (_K5Search_CreateWorkspace(&ws, theGraph, context, maxSkeletonEdges) != OK)
+     {
+         gp_Free(&theTreeGraph);
+         return NOTOK;
+     }
+
+     for (i = 0; i < numNodes && RetVal == OK; i++)
+     {
+          if (gp_SPQRTree_GetNodeType(theTreeGraph, i) != SPQRTREE_RNODE)
+              continue;
+
+          if (_K5Search_GetSkeleton(theTreeGraph, i, &ws) != OK)
+              RetVal = NOTOK;
+          else
+              RetVal = _K5Search_SearchSkeleton(&ws);
+
+          while (ws.N > 0)
+               ws.localVertex[ws.vertex[--ws.N]] = -1;
+     }
+
+     if (RetVal == NONEMBEDDABLE)
+     {
+         if (_K5Search_ReplaceEdges(theGraph, ws.witness, ws.witnessSize) != OK)
+             RetVal = NOTOK;
+     }
+     else if (RetVal == OK)
+     {
+         if (_K5Search_ReplaceEdges(theGraph, context->edgeList, context->numEdges) != OK)
+             RetVal = NOTOK;
+     }
+
+     _K5Search_FreeWorkspace(&ws);
+     gp_Free(&theTreeGraph);
+     return RetVal;
+}
+
+/****************************************************************************
+ _K5Search_NewSPQRTree()
+
+ Creates a graph with the vertices of theGraph and the recorded edges of
+ the input graph, omitting loops, and obtains its SPQR trees.  The vertex
+ numbering of the new graph, and hence of the skeletons, is that of
+ theGraph.
+
+ Returns the new graph, or NULL on internal error
+ ****************************************************************************/
+
+graphP _K5Search_NewSPQRTree(graphP theGraph, K5SearchContext *context)
+{
+     graphP theTreeGraph = gp_New();
+     int *edgeList = context->edgeList;
+     int e;
+
+     if (theTreeGraph == NULL)
+         return NULL;
+
+     if (gp_EnsureArcCapacity(theTreeGraph, 2*context->numEdges) != OK ||
+         gp_InitGraph(theTreeGraph, theGraph->N) != OK)
+     {
+         gp_Free(&theTreeGraph);
+         return NULL;
+     }
+
+     for (e = 0; e < context->numEdges; e++)
+     {
+          if (edgeList[2*e] != edgeList[2*e+1] &&
+              gp_AddEdge(theTreeGraph, edgeList[2*e], 0, edgeList[2*e+1], 0) != OK)
+          {
+              gp_Free(&theTreeGraph);
+              return NULL;
+          }
+     }
+
+     if (gp_SPQRTree(theTreeGraph) != OK)
+         gp_Free(&theTreeGraph);
+
+     return theTreeGraph;
+}
+
+/****************************************************************************
+ _K5Search_CreateWorkspace()
+
+ The integer arrays of the workspace are carved from a single allocation,
+ which is owned by the adjStart member.  The skeleton arrays are sized by
+ the number of vertices of theGraph, since skeleton vertices are distinct
+ vertices of theGraph, and by the largest number of skeleton edges.
+ ****************************************************************************/
+
+int  _K5Search_CreateWorkspace(K5SearchWorkspace *ws, graphP theGraph, K5SearchContext *context, int maxSkeletonEdges)
+{
+     int Vsize = gp_PrimaryVertexIndexBound(theGraph);
+     int N = theGraph->N, M = context->numEdges, S = maxSkeletonEdges;
+     int *edgeList = context->edgeList;
+     int u, w, e, j, *p;
+
+     memset(ws, 0, sizeof(K5SearchWorkspace));
+
+     p = (int *) malloc((6*Vsize + 1 + 4*M + 48*N + 1 + 21*S) * sizeof(int));
+     if (p == NULL)
+         return NOTOK;
+
+     ws->pathCost = (long *) malloc(N * sizeof(long));
+     if (ws->pathCost == NULL)
+     {
+         free(p);
+         return NOTOK;
+     }
+
+     ws->adjStart = p;        p += Vsize + 1;
+     ws->adjList = p;         p += 2*M;
+     ws->localVertex = p;     p += Vsize;
+     ws->component = p;       p += Vsize;
+     ws->componentAttach = p; p += 2*Vsize;
+     ws->componentParent = p; p += Vsize;
+
+     ws->vertex = p;          p += N;
+     ws->edges = p;           p += 2*S;
+     ws->isVirtual = p;       p += S;
+     ws->start = p;           p += N + 1;
+     ws->neighbors = p;       p += 2*S;
+     ws->neighborEdge = p;    p += 2*S;
+     ws->candidates = p;      p += N;
+     ws->candidateIndex = p;  p += N;
+     ws->seeds = p;           p += N;
+     ws->paths = p;           p += 10*N;
+     ws->cursors = p;         p += 10*N;
+     ws->isBranch = p;        p += N;
+     ws->isUsed = p;          p += N;
+     ws->isOnPath = p;        p += N;
+     ws->reachStamp = p;      p += N;
+     ws->queue = p;           p += N;
+     ws->distance = p;        p += N;
+     ws->pathCandidates = p;  p += 2*S;
+     ws->occupancy = p;       p += N;
+     ws->history = p;         p += N;
+     ws->heap = p;            p += N;
+     ws->heapPos = p;         p += N;
+     ws->pathParent = p;      p += N;
+     ws->flowHead = p;        p += 2*N;
+     ws->flowParent = p;      p += 2*N;
+     ws->flowQueue = p;       p += 2*N;
+     ws->flowTarget = p;      p += 2*N + 4*S;
+     ws->flowNext = p;        p += 2*N + 4*S;
+     ws->flowCapacity = p;    p += 2*N + 4*S;
+     ws->witness = p;
+
+     ws->firstVertex = gp_GetFirstVertex(theGraph);
+     ws->vertexIndexBound = Vsize;
+
+     // Build the adjacency arrays of the input graph, omitting loops
+     for (u = 0; u <= Vsize; u++)
+          ws->adjStart[u] = 0;
+
+     for (e = 0; e < M; e++)
+     {
+          u = edgeList[2*e];
+          w = edgeList[2*e+1];
+          if (u != w)
+          {
+              ws->adjStart[u+1]++;
+              ws->adjStart[w+1]++;
+          }
+     }
+
+     for (u = 1; u <= Vsize; u++)
+          ws->adjStart[u] += ws->adjStart[u-1];
+
+     // The component parents serve as cursors until the split components
+     // of a skeleton are labeled
+     for (u = 0; u < Vsize; u++)
+     {
+          ws->componentParent[u] = ws->adjStart[u];
+          ws->localVertex[u] = -1;
+     }
+
+     for (e = 0; e < M; e++)
+     {
+          u = edgeList[2*e];
+          w = edgeList[2*e+1];
+          if (u != w)
+          {
+              j = ws->componentParent[u]++;
+              ws->adjList[j] = w;
+              j = ws->componentParent[w]++;
+              ws->adjList[j] = u;
+          }
+     }
+
+     return OK;
+}
+
+/****************************************************************************
+ _K5Search_FreeWorkspace()
+ ****************************************************************************/
+
+void _K5Search_FreeWorkspace(K5SearchWorkspace *ws)
+{
+     if (ws->adjStart != NULL)
+     {
+         free(ws->adjStart);
+         ws->adjStart = NULL;
+     }
+
+     if (ws->pathCost != NULL)
+     {
+         free(ws->pathCost);
+         ws->pathCost = NULL;
+     }
+}
+
+/****************************************************************************
+ _K5Search_GetSkeleton()
+
+ Renumbers the vertices of the skeleton of the given SPQR tree node from 0
+ into the workspace, along with its edges, marking the virtual ones.
+
+ Returns OK on success, NOTOK on internal error
+ ****************************************************************************/
+
+int  _K5Search_GetSkeleton(graphP theTreeGraph, int node, K5SearchWorkspace *ws)
+{
+     int numSkeletonEdges = gp_SPQRTree_GetNumSkeletonEdges(theTreeGraph, node);
+     int ends[2], j, i, x, e, adjacentNode;
+
+     ws->N = ws->M = 0;
+     ws->componentsLabeled = FALSE;
+
+     for (j = 0; j < numSkeletonEdges; j++)
+     {
+          if (gp_SPQRTree_GetSkeletonEdge(theTreeGraph, node, j, &ends[0], &ends[1], &e, &adjacentNode) != OK)
+              return NOTOK;
+
+          for (i = 0; i < 2; i++)
+          {
+               x = ends[i];
+               if (ws->localVertex[x] < 0)
+               {
+                   ws->localVertex[x] = ws->N;
+                   ws->vertex[ws->N++] = x;
+               }
+               ws->edges[2*ws->M+i] = ws->localVertex[x];
+          }
+
+          ws->isVirtual[ws->M] = e == NIL ? TRUE : FALSE;
+          ws->M++;
+     }
+
+     return OK;
+}
+
+/****************************************************************************
+ _K5Search_SearchSkeleton()
+
+ Searches the skeleton in the workspace for a K5 homeomorph, treating its
+ virtual edges as edges.
+
+ The core planarity algorithm is first run on the skeleton, which dismisses
+ a planar skeleton and finds a K5 homeomorph if it happens to isolate one.
+ Otherwise, _K5Search_TryNearbyBranchVertices() tries sets of five nearby
+ vertices of degree four or more as branch vertices, which quickly finds
+ the K5 homeomorphs of large sparse skeletons in which some are present.
+ Finally, _K5Search_TryAllBranchVertices() decides the skeleton.
+
+ Cost: the final search is exponential in the worst case, since it may try
+ O(C^5) sets of branch vertices, where C is the number of candidates, and
+ enumerate many paths for each.  The search is nonetheless exhaustive, so
+ the result is always decided.
+
+ Returns NONEMBEDDABLE if a K5 homeomorph was found, in which case its
+               edges are in the workspace witness
+         OK if the skeleton has no K5 homeomorph
+         NOTOK on internal error
+ ****************************************************************************/
+
+int  _K5Search_SearchSkeleton(K5SearchWorkspace *ws)
+{
+     int u, w, i, RetVal;
+
+     // A K5 homeomorph has ten edges and five vertices of degree four or more
+     if (ws->M < 10 || ws->N < 5)
+         return OK;
+
+     // Build the adjacency arrays of the skeleton, recording the skeleton
+     // edge that joins each vertex to each of its neighbors
+     for (u = 0; u <= ws->N; u++)
+          ws->start[u] = 0;
+
+     for (i = 0; i < ws->M; i++)
+     {
+          ws->start[ws->edges[2*i]+1]++;
+          ws->start[ws->edges[2*i+1]+1]++;
+     }
+
+     for (u = 1; u <= ws->N; u++)
+          ws->start[u] += ws->start[u-1];
+
+     for (u = 0; u < ws->N; u++)
+          ws->cursors[u] = ws->start[u];
+
+     for (i = 0; i < ws->M; i++)
+     {
+          u = ws->edges[2*i];
+          w = ws->edges[2*i+1];
+          ws->neighborEdge[ws->cursors[u]] = i;
+          ws->neighbors[ws->cursors[u]++] = w;
+          ws->neighborEdge[ws->cursors[w]] = i;
+          ws->neighbors[ws->cursors[w]++] = u;
+     }
+
+     // Collect the candidate branch vertices, in descending order of degree
+     ws->numCandidates = 0;
+     for (u = 0; u < ws->N; u++)
+     {
+          ws->candidateIndex[u] = -1;
+          if (ws->start[u+1] - ws->start[u] < 4)
+              continue;
+
+          for (i = ws->numCandidates; i > 0; i--)
+          {
+              w = ws->candidates[i-1];
+              if (ws->start[w+1] - ws->start[w] >= ws->start[u+1] - ws->start[u])
+                  break;
+              ws->candidates[i] = w;
+          }
+          ws->candidates[i] = u;
+          ws->numCandidates++;
+     }
+
+     if (ws->numCandidates < 5)
+         return OK;
+
+     for (i = 0; i < ws->numCandidates; i++)
+          ws->candidateIndex[ws->candidates[i]] = i;
+
+     // Planar skeletons are dismissed, and if the planarity algorithm
+     // happens to isolate a K5 homeomorph, then the search is done
+     ws->witnessSize = 0;
+     RetVal = _K5Search_EmbedSkeleton(ws);
+     if (RetVal != NONEMBEDDABLE || ws->witnessSize > 0)
+         return RetVal;
+
+     // Otherwise, prepare to try sets of five candidates as branch vertices
+     for (u = 0; u < ws->N; u++)
+     {
+          ws->isBranch[u] = ws->isUsed[u] = ws->isOnPath[u] = FALSE;
+          ws->reachStamp[u] = 0;
+     }
+     ws->stamp = 0;
+
+     _K5Search_BuildFlowNetwork(ws);
+
+     ws->linked = NULL;
+     if (ws->numCandidates <= K5SEARCH_MAXLINKEDCANDIDATES)
+     {
+         ws->linked = (char *) calloc(ws->numCandidates * ws->numCandidates, sizeof(char));
+         if (ws->linked == NULL)
+             return NOTOK;
+     }
+
+     RetVal = _K5Search_TryNearbyBranchVertices(ws);
+     if (RetVal == OK)
+         RetVal = _K5Search_TryAllBranchVertices(ws);
+
+     if (ws->linked != NULL)
+     {
+         free(ws->linked);
+         ws->linked = NULL;
+     }
+
+     return RetVal;
+}
+
+/****************************************************************************
+ _K5Search_EmbedSkeleton()
+
+ Runs the core planarity algorithm on a copy of the skeleton in the
+ workspace.  If a K5 homeomorph is isolated, its edges are put in the
+ workspace witness.  If a K_{3,3} homeomorph is isolated, its vertices of
+ degree three are recorded as the seeds of the search for nearby branch
+ vertices.
+
+ Returns the result of gp_Embed(), or NOTOK on internal error
+ ****************************************************************************/
+
+int  _K5Search_EmbedSkeleton(K5SearchWorkspace *ws)
+{
+     graphP theSkeleton = gp_New();
+     int first, v, e, i, degree, RetVal;
+
+     if (theSkeleton == NULL)
+         return NOTOK;
+
+     if (gp_EnsureArcCapacity(theSkeleton, 2*ws->M) != OK ||
+         gp_InitGraph(theSkeleton, ws->N) != OK)
+     {
+         gp_Free(&theSkeleton);
+         return NOTOK;
+     }
+
+     first = gp_GetFirstVertex(theSkeleton);
+     for (i = 0; i < ws->M; i++)
+     {
+          if (gp_AddEdge(theSkeleton, ws->edges[2*i]+first, 0, ws->edges[2*i+1]+first, 0) != OK)
+          {
+              gp_Free(&theSkeleton);
+              return NOTOK;
+          }
+     }
+
+     ws->numSeeds = 0;
+     RetVal = gp_Embed(theSkeleton, EMBEDFLAGS_PLANAR);
+
+     if (RetVal == NONEMBEDDABLE)
+     {
+         if (gp_SortVertices(theSkeleton) != OK)
+             RetVal = NOTOK;
+         else
+         {
+             for (v = first; gp_VertexInRange(theSkeleton, v); v++)
+             {
+                  degree = 0;
+                  e = gp_GetFirstArc(theSkeleton, v);
+                  while (gp_IsArc(e))
+                  {
+                      if (theSkeleton->IC.minorType == MINORTYPE_E && v < gp_GetNeighbor(theSkeleton, e))
+                          _K5Search_AddWitnessEdge(ws, v-first, gp_GetNeighbor(theSkeleton, e)-first);
+                      degree++;
+                      e = gp_GetNextArc(theSkeleton, e);
+                  }
+
+                  if (degree >= 3)
+                      ws->seeds[ws->numSeeds++] = v-first;
+             }
+         }
+     }
+
+     gp_Free(&theSkeleton);
+     return RetVal;
+}
+
+/****************************************************************************
+ _K5Search_BuildFlowNetwork()
+
+ Builds the unit capacity flow network used to count internally disjoint
+ paths in the skeleton.  Each vertex v is split into an in-node 2v and an
+ out-node 2v+1 joined by an arc, and each edge (u, w) becomes the arcs
+ from the out-node of each endpoint to the in-node of the other.  Each arc
+ is stored at an even index, and its residual arc at the next odd index.
+ ****************************************************************************/
+
+void _K5Search_BuildFlowNetwork(K5SearchWorkspace *ws)
+{
+     int v, i;
+
+     for (v = 0; v < 2*ws->N; v++)
+          ws->flowHead[v] = -1;
+     ws->numFlowArcs = 0;
+
+     for (v = 0; v < ws->N; v++)
+          _K5Search_AddFlowArc(ws, 2*v, 2*v+1);
+
+     for (i = 0; i < ws->M; i++)
+     {
+          _K5Search_AddFlowArc(ws, 2*ws->edges[2*i]+1, 2*ws->edges[2*i+1]);
+          _K5Search_AddFlowArc(ws, 2*ws->edges[2*i+1]+1, 2*ws->edges[2*i]);
+     }
+}
+
+/****************************************************************************
+ _K5Search_AddFlowArc()
+ ****************************************************************************/
+
+void _K5Search_AddFlowArc(K5SearchWorkspace *ws, int from, int to)
+{
+     int k = ws->numFlowArcs;
+
+     ws->flowTarget[k] = to;
+     ws->flowNext[k] = ws->flowHead[from];
+     ws->flowHead[from] = k;
+
+     ws->flowTarget[k+1] = from;
+     ws->flowNext[k+1] = ws->flowHead[to];
+     ws->flowHead[to] = k+1;
+
+     ws->numFlowArcs += 2;
+}
+
+/****************************************************************************
+ _K5Search_IsLinked()
+
+ Determines whether the candidates at positions i < j of the candidate list
+ are joined by four internally disjoint paths, which every pair of branch
+ vertices of a K5 homeomorph must be.  The result is memoized when the
+ number of candidates is small enough.
+ ****************************************************************************/
+
+int  _K5Search_IsLinked(K5SearchWorkspace *ws, int i, int j)
+{
+     char *pLinked = ws->linked == NULL ? NULL : ws->linked + i*ws->numCandidates + j;
+
+     if (pLinked != NULL && *pLinked != 0)
+         return *pLinked == 1 ? TRUE : FALSE;
+
+     if (_K5Search_CountDisjointPaths(ws, ws->candidates[i], ws->candidates[j], 4) >= 4)
+     {
+         if (pLinked != NULL)
+             *pLinked = 1;
+         return TRUE;
+     }
+
+     if (pLinked != NULL)
+         *pLinked = 2;
+     return FALSE;
+}
+
+/****************************************************************************
+ _K5Search_CountDisjointPaths()
+
+ Counts the internally disjoint paths from a to b, up to the given limit,
+ by finding augmenting paths in the flow network.
+ ****************************************************************************/
+
+int  _K5Search_CountDisjointPaths(K5SearchWorkspace *ws, int a, int b, int limit)
+{
+     int source = 2*a+1, sink = 2*b;
+     int count, head, tail, x, k;
+
+     for (k = 0; k < ws->numFlowArcs; k++)
+          ws->flowCapacity[k] = (k & 1) ? 0 : 1;
+
+     for (count = 0; count < limit; count++)
+     {
+          for (x = 0; x < 2*ws->N; x++)
+               ws->flowParent[x] = -1;
+
+          head = tail = 0;
+          ws->flowQueue[tail++] = source;
+          while (head < tail && ws->flowParent[sink] < 0)
+          {
+               x = ws->flowQueue[head++];
+               for (k = ws->flowHead[x]; k >= 0; k = ws->flowNext[k])
+               {
+                    if (ws->flowCapacity[k] > 0 && ws->flowTarget[k] != source &&
+                        ws->flowParent[ws->flowTarget[k]] < 0)
+                    {
+                        ws->flowParent[ws->flowTarget[k]] = k;
+                        ws->flowQueue[tail++] = ws->flowTarget[k];
+                    }
+               }
+          }
+
+          if (ws->flowParent[sink] < 0)
+              break;
+
+          for (x = sink; x != source; x = ws->flowTarget[k ^ 1])
+          {
+               k = ws->flowParent[x];
+               ws->flowCapacity[k]--;
+               ws->flowCapacity[k ^ 1]++;
+          }
+     }
+
+     return count;
+}
+
+/****************************************************************************
+ _K5Search_CountFanPaths()
+
+ Counts the paths from a to distinct targets that are disjoint except at a
+ and that only pass through free vertices.  Each target absorbs one path,
+ which is equivalent to joining the in-node of each target to a common sink.
+ ****************************************************************************/
+
+int  _K5Search_CountFanPaths(K5SearchWorkspace *ws, int a, int *targets, int numTargets)
+{
+     int source = 2*a+1, sink = -1;
+     int count, head, tail, x, k, v, i;
+     int absorbed[4] = { FALSE, FALSE, FALSE, FALSE };
+
+     // Only the arcs between the in-node and out-node of free vertices
+     // are given capacity, and those are the first arcs in the network
+     for (k = 0; k < ws->numFlowArcs; k++)
+          ws->flowCapacity[k] = (k & 1) ? 0 : 1;
+
+     for (v = 0; v < ws->N; v++)
+          if (ws->isBranch[v] || ws->isUsed[v] || ws->isOnPath[v])
+              ws->flowCapacity[2*v] = 0;
+
+     for (count = 0; count < numTargets; count++)
+     {
+          for (x = 0; x < 2*ws->N; x++)
+               ws->flowParent[x] = -1;
+
+          sink = -1;
+          head = tail = 0;
+          ws->flowQueue[tail++] = source;
+          while (head < tail && sink < 0)
+          {
+               x = ws->flowQueue[head++];
+               for (k = ws->flowHead[x]; k >= 0 && sink < 0; k = ws->flowNext[k])
+               {
+                    if (ws->flowCapacity[k] > 0 && ws->flowTarget[k] != source &&
+                        ws->flowParent[ws->flowTarget[k]] < 0)
+                    {
+                        ws->flowParent[ws->flowTarget[k]] = k;
+                        ws->flowQueue[tail++] = ws->flowTarget[k];
+
+                        for (i = 0; i < numTargets; i++)
+                             if (!absorbed[i] && ws->flowTarget[k] == 2*targets[i])
+                             {
+                                 absorbed[i] = TRUE;
+                                 sink = ws->flowTarget[k];
+                                 break;
+                             }
+                    }
+               }
+          }
+
+          if (sink < 0)
+              break;
+
+          for (x = sink; x != source; x = ws->flowTarget[k ^ 1])
+          {
+               k = ws->flowParent[x];
+               ws->flowCapacity[k]--;
+               ws->flowCapacity[k ^ 1]++;
+          }
+     }
+
+     return count;
+}
+
+/****************************************************************************
+ _K5Search_TryNearbyBranchVertices()
+
+ In a large sparse skeleton, such as a grid with a few long edges added,
+ a K5 homeomorph typically has its branch vertices close together, and
+ only some of its paths take long detours through the edges that make the
+ skeleton nonplanar.  So, the K5SEARCH_MAXSEEDS candidates nearest to the
+ seeds recorded by _K5Search_EmbedSkeleton() are each tried as a branch
+ vertex together with each four of the K5SEARCH_NEARCANDIDATES candidates
+ nearest to it.  The paths are sought by _K5Search_NegotiatePaths(), which
+ takes polynomial time but may miss paths that exist, so this phase only
+ finds K5 homeomorphs quickly and leaves the decision to the final search.
+
+ Returns NONEMBEDDABLE if a K5 homeomorph was found, OK if not
+ ****************************************************************************/
+
+int  _K5Search_TryNearbyBranchVertices(K5SearchWorkspace *ws)
+{
+     int seeds[K5SEARCH_MAXSEEDS], near[K5SEARCH_NEARCANDIDATES+1], index[4];
+     int numSeeds, numNear, s, i, j, linked, RetVal;
+
+     numSeeds = _K5Search_GetNearCandidates(ws, ws->seeds, ws->numSeeds, seeds, K5SEARCH_MAXSEEDS);
+
+     for (s = 0; s < numSeeds; s++)
+     {
+          // The seed is the candidate nearest to itself, so it is near[0]
+          numNear = _K5Search_GetNearCandidates(ws, &seeds[s], 1, near, K5SEARCH_NEARCANDIDATES+1);
+          if (numNear < 5)
+              continue;
+
+          ws->branch[0] = near[0];
+          for (i = 0; i < 4; i++)
+               index[i] = i+1;
+
+          while (TRUE)
+          {
+               for (i = 0; i < 4; i++)
+                    ws->branch[i+1] = near[index[i]];
+
+               linked = TRUE;
+               for (i = 0; i < 5 && linked; i++)
+                    for (j = i+1; j < 5 && linked; j++)
+                    {
+                         if (ws->candidateIndex[ws->branch[i]] < ws->candidateIndex[ws->branch[j]])
+                             linked = _K5Search_IsLinked(ws, ws->candidateIndex[ws->branch[i]], ws->candidateIndex[ws->branch[j]]);
+                         else
+                             linked = _K5Search_IsLinked(ws, ws->candidateIndex[ws->branch[j]], ws->candidateIndex[ws->branch[i]]);
+                    }
+
+               if (linked && (RetVal = _K5Search_NegotiatePaths(ws)) != OK)
+                   return RetVal;
+
+               // Advance to the next four of the nearby candidates
+               for (i = 3; i >= 0 && index[i] == numNear - 4 + i; i--)
+                    ;
+               if (i < 0)
+                   break;
+
+               index[i]++;
+               for (i++; i < 4; i++)
+                    index[i] = index[i-1] + 1;
+          }
+     }
+
+     return OK;
+}
+
+/****************************************************************************
+ _K5Search_GetNearCandidates()
+
+ Gets up to maxNear candidates in ascending order of their distance from
+ the nearest of the given source vertices, by breadth first search.
+
+ Returns the number of candidates obtained
+ ****************************************************************************/
+
+int  _K5Search_GetNearCandidates(K5SearchWorkspace *ws, int *sources, int numSources, int *near, int maxNear)
+{
+     int head = 0, tail = 0, numNear = 0, u, w, j;
+
+     ws->stamp++;
+     for (j = 0; j < numSources; j++)
+     {
+          ws->reachStamp[sources[j]] = ws->stamp;
+          ws->queue[tail++] = sources[j];
+     }
+
+     while (head < tail && numNear < maxNear)
+     {
+          u = ws->queue[head++];
+          if (ws->candidateIndex[u] >= 0)
+              near[numNear++] = u;
+
+          for (j = ws->start[u]; j < ws->start[u+1]; j++)
+          {
+               w = ws->neighbors[j];
+               if (ws->reachStamp[w] != ws->stamp)
+               {
+                   ws->reachStamp[w] = ws->stamp;
+                   ws->queue[tail++] = w;
+               }
+          }
+     }
+
+     return numNear;
+}
+
+/****************************************************************************
+ _K5Search_NegotiatePaths()
+
+ Seeks the paths joining the branch vertices in the workspace by negotiated
+ congestion, as in the PathFinder router of McMurchie and Ebeling.  In each
+ round, the path of each pair is replaced by a least cost path, in which
+ a vertex costs more the more other paths use it and the more rounds it
+ has been overused.  The paths are found once no vertex is used by two of
+ them.  Each round takes O(M log N) time per pair, and the search gives up
+ after K5SEARCH_NEGOTIATIONROUNDS rounds.
+
+ Returns NONEMBEDDABLE if the paths were found, in which case the edges of
+         the K5 homeomorph are put in the workspace witness, or OK if not
+ ****************************************************************************/
+
+int  _K5Search_NegotiatePaths(K5SearchWorkspace *ws)
+{
+     long presentFactor = 1;
+     int round, k, v, numOverused;
+     int RetVal = OK;
+
+     _K5Search_BeginBranchVertices(ws);
+
+     if (_K5Search_HasCapacity(ws, 0) && _K5Search_HasFans(ws, 0))
+     {
+         for (v = 0; v < ws->N; v++)
+              ws->occupancy[v] = ws->history[v] = 0;
+
+         for (k = 0; k < ws->numPairs; k++)
+              ws->pathLength[k] = 0;
+
+         for (round = 0; round < K5SEARCH_NEGOTIATIONROUNDS; round++)
+         {
+              for (k = 0; k < ws->numPairs; k++)
+              {
+                   _K5Search_SetPathOccupancy(ws, k, -1);
+                   if (!_K5Search_FindLeastCostPath(ws, k, presentFactor))
+                       break;
+                   _K5Search_SetPathOccupancy(ws, k, 1);
+              }
+
+              if (k < ws->numPairs)
+                  break;
+
+              numOverused = 0;
+              for (v = 0; v < ws->N; v++)
+              {
+                   if (ws->occupancy[v] > 1)
+                   {
+                       ws->history[v]++;
+                       numOverused++;
+                   }
+              }
+
+              if (numOverused == 0)
+              {
+                  _K5Search_AddPathsToWitness(ws);
+                  RetVal = NONEMBEDDABLE;
+                  break;
+              }
+
+              presentFactor *= 3;
+         }
+     }
+
+     _K5Search_EndBranchVertices(ws);
+     return RetVal;
+}
+
+/****************************************************************************
+ _K5Search_FindLeastCostPath()
+
+ Replaces the path of pair k by a least cost path found by Dijkstra's
+ algorithm, which only passes through vertices that are not branch vertices.
+ Entering a vertex w costs (1 + history) * (2 + presentFactor * occupancy),
+ where the occupancy of w counts the paths of the other pairs that use it.
+
+ Returns TRUE if a path was found, FALSE otherwise
+ ****************************************************************************/
+
+int  _K5Search_FindLeastCostPath(K5SearchWorkspace *ws, int k, long presentFactor)
+{
+     int a = ws->pairs[k][0], b = ws->pairs[k][1];
+     int *path = ws->paths + k*ws->N;
+     int u, w, j, length;
+     long cost;
+
+     for (u = 0; u < ws->N; u++)
+     {
+          ws->pathCost[u] = -1;
+          ws->heapPos[u] = -1;
+     }
+
+     ws->pathCost[a] = 0;
+     ws->pathParent[a] = -1;
+     ws->heap[0] = a;
+     ws->heapPos[a] = 0;
+     ws->heapSize = 1;
+
+     while (ws->heapSize > 0)
+     {
+          // Remove the least cost vertex u from the heap
+          u = ws->heap[0];
+          ws->heapPos[u] = -2;
+          if (--ws->heapSize > 0)
+          {
+              ws->heap[0] = ws->heap[ws->heapSize];
+              ws->heapPos[ws->heap[0]] = 0;
+              _K5Search_HeapDown(ws, 0);
+          }
+
+          if (u == b)
+              break;
+
+          for (j = ws->start[u]; j < ws->start[u+1]; j++)
+          {
+               w = ws->neighbors[j];
+               if (ws->heapPos[w] == -2 || (ws->isBranch[w] && w != b))
+                   continue;
+
+               cost = ws->pathCost[u];
+               if (w != b)
+                   cost += (1 + ws->history[w]) * (2 + presentFactor * ws->occupancy[w]);
+
+               if (ws->pathCost[w] < 0 || cost < ws->pathCost[w])
+               {
+                   ws->pathCost[w] = cost;
+                   ws->pathParent[w] = u;
+                   if (ws->heapPos[w] < 0)
+                   {
+                       ws->heap[ws->heapSize] = w;
+                       ws->heapPos[w] = ws->heapSize++;
+                   }
+                   _K5Search_HeapUp(ws, ws->heapPos[w]);
+               }
+          }
+     }
+
+     if (ws->heapPos[b] != -2)
+         return FALSE;
+
+     length = 0;
+     for (u = b; u != -1; u = ws->pathParent[u])
+          length++;
+
+     ws->pathLength[k] = length;
+     for (u = b; u != -1; u = ws->pathParent[u])
+          path[--length] = u;
+
+     return TRUE;
+}
+
+/****************************************************************************
+ _K5Search_SetPathOccupancy()
+ Adds delta to the occupancy of the internal vertices of the path of pair k
+ ****************************************************************************/
+
+void _K5Search_SetPathOccupancy(K5SearchWorkspace *ws, int k, int delta)
+{
+     int *path = ws->paths + k*ws->N;
+     int i;
+
+     for (i = 1; i < ws->pathLength[k] - 1; i++)
+          ws->occupancy[path[i]] += delta;
+}
+
+/****************************************************************************
+ _K5Search_HeapUp()
+ ****************************************************************************/
+
+void _K5Search_HeapUp(K5SearchWorkspace *ws, int i)
+{
+     int u = ws->heap[i], parent;
+
+     while (i > 0)
+     {
+          parent = (i-1) / 2;
+          if (ws->pathCost[ws->heap[parent]] <= ws->pathCost[u])
+              break;
+
+          ws->heap[i] = ws->heap[parent];
+          ws->heapPos[ws->heap[i]] = i;
+          i = parent;
+     }
+
+     ws->heap[i] = u;
+     ws->heapPos[u] = i;
+}
+
+/****************************************************************************
+ _K5Search_HeapDown()
+ ****************************************************************************/
+
+void _K5Search_HeapDown(K5SearchWorkspace *ws, int i)
+{
+     int u = ws->heap[i], child;
+
+     while ((child = 2*i + 1) < ws->heapSize)
+     {
+          if (child+1 < ws->heapSize &&
+              ws->pathCost[ws->heap[child+1]] < ws->pathCost[ws->heap[child]])
+              child++;
+
+          if (ws->pathCost[u] <= ws->pathCost[ws->heap[child]])
+              break;
+
+          ws->heap[i] = ws->heap[child];
+          ws->heapPos[ws->heap[i]] = i;
+          i = child;
+     }
+
+     ws->heap[i] = u;
+     ws->heapPos[u] = i;
+}
+
+/****************************************************************************
+ _K5Search_TryAllBranchVertices()
+
+ Each pair of branch vertices must be joined by four internally disjoint
+ paths, so the sets of five candidates that are pairwise linked in this
+ way are generated by backtracking, and each is tested exhaustively by
+ _K5Search_TestBranchVertices().
+
+ Returns NONEMBEDDABLE if a K5 homeomorph was found, OK if not
+ ****************************************************************************/
+
+int  _K5Search_TryAllBranchVertices(K5SearchWorkspace *ws)
+{
+     int index[5];
+     int i, d, RetVal = OK;
+
+     d = 0;
+     index[0] = 0;
+     while (d >= 0)
+     {
+          if (index[d] > ws->numCandidates - 5 + d)
+          {
+              if (--d >= 0)
+                  index[d]++;
+              continue;
+          }
+
+          for (i = 0; i < d; i++)
+               if (!_K5Search_IsLinked(ws, index[i], index[d]))
+                   break;
+
+          if (i < d)
+              index[d]++;
+
+          else if (d < 4)
+          {
+              d++;
+              index[d] = index[d-1] + 1;
+          }
+
+          else
+          {
+              for (i = 0; i < 5; i++)
+                   ws->branch[i] = ws->candidates[index[i]];
+
+              if ((RetVal = _K5Search_TestBranchVertices(ws)) != OK)
+                  break;
+
+              index[d]++;
+          }
+     }
+
+     return RetVal;
+}
+
+/****************************************************************************
+ _K5Search_BeginBranchVertices()
+
+ Marks the five branch vertices in the workspace and collects the pairs of
+ them that are not adjacent.  An edge between two branch vertices is always
+ the best path for them since it uses no other vertices, so paths are only
+ sought for the pairs of non-adjacent branch vertices.
+ ****************************************************************************/
+
+void _K5Search_BeginBranchVertices(K5SearchWorkspace *ws)
+{
+     int i, j;
+
+     for (i = 0; i < 5; i++)
+          ws->isBranch[ws->branch[i]] = TRUE;
+
+     ws->numPairs = 0;
+     for (i = 0; i < 5; i++)
+          for (j = i+1; j < 5; j++)
+               if (!_K5Search_IsAdjacent(ws, ws->branch[i], ws->branch[j]))
+               {
+                   ws->pairs[ws->numPairs][0] = ws->branch[i];
+                   ws->pairs[ws->numPairs][1] = ws->branch[j];
+                   ws->numPairs++;
+               }
+}
+
+/****************************************************************************
+ _K5Search_EndBranchVertices()
+ ****************************************************************************/
+
+void _K5Search_EndBranchVertices(K5SearchWorkspace *ws)
+{
+     int i;
+
+     for (i = 0; i < 5; i++)
+          ws->isBranch[ws->branch[i]] = FALSE;
+}
+
+/****************************************************************************
+ _K5Search_TestBranchVertices()
+
+ Tests whether the five branch vertices in the workspace can be joined by
+ ten internally disjoint paths.
+
+ Returns NONEMBEDDABLE if the paths were found, in which case the edges of
+         the K5 homeomorph are put in the workspace witness, or OK if not
+ ****************************************************************************/
+
+int  _K5Search_TestBranchVertices(K5SearchWorkspace *ws)
+{
+     int RetVal = OK;
+
+     _K5Search_BeginBranchVertices(ws);
+
+     if (_K5Search_RoutePaths(ws, 0))
+     {
+         _K5Search_AddPathsToWitness(ws);
+         RetVal = NONEMBEDDABLE;
+     }
+
+     _K5Search_EndBranchVertices(ws);
+     return RetVal;
+}
+
+/****************************************************************************
+ _K5Search_RoutePaths()
+
+ Seeks internally disjoint paths for the pairs of branch vertices from
+ index k onward, given the paths already found for the preceding pairs.
+ The paths for pair k are enumerated by an iterative depth first search,
+ and the search recurses on pair k+1 each time a path is found.
+
+ Only induced paths are enumerated, since a path with a chord can be
+ shortcut to use a subset of its vertices.  Also, the search only extends
+ a path to vertices from which the path can still reach its end vertex.
+
+ Returns TRUE if the paths were found, FALSE otherwise
+ ****************************************************************************/
+
+int  _K5Search_RoutePaths(K5SearchWorkspace *ws, int k)
+{
+     int *path, *cursor;
+     int a, b, u, w, i, length;
+
+     if (k == ws->numPairs)
+         return TRUE;
+
+     if (!_K5Search_HasCapacity(ws, k))
+         return FALSE;
+
+     if (!_K5Search_HasFans(ws, k))
+         return FALSE;
+
+     a = ws->pairs[k][0];
+     b = ws->pairs[k][1];
+     path = ws->paths + k*ws->N;
+     cursor = ws->cursors + k*ws->N;
+
+     path[0] = a;
+     cursor[0] = 0;
+     ws->isOnPath[a] = TRUE;
+     length = 1;
+
+     while (length > 0)
+     {
+          u = path[length-1];
+          w = _K5Search_GetNextPathVertex(ws, u, b, &cursor[length-1]);
+
+          // A path to b was found, so try to route the remaining pairs
+          if (w == b)
+          {
+              path[length] = b;
+              ws->pathLength[k] = length + 1;
+
+              for (i = 0; i < length; i++)
+                   ws->isOnPath[path[i]] = FALSE;
+
+              if (_K5Search_RoutePaths(ws, k+1))
+                  return TRUE;
+
+              for (i = 0; i < length; i++)
+                   ws->isOnPath[path[i]] = TRUE;
+          }
+
+          // Extend the path to w
+          else if (w >= 0)
+          {
+              path[length] = w;
+              cursor[length] = 0;
+              ws->isOnPath[w] = ws->isUsed[w] = TRUE;
+              length++;
+          }
+
+          // Backtrack from u
+          else
+          {
+              ws->isOnPath[u] = FALSE;
+              if (length > 1)
+                  ws->isUsed[u] = FALSE;
+              length--;
+          }
+     }
+
+     return FALSE;
+}
+
+/****************************************************************************
+ _K5Search_HasCapacity()
+
+ Each branch vertex needs a distinct free neighbor for each of its paths
+ that has not yet been found.
+ ****************************************************************************/
+
+int  _K5Search_HasCapacity(K5SearchWorkspace *ws, int k)
+{
+     int i, j, x, w, needed, available;
+
+     for (i = 0; i < 5; i++)
+     {
+          x = ws->branch[i];
+
+          needed = 0;
+          for (j = k; j < ws->numPairs; j++)
+               if (ws->pairs[j][0] == x || ws->pairs[j][1] == x)
+                   needed++;
+
+          if (needed == 0)
+              continue;
+
+          available = 0;
+          for (j = ws->start[x]; j < ws->start[x+1]; j++)
+          {
+               w = ws->neighbors[j];
+               if (!ws->isBranch[w] && !ws->isUsed[w])
+                   available++;
+          }
+
+          if (available < needed)
+              return FALSE;
+     }
+
+     return TRUE;
+}
+
+/****************************************************************************
+ _K5Search_HasFans()
+
+ Each branch vertex must be joined to the other ends of its paths that have
+ not yet been found by paths through free vertices that are disjoint except
+ at the branch vertex.  This subsumes the test of whether each remaining
+ pair can still be connected at all.
+ ****************************************************************************/
+
+int  _K5Search_HasFans(K5SearchWorkspace *ws, int k)
+{
+     int i, j, x, targets[4], numTargets;
+
+     for (i = 0; i < 5; i++)
+     {
+          x = ws->branch[i];
+
+          numTargets = 0;
+          for (j = k; j < ws->numPairs; j++)
+          {
+               if (ws->pairs[j][0] == x)
+                   targets[numTargets++] = ws->pairs[j][1];
+               else if (ws->pairs[j][1] == x)
+                   targets[numTargets++] = ws->pairs[j][0];
+          }
+
+          if (numTargets > 0 &&
+              _K5Search_CountFanPaths(ws, x, targets, numTargets) < numTargets)
+              return FALSE;
+     }
+
+     return TRUE;
+}
+
+/****************************************************************************
+ _K5Search_GetNextPathVertex()
+
+ Gets the next vertex that can extend the path ending at u toward b.  The
+ candidates are the free neighbors of u from which b can still be reached,
+ and which keep the path induced.  They are tried in ascending order of
+ their distance to b, so that short paths are found first, and the count
+ of candidates already tried at this point of the path is kept in pTried.
+
+ Returns the vertex, or -1 if there is none
+ ****************************************************************************/
+
+int  _K5Search_GetNextPathVertex(K5SearchWorkspace *ws, int u, int b, int *pTried)
+{
+     int j, x, w, i, numCandidates = 0;
+
+     // If u is adjacent to b, then b is the only way to extend the path
+     if (_K5Search_IsAdjacent(ws, u, b))
+     {
+         if (*pTried > 0)
+             return -1;
+
+         *pTried = 1;
+         return b;
+     }
+
+     _K5Search_MarkReachable(ws, b);
+
+     for (j = ws->start[u]; j < ws->start[u+1]; j++)
+     {
+          w = ws->neighbors[j];
+          if (ws->reachStamp[w] != ws->stamp)
+              continue;
+
+          // Only extend to w if the path remains an induced path
+          for (x = ws->start[w]; x < ws->start[w+1]; x++)
+               if (ws->isOnPath[ws->neighbors[x]] && ws->neighbors[x] != u)
+                   break;
+
+          if (x < ws->start[w+1])
+              continue;
+
+          for (i = numCandidates; i > 0 && ws->distance[ws->pathCandidates[i-1]] > ws->distance[w]; i--)
+               ws->pathCandidates[i] = ws->pathCandidates[i-1];
+          ws->pathCandidates[i] = w;
+          numCandidates++;
+     }
+
+     if (*pTried >= numCandidates)
+         return -1;
+
+     return ws->pathCandidates[(*pTried)++];
+}
+
+/****************************************************************************
+ _K5Search_MarkReachable()
+
+ Marks with the current stamp the free vertices that can reach b without
+ passing through a branch vertex or a vertex already used by a path, and
+ records their distances to b.
+ ****************************************************************************/
+
+void _K5Search_MarkReachable(K5SearchWorkspace *ws, int b)
+{
+     int head = 0, tail = 0, u, w, j;
+
+     ws->stamp++;
+     ws->queue[tail++] = b;
+     ws->distance[b] = 0;
+
+     while (head < tail)
+     {
+          u = ws->queue[head++];
+          for (j = ws->start[u]; j < ws->start[u+1]; j++)
+          {
+               w = ws->neighbors[j];
+               if (ws->reachStamp[w] != ws->stamp &&
+                   !ws->isBranch[w] && !ws->isUsed[w] && !ws->isOnPath[w])
+               {
+                   ws->reachStamp[w] = ws->stamp;
+                   ws->distance[w] = ws->distance[u] + 1;
+                   ws->queue[tail++] = w;
+               }
+          }
+     }
+}
+
+/****************************************************************************
+ _K5Search_GetEdge()
+
+ Returns the index of the skeleton edge joining u and w, or -1 if none
+ ****************************************************************************/
+
+int  _K5Search_GetEdge(K5SearchWorkspace *ws, int u, int w)
+{
+     int j;
+
+     for (j = ws->start[u]; j < ws->start[u+1]; j++)
+          if (ws->neighbors[j] == w)
+              return ws->neighborEdge[j];
+
+     return -1;
+}
+
+/****************************************************************************
+ _K5Search_IsAdjacent()
+ ****************************************************************************/
+
+int  _K5Search_IsAdjacent(K5SearchWorkspace *ws, int u, int w)
+{
+     return _K5Search_GetEdge(ws, u, w) >= 0 ? TRUE : FALSE;
+}
+
+/****************************************************************************
+ _K5Search_AddPathsToWitness()
+
+ Puts in the workspace witness the edges of the K5 homeomorph formed by
+ the five branch vertices, the edges joining them and the paths found for
+ the pairs of them that are not adjacent.
+ ****************************************************************************/
+
+void _K5Search_AddPathsToWitness(K5SearchWorkspace *ws)
+{
+     int i, j, k, *path;
+
+     ws->witnessSize = 0;
+     for (i = 0; i < 5; i++)
+          for (j = i+1; j < 5; j++)
+               if (_K5Search_IsAdjacent(ws, ws->branch[i], ws->branch[j]))
+                   _K5Search_AddWitnessEdge(ws, ws->branch[i], ws->branch[j]);
+
+     for (k = 0; k < ws->numPairs; k++)
+     {
+          path = ws->paths + k*ws->N;
+          for (i = 1; i < ws->pathLength[k]; i++)
+               _K5Search_AddWitnessEdge(ws, path[i-1], path[i]);
+     }
+}
+
+/****************************************************************************
+ _K5Search_AddWitnessEdge()
+
+ Adds the skeleton edge joining u and w to the witness in input graph
+ vertex numbering.  A virtual edge is expanded into a path of the input
+ graph by _K5Search_AddVirtualEdgePath().
+ ****************************************************************************/
+
+void _K5Search_AddWitnessEdge(K5SearchWorkspace *ws, int u, int w)
+{
+     int i = _K5Search_GetEdge(ws, u, w);
+
+     if (i >= 0 && ws->isVirtual[i])
+     {
+         _K5Search_AddVirtualEdgePath(ws, ws->vertex[u], ws->vertex[w]);
+         return;
+     }
+
+     ws->witness[2*ws->witnessSize] = ws->vertex[u];
+     ws->witness[2*ws->witnessSize+1] = ws->vertex[w];
+     ws->witnessSize++;
+}
+
+/****************************************************************************
+ _K5Search_AddVirtualEdgePath()
+
+ Adds to the witness a path of the input graph that joins the skeleton
+ vertices a and b on the other side of their virtual edge.  This is either
+ an edge joining a and b or a path through a split component, which is a
+ component of the input graph minus the skeleton vertices that attaches
+ to a and b.  The path is found by breadth first search of the component.
+
+ Cost: each split component attaches to only one pair of skeleton vertices,
+ and the skeleton has at most one virtual edge per pair, so the components
+ searched for a witness are distinct, and the expansion of all virtual
+ edges of a witness takes linear time.
+ ****************************************************************************/
+
+void _K5Search_AddVirtualEdgePath(K5SearchWorkspace *ws, int a, int b)
+{
+     int head = 0, tail = 0, u, w, j, c = -1;
+
+     for (j = ws->adjStart[a]; j < ws->adjStart[a+1]; j++)
+     {
+          if (ws->adjList[j] == b)
+          {
+              ws->witness[2*ws->witnessSize] = a;
+              ws->witness[2*ws->witnessSize+1] = b;
+              ws->witnessSize++;
+              return;
+          }
+     }
+
+     if (!ws->componentsLabeled)
+         _K5Search_LabelSplitComponents(ws);
+
+     // Start from a neighbor of a in a split component attached to b
+     for (j = ws->adjStart[a]; j < ws->adjStart[a+1] && c < 0; j++)
+     {
+          w = ws->adjList[j];
+          if (ws->component[w] >= 0 &&
+              (ws->componentAttach[2*ws->component[w]] == b ||
+               ws->componentAttach[2*ws->component[w]+1] == b))
+          {
+              c = ws->component[w];
+              ws->componentParent[w] = a;
+              ws->queue[tail++] = w;
+          }
+     }
+
+     while (head < tail)
+     {
+          u = ws->queue[head++];
+          for (j = ws->adjStart[u]; j < ws->adjStart[u+1]; j++)
+          {
+               w = ws->adjList[j];
+               if (w == b)
+               {
+                   ws->witness[2*ws->witnessSize] = u;
+                   ws->witness[2*ws->witnessSize+1] = b;
+                   ws->witnessSize++;
+
+                   for (; u != a; u = ws->componentParent[u])
+                   {
+                        ws->witness[2*ws->witnessSize] = ws->componentParent[u];
+                        ws->witness[2*ws->witnessSize+1] = u;
+                        ws->witnessSize++;
+                   }
+                   return;
+               }
+
+               if (ws->component[w] == c && ws->componentParent[w] < 0)
+               {
+                   ws->componentParent[w] = u;
+                   ws->queue[tail++] = w;
+               }
+          }
+     }
+}
+
+/****************************************************************************
+ _K5Search_LabelSplitComponents()
+
+ Labels the components of the input graph minus the vertices of the
+ skeleton in the workspace, and records the skeleton vertices to which
+ each component attaches.  The skeleton vertices are labeled -1.
+ ****************************************************************************/
+
+void _K5Search_LabelSplitComponents(K5SearchWorkspace *ws)
+{
+     int head, tail, u, w, j, v, c;
+
+     for (v = ws->firstVertex; v < ws->vertexIndexBound; v++)
+     {
+          ws->component[v] = -1;
+          ws->componentParent[v] = -1;
+     }
+
+     for (v = ws->firstVertex; v < ws->vertexIndexBound; v++)
+     {
+          if (ws->localVertex[v] >= 0 || ws->component[v] >= 0)
+              continue;
+
+          c = v;
+          ws->componentAttach[2*c] = ws->componentAttach[2*c+1] = -1;
+          ws->component[v] = c;
+
+          head = tail = 0;
+          ws->queue[tail++] = v;
+          while (head < tail)
+          {
+               u = ws->queue[head++];
+               for (j = ws->adjStart[u]; j < ws->adjStart[u+1]; j++)
+               {
+                    w = ws->adjList[j];
+                    if (ws->localVertex[w] >= 0)
+                    {
+                        if (ws->componentAttach[2*c] < 0)
+                            ws->componentAttach[2*c] = w;
+                        else if (ws->componentAttach[2*c] != w && ws->componentAttach[2*c+1] < 0)
+                            ws->componentAttach[2*c+1] = w;
+                    }
+                    else if (ws->component[w] < 0)
+                    {
+                        ws->component[w] = c;
+                        ws->queue[tail++] = w;
+                    }
+               }
+          }
+     }
+
+     ws->componentsLabeled = TRUE;
+}
+
+/****************************************************************************
+ _K5Search_ReplaceEdges()
+
+ Deletes all edges of theGraph, then adds the edges in the given list.
+ ****************************************************************************/
+
+int  _K5Search_ReplaceEdges(graphP theGraph, int *edgeList, int numEdges)
+{
+     int v, e, i;
+
+     for (v = gp_GetFirstVertex(theGraph); v < gp_VertexIndexBound(theGraph); v++)
+     {
+          e = gp_GetFirstArc(theGraph, v);
+          while (gp_IsArc(e))
+              e = gp_DeleteEdge(theGraph, e, 0);
+     }
+
+     for (i = 0; i < numEdges; i++)
+     {
+          if (gp_AddEdge(theGraph, edgeList[2*i], 0, edgeList[2*i+1], 0) != OK)
+              return NOTOK;
+     }
+
+     return OK;
+}
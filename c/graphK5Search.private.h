@@ -0,0 +1,187 @@
+#ifndef GRAPH_K5SEARCH_PRIVATE_H
+#define GRAPH_K5SEARCH_PRIVATE_H
+
+/*
+Planarity-Related Graph Algorithms Project
+Copyright (c) 1997-2012, John M. Boyer
+All rights reserved. Includes a reference implementation of the following:
+
+* John M. Boyer. "Subgraph Homeomorphism via the Edge Addition Planarity Algorithm".
+  Journal of Graph Algorithms and Applications, Vol. 16, no. 2, pp. 381-410, 2012.
+  http://www.jgaa.info/16/268.html
+
+* John M. Boyer. "A New Method for Efficiently Generating Planar Graph
+  Visibility Representations". In P. Eades and P. Healy, editors,
+  Proceedings of the 13th International Conference on Graph Drawing 2005,
+  Lecture Notes Comput. Sci., Volume 3843, pp. 508-511, Springer-Verlag, 2006.
+
+* John M. Boyer and Wendy J. Myrvold. "On the Cutting Edge: Simplified O(n)
+  Planarity by Edge Addition". Journal of Graph Algorithms and Applications,
+  Vol. 8, No. 3, pp. 241-273, 2004.
+  http://www.jgaa.info/08/91.html
+
+* John M. Boyer. "Simplified O(n) Algorithms for Planar Graph Embedding,
+  Kuratowski Subgraph Isolation, and Related Problems". Ph.D. Dissertation,
+  University of Victoria, 2001.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+  list of conditions and the following disclaimer in the documentation and/or
+  other materials provided with the distribution.
+
+* Neither the name of the Planarity-Related Graph Algorithms Project nor the names
+  of its contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "graph.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Additional equipment for each EdgeRec: None
+   Additional equipment for each vertex: None
+
+   The K5 search runs the core planarity algorithm, which isolates a K5 in
+   linear time whenever the first blocked bicomp yields the K5 case of minor E.
+   When a K_{3,3} is isolated instead, the existence of a K5 is not decided,
+   so the input graph is reduced to its triconnected components, and the
+   skeleton of each R-node is searched.  For this, the edges of the input
+   graph are recorded during embedding initialization.
+ */
+
+typedef struct
+{
+    // Helps distinguish initialize from re-initialize
+    int initialized;
+
+    // The graph that this context augments
+    graphP theGraph;
+
+    // The endpoints (in DFI order) of each edge of the input graph, recorded
+    // by _K5Search_EmbeddingInitialize(), and the number of edges recorded
+    int *edgeList;
+    int numEdges;
+
+    // Set when the core planarity algorithm isolated a K_{3,3} homeomorph,
+    // which means gp_Embed() must search the triconnected components
+    int k33Isolated;
+
+    // Overloaded function pointers
+    graphFunctionTable functions;
+
+} K5SearchContext;
+
+/* The workspace used by the search of the triconnected components, which
+   is allocated by _SearchForK5InGraph() and sized by the input graph and
+   its largest R-node skeleton.  The first group of arrays holds the input
+   graph and its split components relative to the current skeleton, which
+   are used to expand virtual edges into paths.  The second group holds one
+   skeleton at a time, with vertices renumbered from 0, and the state of the
+   search for five branch vertices and ten internally disjoint paths.
+ */
+
+// The largest number of candidate branch vertices for which the pairwise
+// results of the disjoint paths test are memoized
+#define K5SEARCH_MAXLINKEDCANDIDATES 4096
+
+// The search for nearby branch vertices tries the K5SEARCH_MAXSEEDS
+// candidates nearest the K_{3,3} isolated in the skeleton, each with the
+// K5SEARCH_NEARCANDIDATES candidates nearest to it, and it negotiates the
+// paths for each set for at most K5SEARCH_NEGOTIATIONROUNDS rounds
+#define K5SEARCH_MAXSEEDS 16
+#define K5SEARCH_NEARCANDIDATES 7
+#define K5SEARCH_NEGOTIATIONROUNDS 10
+
+typedef struct
+{
+    // Adjacency arrays of the input graph, indexed by vertex
+    int *adjStart, *adjList;
+    int firstVertex, vertexIndexBound;
+
+    // Maps vertices of the input graph to vertices of the current skeleton,
+    // or to -1 if they are not in it
+    int *localVertex;
+
+    // The split components of the input graph relative to the skeleton,
+    // with the one or two skeleton vertices to which each attaches, and the
+    // BFS parents used to find a path through a component
+    int *component, *componentAttach, *componentParent;
+    int componentsLabeled;
+
+    // The current skeleton: N vertices mapped back to input graph vertices
+    // by vertex, and its edges, whether each is virtual, and its adjacency
+    // arrays in local numbering, with the edge index of each adjacency
+    int N, M;
+    int *vertex, *edges, *isVirtual, *start, *neighbors, *neighborEdge;
+
+    // The branch vertices being tried, the candidate branch vertices and
+    // the index of each vertex among them (-1 for non-candidates), and the
+    // vertices of the K_{3,3} isolated in the skeleton
+    int branch[5];
+    int numCandidates;
+    int *candidates, *candidateIndex;
+    int *seeds;
+    int numSeeds;
+
+    // For each pair of candidates, whether they are joined by four
+    // internally disjoint paths (1), not joined (2) or not yet known (0)
+    char *linked;
+
+    // The unit capacity flow network with split vertices that is used to
+    // count the internally disjoint paths joining two candidates
+    int *flowHead, *flowParent, *flowQueue;
+    int *flowTarget, *flowNext, *flowCapacity;
+    int numFlowArcs;
+
+    // The pairs of non-adjacent branch vertices to be joined by paths
+    int numPairs;
+    int pairs[10][2];
+
+    // The path for each pair, with its length and DFS cursors
+    int *paths, *cursors;
+    int pathLength[10];
+
+    // Vertex markings used while routing paths
+    int *isBranch, *isUsed, *isOnPath, *reachStamp, *queue, *distance;
+    int stamp;
+
+    // The candidates for extending a path, in ascending order of distance
+    int *pathCandidates;
+
+    // The number of paths using each vertex and the number of rounds in
+    // which it was overused, and the heap and least cost path state used
+    // while negotiating paths
+    int *occupancy, *history;
+    int *heap, *heapPos, *pathParent;
+    int heapSize;
+    long *pathCost;
+
+    // Endpoints, in input graph numbering, of the edges of a K5 homeomorph
+    int *witness;
+    int witnessSize;
+
+} K5SearchWorkspace;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,519 @@
+/*
+Planarity-Related Graph Algorithms Project
+Copyright (c) 1997-2012, John M. Boyer
+All rights reserved. Includes a reference implementation of the following:
+
+* John M. Boyer. "Subgraph Homeomorphism via the Edge Addition Planarity Algorithm".
+  Journal of Graph Algorithms and Applications, Vol. 16, no. 2, pp. 381-410, 2012.
+  http://www.jgaa.info/16/268.html
+
+* John M. Boyer. "A New Method for Efficiently Generating Planar Graph
+  Visibility Representations". In P. Eades and P. Healy, editors,
+  Proceedings of the 13th International Conference on Graph Drawing 2005,
+  Lecture Notes Comput. Sci., Volume 3843, pp. 508-511, Springer-Verlag, 2006.
+
+* John M. Boyer and Wendy J. Myrvold. "On the Cutting Edge: Simplified O(n)
+  Planarity by Edge Addition". Journal of Graph Algorithms and Applications,
+  Vol. 8, No. 3, pp. 241-273, 2004.
+  http://www.jgaa.info/08/91.html
+
+* John M. Boyer. "Simplified O(n) Algorithms for Planar Graph Embedding,
+  Kuratowski Subgraph Isolation, and Related Problems". Ph.D. Dissertation,
+  University of Victoria, 2001.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+  list of conditions and the following disclaimer in the documentation and/or
+  other materials provided with the distribution.
+
+* Neither the name of the Planarity-Related Graph Algorithms Project nor the names
+  of its contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdlib.h>
+
+#include "graphK5Search.private.h"
+#include "graphK5Search.h"
+
+extern int  _SearchForK5InBicomp(graphP theGraph, K5SearchContext *context, int v, int R);
+extern int  _SearchForK5InGraph(graphP theGraph, K5SearchContext *context);
+
+extern int _TestForCompleteGraphObstruction(graphP theGraph, int numVerts,
+                                            int *degrees, int *imageVerts);
+
+extern int  _getImageVertices(graphP theGraph, int *degrees, int maxDegree,
+                              int *imageVerts, int maxNumImageVerts);
+
+extern int  _TestSubgraph(graphP theSubgraph, graphP theGraph);
+
+/* Forward declarations of local functions */
+
+void _K5Search_ClearStructures(K5SearchContext *context);
+int  _K5Search_CreateStructures(K5SearchContext *context);
+int  _K5Search_InitStructures(K5SearchContext *context);
+
+/* Forward declarations of overloading functions */
+int  _K5Search_EmbeddingInitialize(graphP theGraph);
+int  _K5Search_HandleBlockedBicomp(graphP theGraph, int v, int RootVertex, int R);
+int  _K5Search_EmbedPostprocess(graphP theGraph, int v, int edgeEmbeddingResult);
+int  _K5Search_CheckEmbeddingIntegrity(graphP theGraph, graphP origGraph);
+int  _K5Search_CheckObstructionIntegrity(graphP theGraph, graphP origGraph);
+
+int  _K5Search_InitGraph(graphP theGraph, int N);
+void _K5Search_ReinitializeGraph(graphP theGraph);
+int  _K5Search_EnsureArcCapacity(graphP theGraph, int requiredArcCapacity);
+
+/* Forward declarations of functions used by the extension system */
+
+void *_K5Search_DupContext(void *pContext, void *theGraph);
+void _K5Search_FreeContext(void *);
+
+/****************************************************************************
+ * K5SEARCH_ID - the integer identifier for this extension, enabling this
+ * feature's extension context to be distinguished from other features'
+ * extension contexts that may be attached to a graph.
+ ****************************************************************************/
+
+const int K5SEARCH_ID = EXTENSIONID_K5SEARCH;
+
+/****************************************************************************
+ gp_AttachK5Search()
+
+ This function adjusts the graph data structure to attach the K5 search
+ feature.
+ ****************************************************************************/
+
+int  gp_AttachK5Search(graphP theGraph)
+{
+     K5SearchContext *context = NULL;
+     int moduleID = K5SEARCH_ID;
+
+     // If the K5 search feature has already been attached to the graph,
+     // then there is no need to attach it again
+     gp_FindExtension(theGraph, K5SEARCH_ID, (void *)&context);
+     if (context != NULL)
+     {
+         return OK;
+     }
+
+     // Allocate a new extension context
+     context = (K5SearchContext *) malloc(sizeof(K5SearchContext));
+     if (context == NULL)
+     {
+         return NOTOK;
+     }
+
+     // First, tell the context that it is not initialized
+     context->initialized = 0;
+
+     // Save a pointer to theGraph in the context
+     context->theGraph = theGraph;
+
+     // Put the overload functions into the context function table.
+     // gp_AddExtension will overload the graph's functions with these, and
+     // return the base function pointers in the context function table
+     memset(&context->functions, 0, sizeof(graphFunctionTable));
+     context->functions.fpEmbeddingInitialize = _K5Search_EmbeddingInitialize;
+     context->functions.fpHandleBlockedBicomp = _K5Search_HandleBlockedBicomp;
+     context->functions.fpEmbedPostprocess = _K5Search_EmbedPostprocess;
+     context->functions.fpCheckEmbeddingIntegrity = _K5Search_CheckEmbeddingIntegrity;
+     context->functions.fpCheckObstructionIntegrity = _K5Search_CheckObstructionIntegrity;
+
+     context->functions.fpInitGraph = _K5Search_InitGraph;
+     context->functions.fpReinitializeGraph = _K5Search_ReinitializeGraph;
+     context->functions.fpEnsureArcCapacity = _K5Search_EnsureArcCapacity;
+
+     _K5Search_ClearStructures(context);
+
+     // Store the K5 search context, including the data structure and the
+     // function pointers, as an extension of the graph
+     if (gp_AddExtension(theGraph, &moduleID, (void *) context,
+                         _K5Search_DupContext, _K5Search_FreeContext,
+                         &context->functions) != OK)
+     {
+         _K5Search_FreeContext(context);
+         return NOTOK;
+     }
+
+     // Create the K5-specific structures if the size of the graph is known
+     // Attach functions are always invoked after gp_New(), but if a graph
+     // extension must be attached before gp_Read(), then the attachment
+     // also happens before gp_InitGraph(), which means N==0.
+     // However, sometimes a feature is attached after gp_InitGraph(), in
+     // which case N > 0
+     if (theGraph->N > 0)
+     {
+         if (_K5Search_CreateStructures(context) != OK ||
+             _K5Search_InitStructures(context) != OK)
+         {
+             _K5Search_FreeContext(context);
+             return NOTOK;
+         }
+     }
+
+     return OK;
+}
+
+/********************************************************************
+ gp_DetachK5Search()
+ ********************************************************************/
+
+int gp_DetachK5Search(graphP theGraph)
+{
+    return gp_RemoveExtension(theGraph, K5SEARCH_ID);
+}
+
+/********************************************************************
+ _K5Search_ClearStructures()
+ ********************************************************************/
+
+void _K5Search_ClearStructures(K5SearchContext *context)
+{
+    if (!context->initialized)
+    {
+        // Before initialization, the pointers are stray, not NULL
+        // Once NULL or allocated, free() or LCFree() can do the job
+        context->edgeList = NULL;
+
+        context->initialized = 1;
+    }
+    else
+    {
+        if (context->edgeList != NULL)
+        {
+            free(context->edgeList);
+            context->edgeList = NULL;
+        }
+    }
+
+    context->numEdges = 0;
+    context->k33Isolated = FALSE;
+}
+
+/********************************************************************
+ _K5Search_CreateStructures()
+ Create uninitialized structures for the vertex and edge levels, and
+ initialized structures for the graph level
+ ********************************************************************/
+int  _K5Search_CreateStructures(K5SearchContext *context)
+{
+     // Two endpoints are recorded per edge, so one int per arc suffices
+     int Esize = gp_EdgeIndexBound(context->theGraph);
+
+     if (context->theGraph->N <= 0)
+         return NOTOK;
+
+     if ((context->edgeList = (int *) malloc(Esize*sizeof(int))) == NULL ||
+        0)
+     {
+         return NOTOK;
+     }
+
+     return OK;
+}
+
+/********************************************************************
+ _K5Search_InitStructures()
+ ********************************************************************/
+int  _K5Search_InitStructures(K5SearchContext *context)
+{
+     context->numEdges = 0;
+     context->k33Isolated = FALSE;
+
+     return OK;
+}
+
+/********************************************************************
+ ********************************************************************/
+
+int  _K5Search_InitGraph(graphP theGraph, int N)
+{
+    K5SearchContext *context = NULL;
+    gp_FindExtension(theGraph, K5SEARCH_ID, (void *)&context);
+
+    if (context == NULL)
+        return NOTOK;
+
+    theGraph->N = N;
+	theGraph->NV = N;
+	if (theGraph->arcCapacity == 0)
+		theGraph->arcCapacity = 2*DEFAULT_EDGE_LIMIT*N;
+
+	if (_K5Search_CreateStructures(context) != OK ||
+		_K5Search_InitStructures(context) != OK)
+		return NOTOK;
+
+	context->functions.fpInitGraph(theGraph, N);
+
+    return OK;
+}
+
+/********************************************************************
+ ********************************************************************/
+
+void _K5Search_ReinitializeGraph(graphP theGraph)
+{
+    K5SearchContext *context = NULL;
+    gp_FindExtension(theGraph, K5SEARCH_ID, (void *)&context);
+
+    if (context != NULL)
+    {
+		// Reinitialize the graph
+		context->functions.fpReinitializeGraph(theGraph);
+
+		// Do the reinitialization that is specific to this module
+		_K5Search_InitStructures(context);
+    }
+}
+
+/********************************************************************
+ The current implementation does not support an increase of arc
+ (edge record) capacity once the extension is attached to the graph
+ data structure.  This is only due to not being necessary to support.
+ For now, it is easy to ensure the correct capacity before attaching
+ the extension, but support could be added later if there is some
+ reason to do so.
+ ********************************************************************/
+
+int  _K5Search_EnsureArcCapacity(graphP theGraph, int requiredArcCapacity)
+{
+	return NOTOK;
+}
+
+/********************************************************************
+ _K5Search_DupContext()
+ ********************************************************************/
+
+void *_K5Search_DupContext(void *pContext, void *theGraph)
+{
+     K5SearchContext *context = (K5SearchContext *) pContext;
+     K5SearchContext *newContext = (K5SearchContext *) malloc(sizeof(K5SearchContext));
+
+     if (newContext != NULL)
+     {
+         *newContext = *context;
+
+         newContext->theGraph = (graphP) theGraph;
+
+         newContext->initialized = 0;
+         _K5Search_ClearStructures(newContext);
+         if (((graphP) theGraph)->N > 0)
+         {
+             if (_K5Search_CreateStructures(newContext) != OK)
+             {
+                 _K5Search_FreeContext(newContext);
+                 return NULL;
+             }
+
+             newContext->numEdges = context->numEdges;
+             newContext->k33Isolated = context->k33Isolated;
+             memcpy(newContext->edgeList, context->edgeList, 2*context->numEdges*sizeof(int));
+         }
+     }
+
+     return newContext;
+}
+
+/********************************************************************
+ _K5Search_FreeContext()
+ ********************************************************************/
+
+void _K5Search_FreeContext(void *pContext)
+{
+     K5SearchContext *context = (K5SearchContext *) pContext;
+
+     _K5Search_ClearStructures(context);
+     free(pContext);
+}
+
+/********************************************************************
+ _K5Search_EmbeddingInitialize()
+
+ After the base embedding initialization, the vertices are in DFI order,
+ so the edges of the input graph are recorded in DFI order in case the
+ K5 search must fall back to searching the whole input graph.  Tree edges
+ are attached to virtual vertices at this point, so those endpoints are
+ converted to the corresponding primary vertices.
+ ********************************************************************/
+
+int  _K5Search_EmbeddingInitialize(graphP theGraph)
+{
+    K5SearchContext *context = NULL;
+    int e, u, w, EsizeOccupied;
+
+    gp_FindExtension(theGraph, K5SEARCH_ID, (void *)&context);
+    if (context == NULL)
+        return NOTOK;
+
+    if (context->functions.fpEmbeddingInitialize(theGraph) != OK)
+        return NOTOK;
+
+    if (theGraph->embedFlags == EMBEDFLAGS_SEARCHFORK5)
+    {
+        context->numEdges = 0;
+        context->k33Isolated = FALSE;
+
+        EsizeOccupied = gp_EdgeInUseIndexBound(theGraph);
+        for (e = gp_GetFirstEdge(theGraph); e < EsizeOccupied; e += 2)
+        {
+            if (!gp_EdgeInUse(theGraph, e))
+                continue;
+
+            u = gp_GetNeighbor(theGraph, gp_GetTwinArc(theGraph, e));
+            w = gp_GetNeighbor(theGraph, e);
+
+            if (gp_IsVirtualVertex(theGraph, u))
+                u = gp_GetPrimaryVertexFromRoot(theGraph, u);
+            if (gp_IsVirtualVertex(theGraph, w))
+                w = gp_GetPrimaryVertexFromRoot(theGraph, w);
+
+            context->edgeList[2*context->numEdges] = u;
+            context->edgeList[2*context->numEdges+1] = w;
+            context->numEdges++;
+        }
+    }
+
+    return OK;
+}
+
+/********************************************************************
+ _K5Search_HandleBlockedBicomp()
+ Returns NONEMBEDDABLE to terminate the Walkdown, since either a K5
+             homeomorph was isolated or the fallback search in the
+             postprocessing must be performed
+         NOTOK on internal error
+ ********************************************************************/
+
+int  _K5Search_HandleBlockedBicomp(graphP theGraph, int v, int RootVertex, int R)
+{
+	K5SearchContext *context = NULL;
+
+	gp_FindExtension(theGraph, K5SEARCH_ID, (void *)&context);
+	if (context == NULL)
+		return NOTOK;
+
+    if (theGraph->embedFlags == EMBEDFLAGS_SEARCHFORK5)
+    {
+    	// The isolator expects the descendant bicomp root on the stack,
+    	// as in the core planarity handler of a blocked bicomp
+    	if (R != RootVertex)
+    	    sp_Push2(theGraph->theStack, R, 0);
+
+    	return _SearchForK5InBicomp(theGraph, context, v, RootVertex);
+    }
+    else
+    {
+    	return context->functions.fpHandleBlockedBicomp(theGraph, v, RootVertex, R);
+    }
+
+    return NOTOK;
+}
+
+/********************************************************************
+ ********************************************************************/
+
+int  _K5Search_EmbedPostprocess(graphP theGraph, int v, int edgeEmbeddingResult)
+{
+     K5SearchContext *context = NULL;
+     gp_FindExtension(theGraph, K5SEARCH_ID, (void *)&context);
+
+     if (context == NULL)
+         return NOTOK;
+
+     // If a K_{3,3} homeomorph was isolated, then the input graph must
+     // be searched for a K5 homeomorph
+     if (theGraph->embedFlags == EMBEDFLAGS_SEARCHFORK5 &&
+         edgeEmbeddingResult == NONEMBEDDABLE && context->k33Isolated)
+     {
+         return _SearchForK5InGraph(theGraph, context);
+     }
+
+     // Otherwise, the superclass either finishes the planar embedding
+     // or passes back the NONEMBEDDABLE result of isolating a K5
+     return context->functions.fpEmbedPostprocess(theGraph, v, edgeEmbeddingResult);
+}
+
+/********************************************************************
+ ********************************************************************/
+
+int  _K5Search_CheckEmbeddingIntegrity(graphP theGraph, graphP origGraph)
+{
+     K5SearchContext *context = NULL;
+     gp_FindExtension(theGraph, K5SEARCH_ID, (void *)&context);
+
+     if (context == NULL)
+         return NOTOK;
+
+     // When searching for K5, an OK result from a graph in which a K_{3,3}
+     // was isolated leaves theGraph with the edges of the input graph, but
+     // not with an embedding, so we ensure the two graphs are the same
+     if (theGraph->embedFlags == EMBEDFLAGS_SEARCHFORK5 && context->k33Isolated)
+     {
+         if (_TestSubgraph(theGraph, origGraph) != TRUE ||
+             _TestSubgraph(origGraph, theGraph) != TRUE)
+             return NOTOK;
+
+         return OK;
+     }
+
+     // Otherwise, theGraph contains a planar embedding, which the
+     // superclass checks
+     return context->functions.fpCheckEmbeddingIntegrity(theGraph, origGraph);
+}
+
+/********************************************************************
+ ********************************************************************/
+
+int  _K5Search_CheckObstructionIntegrity(graphP theGraph, graphP origGraph)
+{
+     // When searching for K5, we ensure that theGraph is a subgraph of
+     // the original graph and that it contains a K5 homeomorph
+     if (theGraph->embedFlags == EMBEDFLAGS_SEARCHFORK5)
+     {
+		int  degrees[5], imageVerts[5];
+
+        if (_TestSubgraph(theGraph, origGraph) != TRUE)
+            return NOTOK;
+
+		if (_getImageVertices(theGraph, degrees, 4, imageVerts, 5) != OK)
+			return NOTOK;
+
+		if (_TestForCompleteGraphObstruction(theGraph, 5, degrees, imageVerts) == TRUE)
+		{
+			return OK;
+		}
+
+		return NOTOK;
+     }
+
+     // When not searching for K5, we let the superclass do the work
+     else
+     {
+        K5SearchContext *context = NULL;
+        gp_FindExtension(theGraph, K5SEARCH_ID, (void *)&context);
+
+        if (context != NULL)
+        {
+            return context->functions.fpCheckObstructionIntegrity(theGraph, origGraph);
+        }
+     }
+
+     return NOTOK;
+}
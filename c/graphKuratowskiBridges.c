@@ -0,0 +1,826 @@
+/*
+Planarity-Related Graph Algorithms Project
+Copyright (c) 1997-2012, John M. Boyer
+All rights reserved. Includes a reference implementation of the following:
+
+* John M. Boyer. "Subgraph Homeomorphism via the Edge Addition Planarity Algorithm".
+  Journal of Graph Algorithms and Applications, Vol. 16, no. 2, pp. 381-410, 2012.
+  http://www.jgaa.info/16/268.html
+
+* John M. Boyer. "A New Method for Efficiently Generating Planar Graph
+  Visibility Representations". In P. Eades and P. Healy, editors,
+  Proceedings of the 13th International Conference on Graph Drawing 2005,
+  Lecture Notes Comput. Sci., Volume 3843, pp. 508-511, Springer-Verlag, 2006.
+
+* John M. Boyer and Wendy J. Myrvold. "On the Cutting Edge: Simplified O(n)
+  Planarity by Edge Addition". Journal of Graph Algorithms and Applications,
+  Vol. 8, No. 3, pp. 241-273, 2004.
+  http://www.jgaa.info/08/91.html
+
+* John M. Boyer. "Simplified O(n) Algorithms for Planar Graph Embedding,
+  Kuratowski Subgraph Isolation, and Related Problems". Ph.D. Dissertation,
+  University of Victoria, 2001.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+  list of conditions and the following disclaimer in the documentation and/or
+  other materials provided with the distribution.
+
+* Neither the name of the Planarity-Related Graph Algorithms Project nor the names
+  of its contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "graph.h"
+#include "graphKuratowskiBridges.private.h"
+#include "platformThread.h"
+
+/* Private functions */
+
+void _KuratowskiBridges_BuildAdjacency(kuratowskiBridgesP kb);
+int  _KuratowskiBridges_MarkSubgraph(kuratowskiBridgesP kb);
+int  _KuratowskiBridges_TracePaths(kuratowskiBridgesP kb);
+void _KuratowskiBridges_LabelK33Sides(kuratowskiBridgesP kb);
+void _KuratowskiBridges_GroupBridges(kuratowskiBridgesP kb);
+
+void _KuratowskiBridges_SearchCases(kuratowskiCaseThread *thread);
+platform_ThreadReturn _KuratowskiBridges_SearchCasesThread(void *thread);
+int  _KuratowskiBridges_NextCase(kuratowskiCaseQueue *queue, int t);
+
+/********************************************************************
+ _KuratowskiBridges_New()
+
+ Allocates the arrays for the edges in the given list, omitting loops,
+ with the vertices numbered as in theGraph, which has the N vertices of
+ the graph being tested, and copies the edges.
+
+ Returns OK on success, NOTOK on allocation failure, in which case the
+         arrays allocated are freed
+ ********************************************************************/
+
+int  _KuratowskiBridges_New(kuratowskiBridgesP kb, graphP theGraph, int *edgeList, int numEdges)
+{
+     int Vsize = gp_PrimaryVertexIndexBound(theGraph), N = theGraph->N;
+     int M = 0, NB, i;
+
+     memset(kb, 0, sizeof(kuratowskiBridges));
+
+     for (i = 0; i < numEdges; i++)
+         if (edgeList[2*i] != edgeList[2*i+1])
+             M++;
+
+     // Each edge not in H is in at most one bridge, and so is each vertex
+     NB = Vsize + M;
+
+     if ((kb->edges = (int *) malloc((2*M+1) * sizeof(int))) == NULL ||
+         (kb->adjStart = (int *) malloc((Vsize+1) * sizeof(int))) == NULL ||
+         (kb->adjList = (int *) malloc((2*M+1) * sizeof(int))) == NULL ||
+         (kb->adjEdge = (int *) malloc((2*M+1) * sizeof(int))) == NULL ||
+         (kb->hEdges = (int *) malloc((2*M+1) * sizeof(int))) == NULL ||
+         (kb->hDegree = (int *) malloc((Vsize+1) * sizeof(int))) == NULL ||
+         (kb->label = (int *) malloc((Vsize+1) * sizeof(int))) == NULL ||
+         (kb->pathVertices = (int *) malloc((2*N+20) * sizeof(int))) == NULL ||
+         (kb->pathEdges = (int *) malloc((2*N+20) * sizeof(int))) == NULL ||
+         (kb->edgeBridge = (int *) malloc((M+1) * sizeof(int))) == NULL ||
+         (kb->bridgeOf = (int *) malloc((Vsize+1) * sizeof(int))) == NULL ||
+         (kb->edgeStart = (int *) malloc((NB+1) * sizeof(int))) == NULL ||
+         (kb->bridgeEdges = (int *) malloc((M+1) * sizeof(int))) == NULL ||
+         (kb->attachStart = (int *) malloc((NB+1) * sizeof(int))) == NULL ||
+         (kb->attachments = (int *) malloc((2*M+1) * sizeof(int))) == NULL ||
+         (kb->endStart = (int *) malloc((NB+1) * sizeof(int))) == NULL ||
+         (kb->endVertex = (int *) malloc((2*M+1) * sizeof(int))) == NULL ||
+         (kb->stamp = (int *) calloc(Vsize+1, sizeof(int))) == NULL ||
+         (kb->queue = (int *) malloc((Vsize+1) * sizeof(int))) == NULL)
+     {
+         _KuratowskiBridges_Free(kb);
+         return NOTOK;
+     }
+
+     kb->firstVertex = gp_GetFirstVertex(theGraph);
+     kb->N = N;
+     for (i = 0; i < numEdges; i++)
+     {
+         if (edgeList[2*i] != edgeList[2*i+1])
+         {
+             kb->edges[2*kb->M] = edgeList[2*i];
+             kb->edges[2*kb->M+1] = edgeList[2*i+1];
+             kb->M++;
+         }
+     }
+
+     return OK;
+}
+
+/********************************************************************
+ _KuratowskiBridges_Free()
+ ********************************************************************/
+
+void _KuratowskiBridges_Free(kuratowskiBridgesP kb)
+{
+     if (kb->edges != NULL) free(kb->edges);
+     if (kb->adjStart != NULL) free(kb->adjStart);
+     if (kb->adjList != NULL) free(kb->adjList);
+     if (kb->adjEdge != NULL) free(kb->adjEdge);
+     if (kb->hEdges != NULL) free(kb->hEdges);
+     if (kb->hDegree != NULL) free(kb->hDegree);
+     if (kb->label != NULL) free(kb->label);
+     if (kb->pathVertices != NULL) free(kb->pathVertices);
+     if (kb->pathEdges != NULL) free(kb->pathEdges);
+     if (kb->edgeBridge != NULL) free(kb->edgeBridge);
+     if (kb->bridgeOf != NULL) free(kb->bridgeOf);
+     if (kb->edgeStart != NULL) free(kb->edgeStart);
+     if (kb->bridgeEdges != NULL) free(kb->bridgeEdges);
+     if (kb->attachStart != NULL) free(kb->attachStart);
+     if (kb->attachments != NULL) free(kb->attachments);
+     if (kb->endStart != NULL) free(kb->endStart);
+     if (kb->endVertex != NULL) free(kb->endVertex);
+     if (kb->stamp != NULL) free(kb->stamp);
+     if (kb->queue != NULL) free(kb->queue);
+
+     memset(kb, 0, sizeof(kuratowskiBridges));
+}
+
+/********************************************************************
+ _KuratowskiBridges_GetNumThreads()
+
+ Gets the number of threads with which to explore the embedding cases
+ of H, which is numThreads, or one per processor if numThreads is not
+ positive, except that small graphs are explored by one thread.
+ ********************************************************************/
+
+int  _KuratowskiBridges_GetNumThreads(kuratowskiBridgesP kb, int numThreads)
+{
+     if (numThreads <= 0)
+         numThreads = kb->M < KURATOWSKICASES_MINPARALLELEDGES ? 1 : platform_GetNumProcessors();
+
+     return numThreads < 1 ? 1 : numThreads;
+}
+
+/********************************************************************
+ _KuratowskiBridges_GetSubgraph()
+
+ Gets the edges of H from a graph in which gp_Embed() has isolated a K5 or
+ K_{3,3} homeomorph, mapping virtual vertices to primary vertices.  If
+ getIndex is TRUE, the vertices are also mapped from DFI order back to
+ their original numbering, which is the numbering of the edges in kb.
+
+ Returns OK on success, NOTOK if H has more edges than the graph in kb
+ ********************************************************************/
+
+int  _KuratowskiBridges_GetSubgraph(kuratowskiBridgesP kb, graphP theGraph, int getIndex)
+{
+     int e, u, w, EsizeOccupied;
+
+     kb->numHEdges = 0;
+
+     EsizeOccupied = gp_EdgeInUseIndexBound(theGraph);
+     for (e = gp_GetFirstEdge(theGraph); e < EsizeOccupied; e += 2)
+     {
+         if (!gp_EdgeInUse(theGraph, e))
+             continue;
+
+         u = gp_GetNeighbor(theGraph, gp_GetTwinArc(theGraph, e));
+         w = gp_GetNeighbor(theGraph, e);
+
+         if (gp_IsVirtualVertex(theGraph, u))
+             u = gp_GetPrimaryVertexFromRoot(theGraph, u);
+         if (gp_IsVirtualVertex(theGraph, w))
+             w = gp_GetPrimaryVertexFromRoot(theGraph, w);
+
+         if (getIndex)
+         {
+             u = gp_GetVertexIndex(theGraph, u);
+             w = gp_GetVertexIndex(theGraph, w);
+         }
+
+         if (kb->numHEdges >= kb->M)
+             return NOTOK;
+
+         kb->hEdges[2*kb->numHEdges] = u;
+         kb->hEdges[2*kb->numHEdges+1] = w;
+         kb->numHEdges++;
+     }
+
+     return OK;
+}
+
+/********************************************************************
+ _KuratowskiBridges_FindBridges()
+
+ Finds the branch vertices and the paths of H, then the bridges of H,
+ with their edges, attachments and ends.  The bridges with at most one
+ attachment are found like the others, but since such a bridge fits in
+ any face at its attachment, the caller only needs to test its planarity.
+
+ Returns OK on success, NOTOK if H is not a K5 or K_{3,3} homeomorph in
+         the graph
+ ********************************************************************/
+
+int  _KuratowskiBridges_FindBridges(kuratowskiBridgesP kb)
+{
+     _KuratowskiBridges_BuildAdjacency(kb);
+
+     if (_KuratowskiBridges_MarkSubgraph(kb) != OK ||
+         _KuratowskiBridges_TracePaths(kb) != OK)
+         return NOTOK;
+
+     if (!kb->isK5)
+         _KuratowskiBridges_LabelK33Sides(kb);
+
+     _KuratowskiBridges_GroupBridges(kb);
+     return OK;
+}
+
+/********************************************************************
+ _KuratowskiBridges_BuildAdjacency()
+
+ Builds the adjacency arrays of the graph.
+ ********************************************************************/
+
+void _KuratowskiBridges_BuildAdjacency(kuratowskiBridgesP kb)
+{
+     int Vsize = kb->firstVertex + kb->N;
+     int v, i, j, u;
+
+     for (v = 0; v <= Vsize; v++)
+         kb->adjStart[v] = 0;
+
+     for (i = 0; i < 2*kb->M; i++)
+         kb->adjStart[kb->edges[i]+1]++;
+
+     for (v = 1; v <= Vsize; v++)
+         kb->adjStart[v] += kb->adjStart[v-1];
+
+     for (i = 0; i < kb->M; i++)
+     {
+         for (j = 0; j < 2; j++)
+         {
+             u = kb->edges[2*i+j];
+             kb->adjList[kb->adjStart[u]] = kb->edges[2*i+1-j];
+             kb->adjEdge[kb->adjStart[u]] = i;
+             kb->adjStart[u]++;
+         }
+     }
+
+     // Filling the arrays advanced each start to the next vertex's start
+     for (v = Vsize; v > 0; v--)
+         kb->adjStart[v] = kb->adjStart[v-1];
+     kb->adjStart[0] = 0;
+}
+
+/********************************************************************
+ _KuratowskiBridges_MarkSubgraph()
+
+ Marks the edges of H in the edgeBridge array, computes the degree of each
+ vertex in H, and identifies the branch vertices of H, in ascending order.
+
+ Returns OK if H is a K5 or K_{3,3} homeomorph in the graph, NOTOK otherwise
+ ********************************************************************/
+
+int  _KuratowskiBridges_MarkSubgraph(kuratowskiBridgesP kb)
+{
+     int Vsize = kb->firstVertex + kb->N;
+     int v, i, j, u, w, numBranch = 0;
+
+     for (v = 0; v < Vsize; v++)
+     {
+         kb->hDegree[v] = 0;
+         kb->label[v] = -1;
+     }
+
+     for (i = 0; i < kb->M; i++)
+         kb->edgeBridge[i] = -2;
+
+     for (i = 0; i < kb->numHEdges; i++)
+     {
+         u = kb->hEdges[2*i];
+         w = kb->hEdges[2*i+1];
+
+         for (j = kb->adjStart[u]; j < kb->adjStart[u+1]; j++)
+         {
+             if (kb->adjList[j] == w && kb->edgeBridge[kb->adjEdge[j]] == -2)
+                 break;
+         }
+
+         if (j == kb->adjStart[u+1])
+             return NOTOK;
+
+         kb->edgeBridge[kb->adjEdge[j]] = -1;
+         kb->hDegree[u]++;
+         kb->hDegree[w]++;
+     }
+
+     for (v = kb->firstVertex; v < Vsize; v++)
+     {
+         if (kb->hDegree[v] > 2)
+         {
+             if (numBranch == 6)
+                 return NOTOK;
+             kb->label[v] = numBranch;
+             kb->branch[numBranch++] = v;
+         }
+     }
+
+     kb->isK5 = numBranch == 5;
+
+     for (i = 0; i < numBranch; i++)
+     {
+         if (kb->hDegree[kb->branch[i]] != (kb->isK5 ? 4 : 3))
+             return NOTOK;
+     }
+
+     return numBranch == 5 || numBranch == 6 ? OK : NOTOK;
+}
+
+/********************************************************************
+ _KuratowskiBridges_TracePaths()
+
+ Traces the paths of H from each branch vertex, storing each path once,
+ along with the edge from each vertex of the path to the next.  Each path
+ is walked twice, and the second walk is stored after the stored paths
+ before it is discarded, so the path arrays have room for 2N + 20 entries.
+
+ Returns OK on success, NOTOK if H is not a K5 or K_{3,3} homeomorph
+ ********************************************************************/
+
+int  _KuratowskiBridges_TracePaths(kuratowskiBridgesP kb)
+{
+     int numBranch = kb->isK5 ? 5 : 6;
+     int maxSize = 2*kb->N + 20;
+     int i, j, k, u, e, prevEdge, size = 0, start;
+
+     for (i = 0; i < 6; i++)
+         for (j = 0; j < 6; j++)
+              kb->pathIndex[i][j] = -1;
+     kb->numPaths = 0;
+
+     for (i = 0; i < numBranch; i++)
+     {
+         u = kb->branch[i];
+         for (k = kb->adjStart[u]; k < kb->adjStart[u+1]; k++)
+         {
+             if (kb->edgeBridge[kb->adjEdge[k]] != -1)
+                 continue;
+
+             // Walk along the path to the branch vertex at its other end,
+             // recording the path in case it has not been stored yet
+             start = size;
+             kb->pathEdges[size] = kb->adjEdge[k];
+             kb->pathVertices[size++] = u;
+             prevEdge = kb->adjEdge[k];
+             u = kb->adjList[k];
+             while (kb->label[u] < 0)
+             {
+                 if (size >= maxSize)
+                     return NOTOK;
+
+                 for (e = kb->adjStart[u]; e < kb->adjStart[u+1]; e++)
+                 {
+                     if (kb->edgeBridge[kb->adjEdge[e]] == -1 && kb->adjEdge[e] != prevEdge)
+                         break;
+                 }
+                 if (e == kb->adjStart[u+1])
+                     return NOTOK;
+
+                 kb->pathEdges[size] = kb->adjEdge[e];
+                 kb->pathVertices[size++] = u;
+
+                 prevEdge = kb->adjEdge[e];
+                 u = kb->adjList[e];
+             }
+             if (size >= maxSize)
+                 return NOTOK;
+             kb->pathEdges[size] = -1;
+             kb->pathVertices[size++] = u;
+
+             j = kb->label[u];
+             if (i == j)
+                 return NOTOK;
+
+             if (i < j)
+             {
+                 if (kb->pathIndex[i][j] >= 0 || kb->numPaths == 10)
+                     return NOTOK;
+                 kb->pathIndex[i][j] = kb->pathIndex[j][i] = kb->numPaths;
+                 kb->pathStart[kb->numPaths] = start;
+                 kb->pathLength[kb->numPaths] = size - start;
+                 kb->numPaths++;
+             }
+             else size = start;
+
+             u = kb->branch[i];
+         }
+     }
+
+     return kb->numPaths == (kb->isK5 ? 10 : 9) ? OK : NOTOK;
+}
+
+/********************************************************************
+ _KuratowskiBridges_LabelK33Sides()
+
+ Relabels the branch vertices of a K_{3,3} homeomorph so that the labels
+ 0 to 2 are on the side of the bipartition that has branch vertex 0.
+ ********************************************************************/
+
+void _KuratowskiBridges_LabelK33Sides(kuratowskiBridgesP kb)
+{
+     int newLabel[6], oldBranch[6], oldPathIndex[6][6];
+     int i, j, numSideA = 0, numSideB = 3;
+
+     for (i = 0; i < 6; i++)
+     {
+         if (i == 0 || kb->pathIndex[0][i] < 0)
+              newLabel[i] = numSideA++;
+         else newLabel[i] = numSideB++;
+
+         oldBranch[i] = kb->branch[i];
+         for (j = 0; j < 6; j++)
+             oldPathIndex[i][j] = kb->pathIndex[i][j];
+     }
+
+     for (i = 0; i < 6; i++)
+     {
+         kb->branch[newLabel[i]] = oldBranch[i];
+         kb->label[oldBranch[i]] = newLabel[i];
+         for (j = 0; j < 6; j++)
+             kb->pathIndex[newLabel[i]][newLabel[j]] = oldPathIndex[i][j];
+     }
+}
+
+/********************************************************************
+ _KuratowskiBridges_GroupBridges()
+
+ Assigns each edge that is not in H to its bridge, then groups the edges,
+ the distinct attachments and the ends of each bridge, and records the
+ number of edges in the largest bridge.
+ ********************************************************************/
+
+void _KuratowskiBridges_GroupBridges(kuratowskiBridgesP kb)
+{
+     int Vsize = kb->firstVertex + kb->N;
+     int v, u, w, i, b, j, qTop, qBottom, numAttach, numEnds;
+
+     kb->numBridges = 0;
+     for (v = 0; v < Vsize; v++)
+         kb->bridgeOf[v] = -1;
+
+     // Each connected component of G-H with at least one edge is in a bridge
+     for (v = kb->firstVertex; v < Vsize; v++)
+     {
+         if (kb->hDegree[v] > 0 || kb->bridgeOf[v] >= 0 || kb->adjStart[v] == kb->adjStart[v+1])
+             continue;
+
+         kb->bridgeOf[v] = kb->numBridges;
+         qBottom = qTop = 0;
+         kb->queue[qTop++] = v;
+         while (qBottom < qTop)
+         {
+             u = kb->queue[qBottom++];
+             for (j = kb->adjStart[u]; j < kb->adjStart[u+1]; j++)
+             {
+                 w = kb->adjList[j];
+                 if (kb->hDegree[w] == 0 && kb->bridgeOf[w] < 0)
+                 {
+                     kb->bridgeOf[w] = kb->numBridges;
+                     kb->queue[qTop++] = w;
+                 }
+             }
+         }
+         kb->numBridges++;
+     }
+
+     // Each edge joining two vertices of H that is not in H is a bridge
+     for (i = 0; i < kb->M; i++)
+     {
+         if (kb->edgeBridge[i] == -1)
+             continue;
+
+         u = kb->edges[2*i];
+         w = kb->edges[2*i+1];
+         if (kb->hDegree[u] == 0)
+              kb->edgeBridge[i] = kb->bridgeOf[u];
+         else if (kb->hDegree[w] == 0)
+              kb->edgeBridge[i] = kb->bridgeOf[w];
+         else kb->edgeBridge[i] = kb->numBridges++;
+     }
+
+     // Group the edges of each bridge by counting sort
+     for (b = 0; b <= kb->numBridges; b++)
+         kb->edgeStart[b] = 0;
+     for (i = 0; i < kb->M; i++)
+         if (kb->edgeBridge[i] >= 0)
+             kb->edgeStart[kb->edgeBridge[i]+1]++;
+     for (b = 1; b <= kb->numBridges; b++)
+         kb->edgeStart[b] += kb->edgeStart[b-1];
+     for (i = 0; i < kb->M; i++)
+         if (kb->edgeBridge[i] >= 0)
+             kb->bridgeEdges[kb->edgeStart[kb->edgeBridge[i]]++] = i;
+     for (b = kb->numBridges; b > 0; b--)
+         kb->edgeStart[b] = kb->edgeStart[b-1];
+     kb->edgeStart[0] = 0;
+
+     kb->maxBridgeEdges = 0;
+     for (b = 0; b < kb->numBridges; b++)
+         if (kb->edgeStart[b+1] - kb->edgeStart[b] > kb->maxBridgeEdges)
+             kb->maxBridgeEdges = kb->edgeStart[b+1] - kb->edgeStart[b];
+
+     // Collect the distinct attachments and the ends of each bridge
+     numAttach = kb->attachStart[0] = 0;
+     numEnds = kb->endStart[0] = 0;
+     for (b = 0; b < kb->numBridges; b++)
+     {
+         kb->stampValue++;
+         for (i = kb->edgeStart[b]; i < kb->edgeStart[b+1]; i++)
+         {
+             for (j = 0; j < 2; j++)
+             {
+                 v = kb->edges[2*kb->bridgeEdges[i]+j];
+                 if (kb->hDegree[v] > 0)
+                 {
+                     kb->endVertex[numEnds++] = v;
+                     if (kb->stamp[v] != kb->stampValue)
+                     {
+                         kb->stamp[v] = kb->stampValue;
+                         kb->attachments[numAttach++] = v;
+                     }
+                 }
+             }
+         }
+
+         kb->attachStart[b+1] = numAttach;
+         kb->endStart[b+1] = numEnds;
+     }
+}
+
+/********************************************************************
+ _KuratowskiBridges_RemoveEdge()
+
+ Swaps edge i to the end of the edge list, then drops it.  If the edge
+ is in H, then H no longer is a subgraph of the graph, so it is cleared.
+
+ Returns TRUE if H is kept, FALSE otherwise
+ ********************************************************************/
+
+int  _KuratowskiBridges_RemoveEdge(kuratowskiBridgesP kb, int i)
+{
+     int u = kb->edges[2*i], w = kb->edges[2*i+1], j;
+
+     kb->edges[2*i] = kb->edges[2*kb->M-2];
+     kb->edges[2*i+1] = kb->edges[2*kb->M-1];
+     kb->edges[2*kb->M-2] = u;
+     kb->edges[2*kb->M-1] = w;
+     kb->M--;
+
+     for (j = 0; j < kb->numHEdges; j++)
+     {
+         if ((kb->hEdges[2*j] == u && kb->hEdges[2*j+1] == w) ||
+             (kb->hEdges[2*j] == w && kb->hEdges[2*j+1] == u))
+         {
+             kb->numHEdges = 0;
+             break;
+         }
+     }
+
+     return kb->numHEdges > 0;
+}
+
+/********************************************************************
+ _KuratowskiBridges_RestoreEdge()
+
+ Restores the edge last removed by _KuratowskiBridges_RemoveEdge() to
+ position i of the edge list.
+ ********************************************************************/
+
+void _KuratowskiBridges_RestoreEdge(kuratowskiBridgesP kb, int i)
+{
+     int u = kb->edges[2*kb->M], w = kb->edges[2*kb->M+1];
+
+     kb->M++;
+     kb->edges[2*kb->M-2] = kb->edges[2*i];
+     kb->edges[2*kb->M-1] = kb->edges[2*i+1];
+     kb->edges[2*i] = u;
+     kb->edges[2*i+1] = w;
+}
+
+/********************************************************************
+ _KuratowskiBridges_ReplaceEdges()
+
+ Deletes all edges of theGraph, then adds the edges in the given list.
+ ********************************************************************/
+
+int  _KuratowskiBridges_ReplaceEdges(graphP theGraph, int *edgeList, int numEdges)
+{
+     int v, e, i;
+
+     for (v = gp_GetFirstVertex(theGraph); v < gp_VertexIndexBound(theGraph); v++)
+     {
+          e = gp_GetFirstArc(theGraph, v);
+          while (gp_IsArc(e))
+              e = gp_DeleteEdge(theGraph, e, 0);
+     }
+
+     for (i = 0; i < numEdges; i++)
+     {
+          if (gp_AddEdge(theGraph, edgeList[2*i], 0, edgeList[2*i+1], 0) != OK)
+              return NOTOK;
+     }
+
+     return OK;
+}
+
+/********************************************************************
+ _KuratowskiBridges_ExploreCases()
+
+ Tries the numCases embedding cases of H with tryCase() until one of
+ them extends, using numThreads threads, but no more threads than there
+ are cases.  The calling thread is one of them.  Each thread starts with
+ an equal share of the cases, in order, and a thread that runs out of
+ cases steals from the others, so a thread that draws cases with long
+ searches does not hold up the rest.  With one thread, the cases are
+ tried in order.  With more, the case that extends can differ from run
+ to run if more than one does.
+
+ Returns OK if a case extends, with the number of the thread that tried
+         it in pFoundBy, NONEMBEDDABLE if no case extends, and NOTOK on
+         internal error
+ ********************************************************************/
+
+int  _KuratowskiBridges_ExploreCases(void *context, int numCases, int numThreads,
+                                     kuratowskiCaseFunc tryCase, int *pFoundBy)
+{
+     kuratowskiCaseQueue queue;
+     kuratowskiCaseThread *threads = NULL;
+     platform_thread *threadHandles = NULL;
+     int *threadStarted = NULL;
+     int t, Result = OK;
+
+     if (numThreads > numCases)
+         numThreads = numCases;
+     if (numThreads < 1)
+         numThreads = 1;
+
+     queue.context = context;
+     queue.tryCase = tryCase;
+     queue.numCases = numCases;
+     queue.numThreads = numThreads;
+     queue.stop = 0;
+     queue.foundBy = -1;
+
+     if ((queue.ranges = (int *) malloc(numThreads * sizeof(int))) == NULL ||
+         (threads = (kuratowskiCaseThread *) calloc(numThreads, sizeof(kuratowskiCaseThread))) == NULL ||
+         (threadHandles = (platform_thread *) malloc(numThreads * sizeof(platform_thread))) == NULL ||
+         (threadStarted = (int *) calloc(numThreads, sizeof(int))) == NULL)
+         Result = NOTOK;
+
+     if (Result == OK)
+     {
+         for (t = 0; t < numThreads; t++)
+         {
+             queue.ranges[t] = (t * numCases / numThreads) * KURATOWSKICASES_RANGEBASE +
+                               (t+1) * numCases / numThreads;
+             threads[t].queue = &queue;
+             threads[t].threadNumber = t;
+             threads[t].Result = OK;
+         }
+
+         // If a thread cannot be started, then the other threads steal its cases
+         for (t = 1; t < numThreads; t++)
+             threadStarted[t] = platform_StartThread(threadHandles[t], _KuratowskiBridges_SearchCasesThread, &threads[t]);
+
+         _KuratowskiBridges_SearchCases(&threads[0]);
+
+         for (t = 1; t < numThreads; t++)
+             if (threadStarted[t])
+                 platform_JoinThread(threadHandles[t]);
+
+         for (t = 0; t < numThreads; t++)
+             if (threads[t].Result == NOTOK)
+                 Result = NOTOK;
+     }
+
+     if (queue.ranges != NULL) free(queue.ranges);
+     if (threads != NULL) free(threads);
+     if (threadHandles != NULL) free(threadHandles);
+     if (threadStarted != NULL) free(threadStarted);
+
+     *pFoundBy = queue.foundBy;
+
+     if (Result == OK && queue.foundBy < 0)
+         Result = NONEMBEDDABLE;
+
+     return Result;
+}
+
+/********************************************************************
+ _KuratowskiBridges_SearchCases()
+
+ Tries the cases taken by the thread until they run out or the search
+ is stopped.  A thread whose case extends or that fails stops the search
+ of all threads.
+ ********************************************************************/
+
+void _KuratowskiBridges_SearchCases(kuratowskiCaseThread *thread)
+{
+     kuratowskiCaseQueue *queue = thread->queue;
+     int k, Result;
+
+     while (!platform_AtomicGet(queue->stop))
+     {
+         if ((k = _KuratowskiBridges_NextCase(queue, thread->threadNumber)) < 0)
+             break;
+
+         Result = queue->tryCase(queue->context, thread->threadNumber, k);
+
+         if (Result == OK)
+             platform_AtomicCompareAndSet(queue->foundBy, -1, thread->threadNumber);
+         else if (Result != NONEMBEDDABLE)
+             thread->Result = NOTOK;
+
+         if (Result != NONEMBEDDABLE)
+             platform_AtomicSet(queue->stop, 1);
+     }
+}
+
+/********************************************************************
+ _KuratowskiBridges_SearchCasesThread()
+
+ The thread function for the threads started by
+ _KuratowskiBridges_ExploreCases()
+ ********************************************************************/
+
+platform_ThreadReturn _KuratowskiBridges_SearchCasesThread(void *thread)
+{
+     _KuratowskiBridges_SearchCases((kuratowskiCaseThread *) thread);
+     return platform_ThreadReturnValue;
+}
+
+/********************************************************************
+ _KuratowskiBridges_NextCase()
+
+ Takes the next case from the front of the range of thread t.  If the
+ range is empty, then the back half of the range of another thread is
+ stolen, and the first stolen case is taken while the rest become the
+ range of thread t.  Only an empty range is replaced, and each case is
+ in one range at a time, so a range that is stolen from has not been
+ emptied and refilled since it was read.
+
+ Returns the case number, or -1 if no cases remain in any range
+ ********************************************************************/
+
+int  _KuratowskiBridges_NextCase(kuratowskiCaseQueue *queue, int t)
+{
+     int range, next, end, mid, i, victim;
+
+     for (;;)
+     {
+         range = platform_AtomicGet(queue->ranges[t]);
+         next = range / KURATOWSKICASES_RANGEBASE;
+         end = range % KURATOWSKICASES_RANGEBASE;
+         if (next >= end)
+             break;
+
+         if (platform_AtomicCompareAndSet(queue->ranges[t], range, range + KURATOWSKICASES_RANGEBASE))
+             return next;
+     }
+
+     for (i = 1; i < queue->numThreads; i++)
+     {
+         victim = (t + i) % queue->numThreads;
+         for (;;)
+         {
+             range = platform_AtomicGet(queue->ranges[victim]);
+             next = range / KURATOWSKICASES_RANGEBASE;
+             end = range % KURATOWSKICASES_RANGEBASE;
+             if (next >= end)
+                 break;
+
+             mid = next + (end - next) / 2;
+             if (platform_AtomicCompareAndSet(queue->ranges[victim], range, next * KURATOWSKICASES_RANGEBASE + mid))
+             {
+                 platform_AtomicSet(queue->ranges[t], (mid+1) * KURATOWSKICASES_RANGEBASE + end);
+                 return mid;
+             }
+         }
+     }
+
+     return -1;
+}
@@ -0,0 +1,180 @@
+#ifndef GRAPH_KURATOWSKIBRIDGES_PRIVATE_H
+#define GRAPH_KURATOWSKIBRIDGES_PRIVATE_H
+
+/*
+Planarity-Related Graph Algorithms Project
+Copyright (c) 1997-2012, John M. Boyer
+All rights reserved. Includes a reference implementation of the following:
+
+* John M. Boyer. "Subgraph Homeomorphism via the Edge Addition Planarity Algorithm".
+  Journal of Graph Algorithms and Applications, Vol. 16, no. 2, pp. 381-410, 2012.
+  http://www.jgaa.info/16/268.html
+
+* John M. Boyer. "A New Method for Efficiently Generating Planar Graph
+  Visibility Representations". In P. Eades and P. Healy, editors,
+  Proceedings of the 13th International Conference on Graph Drawing 2005,
+  Lecture Notes Comput. Sci., Volume 3843, pp. 508-511, Springer-Verlag, 2006.
+
+* John M. Boyer and Wendy J. Myrvold. "On the Cutting Edge: Simplified O(n)
+  Planarity by Edge Addition". Journal of Graph Algorithms and Applications,
+  Vol. 8, No. 3, pp. 241-273, 2004.
+  http://www.jgaa.info/08/91.html
+
+* John M. Boyer. "Simplified O(n) Algorithms for Planar Graph Embedding,
+  Kuratowski Subgraph Isolation, and Related Problems". Ph.D. Dissertation,
+  University of Victoria, 2001.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+  list of conditions and the following disclaimer in the documentation and/or
+  other materials provided with the distribution.
+
+* Neither the name of the Planarity-Related Graph Algorithms Project nor the names
+  of its contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "graph.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/********************************************************************
+ The Kuratowski subgraph and its bridges, of graphKuratowskiBridges.c
+
+ The projective planarity and toroidal embedding tests both start from a
+ subgraph H homeomorphic to K5 or K_{3,3}, isolated by the core planarity
+ algorithm, and try to extend each embedding of H in the surface to the
+ whole graph.  This structure holds the graph being tested, with vertices
+ numbered from firstVertex, together with H, the paths of H joining its
+ branch vertices, and the bridges of H, none of which depend on the
+ embedding of H being extended.
+ */
+
+typedef struct
+{
+    // The graph being tested, with adjacency arrays that store the index
+    // of each edge in the edges array
+    int firstVertex, N, M;
+    int *edges;
+    int *adjStart, *adjList, *adjEdge;
+
+    // The edges of H and the degree of each vertex in H
+    int numHEdges;
+    int *hEdges, *hDegree;
+
+    // The branch vertices of H, with a label for each vertex that is 0 to 4
+    // for K5 or 0 to 5 for K_{3,3}, and -1 for vertices that are not branch
+    // vertices.  For K_{3,3}, labels 0 to 2 are on one side of the bipartition
+    int isK5;
+    int branch[6];
+    int *label;
+
+    // The paths of H joining pairs of branch vertices.  The vertices of the
+    // path joining the branch vertices labeled i and j, including the two
+    // branch vertices, are stored in order from one of the branch vertices
+    // to the other, starting at pathStart[pathIndex[i][j]], and the edge
+    // from each vertex of the path to the next is stored at the same index
+    int numPaths;
+    int pathIndex[6][6];
+    int pathStart[10], pathLength[10];
+    int *pathVertices, *pathEdges;
+
+    // The bridges of H, each of which is an edge joining two vertices of H
+    // or a connected component of G-H together with its edges to H.  The
+    // bridge of each edge is in edgeBridge, or -1 for the edges of H, and
+    // the bridge of each vertex of G-H is in bridgeOf.  Each bridge has a
+    // contiguous range of its edges, of its distinct attachments, which are
+    // its vertices in H, and of its ends, which are the pairs of an edge of
+    // the bridge and an endpoint of the edge in H, in the order of the edges
+    int numBridges, maxBridgeEdges;
+    int *edgeBridge, *bridgeOf;
+    int *edgeStart, *bridgeEdges;
+    int *attachStart, *attachments;
+    int *endStart, *endVertex;
+
+    // Vertex markings, and a queue for finding the bridges
+    int *stamp;
+    int stampValue;
+    int *queue;
+
+} kuratowskiBridges;
+
+typedef kuratowskiBridges * kuratowskiBridgesP;
+
+/********************************************************************
+ The exploration of the embedding cases of H
+
+ Each embedding of H in the surface is a case that is tried separately,
+ by a caller-supplied function that is given the thread number and the
+ case number, and that returns OK if the case extends to an embedding of
+ the whole graph, NONEMBEDDABLE if not, and NOTOK on internal error.
+
+ Each thread has a contiguous range of the cases that remain, packed
+ into one int as next*KURATOWSKICASES_RANGEBASE + end, so that a range
+ can be changed atomically.  A thread takes the cases from the front of
+ its own range, and when the range is empty, it steals the back half of
+ the range of another thread.  Once a case extends, or a thread fails,
+ stop is set so that no thread takes another case.  The first thread
+ whose case extends sets foundBy to its thread number.
+ */
+
+#define KURATOWSKICASES_RANGEBASE 65536
+
+// Graphs with fewer edges are explored by one thread, since each case
+// takes less time than starting a thread
+#define KURATOWSKICASES_MINPARALLELEDGES 64
+
+typedef int (*kuratowskiCaseFunc)(void *context, int threadNumber, int caseNumber);
+
+typedef struct
+{
+    void *context;
+    kuratowskiCaseFunc tryCase;
+    int numCases, numThreads;
+    int *ranges;
+    int stop, foundBy;
+} kuratowskiCaseQueue;
+
+typedef struct
+{
+    kuratowskiCaseQueue *queue;
+    int threadNumber;
+    int Result;
+} kuratowskiCaseThread;
+
+int  _KuratowskiBridges_New(kuratowskiBridgesP kb, graphP theGraph, int *edgeList, int numEdges);
+void _KuratowskiBridges_Free(kuratowskiBridgesP kb);
+int  _KuratowskiBridges_GetNumThreads(kuratowskiBridgesP kb, int numThreads);
+
+int  _KuratowskiBridges_GetSubgraph(kuratowskiBridgesP kb, graphP theGraph, int getIndex);
+int  _KuratowskiBridges_FindBridges(kuratowskiBridgesP kb);
+int  _KuratowskiBridges_RemoveEdge(kuratowskiBridgesP kb, int i);
+void _KuratowskiBridges_RestoreEdge(kuratowskiBridgesP kb, int i);
+int  _KuratowskiBridges_ReplaceEdges(graphP theGraph, int *edgeList, int numEdges);
+
+int  _KuratowskiBridges_ExploreCases(void *context, int numCases, int numThreads,
+                                     kuratowskiCaseFunc tryCase, int *pFoundBy);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,610 @@
+/*
+Planarity-Related Graph Algorithms Project
+Copyright (c) 1997-2012, John M. Boyer
+All rights reserved. Includes a reference implementation of the following:
+
+* John M. Boyer. "Subgraph Homeomorphism via the Edge Addition Planarity Algorithm".
+  Journal of Graph Algorithms and Applications, Vol. 16, no. 2, pp. 381-410, 2012.
+  http://www.jgaa.info/16/268.html
+
+* John M. Boyer. "A New Method for Efficiently Generating Planar Graph
+  Visibility Representations". In P. Eades and P. Healy, editors,
+  Proceedings of the 13th International Conference on Graph Drawing 2005,
+  Lecture Notes Comput. Sci., Volume 3843, pp. 508-511, Springer-Verlag, 2006.
+
+* John M. Boyer and Wendy J. Myrvold. "On the Cutting Edge: Simplified O(n)
+  Planarity by Edge Addition". Journal of Graph Algorithms and Applications,
+  Vol. 8, No. 3, pp. 241-273, 2004.
+  http://www.jgaa.info/08/91.html
+
+* John M. Boyer. "Simplified O(n) Algorithms for Planar Graph Embedding,
+  Kuratowski Subgraph Isolation, and Related Problems". Ph.D. Dissertation,
+  University of Victoria, 2001.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+  list of conditions and the following disclaimer in the documentation and/or
+  other materials provided with the distribution.
+
+* Neither the name of the Planarity-Related Graph Algorithms Project nor the names
+  of its contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include <stdlib.h>
+
+#include "graphMaxPlanarSubgraph.h"
+#include "graphMaxPlanarSubgraph.private.h"
+
+#include "graph.h"
+
+extern const int MAXPLANARSUBGRAPH_ID;
+
+/* Imported functions */
+
+extern void _InitEdgeRec(graphP theGraph, int e);
+extern int  _TestSubgraph(graphP theSubgraph, graphP theGraph);
+extern int  _CheckEmbeddingFacialIntegrity(graphP theGraph);
+
+/* Private functions (exported to system) */
+
+int  _DeleteBlockedEdges(graphP theGraph, MaxPlanarSubgraphContext *context, int v, int RootVertex, int R);
+int  _RestoreDeletedEdges(graphP theGraph, MaxPlanarSubgraphContext *context);
+int  _CheckMaxPlanarSubgraphIntegrity(graphP theGraph, MaxPlanarSubgraphContext *context, graphP origGraph);
+
+/* Private functions */
+
+int  _MaxPlanarSubgraph_DeleteFwdArc(graphP theGraph, MaxPlanarSubgraphContext *context, int v, int e);
+void _MaxPlanarSubgraph_ClearPertinence(graphP theGraph, MaxPlanarSubgraphContext *context, int W, int StopRoot);
+
+graphP _MaxPlanarSubgraph_NewTestGraph(graphP theGraph);
+int  _MaxPlanarSubgraph_EmbedTestGraph(graphP theGraph, graphP testGraph, int u, int w);
+int  _MaxPlanarSubgraph_FindComponent(int *parent, int v);
+int  _MaxPlanarSubgraph_TestEdge(graphP workGraph, int u, int w);
+
+/********************************************************************
+ gp_MaxPlanarSubgraph_GetNumDeletedEdges()
+
+ Returns the number of edges of the input graph that are not in the
+ maximal planar subgraph computed by gp_Embed() with the flag
+ EMBEDFLAGS_MAXIMALPLANARSUBGRAPH.
+ ********************************************************************/
+
+int  gp_MaxPlanarSubgraph_GetNumDeletedEdges(graphP theGraph)
+{
+    MaxPlanarSubgraphContext *context = (MaxPlanarSubgraphContext *) gp_GetExtension(theGraph, MAXPLANARSUBGRAPH_ID);
+	return context == NULL ? 0 : context->numDeletedEdges;
+}
+
+/********************************************************************
+ gp_MaxPlanarSubgraph_GetDeletedEdge()
+
+ Obtains the endpoints of the i-th deleted edge, for i from 0 to one
+ less than the number of deleted edges.  The endpoints are given in
+ the current vertex numbering of theGraph, so they are DFIs right after
+ gp_Embed() and original vertex numbers after gp_SortVertices().
+
+ Returns OK on success, NOTOK if i is out of range
+ ********************************************************************/
+
+int  gp_MaxPlanarSubgraph_GetDeletedEdge(graphP theGraph, int i, int *pu, int *pv)
+{
+    MaxPlanarSubgraphContext *context = (MaxPlanarSubgraphContext *) gp_GetExtension(theGraph, MAXPLANARSUBGRAPH_ID);
+
+    if (context == NULL || i < 0 || i >= context->numDeletedEdges)
+        return NOTOK;
+
+    *pu = context->deletedEdges[2*i];
+    *pv = context->deletedEdges[2*i+1];
+
+    return OK;
+}
+
+/****************************************************************************
+ _DeleteBlockedEdges()
+
+ The Walkdown has been blocked in the bicomp rooted by R, or the Walkdown
+ has finished (R == RootVertex) without embedding all of the back edges
+ from v into the subtree of the DFS child in the root edge of RootVertex.
+ Rather than isolating an obstruction, the unembedded back edges from v
+ into the DFS subtree of the child in the root edge of R are deleted, and
+ their pertinence is cleared from the vertices and bicomp roots through
+ which the Walkups reached R.  Since the forward arc list of v is sorted
+ by descendant DFI, the forward arcs to be deleted are contiguous.
+
+ When the Walkdown is blocked in a descendant bicomp, the root R is no
+ longer pertinent, so it is removed from the pertinent roots of the cut
+ vertex W on top of the stack.  If W is then no longer pertinent and W is
+ not in the bicomp rooted by RootVertex, then the stack is popped back to
+ the preceding cut vertex, so that the Walkdown reconsiders its choice
+ of direction in the bicomp containing W.  This keeps the invariant that
+ the Walkdown only stops at a stopping vertex when the stack is empty.
+
+ Returns OK to proceed with the Walkdown, NOTOK on internal error
+ ****************************************************************************/
+
+int  _DeleteBlockedEdges(graphP theGraph, MaxPlanarSubgraphContext *context, int v, int RootVertex, int R)
+{
+     int  child = gp_GetDFSChildFromRoot(theGraph, R);
+     int  lastDescendant = context->lastDescendant[child];
+     int  e, eNext, W, stackSize;
+
+     context->stamp++;
+
+     e = gp_GetVertexFwdArcList(theGraph, v);
+     while (gp_IsArc(e) && gp_GetNeighbor(theGraph, e) <= lastDescendant)
+     {
+         eNext = gp_GetNextArc(theGraph, e);
+         if (eNext == gp_GetVertexFwdArcList(theGraph, v))
+             eNext = NIL;
+
+         if (gp_GetNeighbor(theGraph, e) >= child)
+         {
+             _MaxPlanarSubgraph_ClearPertinence(theGraph, context, gp_GetNeighbor(theGraph, e), R);
+             if (_MaxPlanarSubgraph_DeleteFwdArc(theGraph, context, v, e) != OK)
+                 return NOTOK;
+         }
+
+         e = eNext;
+     }
+
+     if (R != RootVertex)
+     {
+         stackSize = sp_GetCurrentSize(theGraph->theStack);
+         W = sp_Get(theGraph->theStack, stackSize-2);
+         gp_DeleteVertexPertinentRoot(theGraph, W, R);
+
+         // Pop the pairs (W, WPrevLink) and (R', RootSide) so that the Walkdown
+         // resumes at the cut vertex whose pertinent root R' led to W
+         if (gp_IsNotVertex(gp_GetVertexPertinentRootsList(theGraph, W)) && stackSize > 2)
+             sp_SetCurrentSize(theGraph->theStack, stackSize-4);
+     }
+
+     return OK;
+}
+
+/****************************************************************************
+ _MaxPlanarSubgraph_DeleteFwdArc()
+
+ Records the deletion of the back edge whose forward arc e is in the
+ forward arc list of v, then removes e from the list in the same way as
+ _EmbedBackEdgeToDescendant() and frees the edge records in the same way
+ as gp_DeleteEdge().  The back arc of an unembedded back edge is not in
+ any adjacency list, so neither arc needs to be detached.
+ ****************************************************************************/
+
+int  _MaxPlanarSubgraph_DeleteFwdArc(graphP theGraph, MaxPlanarSubgraphContext *context, int v, int e)
+{
+     context->deletedEdges[2*context->numDeletedEdges] = v;
+     context->deletedEdges[2*context->numDeletedEdges+1] = gp_GetNeighbor(theGraph, e);
+     context->numDeletedEdges++;
+
+     if (gp_GetVertexFwdArcList(theGraph, v) == e)
+     {
+         gp_SetVertexFwdArcList(theGraph, v, gp_GetNextArc(theGraph, e));
+         if (gp_GetVertexFwdArcList(theGraph, v) == e)
+             gp_SetVertexFwdArcList(theGraph, v, NIL);
+     }
+
+     gp_SetNextArc(theGraph, gp_GetPrevArc(theGraph, e), gp_GetNextArc(theGraph, e));
+     gp_SetPrevArc(theGraph, gp_GetNextArc(theGraph, e), gp_GetPrevArc(theGraph, e));
+
+#if NIL == 0
+     memset(theGraph->E + (e & ~1), NIL_CHAR, sizeof(edgeRec) << 1);
+#else
+     _InitEdgeRec(theGraph, e);
+     _InitEdgeRec(theGraph, gp_GetTwinArc(theGraph, e));
+#endif
+
+     theGraph->M--;
+
+     if (e < gp_EdgeInUseIndexBound(theGraph))
+     {
+         sp_Push(theGraph->edgeHoles, e);
+     }
+
+     return OK;
+}
+
+/****************************************************************************
+ _MaxPlanarSubgraph_ClearPertinence()
+
+ Undoes the Walkup for a deleted back edge to the descendant W by clearing
+ the pertinent edge of W and then traversing the same external face paths
+ as the Walkup, in parallel, up to the bicomp root StopRoot.  The pertinent
+ roots of each cut vertex reached along the way are cleared entirely since
+ all of the cut vertex's pertinence comes from back edges being deleted.
+ The traversal stops early at any vertex visited by a traversal for another
+ deleted edge in the same call to _DeleteBlockedEdges(), since the rest of
+ the path up to StopRoot has already been cleared.
+ ****************************************************************************/
+
+void _MaxPlanarSubgraph_ClearPertinence(graphP theGraph, MaxPlanarSubgraphContext *context, int W, int StopRoot)
+{
+     int  Zig=W, Zag=W, ZigPrevLink=1, ZagPrevLink=0;
+     int  nextZig, nextZag, R;
+
+     gp_SetVertexPertinentEdge(theGraph, W, NIL);
+
+     while (context->visitedStamp[Zig] != context->stamp &&
+            context->visitedStamp[Zag] != context->stamp)
+     {
+         context->visitedStamp[Zig] = context->visitedStamp[Zag] = context->stamp;
+
+         nextZig = gp_GetExtFaceVertex(theGraph, Zig, 1^ZigPrevLink);
+         nextZag = gp_GetExtFaceVertex(theGraph, Zag, 1^ZagPrevLink);
+
+         if (gp_IsVirtualVertex(theGraph, nextZig))
+             R = nextZig;
+         else if (gp_IsVirtualVertex(theGraph, nextZag))
+             R = nextZag;
+         else
+             R = NIL;
+
+         if (gp_IsNotVertex(R))
+         {
+             ZigPrevLink = gp_GetExtFaceVertex(theGraph, nextZig, 0)==Zig ? 0 : 1;
+             Zig = nextZig;
+
+             ZagPrevLink = gp_GetExtFaceVertex(theGraph, nextZag, 0)==Zag ? 0 : 1;
+             Zag = nextZag;
+         }
+         else
+         {
+             if (R == StopRoot)
+                 break;
+
+             Zig = Zag = gp_GetPrimaryVertexFromRoot(theGraph, R);
+             ZigPrevLink = 1;
+             ZagPrevLink = 0;
+
+             gp_SetVertexPertinentRootsList(theGraph, Zig, NIL);
+         }
+     }
+}
+
+/****************************************************************************
+ _RestoreDeletedEdges()
+
+ The deletions made during the Walkdowns are decided locally, so some
+ deleted edges may be addable to the final planar subgraph.  The planar
+ subgraph is copied into a plain work graph, and each deleted edge is
+ added to the work graph if the work graph stays planar.  Since an edge
+ that cannot be added to a planar subgraph cannot be added to any
+ supergraph of it, a single pass over the deleted edges yields a maximal
+ planar subgraph.
+
+ The connected components of the work graph are kept in a union-find
+ structure, with their numbers of vertices and edges and whether they are
+ simple.  An edge joining two components always keeps the graph planar.
+ An edge within a simple component that has 3n-6 edges on n vertices, so
+ is maximal planar, keeps the graph planar only if it parallels an edge.
+ Any other edge is tested by embedding the work graph with the edge added,
+ within a transaction that is then rolled back.
+
+ Once all deleted edges have been tried, the work graph is embedded, and
+ its adjacency lists are copied into theGraph, so that theGraph is a planar
+ embedding of the maximal planar subgraph.  The work graph has the vertex
+ numbering of theGraph, and the edges kept by the Walkdown have the same
+ positions in both graphs, so the edge records of theGraph stay with them.
+
+ Cost: an edge decided by the union-find structure takes near-constant
+ time, apart from the parallel edge test, so once the Walkdown deletions
+ leave a maximal planar component, as they tend to for dense inputs, the
+ rest of its deleted edges are rejected without embedding.  Otherwise,
+ each test takes linear time, so the worst case remains proportional to
+ the number of deleted edges times the size of the graph.
+
+ Returns NONEMBEDDABLE with theGraph reduced to a planar embedding of a
+               maximal planar subgraph and with the remaining deleted
+               edges recorded in the context
+         NOTOK on internal error
+ ****************************************************************************/
+
+int  _RestoreDeletedEdges(graphP theGraph, MaxPlanarSubgraphContext *context)
+{
+     graphP workGraph;
+     int  *parent = NULL, *componentN, *componentM, *componentSimple, *neighborStamp;
+     int  Vsize = gp_PrimaryVertexIndexBound(theGraph);
+     int  numDeletedEdges = 0, numRestoredEdges = 0;
+     int  i, u, w, cu, cw, v, e, Result = OK;
+
+     if ((workGraph = _MaxPlanarSubgraph_NewTestGraph(theGraph)) == NULL)
+         return NOTOK;
+
+     if ((parent = (int *) malloc(5 * Vsize * sizeof(int))) == NULL ||
+         gp_CopyAdjacencyLists(workGraph, theGraph) != OK)
+     {
+         if (parent != NULL) free(parent);
+         gp_Free(&workGraph);
+         return NOTOK;
+     }
+
+     componentN = parent + Vsize;
+     componentM = componentN + Vsize;
+     componentSimple = componentM + Vsize;
+     neighborStamp = componentSimple + Vsize;
+
+     // Find the connected components of the work graph, then count the
+     // vertices and edges of each one, and find whether it is simple
+     for (v = gp_GetFirstVertex(workGraph); gp_VertexInRange(workGraph, v); v++)
+     {
+         parent[v] = v;
+         componentN[v] = componentM[v] = 0;
+         componentSimple[v] = TRUE;
+         neighborStamp[v] = NIL;
+     }
+
+     for (v = gp_GetFirstVertex(workGraph); gp_VertexInRange(workGraph, v); v++)
+     {
+         e = gp_GetFirstArc(workGraph, v);
+         while (gp_IsArc(e))
+         {
+             cu = _MaxPlanarSubgraph_FindComponent(parent, v);
+             cw = _MaxPlanarSubgraph_FindComponent(parent, gp_GetNeighbor(workGraph, e));
+             if (cu != cw)
+                 parent[cw] = cu;
+
+             e = gp_GetNextArc(workGraph, e);
+         }
+     }
+
+     for (v = gp_GetFirstVertex(workGraph); gp_VertexInRange(workGraph, v); v++)
+     {
+         cu = _MaxPlanarSubgraph_FindComponent(parent, v);
+         componentN[cu]++;
+
+         e = gp_GetFirstArc(workGraph, v);
+         while (gp_IsArc(e))
+         {
+             w = gp_GetNeighbor(workGraph, e);
+             if (v < w)
+                 componentM[cu]++;
+             if (w == v || neighborStamp[w] == v)
+                 componentSimple[cu] = FALSE;
+             neighborStamp[w] = v;
+
+             e = gp_GetNextArc(workGraph, e);
+         }
+     }
+
+     for (i = 0; i < context->numDeletedEdges && Result == OK; i++)
+     {
+         u = context->deletedEdges[2*i];
+         w = context->deletedEdges[2*i+1];
+         cu = _MaxPlanarSubgraph_FindComponent(parent, u);
+         cw = _MaxPlanarSubgraph_FindComponent(parent, w);
+
+         if (cu != cw)
+             Result = OK;
+         else if (componentSimple[cu] && componentN[cu] >= 3 && componentM[cu] == 3 * componentN[cu] - 6)
+             Result = gp_IsNeighbor(workGraph, u, w) ? OK : NONEMBEDDABLE;
+         else
+             Result = _MaxPlanarSubgraph_TestEdge(workGraph, u, w);
+
+         if (Result == OK)
+         {
+             if (cu != cw)
+             {
+                 parent[cw] = cu;
+                 componentN[cu] += componentN[cw];
+                 componentM[cu] += componentM[cw];
+                 componentSimple[cu] = componentSimple[cu] && componentSimple[cw];
+             }
+             else if (gp_IsNeighbor(workGraph, u, w))
+                 componentSimple[cu] = FALSE;
+
+             componentM[cu]++;
+             Result = gp_AddEdge(workGraph, u, 0, w, 0);
+             numRestoredEdges++;
+         }
+         else if (Result == NONEMBEDDABLE)
+         {
+             context->deletedEdges[2*numDeletedEdges] = u;
+             context->deletedEdges[2*numDeletedEdges+1] = w;
+             numDeletedEdges++;
+             Result = OK;
+         }
+     }
+
+     // Embed the maximal planar subgraph once, and give theGraph its embedding
+     if (Result == OK && numRestoredEdges > 0)
+     {
+         Result = gp_Embed(workGraph, EMBEDFLAGS_PLANAR);
+         if (Result == OK && (workGraph->internalFlags & FLAGS_SORTEDBYDFI))
+             Result = gp_SortVertices(workGraph);
+         if (Result == OK)
+             Result = gp_CopyAdjacencyLists(theGraph, workGraph);
+     }
+
+     free(parent);
+     gp_Free(&workGraph);
+
+     if (Result != OK)
+         return NOTOK;
+
+     context->numDeletedEdges = numDeletedEdges;
+     return NONEMBEDDABLE;
+}
+
+/****************************************************************************
+ _MaxPlanarSubgraph_FindComponent()
+
+ Returns the representative of the component containing v in the union-find
+ structure given by parent, halving the path from v along the way.
+ ****************************************************************************/
+
+int  _MaxPlanarSubgraph_FindComponent(int *parent, int v)
+{
+     while (parent[v] != v)
+     {
+         parent[v] = parent[parent[v]];
+         v = parent[v];
+     }
+
+     return v;
+}
+
+/****************************************************************************
+ _MaxPlanarSubgraph_TestEdge()
+
+ Determines whether workGraph stays planar when the edge (u, w) is added.
+ The edge is added and workGraph is embedded within a transaction that is
+ then rolled back, so workGraph is not changed.
+
+ Returns OK if planar, NONEMBEDDABLE if not, NOTOK on internal error
+ ****************************************************************************/
+
+int  _MaxPlanarSubgraph_TestEdge(graphP workGraph, int u, int w)
+{
+     int  Result;
+
+     if (gp_BeginTransaction(workGraph) != OK)
+         return NOTOK;
+
+     Result = gp_AddEdge(workGraph, u, 0, w, 0);
+     if (Result == OK)
+         Result = gp_Embed(workGraph, EMBEDFLAGS_PLANAR);
+
+     if (gp_Rollback(workGraph) != OK)
+         Result = NOTOK;
+
+     return Result;
+}
+
+/****************************************************************************
+ _CheckMaxPlanarSubgraphIntegrity()
+
+ Checks that theGraph is a planar embedding of a subgraph of the original
+ graph, that the deleted edges are exactly the edges of the original graph
+ that are not in theGraph, and that adding any one of the deleted edges to
+ theGraph makes it nonplanar.
+
+ Returns OK if all integrity tests passed, NOTOK otherwise
+ ****************************************************************************/
+
+int  _CheckMaxPlanarSubgraphIntegrity(graphP theGraph, MaxPlanarSubgraphContext *context, graphP origGraph)
+{
+     graphP testGraph = NULL;
+     int  i, u, w, RetVal = OK;
+     int  invokeSortOnGraph = FALSE;
+
+     // Give theGraph the vertex order of the original graph so that the
+     // endpoints of the deleted edges can be found in the original graph
+     if (!(origGraph->internalFlags & FLAGS_SORTEDBYDFI) &&
+          (theGraph->internalFlags & FLAGS_SORTEDBYDFI))
+     {
+         invokeSortOnGraph = TRUE;
+         gp_SortVertices(theGraph);
+     }
+
+     if (_CheckEmbeddingFacialIntegrity(theGraph) != OK ||
+         _TestSubgraph(theGraph, origGraph) != TRUE ||
+         theGraph->M + context->numDeletedEdges != origGraph->M)
+         RetVal = NOTOK;
+
+     for (i = 0; i < context->numDeletedEdges && RetVal == OK; i++)
+     {
+         if (!gp_IsNeighbor(origGraph, context->deletedEdges[2*i], context->deletedEdges[2*i+1]))
+             RetVal = NOTOK;
+     }
+
+     if (RetVal == OK && (testGraph = _MaxPlanarSubgraph_NewTestGraph(theGraph)) == NULL)
+         RetVal = NOTOK;
+
+     if (RetVal == OK && _MaxPlanarSubgraph_EmbedTestGraph(theGraph, testGraph, NIL, NIL) != OK)
+         RetVal = NOTOK;
+
+     for (i = 0; i < context->numDeletedEdges && RetVal == OK; i++)
+     {
+         u = context->deletedEdges[2*i];
+         w = context->deletedEdges[2*i+1];
+
+         if (_MaxPlanarSubgraph_EmbedTestGraph(theGraph, testGraph, u, w) != NONEMBEDDABLE)
+             RetVal = NOTOK;
+     }
+
+     gp_Free(&testGraph);
+
+     if (invokeSortOnGraph)
+         gp_SortVertices(theGraph);
+
+     return RetVal;
+}
+
+/****************************************************************************
+ _MaxPlanarSubgraph_NewTestGraph()
+
+ Creates a graph without extensions that has the order and arc capacity
+ of theGraph, for use by _MaxPlanarSubgraph_EmbedTestGraph().
+ ****************************************************************************/
+
+graphP _MaxPlanarSubgraph_NewTestGraph(graphP theGraph)
+{
+     graphP testGraph = gp_New();
+
+     if (testGraph != NULL)
+     {
+         if (gp_EnsureArcCapacity(testGraph, theGraph->arcCapacity) != OK ||
+             gp_InitGraph(testGraph, theGraph->N) != OK)
+             gp_Free(&testGraph);
+     }
+
+     return testGraph;
+}
+
+/****************************************************************************
+ _MaxPlanarSubgraph_EmbedTestGraph()
+
+ Loads testGraph with the edges of theGraph, plus the edge (u, w) unless
+ u is NIL, and then runs the core planarity algorithm on testGraph.
+
+ Returns the result of gp_Embed(), or NOTOK if the edges could not be added
+ ****************************************************************************/
+
+int  _MaxPlanarSubgraph_EmbedTestGraph(graphP theGraph, graphP testGraph, int u, int w)
+{
+     int  v, e;
+
+     gp_ReinitializeGraph(testGraph);
+
+     for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
+     {
+         e = gp_GetFirstArc(theGraph, v);
+         while (gp_IsArc(e))
+         {
+             if (v < gp_GetNeighbor(theGraph, e))
+             {
+                 if (gp_AddEdge(testGraph, v, 0, gp_GetNeighbor(theGraph, e), 0) != OK)
+                     return NOTOK;
+             }
+
+             e = gp_GetNextArc(theGraph, e);
+         }
+     }
+
+     if (gp_IsVertex(u))
+     {
+         if (gp_AddEdge(testGraph, u, 0, w, 0) != OK)
+             return NOTOK;
+     }
+
+     return gp_Embed(testGraph, EMBEDFLAGS_PLANAR);
+}
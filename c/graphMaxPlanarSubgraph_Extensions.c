@@ -0,0 +1,504 @@
+/*
+Planarity-Related Graph Algorithms Project
+Copyright (c) 1997-2012, John M. Boyer
+All rights reserved. Includes a reference implementation of the following:
+
+* John M. Boyer. "Subgraph Homeomorphism via the Edge Addition Planarity Algorithm".
+  Journal of Graph Algorithms and Applications, Vol. 16, no. 2, pp. 381-410, 2012.
+  http://www.jgaa.info/16/268.html
+
+* John M. Boyer. "A New Method for Efficiently Generating Planar Graph
+  Visibility Representations". In P. Eades and P. Healy, editors,
+  Proceedings of the 13th International Conference on Graph Drawing 2005,
+  Lecture Notes Comput. Sci., Volume 3843, pp. 508-511, Springer-Verlag, 2006.
+
+* John M. Boyer and Wendy J. Myrvold. "On the Cutting Edge: Simplified O(n)
+  Planarity by Edge Addition". Journal of Graph Algorithms and Applications,
+  Vol. 8, No. 3, pp. 241-273, 2004.
+  http://www.jgaa.info/08/91.html
+
+* John M. Boyer. "Simplified O(n) Algorithms for Planar Graph Embedding,
+  Kuratowski Subgraph Isolation, and Related Problems". Ph.D. Dissertation,
+  University of Victoria, 2001.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+  list of conditions and the following disclaimer in the documentation and/or
+  other materials provided with the distribution.
+
+* Neither the name of the Planarity-Related Graph Algorithms Project nor the names
+  of its contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include <stdlib.h>
+
+#include "graphMaxPlanarSubgraph.private.h"
+#include "graphMaxPlanarSubgraph.h"
+
+extern int  _DeleteBlockedEdges(graphP theGraph, MaxPlanarSubgraphContext *context, int v, int RootVertex, int R);
+extern int  _RestoreDeletedEdges(graphP theGraph, MaxPlanarSubgraphContext *context);
+extern int  _CheckMaxPlanarSubgraphIntegrity(graphP theGraph, MaxPlanarSubgraphContext *context, graphP origGraph);
+
+/* Forward declarations of local functions */
+
+void _MaxPlanarSubgraph_ClearStructures(MaxPlanarSubgraphContext *context);
+int  _MaxPlanarSubgraph_CreateStructures(MaxPlanarSubgraphContext *context);
+int  _MaxPlanarSubgraph_InitStructures(MaxPlanarSubgraphContext *context);
+
+/* Forward declarations of overloading functions */
+int  _MaxPlanarSubgraph_EmbeddingInitialize(graphP theGraph);
+int  _MaxPlanarSubgraph_HandleBlockedBicomp(graphP theGraph, int v, int RootVertex, int R);
+int  _MaxPlanarSubgraph_EmbedPostprocess(graphP theGraph, int v, int edgeEmbeddingResult);
+int  _MaxPlanarSubgraph_CheckObstructionIntegrity(graphP theGraph, graphP origGraph);
+int  _MaxPlanarSubgraph_SortVertices(graphP theGraph);
+
+int  _MaxPlanarSubgraph_InitGraph(graphP theGraph, int N);
+void _MaxPlanarSubgraph_ReinitializeGraph(graphP theGraph);
+int  _MaxPlanarSubgraph_EnsureArcCapacity(graphP theGraph, int requiredArcCapacity);
+
+/* Forward declarations of functions used by the extension system */
+
+void *_MaxPlanarSubgraph_DupContext(void *pContext, void *theGraph);
+void _MaxPlanarSubgraph_FreeContext(void *);
+
+/****************************************************************************
+ * MAXPLANARSUBGRAPH_ID - the integer identifier for this extension,
+ * enabling this feature's extension context to be distinguished from
+ * other features' extension contexts that may be attached to a graph.
+ ****************************************************************************/
+
+const int MAXPLANARSUBGRAPH_ID = EXTENSIONID_MAXPLANARSUBGRAPH;
+
+/****************************************************************************
+ gp_AttachMaxPlanarSubgraph()
+
+ This function adjusts the graph data structure to attach the maximal
+ planar subgraph feature.
+ ****************************************************************************/
+
+int  gp_AttachMaxPlanarSubgraph(graphP theGraph)
+{
+     MaxPlanarSubgraphContext *context = NULL;
+     int moduleID = MAXPLANARSUBGRAPH_ID;
+
+     // If the maximal planar subgraph feature has already been attached to
+     // the graph, then there is no need to attach it again
+     gp_FindExtension(theGraph, MAXPLANARSUBGRAPH_ID, (void *)&context);
+     if (context != NULL)
+     {
+         return OK;
+     }
+
+     // Allocate a new extension context
+     context = (MaxPlanarSubgraphContext *) malloc(sizeof(MaxPlanarSubgraphContext));
+     if (context == NULL)
+     {
+         return NOTOK;
+     }
+
+     // First, tell the context that it is not initialized
+     context->initialized = 0;
+
+     // Save a pointer to theGraph in the context
+     context->theGraph = theGraph;
+
+     // Put the overload functions into the context function table.
+     // gp_AddExtension will overload the graph's functions with these, and
+     // return the base function pointers in the context function table
+     memset(&context->functions, 0, sizeof(graphFunctionTable));
+     context->functions.fpEmbeddingInitialize = _MaxPlanarSubgraph_EmbeddingInitialize;
+     context->functions.fpHandleBlockedBicomp = _MaxPlanarSubgraph_HandleBlockedBicomp;
+     context->functions.fpEmbedPostprocess = _MaxPlanarSubgraph_EmbedPostprocess;
+     context->functions.fpCheckObstructionIntegrity = _MaxPlanarSubgraph_CheckObstructionIntegrity;
+     context->functions.fpSortVertices = _MaxPlanarSubgraph_SortVertices;
+
+     context->functions.fpInitGraph = _MaxPlanarSubgraph_InitGraph;
+     context->functions.fpReinitializeGraph = _MaxPlanarSubgraph_ReinitializeGraph;
+     context->functions.fpEnsureArcCapacity = _MaxPlanarSubgraph_EnsureArcCapacity;
+
+     _MaxPlanarSubgraph_ClearStructures(context);
+
+     // Store the maximal planar subgraph context, including the data structure
+     // and the function pointers, as an extension of the graph
+     if (gp_AddExtension(theGraph, &moduleID, (void *) context,
+                         _MaxPlanarSubgraph_DupContext, _MaxPlanarSubgraph_FreeContext,
+                         &context->functions) != OK)
+     {
+         _MaxPlanarSubgraph_FreeContext(context);
+         return NOTOK;
+     }
+
+     // Create the structures if the size of the graph is known
+     // Attach functions are always invoked after gp_New(), but if a graph
+     // extension must be attached before gp_Read(), then the attachment
+     // also happens before gp_InitGraph(), which means N==0.
+     // However, sometimes a feature is attached after gp_InitGraph(), in
+     // which case N > 0
+     if (theGraph->N > 0)
+     {
+         if (_MaxPlanarSubgraph_CreateStructures(context) != OK ||
+             _MaxPlanarSubgraph_InitStructures(context) != OK)
+         {
+             _MaxPlanarSubgraph_FreeContext(context);
+             return NOTOK;
+         }
+     }
+
+     return OK;
+}
+
+/********************************************************************
+ gp_DetachMaxPlanarSubgraph()
+ ********************************************************************/
+
+int gp_DetachMaxPlanarSubgraph(graphP theGraph)
+{
+    return gp_RemoveExtension(theGraph, MAXPLANARSUBGRAPH_ID);
+}
+
+/********************************************************************
+ _MaxPlanarSubgraph_ClearStructures()
+ ********************************************************************/
+
+void _MaxPlanarSubgraph_ClearStructures(MaxPlanarSubgraphContext *context)
+{
+    if (!context->initialized)
+    {
+        // Before initialization, the pointers are stray, not NULL
+        // Once NULL or allocated, free() or LCFree() can do the job
+        context->deletedEdges = NULL;
+        context->lastDescendant = NULL;
+        context->visitedStamp = NULL;
+
+        context->initialized = 1;
+    }
+    else
+    {
+        if (context->deletedEdges != NULL)
+        {
+            free(context->deletedEdges);
+            context->deletedEdges = NULL;
+        }
+        if (context->lastDescendant != NULL)
+        {
+            free(context->lastDescendant);
+            context->lastDescendant = NULL;
+        }
+        if (context->visitedStamp != NULL)
+        {
+            free(context->visitedStamp);
+            context->visitedStamp = NULL;
+        }
+    }
+
+    context->numDeletedEdges = 0;
+    context->stamp = 0;
+}
+
+/********************************************************************
+ _MaxPlanarSubgraph_CreateStructures()
+ Create uninitialized structures for the vertex and edge levels, and
+ initialized structures for the graph level
+ ********************************************************************/
+int  _MaxPlanarSubgraph_CreateStructures(MaxPlanarSubgraphContext *context)
+{
+     graphP theGraph = context->theGraph;
+
+     // Two endpoints are recorded per deleted edge, so one int per arc suffices
+     int Esize = gp_EdgeIndexBound(theGraph);
+     int VIsize = gp_PrimaryVertexIndexBound(theGraph);
+
+     if (theGraph->N <= 0)
+         return NOTOK;
+
+     if ((context->deletedEdges = (int *) malloc(Esize*sizeof(int))) == NULL ||
+         (context->lastDescendant = (int *) malloc(VIsize*sizeof(int))) == NULL ||
+         (context->visitedStamp = (int *) malloc(VIsize*sizeof(int))) == NULL
+        )
+     {
+         return NOTOK;
+     }
+
+     return OK;
+}
+
+/********************************************************************
+ _MaxPlanarSubgraph_InitStructures()
+ ********************************************************************/
+int  _MaxPlanarSubgraph_InitStructures(MaxPlanarSubgraphContext *context)
+{
+     context->numDeletedEdges = 0;
+     context->stamp = 0;
+     memset(context->visitedStamp, 0,
+            gp_PrimaryVertexIndexBound(context->theGraph)*sizeof(int));
+
+     return OK;
+}
+
+/********************************************************************
+ ********************************************************************/
+
+int  _MaxPlanarSubgraph_InitGraph(graphP theGraph, int N)
+{
+    MaxPlanarSubgraphContext *context = NULL;
+    gp_FindExtension(theGraph, MAXPLANARSUBGRAPH_ID, (void *)&context);
+
+    if (context == NULL)
+        return NOTOK;
+
+    theGraph->N = N;
+	theGraph->NV = N;
+	if (theGraph->arcCapacity == 0)
+		theGraph->arcCapacity = 2*DEFAULT_EDGE_LIMIT*N;
+
+	if (_MaxPlanarSubgraph_CreateStructures(context) != OK ||
+		_MaxPlanarSubgraph_InitStructures(context) != OK)
+		return NOTOK;
+
+	context->functions.fpInitGraph(theGraph, N);
+
+    return OK;
+}
+
+/********************************************************************
+ ********************************************************************/
+
+void _MaxPlanarSubgraph_ReinitializeGraph(graphP theGraph)
+{
+    MaxPlanarSubgraphContext *context = NULL;
+    gp_FindExtension(theGraph, MAXPLANARSUBGRAPH_ID, (void *)&context);
+
+    if (context != NULL)
+    {
+		// Reinitialize the graph
+		context->functions.fpReinitializeGraph(theGraph);
+
+		// Do the reinitialization that is specific to this module
+		_MaxPlanarSubgraph_InitStructures(context);
+    }
+}
+
+/********************************************************************
+ The current implementation does not support an increase of arc
+ (edge record) capacity once the extension is attached to the graph
+ data structure.  This is only due to not being necessary to support.
+ For now, it is easy to ensure the correct capacity before attaching
+ the extension, but support could be added later if there is some
+ reason to do so.
+ ********************************************************************/
+
+int  _MaxPlanarSubgraph_EnsureArcCapacity(graphP theGraph, int requiredArcCapacity)
+{
+	return NOTOK;
+}
+
+/********************************************************************
+ _MaxPlanarSubgraph_DupContext()
+ ********************************************************************/
+
+void *_MaxPlanarSubgraph_DupContext(void *pContext, void *theGraph)
+{
+     MaxPlanarSubgraphContext *context = (MaxPlanarSubgraphContext *) pContext;
+     MaxPlanarSubgraphContext *newContext = (MaxPlanarSubgraphContext *) malloc(sizeof(MaxPlanarSubgraphContext));
+
+     if (newContext != NULL)
+     {
+         int VIsize = gp_PrimaryVertexIndexBound((graphP) theGraph);
+
+         *newContext = *context;
+
+         newContext->theGraph = (graphP) theGraph;
+
+         newContext->initialized = 0;
+         _MaxPlanarSubgraph_ClearStructures(newContext);
+         if (((graphP) theGraph)->N > 0)
+         {
+             if (_MaxPlanarSubgraph_CreateStructures(newContext) != OK)
+             {
+                 _MaxPlanarSubgraph_FreeContext(newContext);
+                 return NULL;
+             }
+
+             newContext->numDeletedEdges = context->numDeletedEdges;
+             newContext->stamp = context->stamp;
+             memcpy(newContext->deletedEdges, context->deletedEdges, 2*context->numDeletedEdges*sizeof(int));
+             memcpy(newContext->lastDescendant, context->lastDescendant, VIsize*sizeof(int));
+             memcpy(newContext->visitedStamp, context->visitedStamp, VIsize*sizeof(int));
+         }
+     }
+
+     return newContext;
+}
+
+/********************************************************************
+ _MaxPlanarSubgraph_FreeContext()
+ ********************************************************************/
+
+void _MaxPlanarSubgraph_FreeContext(void *pContext)
+{
+     MaxPlanarSubgraphContext *context = (MaxPlanarSubgraphContext *) pContext;
+
+     _MaxPlanarSubgraph_ClearStructures(context);
+     free(pContext);
+}
+
+/********************************************************************
+ _MaxPlanarSubgraph_EmbeddingInitialize()
+
+ After the base embedding initialization, the vertices are in DFI order,
+ so the last descendant of each vertex is computed by propagating DFIs
+ from children to parents in descending DFI order.  The DFS subtree of
+ a vertex u then consists of the vertices from u to lastDescendant[u].
+ ********************************************************************/
+
+int  _MaxPlanarSubgraph_EmbeddingInitialize(graphP theGraph)
+{
+    MaxPlanarSubgraphContext *context = NULL;
+    int v, parent;
+
+    gp_FindExtension(theGraph, MAXPLANARSUBGRAPH_ID, (void *)&context);
+    if (context == NULL)
+        return NOTOK;
+
+    if (context->functions.fpEmbeddingInitialize(theGraph) != OK)
+        return NOTOK;
+
+    if (theGraph->embedFlags == EMBEDFLAGS_MAXIMALPLANARSUBGRAPH)
+    {
+        context->numDeletedEdges = 0;
+
+        for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
+            context->lastDescendant[v] = v;
+
+        for (v = gp_GetLastVertex(theGraph); gp_VertexInRangeDescending(theGraph, v); v--)
+        {
+            parent = gp_GetVertexParent(theGraph, v);
+            if (gp_IsVertex(parent) && context->lastDescendant[parent] < context->lastDescendant[v])
+                context->lastDescendant[parent] = context->lastDescendant[v];
+        }
+    }
+
+    return OK;
+}
+
+/********************************************************************
+ _MaxPlanarSubgraph_HandleBlockedBicomp()
+ Returns OK to proceed with the Walkdown, since the edges that were
+             blocked have been deleted
+         NOTOK on internal error
+ ********************************************************************/
+
+int  _MaxPlanarSubgraph_HandleBlockedBicomp(graphP theGraph, int v, int RootVertex, int R)
+{
+	MaxPlanarSubgraphContext *context = NULL;
+
+	gp_FindExtension(theGraph, MAXPLANARSUBGRAPH_ID, (void *)&context);
+	if (context == NULL)
+		return NOTOK;
+
+    if (theGraph->embedFlags == EMBEDFLAGS_MAXIMALPLANARSUBGRAPH)
+    {
+    	return _DeleteBlockedEdges(theGraph, context, v, RootVertex, R);
+    }
+    else
+    {
+    	return context->functions.fpHandleBlockedBicomp(theGraph, v, RootVertex, R);
+    }
+
+    return NOTOK;
+}
+
+/********************************************************************
+ ********************************************************************/
+
+int  _MaxPlanarSubgraph_EmbedPostprocess(graphP theGraph, int v, int edgeEmbeddingResult)
+{
+     MaxPlanarSubgraphContext *context = NULL;
+     int RetVal;
+
+     gp_FindExtension(theGraph, MAXPLANARSUBGRAPH_ID, (void *)&context);
+
+     if (context == NULL)
+         return NOTOK;
+
+     // The superclass finishes the planar embedding of the edges that
+     // were not deleted
+     RetVal = context->functions.fpEmbedPostprocess(theGraph, v, edgeEmbeddingResult);
+
+     // If edges were deleted, then those that can be restored without
+     // breaking planarity are restored to make the subgraph maximal
+     if (theGraph->embedFlags == EMBEDFLAGS_MAXIMALPLANARSUBGRAPH &&
+         RetVal == OK && context->numDeletedEdges > 0)
+     {
+         RetVal = _RestoreDeletedEdges(theGraph, context);
+     }
+
+     return RetVal;
+}
+
+/********************************************************************
+ ********************************************************************/
+
+int  _MaxPlanarSubgraph_CheckObstructionIntegrity(graphP theGraph, graphP origGraph)
+{
+     MaxPlanarSubgraphContext *context = NULL;
+     gp_FindExtension(theGraph, MAXPLANARSUBGRAPH_ID, (void *)&context);
+
+     if (context == NULL)
+         return NOTOK;
+
+     // When computing a maximal planar subgraph, we ensure that theGraph
+     // is a planar embedding of a subgraph of the original graph, that the
+     // deleted edges account for the rest of the original graph, and that
+     // none of the deleted edges can be restored without breaking planarity
+     if (theGraph->embedFlags == EMBEDFLAGS_MAXIMALPLANARSUBGRAPH)
+     {
+         return _CheckMaxPlanarSubgraphIntegrity(theGraph, context, origGraph);
+     }
+
+     // Otherwise, we let the superclass do the work
+     return context->functions.fpCheckObstructionIntegrity(theGraph, origGraph);
+}
+
+/********************************************************************
+ _MaxPlanarSubgraph_SortVertices()
+
+ The endpoints of the deleted edges are relabeled so that they remain
+ in the same vertex numbering as theGraph.
+ ********************************************************************/
+
+int  _MaxPlanarSubgraph_SortVertices(graphP theGraph)
+{
+    MaxPlanarSubgraphContext *context = NULL;
+    gp_FindExtension(theGraph, MAXPLANARSUBGRAPH_ID, (void *)&context);
+
+    if (context != NULL)
+    {
+        int i;
+
+        for (i = 0; i < 2*context->numDeletedEdges; i++)
+            context->deletedEdges[i] = gp_GetVertexIndex(theGraph, context->deletedEdges[i]);
+
+        return context->functions.fpSortVertices(theGraph);
+    }
+
+    return NOTOK;
+}
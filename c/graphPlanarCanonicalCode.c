@@ -0,0 +1,2023 @@
+/*
+Planarity-Related Graph Algorithms Project
+Copyright (c) 1997-2012, John M. Boyer
+All rights reserved. Includes a reference implementation of the following:
+
+* John M. Boyer. "Subgraph Homeomorphism via the Edge Addition Planarity Algorithm".
+  Journal of Graph Algorithms and Applications, Vol. 16, no. 2, pp. 381-410, 2012.
+  http://www.jgaa.info/16/268.html
+
+* John M. Boyer. "A New Method for Efficiently Generating Planar Graph
+  Visibility Representations". In P. Eades and P. Healy, editors,
+  Proceedings of the 13th International Conference on Graph Drawing 2005,
+  Lecture Notes Comput. Sci., Volume 3843, pp. 508-511, Springer-Verlag, 2006.
+
+* John M. Boyer and Wendy J. Myrvold. "On the Cutting Edge: Simplified O(n)
+  Planarity by Edge Addition". Journal of Graph Algorithms and Applications,
+  Vol. 8, No. 3, pp. 241-273, 2004.
+  http://www.jgaa.info/08/91.html
+
+* John M. Boyer. "Simplified O(n) Algorithms for Planar Graph Embedding,
+  Kuratowski Subgraph Isolation, and Related Problems". Ph.D. Dissertation,
+  University of Victoria, 2001.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+  list of conditions and the following disclaimer in the documentation and/or
+  other materials provided with the distribution.
+
+* Neither the name of the Planarity-Related Graph Algorithms Project nor the names
+  of its contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "graph.h"
+#include "graphSPQRTree.h"
+
+/* Private definitions */
+
+// The first token of the code of each kind of part of the graph.  A part
+// is a vertex with what hangs from it, a block, an SPQR tree node seen
+// from one orientation of its parent virtual edge, the center of an SPQR
+// tree, or the whole graph.
+#define CC_HANG         1
+#define CC_BRIDGE       2
+#define CC_SNODE        3
+#define CC_PNODE        4
+#define CC_RNODE        5
+#define CC_SROOT        6
+#define CC_PROOT        7
+#define CC_RROOT        8
+#define CC_EROOT        9
+#define CC_GRAPH        10
+
+// Vertex colors and edge labels that precede the ranks of the parts.  A
+// plain vertex has nothing hanging from it, and a plain edge is an edge of
+// the graph.  The parent color marks the vertex at which a block hangs from
+// its parent and the label of the virtual edge leading to a node's parent.
+#define CC_PLAIN        0
+#define CC_PARENT       1
+#define CC_FIRSTRANK    2
+
+// The most automorphisms kept to prune the search for the canonical walk
+#define CC_MAXGENERATORS    32
+
+#define CC_ROTL(x, r) ((((x) << (r)) | ((x) >> (32 - (r)))) & 0xffffffffu)
+
+/* Private types */
+
+/********************************************************************
+ Working storage of gp_PlanarCanonicalCode()
+
+ The graph is decomposed into connected components, each component
+ into blocks arranged in its block-cut tree, and each block with two or
+ more edges into the nodes of its SPQR tree.  Each tree is rooted at its
+ center, and each part of the decomposition becomes an object whose
+ code is a sequence of tokens that refer to the parts below it by rank.
+
+        theGraph: a copy of the input graph without its self-loops
+        loops, hangObj, parentBlock: for each vertex, the number of
+                self-loops, the object for what hangs from the vertex or
+                -1 if it is plain, and the block above the vertex in the
+                block-cut tree or -1 if there is none
+        vertBlockStart, vertBlocks: the blocks containing each vertex
+        blockVertStart, blockVerts: the vertices of each block
+        blockTree, blockArc, blockRoot, blockObj: for each block, its
+                SPQR tree or -1 for a bridge, the arc of a bridge, the
+                vertex at which the block hangs from its parent or NIL,
+                and the object at the root of the block
+        nodeType, nodeFirst, skelU, skelV, skelEdge, skelAdj: copies of
+                the SPQR tree nodes and their skeleton edges
+        nodeBlock, nodeParent, nodeParentEdge, nodeObj: the block of each
+                node, its parent node and the skeleton edge leading to it,
+                or -1, and its first object
+        rStart, dartTail, dartNext, dartPrev, dartEdge: the planar
+                embedding of the skeleton of each R-node, whose darts are
+                numbered from rStart of the node, giving the vertex each
+                dart leaves, the next and previous darts around that
+                vertex, and the skeleton edge of the dart
+        objKind, objX, objY, objHeight: the kind of each object, the
+                vertex, block or node it is for, its orientation or the
+                second node of a center edge, and its height in the
+                decomposition
+        objSeqStart, objSeqLen, seqPool: the code of each object
+        objRank, rankObj: the rank of each object, which orders the
+                codes of all objects by height and then lexicographically,
+                and an object with each rank
+*/
+
+typedef struct
+{
+    graphP theGraph;
+    int N;
+    int *loops, *hangObj, *parentBlock;
+    int *vertBlockStart, *vertBlocks;
+
+    int numBlocks, numTrees;
+    int *blockTree, *blockArc, *blockRoot, *blockObj;
+    int *blockVertStart, *blockVerts;
+
+    int numNodes, numSkel;
+    int *nodeType, *nodeFirst, *skelU, *skelV, *skelEdge, *skelAdj;
+    int *nodeBlock, *nodeParent, *nodeParentEdge, *nodeObj;
+
+    int numDarts, maxDarts;
+    int *rStart, *dartTail, *dartNext, *dartPrev, *dartEdge;
+
+    int numObjects, objCapacity, numComponents, maxSeqLen;
+    int *objKind, *objX, *objY, *objHeight, *objSeqStart, *objSeqLen;
+    int seqPoolSize, *seqPool;
+    int numRanks, *objRank, *rankObj;
+    int *compObj;
+
+    // Scratch storage: breadth first search over the block-cut tree and
+    // the SPQR trees, local vertex numbers and S-node cycles, and the
+    // walks of the R-node skeletons
+    int stamp, *bctStamp, *bctParent, *bctDist, *bctQueue;
+    int *nodeStamp, *nodeBFSParent, *nodeDist, *nodeQueue;
+    int *vertexLocal, *vertexEdge1, *vertexEdge2;
+    int *walkNum, *walkOrder1, *walkOrder2, *walkTokens1, *walkTokens2;
+    int *dartLabel, *dartColor, *candidate;
+} canonicalCodeWorkspace;
+
+/* Private functions */
+
+int  _CC_InitWorkspace(canonicalCodeWorkspace *ws, graphP theGraph);
+void _CC_FreeWorkspace(canonicalCodeWorkspace *ws);
+int  _CC_FindBlocks(canonicalCodeWorkspace *ws);
+void _CC_AddIncidence(canonicalCodeWorkspace *ws, int pass, int v, int b);
+int  _CC_CreateObjects(canonicalCodeWorkspace *ws);
+int  _CC_CreateComponentObjects(canonicalCodeWorkspace *ws, int startBlock);
+int  _CC_CreateBlockObjects(canonicalCodeWorkspace *ws, int b);
+int  _CC_BCTSearch(canonicalCodeWorkspace *ws, int start);
+int  _CC_NodeSearch(canonicalCodeWorkspace *ws, int start, int start2);
+int  _CC_NewObject(canonicalCodeWorkspace *ws, int kind, int x, int y, int height, int seqBound);
+int  _CC_EmbedRNode(canonicalCodeWorkspace *ws, int i);
+int  _CC_VertexHeight(canonicalCodeWorkspace *ws, int b, int v);
+int  _CC_Color(canonicalCodeWorkspace *ws, int b, int v);
+int  _CC_Label(canonicalCodeWorkspace *ws, int i, int k, int x);
+
+int  _CC_RankObjects(canonicalCodeWorkspace *ws);
+int  _CC_ComputeSequence(canonicalCodeWorkspace *ws, int o);
+int  _CC_HangSequence(canonicalCodeWorkspace *ws, int v, int *seq);
+int  _CC_SNodeSequence(canonicalCodeWorkspace *ws, int i, int s, int *seq);
+int  _CC_PNodeSequence(canonicalCodeWorkspace *ws, int i, int kind, int s, int *seq);
+int  _CC_SRootSequence(canonicalCodeWorkspace *ws, int i, int *seq);
+int  _CC_RNodeSequence(canonicalCodeWorkspace *ws, int i, int s, int *seq);
+int  _CC_RRootSequence(canonicalCodeWorkspace *ws, int i, int *seq);
+void _CC_PrepareDarts(canonicalCodeWorkspace *ws, int i);
+int  _CC_Walk(canonicalCodeWorkspace *ws, int i, int start, int mirror, int *tokens, int *best, int *order);
+int  _CC_LeastRotation(int *pairs, int k);
+int  _CC_CompareRotations(int *pairs1, int start1, int *pairs2, int start2, int k);
+int  _CC_RRootOrbit(int D, int start, int **gens, int *flips, int numGens, unsigned char *covered, int *orbit);
+int  _CC_CompareSequences(canonicalCodeWorkspace *ws, int o1, int o2);
+void _CC_SortObjects(canonicalCodeWorkspace *ws, int *items, int n, int *temp);
+int  _CC_CompareInts(const void *p1, const void *p2);
+int  _CC_CompareUnsigned(const void *p1, const void *p2);
+unsigned int _CC_Mix(unsigned int h, unsigned int x);
+
+int  _CC_WriteCode(canonicalCodeWorkspace *ws, planarCanonicalCodeP theCode);
+void _CC_Hash128(unsigned char *data, int length, unsigned char *hash);
+
+/********************************************************************
+ gp_NewCanonicalCode()
+
+ Returns a new, empty canonical code structure, or NULL on allocation
+ failure
+ ********************************************************************/
+
+planarCanonicalCodeP gp_NewCanonicalCode(void)
+{
+     planarCanonicalCodeP theCode = (planarCanonicalCodeP) malloc(sizeof(planarCanonicalCode));
+
+     if (theCode != NULL)
+     {
+         theCode->code = NULL;
+         theCode->codeLength = theCode->codeCapacity = 0;
+         memset(theCode->hash, 0, sizeof(theCode->hash));
+     }
+
+     return theCode;
+}
+
+/********************************************************************
+ gp_FreeCanonicalCode()
+
+ Frees the canonical code structure and sets the pointer to it to NULL
+ ********************************************************************/
+
+void gp_FreeCanonicalCode(planarCanonicalCodeP *pCode)
+{
+     if (pCode == NULL || *pCode == NULL)
+         return;
+
+     if ((*pCode)->code != NULL)
+         free((*pCode)->code);
+
+     free(*pCode);
+     *pCode = NULL;
+}
+
+/********************************************************************
+ gp_PlanarCanonicalCode()
+
+ Obtains a canonical code for the planar graph theGraph, so that two
+ planar graphs are isomorphic if and only if their codes are equal.
+ Self-loops and multiple edges are allowed.  theGraph is not modified.
+
+ The code is built from the decomposition of the graph into connected
+ components, blocks and triconnected components.  The block-cut tree of
+ each component and the SPQR tree of each block are rooted at their
+ centers, and each part of the decomposition, such as a vertex with the
+ blocks hanging from it or an SPQR tree node seen from its parent, gets
+ a code in which the parts below it appear by rank.  The parts are coded
+ in order of height, and the codes of each height are sorted to give the
+ ranks, so the ranks order the parts in the same way in any graph.
+
+ The skeleton of an R-node is triconnected, so its planar embedding is
+ unique up to mirror image, and its code is the least of the walks of
+ that embedding from its parent virtual edge in either orientation.  At
+ the center of an SPQR tree, the walk starts from every dart, except that
+ the candidate darts are limited to those with the rarest invariant, and
+ the automorphisms found when two walks agree prune the others.  The
+ codes of S-nodes and of centers that are S-nodes are their cycles read
+ in the given direction or from their least rotation, and the codes of
+ P-nodes are the sorted codes of their parallel edges.
+
+ The result is the table of the distinct codes in rank order, with the
+ tokens of each written as variable length integers, followed by a
+ 128-bit hash of the table (MurmurHash3 x86_128 with seed 0).  The code
+ of the whole graph is last.  The time and space are linear in the size
+ of the graph, apart from the sorting of the codes and the walks at the
+ centers of the SPQR trees, which are near-linear unless the skeleton
+ of a center is highly symmetric.
+
+ Returns OK on success, NONEMBEDDABLE if theGraph is not planar,
+         NOTOK on allocation failure or invalid input
+ ********************************************************************/
+
+int  gp_PlanarCanonicalCode(graphP theGraph, planarCanonicalCodeP theCode)
+{
+     canonicalCodeWorkspace ws;
+     int Result;
+
+     if (theGraph == NULL || theCode == NULL || theGraph->N == 0)
+         return NOTOK;
+
+     Result = _CC_InitWorkspace(&ws, theGraph);
+
+     if (Result == OK)
+         Result = _CC_FindBlocks(&ws);
+
+     if (Result == OK)
+         Result = _CC_CreateObjects(&ws);
+
+     if (Result == OK)
+         Result = _CC_RankObjects(&ws);
+
+     if (Result == OK)
+         Result = _CC_WriteCode(&ws, theCode);
+
+     _CC_FreeWorkspace(&ws);
+     return Result;
+}
+
+/********************************************************************
+ gp_PlanarIsomorphic()
+
+ Decides whether the planar graphs theGraph1 and theGraph2 are isomorphic
+ by comparing their canonical codes.  *pIsomorphic receives TRUE or FALSE.
+ Neither graph is modified.
+
+ Returns OK on success, NONEMBEDDABLE if either graph is not planar,
+         NOTOK on allocation failure or invalid input
+ ********************************************************************/
+
+int  gp_PlanarIsomorphic(graphP theGraph1, graphP theGraph2, int *pIsomorphic)
+{
+     planarCanonicalCodeP code1 = NULL, code2 = NULL;
+     int Result = OK;
+
+     if (theGraph1 == NULL || theGraph2 == NULL || pIsomorphic == NULL)
+         return NOTOK;
+
+     *pIsomorphic = FALSE;
+
+     // Graphs of different orders or sizes need no code
+     if (theGraph1->N != theGraph2->N || theGraph1->M != theGraph2->M)
+         return OK;
+
+     if ((code1 = gp_NewCanonicalCode()) == NULL ||
+         (code2 = gp_NewCanonicalCode()) == NULL)
+         Result = NOTOK;
+
+     if (Result == OK)
+         Result = gp_PlanarCanonicalCode(theGraph1, code1);
+
+     if (Result == OK)
+         Result = gp_PlanarCanonicalCode(theGraph2, code2);
+
+     if (Result == OK && code1->codeLength == code2->codeLength &&
+         memcmp(code1->code, code2->code, code1->codeLength) == 0)
+         *pIsomorphic = TRUE;
+
+     gp_FreeCanonicalCode(&code1);
+     gp_FreeCanonicalCode(&code2);
+     return Result;
+}
+
+/********************************************************************
+ _CC_InitWorkspace()
+
+ Copies the edges of theGraph other than self-loops into a new graph,
+ counting the self-loops of each vertex, then obtains the SPQR trees of
+ the copy and makes a copy of their nodes and skeletons.
+
+ Returns OK on success, NOTOK on failure
+ ********************************************************************/
+
+int  _CC_InitWorkspace(canonicalCodeWorkspace *ws, graphP theGraph)
+{
+     int N = theGraph->N, e, u, v, i, j, k, numTrees, first, count, EsizeOccupied;
+     int Result = OK;
+
+     memset(ws, 0, sizeof(canonicalCodeWorkspace));
+     ws->N = N;
+
+     if ((ws->theGraph = gp_New()) == NULL ||
+         (theGraph->M > 0 && gp_EnsureArcCapacity(ws->theGraph, 2*theGraph->M) != OK) ||
+         gp_InitGraph(ws->theGraph, N) != OK ||
+         (ws->loops = (int *) calloc(N+1, sizeof(int))) == NULL)
+         return NOTOK;
+
+     EsizeOccupied = gp_EdgeInUseIndexBound(theGraph);
+     for (e = gp_GetFirstEdge(theGraph); e < EsizeOccupied && Result == OK; e += 2)
+     {
+         if (!gp_EdgeInUse(theGraph, e))
+             continue;
+
+         u = gp_GetNeighbor(theGraph, gp_GetTwinArc(theGraph, e));
+         v = gp_GetNeighbor(theGraph, e);
+         if (u < gp_GetFirstVertex(theGraph) || !gp_VertexInRange(theGraph, u) ||
+             v < gp_GetFirstVertex(theGraph) || !gp_VertexInRange(theGraph, v))
+             Result = NOTOK;
+         else if (u == v)
+             ws->loops[u]++;
+         else if (gp_AddEdge(ws->theGraph, u, 0, v, 0) != OK)
+             Result = NOTOK;
+     }
+
+     if (Result == OK && gp_SPQRTree(ws->theGraph) != OK)
+         Result = NOTOK;
+
+     if (Result != OK)
+         return Result;
+
+     // Copy the SPQR tree nodes and their skeletons
+     numTrees = ws->numTrees = gp_SPQRTree_GetNumTrees(ws->theGraph);
+     ws->numNodes = gp_SPQRTree_GetNumNodes(ws->theGraph);
+     for (i = 0; i < ws->numNodes; i++)
+          ws->numSkel += gp_SPQRTree_GetNumSkeletonEdges(ws->theGraph, i);
+
+     if ((ws->nodeType = (int *) malloc((ws->numNodes+1) * sizeof(int))) == NULL ||
+         (ws->nodeFirst = (int *) malloc((ws->numNodes+1) * sizeof(int))) == NULL ||
+         (ws->nodeBlock = (int *) malloc((ws->numNodes+1) * sizeof(int))) == NULL ||
+         (ws->skelU = (int *) malloc((ws->numSkel+1) * sizeof(int))) == NULL ||
+         (ws->skelV = (int *) malloc((ws->numSkel+1) * sizeof(int))) == NULL ||
+         (ws->skelEdge = (int *) malloc((ws->numSkel+1) * sizeof(int))) == NULL ||
+         (ws->skelAdj = (int *) malloc((ws->numSkel+1) * sizeof(int))) == NULL)
+         return NOTOK;
+
+     for (i = k = 0; i < ws->numNodes; i++)
+     {
+          ws->nodeType[i] = gp_SPQRTree_GetNodeType(ws->theGraph, i);
+          ws->nodeFirst[i] = k;
+          for (j = 0; j < gp_SPQRTree_GetNumSkeletonEdges(ws->theGraph, i); j++, k++)
+               gp_SPQRTree_GetSkeletonEdge(ws->theGraph, i, j, ws->skelU+k, ws->skelV+k,
+                                           ws->skelEdge+k, ws->skelAdj+k);
+     }
+     ws->nodeFirst[ws->numNodes] = k;
+
+     // The trees are the first blocks, so the block of a node is its tree
+     for (i = 0; i < numTrees; i++)
+     {
+          gp_SPQRTree_GetTreeNodes(ws->theGraph, i, &first, &count);
+          for (j = first; j < first + count; j++)
+               ws->nodeBlock[j] = i;
+     }
+
+     return OK;
+}
+
+/********************************************************************
+ _CC_FreeWorkspace()
+ ********************************************************************/
+
+void _CC_FreeWorkspace(canonicalCodeWorkspace *ws)
+{
+     int **arrays[] = {
+         &ws->loops, &ws->hangObj, &ws->parentBlock, &ws->vertBlockStart, &ws->vertBlocks,
+         &ws->blockTree, &ws->blockArc, &ws->blockRoot, &ws->blockObj, &ws->blockVertStart, &ws->blockVerts,
+         &ws->nodeType, &ws->nodeFirst, &ws->skelU, &ws->skelV, &ws->skelEdge, &ws->skelAdj,
+         &ws->nodeBlock, &ws->nodeParent, &ws->nodeParentEdge, &ws->nodeObj,
+         &ws->rStart, &ws->dartTail, &ws->dartNext, &ws->dartPrev, &ws->dartEdge,
+         &ws->objKind, &ws->objX, &ws->objY, &ws->objHeight, &ws->objSeqStart, &ws->objSeqLen,
+         &ws->seqPool, &ws->objRank, &ws->rankObj, &ws->compObj,
+         &ws->bctStamp, &ws->bctParent, &ws->bctDist, &ws->bctQueue,
+         &ws->nodeStamp, &ws->nodeBFSParent, &ws->nodeDist, &ws->nodeQueue,
+         &ws->vertexLocal, &ws->vertexEdge1, &ws->vertexEdge2,
+         &ws->walkNum, &ws->walkOrder1, &ws->walkOrder2, &ws->walkTokens1, &ws->walkTokens2,
+         &ws->dartLabel, &ws->dartColor, &ws->candidate
+     };
+     int i;
+
+     for (i = 0; i < (int) (sizeof(arrays) / sizeof(arrays[0])); i++)
+     {
+          if (*arrays[i] != NULL)
+              free(*arrays[i]);
+          *arrays[i] = NULL;
+     }
+
+     gp_Free(&ws->theGraph);
+}
+
+/********************************************************************
+ _CC_FindBlocks()
+
+ The blocks with two or more edges are the SPQR trees, and the other
+ edges that are not self-loops are bridges, each a block of its own.
+ Gives the blocks containing each vertex and the vertices of each
+ block, which are the adjacency lists of the block-cut tree.
+
+ Returns OK on success, NOTOK on allocation failure
+ ********************************************************************/
+
+int  _CC_FindBlocks(canonicalCodeWorkspace *ws)
+{
+     graphP W = ws->theGraph;
+     int N = ws->N, numEdges = W->M, e, b, i, k, v, total, pass, end;
+     int *edgeInTree = NULL, *blockStamp = NULL, Result = OK;
+
+     if ((edgeInTree = (int *) calloc(numEdges+1, sizeof(int))) == NULL ||
+         (blockStamp = (int *) malloc((N+1) * sizeof(int))) == NULL)
+         Result = NOTOK;
+
+     // The edges of W have no holes, so edge k has arcs first+2k and its twin
+     if (Result == OK)
+     {
+         for (k = 0; k < ws->numSkel; k++)
+              if (gp_IsArc(ws->skelEdge[k]))
+                  edgeInTree[(ws->skelEdge[k] - gp_GetFirstEdge(W)) >> 1] = 1;
+
+         ws->numBlocks = ws->numTrees;
+         for (k = 0; k < numEdges; k++)
+              if (!edgeInTree[k])
+                  ws->numBlocks++;
+
+         if ((ws->blockTree = (int *) malloc((ws->numBlocks+1) * sizeof(int))) == NULL ||
+             (ws->blockArc = (int *) malloc((ws->numBlocks+1) * sizeof(int))) == NULL ||
+             (ws->blockRoot = (int *) malloc((ws->numBlocks+1) * sizeof(int))) == NULL ||
+             (ws->blockObj = (int *) malloc((ws->numBlocks+1) * sizeof(int))) == NULL ||
+             (ws->vertBlockStart = (int *) calloc(N+2, sizeof(int))) == NULL ||
+             (ws->blockVertStart = (int *) calloc(ws->numBlocks+2, sizeof(int))) == NULL)
+             Result = NOTOK;
+     }
+
+     if (Result == OK)
+     {
+         for (b = 0; b < ws->numTrees; b++)
+         {
+              ws->blockTree[b] = b;
+              ws->blockArc[b] = NIL;
+         }
+         for (k = 0; k < numEdges; k++)
+         {
+              if (!edgeInTree[k])
+              {
+                  ws->blockTree[b] = -1;
+                  ws->blockArc[b++] = gp_GetFirstEdge(W) + 2*k;
+              }
+         }
+
+         // Count, then list, the blocks of each vertex.  A vertex is
+         // stamped with its block so that it is recorded once per block.
+         for (pass = 0; pass < 2 && Result == OK; pass++)
+         {
+              for (v = 0; v <= N; v++)
+                   blockStamp[v] = -1;
+
+              for (i = 0; i < ws->numNodes; i++)
+              {
+                   b = ws->nodeBlock[i];
+                   for (k = ws->nodeFirst[i]; k < ws->nodeFirst[i+1]; k++)
+                   {
+                        for (end = 0; end < 2; end++)
+                        {
+                             v = end == 0 ? ws->skelU[k] : ws->skelV[k];
+                             if (blockStamp[v] != b)
+                             {
+                                 blockStamp[v] = b;
+                                 _CC_AddIncidence(ws, pass, v, b);
+                             }
+                        }
+                   }
+              }
+
+              for (b = ws->numTrees; b < ws->numBlocks; b++)
+              {
+                   for (end = 0; end < 2; end++)
+                   {
+                        e = ws->blockArc[b] ^ end;
+                        _CC_AddIncidence(ws, pass, gp_GetNeighbor(W, e), b);
+                   }
+              }
+
+              if (pass == 0)
+              {
+                  for (v = 0; v <= N; v++)
+                       ws->vertBlockStart[v+1] += ws->vertBlockStart[v];
+                  for (b = 0; b < ws->numBlocks; b++)
+                       ws->blockVertStart[b+1] += ws->blockVertStart[b];
+                  total = ws->vertBlockStart[N+1];
+                  if ((ws->vertBlocks = (int *) malloc((total+1) * sizeof(int))) == NULL ||
+                      (ws->blockVerts = (int *) malloc((total+1) * sizeof(int))) == NULL)
+                      Result = NOTOK;
+              }
+              else
+              {
+                  // The filling advanced each start to the next one
+                  for (v = N+1; v > 0; v--)
+                       ws->vertBlockStart[v] = ws->vertBlockStart[v-1];
+                  ws->vertBlockStart[0] = 0;
+                  for (b = ws->numBlocks; b > 0; b--)
+                       ws->blockVertStart[b] = ws->blockVertStart[b-1];
+                  ws->blockVertStart[0] = 0;
+              }
+         }
+     }
+
+     if (edgeInTree != NULL)
+         free(edgeInTree);
+     if (blockStamp != NULL)
+         free(blockStamp);
+     return Result;
+}
+
+/********************************************************************
+ _CC_AddIncidence()
+
+ Records that vertex v is in block b.  The first pass counts the
+ incidences of each vertex and of each block, and the second pass
+ fills them in, advancing the start of each list as it goes.
+ ********************************************************************/
+
+void _CC_AddIncidence(canonicalCodeWorkspace *ws, int pass, int v, int b)
+{
+     if (pass == 0)
+     {
+         ws->vertBlockStart[v+1]++;
+         ws->blockVertStart[b+1]++;
+     }
+     else
+     {
+         ws->vertBlocks[ws->vertBlockStart[v]++] = b;
+         ws->blockVerts[ws->blockVertStart[b]++] = v;
+     }
+}
+
+/********************************************************************
+ _CC_CreateObjects()
+
+ Roots the block-cut tree of each connected component at its center and
+ creates the objects for the parts of the graph from the bottom up, so
+ that the height of each object follows from those of the parts below
+ it.  No code is computed yet, since a code refers to the parts below it
+ by rank, and the ranks are only known once all of the codes of lower
+ height have been sorted.
+
+ Returns OK on success, NONEMBEDDABLE if the skeleton of an R-node is
+         not planar, NOTOK on allocation failure
+ ********************************************************************/
+
+int  _CC_CreateObjects(canonicalCodeWorkspace *ws)
+{
+     int N = ws->N, numBCT = ws->numBlocks + N + 1, numRDarts = 0, v, i, m, h;
+     int Result = OK;
+
+     ws->objCapacity = N + ws->numBlocks + 2*ws->numNodes + ws->numTrees + 1;
+     for (i = 0; i < ws->numNodes; i++)
+     {
+          m = ws->nodeFirst[i+1] - ws->nodeFirst[i];
+          if (ws->nodeType[i] == SPQRTREE_RNODE)
+              numRDarts += 2*m;
+          if (ws->maxDarts < 2*m)
+              ws->maxDarts = 2*m;
+     }
+
+     if ((ws->objKind = (int *) malloc(ws->objCapacity * sizeof(int))) == NULL ||
+         (ws->objX = (int *) malloc(ws->objCapacity * sizeof(int))) == NULL ||
+         (ws->objY = (int *) malloc(ws->objCapacity * sizeof(int))) == NULL ||
+         (ws->objHeight = (int *) malloc(ws->objCapacity * sizeof(int))) == NULL ||
+         (ws->objSeqStart = (int *) malloc(ws->objCapacity * sizeof(int))) == NULL ||
+         (ws->objSeqLen = (int *) malloc(ws->objCapacity * sizeof(int))) == NULL ||
+         (ws->hangObj = (int *) malloc((N+1) * sizeof(int))) == NULL ||
+         (ws->parentBlock = (int *) malloc((N+1) * sizeof(int))) == NULL ||
+         (ws->compObj = (int *) malloc((N+1) * sizeof(int))) == NULL ||
+         (ws->vertexLocal = (int *) malloc((N+1) * sizeof(int))) == NULL ||
+         (ws->vertexEdge1 = (int *) malloc((N+1) * sizeof(int))) == NULL ||
+         (ws->vertexEdge2 = (int *) malloc((N+1) * sizeof(int))) == NULL ||
+         (ws->nodeParent = (int *) malloc((ws->numNodes+1) * sizeof(int))) == NULL ||
+         (ws->nodeParentEdge = (int *) malloc((ws->numNodes+1) * sizeof(int))) == NULL ||
+         (ws->nodeObj = (int *) malloc((ws->numNodes+1) * sizeof(int))) == NULL ||
+         (ws->nodeStamp = (int *) calloc(ws->numNodes+1, sizeof(int))) == NULL ||
+         (ws->nodeBFSParent = (int *) malloc((ws->numNodes+1) * sizeof(int))) == NULL ||
+         (ws->nodeDist = (int *) malloc((ws->numNodes+1) * sizeof(int))) == NULL ||
+         (ws->nodeQueue = (int *) malloc((ws->numNodes+1) * sizeof(int))) == NULL ||
+         (ws->rStart = (int *) malloc((ws->numNodes+1) * sizeof(int))) == NULL ||
+         (ws->dartTail = (int *) malloc((numRDarts+1) * sizeof(int))) == NULL ||
+         (ws->dartNext = (int *) malloc((numRDarts+1) * sizeof(int))) == NULL ||
+         (ws->dartPrev = (int *) malloc((numRDarts+1) * sizeof(int))) == NULL ||
+         (ws->dartEdge = (int *) malloc((numRDarts+1) * sizeof(int))) == NULL ||
+         (ws->bctStamp = (int *) calloc(numBCT, sizeof(int))) == NULL ||
+         (ws->bctParent = (int *) malloc(numBCT * sizeof(int))) == NULL ||
+         (ws->bctDist = (int *) malloc(numBCT * sizeof(int))) == NULL ||
+         (ws->bctQueue = (int *) malloc(numBCT * sizeof(int))) == NULL)
+         return NOTOK;
+
+     for (v = 0; v <= N; v++)
+     {
+          ws->hangObj[v] = ws->parentBlock[v] = -1;
+          ws->vertexLocal[v] = ws->vertexEdge1[v] = ws->vertexEdge2[v] = -1;
+     }
+
+     // A vertex in at most one block has nothing hanging from it but its
+     // self-loops, so it only needs an object if it has self-loops or if
+     // it is a connected component by itself
+     for (v = gp_GetFirstVertex(ws->theGraph); v <= N; v++)
+     {
+          m = ws->vertBlockStart[v+1] - ws->vertBlockStart[v];
+          if (m == 0 || (m == 1 && ws->loops[v] > 0))
+              ws->hangObj[v] = _CC_NewObject(ws, CC_HANG, v, 0, 0, 2);
+     }
+
+     for (v = gp_GetFirstVertex(ws->theGraph); v <= N && Result == OK; v++)
+     {
+          if (ws->vertBlockStart[v+1] == ws->vertBlockStart[v])
+              ws->compObj[ws->numComponents++] = ws->hangObj[v];
+          else if (ws->bctStamp[ws->vertBlocks[ws->vertBlockStart[v]]] == 0)
+              Result = _CC_CreateComponentObjects(ws, ws->vertBlocks[ws->vertBlockStart[v]]);
+     }
+
+     if (Result == OK)
+     {
+         for (i = 0, h = -1; i < ws->numComponents; i++)
+              if (h < ws->objHeight[ws->compObj[i]])
+                  h = ws->objHeight[ws->compObj[i]];
+
+         _CC_NewObject(ws, CC_GRAPH, 0, 0, h+1, 1 + ws->numComponents);
+     }
+
+     return Result;
+}
+
+/********************************************************************
+ _CC_CreateComponentObjects()
+
+ The block-cut tree of a connected component has blocks as its leaves,
+ so its longest paths have even length and its center is one node, a
+ block or a cut vertex.  The center is found by two breadth first
+ searches, and a third one from the center roots the tree, after which
+ the objects are created in the reverse of the search order.  The object
+ of the center is the object of the component.
+
+ Returns OK on success, NONEMBEDDABLE if the skeleton of an R-node is
+         not planar, NOTOK on allocation failure
+ ********************************************************************/
+
+int  _CC_CreateComponentObjects(canonicalCodeWorkspace *ws, int startBlock)
+{
+     int B = ws->numBlocks, center, count, q, k, z, b, v, h, Result = OK;
+
+     count = _CC_BCTSearch(ws, startBlock);
+     count = _CC_BCTSearch(ws, ws->bctQueue[count-1]);
+     center = ws->bctQueue[count-1];
+     for (k = ws->bctDist[center] / 2; k > 0; k--)
+          center = ws->bctParent[center];
+     count = _CC_BCTSearch(ws, center);
+
+     // Each block is the parent of its vertices other than its root
+     for (q = 0; q < count; q++)
+     {
+          if ((z = ws->bctQueue[q]) >= B)
+              continue;
+
+          ws->blockRoot[z] = ws->bctParent[z] < 0 ? NIL : ws->bctParent[z] - B;
+          for (k = ws->blockVertStart[z]; k < ws->blockVertStart[z+1]; k++)
+               if (ws->blockVerts[k] != ws->blockRoot[z])
+                   ws->parentBlock[ws->blockVerts[k]] = z;
+     }
+
+     for (q = count-1; q >= 0 && Result == OK; q--)
+     {
+          z = ws->bctQueue[q];
+          if (z < B)
+              Result = _CC_CreateBlockObjects(ws, z);
+          else
+          {
+              v = z - B;
+              for (k = ws->vertBlockStart[v], h = -1; k < ws->vertBlockStart[v+1]; k++)
+              {
+                   b = ws->vertBlocks[k];
+                   if (b != ws->parentBlock[v] && h < ws->objHeight[ws->blockObj[b]])
+                       h = ws->objHeight[ws->blockObj[b]];
+              }
+              ws->hangObj[v] = _CC_NewObject(ws, CC_HANG, v, 0, h+1,
+                                             2 + ws->vertBlockStart[v+1] - ws->vertBlockStart[v]);
+          }
+     }
+
+     if (Result == OK)
+         ws->compObj[ws->numComponents++] = center < B ? ws->blockObj[center] : ws->hangObj[center - B];
+
+     return Result;
+}
+
+/********************************************************************
+ _CC_BCTSearch()
+
+ Breadth first search of the block-cut tree from the given node, which
+ is a block b numbered b or a cut vertex v numbered numBlocks+v.  Gives
+ the search order in bctQueue and the parent and distance of each node
+ reached, and returns the number of nodes reached.
+ ********************************************************************/
+
+int  _CC_BCTSearch(canonicalCodeWorkspace *ws, int start)
+{
+     int B = ws->numBlocks, head = 0, tail = 0, z, w, k, first, last, stamp = ++ws->stamp;
+
+     ws->bctQueue[tail++] = start;
+     ws->bctStamp[start] = stamp;
+     ws->bctParent[start] = -1;
+     ws->bctDist[start] = 0;
+
+     while (head < tail)
+     {
+          z = ws->bctQueue[head++];
+          if (z < B)
+          {
+              first = ws->blockVertStart[z];
+              last = ws->blockVertStart[z+1];
+          }
+          else
+          {
+              first = ws->vertBlockStart[z-B];
+              last = ws->vertBlockStart[z-B+1];
+          }
+
+          for (k = first; k < last; k++)
+          {
+               if (z < B)
+               {
+                   // Only cut vertices are in the block-cut tree
+                   w = ws->blockVerts[k];
+                   if (ws->vertBlockStart[w+1] - ws->vertBlockStart[w] < 2)
+                       continue;
+                   w += B;
+               }
+               else w = ws->vertBlocks[k];
+
+               if (ws->bctStamp[w] != stamp)
+               {
+                   ws->bctStamp[w] = stamp;
+                   ws->bctParent[w] = z;
+                   ws->bctDist[w] = ws->bctDist[z] + 1;
+                   ws->bctQueue[tail++] = w;
+               }
+          }
+     }
+
+     return tail;
+}
+
+/********************************************************************
+ _CC_NodeSearch()
+
+ Breadth first search of an SPQR tree from the given node, and also from
+ start2 unless it is -1.  Gives the search order in nodeQueue and the
+ parent and distance of each node reached, and returns the number of
+ nodes reached.
+ ********************************************************************/
+
+int  _CC_NodeSearch(canonicalCodeWorkspace *ws, int start, int start2)
+{
+     int head = 0, tail = 0, i, a, k, stamp = ++ws->stamp;
+
+     ws->nodeQueue[tail++] = start;
+     if (start2 >= 0)
+         ws->nodeQueue[tail++] = start2;
+
+     for (k = 0; k < tail; k++)
+     {
+          ws->nodeStamp[ws->nodeQueue[k]] = stamp;
+          ws->nodeBFSParent[ws->nodeQueue[k]] = -1;
+          ws->nodeDist[ws->nodeQueue[k]] = 0;
+     }
+
+     while (head < tail)
+     {
+          i = ws->nodeQueue[head++];
+          for (k = ws->nodeFirst[i]; k < ws->nodeFirst[i+1]; k++)
+          {
+               if ((a = ws->skelAdj[k]) >= 0 && ws->nodeStamp[a] != stamp)
+               {
+                   ws->nodeStamp[a] = stamp;
+                   ws->nodeBFSParent[a] = i;
+                   ws->nodeDist[a] = ws->nodeDist[i] + 1;
+                   ws->nodeQueue[tail++] = a;
+               }
+          }
+     }
+
+     return tail;
+}
+
+/********************************************************************
+ _CC_CreateBlockObjects()
+
+ A bridge gets one object.  Otherwise, the SPQR tree of the block is
+ rooted at its center, which is a node or, if the longest paths of the
+ tree have odd length, the tree edge joining two nodes.  Each node other
+ than a center node gets two objects, one for each orientation of the
+ virtual edge leading to its parent, where the nodes joined by a center
+ edge are each other's parent.  The root object of the block is that of
+ the center node or the center edge.
+
+ Returns OK on success, NONEMBEDDABLE if the skeleton of an R-node is
+         not planar, NOTOK on allocation failure
+ ********************************************************************/
+
+int  _CC_CreateBlockObjects(canonicalCodeWorkspace *ws, int b)
+{
+     graphP W = ws->theGraph;
+     int first, count, c1, c2 = -1, q, i, k, a, h, m, kind, bound, Result = OK;
+
+     if (ws->blockTree[b] < 0)
+     {
+         h = _CC_VertexHeight(ws, b, gp_GetNeighbor(W, ws->blockArc[b]));
+         k = _CC_VertexHeight(ws, b, gp_GetNeighbor(W, gp_GetTwinArc(W, ws->blockArc[b])));
+         ws->blockObj[b] = _CC_NewObject(ws, CC_BRIDGE, b, 0, (h > k ? h : k) + 1, 3);
+         return OK;
+     }
+
+     gp_SPQRTree_GetTreeNodes(W, ws->blockTree[b], &first, &count);
+
+     c1 = first;
+     if (count > 1)
+     {
+         q = _CC_NodeSearch(ws, first, -1);
+         q = _CC_NodeSearch(ws, ws->nodeQueue[q-1], -1);
+         c1 = ws->nodeQueue[q-1];
+         for (k = ws->nodeDist[c1] / 2; k > 0; k--)
+              c1 = ws->nodeBFSParent[c1];
+         if (ws->nodeDist[ws->nodeQueue[q-1]] & 1)
+             c2 = ws->nodeBFSParent[c1];
+     }
+
+     count = _CC_NodeSearch(ws, c1, c2);
+     for (q = 0; q < count; q++)
+          ws->nodeParent[ws->nodeQueue[q]] = ws->nodeBFSParent[ws->nodeQueue[q]];
+     if (c2 >= 0)
+     {
+         ws->nodeParent[c1] = c2;
+         ws->nodeParent[c2] = c1;
+     }
+
+     for (q = count-1; q >= 0 && Result == OK; q--)
+     {
+          i = ws->nodeQueue[q];
+          ws->nodeParentEdge[i] = -1;
+          for (k = ws->nodeFirst[i], h = -1; k < ws->nodeFirst[i+1]; k++)
+          {
+               if (h < _CC_VertexHeight(ws, b, ws->skelU[k]))
+                   h = _CC_VertexHeight(ws, b, ws->skelU[k]);
+               if (h < _CC_VertexHeight(ws, b, ws->skelV[k]))
+                   h = _CC_VertexHeight(ws, b, ws->skelV[k]);
+
+               if ((a = ws->skelAdj[k]) < 0)
+                   continue;
+               if (a == ws->nodeParent[i])
+                   ws->nodeParentEdge[i] = k;
+               else if (h < ws->objHeight[ws->nodeObj[a]])
+                   h = ws->objHeight[ws->nodeObj[a]];
+          }
+
+          ws->rStart[i] = -1;
+          if (ws->nodeType[i] == SPQRTREE_RNODE)
+              Result = _CC_EmbedRNode(ws, i);
+
+          m = ws->nodeFirst[i+1] - ws->nodeFirst[i];
+          switch (ws->nodeType[i])
+          {
+              case SPQRTREE_SNODE : kind = CC_SNODE; bound = 3 + 2*m; break;
+              case SPQRTREE_PNODE : kind = CC_PNODE; bound = 4 + m; break;
+              default             : kind = CC_RNODE; bound = 1 + 8*m; break;
+          }
+
+          if (ws->nodeParent[i] >= 0)
+          {
+              ws->nodeObj[i] = _CC_NewObject(ws, kind, i, 0, h+1, bound);
+              _CC_NewObject(ws, kind, i, 1, h+1, bound);
+          }
+          else
+          {
+              kind = kind == CC_SNODE ? CC_SROOT : (kind == CC_PNODE ? CC_PROOT : CC_RROOT);
+              ws->nodeObj[i] = _CC_NewObject(ws, kind, i, 0, h+1, bound);
+          }
+     }
+
+     if (Result == OK)
+     {
+         if (c2 < 0)
+             ws->blockObj[b] = ws->nodeObj[c1];
+         else
+         {
+             h = ws->objHeight[ws->nodeObj[c1]];
+             if (h < ws->objHeight[ws->nodeObj[c2]])
+                 h = ws->objHeight[ws->nodeObj[c2]];
+             ws->blockObj[b] = _CC_NewObject(ws, CC_EROOT, c1, c2, h+1, 3);
+         }
+     }
+
+     return Result;
+}
+
+/********************************************************************
+ _CC_NewObject()
+
+ Creates an object and reserves bound tokens for its code.  The
+ capacity for objects is computed in advance, so there is always room.
+
+ Returns the new object
+ ********************************************************************/
+
+int  _CC_NewObject(canonicalCodeWorkspace *ws, int kind, int x, int y, int height, int seqBound)
+{
+     int o = ws->numObjects++;
+
+     ws->objKind[o] = kind;
+     ws->objX[o] = x;
+     ws->objY[o] = y;
+     ws->objHeight[o] = height;
+     ws->objSeqStart[o] = ws->seqPoolSize;
+     ws->objSeqLen[o] = 0;
+     ws->seqPoolSize += seqBound;
+     if (ws->maxSeqLen < seqBound)
+         ws->maxSeqLen = seqBound;
+
+     return o;
+}
+
+/********************************************************************
+ _CC_EmbedRNode()
+
+ Embeds the skeleton of R-node i, which is triconnected, so that its
+ embedding is unique up to mirror image.  The skeleton is copied into a
+ graph of its own, whose edge j has the arcs first+2j and first+2j+1,
+ and after gp_Embed() and gp_SortVertices() the darts of the node are
+ read from those arcs in the same order.
+
+ Returns OK on success, NONEMBEDDABLE if the skeleton is not planar,
+         NOTOK on failure
+ ********************************************************************/
+
+int  _CC_EmbedRNode(canonicalCodeWorkspace *ws, int i)
+{
+     graphP theSkeleton = NULL;
+     int first = ws->nodeFirst[i], m = ws->nodeFirst[i+1] - first, base = ws->numDarts;
+     int n = 0, k, j, d, arc, firstArc, tail, head, Result = OK;
+
+     ws->rStart[i] = base;
+     for (k = first; k < first + m; k++)
+     {
+          if (ws->vertexLocal[ws->skelU[k]] < 0)
+              ws->vertexLocal[ws->skelU[k]] = ++n;
+          if (ws->vertexLocal[ws->skelV[k]] < 0)
+              ws->vertexLocal[ws->skelV[k]] = ++n;
+     }
+
+     // A simple planar graph has at most 3n-6 edges
+     if (m > 3*n - 6)
+         Result = NONEMBEDDABLE;
+
+     else if ((theSkeleton = gp_New()) == NULL || gp_InitGraph(theSkeleton, n) != OK)
+         Result = NOTOK;
+
+     for (k = first; k < first + m && Result == OK; k++)
+     {
+          if (gp_AddEdge(theSkeleton, ws->vertexLocal[ws->skelU[k]], 0,
+                                      ws->vertexLocal[ws->skelV[k]], 0) != OK)
+              Result = NOTOK;
+     }
+
+     if (Result == OK)
+     {
+         Result = gp_Embed(theSkeleton, EMBEDFLAGS_PLANAR);
+         if (Result == OK)
+             Result = gp_SortVertices(theSkeleton);
+         else if (Result != NONEMBEDDABLE)
+             Result = NOTOK;
+     }
+
+     if (Result == OK)
+     {
+         firstArc = gp_GetFirstEdge(theSkeleton);
+         for (d = 0; d < 2*m && Result == OK; d++)
+         {
+              j = first + (d >> 1);
+              arc = firstArc + d;
+              tail = gp_GetNeighbor(theSkeleton, gp_GetTwinArc(theSkeleton, arc));
+              head = gp_GetNeighbor(theSkeleton, arc);
+
+              if (tail == ws->vertexLocal[ws->skelU[j]] && head == ws->vertexLocal[ws->skelV[j]])
+                  ws->dartTail[base+d] = ws->skelU[j];
+              else if (tail == ws->vertexLocal[ws->skelV[j]] && head == ws->vertexLocal[ws->skelU[j]])
+                  ws->dartTail[base+d] = ws->skelV[j];
+              else Result = NOTOK;
+
+              ws->dartNext[base+d] = gp_GetNextArcCircular(theSkeleton, arc) - firstArc;
+              ws->dartPrev[base+d] = gp_GetPrevArcCircular(theSkeleton, arc) - firstArc;
+              ws->dartEdge[base+d] = j;
+         }
+     }
+
+     for (k = first; k < first + m; k++)
+          ws->vertexLocal[ws->skelU[k]] = ws->vertexLocal[ws->skelV[k]] = -1;
+
+     ws->numDarts += 2*m;
+     gp_Free(&theSkeleton);
+     return Result;
+}
+
+/********************************************************************
+ _CC_VertexHeight()
+
+ Returns the height of what hangs from vertex v as seen from block b,
+ or -1 if v is plain or is the vertex at which b hangs from its parent
+ ********************************************************************/
+
+int  _CC_VertexHeight(canonicalCodeWorkspace *ws, int b, int v)
+{
+     if (v == ws->blockRoot[b] || ws->hangObj[v] < 0)
+         return -1;
+
+     return ws->objHeight[ws->hangObj[v]];
+}
+
+/********************************************************************
+ _CC_Color()
+
+ Returns the color of vertex v within block b, which is the rank of
+ what hangs from it, CC_PLAIN if nothing does, or CC_PARENT if v is the
+ vertex at which b hangs from its parent
+ ********************************************************************/
+
+int  _CC_Color(canonicalCodeWorkspace *ws, int b, int v)
+{
+     if (v == ws->blockRoot[b])
+         return CC_PARENT;
+
+     return ws->hangObj[v] < 0 ? CC_PLAIN : ws->objRank[ws->hangObj[v]];
+}
+
+/********************************************************************
+ _CC_Label()
+
+ Returns the label of skeleton edge k of node i when it is traversed
+ from its endpoint x, which is CC_PLAIN for an edge of the graph,
+ CC_PARENT for the virtual edge leading to the parent of node i, and
+ otherwise the rank of the child node seen from x to the other endpoint
+ ********************************************************************/
+
+int  _CC_Label(canonicalCodeWorkspace *ws, int i, int k, int x)
+{
+     int a = ws->skelAdj[k];
+
+     if (a < 0)
+         return CC_PLAIN;
+
+     if (a == ws->nodeParent[i])
+         return CC_PARENT;
+
+     return ws->objRank[ws->nodeObj[a] + (x == ws->skelU[ws->nodeParentEdge[a]] ? 0 : 1)];
+}
+
+/********************************************************************
+ _CC_RankObjects()
+
+ Computes the codes of the objects in order of height.  The objects of
+ each height are sorted by their codes, and each distinct code gets the
+ next rank, so the codes of the next height can refer to them by rank.
+
+ Returns OK on success, NOTOK on allocation failure
+ ********************************************************************/
+
+int  _CC_RankObjects(canonicalCodeWorkspace *ws)
+{
+     int numObjects = ws->numObjects, maxHeight = 0, o, h, q, first, last, Result = OK;
+     int *heightStart = NULL, *items = NULL, *temp = NULL;
+
+     for (o = 0; o < numObjects; o++)
+          if (maxHeight < ws->objHeight[o])
+              maxHeight = ws->objHeight[o];
+
+     if ((ws->seqPool = (int *) malloc((ws->seqPoolSize+1) * sizeof(int))) == NULL ||
+         (ws->objRank = (int *) malloc((numObjects+1) * sizeof(int))) == NULL ||
+         (ws->rankObj = (int *) malloc((numObjects+CC_FIRSTRANK) * sizeof(int))) == NULL ||
+         (ws->candidate = (int *) malloc((ws->maxSeqLen+1) * sizeof(int))) == NULL ||
+         (ws->walkNum = (int *) calloc(ws->maxDarts+1, sizeof(int))) == NULL ||
+         (ws->walkOrder1 = (int *) malloc((ws->maxDarts+1) * sizeof(int))) == NULL ||
+         (ws->walkOrder2 = (int *) malloc((ws->maxDarts+1) * sizeof(int))) == NULL ||
+         (ws->walkTokens1 = (int *) malloc((4*ws->maxDarts+1) * sizeof(int))) == NULL ||
+         (ws->walkTokens2 = (int *) malloc((4*ws->maxDarts+1) * sizeof(int))) == NULL ||
+         (ws->dartLabel = (int *) malloc((ws->maxDarts+1) * sizeof(int))) == NULL ||
+         (ws->dartColor = (int *) malloc((ws->maxDarts+1) * sizeof(int))) == NULL ||
+         (heightStart = (int *) calloc(maxHeight+2, sizeof(int))) == NULL ||
+         (items = (int *) malloc((numObjects+1) * sizeof(int))) == NULL ||
+         (temp = (int *) malloc((numObjects+1) * sizeof(int))) == NULL)
+         Result = NOTOK;
+
+     if (Result == OK)
+     {
+         // Bucket the objects by height
+         for (o = 0; o < numObjects; o++)
+              heightStart[ws->objHeight[o]+1]++;
+         for (h = 0; h < maxHeight; h++)
+              heightStart[h+1] += heightStart[h];
+         for (o = 0; o < numObjects; o++)
+              items[heightStart[ws->objHeight[o]]++] = o;
+         for (h = maxHeight; h > 0; h--)
+              heightStart[h] = heightStart[h-1];
+         heightStart[0] = 0;
+
+         ws->numRanks = CC_FIRSTRANK;
+         for (h = 0; h <= maxHeight && Result == OK; h++)
+         {
+              first = heightStart[h];
+              last = h < maxHeight ? heightStart[h+1] : numObjects;
+
+              for (q = first; q < last && Result == OK; q++)
+                   Result = _CC_ComputeSequence(ws, items[q]);
+
+              if (Result != OK)
+                  break;
+
+              _CC_SortObjects(ws, items + first, last - first, temp);
+
+              for (q = first; q < last; q++)
+              {
+                   if (q == first || _CC_CompareSequences(ws, items[q-1], items[q]) != 0)
+                       ws->rankObj[ws->numRanks++] = items[q];
+                   ws->objRank[items[q]] = ws->numRanks - 1;
+              }
+         }
+     }
+
+     if (heightStart != NULL)
+         free(heightStart);
+     if (items != NULL)
+         free(items);
+     if (temp != NULL)
+         free(temp);
+     return Result;
+}
+
+/********************************************************************
+ _CC_ComputeSequence()
+
+ Computes the code of object o, whose parts below it are already ranked.
+
+ Returns OK on success, NOTOK on allocation failure
+ ********************************************************************/
+
+int  _CC_ComputeSequence(canonicalCodeWorkspace *ws, int o)
+{
+     graphP W = ws->theGraph;
+     int *seq = ws->seqPool + ws->objSeqStart[o];
+     int i = ws->objX[o], b, u, w, cu, cw, c1, c2, pe1, pe2, k, n = 0, Result = OK;
+
+     switch (ws->objKind[o])
+     {
+         case CC_HANG :
+             n = _CC_HangSequence(ws, i, seq);
+             break;
+
+         case CC_BRIDGE :
+             b = i;
+             u = gp_GetNeighbor(W, gp_GetTwinArc(W, ws->blockArc[b]));
+             w = gp_GetNeighbor(W, ws->blockArc[b]);
+             cu = _CC_Color(ws, b, u);
+             cw = _CC_Color(ws, b, w);
+             seq[n++] = CC_BRIDGE;
+             if (cu == CC_PARENT)
+                 seq[n++] = cw;
+             else if (cw == CC_PARENT)
+                 seq[n++] = cu;
+             else
+             {
+                 seq[n++] = cu < cw ? cu : cw;
+                 seq[n++] = cu < cw ? cw : cu;
+             }
+             break;
+
+         case CC_SNODE :
+         case CC_PNODE :
+         case CC_RNODE :
+             k = ws->nodeParentEdge[i];
+             u = ws->objY[o] == 0 ? ws->skelU[k] : ws->skelV[k];
+             if (ws->objKind[o] == CC_SNODE)
+                 n = _CC_SNodeSequence(ws, i, u, seq);
+             else if (ws->objKind[o] == CC_PNODE)
+                 n = _CC_PNodeSequence(ws, i, CC_PNODE, u, seq);
+             else
+                 n = _CC_RNodeSequence(ws, i, u, seq);
+             break;
+
+         case CC_SROOT :
+             n = _CC_SRootSequence(ws, i, seq);
+             break;
+
+         case CC_PROOT :
+             k = ws->nodeFirst[i];
+             n = _CC_PNodeSequence(ws, i, CC_PROOT, ws->skelU[k], seq);
+             _CC_PNodeSequence(ws, i, CC_PROOT, ws->skelV[k], ws->candidate);
+             for (k = 0; k < n && seq[k] == ws->candidate[k]; k++)
+                  ;
+             if (k < n && ws->candidate[k] < seq[k])
+                 memcpy(seq, ws->candidate, n * sizeof(int));
+             break;
+
+         case CC_RROOT :
+             n = _CC_RRootSequence(ws, i, seq);
+             if (n < 0)
+                 Result = NOTOK;
+             break;
+
+         case CC_EROOT :
+             // The two nodes of the center edge, each seen from the same
+             // orientation of the edge, in either order and orientation
+             c1 = i;
+             c2 = ws->objY[o];
+             pe1 = ws->nodeParentEdge[c1];
+             pe2 = ws->nodeParentEdge[c2];
+             for (k = 0; k < 2; k++)
+             {
+                  u = k == 0 ? ws->skelU[pe1] : ws->skelV[pe1];
+                  cu = ws->objRank[ws->nodeObj[c1] + k];
+                  cw = ws->objRank[ws->nodeObj[c2] + (u == ws->skelU[pe2] ? 0 : 1)];
+                  ws->candidate[2*k] = cu < cw ? cu : cw;
+                  ws->candidate[2*k+1] = cu < cw ? cw : cu;
+             }
+
+             k = ws->candidate[2] < ws->candidate[0] ||
+                 (ws->candidate[2] == ws->candidate[0] && ws->candidate[3] < ws->candidate[1]) ? 2 : 0;
+             seq[n++] = CC_EROOT;
+             seq[n++] = ws->candidate[k];
+             seq[n++] = ws->candidate[k+1];
+             break;
+
+         case CC_GRAPH :
+             seq[n++] = CC_GRAPH;
+             for (k = 0; k < ws->numComponents; k++)
+                  seq[n++] = ws->objRank[ws->compObj[k]];
+             qsort(seq + 1, n - 1, sizeof(int), _CC_CompareInts);
+             break;
+     }
+
+     ws->objSeqLen[o] = n;
+     return Result;
+}
+
+/********************************************************************
+ _CC_HangSequence()
+
+ The code of vertex v with what hangs from it is its number of
+ self-loops and the sorted ranks of its child blocks.
+
+ Returns the length of the code
+ ********************************************************************/
+
+int  _CC_HangSequence(canonicalCodeWorkspace *ws, int v, int *seq)
+{
+     int n = 0, k, b;
+
+     seq[n++] = CC_HANG;
+     seq[n++] = ws->loops[v];
+     for (k = ws->vertBlockStart[v]; k < ws->vertBlockStart[v+1]; k++)
+     {
+          b = ws->vertBlocks[k];
+          if (b != ws->parentBlock[v])
+              seq[n++] = ws->objRank[ws->blockObj[b]];
+     }
+
+     qsort(seq + 2, n - 2, sizeof(int), _CC_CompareInts);
+     return n;
+}
+
+/********************************************************************
+ _CC_SNodeSequence()
+
+ The skeleton of an S-node is a cycle.  Its code seen from pole s is the
+ colors of the poles followed by the labels and colors along the path
+ from the other pole t back to s that avoids the parent virtual edge.
+
+ Returns the length of the code
+ ********************************************************************/
+
+int  _CC_SNodeSequence(canonicalCodeWorkspace *ws, int i, int s, int *seq)
+{
+     int b = ws->nodeBlock[i], pe = ws->nodeParentEdge[i], n = 0, k, x, y, prev, steps;
+
+     for (k = ws->nodeFirst[i]; k < ws->nodeFirst[i+1]; k++)
+     {
+          x = ws->skelU[k];
+          if (ws->vertexEdge1[x] < 0) ws->vertexEdge1[x] = k; else ws->vertexEdge2[x] = k;
+          x = ws->skelV[k];
+          if (ws->vertexEdge1[x] < 0) ws->vertexEdge1[x] = k; else ws->vertexEdge2[x] = k;
+     }
+
+     x = ws->skelU[pe] == s ? ws->skelV[pe] : ws->skelU[pe];
+     seq[n++] = CC_SNODE;
+     seq[n++] = _CC_Color(ws, b, s);
+     seq[n++] = _CC_Color(ws, b, x);
+
+     prev = pe;
+     for (steps = ws->nodeFirst[i+1] - ws->nodeFirst[i]; steps > 1; steps--)
+     {
+          k = ws->vertexEdge1[x] == prev ? ws->vertexEdge2[x] : ws->vertexEdge1[x];
+          y = ws->skelU[k] == x ? ws->skelV[k] : ws->skelU[k];
+          seq[n++] = _CC_Label(ws, i, k, x);
+          if (y == s)
+              break;
+          seq[n++] = _CC_Color(ws, b, y);
+          x = y;
+          prev = k;
+     }
+
+     for (k = ws->nodeFirst[i]; k < ws->nodeFirst[i+1]; k++)
+          ws->vertexEdge1[ws->skelU[k]] = ws->vertexEdge2[ws->skelU[k]] =
+          ws->vertexEdge1[ws->skelV[k]] = ws->vertexEdge2[ws->skelV[k]] = -1;
+
+     return n;
+}
+
+/********************************************************************
+ _CC_PNodeSequence()
+
+ The skeleton of a P-node is a bundle of parallel edges.  Its code seen
+ from pole s is the colors of the poles followed by the sorted labels
+ of the edges other than the parent virtual edge, seen from s.
+
+ Returns the length of the code
+ ********************************************************************/
+
+int  _CC_PNodeSequence(canonicalCodeWorkspace *ws, int i, int kind, int s, int *seq)
+{
+     int b = ws->nodeBlock[i], first = ws->nodeFirst[i], n = 0, k, t;
+
+     t = ws->skelU[first] == s ? ws->skelV[first] : ws->skelU[first];
+     seq[n++] = kind;
+     seq[n++] = _CC_Color(ws, b, s);
+     seq[n++] = _CC_Color(ws, b, t);
+     for (k = first; k < ws->nodeFirst[i+1]; k++)
+          if (k != ws->nodeParentEdge[i])
+              seq[n++] = _CC_Label(ws, i, k, s);
+
+     qsort(seq + 3, n - 3, sizeof(int), _CC_CompareInts);
+     return n;
+}
+
+/********************************************************************
+ _CC_SRootSequence()
+
+ The code of an S-node at the center of its tree is the least rotation
+ of the colors and labels around its cycle, read in either direction.
+
+ Returns the length of the code
+ ********************************************************************/
+
+int  _CC_SRootSequence(canonicalCodeWorkspace *ws, int i, int *seq)
+{
+     int b = ws->nodeBlock[i], first = ws->nodeFirst[i], m = ws->nodeFirst[i+1] - first;
+     int *verts = ws->walkOrder1, *edges = ws->walkOrder2;
+     int *forward = ws->walkTokens1, *backward = ws->walkTokens2;
+     int j, k, x, y, start1, start2, n = 0;
+
+     for (k = first; k < first + m; k++)
+     {
+          x = ws->skelU[k];
+          if (ws->vertexEdge1[x] < 0) ws->vertexEdge1[x] = k; else ws->vertexEdge2[x] = k;
+          x = ws->skelV[k];
+          if (ws->vertexEdge1[x] < 0) ws->vertexEdge1[x] = k; else ws->vertexEdge2[x] = k;
+     }
+
+     // Edge j of the cycle joins verts[j] to verts[j+1 mod m]
+     x = ws->skelU[first];
+     k = first;
+     for (j = 0; j < m; j++)
+     {
+          verts[j] = x;
+          edges[j] = k;
+          y = ws->skelU[k] == x ? ws->skelV[k] : ws->skelU[k];
+          k = ws->vertexEdge1[y] == k ? ws->vertexEdge2[y] : ws->vertexEdge1[y];
+          x = y;
+     }
+
+     for (j = 0; j < m; j++)
+     {
+          forward[2*j] = _CC_Color(ws, b, verts[j]);
+          forward[2*j+1] = _CC_Label(ws, i, edges[j], verts[j]);
+          backward[2*j] = _CC_Color(ws, b, verts[(m-j) % m]);
+          backward[2*j+1] = _CC_Label(ws, i, edges[(2*m-j-1) % m], verts[(m-j) % m]);
+     }
+
+     start1 = _CC_LeastRotation(forward, m);
+     start2 = _CC_LeastRotation(backward, m);
+     if (_CC_CompareRotations(backward, start2, forward, start1, m) < 0)
+     {
+         forward = backward;
+         start1 = start2;
+     }
+
+     seq[n++] = CC_SROOT;
+     for (j = 0; j < m; j++)
+     {
+          seq[n++] = forward[2*((start1+j) % m)];
+          seq[n++] = forward[2*((start1+j) % m) + 1];
+     }
+
+     for (k = first; k < first + m; k++)
+          ws->vertexEdge1[ws->skelU[k]] = ws->vertexEdge2[ws->skelU[k]] =
+          ws->vertexEdge1[ws->skelV[k]] = ws->vertexEdge2[ws->skelV[k]] = -1;
+
+     return n;
+}
+
+/********************************************************************
+ _CC_RNodeSequence()
+
+ The code of an R-node seen from pole s is the lesser of the walks of
+ its embedding and of the mirror image of its embedding, each starting
+ from the dart of the parent virtual edge that leaves s.
+
+ Returns the length of the code
+ ********************************************************************/
+
+int  _CC_RNodeSequence(canonicalCodeWorkspace *ws, int i, int s, int *seq)
+{
+     int D = 2*(ws->nodeFirst[i+1] - ws->nodeFirst[i]), start, *best;
+
+     _CC_PrepareDarts(ws, i);
+
+     start = 2*(ws->nodeParentEdge[i] - ws->nodeFirst[i]);
+     if (ws->dartTail[ws->rStart[i] + start] != s)
+         start ^= 1;
+
+     _CC_Walk(ws, i, start, 0, ws->walkTokens1, NULL, ws->walkOrder1);
+     best = _CC_Walk(ws, i, start, 1, ws->walkTokens2, ws->walkTokens1, ws->walkOrder2) < 0
+          ? ws->walkTokens2 : ws->walkTokens1;
+
+     seq[0] = CC_RNODE;
+     memcpy(seq + 1, best, 4 * D * sizeof(int));
+     return 1 + 4*D;
+}
+
+/********************************************************************
+ _CC_RRootSequence()
+
+ The code of an R-node at the center of its tree is the least walk of
+ its embedding or its mirror image from any dart.  Only the darts of the
+ rarest class of an invariant that is unchanged by isomorphism and by
+ mirroring are tried.  The invariant starts from the label and color of
+ each dart and the degree of its tail, and is refined a few times by the
+ invariants of the darts around it.
+
+ When the walks from two starts agree, mapping the walk order of one to
+ that of the other is an automorphism of the embedding.  The starts in
+ the orbit of the best start under the automorphisms found so far give
+ the same walk, so they are skipped.
+
+ Returns the length of the code, or -1 on allocation failure
+ ********************************************************************/
+
+int  _CC_RRootSequence(canonicalCodeWorkspace *ws, int i, int *seq)
+{
+     int base = ws->rStart[i], D = 2*(ws->nodeFirst[i+1] - ws->nodeFirst[i]);
+     unsigned int *inv = NULL, *inv2 = NULL, *sorted = NULL, *swapInv, target = 0;
+     int *deg = NULL, *orbit = NULL, *gens[CC_MAXGENERATORS], flips[CC_MAXGENERATORS];
+     unsigned char *covered = NULL;
+     int *cur = ws->walkTokens1, *best = ws->walkTokens2, *curOrder = ws->walkOrder1, *bestOrder = ws->walkOrder2;
+     int *swapInts, numGens = 0, orbitSize = 0, haveBest = 0, bestStart = 0, d, e, m, r, q, run, bestRun, cmp;
+     int n = -1;
+
+     if ((inv = (unsigned int *) malloc(D * sizeof(unsigned int))) == NULL ||
+         (inv2 = (unsigned int *) malloc(D * sizeof(unsigned int))) == NULL ||
+         (sorted = (unsigned int *) malloc(D * sizeof(unsigned int))) == NULL ||
+         (deg = (int *) calloc(D, sizeof(int))) == NULL ||
+         (orbit = (int *) malloc(2 * D * sizeof(int))) == NULL ||
+         (covered = (unsigned char *) calloc(2 * D, sizeof(unsigned char))) == NULL)
+         D = -1;
+
+     _CC_PrepareDarts(ws, i);
+
+     // The degree of the tail of each dart is the length of its rotation
+     for (d = 0; d < D; d++)
+     {
+          if (deg[d] > 0)
+              continue;
+          for (e = d, m = 0; m == 0 || e != d; e = ws->dartNext[base+e])
+               m++;
+          for (e = d, r = 0; r == 0 || e != d; e = ws->dartNext[base+e], r++)
+               deg[e] = m;
+     }
+
+     for (d = 0; d < D; d++)
+     {
+          inv[d] = _CC_Mix(_CC_Mix(_CC_Mix(0, ws->dartLabel[d]), ws->dartColor[d]), deg[d]);
+          inv[d] = _CC_Mix(_CC_Mix(inv[d], ws->dartColor[d^1]), deg[d^1]);
+     }
+
+     for (r = 0; r < 3 && D > 0; r++)
+     {
+          for (d = 0; d < D; d++)
+          {
+               unsigned int a = inv[ws->dartNext[base+d]], c = inv[ws->dartPrev[base+d]];
+               inv2[d] = _CC_Mix(_CC_Mix(_CC_Mix(_CC_Mix(inv[d], inv[d^1]), a < c ? a : c), a < c ? c : a), r);
+          }
+          swapInv = inv; inv = inv2; inv2 = swapInv;
+     }
+
+     // Find the rarest class, taking the least invariant among equals
+     if (D > 0)
+     {
+         memcpy(sorted, inv, D * sizeof(unsigned int));
+         qsort(sorted, D, sizeof(unsigned int), _CC_CompareUnsigned);
+         for (q = 0, bestRun = D+1; q < D; q += run)
+         {
+              for (run = 1; q + run < D && sorted[q+run] == sorted[q]; run++)
+                   ;
+              if (run < bestRun)
+              {
+                  bestRun = run;
+                  target = sorted[q];
+              }
+         }
+     }
+
+     for (d = 0; d < D; d++)
+     {
+          if (inv[d] != target)
+              continue;
+
+          for (m = 0; m < 2; m++)
+          {
+               if (covered[2*d+m])
+                   continue;
+
+               cmp = _CC_Walk(ws, i, d, m, cur, haveBest ? best : NULL, curOrder);
+               if (cmp < 0)
+               {
+                   swapInts = cur; cur = best; best = swapInts;
+                   swapInts = curOrder; curOrder = bestOrder; bestOrder = swapInts;
+                   haveBest = 1;
+                   bestStart = 2*d+m;
+               }
+               else if (cmp == 0 && numGens < CC_MAXGENERATORS)
+               {
+                   if ((gens[numGens] = (int *) malloc(D * sizeof(int))) == NULL)
+                   {
+                       D = -1;
+                       break;
+                   }
+                   for (q = 0; q < D; q++)
+                        gens[numGens][bestOrder[q]] = curOrder[q];
+                   flips[numGens++] = (bestStart & 1) ^ m;
+               }
+               else continue;
+
+               // Recompute the orbit of the best start
+               for (q = 0; q < orbitSize; q++)
+                    covered[orbit[q]] = 0;
+               orbitSize = _CC_RRootOrbit(D, bestStart, gens, flips, numGens, covered, orbit);
+          }
+     }
+
+     if (D >= 0)
+     {
+         seq[0] = CC_RROOT;
+         memcpy(seq + 1, best, 4 * D * sizeof(int));
+         n = 1 + 4*D;
+     }
+
+     while (numGens > 0)
+         free(gens[--numGens]);
+     if (inv != NULL) free(inv);
+     if (inv2 != NULL) free(inv2);
+     if (sorted != NULL) free(sorted);
+     if (deg != NULL) free(deg);
+     if (orbit != NULL) free(orbit);
+     if (covered != NULL) free(covered);
+
+     return n;
+}
+
+/********************************************************************
+ _CC_RRootOrbit()
+
+ Marks as covered the orbit of the start 2d+m, meaning dart d walked
+ with mirror m, under the generators found so far.  Generator g maps
+ dart d to gens[g][d] and toggles the mirror if flips[g] is set.
+
+ Returns the size of the orbit, whose starts are listed in orbit
+ ********************************************************************/
+
+int  _CC_RRootOrbit(int D, int start, int **gens, int *flips, int numGens, unsigned char *covered, int *orbit)
+{
+     int head = 0, tail = 0, g, x, y;
+
+     covered[start] = 1;
+     orbit[tail++] = start;
+     while (head < tail)
+     {
+          x = orbit[head++];
+          for (g = 0; g < numGens; g++)
+          {
+               y = 2*gens[g][x >> 1] + ((x & 1) ^ flips[g]);
+               if (!covered[y])
+               {
+                   covered[y] = 1;
+                   orbit[tail++] = y;
+               }
+          }
+     }
+
+     return tail;
+}
+
+/********************************************************************
+ _CC_PrepareDarts()
+
+ Gives the label and color of each dart of R-node i, for its walks.
+ ********************************************************************/
+
+void _CC_PrepareDarts(canonicalCodeWorkspace *ws, int i)
+{
+     int base = ws->rStart[i], D = 2*(ws->nodeFirst[i+1] - ws->nodeFirst[i]), d;
+
+     for (d = 0; d < D; d++)
+     {
+          ws->dartLabel[d] = _CC_Label(ws, i, ws->dartEdge[base+d], ws->dartTail[base+d]);
+          ws->dartColor[d] = _CC_Color(ws, ws->nodeBlock[i], ws->dartTail[base+d]);
+     }
+}
+
+/********************************************************************
+ _CC_Walk()
+
+ Walks the embedding of R-node i from the start dart, or its mirror
+ image if mirror is set, numbering the darts in the order they are
+ first reached.  The darts are visited in order of their numbers, and
+ each one adds four tokens to the walk: the numbers of the next dart
+ around its tail and of its twin, and its label and color.  The walk
+ depends only on the embedding and the start, so equal walks from two
+ starts give an automorphism.
+
+ If best is not NULL, the walk stops as soon as it exceeds best.  The
+ visiting order of the darts is given in order.
+
+ Returns -1 if the walk is less than best or best is NULL, 0 if equal,
+         1 if greater
+ ********************************************************************/
+
+int  _CC_Walk(canonicalCodeWorkspace *ws, int i, int start, int mirror, int *tokens, int *best, int *order)
+{
+     int *rotation = mirror ? ws->dartPrev + ws->rStart[i] : ws->dartNext + ws->rStart[i];
+     int *num = ws->walkNum, n = 0, q = 0, pos = 0, cmp = best == NULL ? -1 : 0, d, r, t, k;
+
+     num[start] = ++n;
+     order[0] = start;
+
+     while (q < n && cmp <= 0)
+     {
+          d = order[q++];
+          r = rotation[d];
+          t = d ^ 1;
+          if (num[r] == 0)
+          {
+              num[r] = ++n;
+              order[n-1] = r;
+          }
+          if (num[t] == 0)
+          {
+              num[t] = ++n;
+              order[n-1] = t;
+          }
+
+          tokens[pos] = num[r];
+          tokens[pos+1] = num[t];
+          tokens[pos+2] = ws->dartLabel[d];
+          tokens[pos+3] = ws->dartColor[d];
+
+          for (k = pos; k < pos + 4 && cmp == 0; k++)
+               if (tokens[k] != best[k])
+                   cmp = tokens[k] < best[k] ? -1 : 1;
+          pos += 4;
+     }
+
+     for (k = 0; k < n; k++)
+          num[order[k]] = 0;
+
+     return cmp;
+}
+
+/********************************************************************
+ _CC_LeastRotation()
+
+ Returns the start of the least rotation of the k (color, label) pairs
+ ********************************************************************/
+
+int  _CC_LeastRotation(int *pairs, int k)
+{
+     int i = 0, j = 1, n = 0, a, b, c;
+
+     while (i < k && j < k && n < k)
+     {
+          a = 2*((i+n) % k);
+          b = 2*((j+n) % k);
+          c = pairs[a] != pairs[b] ? pairs[a] - pairs[b] : pairs[a+1] - pairs[b+1];
+          if (c == 0)
+              n++;
+          else
+          {
+              if (c > 0)
+                  i += n + 1;
+              else
+                  j += n + 1;
+              if (i == j)
+                  j++;
+              n = 0;
+          }
+     }
+
+     return i < j ? i : j;
+}
+
+/********************************************************************
+ _CC_CompareRotations()
+
+ Compares k pairs of the cyclic sequence pairs1 from start1 with k pairs
+ of the cyclic sequence pairs2 from start2, both of length k pairs.
+ ********************************************************************/
+
+int  _CC_CompareRotations(int *pairs1, int start1, int *pairs2, int start2, int k)
+{
+     int j, a, b;
+
+     for (j = 0; j < 2*k; j++)
+     {
+          a = pairs1[(2*start1 + j) % (2*k)];
+          b = pairs2[(2*start2 + j) % (2*k)];
+          if (a != b)
+              return a < b ? -1 : 1;
+     }
+
+     return 0;
+}
+
+/********************************************************************
+ _CC_CompareSequences()
+
+ Compares the codes of objects o1 and o2 lexicographically, where a
+ proper prefix is less.
+ ********************************************************************/
+
+int  _CC_CompareSequences(canonicalCodeWorkspace *ws, int o1, int o2)
+{
+     int *seq1 = ws->seqPool + ws->objSeqStart[o1], *seq2 = ws->seqPool + ws->objSeqStart[o2];
+     int len1 = ws->objSeqLen[o1], len2 = ws->objSeqLen[o2], k;
+
+     for (k = 0; k < len1 && k < len2; k++)
+          if (seq1[k] != seq2[k])
+              return seq1[k] < seq2[k] ? -1 : 1;
+
+     return len1 == len2 ? 0 : (len1 < len2 ? -1 : 1);
+}
+
+/********************************************************************
+ _CC_SortObjects()
+
+ Sorts the n objects in items by their codes with a bottom-up merge
+ sort, using temp as working space.
+ ********************************************************************/
+
+void _CC_SortObjects(canonicalCodeWorkspace *ws, int *items, int n, int *temp)
+{
+     int width, lo, mid, hi, a, b, k;
+
+     for (width = 1; width < n; width *= 2)
+     {
+          for (lo = 0; lo < n; lo += 2*width)
+          {
+               mid = lo + width < n ? lo + width : n;
+               hi = lo + 2*width < n ? lo + 2*width : n;
+               for (a = lo, b = mid, k = lo; k < hi; k++)
+               {
+                    if (a < mid && (b >= hi || _CC_CompareSequences(ws, items[a], items[b]) <= 0))
+                        temp[k] = items[a++];
+                    else
+                        temp[k] = items[b++];
+               }
+          }
+          memcpy(items, temp, n * sizeof(int));
+     }
+}
+
+/********************************************************************
+ _CC_CompareInts(), _CC_CompareUnsigned()
+
+ Comparison functions for qsort()
+ ********************************************************************/
+
+int  _CC_CompareInts(const void *p1, const void *p2)
+{
+     int a = *(const int *) p1, b = *(const int *) p2;
+     return a < b ? -1 : (a > b ? 1 : 0);
+}
+
+int  _CC_CompareUnsigned(const void *p1, const void *p2)
+{
+     unsigned int a = *(const unsigned int *) p1, b = *(const unsigned int *) p2;
+     return a < b ? -1 : (a > b ? 1 : 0);
+}
+
+/********************************************************************
+ _CC_Mix()
+
+ Mixes x into the hash value h with one round of MurmurHash3
+ ********************************************************************/
+
+unsigned int _CC_Mix(unsigned int h, unsigned int x)
+{
+     x *= 0xcc9e2d51u;
+     x = ((x << 15) | (x >> 17)) & 0xffffffffu;
+     x *= 0x1b873593u;
+     h ^= x;
+     h = ((h << 13) | (h >> 19)) & 0xffffffffu;
+     return (h * 5 + 0xe6546b64u) & 0xffffffffu;
+}
+
+/********************************************************************
+ _CC_WriteCode()
+
+ Writes the codes of the distinct ranks in rank order, each as its
+ length followed by its tokens, all as variable length integers of
+ seven bits per byte, least significant first, with the high bit set
+ on all but the last byte.  The code of the whole graph has the highest
+ rank, so it is last.  Then hashes the result.
+
+ Returns OK on success, NOTOK on allocation failure
+ ********************************************************************/
+
+int  _CC_WriteCode(canonicalCodeWorkspace *ws, planarCanonicalCodeP theCode)
+{
+     int r, k, pass, length = 0, len, *seq;
+     unsigned int x;
+
+     // The first pass measures the code, and the second writes it
+     for (pass = 0; pass < 2; pass++)
+     {
+          if (pass == 1)
+          {
+              if (theCode->codeCapacity < length)
+              {
+                  if (theCode->code != NULL)
+                      free(theCode->code);
+                  if ((theCode->code = (unsigned char *) malloc(length)) == NULL)
+                  {
+                      theCode->codeLength = theCode->codeCapacity = 0;
+                      return NOTOK;
+                  }
+                  theCode->codeCapacity = length;
+              }
+              length = 0;
+          }
+
+          for (r = CC_FIRSTRANK; r < ws->numRanks; r++)
+          {
+               seq = ws->seqPool + ws->objSeqStart[ws->rankObj[r]];
+               len = ws->objSeqLen[ws->rankObj[r]];
+               for (k = -1; k < len; k++)
+               {
+                    x = (unsigned int) (k < 0 ? len : seq[k]);
+                    do {
+                         if (pass == 1)
+                             theCode->code[length] = (unsigned char) ((x & 0x7f) | (x > 0x7f ? 0x80 : 0));
+                         length++;
+                         x >>= 7;
+                    } while (x > 0);
+               }
+          }
+     }
+
+     theCode->codeLength = length;
+     _CC_Hash128(theCode->code, length, theCode->hash);
+     return OK;
+}
+
+/********************************************************************
+ _CC_Hash128()
+
+ MurmurHash3 x86_128 of the data with seed 0, with the four 32-bit
+ words of the result written least significant byte first
+ ********************************************************************/
+
+void _CC_Hash128(unsigned char *data, int length, unsigned char *hash)
+{
+     static const unsigned int c[4] = { 0x239b961bu, 0xab0e9789u, 0x38b34ae5u, 0xa1e38b93u };
+     static const int rk[4] = { 15, 16, 17, 18 }, rh[4] = { 19, 17, 15, 13 };
+     static const unsigned int add[4] = { 0x561ccd1bu, 0x0bcaa747u, 0x96cd1c35u, 0x32ac3b17u };
+     unsigned int h[4] = { 0, 0, 0, 0 }, k[4];
+     int numBlocks = length / 16, blk, j, b;
+
+     for (blk = 0; blk < numBlocks; blk++)
+     {
+          for (j = 0; j < 4; j++)
+          {
+               for (b = 3, k[j] = 0; b >= 0; b--)
+                    k[j] = (k[j] << 8) | data[16*blk + 4*j + b];
+          }
+          for (j = 0; j < 4; j++)
+          {
+               k[j] = (k[j] * c[j]) & 0xffffffffu;
+               k[j] = CC_ROTL(k[j], rk[j]);
+               k[j] = (k[j] * c[(j+1) & 3]) & 0xffffffffu;
+               h[j] ^= k[j];
+               h[j] = CC_ROTL(h[j], rh[j]);
+               h[j] = (h[j] + h[(j+1) & 3]) & 0xffffffffu;
+               h[j] = (h[j] * 5 + add[j]) & 0xffffffffu;
+          }
+     }
+
+     // The tail of up to 15 bytes
+     k[0] = k[1] = k[2] = k[3] = 0;
+     for (b = length - 16*numBlocks - 1; b >= 0; b--)
+          k[b >> 2] |= (unsigned int) data[16*numBlocks + b] << (8 * (b & 3));
+     for (j = 0; j < 4; j++)
+     {
+          if (16*numBlocks + 4*j >= length)
+              break;
+          k[j] = (k[j] * c[j]) & 0xffffffffu;
+          k[j] = CC_ROTL(k[j], rk[j]);
+          k[j] = (k[j] * c[(j+1) & 3]) & 0xffffffffu;
+          h[j] ^= k[j];
+     }
+
+     // Finalization
+     for (j = 0; j < 4; j++)
+          h[j] ^= (unsigned int) length;
+     h[0] = (h[0] + h[1] + h[2] + h[3]) & 0xffffffffu;
+     for (j = 1; j < 4; j++)
+          h[j] = (h[j] + h[0]) & 0xffffffffu;
+     for (j = 0; j < 4; j++)
+     {
+          h[j] ^= h[j] >> 16;
+          h[j] = (h[j] * 0x85ebca6bu) & 0xffffffffu;
+          h[j] ^= h[j] >> 13;
+          h[j] = (h[j] * 0xc2b2ae35u) & 0xffffffffu;
+          h[j] ^= h[j] >> 16;
+     }
+     h[0] = (h[0] + h[1] + h[2] + h[3]) & 0xffffffffu;
+     for (j = 1; j < 4; j++)
+          h[j] = (h[j] + h[0]) & 0xffffffffu;
+
+     for (j = 0; j < 16; j++)
+          hash[j] = (unsigned char) (h[j >> 2] >> (8 * (j & 3)));
+}
@@ -0,0 +1,1524 @@
+/*
+Planarity-Related Graph Algorithms Project
+Copyright (c) 1997-2012, John M. Boyer
+All rights reserved. Includes a reference implementation of the following:
+
+* John M. Boyer. "Subgraph Homeomorphism via the Edge Addition Planarity Algorithm".
+  Journal of Graph Algorithms and Applications, Vol. 16, no. 2, pp. 381-410, 2012.
+  http://www.jgaa.info/16/268.html
+
+* John M. Boyer. "A New Method for Efficiently Generating Planar Graph
+  Visibility Representations". In P. Eades and P. Healy, editors,
+  Proceedings of the 13th International Conference on Graph Drawing 2005,
+  Lecture Notes Comput. Sci., Volume 3843, pp. 508-511, Springer-Verlag, 2006.
+
+* John M. Boyer and Wendy J. Myrvold. "On the Cutting Edge: Simplified O(n)
+  Planarity by Edge Addition". Journal of Graph Algorithms and Applications,
+  Vol. 8, No. 3, pp. 241-273, 2004.
+  http://www.jgaa.info/08/91.html
+
+* John M. Boyer. "Simplified O(n) Algorithms for Planar Graph Embedding,
+  Kuratowski Subgraph Isolation, and Related Problems". Ph.D. Dissertation,
+  University of Victoria, 2001.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+  list of conditions and the following disclaimer in the documentation and/or
+  other materials provided with the distribution.
+
+* Neither the name of the Planarity-Related Graph Algorithms Project nor the names
+  of its contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdlib.h>
+
+#include "graph.h"
+#include "platformThread.h"
+
+/* Private types */
+
+/********************************************************************
+ A rotation system on local vertices 0..n-1, used to separate and
+ partition induced subgraphs of an embedding without modifying it.
+
+        vertex: the graph vertex of each local vertex
+        parentLocal: the local vertex in the rotation system from which
+                this one was induced, or the local vertex itself
+        dartStart: the darts leaving local vertex v are dartStart[v] to
+                dartStart[v+1]-1, in rotation order
+        dartHead: the local vertex that each dart enters
+        dartTwin: the dart of the same edge in the opposite direction
+*/
+
+typedef struct
+{
+    int n, numDarts;
+    int *vertex, *parentLocal;
+    int *dartStart, *dartHead, *dartTwin;
+} rotationSystem;
+
+typedef rotationSystem * rotationSystemP;
+
+/********************************************************************
+ A unit of work of the recursive partitioning: the rotation system of
+ an induced subgraph whose vertices are to be divided into numParts
+ parts, numbered from firstPart.
+*/
+
+typedef struct
+{
+    rotationSystemP R;
+    int numParts, firstPart;
+} partitionUnit;
+
+/********************************************************************
+ The units of work shared by the threads of the partitioning, with the
+ next unit to be taken, and the part of each vertex, which the threads
+ write for disjoint sets of vertices.  Each thread counts the separator
+ vertices that it finds.
+*/
+
+typedef struct
+{
+    partitionUnit *units;
+    int numUnits, nextUnit, stop;
+    int *vertexPart;
+} partitionQueue;
+
+typedef struct
+{
+    partitionQueue *queue;
+    int numSeparator;
+    int Result;
+} partitionThread;
+
+/* Private functions */
+
+rotationSystemP _RS_New(int n, int numDarts);
+void _RS_Free(rotationSystemP *pRS);
+rotationSystemP _RS_FromGraph(graphP theGraph);
+rotationSystemP _RS_Induced(rotationSystemP rs, int *newId, int newN);
+int  _RS_Separate(rotationSystemP rs, int *side);
+int  _RS_SplitByCycle(rotationSystemP rs, int *order, int nK, int *parentDart,
+                      int *pieceOf, int midPiece, int inPiece);
+int  _RS_Bisect(rotationSystemP rs, int numerator, int denominator, int *side);
+void _GroupPieces(int numPieces, int *pieceSize, int *pieceSide);
+int  _AssignSeparatorVertices(graphP theGraph, int numParts, int *vertexPart);
+
+int  _SplitUnit(partitionUnit *unit, partitionUnit *unitA, partitionUnit *unitB,
+                int *side, int *newIdA, int *newIdB, int *pNumSeparator);
+int  _PartitionUnit(partitionUnit *unit, int *vertexPart, int *pNumSeparator);
+void _PartitionUnits(partitionThread *thread);
+platform_ThreadReturn _PartitionUnitsThread(void *thread);
+
+/********************************************************************
+ _RS_New()
+ ********************************************************************/
+
+rotationSystemP _RS_New(int n, int numDarts)
+{
+     rotationSystemP rs = (rotationSystemP) calloc(1, sizeof(rotationSystem));
+
+     if (rs == NULL)
+         return NULL;
+
+     rs->n = n;
+     rs->numDarts = numDarts;
+
+     if ((rs->vertex = (int *) malloc((n+1) * sizeof(int))) == NULL ||
+         (rs->parentLocal = (int *) malloc((n+1) * sizeof(int))) == NULL ||
+         (rs->dartStart = (int *) malloc((n+1) * sizeof(int))) == NULL ||
+         (rs->dartHead = (int *) malloc((numDarts+1) * sizeof(int))) == NULL ||
+         (rs->dartTwin = (int *) malloc((numDarts+1) * sizeof(int))) == NULL)
+         _RS_Free(&rs);
+
+     return rs;
+}
+
+/********************************************************************
+ _RS_Free()
+ ********************************************************************/
+
+void _RS_Free(rotationSystemP *pRS)
+{
+     if (pRS == NULL || *pRS == NULL)
+         return;
+
+     free((*pRS)->vertex);
+     free((*pRS)->parentLocal);
+     free((*pRS)->dartStart);
+     free((*pRS)->dartHead);
+     free((*pRS)->dartTwin);
+     free(*pRS);
+     *pRS = NULL;
+}
+
+/********************************************************************
+ _RS_FromGraph()
+
+ Obtains the rotation system of all the vertices of theGraph from the
+ order of their adjacency lists.  Self-loops are omitted.
+
+ Returns the rotation system, or NULL on allocation failure
+ ********************************************************************/
+
+rotationSystemP _RS_FromGraph(graphP theGraph)
+{
+     rotationSystemP rs;
+     int *dartOfArc, v, e, d, first = gp_GetFirstVertex(theGraph);
+
+     d = 0;
+     for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
+          for (e = gp_GetFirstArc(theGraph, v); gp_IsArc(e); e = gp_GetNextArc(theGraph, e))
+               if (gp_GetNeighbor(theGraph, e) != v)
+                   d++;
+
+     if ((rs = _RS_New(theGraph->N, d)) == NULL)
+         return NULL;
+
+     if ((dartOfArc = (int *) malloc(gp_EdgeIndexBound(theGraph) * sizeof(int))) == NULL)
+     {
+         _RS_Free(&rs);
+         return NULL;
+     }
+
+     d = 0;
+     for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
+     {
+          rs->vertex[v - first] = v;
+          rs->parentLocal[v - first] = v - first;
+          rs->dartStart[v - first] = d;
+          for (e = gp_GetFirstArc(theGraph, v); gp_IsArc(e); e = gp_GetNextArc(theGraph, e))
+          {
+               if (gp_GetNeighbor(theGraph, e) != v)
+               {
+                   dartOfArc[e] = d;
+                   rs->dartHead[d++] = gp_GetNeighbor(theGraph, e) - first;
+               }
+          }
+     }
+     rs->dartStart[theGraph->N] = d;
+
+     for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
+          for (e = gp_GetFirstArc(theGraph, v); gp_IsArc(e); e = gp_GetNextArc(theGraph, e))
+               if (gp_GetNeighbor(theGraph, e) != v)
+                   rs->dartTwin[dartOfArc[e]] = dartOfArc[gp_GetTwinArc(theGraph, e)];
+
+     free(dartOfArc);
+     return rs;
+}
+
+/********************************************************************
+ _RS_Induced()
+
+ Obtains the rotation system induced by the local vertices v of rs that
+ have newId[v] >= 0.  The new ids must be 0..newN-1 in increasing order
+ of v.  Deleting vertices from a planar rotation system leaves a planar
+ rotation system, so the result is an embedding of the induced subgraph.
+
+ Returns the rotation system, or NULL on allocation failure
+ ********************************************************************/
+
+rotationSystemP _RS_Induced(rotationSystemP rs, int *newId, int newN)
+{
+     rotationSystemP child;
+     int *newDart, v, d, count = 0;
+
+     for (v = 0; v < rs->n; v++)
+          if (newId[v] >= 0)
+              for (d = rs->dartStart[v]; d < rs->dartStart[v+1]; d++)
+                   if (newId[rs->dartHead[d]] >= 0)
+                       count++;
+
+     if ((child = _RS_New(newN, count)) == NULL)
+         return NULL;
+
+     if ((newDart = (int *) malloc((rs->numDarts+1) * sizeof(int))) == NULL)
+     {
+         _RS_Free(&child);
+         return NULL;
+     }
+
+     count = 0;
+     for (v = 0; v < rs->n; v++)
+     {
+          if (newId[v] < 0)
+              continue;
+
+          child->vertex[newId[v]] = rs->vertex[v];
+          child->parentLocal[newId[v]] = v;
+          child->dartStart[newId[v]] = count;
+          for (d = rs->dartStart[v]; d < rs->dartStart[v+1]; d++)
+          {
+               if (newId[rs->dartHead[d]] >= 0)
+               {
+                   newDart[d] = count;
+                   child->dartHead[count++] = newId[rs->dartHead[d]];
+               }
+          }
+     }
+     child->dartStart[newN] = count;
+
+     for (v = 0; v < rs->n; v++)
+          if (newId[v] >= 0)
+              for (d = rs->dartStart[v]; d < rs->dartStart[v+1]; d++)
+                   if (newId[rs->dartHead[d]] >= 0)
+                       child->dartTwin[newDart[d]] = newDart[rs->dartTwin[d]];
+
+     free(newDart);
+     return child;
+}
+
+/********************************************************************
+ _GroupPieces()
+
+ Assigns pieces of sizes at most 2n/3, whose sizes total at most n, to
+ sides 1 and 2 so that each side gets at most 2n/3 vertices.  Taking the
+ pieces from largest to smallest, each goes to the side with fewer
+ vertices.  The first two pieces go to different sides, and each later
+ piece has at most n/3 vertices, so it cannot push the lighter side past
+ 2n/3.  Pieces of size zero are given side 1.
+ ********************************************************************/
+
+void _GroupPieces(int numPieces, int *pieceSize, int *pieceSide)
+{
+     int sideSize[3] = {0, 0, 0}, i, best, done;
+
+     for (i = 0; i < numPieces; i++)
+          pieceSide[i] = 0;
+
+     // There are only a handful of pieces other than the components,
+     // so selection of the next largest piece is adequate
+     for (done = 0; done < numPieces; done++)
+     {
+          best = -1;
+          for (i = 0; i < numPieces; i++)
+               if (pieceSide[i] == 0 && (best < 0 || pieceSize[i] > pieceSize[best]))
+                   best = i;
+
+          pieceSide[best] = sideSize[1] <= sideSize[2] ? 1 : 2;
+          sideSize[pieceSide[best]] += pieceSize[best];
+     }
+}
+
+/********************************************************************
+ _RS_Separate()
+
+ Finds a separator of the planar rotation system rs by the method of
+ Lipton and Tarjan, "A Separator Theorem for Planar Graphs", SIAM J.
+ Appl. Math. 36(2), 1979.  On return, side[v] is 0 for the separator
+ vertices and 1 or 2 for the vertices of the two sides, each having at
+ most 2n/3 vertices, with no edge between sides 1 and 2.  The separator
+ has at most 2*sqrt(2)*sqrt(n) + O(1) vertices.
+
+ If no connected component has more than 2n/3 vertices, the components
+ are grouped into two sides and the separator is empty.  Otherwise, the
+ large component K is partitioned into the levels of a breadth first
+ search.  The level l1 contains the median vertex, and levels l0 <= l1
+ and l2 > l1 are chosen to minimize the sizes of the levels plus twice
+ their distances from l1, so that levels l0 and l2 together with a
+ cycle through the middle levels are small.  If the middle levels
+ strictly between l0 and l2 have at most 2n/3 vertices, levels l0 and l2
+ are the separator.  Otherwise, the middle levels are split by a cycle
+ in _RS_SplitByCycle().
+
+ Returns OK on success, NOTOK on allocation failure or if rs is not a
+         planar rotation system
+ ********************************************************************/
+
+int  _RS_Separate(rotationSystemP rs, int *side)
+{
+     int n = rs->n, numComps = 0, numPieces, head, tail, big;
+     int *order=NULL, *level=NULL, *parentDart=NULL, *comp=NULL, *pieceOf=NULL;
+     int *compFirst=NULL, *pieceSize=NULL, *pieceSide=NULL, *levelCount=NULL;
+     int v, w, d, c, i, l, l0, l1, l2, cost, bestCost, cum, nK, r, Result = OK;
+     int middle, above, inside;
+
+     // One or two vertices need a separator vertex only if adjacent
+     if (n <= 2)
+     {
+         for (v = 0; v < n; v++)
+              side[v] = v + 1;
+         if (n == 2 && rs->numDarts > 0)
+             side[1] = 0;
+         return OK;
+     }
+
+     if ((order = (int *) malloc(n * sizeof(int))) == NULL ||
+         (level = (int *) malloc(n * sizeof(int))) == NULL ||
+         (parentDart = (int *) malloc(n * sizeof(int))) == NULL ||
+         (comp = (int *) malloc(n * sizeof(int))) == NULL ||
+         (pieceOf = (int *) malloc(n * sizeof(int))) == NULL ||
+         (compFirst = (int *) malloc((n+1) * sizeof(int))) == NULL ||
+         (pieceSize = (int *) malloc((n+4) * sizeof(int))) == NULL ||
+         (pieceSide = (int *) malloc((n+4) * sizeof(int))) == NULL ||
+         (levelCount = (int *) malloc((n+2) * sizeof(int))) == NULL)
+         Result = NOTOK;
+
+     // Find the connected components by breadth first search, which also
+     // gives the levels of each component from its first vertex
+     if (Result == OK)
+     {
+         for (v = 0; v < n; v++)
+              comp[v] = -1;
+
+         head = tail = 0;
+         for (v = 0; v < n; v++)
+         {
+              if (comp[v] >= 0)
+                  continue;
+
+              compFirst[numComps] = tail;
+              comp[v] = numComps;
+              level[v] = 0;
+              parentDart[v] = -1;
+              order[tail++] = v;
+              while (head < tail)
+              {
+                   w = order[head++];
+                   for (d = rs->dartStart[w]; d < rs->dartStart[w+1]; d++)
+                   {
+                        if (comp[rs->dartHead[d]] < 0)
+                        {
+                            comp[rs->dartHead[d]] = numComps;
+                            level[rs->dartHead[d]] = level[w] + 1;
+                            parentDart[rs->dartHead[d]] = d;
+                            order[tail++] = rs->dartHead[d];
+                        }
+                   }
+              }
+              numComps++;
+         }
+         compFirst[numComps] = n;
+
+         // Each component is a piece, except that the largest may be split
+         big = 0;
+         for (c = 0; c < numComps; c++)
+         {
+              pieceSize[c] = compFirst[c+1] - compFirst[c];
+              if (pieceSize[c] > pieceSize[big])
+                  big = c;
+         }
+         for (v = 0; v < n; v++)
+              pieceOf[v] = comp[v];
+         numPieces = numComps;
+     }
+
+     // Split the largest component if it has more than 2n/3 vertices
+     if (Result == OK && 3 * (nK = pieceSize[big]) > 2 * n)
+     {
+         int *K = order + compFirst[big];
+
+         r = level[K[nK-1]];
+         for (l = 0; l <= r+1; l++)
+              levelCount[l] = 0;
+         for (i = 0; i < nK; i++)
+              levelCount[level[K[i]]]++;
+
+         // Level l1 contains the median vertex of K
+         for (cum = 0, l1 = 0; 2 * (cum += levelCount[l1]) < nK; l1++)
+              ;
+
+         // Level l0 = -1 and level l2 = r+1 are empty
+         bestCost = n + 1;
+         for (l = l1, l0 = -1; l >= -1; l--)
+         {
+              cost = (l >= 0 ? levelCount[l] : 0) + 2*(l1 - l);
+              if (cost < bestCost)
+              {
+                  bestCost = cost;
+                  l0 = l;
+              }
+         }
+
+         bestCost = n + 1;
+         for (l = l1+1, l2 = r+1; l <= r+1; l++)
+         {
+              cost = levelCount[l] + 2*(l - l1 - 1);
+              if (cost < bestCost)
+              {
+                  bestCost = cost;
+                  l2 = l;
+              }
+         }
+
+         // The pieces of K are the levels below l0, which reuse the piece
+         // of K, and the levels between l0 and l2 and above l2.  Levels l0
+         // and l2 are separator vertices.
+         middle = numComps;
+         above = numComps + 1;
+         inside = numComps + 2;
+         numPieces = numComps + 2;
+         pieceSize[big] = pieceSize[middle] = pieceSize[above] = pieceSize[inside] = 0;
+         for (i = 0; i < nK; i++)
+         {
+              v = K[i];
+              if (level[v] == l0 || level[v] == l2)
+                  pieceOf[v] = -1;
+              else
+              {
+                  pieceOf[v] = level[v] < l0 ? big : (level[v] < l2 ? middle : above);
+                  pieceSize[pieceOf[v]]++;
+              }
+         }
+
+         // If the middle levels are too large, split them with a cycle
+         if (3 * pieceSize[middle] > 2 * n)
+         {
+             numPieces = numComps + 3;
+             if (_RS_SplitByCycle(rs, K, nK, parentDart, pieceOf, middle, inside) != OK)
+                 Result = NOTOK;
+             else
+             {
+                 pieceSize[middle] = pieceSize[inside] = 0;
+                 for (i = 0; i < nK; i++)
+                      if (pieceOf[K[i]] == middle || pieceOf[K[i]] == inside)
+                          pieceSize[pieceOf[K[i]]]++;
+             }
+         }
+     }
+
+     // Group the pieces into two sides
+     if (Result == OK)
+     {
+         _GroupPieces(numPieces, pieceSize, pieceSide);
+         for (v = 0; v < n; v++)
+              side[v] = pieceOf[v] < 0 ? 0 : pieceSide[pieceOf[v]];
+     }
+
+     free(order);
+     free(level);
+     free(parentDart);
+     free(comp);
+     free(pieceOf);
+     free(compFirst);
+     free(pieceSize);
+     free(pieceSide);
+     free(levelCount);
+
+     return Result;
+}
+
+/********************************************************************
+ _RS_SplitByCycle()
+
+ Splits the middle levels of the connected component K of rs, whose
+ vertices are given in breadth first order by K[0..nK-1] with the tree
+ arcs in parentDart, using a fundamental cycle of the breadth first
+ search tree in a triangulation of K.
+
+ The middle vertices have pieceOf[v] == midPiece, and they have weight
+ one; the other vertices of K have weight zero.  Each face of K other
+ than a triangle is triangulated by a new center vertex joined to each
+ position of the face walk, which adds no edges between vertices of K,
+ and each center vertex becomes a leaf of the tree.  By the lemma of
+ Lipton and Tarjan, some non-tree edge has a fundamental cycle with at
+ most 2/3 of the weight strictly inside and at most 2/3 strictly
+ outside.  Since the tree paths descend one level per edge, the cycle
+ has at most two vertices in each middle level.
+
+ The edges not in the tree are dual to a spanning tree of the triangles,
+ rooted at a triangle incident to the root of K, so the triangles inside
+ the cycle of a non-tree edge are the subtree below its dual edge.  If
+ each tree edge charges the weight of its child vertex to both of its
+ triangles, then the subtree total is twice the weight inside the cycle
+ plus the weight of the cycle vertices other than the least common
+ ancestor of the edge's endpoints.  The latter is obtained from the root
+ path weights and the least common ancestors, which are found for all
+ non-tree edges at once by Tarjan's offline method.
+
+ On return, the middle vertices on the chosen cycle have pieceOf[v] set
+ to -1, the middle vertices inside it have pieceOf[v] set to inPiece,
+ and those outside it keep midPiece.
+
+ Returns OK on success, NOTOK on allocation failure or if rs is not a
+         planar rotation system
+ ********************************************************************/
+
+int  _RS_SplitByCycle(rotationSystemP rs, int *K, int nK, int *parentDart,
+                      int *pieceOf, int midPiece, int inPiece)
+{
+     int n = rs->n, D = rs->numDarts, Result = OK;
+     int *dartTail=NULL, *dartFace=NULL, *faceStart=NULL, *faceDarts=NULL, *triBase=NULL;
+     int *dartTri=NULL, *triFace=NULL, *edgeTriA=NULL, *edgeTriB=NULL;
+     int *ntEdge=NULL, *ntX=NULL, *ntY=NULL, *lca=NULL;
+     int *tpar=NULL, *pathWeight=NULL, *childStart=NULL, *childList=NULL;
+     int *qStart=NULL, *qList=NULL, *ufp=NULL, *anc=NULL, *stk=NULL, *iter=NULL;
+     int *sub=NULL, *triParentEdge=NULL, *triOrder=NULL;
+     char *isTree=NULL, *finished=NULL;
+     int numFaces = 0, numTri = 0, numNT = 0, numV = 0, Wtotal = 0;
+     int s = K[0], v, w, d, e, f, p, j, t, u, i, len, x, y, z, top, head, tail;
+     int sides[3], k, best = -1, bestCost = 0, cost, wc, wi, wo, child, bestChild = -1;
+
+     if ((dartTail = (int *) malloc((D+1) * sizeof(int))) == NULL ||
+         (dartFace = (int *) malloc((D+1) * sizeof(int))) == NULL ||
+         (faceStart = (int *) malloc((D+2) * sizeof(int))) == NULL ||
+         (faceDarts = (int *) malloc((D+1) * sizeof(int))) == NULL ||
+         (triBase = (int *) malloc((D+2) * sizeof(int))) == NULL ||
+         (dartTri = (int *) malloc((D+1) * sizeof(int))) == NULL ||
+         (triFace = (int *) malloc((D+1) * sizeof(int))) == NULL ||
+         (edgeTriA = (int *) malloc((2*D+1) * sizeof(int))) == NULL ||
+         (edgeTriB = (int *) malloc((2*D+1) * sizeof(int))) == NULL ||
+         (ntEdge = (int *) malloc((2*D+1) * sizeof(int))) == NULL ||
+         (ntX = (int *) malloc((2*D+1) * sizeof(int))) == NULL ||
+         (ntY = (int *) malloc((2*D+1) * sizeof(int))) == NULL ||
+         (lca = (int *) malloc((2*D+1) * sizeof(int))) == NULL ||
+         (isTree = (char *) calloc(2*D+1, sizeof(char))) == NULL ||
+         (sub = (int *) malloc((D+1) * sizeof(int))) == NULL ||
+         (triParentEdge = (int *) malloc((D+1) * sizeof(int))) == NULL ||
+         (triOrder = (int *) malloc((D+1) * sizeof(int))) == NULL)
+         Result = NOTOK;
+
+     // Walk the faces of K
+     if (Result == OK)
+     {
+         for (v = 0; v < n; v++)
+              for (d = rs->dartStart[v]; d < rs->dartStart[v+1]; d++)
+              {
+                   dartTail[d] = v;
+                   dartFace[d] = -1;
+              }
+
+         p = 0;
+         for (i = 0; i < nK && Result == OK; i++)
+         {
+              for (d = rs->dartStart[K[i]]; d < rs->dartStart[K[i]+1] && Result == OK; d++)
+              {
+                   if (dartFace[d] >= 0)
+                       continue;
+
+                   faceStart[numFaces] = p;
+                   e = d;
+                   do {
+                        // A dart reached twice means the successor relation is not a permutation
+                        if (dartFace[e] >= 0)
+                        {
+                            Result = NOTOK;
+                            break;
+                        }
+                        dartFace[e] = numFaces;
+                        faceDarts[p++] = e;
+
+                        // The next dart follows the twin in the rotation of the head
+                        w = rs->dartHead[e];
+                        e = rs->dartTwin[e] + 1 < rs->dartStart[w+1] ? rs->dartTwin[e] + 1 : rs->dartStart[w];
+                   } while (e != d);
+                   numFaces++;
+              }
+         }
+         faceStart[numFaces] = p;
+     }
+
+     // Triangles: a face of length 3 is one triangle; otherwise, the dart
+     // at position j of the face walk gives triangle j of the face, whose
+     // other two sides are the star edges j and j+1 to the center vertex.
+     // Edge ids are the lesser dart of each edge of K, and D+p for the star
+     // edge to the vertex at position p of a face walk.
+     if (Result == OK)
+     {
+         for (f = 0; f < numFaces; f++)
+         {
+              len = faceStart[f+1] - faceStart[f];
+              triBase[f] = numTri;
+              for (j = 0; j < (len == 3 ? 1 : len); j++)
+                   triFace[numTri + j] = f;
+              for (p = faceStart[f]; p < faceStart[f+1]; p++)
+                   dartTri[faceDarts[p]] = len == 3 ? numTri : numTri + p - faceStart[f];
+              numTri += len == 3 ? 1 : len;
+         }
+
+         for (f = 0; f < numFaces; f++)
+         {
+              len = faceStart[f+1] - faceStart[f];
+              for (p = faceStart[f]; p < faceStart[f+1]; p++)
+              {
+                   d = faceDarts[p];
+                   if (d < rs->dartTwin[d])
+                   {
+                       edgeTriA[d] = dartTri[d];
+                       edgeTriB[d] = dartTri[rs->dartTwin[d]];
+                   }
+                   if (len != 3)
+                   {
+                       j = p - faceStart[f];
+                       edgeTriA[D+p] = triBase[f] + j;
+                       edgeTriB[D+p] = triBase[f] + (j + len - 1) % len;
+                   }
+              }
+         }
+
+         // Center vertices are numbered n+f
+         numV = n + numFaces;
+         if ((tpar = (int *) malloc(numV * sizeof(int))) == NULL ||
+             (pathWeight = (int *) malloc(numV * sizeof(int))) == NULL ||
+             (childStart = (int *) calloc(numV + 1, sizeof(int))) == NULL ||
+             (childList = (int *) malloc(numV * sizeof(int))) == NULL ||
+             (qStart = (int *) calloc(numV + 1, sizeof(int))) == NULL ||
+             (qList = (int *) malloc((4*D+1) * sizeof(int))) == NULL ||
+             (ufp = (int *) malloc(numV * sizeof(int))) == NULL ||
+             (anc = (int *) malloc(numV * sizeof(int))) == NULL ||
+             (stk = (int *) malloc(numV * sizeof(int))) == NULL ||
+             (iter = (int *) malloc(numV * sizeof(int))) == NULL ||
+             (finished = (char *) calloc(numV, sizeof(char))) == NULL)
+             Result = NOTOK;
+     }
+
+     // The tree is the breadth first search tree of K, plus the star edge
+     // at the start of each face walk for each center vertex.  The path
+     // weight of a vertex is the weight of its path to the root, and each
+     // tree edge charges the weight of its child to both its triangles.
+     if (Result == OK)
+     {
+         for (t = 0; t < numTri; t++)
+              sub[t] = 0;
+
+         for (i = 0; i < nK; i++)
+         {
+              v = K[i];
+              w = pieceOf[v] == midPiece ? 1 : 0;
+              Wtotal += w;
+              if (v == s)
+              {
+                  tpar[v] = -1;
+                  pathWeight[v] = w;
+              }
+              else
+              {
+                  d = parentDart[v];
+                  e = d < rs->dartTwin[d] ? d : rs->dartTwin[d];
+                  tpar[v] = dartTail[d];
+                  pathWeight[v] = pathWeight[tpar[v]] + w;
+                  isTree[e] = 1;
+                  sub[edgeTriA[e]] += w;
+                  sub[edgeTriB[e]] += w;
+              }
+         }
+
+         for (f = 0; f < numFaces; f++)
+         {
+              if (faceStart[f+1] - faceStart[f] != 3)
+              {
+                  tpar[n+f] = dartTail[faceDarts[faceStart[f]]];
+                  pathWeight[n+f] = pathWeight[tpar[n+f]];
+                  isTree[D + faceStart[f]] = 1;
+              }
+         }
+     }
+
+     // Find the dual spanning tree of the triangles by breadth first search
+     // across the non-tree edges, from a triangle incident to the root, and
+     // accumulate the charges of each dual subtree
+     if (Result == OK)
+     {
+         for (t = 0; t < numTri; t++)
+              triParentEdge[t] = -2;
+
+         t = dartTri[rs->dartStart[s]];
+         triParentEdge[t] = -1;
+         triOrder[0] = t;
+         head = 0; tail = 1;
+         while (head < tail)
+         {
+              t = triOrder[head++];
+              f = triFace[t];
+              len = faceStart[f+1] - faceStart[f];
+              j = len == 3 ? 0 : t - triBase[f];
+              for (k = 0; k < (len == 3 ? 3 : 1); k++)
+              {
+                   d = faceDarts[faceStart[f] + j + k];
+                   sides[k] = d < rs->dartTwin[d] ? d : rs->dartTwin[d];
+              }
+              if (len != 3)
+              {
+                  sides[1] = D + faceStart[f] + j;
+                  sides[2] = D + faceStart[f] + (j + 1) % len;
+              }
+
+              for (k = 0; k < 3; k++)
+              {
+                   e = sides[k];
+                   u = edgeTriA[e] == t ? edgeTriB[e] : edgeTriA[e];
+                   if (!isTree[e] && triParentEdge[u] == -2)
+                   {
+                       triParentEdge[u] = e;
+                       triOrder[tail++] = u;
+                   }
+              }
+         }
+
+         if (tail != numTri)
+             Result = NOTOK;
+         else
+         {
+             for (i = numTri-1; i > 0; i--)
+             {
+                  t = triOrder[i];
+                  e = triParentEdge[t];
+                  u = edgeTriA[e] == t ? edgeTriB[e] : edgeTriA[e];
+                  sub[u] += sub[t];
+             }
+         }
+     }
+
+     // List the non-tree edges with their endpoints, which are the queries
+     // for the least common ancestors, and list the children of each vertex
+     if (Result == OK)
+     {
+         for (i = 0; i < nK; i++)
+         {
+              for (d = rs->dartStart[K[i]]; d < rs->dartStart[K[i]+1]; d++)
+              {
+                   if (d < rs->dartTwin[d] && !isTree[d])
+                   {
+                       ntEdge[numNT] = d;
+                       ntX[numNT] = dartTail[d];
+                       ntY[numNT++] = rs->dartHead[d];
+                   }
+              }
+         }
+         for (f = 0; f < numFaces; f++)
+         {
+              if (faceStart[f+1] - faceStart[f] != 3)
+              {
+                  for (p = faceStart[f] + 1; p < faceStart[f+1]; p++)
+                  {
+                       ntEdge[numNT] = D + p;
+                       ntX[numNT] = n + f;
+                       ntY[numNT++] = dartTail[faceDarts[p]];
+                  }
+              }
+         }
+
+         for (i = 0; i < numNT; i++)
+         {
+              qStart[ntX[i]+1]++;
+              qStart[ntY[i]+1]++;
+         }
+         for (v = 0; v < numV; v++)
+              qStart[v+1] += qStart[v];
+         for (i = 0; i < numNT; i++)
+         {
+              qList[qStart[ntX[i]]++] = i;
+              qList[qStart[ntY[i]]++] = i;
+         }
+         for (v = numV; v > 0; v--)
+              qStart[v] = qStart[v-1];
+         qStart[0] = 0;
+
+         for (i = 1; i < nK; i++)
+              childStart[tpar[K[i]] + 1]++;
+         for (f = 0; f < numFaces; f++)
+              if (faceStart[f+1] - faceStart[f] != 3)
+                  childStart[tpar[n+f] + 1]++;
+         for (v = 0; v < numV; v++)
+              childStart[v+1] += childStart[v];
+         for (i = 1; i < nK; i++)
+              childList[childStart[tpar[K[i]]]++] = K[i];
+         for (f = 0; f < numFaces; f++)
+              if (faceStart[f+1] - faceStart[f] != 3)
+                  childList[childStart[tpar[n+f]]++] = n+f;
+         for (v = numV; v > 0; v--)
+              childStart[v] = childStart[v-1];
+         childStart[0] = 0;
+     }
+
+     // Tarjan's offline least common ancestors, by an iterative depth
+     // first search of the tree.  When a vertex finishes, each query whose
+     // other endpoint has already finished is answered, and then the
+     // vertex is united with its parent.
+     if (Result == OK)
+     {
+         top = 0;
+         stk[top++] = s;
+         ufp[s] = anc[s] = s;
+         iter[s] = childStart[s];
+         while (top > 0)
+         {
+              v = stk[top-1];
+              if (iter[v] < childStart[v+1])
+              {
+                  w = childList[iter[v]++];
+                  ufp[w] = anc[w] = w;
+                  iter[w] = childStart[w];
+                  stk[top++] = w;
+                  continue;
+              }
+
+              top--;
+              finished[v] = 1;
+              for (i = qStart[v]; i < qStart[v+1]; i++)
+              {
+                   w = ntX[qList[i]] == v ? ntY[qList[i]] : ntX[qList[i]];
+                   if (finished[w])
+                   {
+                       for (z = w; ufp[z] != z; z = ufp[z])
+                            ufp[z] = ufp[ufp[z]];
+                       lca[qList[i]] = anc[z];
+                   }
+              }
+
+              if (top > 0)
+              {
+                  for (x = v; ufp[x] != x; x = ufp[x])
+                       ufp[x] = ufp[ufp[x]];
+                  for (y = stk[top-1]; ufp[y] != y; y = ufp[y])
+                       ufp[y] = ufp[ufp[y]];
+                  ufp[x] = y;
+                  anc[y] = stk[top-1];
+              }
+         }
+     }
+
+     // Choose the non-tree edge whose cycle best balances the weight.  The
+     // dual subtree below the edge holds twice the weight inside the cycle
+     // plus the weight of the cycle other than the least common ancestor.
+     if (Result == OK)
+     {
+         for (i = 0; i < numNT && Result == OK; i++)
+         {
+              e = ntEdge[i];
+              z = lca[i];
+              child = triParentEdge[edgeTriA[e]] == e ? edgeTriA[e] : edgeTriB[e];
+              wc = pathWeight[ntX[i]] + pathWeight[ntY[i]] - 2*pathWeight[z];
+              if (sub[child] < wc || ((sub[child] - wc) & 1))
+                  Result = NOTOK;
+
+              wi = (sub[child] - wc) / 2;
+              wo = Wtotal - wi - wc - (z < n && pieceOf[z] == midPiece ? 1 : 0);
+              cost = wi > wo ? wi : wo;
+              if (best < 0 || cost < bestCost)
+              {
+                  best = i;
+                  bestCost = cost;
+                  bestChild = child;
+              }
+         }
+
+         if (best < 0)
+             Result = NOTOK;
+     }
+
+     // Mark the triangles inside the cycle, which form the dual subtree
+     // below the chosen edge, reusing sub[] for the marks
+     if (Result == OK)
+     {
+         for (t = 0; t < numTri; t++)
+              sub[t] = 0;
+         sub[bestChild] = 1;
+         triOrder[0] = bestChild;
+         head = 0; tail = 1;
+         while (head < tail)
+         {
+              t = triOrder[head++];
+              f = triFace[t];
+              len = faceStart[f+1] - faceStart[f];
+              j = len == 3 ? 0 : t - triBase[f];
+              for (k = 0; k < (len == 3 ? 3 : 1); k++)
+              {
+                   d = faceDarts[faceStart[f] + j + k];
+                   sides[k] = d < rs->dartTwin[d] ? d : rs->dartTwin[d];
+              }
+              if (len != 3)
+              {
+                  sides[1] = D + faceStart[f] + j;
+                  sides[2] = D + faceStart[f] + (j + 1) % len;
+              }
+
+              for (k = 0; k < 3; k++)
+              {
+                   e = sides[k];
+                   u = edgeTriA[e] == t ? edgeTriB[e] : edgeTriA[e];
+                   if (!isTree[e] && e != ntEdge[best] && !sub[u])
+                   {
+                       sub[u] = 1;
+                       triOrder[tail++] = u;
+                   }
+              }
+         }
+
+         // The middle vertices on the cycle are separator vertices
+         z = lca[best];
+         for (v = ntX[best]; v != z; v = tpar[v])
+              if (v < n && pieceOf[v] == midPiece)
+                  pieceOf[v] = -1;
+         for (v = ntY[best]; v != z; v = tpar[v])
+              if (v < n && pieceOf[v] == midPiece)
+                  pieceOf[v] = -1;
+         if (z < n && pieceOf[z] == midPiece)
+             pieceOf[z] = -1;
+
+         // Each other middle vertex is inside if its triangles are
+         for (i = 0; i < nK; i++)
+         {
+              v = K[i];
+              if (pieceOf[v] == midPiece && sub[dartTri[rs->dartStart[v]]])
+                  pieceOf[v] = inPiece;
+         }
+     }
+
+     free(dartTail); free(dartFace); free(faceStart); free(faceDarts); free(triBase);
+     free(dartTri); free(triFace); free(edgeTriA); free(edgeTriB);
+     free(ntEdge); free(ntX); free(ntY); free(lca);
+     free(tpar); free(pathWeight); free(childStart); free(childList);
+     free(qStart); free(qList); free(ufp); free(anc); free(stk); free(iter);
+     free(sub); free(triParentEdge); free(triOrder); free(isTree); free(finished);
+
+     return Result;
+}
+
+/********************************************************************
+ _RS_Bisect()
+
+ Divides the vertices of rs into sides 1 and 2, holding about
+ numerator/denominator and the rest of the non-separator vertices, with
+ separator vertices given side 0.  The separator of Lipton and Tarjan is
+ applied repeatedly to the remaining vertices.  Of its two sides, the
+ larger goes to the side with the larger deficit if it fits there, and
+ the smaller is kept for further separation; otherwise, the smaller
+ goes to that side, where it always fits, and the larger is kept.  Each
+ round keeps at most 2/3 of the vertices, so the total separator size
+ is O(sqrt(n)) and the total time is O(n).
+
+ Returns OK on success, NOTOK on failure
+ ********************************************************************/
+
+int  _RS_Bisect(rotationSystemP rs, int numerator, int denominator, int *side)
+{
+     rotationSystemP R = rs, next;
+     int *rsId=NULL, *nextRsId=NULL, *subSide=NULL, *newId=NULL, *swap;
+     int count[3], assigned[3] = {0, 0, 0}, numSeparator = 0;
+     int v, s1, big, give, keep, newN, Result = OK;
+     long total, deficit[3];
+
+     if ((rsId = (int *) malloc((rs->n+1) * sizeof(int))) == NULL ||
+         (nextRsId = (int *) malloc((rs->n+1) * sizeof(int))) == NULL ||
+         (subSide = (int *) malloc((rs->n+1) * sizeof(int))) == NULL ||
+         (newId = (int *) malloc((rs->n+1) * sizeof(int))) == NULL)
+         Result = NOTOK;
+
+     if (Result == OK)
+     {
+         for (v = 0; v < rs->n; v++)
+              rsId[v] = v;
+     }
+
+     while (Result == OK && R->n > 0)
+     {
+          if (_RS_Separate(R, subSide) != OK)
+          {
+              Result = NOTOK;
+              break;
+          }
+
+          count[0] = count[1] = count[2] = 0;
+          for (v = 0; v < R->n; v++)
+          {
+               count[subSide[v]]++;
+               if (subSide[v] == 0)
+                   side[rsId[v]] = 0;
+          }
+          numSeparator += count[0];
+
+          // The deficits of the two sides sum to the vertices remaining
+          total = rs->n - numSeparator;
+          deficit[1] = total * numerator / denominator - assigned[1];
+          deficit[2] = total - total * numerator / denominator - assigned[2];
+          s1 = deficit[1] >= deficit[2] ? 1 : 2;
+
+          big = count[1] >= count[2] ? 1 : 2;
+          if (count[big] <= deficit[s1])
+              give = big;
+          else give = 3 - big;
+          keep = 3 - give;
+
+          // If the other side needs no more vertices, the rest go to side s1
+          if (deficit[3 - s1] <= 0)
+              give = keep = -1;
+
+          newN = 0;
+          for (v = 0; v < R->n; v++)
+          {
+               newId[v] = -1;
+               if (subSide[v] == 0)
+                   continue;
+               if (keep < 0 || subSide[v] == give)
+               {
+                   side[rsId[v]] = s1;
+                   assigned[s1]++;
+               }
+               else
+               {
+                   nextRsId[newN] = rsId[v];
+                   newId[v] = newN++;
+               }
+          }
+
+          // Continue with the kept vertices
+          next = NULL;
+          if (newN > 0 && (next = _RS_Induced(R, newId, newN)) == NULL)
+              Result = NOTOK;
+
+          if (R != rs)
+              _RS_Free(&R);
+          R = next;
+          swap = rsId; rsId = nextRsId; nextRsId = swap;
+
+          if (R == NULL)
+              break;
+     }
+
+     if (R != rs)
+         _RS_Free(&R);
+
+     free(rsId);
+     free(nextRsId);
+     free(subSide);
+     free(newId);
+     return Result;
+}
+
+/********************************************************************
+ _AssignSeparatorVertices()
+
+ Gives each vertex with vertexPart[v] < 0 the part of one of its
+ neighbors, in breadth first order from the vertices already assigned,
+ choosing the neighboring part with the fewest vertices.  Vertices with
+ no path to an assigned vertex go to the part with the fewest vertices.
+
+ Returns OK on success, NOTOK on allocation failure
+ ********************************************************************/
+
+int  _AssignSeparatorVertices(graphP theGraph, int numParts, int *vertexPart)
+{
+     int *partSize, *queue, head = 0, tail = 0, v, w, e, best, i;
+     char *queued;
+
+     partSize = (int *) calloc(numParts, sizeof(int));
+     queue = (int *) malloc((theGraph->N+1) * sizeof(int));
+     queued = (char *) calloc(theGraph->N+1, sizeof(char));
+     if (partSize == NULL || queue == NULL || queued == NULL)
+     {
+         free(partSize);
+         free(queue);
+         free(queued);
+         return NOTOK;
+     }
+
+     for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
+          if (vertexPart[v] >= 0)
+              partSize[vertexPart[v]]++;
+
+     for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
+     {
+          if (vertexPart[v] >= 0)
+              continue;
+          for (e = gp_GetFirstArc(theGraph, v); gp_IsArc(e); e = gp_GetNextArc(theGraph, e))
+          {
+               if (vertexPart[gp_GetNeighbor(theGraph, e)] >= 0)
+               {
+                   queue[tail++] = v;
+                   queued[v] = 1;
+                   break;
+               }
+          }
+     }
+
+     while (head < tail)
+     {
+          v = queue[head++];
+          best = -1;
+          for (e = gp_GetFirstArc(theGraph, v); gp_IsArc(e); e = gp_GetNextArc(theGraph, e))
+          {
+               w = gp_GetNeighbor(theGraph, e);
+               if (vertexPart[w] >= 0)
+               {
+                   if (best < 0 || partSize[vertexPart[w]] < partSize[best])
+                       best = vertexPart[w];
+               }
+               else if (!queued[w])
+               {
+                   queue[tail++] = w;
+                   queued[w] = 1;
+               }
+          }
+          vertexPart[v] = best;
+          partSize[best]++;
+     }
+
+     for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
+     {
+          if (vertexPart[v] < 0)
+          {
+              for (best = 0, i = 1; i < numParts; i++)
+                   if (partSize[i] < partSize[best])
+                       best = i;
+              vertexPart[v] = best;
+              partSize[best]++;
+          }
+     }
+
+     free(partSize);
+     free(queue);
+     free(queued);
+     return OK;
+}
+
+/********************************************************************
+ gp_PlanarSeparator()
+
+ Finds a separator of a planar graph with O(sqrt(n)) vertices whose
+ removal leaves no connected component with more than 2n/3 vertices, by
+ the method of Lipton and Tarjan.  theGraph must hold a planar embedding,
+ such as the one obtained when gp_Embed() returns OK, and it is not
+ modified, so the vertices may be in DFI order or, after gp_SortVertices(),
+ in their original order.
+
+ On success, vertexSide[v] is 0 for each separator vertex v, and 1 or 2
+ for the vertices of the two sides, which have no edges between them and
+ at most 2n/3 vertices each.  The array is indexed by vertex, so it must
+ have at least N+1 entries.
+
+ The time and space are linear in the size of the graph.
+
+ Returns OK on success, NOTOK on allocation failure or if theGraph does
+         not hold a planar embedding
+ ********************************************************************/
+
+int  gp_PlanarSeparator(graphP theGraph, int *vertexSide)
+{
+     rotationSystemP rs;
+     int *side, v, Result;
+
+     if (theGraph == NULL || vertexSide == NULL || theGraph->N == 0)
+         return NOTOK;
+
+     if ((rs = _RS_FromGraph(theGraph)) == NULL)
+         return NOTOK;
+
+     if ((side = (int *) malloc((rs->n+1) * sizeof(int))) == NULL)
+         Result = NOTOK;
+     else Result = _RS_Separate(rs, side);
+
+     if (Result == OK)
+     {
+         for (v = 0; v < rs->n; v++)
+              vertexSide[rs->vertex[v]] = side[v];
+     }
+
+     free(side);
+     _RS_Free(&rs);
+     return Result;
+}
+
+/********************************************************************
+ _SplitUnit()
+
+ Bisects the unit of work in proportion to the number of parts on each
+ side, k/2 and k-k/2 for k parts, giving the units of work unitA and
+ unitB, and adds the number of separator vertices to *pNumSeparator.
+ The rotation system of the unit is freed, and unitA may be the unit.
+ The side, newIdA and newIdB arrays must have an entry for each vertex
+ of the unit.
+
+ Returns OK on success, NOTOK on failure
+ ********************************************************************/
+
+int  _SplitUnit(partitionUnit *unit, partitionUnit *unitA, partitionUnit *unitB,
+                int *side, int *newIdA, int *newIdB, int *pNumSeparator)
+{
+     rotationSystemP R = unit->R;
+     int k = unit->numParts, first = unit->firstPart, v, nA = 0, nB = 0;
+
+     unit->R = unitA->R = unitB->R = NULL;
+
+     if (_RS_Bisect(R, k/2, k, side) != OK)
+     {
+         _RS_Free(&R);
+         return NOTOK;
+     }
+
+     for (v = 0; v < R->n; v++)
+     {
+          newIdA[v] = side[v] == 1 ? nA++ : -1;
+          newIdB[v] = side[v] == 2 ? nB++ : -1;
+          if (side[v] == 0)
+              (*pNumSeparator)++;
+     }
+
+     unitA->R = _RS_Induced(R, newIdA, nA);
+     unitA->numParts = k/2;
+     unitA->firstPart = first;
+     unitB->R = _RS_Induced(R, newIdB, nB);
+     unitB->numParts = k - k/2;
+     unitB->firstPart = first + k/2;
+     _RS_Free(&R);
+
+     if (unitA->R == NULL || unitB->R == NULL)
+     {
+         _RS_Free(&unitA->R);
+         _RS_Free(&unitB->R);
+         return NOTOK;
+     }
+
+     return OK;
+}
+
+/********************************************************************
+ _PartitionUnit()
+
+ Partitions the vertices of the unit of work into its parts by
+ recursive bisection, over an explicit stack of units of work, and adds
+ the number of separator vertices found to *pNumSeparator.  The
+ separator vertices are left with part -1.  The rotation system of the
+ unit is freed.
+
+ Returns OK on success, NOTOK on failure
+ ********************************************************************/
+
+int  _PartitionUnit(partitionUnit *unit, int *vertexPart, int *pNumSeparator)
+{
+     partitionUnit *stack = NULL, U;
+     int *side = NULL, *newIdA = NULL, *newIdB = NULL;
+     int n = unit->R->n, top = 0, v, Result = OK;
+
+     // Each bisection replaces a unit of work by at most two, and the
+     // one with fewer parts is done first, so numParts entries suffice
+     if ((stack = (partitionUnit *) malloc((unit->numParts+1) * sizeof(partitionUnit))) == NULL ||
+         (side = (int *) malloc((n+1) * sizeof(int))) == NULL ||
+         (newIdA = (int *) malloc((n+1) * sizeof(int))) == NULL ||
+         (newIdB = (int *) malloc((n+1) * sizeof(int))) == NULL)
+     {
+         Result = NOTOK;
+         _RS_Free(&unit->R);
+     }
+     else
+     {
+         stack[top++] = *unit;
+         unit->R = NULL;
+     }
+
+     while (top > 0)
+     {
+          U = stack[--top];
+
+          if (Result != OK)
+          {
+              _RS_Free(&U.R);
+              continue;
+          }
+
+          if (U.numParts == 1 || U.R->n == 0)
+          {
+              for (v = 0; v < U.R->n; v++)
+                   vertexPart[U.R->vertex[v]] = U.firstPart;
+              _RS_Free(&U.R);
+              continue;
+          }
+
+          if (_SplitUnit(&U, &stack[top+1], &stack[top], side, newIdA, newIdB, pNumSeparator) != OK)
+              Result = NOTOK;
+          else top += 2;
+     }
+
+     free(stack);
+     free(side);
+     free(newIdA);
+     free(newIdB);
+
+     return Result;
+}
+
+/********************************************************************
+ _PartitionUnits()
+
+ Takes units of work from the queue and partitions them until none are
+ left or a thread fails, which stops all threads.
+ ********************************************************************/
+
+void _PartitionUnits(partitionThread *thread)
+{
+     partitionQueue *queue = thread->queue;
+     int i;
+
+     while (!platform_AtomicGet(queue->stop) &&
+            (i = platform_AtomicIncrement(queue->nextUnit)) < queue->numUnits)
+     {
+          if (_PartitionUnit(&queue->units[i], queue->vertexPart, &thread->numSeparator) != OK)
+          {
+              thread->Result = NOTOK;
+              platform_AtomicSet(queue->stop, 1);
+          }
+     }
+}
+
+/********************************************************************
+ _PartitionUnitsThread()
+
+ The thread function for the threads started by gp_PlanarPartition()
+ ********************************************************************/
+
+platform_ThreadReturn _PartitionUnitsThread(void *thread)
+{
+     _PartitionUnits((partitionThread *) thread);
+     return platform_ThreadReturnValue;
+}
+
+/********************************************************************
+ gp_PlanarPartition()
+
+ Partitions the vertices of a planar graph into numParts parts of nearly
+ equal size by recursive bisection with planar separators.  theGraph
+ must hold a planar embedding as for gp_PlanarSeparator(), and it is not
+ modified.
+
+ Each bisection divides the vertices of a subgraph in proportion to the
+ number of parts on each side, k/2 and k-k/2 for k parts, so the parts
+ are balanced up to the separator vertices, which are removed from the
+ subgraphs that are bisected further.  Each bisection is a unit of work
+ with its own rotation system of its induced subgraph, so the pending
+ units of work are independent of one another.  The largest units are
+ bisected until there is one for each of numThreads threads, or for one
+ thread per processor if numThreads is not positive, and the threads
+ then take the units and bisect them further.  The result does not
+ depend on the number of threads.  Finally, each separator vertex joins
+ the smallest part among those of its neighbors.
+
+ On success, vertexPart[v] is the part of vertex v, from 0 to numParts-1,
+ with the array indexed by vertex as for gp_PlanarSeparator(), and
+ if pNumSeparatorVertices is not NULL, then it receives the total number
+ of separator vertices found by all of the bisections.
+
+ Returns OK on success, NOTOK on allocation failure, if numParts < 1 or if
+         theGraph does not hold a planar embedding
+ ********************************************************************/
+
+int  gp_PlanarPartition(graphP theGraph, int numParts, int *vertexPart, int *pNumSeparatorVertices, int numThreads)
+{
+     partitionQueue queue;
+     partitionThread *threads = NULL;
+     platform_thread *threadHandles = NULL;
+     int *threadStarted = NULL, *side = NULL, *newIdA = NULL, *newIdB = NULL;
+     int i, t, big, v, numSeparator = 0, Result = OK;
+
+     if (theGraph == NULL || vertexPart == NULL || numParts < 1 || theGraph->N == 0)
+         return NOTOK;
+
+     if (numThreads <= 0)
+         numThreads = platform_GetNumProcessors();
+     if (numThreads > numParts)
+         numThreads = numParts;
+     if (numThreads < 1)
+         numThreads = 1;
+
+     memset(&queue, 0, sizeof(partitionQueue));
+     queue.vertexPart = vertexPart;
+
+     for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
+          vertexPart[v] = -1;
+
+     // Each unit of work has at least one part, so numParts units suffice
+     if ((queue.units = (partitionUnit *) calloc(numParts, sizeof(partitionUnit))) == NULL ||
+         (threads = (partitionThread *) calloc(numThreads, sizeof(partitionThread))) == NULL ||
+         (threadHandles = (platform_thread *) malloc(numThreads * sizeof(platform_thread))) == NULL ||
+         (threadStarted = (int *) calloc(numThreads, sizeof(int))) == NULL ||
+         (side = (int *) malloc((theGraph->N+1) * sizeof(int))) == NULL ||
+         (newIdA = (int *) malloc((theGraph->N+1) * sizeof(int))) == NULL ||
+         (newIdB = (int *) malloc((theGraph->N+1) * sizeof(int))) == NULL ||
+         (queue.units[0].R = _RS_FromGraph(theGraph)) == NULL)
+         Result = NOTOK;
+     else
+     {
+         queue.units[0].numParts = numParts;
+         queue.units[0].firstPart = 0;
+         queue.numUnits = 1;
+     }
+
+     // The largest unit with more than one part is bisected until there
+     // is a unit of work for each thread
+     while (Result == OK && queue.numUnits < numThreads)
+     {
+          big = -1;
+          for (i = 0; i < queue.numUnits; i++)
+          {
+               if (queue.units[i].numParts > 1 &&
+                   (big < 0 || queue.units[i].R->n > queue.units[big].R->n))
+                   big = i;
+          }
+
+          if (big < 0)
+              break;
+
+          Result = _SplitUnit(&queue.units[big], &queue.units[big], &queue.units[queue.numUnits],
+                              side, newIdA, newIdB, &numSeparator);
+          if (Result == OK)
+              queue.numUnits++;
+     }
+
+     if (Result == OK)
+     {
+         if (numThreads > queue.numUnits)
+             numThreads = queue.numUnits;
+
+         for (t = 0; t < numThreads; t++)
+         {
+             threads[t].queue = &queue;
+             threads[t].Result = OK;
+         }
+
+         // If a thread cannot be started, then the other threads take its units
+         for (t = 1; t < numThreads; t++)
+             threadStarted[t] = platform_StartThread(threadHandles[t], _PartitionUnitsThread, &threads[t]);
+
+         _PartitionUnits(&threads[0]);
+
+         for (t = 1; t < numThreads; t++)
+             if (threadStarted[t])
+                 platform_JoinThread(threadHandles[t]);
+
+         for (t = 0; t < numThreads; t++)
+         {
+             numSeparator += threads[t].numSeparator;
+             if (threads[t].Result != OK)
+                 Result = NOTOK;
+         }
+     }
+
+     if (Result == OK)
+         Result = _AssignSeparatorVertices(theGraph, numParts, vertexPart);
+
+     if (Result == OK && pNumSeparatorVertices != NULL)
+         *pNumSeparatorVertices = numSeparator;
+
+     if (queue.units != NULL)
+     {
+         for (i = 0; i < queue.numUnits; i++)
+              _RS_Free(&queue.units[i].R);
+         free(queue.units);
+     }
+
+     free(threads);
+     free(threadHandles);
+     free(threadStarted);
+     free(side);
+     free(newIdA);
+     free(newIdB);
+
+     return Result;
+}
@@ -0,0 +1,858 @@
+/*
+Planarity-Related Graph Algorithms Project
+Copyright (c) 1997-2012, John M. Boyer
+All rights reserved. Includes a reference implementation of the following:
+
+* John M. Boyer. "Subgraph Homeomorphism via the Edge Addition Planarity Algorithm".
+  Journal of Graph Algorithms and Applications, Vol. 16, no. 2, pp. 381-410, 2012.
+  http://www.jgaa.info/16/268.html
+
+* John M. Boyer. "A New Method for Efficiently Generating Planar Graph
+  Visibility Representations". In P. Eades and P. Healy, editors,
+  Proceedings of the 13th International Conference on Graph Drawing 2005,
+  Lecture Notes Comput. Sci., Volume 3843, pp. 508-511, Springer-Verlag, 2006.
+
+* John M. Boyer and Wendy J. Myrvold. "On the Cutting Edge: Simplified O(n)
+  Planarity by Edge Addition". Journal of Graph Algorithms and Applications,
+  Vol. 8, No. 3, pp. 241-273, 2004.
+  http://www.jgaa.info/08/91.html
+
+* John M. Boyer. "Simplified O(n) Algorithms for Planar Graph Embedding,
+  Kuratowski Subgraph Isolation, and Related Problems". Ph.D. Dissertation,
+  University of Victoria, 2001.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+  list of conditions and the following disclaimer in the documentation and/or
+  other materials provided with the distribution.
+
+* Neither the name of the Planarity-Related Graph Algorithms Project nor the names
+  of its contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdlib.h>
+
+#include "graphProjectivePlanarity.h"
+#include "graphProjectivePlanarity.private.h"
+
+#include "graph.h"
+
+/* Private functions (exported to system) */
+
+int  _TestProjectivePlanarity(graphP theGraph, ProjectivePlanarityContext *context);
+int  _CheckProjectivePlanarityResult(graphP theGraph, int expectedResult);
+
+/* Private functions */
+
+int  _ProjectivePlanarity_CreateWorkspace(ProjectivePlanarityWorkspace *ws, int N, int *edgeList, int numEdges, int numThreads);
+void _ProjectivePlanarity_FreeWorkspace(ProjectivePlanarityWorkspace *ws);
+int  _ProjectivePlanarity_NewSearch(ProjectivePlanaritySearch *search, kuratowskiBridgesP kb);
+void _ProjectivePlanarity_FreeSearch(ProjectivePlanaritySearch *search);
+
+int  _ProjectivePlanarity_Test(ProjectivePlanarityWorkspace *ws);
+int  _ProjectivePlanarity_IsolateObstruction(ProjectivePlanarityWorkspace *ws);
+int  _ProjectivePlanarity_ExtendSubgraph(ProjectivePlanarityWorkspace *ws);
+int  _ProjectivePlanarity_TryCase(void *context, int threadNumber, int k);
+
+void _ProjectivePlanarity_BuildFaces(ProjectivePlanaritySearch *search, int *faceLabels, int numFaces, int width);
+int  _ProjectivePlanarity_BridgeFitsFace(ProjectivePlanaritySearch *search, int b, int f);
+int  _ProjectivePlanarity_TestBridge(ProjectivePlanaritySearch *search, int b, int f);
+int  _ProjectivePlanarity_PlaceBridges(ProjectivePlanaritySearch *search);
+int  _ProjectivePlanarity_AssignBridge(ProjectivePlanaritySearch *search, int b, int f);
+void _ProjectivePlanarity_UndoTrail(ProjectivePlanaritySearch *search, int trailSize);
+int  _ProjectivePlanarity_Overlap(ProjectivePlanaritySearch *search, int b1, int b2, int f);
+
+int  _ProjectivePlanarity_ComparePositions(const void *p1, const void *p2);
+
+/****************************************************************************
+ The labeled embeddings of K_{3,3} and K5 in the projective plane, up to
+ equivalence.  Each embedding is given by its faces, and each face is
+ given by the cyclic sequence of the labels of the branch vertices on
+ its boundary, terminated by -1 if it is shorter than the row.  For
+ K_{3,3}, the labels 0 to 2 are on one side of the bipartition.
+
+ The embeddings were obtained by an exhaustive enumeration of rotation
+ systems and edge signatures, keeping those with Euler characteristic 1.
+ Every face of every one of these embeddings is bounded by a cycle.
+ ****************************************************************************/
+
+#define PROJECTIVEPLANARITY_NUMK33EMBEDDINGS 6
+#define PROJECTIVEPLANARITY_NUMK5EMBEDDINGS  27
+
+static int ProjectivePlanarity_K33Faces[6][4][7] = {
+    { {0, 3, 1, 4, -1, -1, -1}, {0, 4, 2, 5, -1, -1, -1}, {1, 3, 2, 5, -1, -1, -1}, {0, 3, 2, 4, 1, 5, -1} },
+    { {0, 3, 1, 4, -1, -1, -1}, {0, 3, 2, 5, -1, -1, -1}, {1, 4, 2, 5, -1, -1, -1}, {0, 4, 2, 3, 1, 5, -1} },
+    { {0, 3, 2, 4, -1, -1, -1}, {0, 4, 1, 5, -1, -1, -1}, {1, 3, 2, 5, -1, -1, -1}, {0, 3, 1, 4, 2, 5, -1} },
+    { {0, 3, 1, 5, -1, -1, -1}, {0, 3, 2, 4, -1, -1, -1}, {1, 4, 2, 5, -1, -1, -1}, {0, 4, 1, 3, 2, 5, -1} },
+    { {0, 3, 1, 5, -1, -1, -1}, {0, 4, 2, 5, -1, -1, -1}, {1, 3, 2, 4, -1, -1, -1}, {0, 3, 2, 5, 1, 4, -1} },
+    { {0, 3, 2, 5, -1, -1, -1}, {0, 4, 1, 5, -1, -1, -1}, {1, 3, 2, 4, -1, -1, -1}, {0, 3, 1, 5, 2, 4, -1} }
+};
+static int ProjectivePlanarity_K5Faces[27][6][6] = {
+    { {0, 1, 2, -1, -1, -1}, {0, 1, 3, -1, -1, -1}, {0, 3, 4, -1, -1, -1}, {1, 2, 4, -1, -1, -1}, {2, 3, 4, -1, -1, -1}, {0, 2, 3, 1, 4, -1} },
+    { {0, 1, 2, -1, -1, -1}, {0, 1, 3, -1, -1, -1}, {1, 2, 4, -1, -1, -1}, {1, 3, 4, -1, -1, -1}, {0, 2, 3, 4, -1, -1}, {0, 3, 2, 4, -1, -1} },
+    { {0, 1, 2, -1, -1, -1}, {0, 1, 3, -1, -1, -1}, {0, 2, 4, -1, -1, -1}, {1, 3, 4, -1, -1, -1}, {2, 3, 4, -1, -1, -1}, {0, 3, 2, 1, 4, -1} },
+    { {0, 1, 2, -1, -1, -1}, {0, 1, 3, -1, -1, -1}, {0, 2, 4, -1, -1, -1}, {0, 3, 4, -1, -1, -1}, {1, 2, 3, 4, -1, -1}, {1, 3, 2, 4, -1, -1} },
+    { {0, 1, 2, -1, -1, -1}, {0, 2, 3, -1, -1, -1}, {0, 3, 4, -1, -1, -1}, {1, 2, 4, -1, -1, -1}, {1, 3, 4, -1, -1, -1}, {0, 1, 3, 2, 4, -1} },
+    { {0, 1, 2, -1, -1, -1}, {0, 2, 3, -1, -1, -1}, {1, 2, 4, -1, -1, -1}, {2, 3, 4, -1, -1, -1}, {0, 1, 3, 4, -1, -1}, {0, 3, 1, 4, -1, -1} },
+    { {0, 1, 2, -1, -1, -1}, {0, 1, 4, -1, -1, -1}, {0, 2, 3, -1, -1, -1}, {1, 3, 4, -1, -1, -1}, {2, 3, 4, -1, -1, -1}, {0, 3, 1, 2, 4, -1} },
+    { {0, 1, 2, -1, -1, -1}, {0, 1, 4, -1, -1, -1}, {0, 2, 3, -1, -1, -1}, {0, 3, 4, -1, -1, -1}, {1, 2, 4, 3, -1, -1}, {1, 3, 2, 4, -1, -1} },
+    { {0, 1, 2, -1, -1, -1}, {0, 1, 4, -1, -1, -1}, {0, 3, 4, -1, -1, -1}, {1, 2, 3, -1, -1, -1}, {2, 3, 4, -1, -1, -1}, {0, 2, 4, 1, 3, -1} },
+    { {0, 1, 2, -1, -1, -1}, {0, 1, 4, -1, -1, -1}, {1, 2, 3, -1, -1, -1}, {1, 3, 4, -1, -1, -1}, {0, 2, 4, 3, -1, -1}, {0, 3, 2, 4, -1, -1} },
+    { {0, 1, 2, -1, -1, -1}, {0, 2, 4, -1, -1, -1}, {0, 3, 4, -1, -1, -1}, {1, 2, 3, -1, -1, -1}, {1, 3, 4, -1, -1, -1}, {0, 1, 4, 2, 3, -1} },
+    { {0, 1, 2, -1, -1, -1}, {0, 2, 4, -1, -1, -1}, {1, 2, 3, -1, -1, -1}, {2, 3, 4, -1, -1, -1}, {0, 1, 4, 3, -1, -1}, {0, 3, 1, 4, -1, -1} },
+    { {0, 2, 4, -1, -1, -1}, {0, 3, 4, -1, -1, -1}, {1, 2, 4, -1, -1, -1}, {1, 3, 4, -1, -1, -1}, {0, 1, 2, 3, -1, -1}, {0, 1, 3, 2, -1, -1} },
+    { {0, 1, 4, -1, -1, -1}, {0, 2, 4, -1, -1, -1}, {1, 3, 4, -1, -1, -1}, {2, 3, 4, -1, -1, -1}, {0, 1, 2, 3, -1, -1}, {0, 2, 1, 3, -1, -1} },
+    { {0, 1, 3, -1, -1, -1}, {0, 2, 3, -1, -1, -1}, {0, 2, 4, -1, -1, -1}, {1, 2, 4, -1, -1, -1}, {1, 3, 4, -1, -1, -1}, {0, 1, 2, 3, 4, -1} },
+    { {0, 1, 3, -1, -1, -1}, {0, 2, 3, -1, -1, -1}, {1, 3, 4, -1, -1, -1}, {2, 3, 4, -1, -1, -1}, {0, 1, 2, 4, -1, -1}, {0, 2, 1, 4, -1, -1} },
+    { {0, 2, 3, -1, -1, -1}, {0, 3, 4, -1, -1, -1}, {1, 2, 3, -1, -1, -1}, {1, 3, 4, -1, -1, -1}, {0, 1, 2, 4, -1, -1}, {0, 1, 4, 2, -1, -1} },
+    { {0, 1, 4, -1, -1, -1}, {0, 2, 3, -1, -1, -1}, {0, 2, 4, -1, -1, -1}, {1, 2, 3, -1, -1, -1}, {1, 3, 4, -1, -1, -1}, {0, 1, 2, 4, 3, -1} },
+    { {0, 1, 3, -1, -1, -1}, {0, 1, 4, -1, -1, -1}, {0, 2, 3, -1, -1, -1}, {1, 2, 4, -1, -1, -1}, {2, 3, 4, -1, -1, -1}, {0, 2, 1, 3, 4, -1} },
+    { {0, 1, 3, -1, -1, -1}, {0, 1, 4, -1, -1, -1}, {0, 2, 4, -1, -1, -1}, {1, 2, 3, -1, -1, -1}, {2, 3, 4, -1, -1, -1}, {0, 2, 1, 4, 3, -1} },
+    { {0, 1, 3, -1, -1, -1}, {0, 1, 4, -1, -1, -1}, {0, 2, 3, -1, -1, -1}, {0, 2, 4, -1, -1, -1}, {1, 2, 3, 4, -1, -1}, {1, 2, 4, 3, -1, -1} },
+    { {0, 1, 3, -1, -1, -1}, {0, 1, 4, -1, -1, -1}, {1, 2, 3, -1, -1, -1}, {1, 2, 4, -1, -1, -1}, {0, 2, 3, 4, -1, -1}, {0, 2, 4, 3, -1, -1} },
+    { {0, 1, 3, -1, -1, -1}, {0, 3, 4, -1, -1, -1}, {1, 2, 3, -1, -1, -1}, {2, 3, 4, -1, -1, -1}, {0, 1, 4, 2, -1, -1}, {0, 2, 1, 4, -1, -1} },
+    { {0, 1, 3, -1, -1, -1}, {0, 2, 4, -1, -1, -1}, {0, 3, 4, -1, -1, -1}, {1, 2, 3, -1, -1, -1}, {1, 2, 4, -1, -1, -1}, {0, 1, 4, 3, 2, -1} },
+    { {0, 1, 4, -1, -1, -1}, {0, 3, 4, -1, -1, -1}, {1, 2, 4, -1, -1, -1}, {2, 3, 4, -1, -1, -1}, {0, 1, 3, 2, -1, -1}, {0, 2, 1, 3, -1, -1} },
+    { {0, 2, 3, -1, -1, -1}, {0, 2, 4, -1, -1, -1}, {1, 2, 3, -1, -1, -1}, {1, 2, 4, -1, -1, -1}, {0, 1, 3, 4, -1, -1}, {0, 1, 4, 3, -1, -1} },
+    { {0, 1, 4, -1, -1, -1}, {0, 2, 3, -1, -1, -1}, {0, 3, 4, -1, -1, -1}, {1, 2, 3, -1, -1, -1}, {1, 2, 4, -1, -1, -1}, {0, 1, 3, 4, 2, -1} }
+};
+
+/****************************************************************************
+ _TestProjectivePlanarity()
+
+ The Walkdown has isolated a K5 or K_{3,3} homeomorph H in theGraph, so
+ the input graph recorded in the context is tested for an embedding in
+ the projective plane by trying to extend each embedding of H.
+
+ If the input graph is projective planar, then theGraph receives the
+ edges of the input graph and OK is returned.  Otherwise, theGraph
+ receives a minimal subgraph of the input graph that does not embed in
+ the projective plane, and NONEMBEDDABLE is returned.
+
+ Returns NOTOK on internal error.
+ ****************************************************************************/
+
+int  _TestProjectivePlanarity(graphP theGraph, ProjectivePlanarityContext *context)
+{
+     ProjectivePlanarityWorkspace ws;
+     int RetVal;
+
+     if (_ProjectivePlanarity_CreateWorkspace(&ws, theGraph->N, context->edgeList, context->numEdges, 0) != OK)
+         return NOTOK;
+
+     // A graph embedded in the projective plane has at most 3N-3 edges.
+     // Otherwise, the subgraph H isolated in theGraph is extended
+     if (ws.kb.M > 3*ws.kb.N - 3)
+         RetVal = NONEMBEDDABLE;
+     else if (_KuratowskiBridges_GetSubgraph(&ws.kb, theGraph, FALSE) != OK)
+         RetVal = NOTOK;
+     else
+         RetVal = _ProjectivePlanarity_ExtendSubgraph(&ws);
+
+     if (RetVal == OK)
+     {
+         if (_KuratowskiBridges_ReplaceEdges(theGraph, context->edgeList, context->numEdges) != OK)
+             RetVal = NOTOK;
+     }
+     else if (RetVal == NONEMBEDDABLE)
+     {
+         if (_ProjectivePlanarity_IsolateObstruction(&ws) != OK ||
+             _KuratowskiBridges_ReplaceEdges(theGraph, ws.kb.edges, ws.kb.M) != OK)
+             RetVal = NOTOK;
+     }
+
+     _ProjectivePlanarity_FreeWorkspace(&ws);
+     return RetVal;
+}
+
+/****************************************************************************
+ _CheckProjectivePlanarityResult()
+
+ Tests the edges of theGraph for projective planarity, for the integrity
+ checks of the results of gp_Embed().
+
+ Returns OK if the test result is the expectedResult, NOTOK otherwise
+ ****************************************************************************/
+
+int  _CheckProjectivePlanarityResult(graphP theGraph, int expectedResult)
+{
+     ProjectivePlanarityWorkspace ws;
+     int *edgeList, numEdges = 0, EsizeOccupied, e, RetVal;
+
+     EsizeOccupied = gp_EdgeInUseIndexBound(theGraph);
+     if ((edgeList = (int *) malloc((EsizeOccupied+1) * sizeof(int))) == NULL)
+         return NOTOK;
+
+     for (e = gp_GetFirstEdge(theGraph); e < EsizeOccupied; e += 2)
+     {
+         if (gp_EdgeInUse(theGraph, e))
+         {
+             edgeList[2*numEdges] = gp_GetNeighbor(theGraph, gp_GetTwinArc(theGraph, e));
+             edgeList[2*numEdges+1] = gp_GetNeighbor(theGraph, e);
+             numEdges++;
+         }
+     }
+
+     RetVal = _ProjectivePlanarity_CreateWorkspace(&ws, theGraph->N, edgeList, numEdges, 0);
+     free(edgeList);
+     if (RetVal != OK)
+         return NOTOK;
+
+     RetVal = _ProjectivePlanarity_Test(&ws) == expectedResult ? OK : NOTOK;
+
+     _ProjectivePlanarity_FreeWorkspace(&ws);
+     return RetVal;
+}
+
+/****************************************************************************
+ _ProjectivePlanarity_CreateWorkspace()
+
+ Copies the given edges, omitting loops, into a new workspace, with a
+ search of the embedding cases of H for each of numThreads threads, or
+ for one thread per processor if numThreads is not positive.
+ ****************************************************************************/
+
+int  _ProjectivePlanarity_CreateWorkspace(ProjectivePlanarityWorkspace *ws, int N, int *edgeList, int numEdges, int numThreads)
+{
+     int M = 0, i, t;
+
+     memset(ws, 0, sizeof(ProjectivePlanarityWorkspace));
+
+     for (i = 0; i < numEdges; i++)
+         if (edgeList[2*i] != edgeList[2*i+1])
+             M++;
+
+     if ((ws->testGraph = gp_New()) == NULL ||
+         gp_EnsureArcCapacity(ws->testGraph, 2*(M + 1)) != OK ||
+         gp_InitGraph(ws->testGraph, N) != OK ||
+         _KuratowskiBridges_New(&ws->kb, ws->testGraph, edgeList, numEdges) != OK)
+     {
+         _ProjectivePlanarity_FreeWorkspace(ws);
+         return NOTOK;
+     }
+
+     ws->numThreads = _KuratowskiBridges_GetNumThreads(&ws->kb, numThreads);
+
+     if ((ws->searches = (ProjectivePlanaritySearch *) calloc(ws->numThreads, sizeof(ProjectivePlanaritySearch))) == NULL)
+     {
+         _ProjectivePlanarity_FreeWorkspace(ws);
+         return NOTOK;
+     }
+
+     for (t = 0; t < ws->numThreads; t++)
+     {
+         if (_ProjectivePlanarity_NewSearch(&ws->searches[t], &ws->kb) != OK)
+         {
+             _ProjectivePlanarity_FreeWorkspace(ws);
+             return NOTOK;
+         }
+     }
+
+     return OK;
+}
+
+/****************************************************************************
+ _ProjectivePlanarity_FreeWorkspace()
+ ****************************************************************************/
+
+void _ProjectivePlanarity_FreeWorkspace(ProjectivePlanarityWorkspace *ws)
+{
+     int t;
+
+     if (ws->searches != NULL)
+     {
+         for (t = 0; t < ws->numThreads; t++)
+             _ProjectivePlanarity_FreeSearch(&ws->searches[t]);
+         free(ws->searches);
+     }
+
+     _KuratowskiBridges_Free(&ws->kb);
+     gp_Free(&ws->testGraph);
+
+     memset(ws, 0, sizeof(ProjectivePlanarityWorkspace));
+}
+
+/****************************************************************************
+ _ProjectivePlanarity_NewSearch()
+
+ Allocates the arrays of a search of the embedding cases of H in the
+ graph of kb, and the graph used for the planarity tests of its bridges.
+
+ Returns OK on success, NOTOK on allocation failure, in which case the
+         arrays allocated are freed
+ ****************************************************************************/
+
+int  _ProjectivePlanarity_NewSearch(ProjectivePlanaritySearch *search, kuratowskiBridgesP kb)
+{
+     int Vsize = kb->firstVertex + kb->N, NB = Vsize + kb->M, i;
+
+     memset(search, 0, sizeof(ProjectivePlanaritySearch));
+     search->kb = kb;
+
+     if ((search->testGraph = gp_New()) == NULL ||
+         gp_EnsureArcCapacity(search->testGraph, 2*(kb->M + kb->N)) != OK ||
+         gp_InitGraph(search->testGraph, kb->N) != OK ||
+         (search->fitsAnyFace = (int *) malloc((NB+1) * sizeof(int))) == NULL ||
+         (search->faceVertices = (int *) malloc((6*Vsize+1) * sizeof(int))) == NULL ||
+         (search->facePosition = (int *) malloc((6*Vsize+1) * sizeof(int))) == NULL ||
+         (search->available = (int *) malloc((NB+1) * sizeof(int))) == NULL ||
+         (search->assigned = (int *) malloc((NB+1) * sizeof(int))) == NULL ||
+         (search->levelBridge = (int *) malloc((NB+1) * sizeof(int))) == NULL ||
+         (search->levelFaces = (int *) malloc((NB+1) * sizeof(int))) == NULL ||
+         (search->levelTrail = (int *) malloc((NB+1) * sizeof(int))) == NULL ||
+         (search->trail = (int *) malloc((12*NB+1) * sizeof(int))) == NULL ||
+         (search->positions = (int *) malloc((Vsize+1) * sizeof(int))) == NULL)
+     {
+         _ProjectivePlanarity_FreeSearch(search);
+         return NOTOK;
+     }
+
+     for (i = 0; i < 6*Vsize; i++)
+         search->facePosition[i] = -1;
+
+     return OK;
+}
+
+/****************************************************************************
+ _ProjectivePlanarity_FreeSearch()
+ ****************************************************************************/
+
+void _ProjectivePlanarity_FreeSearch(ProjectivePlanaritySearch *search)
+{
+     if (search->fitsAnyFace != NULL) free(search->fitsAnyFace);
+     if (search->faceVertices != NULL) free(search->faceVertices);
+     if (search->facePosition != NULL) free(search->facePosition);
+     if (search->available != NULL) free(search->available);
+     if (search->assigned != NULL) free(search->assigned);
+     if (search->levelBridge != NULL) free(search->levelBridge);
+     if (search->levelFaces != NULL) free(search->levelFaces);
+     if (search->levelTrail != NULL) free(search->levelTrail);
+     if (search->trail != NULL) free(search->trail);
+     if (search->positions != NULL) free(search->positions);
+
+     gp_Free(&search->testGraph);
+
+     memset(search, 0, sizeof(ProjectivePlanaritySearch));
+}
+
+/****************************************************************************
+ _ProjectivePlanarity_Test()
+
+ Tests the edges in the workspace for an embedding in the projective plane.
+ A planarity test either shows the graph is planar or isolates the subgraph
+ H, which is then extended.
+
+ Returns OK if the graph is projective planar, NONEMBEDDABLE if not, and
+         NOTOK on internal error
+ ****************************************************************************/
+
+int  _ProjectivePlanarity_Test(ProjectivePlanarityWorkspace *ws)
+{
+     kuratowskiBridgesP kb = &ws->kb;
+     int i, RetVal;
+
+     if (kb->M > 3*kb->N - 3)
+         return NONEMBEDDABLE;
+
+     gp_ReinitializeGraph(ws->testGraph);
+     for (i = 0; i < kb->M; i++)
+     {
+         if (gp_AddEdge(ws->testGraph, kb->edges[2*i], 0, kb->edges[2*i+1], 0) != OK)
+             return NOTOK;
+     }
+
+     RetVal = gp_Embed(ws->testGraph, EMBEDFLAGS_PLANAR);
+     if (RetVal != NONEMBEDDABLE)
+         return RetVal;
+
+     if (_KuratowskiBridges_GetSubgraph(kb, ws->testGraph, TRUE) != OK)
+         return NOTOK;
+
+     return _ProjectivePlanarity_ExtendSubgraph(ws);
+}
+
+/****************************************************************************
+ _ProjectivePlanarity_IsolateObstruction()
+
+ The edges in the workspace do not form a projective planar graph, so
+ each edge in turn is deleted if the remaining edges still do not form a
+ projective planar graph.  The edges that remain in the workspace form a
+ minimal subgraph that does not embed in the projective plane.
+
+ Deleting an edge that is not in H leaves H a subgraph of the graph, so
+ H is extended again without another planarity test.
+
+ Returns OK on success, NOTOK on internal error
+ ****************************************************************************/
+
+int  _ProjectivePlanarity_IsolateObstruction(ProjectivePlanarityWorkspace *ws)
+{
+     kuratowskiBridgesP kb = &ws->kb;
+     int i, RetVal;
+
+     for (i = kb->M-1; i >= 0; i--)
+     {
+         if (_KuratowskiBridges_RemoveEdge(kb, i) && kb->M <= 3*kb->N - 3)
+              RetVal = _ProjectivePlanarity_ExtendSubgraph(ws);
+         else RetVal = _ProjectivePlanarity_Test(ws);
+         if (RetVal == NOTOK)
+             return NOTOK;
+
+         // If the edge is needed, then restore it to position i
+         if (RetVal == OK)
+             _KuratowskiBridges_RestoreEdge(kb, i);
+     }
+
+     return OK;
+}
+
+/****************************************************************************
+ _ProjectivePlanarity_ExtendSubgraph()
+
+ Finds the branch vertices, paths and bridges of H, then tries each
+ embedding of H in the projective plane until the bridges can be placed
+ in its faces.  The embeddings are tried by the threads of the workspace,
+ each with its own search, and the first that extends stops the others.
+
+ Returns OK if some embedding of H extends to the whole graph,
+         NONEMBEDDABLE if none does, and NOTOK on internal error
+ ****************************************************************************/
+
+int  _ProjectivePlanarity_ExtendSubgraph(ProjectivePlanarityWorkspace *ws)
+{
+     kuratowskiBridgesP kb = &ws->kb;
+     int numEmbeddings, foundBy, b, t, RetVal;
+
+     if (_KuratowskiBridges_FindBridges(kb) != OK)
+         return NOTOK;
+
+     for (t = 0; t < ws->numThreads; t++)
+         for (b = 0; b < kb->numBridges; b++)
+             ws->searches[t].fitsAnyFace[b] = 0;
+
+     // A bridge with at most one attachment that is not planar is a second
+     // obstruction to planarity that shares at most one vertex with H
+     for (b = 0; b < kb->numBridges; b++)
+     {
+         if (kb->attachStart[b+1] - kb->attachStart[b] < 2 &&
+             (RetVal = _ProjectivePlanarity_TestBridge(&ws->searches[0], b, -1)) != OK)
+             return RetVal;
+     }
+
+     numEmbeddings = kb->isK5 ? PROJECTIVEPLANARITY_NUMK5EMBEDDINGS
+                              : PROJECTIVEPLANARITY_NUMK33EMBEDDINGS;
+
+     return _KuratowskiBridges_ExploreCases(ws, numEmbeddings, ws->numThreads, _ProjectivePlanarity_TryCase, &foundBy);
+}
+
+/****************************************************************************
+ _ProjectivePlanarity_TryCase()
+
+ Tries to extend embedding k of H with the search of the given thread.
+
+ Returns OK if the bridges can be placed in the faces of the embedding,
+         NONEMBEDDABLE if not, and NOTOK on internal error
+ ****************************************************************************/
+
+int  _ProjectivePlanarity_TryCase(void *context, int threadNumber, int k)
+{
+     ProjectivePlanarityWorkspace *ws = (ProjectivePlanarityWorkspace *) context;
+     ProjectivePlanaritySearch *search = &ws->searches[threadNumber];
+
+     if (ws->kb.isK5)
+          _ProjectivePlanarity_BuildFaces(search, &ProjectivePlanarity_K5Faces[k][0][0], 6, 6);
+     else _ProjectivePlanarity_BuildFaces(search, &ProjectivePlanarity_K33Faces[k][0][0], 4, 7);
+
+     return _ProjectivePlanarity_PlaceBridges(search);
+}
+
+/****************************************************************************
+ _ProjectivePlanarity_BuildFaces()
+
+ Builds the boundary cycle of each face of an embedding of H by replacing
+ each pair of consecutive branch vertex labels with the path of H that
+ joins the corresponding branch vertices, and records the position of
+ each vertex on the boundary of each face.
+ ****************************************************************************/
+
+void _ProjectivePlanarity_BuildFaces(ProjectivePlanaritySearch *search, int *faceLabels, int numFaces, int width)
+{
+     kuratowskiBridgesP kb = search->kb;
+     int Vsize = gp_PrimaryVertexIndexBound(search->testGraph);
+     int f, i, j, k, a, c, p, size = 0, length;
+
+     // Clear the positions of the vertices on the faces of the prior embedding
+     for (f = 0; f < search->numFaces; f++)
+         for (i = 0; i < search->faceLength[f]; i++)
+             search->facePosition[f*Vsize + search->faceVertices[search->faceStart[f]+i]] = -1;
+
+     search->numFaces = numFaces;
+     for (f = 0; f < numFaces; f++)
+     {
+         int *labels = faceLabels + f*width;
+
+         for (k = 0; k < width && labels[k] >= 0; k++)
+             ;
+
+         search->faceStart[f] = size;
+         for (i = 0; i < k; i++)
+         {
+             a = labels[i];
+             c = labels[(i+1) % k];
+             p = kb->pathIndex[a][c];
+             length = kb->pathLength[p];
+
+             // Add the path from branch vertex a, omitting the branch vertex c
+             for (j = 0; j < length-1; j++)
+             {
+                 if (kb->pathVertices[kb->pathStart[p]] == kb->branch[a])
+                      search->faceVertices[size] = kb->pathVertices[kb->pathStart[p] + j];
+                 else search->faceVertices[size] = kb->pathVertices[kb->pathStart[p] + length-1 - j];
+
+                 search->facePosition[f*Vsize + search->faceVertices[size]] = size - search->faceStart[f];
+                 size++;
+             }
+         }
+         search->faceLength[f] = size - search->faceStart[f];
+     }
+}
+
+/****************************************************************************
+ _ProjectivePlanarity_BridgeFitsFace()
+
+ Determines whether bridge b, which has at least two attachments, can be
+ embedded in face f by itself.  This requires all attachments of b to be
+ on the boundary of f, and b must be planar together with the boundary.
+ A bridge that is a single edge always fits, and for a bridge with at
+ most three attachments, the result does not depend on the face.
+
+ Returns OK if the bridge fits, NONEMBEDDABLE if not, NOTOK on error
+ ****************************************************************************/
+
+int  _ProjectivePlanarity_BridgeFitsFace(ProjectivePlanaritySearch *search, int b, int f)
+{
+     kuratowskiBridgesP kb = search->kb;
+     int Vsize = gp_PrimaryVertexIndexBound(search->testGraph);
+     int numAttach = kb->attachStart[b+1] - kb->attachStart[b];
+     int i, RetVal;
+
+     for (i = kb->attachStart[b]; i < kb->attachStart[b+1]; i++)
+     {
+         if (search->facePosition[f*Vsize + kb->attachments[i]] < 0)
+             return NONEMBEDDABLE;
+     }
+
+     if (kb->edgeStart[b+1] - kb->edgeStart[b] == 1)
+         return OK;
+
+     if (numAttach > 3)
+         return _ProjectivePlanarity_TestBridge(search, b, f);
+
+     if (search->fitsAnyFace[b] == 0)
+     {
+         if ((RetVal = _ProjectivePlanarity_TestBridge(search, b, -1)) == NOTOK)
+             return NOTOK;
+         search->fitsAnyFace[b] = RetVal == OK ? 1 : 2;
+     }
+
+     return search->fitsAnyFace[b] == 1 ? OK : NONEMBEDDABLE;
+}
+
+/****************************************************************************
+ _ProjectivePlanarity_TestBridge()
+
+ Tests the planarity of bridge b together with a cycle through its
+ attachments, in the order of their positions on the boundary of face f,
+ or in any order if f is -1.  With two attachments, the cycle is just
+ an edge, and with fewer, there is no cycle.
+
+ Returns OK if planar, NONEMBEDDABLE if not, NOTOK on internal error
+ ****************************************************************************/
+
+int  _ProjectivePlanarity_TestBridge(ProjectivePlanaritySearch *search, int b, int f)
+{
+     kuratowskiBridgesP kb = search->kb;
+     int Vsize = gp_PrimaryVertexIndexBound(search->testGraph);
+     int numAttach = kb->attachStart[b+1] - kb->attachStart[b];
+     int *cycle = search->positions;
+     int i, e;
+
+     gp_ReinitializeGraph(search->testGraph);
+
+     for (i = kb->edgeStart[b]; i < kb->edgeStart[b+1]; i++)
+     {
+         e = kb->bridgeEdges[i];
+         if (gp_AddEdge(search->testGraph, kb->edges[2*e], 0, kb->edges[2*e+1], 0) != OK)
+             return NOTOK;
+     }
+
+     if (numAttach >= 2)
+     {
+         for (i = 0; i < numAttach; i++)
+             cycle[i] = kb->attachments[kb->attachStart[b] + i];
+
+         if (f >= 0)
+         {
+             // Order the attachments by their positions on the face
+             for (i = 0; i < numAttach; i++)
+                 cycle[i] = search->facePosition[f*Vsize + cycle[i]];
+             qsort(cycle, numAttach, sizeof(int), _ProjectivePlanarity_ComparePositions);
+             for (i = 0; i < numAttach; i++)
+                 cycle[i] = search->faceVertices[search->faceStart[f] + cycle[i]];
+         }
+
+         for (i = 0; i < (numAttach == 2 ? 1 : numAttach); i++)
+         {
+             if (gp_AddEdge(search->testGraph, cycle[i], 0, cycle[(i+1) % numAttach], 0) != OK)
+                 return NOTOK;
+         }
+     }
+
+     return gp_Embed(search->testGraph, EMBEDFLAGS_PLANAR);
+}
+
+/****************************************************************************
+ _ProjectivePlanarity_PlaceBridges()
+
+ Searches for an assignment of each bridge with at least two attachments
+ to a face in which it fits, such that no two bridges assigned to the same
+ face overlap.  Since every face is a disk bounded by a cycle, the bridges
+ in a face can be embedded together if and only if they pairwise do not
+ overlap.
+
+ The search is a backtracking search that always branches on a bridge
+ with the fewest available faces, and that removes a face from each
+ unassigned bridge that would overlap a bridge just assigned to the face.
+
+ Returns OK if the bridges can be placed, NONEMBEDDABLE if not, and
+         NOTOK on internal error
+ ****************************************************************************/
+
+int  _ProjectivePlanarity_PlaceBridges(ProjectivePlanaritySearch *search)
+{
+     kuratowskiBridgesP kb = search->kb;
+     int b, f, level, best, bestCount, count, faces, RetVal;
+
+     for (b = 0; b < kb->numBridges; b++)
+     {
+         search->available[b] = 0;
+         search->assigned[b] = -2;
+
+         if (kb->attachStart[b+1] - kb->attachStart[b] < 2)
+             continue;
+
+         search->assigned[b] = -1;
+         for (f = 0; f < search->numFaces; f++)
+         {
+             if ((RetVal = _ProjectivePlanarity_BridgeFitsFace(search, b, f)) == NOTOK)
+                 return NOTOK;
+             if (RetVal == OK)
+                 search->available[b] |= 1 << f;
+         }
+
+         if (search->available[b] == 0)
+             return NONEMBEDDABLE;
+     }
+
+     search->trailSize = 0;
+     level = 0;
+     for (;;)
+     {
+         // Choose the unassigned bridge with the fewest available faces
+         best = -1;
+         bestCount = 7;
+         for (b = 0; b < kb->numBridges; b++)
+         {
+             if (search->assigned[b] != -1)
+                 continue;
+             for (count = 0, faces = search->available[b]; faces; faces &= faces-1)
+                 count++;
+             if (count < bestCount)
+             {
+                 best = b;
+                 bestCount = count;
+             }
+         }
+
+         if (best < 0)
+             return OK;
+
+         search->levelBridge[level] = best;
+         search->levelFaces[level] = search->available[best];
+         search->levelTrail[level] = search->trailSize;
+
+         // Try the untried faces of the bridge at the current level,
+         // backtracking to prior levels when they are exhausted
+         for (;;)
+         {
+             b = search->levelBridge[level];
+             if (search->levelFaces[level] == 0)
+             {
+                 search->assigned[b] = -1;
+                 if (--level < 0)
+                     return NONEMBEDDABLE;
+                 _ProjectivePlanarity_UndoTrail(search, search->levelTrail[level]);
+                 continue;
+             }
+
+             for (f = 0; !(search->levelFaces[level] & (1 << f)); f++)
+                 ;
+             search->levelFaces[level] &= ~(1 << f);
+
+             if (_ProjectivePlanarity_AssignBridge(search, b, f) == OK)
+                 break;
+
+             _ProjectivePlanarity_UndoTrail(search, search->levelTrail[level]);
+         }
+
+         level++;
+     }
+
+     return NOTOK;
+}
+
+/****************************************************************************
+ _ProjectivePlanarity_AssignBridge()
+
+ Assigns bridge b to face f, and removes face f from each unassigned
+ bridge that overlaps b in face f, recording the removals in the trail.
+
+ Returns OK if every unassigned bridge still has an available face,
+         NONEMBEDDABLE otherwise
+ ****************************************************************************/
+
+int  _ProjectivePlanarity_AssignBridge(ProjectivePlanaritySearch *search, int b, int f)
+{
+     kuratowskiBridgesP kb = search->kb;
+     int b2;
+
+     search->assigned[b] = f;
+
+     for (b2 = 0; b2 < kb->numBridges; b2++)
+     {
+         if (search->assigned[b2] != -1 || !(search->available[b2] & (1 << f)))
+             continue;
+
+         if (_ProjectivePlanarity_Overlap(search, b, b2, f))
+         {
+             search->available[b2] &= ~(1 << f);
+             search->trail[2*search->trailSize] = b2;
+             search->trail[2*search->trailSize+1] = f;
+             search->trailSize++;
+
+             if (search->available[b2] == 0)
+                 return NONEMBEDDABLE;
+         }
+     }
+
+     return OK;
+}
+
+/****************************************************************************
+ _ProjectivePlanarity_UndoTrail()
+
+ Restores the available faces removed since the trail had the given size.
+ ****************************************************************************/
+
+void _ProjectivePlanarity_UndoTrail(ProjectivePlanaritySearch *search, int trailSize)
+{
+     while (search->trailSize > trailSize)
+     {
+         search->trailSize--;
+         search->available[search->trail[2*search->trailSize]] |= 1 << search->trail[2*search->trailSize+1];
+     }
+}
+
+/****************************************************************************
+ _ProjectivePlanarity_Overlap()
+
+ Two bridges of a cycle avoid each other if and only if the attachments
+ of one bridge all lie in a single segment of the cycle between two
+ consecutive attachments of the other bridge.  This tests the attachments
+ of bridge b2 against the segments of the boundary of face f determined
+ by the attachments of bridge b1.
+
+ Returns TRUE if the bridges overlap in face f, FALSE otherwise
+ ****************************************************************************/
+
+int  _ProjectivePlanarity_Overlap(ProjectivePlanaritySearch *search, int b1, int b2, int f)
+{
+     kuratowskiBridgesP kb = search->kb;
+     int Vsize = gp_PrimaryVertexIndexBound(search->testGraph);
+     int *p = search->positions;
+     int k = kb->attachStart[b1+1] - kb->attachStart[b1];
+     int i, q, lo, hi, seg1 = -2, seg2 = -2, s1, s2;
+
+     for (i = 0; i < k; i++)
+         p[i] = search->facePosition[f*Vsize + kb->attachments[kb->attachStart[b1] + i]];
+     qsort(p, k, sizeof(int), _ProjectivePlanarity_ComparePositions);
+
+     // Segment i is from p[i] to p[i+1], or from p[k-1] around to p[0].
+     // The candidate segments for b2 are seg1 and seg2, where -2 means
+     // any segment and -1 means none
+     for (i = kb->attachStart[b2]; i < kb->attachStart[b2+1]; i++)
+     {
+         q = search->facePosition[f*Vsize + kb->attachments[i]];
+
+         // Find the least lo such that q <= p[lo], or k if there is none
+         lo = 0;
+         hi = k;
+         while (lo < hi)
+         {
+             if (p[(lo+hi)/2] < q)
+                  lo = (lo+hi)/2 + 1;
+             else hi = (lo+hi)/2;
+         }
+
+         // An attachment of b1 is in the two segments that it ends
+         if (lo < k && p[lo] == q)
+         {
+             s1 = (lo + k - 1) % k;
+             s2 = lo;
+         }
+         else s1 = s2 = (lo + k - 1) % k;
+
+         if (seg1 == -2)
+         {
+             seg1 = s1;
+             seg2 = s2;
+         }
+         else
+         {
+             if (seg1 != s1 && seg1 != s2)
+                 seg1 = -1;
+             if (seg2 != s1 && seg2 != s2)
+                 seg2 = -1;
+             if (seg1 == -1 && seg2 == -1)
+                 return TRUE;
+         }
+     }
+
+     return FALSE;
+}
+
+/****************************************************************************
+ _ProjectivePlanarity_ComparePositions()
+ ****************************************************************************/
+
+int  _ProjectivePlanarity_ComparePositions(const void *p1, const void *p2)
+{
+     return *((int *) p1) - *((int *) p2);
+}
@@ -0,0 +1,162 @@
+#ifndef GRAPH_PROJECTIVEPLANARITY_PRIVATE_H
+#define GRAPH_PROJECTIVEPLANARITY_PRIVATE_H
+
+/*
+Planarity-Related Graph Algorithms Project
+Copyright (c) 1997-2012, John M. Boyer
+All rights reserved. Includes a reference implementation of the following:
+
+* John M. Boyer. "Subgraph Homeomorphism via the Edge Addition Planarity Algorithm".
+  Journal of Graph Algorithms and Applications, Vol. 16, no. 2, pp. 381-410, 2012.
+  http://www.jgaa.info/16/268.html
+
+* John M. Boyer. "A New Method for Efficiently Generating Planar Graph
+  Visibility Representations". In P. Eades and P. Healy, editors,
+  Proceedings of the 13th International Conference on Graph Drawing 2005,
+  Lecture Notes Comput. Sci., Volume 3843, pp. 508-511, Springer-Verlag, 2006.
+
+* John M. Boyer and Wendy J. Myrvold. "On the Cutting Edge: Simplified O(n)
+  Planarity by Edge Addition". Journal of Graph Algorithms and Applications,
+  Vol. 8, No. 3, pp. 241-273, 2004.
+  http://www.jgaa.info/08/91.html
+
+* John M. Boyer. "Simplified O(n) Algorithms for Planar Graph Embedding,
+  Kuratowski Subgraph Isolation, and Related Problems". Ph.D. Dissertation,
+  University of Victoria, 2001.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+  list of conditions and the following disclaimer in the documentation and/or
+  other materials provided with the distribution.
+
+* Neither the name of the Planarity-Related Graph Algorithms Project nor the names
+  of its contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include "graph.h"
+#include "graphKuratowskiBridges.private.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Additional equipment for each EdgeRec: None
+   Additional equipment for each vertex: None
+
+   The projective planarity test runs the core planarity algorithm.  If the
+   graph is planar, then the result is a planar embedding.  Otherwise, the
+   core isolates a subgraph H homeomorphic to K5 or K_{3,3}, and the test
+   tries to extend each of the labeled projective plane embeddings of H
+   (27 for K5 and 6 for K_{3,3}) to the whole graph.  Every face of these
+   embeddings is bounded by a cycle, so an embedding extends if and only if
+   each bridge of H can be assigned to a face whose boundary contains all
+   of the bridge's attachments such that the bridge is planar together with
+   the face boundary and no two bridges in the same face overlap.
+   For this, the edges of the input graph are recorded during embedding
+   initialization.
+ */
+
+typedef struct
+{
+    // Helps distinguish initialize from re-initialize
+    int initialized;
+
+    // The graph that this context augments
+    graphP theGraph;
+
+    // The endpoints (in DFI order) of each edge of the input graph, recorded
+    // by _ProjectivePlanarity_EmbeddingInitialize(), and the number of edges
+    int *edgeList;
+    int numEdges;
+
+    // Set when the input graph was found to be nonplanar, in which case a
+    // successful test leaves the input graph, not an embedding, in theGraph
+    int nonplanar;
+
+    // Overloaded function pointers
+    graphFunctionTable functions;
+
+} ProjectivePlanarityContext;
+
+/* The search of the embedding cases of H by one thread of the projective
+   planarity test.  The graph being tested, H and the bridges of H are in
+   the workspace, and the search of each thread has the faces of the
+   embedding of H being extended and the state of the search for a bridge
+   placement, along with a graph for the planarity tests of bridges.
+ */
+
+typedef struct
+{
+    // The graph, H and the bridges of H, which are shared by all threads
+    kuratowskiBridgesP kb;
+
+    // A graph without extensions that is used for planarity tests of bridges
+    graphP testGraph;
+
+    // For bridges with at most three attachments, whether the bridge can be
+    // embedded in a face (1) or not (2) does not depend on the face, so the
+    // result is kept once known (0 otherwise)
+    int *fitsAnyFace;
+
+    // The faces of the embedding of H being extended, and for each face,
+    // the position on the face boundary of each vertex, or -1
+    int numFaces;
+    int faceStart[6], faceLength[6];
+    int *faceVertices, *facePosition;
+
+    // The search state: the faces still available to each bridge, the face
+    // assigned to each bridge or -1, the bridge and untried faces at each
+    // search level, and a trail of removed faces so they can be restored
+    int *available, *assigned;
+    int *levelBridge, *levelFaces, *levelTrail;
+    int *trail;
+    int trailSize;
+
+    // Scratch space for sorting face positions
+    int *positions;
+
+} ProjectivePlanaritySearch;
+
+/* The workspace used by the projective planarity test, which is sized by
+   the graph being tested, with N vertices starting from gp_GetFirstVertex().
+   It has the graph, H and the bridges of H, and a search of the embedding
+   cases of H for each thread.
+ */
+
+typedef struct
+{
+    // The graph being tested, its subgraph H, and the bridges of H
+    kuratowskiBridges kb;
+
+    // A graph without extensions that is used for planarity tests
+    graphP testGraph;
+
+    // The searches of the threads that try the embedding cases of H
+    int numThreads;
+    ProjectivePlanaritySearch *searches;
+
+} ProjectivePlanarityWorkspace;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,508 @@
+/*
+Planarity-Related Graph Algorithms Project
+Copyright (c) 1997-2012, John M. Boyer
+All rights reserved. Includes a reference implementation of the following:
+
+* John M. Boyer. "Subgraph Homeomorphism via the Edge Addition Planarity Algorithm".
+  Journal of Graph Algorithms and Applications, Vol. 16, no. 2, pp. 381-410, 2012.
+  http://www.jgaa.info/16/268.html
+
+* John M. Boyer. "A New Method for Efficiently Generating Planar Graph
+  Visibility Representations". In P. Eades and P. Healy, editors,
+  Proceedings of the 13th International Conference on Graph Drawing 2005,
+  Lecture Notes Comput. Sci., Volume 3843, pp. 508-511, Springer-Verlag, 2006.
+
+* John M. Boyer and Wendy J. Myrvold. "On the Cutting Edge: Simplified O(n)
+  Planarity by Edge Addition". Journal of Graph Algorithms and Applications,
+  Vol. 8, No. 3, pp. 241-273, 2004.
+  http://www.jgaa.info/08/91.html
+
+* John M. Boyer. "Simplified O(n) Algorithms for Planar Graph Embedding,
+  Kuratowski Subgraph Isolation, and Related Problems". Ph.D. Dissertation,
+  University of Victoria, 2001.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+  list of conditions and the following disclaimer in the documentation and/or
+  other materials provided with the distribution.
+
+* Neither the name of the Planarity-Related Graph Algorithms Project nor the names
+  of its contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdlib.h>
+
+#include "graphProjectivePlanarity.private.h"
+#include "graphProjectivePlanarity.h"
+
+extern int  _TestProjectivePlanarity(graphP theGraph, ProjectivePlanarityContext *context);
+extern int  _CheckProjectivePlanarityResult(graphP theGraph, int expectedResult);
+
+extern int  _IsolateKuratowskiSubgraph(graphP theGraph, int v, int R);
+extern int  _TestSubgraph(graphP theSubgraph, graphP theGraph);
+
+/* Forward declarations of local functions */
+
+void _ProjectivePlanarity_ClearStructures(ProjectivePlanarityContext *context);
+int  _ProjectivePlanarity_CreateStructures(ProjectivePlanarityContext *context);
+int  _ProjectivePlanarity_InitStructures(ProjectivePlanarityContext *context);
+
+/* Forward declarations of overloading functions */
+int  _ProjectivePlanarity_EmbeddingInitialize(graphP theGraph);
+int  _ProjectivePlanarity_HandleBlockedBicomp(graphP theGraph, int v, int RootVertex, int R);
+int  _ProjectivePlanarity_EmbedPostprocess(graphP theGraph, int v, int edgeEmbeddingResult);
+int  _ProjectivePlanarity_CheckEmbeddingIntegrity(graphP theGraph, graphP origGraph);
+int  _ProjectivePlanarity_CheckObstructionIntegrity(graphP theGraph, graphP origGraph);
+
+int  _ProjectivePlanarity_InitGraph(graphP theGraph, int N);
+void _ProjectivePlanarity_ReinitializeGraph(graphP theGraph);
+int  _ProjectivePlanarity_EnsureArcCapacity(graphP theGraph, int requiredArcCapacity);
+
+/* Forward declarations of functions used by the extension system */
+
+void *_ProjectivePlanarity_DupContext(void *pContext, void *theGraph);
+void _ProjectivePlanarity_FreeContext(void *);
+
+/****************************************************************************
+ * PROJECTIVEPLANARITY_ID - the integer identifier for this extension,
+ * enabling this feature's extension context to be distinguished from
+ * other features' extension contexts that may be attached to a graph.
+ ****************************************************************************/
+
+const int PROJECTIVEPLANARITY_ID = EXTENSIONID_PROJECTIVEPLANARITY;
+
+/****************************************************************************
+ gp_AttachProjectivePlanarity()
+
+ This function adjusts the graph data structure to attach the projective
+ planarity feature.
+ ****************************************************************************/
+
+int  gp_AttachProjectivePlanarity(graphP theGraph)
+{
+     ProjectivePlanarityContext *context = NULL;
+     int moduleID = PROJECTIVEPLANARITY_ID;
+
+     // If the projective planarity feature has already been attached to
+     // the graph, then there is no need to attach it again
+     gp_FindExtension(theGraph, PROJECTIVEPLANARITY_ID, (void *)&context);
+     if (context != NULL)
+     {
+         return OK;
+     }
+
+     // Allocate a new extension context
+     context = (ProjectivePlanarityContext *) malloc(sizeof(ProjectivePlanarityContext));
+     if (context == NULL)
+     {
+         return NOTOK;
+     }
+
+     // First, tell the context that it is not initialized
+     context->initialized = 0;
+
+     // Save a pointer to theGraph in the context
+     context->theGraph = theGraph;
+
+     // Put the overload functions into the context function table.
+     // gp_AddExtension will overload the graph's functions with these, and
+     // return the base function pointers in the context function table
+     memset(&context->functions, 0, sizeof(graphFunctionTable));
+     context->functions.fpEmbeddingInitialize = _ProjectivePlanarity_EmbeddingInitialize;
+     context->functions.fpHandleBlockedBicomp = _ProjectivePlanarity_HandleBlockedBicomp;
+     context->functions.fpEmbedPostprocess = _ProjectivePlanarity_EmbedPostprocess;
+     context->functions.fpCheckEmbeddingIntegrity = _ProjectivePlanarity_CheckEmbeddingIntegrity;
+     context->functions.fpCheckObstructionIntegrity = _ProjectivePlanarity_CheckObstructionIntegrity;
+
+     context->functions.fpInitGraph = _ProjectivePlanarity_InitGraph;
+     context->functions.fpReinitializeGraph = _ProjectivePlanarity_ReinitializeGraph;
+     context->functions.fpEnsureArcCapacity = _ProjectivePlanarity_EnsureArcCapacity;
+
+     _ProjectivePlanarity_ClearStructures(context);
+
+     // Store the projective planarity context, including the data structure
+     // and the function pointers, as an extension of the graph
+     if (gp_AddExtension(theGraph, &moduleID, (void *) context,
+                         _ProjectivePlanarity_DupContext, _ProjectivePlanarity_FreeContext,
+                         &context->functions) != OK)
+     {
+         _ProjectivePlanarity_FreeContext(context);
+         return NOTOK;
+     }
+
+     // Create the structures if the size of the graph is known
+     // Attach functions are always invoked after gp_New(), but if a graph
+     // extension must be attached before gp_Read(), then the attachment
+     // also happens before gp_InitGraph(), which means N==0.
+     // However, sometimes a feature is attached after gp_InitGraph(), in
+     // which case N > 0
+     if (theGraph->N > 0)
+     {
+         if (_ProjectivePlanarity_CreateStructures(context) != OK ||
+             _ProjectivePlanarity_InitStructures(context) != OK)
+         {
+             _ProjectivePlanarity_FreeContext(context);
+             return NOTOK;
+         }
+     }
+
+     return OK;
+}
+
+/********************************************************************
+ gp_DetachProjectivePlanarity()
+ ********************************************************************/
+
+int gp_DetachProjectivePlanarity(graphP theGraph)
+{
+    return gp_RemoveExtension(theGraph, PROJECTIVEPLANARITY_ID);
+}
+
+/********************************************************************
+ _ProjectivePlanarity_ClearStructures()
+ ********************************************************************/
+
+void _ProjectivePlanarity_ClearStructures(ProjectivePlanarityContext *context)
+{
+    if (!context->initialized)
+    {
+        // Before initialization, the pointers are stray, not NULL
+        // Once NULL or allocated, free() or LCFree() can do the job
+        context->edgeList = NULL;
+
+        context->initialized = 1;
+    }
+    else
+    {
+        if (context->edgeList != NULL)
+        {
+            free(context->edgeList);
+            context->edgeList = NULL;
+        }
+    }
+
+    context->numEdges = 0;
+    context->nonplanar = FALSE;
+}
+
+/********************************************************************
+ _ProjectivePlanarity_CreateStructures()
+ Create uninitialized structures for the vertex and edge levels, and
+ initialized structures for the graph level
+ ********************************************************************/
+int  _ProjectivePlanarity_CreateStructures(ProjectivePlanarityContext *context)
+{
+     // Two endpoints are recorded per edge, so one int per arc suffices
+     int Esize = gp_EdgeIndexBound(context->theGraph);
+
+     if (context->theGraph->N <= 0)
+         return NOTOK;
+
+     if ((context->edgeList = (int *) malloc(Esize*sizeof(int))) == NULL ||
+        0)
+     {
+         return NOTOK;
+     }
+
+     return OK;
+}
+
+/********************************************************************
+ _ProjectivePlanarity_InitStructures()
+ ********************************************************************/
+int  _ProjectivePlanarity_InitStructures(ProjectivePlanarityContext *context)
+{
+     context->numEdges = 0;
+     context->nonplanar = FALSE;
+
+     return OK;
+}
+
+/********************************************************************
+ ********************************************************************/
+
+int  _ProjectivePlanarity_InitGraph(graphP theGraph, int N)
+{
+    ProjectivePlanarityContext *context = NULL;
+    gp_FindExtension(theGraph, PROJECTIVEPLANARITY_ID, (void *)&context);
+
+    if (context == NULL)
+        return NOTOK;
+
+    theGraph->N = N;
+	theGraph->NV = N;
+	if (theGraph->arcCapacity == 0)
+		theGraph->arcCapacity = 2*DEFAULT_EDGE_LIMIT*N;
+
+	if (_ProjectivePlanarity_CreateStructures(context) != OK ||
+		_ProjectivePlanarity_InitStructures(context) != OK)
+		return NOTOK;
+
+	context->functions.fpInitGraph(theGraph, N);
+
+    return OK;
+}
+
+/********************************************************************
+ ********************************************************************/
+
+void _ProjectivePlanarity_ReinitializeGraph(graphP theGraph)
+{
+    ProjectivePlanarityContext *context = NULL;
+    gp_FindExtension(theGraph, PROJECTIVEPLANARITY_ID, (void *)&context);
+
+    if (context != NULL)
+    {
+		// Reinitialize the graph
+		context->functions.fpReinitializeGraph(theGraph);
+
+		// Do the reinitialization that is specific to this module
+		_ProjectivePlanarity_InitStructures(context);
+    }
+}
+
+/********************************************************************
+ The current implementation does not support an increase of arc
+ (edge record) capacity once the extension is attached to the graph
+ data structure.  This is only due to not being necessary to support.
+ For now, it is easy to ensure the correct capacity before attaching
+ the extension, but support could be added later if there is some
+ reason to do so.
+ ********************************************************************/
+
+int  _ProjectivePlanarity_EnsureArcCapacity(graphP theGraph, int requiredArcCapacity)
+{
+	return NOTOK;
+}
+
+/********************************************************************
+ _ProjectivePlanarity_DupContext()
+ ********************************************************************/
+
+void *_ProjectivePlanarity_DupContext(void *pContext, void *theGraph)
+{
+     ProjectivePlanarityContext *context = (ProjectivePlanarityContext *) pContext;
+     ProjectivePlanarityContext *newContext = (ProjectivePlanarityContext *) malloc(sizeof(ProjectivePlanarityContext));
+
+     if (newContext != NULL)
+     {
+         *newContext = *context;
+
+         newContext->theGraph = (graphP) theGraph;
+
+         newContext->initialized = 0;
+         _ProjectivePlanarity_ClearStructures(newContext);
+         if (((graphP) theGraph)->N > 0)
+         {
+             if (_ProjectivePlanarity_CreateStructures(newContext) != OK)
+             {
+                 _ProjectivePlanarity_FreeContext(newContext);
+                 return NULL;
+             }
+
+             newContext->numEdges = context->numEdges;
+             newContext->nonplanar = context->nonplanar;
+             memcpy(newContext->edgeList, context->edgeList, 2*context->numEdges*sizeof(int));
+         }
+     }
+
+     return newContext;
+}
+
+/********************************************************************
+ _ProjectivePlanarity_FreeContext()
+ ********************************************************************/
+
+void _ProjectivePlanarity_FreeContext(void *pContext)
+{
+     ProjectivePlanarityContext *context = (ProjectivePlanarityContext *) pContext;
+
+     _ProjectivePlanarity_ClearStructures(context);
+     free(pContext);
+}
+
+/********************************************************************
+ _ProjectivePlanarity_EmbeddingInitialize()
+
+ After the base embedding initialization, the vertices are in DFI order,
+ so the edges of the input graph are recorded in DFI order for use by
+ the projective planarity test if the graph is not planar.  Tree edges
+ are attached to virtual vertices at this point, so those endpoints are
+ converted to the corresponding primary vertices.
+ ********************************************************************/
+
+int  _ProjectivePlanarity_EmbeddingInitialize(graphP theGraph)
+{
+    ProjectivePlanarityContext *context = NULL;
+    int e, u, w, EsizeOccupied;
+
+    gp_FindExtension(theGraph, PROJECTIVEPLANARITY_ID, (void *)&context);
+    if (context == NULL)
+        return NOTOK;
+
+    if (context->functions.fpEmbeddingInitialize(theGraph) != OK)
+        return NOTOK;
+
+    if (theGraph->embedFlags == EMBEDFLAGS_PROJECTIVEPLANAR)
+    {
+        context->numEdges = 0;
+        context->nonplanar = FALSE;
+
+        EsizeOccupied = gp_EdgeInUseIndexBound(theGraph);
+        for (e = gp_GetFirstEdge(theGraph); e < EsizeOccupied; e += 2)
+        {
+            if (!gp_EdgeInUse(theGraph, e))
+                continue;
+
+            u = gp_GetNeighbor(theGraph, gp_GetTwinArc(theGraph, e));
+            w = gp_GetNeighbor(theGraph, e);
+
+            if (gp_IsVirtualVertex(theGraph, u))
+                u = gp_GetPrimaryVertexFromRoot(theGraph, u);
+            if (gp_IsVirtualVertex(theGraph, w))
+                w = gp_GetPrimaryVertexFromRoot(theGraph, w);
+
+            context->edgeList[2*context->numEdges] = u;
+            context->edgeList[2*context->numEdges+1] = w;
+            context->numEdges++;
+        }
+    }
+
+    return OK;
+}
+
+/********************************************************************
+ _ProjectivePlanarity_HandleBlockedBicomp()
+ Returns NONEMBEDDABLE to terminate the Walkdown once a K5 or K_{3,3}
+             homeomorph has been isolated for the projective planarity
+             test in the postprocessing
+         NOTOK on internal error
+ ********************************************************************/
+
+int  _ProjectivePlanarity_HandleBlockedBicomp(graphP theGraph, int v, int RootVertex, int R)
+{
+	ProjectivePlanarityContext *context = NULL;
+
+	gp_FindExtension(theGraph, PROJECTIVEPLANARITY_ID, (void *)&context);
+	if (context == NULL)
+		return NOTOK;
+
+    if (theGraph->embedFlags == EMBEDFLAGS_PROJECTIVEPLANAR)
+    {
+    	// The isolator expects the descendant bicomp root on the stack,
+    	// as in the core planarity handler of a blocked bicomp
+    	if (R != RootVertex)
+    	    sp_Push2(theGraph->theStack, R, 0);
+
+    	if (_IsolateKuratowskiSubgraph(theGraph, v, RootVertex) != OK)
+    	    return NOTOK;
+
+    	context->nonplanar = TRUE;
+    	return NONEMBEDDABLE;
+    }
+    else
+    {
+    	return context->functions.fpHandleBlockedBicomp(theGraph, v, RootVertex, R);
+    }
+
+    return NOTOK;
+}
+
+/********************************************************************
+ ********************************************************************/
+
+int  _ProjectivePlanarity_EmbedPostprocess(graphP theGraph, int v, int edgeEmbeddingResult)
+{
+     ProjectivePlanarityContext *context = NULL;
+     gp_FindExtension(theGraph, PROJECTIVEPLANARITY_ID, (void *)&context);
+
+     if (context == NULL)
+         return NOTOK;
+
+     // If a K5 or K_{3,3} homeomorph was isolated, then the input graph
+     // is tested for an embedding in the projective plane
+     if (theGraph->embedFlags == EMBEDFLAGS_PROJECTIVEPLANAR &&
+         edgeEmbeddingResult == NONEMBEDDABLE && context->nonplanar)
+     {
+         return _TestProjectivePlanarity(theGraph, context);
+     }
+
+     // Otherwise, the superclass finishes the planar embedding
+     return context->functions.fpEmbedPostprocess(theGraph, v, edgeEmbeddingResult);
+}
+
+/********************************************************************
+ ********************************************************************/
+
+int  _ProjectivePlanarity_CheckEmbeddingIntegrity(graphP theGraph, graphP origGraph)
+{
+     ProjectivePlanarityContext *context = NULL;
+     gp_FindExtension(theGraph, PROJECTIVEPLANARITY_ID, (void *)&context);
+
+     if (context == NULL)
+         return NOTOK;
+
+     // An OK result for a nonplanar graph leaves theGraph with the edges
+     // of the input graph, but not with an embedding, so we ensure the two
+     // graphs are the same and that the test result can be reproduced
+     if (theGraph->embedFlags == EMBEDFLAGS_PROJECTIVEPLANAR && context->nonplanar)
+     {
+         if (_TestSubgraph(theGraph, origGraph) != TRUE ||
+             _TestSubgraph(origGraph, theGraph) != TRUE)
+             return NOTOK;
+
+         return _CheckProjectivePlanarityResult(theGraph, OK);
+     }
+
+     // Otherwise, theGraph contains a planar embedding, which the
+     // superclass checks
+     return context->functions.fpCheckEmbeddingIntegrity(theGraph, origGraph);
+}
+
+/********************************************************************
+ ********************************************************************/
+
+int  _ProjectivePlanarity_CheckObstructionIntegrity(graphP theGraph, graphP origGraph)
+{
+     // For the projective planarity test, we ensure that theGraph is a
+     // subgraph of the original graph that does not embed in the
+     // projective plane
+     if (theGraph->embedFlags == EMBEDFLAGS_PROJECTIVEPLANAR)
+     {
+        if (_TestSubgraph(theGraph, origGraph) != TRUE)
+            return NOTOK;
+
+        return _CheckProjectivePlanarityResult(theGraph, NONEMBEDDABLE);
+     }
+
+     // When not testing projective planarity, we let the superclass do the work
+     else
+     {
+        ProjectivePlanarityContext *context = NULL;
+        gp_FindExtension(theGraph, PROJECTIVEPLANARITY_ID, (void *)&context);
+
+        if (context != NULL)
+        {
+            return context->functions.fpCheckObstructionIntegrity(theGraph, origGraph);
+        }
+     }
+
+     return NOTOK;
+}
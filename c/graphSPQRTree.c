@@ -0,0 +1,1983 @@
+/*
+Planarity-Related Graph Algorithms Project
+Copyright (c) 1997-2012, John M. Boyer
+All rights reserved. Includes a reference implementation of the following:
+
+* John M. Boyer. "Subgraph Homeomorphism via the Edge Addition Planarity Algorithm".
+  Journal of Graph Algorithms and Applications, Vol. 16, no. 2, pp. 381-410, 2012.
+  http://www.jgaa.info/16/268.html
+
+* John M. Boyer. "A New Method for Efficiently Generating Planar Graph
+  Visibility Representations". In P. Eades and P. Healy, editors,
+  Proceedings of the 13th International Conference on Graph Drawing 2005,
+  Lecture Notes Comput. Sci., Volume 3843, pp. 508-511, Springer-Verlag, 2006.
+
+* John M. Boyer and Wendy J. Myrvold. "On the Cutting Edge: Simplified O(n)
+  Planarity by Edge Addition". Journal of Graph Algorithms and Applications,
+  Vol. 8, No. 3, pp. 241-273, 2004.
+  http://www.jgaa.info/08/91.html
+
+* John M. Boyer. "Simplified O(n) Algorithms for Planar Graph Embedding,
+  Kuratowski Subgraph Isolation, and Related Problems". Ph.D. Dissertation,
+  University of Victoria, 2001.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+  list of conditions and the following disclaimer in the documentation and/or
+  other materials provided with the distribution.
+
+* Neither the name of the Planarity-Related Graph Algorithms Project nor the names
+  of its contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "graphSPQRTree.h"
+#include "graphSPQRTree.private.h"
+
+extern const int SPQRTREE_ID;
+
+#include "graph.h"
+
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+extern int  _TestSubgraph(graphP theSubgraph, graphP theGraph);
+
+extern void _SPQRTree_ClearStructures(SPQRTreeContext *context);
+
+/* Edge types and split component types used during the decomposition */
+
+#define SPQR_UNSEEN     0
+#define SPQR_TREE       1
+#define SPQR_FROND      2
+#define SPQR_REMOVED    3
+
+#define SPQR_BOND       SPQRTREE_PNODE
+#define SPQR_POLYGON    SPQRTREE_SNODE
+#define SPQR_TRICONN    SPQRTREE_RNODE
+
+// The triples on the TSTACK are separated by end-of-stack markers,
+// represented by the tstackA value -1
+#define SPQR_EOS        -1
+
+/* Private functions */
+
+int  _SPQRTree_NewWorkspace(SPQRTreeWorkspace *ws, int N, int M);
+void _SPQRTree_FreeWorkspace(SPQRTreeWorkspace *ws);
+int  _SPQRTree_FindBlocks(graphP theGraph, SPQRTreeWorkspace *ws);
+int  _SPQRTree_DecomposeBlock(SPQRTreeContext *context, graphP theGraph, SPQRTreeWorkspace *ws, int b);
+int  _SPQRTree_SplitMultiEdges(SPQRTreeWorkspace *ws);
+void _SPQRTree_ComputeLowpoints(SPQRTreeWorkspace *ws);
+void _SPQRTree_BuildAcceptableAdjStruct(SPQRTreeWorkspace *ws);
+void _SPQRTree_PathFinder(SPQRTreeWorkspace *ws);
+int  _SPQRTree_PathSearch(SPQRTreeWorkspace *ws);
+void _SPQRTree_Assemble(SPQRTreeWorkspace *ws);
+int  _SPQRTree_AppendTree(SPQRTreeContext *context, SPQRTreeWorkspace *ws);
+int  _SPQRTree_EnsureCapacity(SPQRTreeContext *context, int numNodes, int numSkeletonEdges);
+
+int  _SPQRTree_NewEdge(SPQRTreeWorkspace *ws, int u, int v);
+int  _SPQRTree_NewComp(SPQRTreeWorkspace *ws, int type);
+void _SPQRTree_AddToComp(SPQRTreeWorkspace *ws, int c, int e);
+void _SPQRTree_FinishTricOrPoly(SPQRTreeWorkspace *ws, int c, int e);
+void _SPQRTree_DelAdj(SPQRTreeWorkspace *ws, int v, int node);
+void _SPQRTree_DelHigh(SPQRTreeWorkspace *ws, int e);
+int  _SPQRTree_FindComp(SPQRTreeWorkspace *ws, int c);
+int  _SPQRTree_CheckMissingEdgesAreBridges(graphP theGraph, int *edgeSeen, int *parent);
+int  _SPQRTree_CheckSkeleton(SPQRTreeContext *context, int i, int *head, int *slotNext, int *mark);
+
+#define _SPQRTree_High(ws, v) \
+        (ws->highHead[v] == NIL ? 0 : ws->highVal[ws->highHead[v]])
+
+#define _SPQRTree_FirstChild(ws, v) \
+        (ws->tgt[ws->adjEdge[ws->adjHead[v]]])
+
+#define _SPQRTree_TStackPush(ws, h, a, b) \
+        { ++ws->tTop; ws->tstackH[ws->tTop] = h; ws->tstackA[ws->tTop] = a; ws->tstackB[ws->tTop] = b; }
+
+/********************************************************************
+ gp_SPQRTree()
+
+ Decomposes each biconnected component of theGraph into its
+ triconnected components and organizes them into an SPQR tree, using
+ the linear-time path search of Hopcroft and Tarjan as corrected by
+ Gutwenger and Mutzel ("A Linear Time Implementation of SPQR-Trees",
+ Graph Drawing 2000, LNCS 1984, pp. 77-90).
+
+ The DFS tree and lowpoints of gp_CreateDFSTree() and
+ gp_LowpointAndLeastAncestor() give the biconnected components and
+ the palm tree within each of them, so the decomposition of each
+ component starts from its acceptable adjacency structure.  Each
+ biconnected component with two or more edges yields one SPQR tree.
+ Bridges and self-loops are not represented.  The skeleton vertices are
+ given in the vertex numbering of theGraph at the time of the call,
+ and theGraph is returned to that numbering.  Apart from the order of
+ the adjacency lists, which gp_CreateDFSTree() may change, theGraph is
+ unchanged.
+
+ The result is available by gp_SPQRTree_GetNumTrees() and the related
+ accessor functions, and by gp_SPQRTree_WriteTree().
+
+ Returns OK on success, NOTOK on failure
+ ********************************************************************/
+
+int gp_SPQRTree(graphP theGraph)
+{
+    SPQRTreeContext *context = NULL;
+    SPQRTreeWorkspace ws;
+    int wasSorted, b, k, Result = OK;
+
+    if (theGraph == NULL)
+        return NOTOK;
+
+    // Attach the algorithm if it is not already attached
+    if (gp_AttachSPQRTree(theGraph) != OK)
+        return NOTOK;
+
+    gp_FindExtension(theGraph, SPQRTREE_ID, (void *)&context);
+    _SPQRTree_ClearStructures(context);
+
+    // Obtain the DFS tree and lowpoints, which leaves the graph sorted by DFI
+    wasSorted = theGraph->internalFlags & FLAGS_SORTEDBYDFI;
+    if (gp_LowpointAndLeastAncestor(theGraph) != OK)
+        return NOTOK;
+
+    if (_SPQRTree_NewWorkspace(&ws, theGraph->N, theGraph->M) != OK ||
+        _SPQRTree_FindBlocks(theGraph, &ws) != OK ||
+        _SPQRTree_EnsureCapacity(context, 0, 0) != OK)
+        Result = NOTOK;
+
+    for (b = 0; b < ws.numBlocks && Result == OK; b++)
+    {
+        if (_SPQRTree_DecomposeBlock(context, theGraph, &ws, b) != OK)
+            Result = NOTOK;
+    }
+
+    _SPQRTree_FreeWorkspace(&ws);
+
+    if (Result == OK)
+        context->treeFirstNode[context->numTrees] = context->numNodes;
+
+    // Give the skeleton vertices in the numbering of the graph as it was given
+    if (!wasSorted)
+    {
+        for (k = 0; k < context->numSkeletonEdges; k++)
+        {
+            context->skeletonU[k] = gp_GetVertexIndex(theGraph, context->skeletonU[k]);
+            context->skeletonV[k] = gp_GetVertexIndex(theGraph, context->skeletonV[k]);
+        }
+
+        if (gp_SortVertices(theGraph) != OK)
+            Result = NOTOK;
+    }
+
+    if (Result != OK)
+        _SPQRTree_ClearStructures(context);
+
+    return Result;
+}
+
+/********************************************************************
+ _SPQRTree_NewWorkspace()
+
+ The bound of 2m on the number of edges of one block, including the
+ virtual edges, follows from the split components having at most 3m-6
+ edges in total and each virtual edge belonging to two of them.
+ ********************************************************************/
+
+int  _SPQRTree_NewWorkspace(SPQRTreeWorkspace *ws, int N, int M)
+{
+    int Vsize = N + 2, Esize = 2*M + 8, Csize = Esize + 2, Isize = 3*Esize + 8;
+    int Ssize = 3*N + 4 > Esize ? 3*N + 4 : Esize;
+    int **vertexArrays[] = {
+            &ws->blockOf, &ws->localNum, &ws->blockRoot, &ws->blockVertexFirst, &ws->blockVertices,
+            &ws->blockVertex, &ws->father, &ws->treeArc, &ws->degree,
+            &ws->lowpt1, &ws->lowpt2, &ws->nd, &ws->newnum, &ws->nodeAt,
+            &ws->adjHead, &ws->adjTail, &ws->highHead, &ws->highTail,
+            &ws->curNode, &ws->nextNode, &ws->curEdge, &ws->treeArcsLeft, &ws->vertexStack };
+    int **edgeArrays[] = {
+            &ws->blockEdgeFirst, &ws->blockEdges,
+            &ws->src, &ws->tgt, &ws->type, &ws->orig, &ws->start, &ws->inAdj, &ws->inHigh,
+            &ws->comp1, &ws->item1, &ws->comp2, &ws->item2,
+            &ws->adjEdge, &ws->adjNext, &ws->adjPrev, &ws->highVal, &ws->highNext, &ws->highPrev,
+            &ws->tstackH, &ws->tstackA, &ws->tstackB, &ws->estack };
+    int **compArrays[] = { &ws->compType, &ws->compSentinel, &ws->compMergedInto, &ws->compNode };
+    int **entryArrays[] = { &ws->entryEdge, &ws->entryNext, &ws->entryPrev };
+    int **sortArrays[] = { &ws->bucketCount, &ws->sortTemp, &ws->sortKey };
+    int i, Result = OK;
+
+    memset(ws, 0, sizeof(SPQRTreeWorkspace));
+    ws->edgeCapacity = Esize - 1;
+
+    for (i = 0; i < (int) (sizeof(vertexArrays)/sizeof(int **)); i++)
+        if ((*vertexArrays[i] = (int *) malloc(Vsize*sizeof(int))) == NULL)
+            Result = NOTOK;
+    for (i = 0; i < (int) (sizeof(edgeArrays)/sizeof(int **)); i++)
+        if ((*edgeArrays[i] = (int *) malloc(Esize*sizeof(int))) == NULL)
+            Result = NOTOK;
+    for (i = 0; i < (int) (sizeof(compArrays)/sizeof(int **)); i++)
+        if ((*compArrays[i] = (int *) malloc(Csize*sizeof(int))) == NULL)
+            Result = NOTOK;
+    for (i = 0; i < (int) (sizeof(entryArrays)/sizeof(int **)); i++)
+        if ((*entryArrays[i] = (int *) malloc(Isize*sizeof(int))) == NULL)
+            Result = NOTOK;
+    for (i = 0; i < (int) (sizeof(sortArrays)/sizeof(int **)); i++)
+        if ((*sortArrays[i] = (int *) malloc(Ssize*sizeof(int))) == NULL)
+            Result = NOTOK;
+
+    return Result;
+}
+
+/********************************************************************
+ _SPQRTree_FreeWorkspace()
+ ********************************************************************/
+
+void _SPQRTree_FreeWorkspace(SPQRTreeWorkspace *ws)
+{
+    int *arrays[] = {
+            ws->blockOf, ws->localNum, ws->blockRoot, ws->blockVertexFirst, ws->blockVertices,
+            ws->blockVertex, ws->father, ws->treeArc, ws->degree,
+            ws->lowpt1, ws->lowpt2, ws->nd, ws->newnum, ws->nodeAt,
+            ws->adjHead, ws->adjTail, ws->highHead, ws->highTail,
+            ws->curNode, ws->nextNode, ws->curEdge, ws->treeArcsLeft, ws->vertexStack,
+            ws->blockEdgeFirst, ws->blockEdges,
+            ws->src, ws->tgt, ws->type, ws->orig, ws->start, ws->inAdj, ws->inHigh,
+            ws->comp1, ws->item1, ws->comp2, ws->item2,
+            ws->adjEdge, ws->adjNext, ws->adjPrev, ws->highVal, ws->highNext, ws->highPrev,
+            ws->tstackH, ws->tstackA, ws->tstackB, ws->estack,
+            ws->compType, ws->compSentinel, ws->compMergedInto, ws->compNode,
+            ws->entryEdge, ws->entryNext, ws->entryPrev,
+            ws->bucketCount, ws->sortTemp, ws->sortKey };
+    int i;
+
+    for (i = 0; i < (int) (sizeof(arrays)/sizeof(int *)); i++)
+        if (arrays[i] != NULL)
+            free(arrays[i]);
+
+    memset(ws, 0, sizeof(SPQRTreeWorkspace));
+}
+
+/********************************************************************
+ _SPQRTree_FindBlocks()
+
+ With the graph sorted by DFI, a DFS child w of v begins a new block
+ rooted at v if lowpoint(w) >= v, and otherwise w is in the block of v.
+ The vertices of each block other than its root are numbered from 2
+ in DFI order, which restricts the DFS preorder to the block.  Each
+ edge belongs to the block of its descendant endpoint.  The block
+ vertices and edges are then bucketed by block.
+ ********************************************************************/
+
+int  _SPQRTree_FindBlocks(graphP theGraph, SPQRTreeWorkspace *ws)
+{
+    int v, p, b, e, u, w, *blockSize = ws->sortTemp, *edgeCount = ws->sortKey;
+
+    ws->numBlocks = 0;
+    for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
+    {
+        p = gp_GetVertexParent(theGraph, v);
+        if (gp_IsNotVertex(p))
+            ws->blockOf[v] = -1;
+        else if (gp_GetVertexLowpoint(theGraph, v) >= p)
+        {
+            b = ws->numBlocks++;
+            ws->blockOf[v] = b;
+            ws->blockRoot[b] = p;
+            blockSize[b] = 1;
+            edgeCount[b] = 0;
+            ws->localNum[v] = ++blockSize[b];
+        }
+        else
+        {
+            b = ws->blockOf[v] = ws->blockOf[p];
+            ws->localNum[v] = ++blockSize[b];
+        }
+    }
+
+    // Bucket the non-root vertices of the blocks
+    ws->blockVertexFirst[0] = 0;
+    for (b = 0; b < ws->numBlocks; b++)
+        ws->blockVertexFirst[b+1] = ws->blockVertexFirst[b] + blockSize[b] - 1;
+    for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
+    {
+        if ((b = ws->blockOf[v]) >= 0)
+            ws->blockVertices[ws->blockVertexFirst[b] + ws->localNum[v] - 2] = v;
+    }
+
+    // Count, then bucket, the edges of the blocks
+    for (e = gp_GetFirstEdge(theGraph); e < gp_EdgeInUseIndexBound(theGraph); e += 2)
+    {
+        if (!gp_EdgeInUse(theGraph, e))
+            continue;
+        u = gp_GetNeighbor(theGraph, e);
+        w = gp_GetNeighbor(theGraph, gp_GetTwinArc(theGraph, e));
+        if (u != w)
+            edgeCount[ws->blockOf[u > w ? u : w]]++;
+    }
+
+    ws->blockEdgeFirst[0] = 0;
+    for (b = 0; b < ws->numBlocks; b++)
+    {
+        ws->blockEdgeFirst[b+1] = ws->blockEdgeFirst[b] + edgeCount[b];
+        edgeCount[b] = ws->blockEdgeFirst[b];
+    }
+
+    for (e = gp_GetFirstEdge(theGraph); e < gp_EdgeInUseIndexBound(theGraph); e += 2)
+    {
+        if (!gp_EdgeInUse(theGraph, e))
+            continue;
+        u = gp_GetNeighbor(theGraph, e);
+        w = gp_GetNeighbor(theGraph, gp_GetTwinArc(theGraph, e));
+        if (u != w)
+            ws->blockEdges[edgeCount[ws->blockOf[u > w ? u : w]]++] = e;
+    }
+
+    return OK;
+}
+
+/********************************************************************
+ _SPQRTree_DecomposeBlock()
+
+ Sets up the local vertices and edges of block b, decomposes them into
+ split components, merges the split components into the triconnected
+ components, and appends the resulting SPQR tree to the context.
+ ********************************************************************/
+
+int  _SPQRTree_DecomposeBlock(SPQRTreeContext *context, graphP theGraph, SPQRTreeWorkspace *ws, int b)
+{
+    int first = ws->blockEdgeFirst[b], m = ws->blockEdgeFirst[b+1] - first;
+    int root = ws->blockRoot[b], i, v, e, u, w, x, c;
+
+    // A bridge is not decomposed
+    if (m < 2)
+        return OK;
+
+    // Set up the local vertices
+    ws->n = ws->blockVertexFirst[b+1] - ws->blockVertexFirst[b] + 1;
+    ws->blockVertex[1] = root;
+    for (i = 2; i <= ws->n; i++)
+        ws->blockVertex[i] = ws->blockVertices[ws->blockVertexFirst[b] + i - 2];
+
+    for (v = 1; v <= ws->n; v++)
+    {
+        ws->father[v] = ws->treeArc[v] = NIL;
+        ws->degree[v] = 0;
+        ws->adjHead[v] = ws->adjTail[v] = ws->highHead[v] = ws->highTail[v] = NIL;
+        ws->treeArcsLeft[v] = 0;
+        if (v > 1)
+        {
+            u = gp_GetVertexParent(theGraph, ws->blockVertex[v]);
+            ws->father[v] = u == root ? 1 : ws->localNum[u];
+        }
+    }
+
+    // Set up the local edges, with tree arcs directed from parent to
+    // child and fronds directed from descendant to ancestor
+    ws->numEdges = ws->numComps = ws->numEntries = 0;
+    for (i = 0; i < m; i++)
+    {
+        e = ws->blockEdges[first + i];
+        u = gp_GetNeighbor(theGraph, e);
+        w = gp_GetNeighbor(theGraph, gp_GetTwinArc(theGraph, e));
+        u = u == root ? 1 : ws->localNum[u];
+        w = w == root ? 1 : ws->localNum[w];
+        if (u > w)
+        {
+            x = u; u = w; w = x;
+        }
+
+        x = gp_GetEdgeType(theGraph, e) == EDGE_TYPE_CHILD || gp_GetEdgeType(theGraph, e) == EDGE_TYPE_PARENT;
+        c = x ? _SPQRTree_NewEdge(ws, u, w) : _SPQRTree_NewEdge(ws, w, u);
+        ws->type[c] = x ? SPQR_TREE : SPQR_FROND;
+        ws->orig[c] = e;
+    }
+
+    // A block with two vertices is a bond of its edges
+    if (ws->n == 2)
+    {
+        c = _SPQRTree_NewComp(ws, SPQR_BOND);
+        for (e = 1; e <= ws->numEdges; e++)
+            _SPQRTree_AddToComp(ws, c, e);
+        return _SPQRTree_AppendTree(context, ws);
+    }
+
+    // Split off the multiple edges, then decompose the remaining simple block
+    if (_SPQRTree_SplitMultiEdges(ws) != OK)
+        return NOTOK;
+
+    _SPQRTree_ComputeLowpoints(ws);
+    _SPQRTree_BuildAcceptableAdjStruct(ws);
+    _SPQRTree_PathFinder(ws);
+
+    if (_SPQRTree_PathSearch(ws) != OK)
+        return NOTOK;
+
+    // The edges remaining on the edge stack form the last split component
+    if (ws->eTop > 0)
+    {
+        c = _SPQRTree_NewComp(ws, SPQR_POLYGON);
+        while (ws->eTop > 1)
+            _SPQRTree_AddToComp(ws, c, ws->estack[ws->eTop--]);
+        _SPQRTree_FinishTricOrPoly(ws, c, ws->estack[ws->eTop--]);
+    }
+
+    if (ws->numEdges > ws->edgeCapacity)
+        return NOTOK;
+
+    _SPQRTree_Assemble(ws);
+
+    return _SPQRTree_AppendTree(context, ws);
+}
+
+/********************************************************************
+ _SPQRTree_SplitMultiEdges()
+
+ Bucket sorts the edges by their endpoints so that the edges joining
+ the same pair of vertices are consecutive.  Each bundle of two or
+ more such edges is replaced by one virtual edge, which is a tree arc
+ if the bundle contains the tree arc, and the bundle together with the
+ virtual edge forms a bond.  Then the degrees and the tree arcs of the
+ vertices are obtained from the remaining edges.
+ ********************************************************************/
+
+int  _SPQRTree_SplitMultiEdges(SPQRTreeWorkspace *ws)
+{
+    int n = ws->n, m = ws->numEdges, *count = ws->bucketCount;
+    int *byHigh = ws->sortKey, *sorted = ws->sortTemp;
+    int i, j, k, e, lo, hi, c, ev, isTree;
+
+    // Sort by the higher endpoint, then stably by the lower endpoint
+    for (i = 0; i <= n + 1; i++)
+        count[i] = 0;
+    for (e = 1; e <= m; e++)
+        count[ws->src[e] > ws->tgt[e] ? ws->src[e] : ws->tgt[e]]++;
+    for (i = 1; i <= n + 1; i++)
+        count[i] += count[i-1];
+    for (e = m; e >= 1; e--)
+        byHigh[--count[ws->src[e] > ws->tgt[e] ? ws->src[e] : ws->tgt[e]]] = e;
+
+    for (i = 0; i <= n + 1; i++)
+        count[i] = 0;
+    for (e = 1; e <= m; e++)
+        count[ws->src[e] < ws->tgt[e] ? ws->src[e] : ws->tgt[e]]++;
+    for (i = 1; i <= n + 1; i++)
+        count[i] += count[i-1];
+    for (k = m - 1; k >= 0; k--)
+    {
+        e = byHigh[k];
+        sorted[--count[ws->src[e] < ws->tgt[e] ? ws->src[e] : ws->tgt[e]]] = e;
+    }
+
+    // Replace each bundle of multiple edges by a virtual edge
+    for (i = 0; i < m; i = j)
+    {
+        e = sorted[i];
+        lo = ws->src[e] < ws->tgt[e] ? ws->src[e] : ws->tgt[e];
+        hi = ws->src[e] > ws->tgt[e] ? ws->src[e] : ws->tgt[e];
+        isTree = ws->type[e] == SPQR_TREE;
+
+        for (j = i + 1; j < m; j++)
+        {
+            e = sorted[j];
+            if ((ws->src[e] < ws->tgt[e] ? ws->src[e] : ws->tgt[e]) != lo ||
+                (ws->src[e] > ws->tgt[e] ? ws->src[e] : ws->tgt[e]) != hi)
+                break;
+            if (ws->type[e] == SPQR_TREE)
+                isTree = 1;
+        }
+
+        if (j - i > 1)
+        {
+            ev = isTree ? _SPQRTree_NewEdge(ws, lo, hi) : _SPQRTree_NewEdge(ws, hi, lo);
+            ws->type[ev] = isTree ? SPQR_TREE : SPQR_FROND;
+
+            c = _SPQRTree_NewComp(ws, SPQR_BOND);
+            for (k = i; k < j; k++)
+            {
+                _SPQRTree_AddToComp(ws, c, sorted[k]);
+                ws->type[sorted[k]] = SPQR_REMOVED;
+            }
+            _SPQRTree_AddToComp(ws, c, ev);
+        }
+    }
+
+    for (e = 1; e <= ws->numEdges; e++)
+    {
+        if (ws->type[e] == SPQR_REMOVED)
+            continue;
+
+        ws->degree[ws->src[e]]++;
+        ws->degree[ws->tgt[e]]++;
+        if (ws->type[e] == SPQR_TREE)
+            ws->treeArc[ws->tgt[e]] = e;
+    }
+
+    // Each non-root vertex of a biconnected block must have a tree arc
+    for (i = 2; i <= n; i++)
+        if (ws->treeArc[i] == NIL)
+            return NOTOK;
+
+    return OK;
+}
+
+/********************************************************************
+ _SPQRTree_ComputeLowpoints()
+
+ The local numbers are a DFS preorder, so processing the vertices in
+ decreasing order visits each DFS child before its parent.  The first
+ and second lowpoints are the least and the second least distinct
+ numbers among a vertex, the heads of the fronds from its subtree and
+ no others, and ND is the number of descendants including the vertex.
+ ********************************************************************/
+
+void _SPQRTree_ComputeLowpoints(SPQRTreeWorkspace *ws)
+{
+    int n = ws->n, v, p, e, a;
+
+    for (v = 1; v <= n; v++)
+    {
+        ws->lowpt1[v] = ws->lowpt2[v] = v;
+        ws->nd[v] = 1;
+    }
+
+    for (e = 1; e <= ws->numEdges; e++)
+    {
+        if (ws->type[e] != SPQR_FROND)
+            continue;
+
+        v = ws->src[e];
+        a = ws->tgt[e];
+        if (a < ws->lowpt1[v])
+        {
+            ws->lowpt2[v] = ws->lowpt1[v];
+            ws->lowpt1[v] = a;
+        }
+        else if (a > ws->lowpt1[v] && a < ws->lowpt2[v])
+            ws->lowpt2[v] = a;
+    }
+
+    for (v = n; v > 1; v--)
+    {
+        p = ws->father[v];
+        if (ws->lowpt1[v] < ws->lowpt1[p])
+        {
+            ws->lowpt2[p] = ws->lowpt1[p] < ws->lowpt2[v] ? ws->lowpt1[p] : ws->lowpt2[v];
+            ws->lowpt1[p] = ws->lowpt1[v];
+        }
+        else if (ws->lowpt1[v] == ws->lowpt1[p])
+        {
+            if (ws->lowpt2[v] < ws->lowpt2[p])
+                ws->lowpt2[p] = ws->lowpt2[v];
+        }
+        else if (ws->lowpt1[v] < ws->lowpt2[p])
+            ws->lowpt2[p] = ws->lowpt1[v];
+
+        ws->nd[p] += ws->nd[v];
+    }
+}
+
+/********************************************************************
+ _SPQRTree_BuildAcceptableAdjStruct()
+
+ Orders the adjacency list of each vertex v by the value phi of its
+ edges, which is 3*lowpt1(w) for a tree arc v->w with lowpt2(w) < v,
+ 3*lowpt1(w)+2 for any other tree arc v->w, and 3*w+1 for a frond v->w.
+ ********************************************************************/
+
+void _SPQRTree_BuildAcceptableAdjStruct(SPQRTreeWorkspace *ws)
+{
+    int n = ws->n, maxPhi = 3*n + 2, *count = ws->bucketCount, *sorted = ws->sortTemp;
+    int *phi = ws->sortKey, i, k, e, v, w, numLive = 0;
+
+    for (i = 0; i <= maxPhi + 1; i++)
+        count[i] = 0;
+
+    for (e = 1; e <= ws->numEdges; e++)
+    {
+        ws->inAdj[e] = ws->inHigh[e] = NIL;
+        ws->start[e] = 0;
+        if (ws->type[e] == SPQR_REMOVED)
+            continue;
+
+        v = ws->src[e];
+        w = ws->tgt[e];
+        if (ws->type[e] == SPQR_FROND)
+            phi[e] = 3*w + 1;
+        else
+        {
+            phi[e] = ws->lowpt2[w] < v ? 3*ws->lowpt1[w] : 3*ws->lowpt1[w] + 2;
+            ws->treeArcsLeft[v]++;
+        }
+        count[phi[e]]++;
+        numLive++;
+    }
+
+    for (i = 1; i <= maxPhi + 1; i++)
+        count[i] += count[i-1];
+    for (e = ws->numEdges; e >= 1; e--)
+        if (ws->type[e] != SPQR_REMOVED)
+            sorted[--count[phi[e]]] = e;
+
+    // Append the edges to the adjacency lists in phi order.  The list
+    // node of each edge has the same index as the edge.
+    for (k = 0; k < numLive; k++)
+    {
+        e = sorted[k];
+        v = ws->src[e];
+        ws->adjEdge[e] = e;
+        ws->adjNext[e] = NIL;
+        ws->adjPrev[e] = ws->adjTail[v];
+        if (ws->adjTail[v] == NIL)
+            ws->adjHead[v] = e;
+        else
+            ws->adjNext[ws->adjTail[v]] = e;
+        ws->adjTail[v] = e;
+        ws->inAdj[e] = e;
+    }
+}
+
+/********************************************************************
+ _SPQRTree_PathFinder()
+
+ A DFS that follows the acceptable adjacency structure to renumber the
+ vertices so that the vertices of each subtree are numbered from the
+ last child to the first, to mark the edges that start a path, and to
+ make the high point list of each vertex, i.e. the sources of its
+ incoming fronds in the order in which they are visited.  The DFS is
+ iterative, so curNode gives the next adjacency list node of each
+ vertex on the stack.  The lowpoints are then renumbered.
+ ********************************************************************/
+
+void _SPQRTree_PathFinder(SPQRTreeWorkspace *ws)
+{
+    int numCount = ws->n, newPath = 1, sp = 0, v, w, e, node;
+
+    ws->newnum[1] = numCount - ws->nd[1] + 1;
+    ws->vertexStack[sp++] = 1;
+    ws->curNode[1] = ws->adjHead[1];
+
+    while (sp > 0)
+    {
+        v = ws->vertexStack[sp-1];
+        node = ws->curNode[v];
+
+        if (node == NIL)
+        {
+            if (--sp > 0)
+                numCount--;
+            continue;
+        }
+
+        e = ws->adjEdge[node];
+        ws->curNode[v] = ws->adjNext[node];
+
+        if (newPath)
+        {
+            newPath = 0;
+            ws->start[e] = 1;
+        }
+
+        w = ws->tgt[e];
+        if (ws->type[e] == SPQR_TREE)
+        {
+            ws->newnum[w] = numCount - ws->nd[w] + 1;
+            ws->vertexStack[sp++] = w;
+            ws->curNode[w] = ws->adjHead[w];
+        }
+        else
+        {
+            // Append newnum(v) to the high point list of w
+            ws->highVal[e] = ws->newnum[v];
+            ws->highNext[e] = NIL;
+            ws->highPrev[e] = ws->highTail[w];
+            if (ws->highTail[w] == NIL)
+                ws->highHead[w] = e;
+            else
+                ws->highNext[ws->highTail[w]] = e;
+            ws->highTail[w] = e;
+            ws->inHigh[e] = e;
+
+            newPath = 1;
+        }
+    }
+
+    for (v = 1; v <= ws->n; v++)
+    {
+        ws->nodeAt[ws->newnum[v]] = v;
+        ws->sortTemp[v] = ws->newnum[ws->lowpt1[v]];
+        ws->sortKey[v] = ws->newnum[ws->lowpt2[v]];
+    }
+    for (v = 1; v <= ws->n; v++)
+    {
+        ws->lowpt1[v] = ws->sortTemp[v];
+        ws->lowpt2[v] = ws->sortKey[v];
+    }
+}
+
+/********************************************************************
+ _SPQRTree_PathSearch()
+
+ The path search of Hopcroft and Tarjan, with the corrections of
+ Gutwenger and Mutzel, which finds the separation pairs in the order
+ of the paths generated by _SPQRTree_PathFinder() and splits off the
+ corresponding split components.  The TSTACK holds the triples (h,a,b)
+ of the candidate type-2 separation pairs (a,b), the ESTACK holds the
+ edges visited and not yet split off, and both hold numbers from the
+ renumbering of the vertices.
+
+ The search is iterative.  For each vertex v on the stack, curNode is
+ the adjacency list node of the edge being processed, nextNode the node
+ after it, and curEdge the edge that was in curNode when processing of
+ it began, because the virtual edges of split components replace edges
+ in the adjacency lists.  The flag returning indicates that the DFS
+ child of the vertex on the top of the stack has just been finished.
+ ********************************************************************/
+
+int  _SPQRTree_PathSearch(SPQRTreeWorkspace *ws)
+{
+    int sp = 0, returning = 0, v, vnum, w, wnum, e, it, x, y, a, b, h, lastB, c, e1, e2, eh, eAB, eVirt, lw;
+
+    ws->tTop = 0;
+    ws->tstackA[0] = SPQR_EOS;
+    ws->eTop = 0;
+
+    ws->vertexStack[sp++] = 1;
+    ws->curNode[1] = ws->adjHead[1];
+
+    while (sp > 0)
+    {
+        v = ws->vertexStack[sp-1];
+        vnum = ws->newnum[v];
+
+        if (returning)
+        {
+            returning = 0;
+            it = ws->curNode[v];
+            e = ws->curEdge[v];
+            w = ws->tgt[e];
+            wnum = ws->newnum[w];
+
+            ws->estack[++ws->eTop] = ws->treeArc[w];
+
+            // Check for type-2 separation pairs
+            while (vnum != 1 &&
+                   (ws->tstackA[ws->tTop] == vnum ||
+                    (ws->degree[w] == 2 && ws->newnum[_SPQRTree_FirstChild(ws, w)] > wnum)))
+            {
+                a = ws->tstackA[ws->tTop];
+                b = ws->tstackB[ws->tTop];
+                eAB = NIL;
+
+                if (a == vnum && ws->father[ws->nodeAt[b]] == ws->nodeAt[a])
+                {
+                    ws->tTop--;
+                    continue;
+                }
+
+                if (ws->degree[w] == 2 && ws->newnum[_SPQRTree_FirstChild(ws, w)] > wnum)
+                {
+                    // The path v->w->x through the degree 2 vertex w is a polygon
+                    e1 = ws->estack[ws->eTop--];
+                    e2 = ws->estack[ws->eTop--];
+                    _SPQRTree_DelAdj(ws, w, ws->inAdj[e2]);
+
+                    x = ws->tgt[e2];
+                    eVirt = _SPQRTree_NewEdge(ws, v, x);
+                    ws->degree[x]--;
+                    ws->degree[v]--;
+
+                    c = _SPQRTree_NewComp(ws, SPQR_POLYGON);
+                    _SPQRTree_AddToComp(ws, c, e1);
+                    _SPQRTree_AddToComp(ws, c, e2);
+                    _SPQRTree_AddToComp(ws, c, eVirt);
+
+                    if (ws->eTop > 0)
+                    {
+                        e1 = ws->estack[ws->eTop];
+                        if (ws->src[e1] == x && ws->tgt[e1] == v)
+                        {
+                            eAB = ws->estack[ws->eTop--];
+                            _SPQRTree_DelAdj(ws, x, ws->inAdj[eAB]);
+                            _SPQRTree_DelHigh(ws, eAB);
+                        }
+                    }
+                }
+                else
+                {
+                    // The edges of the ESTACK between a and h form a split component
+                    h = ws->tstackH[ws->tTop--];
+                    c = _SPQRTree_NewComp(ws, SPQR_POLYGON);
+
+                    while (ws->eTop > 0)
+                    {
+                        eh = ws->estack[ws->eTop];
+                        x = ws->newnum[ws->src[eh]];
+                        y = ws->newnum[ws->tgt[eh]];
+                        if (!(vnum <= x && x <= h && vnum <= y && y <= h))
+                            break;
+
+                        ws->eTop--;
+                        if ((x == a && y == b) || (y == a && x == b))
+                        {
+                            eAB = eh;
+                            _SPQRTree_DelAdj(ws, ws->src[eAB], ws->inAdj[eAB]);
+                            _SPQRTree_DelHigh(ws, eAB);
+                        }
+                        else
+                        {
+                            if (it != ws->inAdj[eh])
+                            {
+                                _SPQRTree_DelAdj(ws, ws->src[eh], ws->inAdj[eh]);
+                                _SPQRTree_DelHigh(ws, eh);
+                            }
+                            _SPQRTree_AddToComp(ws, c, eh);
+                            ws->degree[ws->src[eh]]--;
+                            ws->degree[ws->tgt[eh]]--;
+                        }
+                    }
+
+                    x = ws->nodeAt[b];
+                    eVirt = _SPQRTree_NewEdge(ws, v, x);
+                    _SPQRTree_FinishTricOrPoly(ws, c, eVirt);
+                }
+
+                // An edge joining the separation pair forms a bond with the virtual edges
+                if (eAB != NIL)
+                {
+                    c = _SPQRTree_NewComp(ws, SPQR_BOND);
+                    _SPQRTree_AddToComp(ws, c, eAB);
+                    _SPQRTree_AddToComp(ws, c, eVirt);
+                    eVirt = _SPQRTree_NewEdge(ws, v, x);
+                    _SPQRTree_AddToComp(ws, c, eVirt);
+                    ws->degree[x]--;
+                    ws->degree[v]--;
+                }
+
+                // The virtual edge becomes the tree arc from v to x
+                ws->estack[++ws->eTop] = eVirt;
+                ws->adjEdge[it] = eVirt;
+                ws->inAdj[eVirt] = it;
+                ws->degree[x]++;
+                ws->degree[v]++;
+                ws->father[x] = v;
+                ws->treeArc[x] = eVirt;
+                ws->type[eVirt] = SPQR_TREE;
+
+                w = x;
+                wnum = ws->newnum[w];
+            }
+
+            // Check for a type-1 separation pair
+            if (ws->lowpt2[w] >= vnum && ws->lowpt1[w] < vnum &&
+                (ws->father[v] != 1 || ws->treeArcsLeft[v] > 0))
+            {
+                c = _SPQRTree_NewComp(ws, SPQR_POLYGON);
+                while (ws->eTop > 0)
+                {
+                    eh = ws->estack[ws->eTop];
+                    x = ws->newnum[ws->src[eh]];
+                    y = ws->newnum[ws->tgt[eh]];
+                    if (!((wnum <= x && x < wnum + ws->nd[w]) || (wnum <= y && y < wnum + ws->nd[w])))
+                        break;
+
+                    ws->eTop--;
+                    _SPQRTree_AddToComp(ws, c, eh);
+                    _SPQRTree_DelHigh(ws, eh);
+                    ws->degree[ws->src[eh]]--;
+                    ws->degree[ws->tgt[eh]]--;
+                }
+
+                lw = ws->nodeAt[ws->lowpt1[w]];
+                eVirt = _SPQRTree_NewEdge(ws, v, lw);
+                _SPQRTree_FinishTricOrPoly(ws, c, eVirt);
+
+                if (ws->eTop > 0)
+                {
+                    eh = ws->estack[ws->eTop];
+                    if ((ws->src[eh] == v && ws->tgt[eh] == lw) || (ws->src[eh] == lw && ws->tgt[eh] == v))
+                    {
+                        ws->eTop--;
+                        if (it != ws->inAdj[eh])
+                            _SPQRTree_DelAdj(ws, ws->src[eh], ws->inAdj[eh]);
+
+                        c = _SPQRTree_NewComp(ws, SPQR_BOND);
+                        _SPQRTree_AddToComp(ws, c, eh);
+                        _SPQRTree_AddToComp(ws, c, eVirt);
+                        eVirt = _SPQRTree_NewEdge(ws, v, lw);
+                        _SPQRTree_AddToComp(ws, c, eVirt);
+
+                        ws->inHigh[eVirt] = ws->inHigh[eh];
+                        ws->inHigh[eh] = NIL;
+                        ws->degree[v]--;
+                        ws->degree[lw]--;
+                    }
+                }
+
+                if (lw != ws->father[v])
+                {
+                    // The virtual edge becomes a frond from v to lw
+                    ws->estack[++ws->eTop] = eVirt;
+                    ws->adjEdge[it] = eVirt;
+                    ws->inAdj[eVirt] = it;
+                    ws->type[eVirt] = SPQR_FROND;
+
+                    if (ws->inHigh[eVirt] == NIL && _SPQRTree_High(ws, lw) < vnum)
+                    {
+                        // Prepend vnum to the high point list of lw
+                        ws->highVal[eVirt] = vnum;
+                        ws->highPrev[eVirt] = NIL;
+                        ws->highNext[eVirt] = ws->highHead[lw];
+                        if (ws->highHead[lw] == NIL)
+                            ws->highTail[lw] = eVirt;
+                        else
+                            ws->highPrev[ws->highHead[lw]] = eVirt;
+                        ws->highHead[lw] = eVirt;
+                        ws->inHigh[eVirt] = eVirt;
+                    }
+
+                    ws->degree[v]++;
+                    ws->degree[lw]++;
+                }
+                else
+                {
+                    // The virtual edge is parallel to the tree arc into v
+                    _SPQRTree_DelAdj(ws, v, it);
+
+                    c = _SPQRTree_NewComp(ws, SPQR_BOND);
+                    _SPQRTree_AddToComp(ws, c, eVirt);
+                    eVirt = _SPQRTree_NewEdge(ws, lw, v);
+                    _SPQRTree_AddToComp(ws, c, eVirt);
+
+                    eh = ws->treeArc[v];
+                    _SPQRTree_AddToComp(ws, c, eh);
+
+                    ws->treeArc[v] = eVirt;
+                    ws->type[eVirt] = SPQR_TREE;
+                    ws->inAdj[eVirt] = ws->inAdj[eh];
+                    ws->adjEdge[ws->inAdj[eh]] = eVirt;
+                }
+            }
+
+            // Discard the triples of the path that started with e
+            if (ws->start[e])
+            {
+                while (ws->tstackA[ws->tTop] != SPQR_EOS)
+                    ws->tTop--;
+                ws->tTop--;
+            }
+
+            while (ws->tstackA[ws->tTop] != SPQR_EOS &&
+                   ws->tstackA[ws->tTop] != vnum && ws->tstackB[ws->tTop] != vnum &&
+                   _SPQRTree_High(ws, v) > ws->tstackH[ws->tTop])
+                ws->tTop--;
+
+            ws->curNode[v] = ws->nextNode[v];
+            continue;
+        }
+
+        // Get the next edge of v, or finish v if there is none
+        it = ws->curNode[v];
+        if (it == NIL)
+        {
+            returning = --sp > 0;
+            continue;
+        }
+
+        e = ws->adjEdge[it];
+        ws->nextNode[v] = ws->adjNext[it];
+        ws->curEdge[v] = e;
+        w = ws->tgt[e];
+        wnum = ws->newnum[w];
+
+        if (ws->type[e] == SPQR_TREE)
+        {
+            if (ws->start[e])
+            {
+                if (ws->tstackA[ws->tTop] > ws->lowpt1[w])
+                {
+                    y = 0;
+                    do {
+                        if (y < ws->tstackH[ws->tTop])
+                            y = ws->tstackH[ws->tTop];
+                        lastB = ws->tstackB[ws->tTop];
+                        ws->tTop--;
+                    } while (ws->tstackA[ws->tTop] > ws->lowpt1[w]);
+                    _SPQRTree_TStackPush(ws, y, ws->lowpt1[w], lastB);
+                }
+                else
+                    _SPQRTree_TStackPush(ws, wnum + ws->nd[w] - 1, ws->lowpt1[w], vnum);
+
+                _SPQRTree_TStackPush(ws, 0, SPQR_EOS, 0);
+            }
+
+            // Descend to w
+            ws->treeArcsLeft[v]--;
+            ws->vertexStack[sp++] = w;
+            ws->curNode[w] = ws->adjHead[w];
+        }
+        else
+        {
+            if (ws->start[e])
+            {
+                if (ws->tstackA[ws->tTop] > wnum)
+                {
+                    y = 0;
+                    do {
+                        if (y < ws->tstackH[ws->tTop])
+                            y = ws->tstackH[ws->tTop];
+                        lastB = ws->tstackB[ws->tTop];
+                        ws->tTop--;
+                    } while (ws->tstackA[ws->tTop] > wnum);
+                    _SPQRTree_TStackPush(ws, y, wnum, lastB);
+                }
+                else
+                    _SPQRTree_TStackPush(ws, vnum, wnum, vnum);
+            }
+
+            if (w == ws->father[v])
+            {
+                // A frond parallel to the tree arc into v forms a bond with it
+                _SPQRTree_DelHigh(ws, e);
+                c = _SPQRTree_NewComp(ws, SPQR_BOND);
+                _SPQRTree_AddToComp(ws, c, e);
+                eh = ws->treeArc[v];
+                _SPQRTree_AddToComp(ws, c, eh);
+                eVirt = _SPQRTree_NewEdge(ws, w, v);
+                _SPQRTree_AddToComp(ws, c, eVirt);
+
+                ws->treeArc[v] = eVirt;
+                ws->type[eVirt] = SPQR_TREE;
+                ws->inAdj[eVirt] = ws->inAdj[eh];
+                ws->adjEdge[ws->inAdj[eh]] = eVirt;
+                ws->degree[v]--;
+                ws->degree[w]--;
+            }
+            else
+                ws->estack[++ws->eTop] = e;
+
+            ws->curNode[v] = ws->nextNode[v];
+        }
+
+        if (ws->numEdges > ws->edgeCapacity)
+            return NOTOK;
+    }
+
+    return OK;
+}
+
+/********************************************************************
+ _SPQRTree_Assemble()
+
+ Merges the split components into the triconnected components: bonds
+ that share a virtual edge are merged, as are polygons that share a
+ virtual edge, and the shared virtual edge is deleted.  A component
+ merged into another is redirected to it by compMergedInto, so that
+ the component now containing any edge can be found.
+ ********************************************************************/
+
+void _SPQRTree_Assemble(SPQRTreeWorkspace *ws)
+{
+    int i, j, it, itNext, e, item, s1, s2;
+
+    for (i = 1; i <= ws->numComps; i++)
+    {
+        s1 = ws->compSentinel[i];
+        if (ws->compMergedInto[i] != NIL || ws->entryNext[s1] == s1)
+            continue;
+        if (ws->compType[i] != SPQR_BOND && ws->compType[i] != SPQR_POLYGON)
+            continue;
+
+        for (it = ws->entryNext[s1]; it != s1; it = itNext)
+        {
+            itNext = ws->entryNext[it];
+            e = ws->entryEdge[it];
+            if (ws->orig[e] != NIL)
+                continue;
+
+            if (_SPQRTree_FindComp(ws, ws->comp1[e]) == i)
+            {
+                j = _SPQRTree_FindComp(ws, ws->comp2[e]);
+                item = ws->item2[e];
+            }
+            else
+            {
+                j = _SPQRTree_FindComp(ws, ws->comp1[e]);
+                item = ws->item1[e];
+            }
+
+            if (j == NIL || j == i || ws->compType[j] != ws->compType[i])
+                continue;
+
+            // Remove e from component j, then move the rest of j to the end of i
+            ws->entryNext[ws->entryPrev[item]] = ws->entryNext[item];
+            ws->entryPrev[ws->entryNext[item]] = ws->entryPrev[item];
+
+            s2 = ws->compSentinel[j];
+            if (ws->entryNext[s2] != s2)
+            {
+                ws->entryNext[ws->entryPrev[s1]] = ws->entryNext[s2];
+                ws->entryPrev[ws->entryNext[s2]] = ws->entryPrev[s1];
+                ws->entryNext[ws->entryPrev[s2]] = s1;
+                ws->entryPrev[s1] = ws->entryPrev[s2];
+                ws->entryNext[s2] = ws->entryPrev[s2] = s2;
+            }
+            ws->compMergedInto[j] = i;
+
+            if (itNext == s1)
+                itNext = ws->entryNext[it];
+
+            // Remove e from component i
+            ws->entryNext[ws->entryPrev[it]] = ws->entryNext[it];
+            ws->entryPrev[ws->entryNext[it]] = ws->entryPrev[it];
+        }
+    }
+}
+
+/********************************************************************
+ _SPQRTree_AppendTree()
+
+ Appends the triconnected components of the current block to the
+ context as the nodes of a new SPQR tree, with the skeleton vertices
+ given by DFI.  The twin of each virtual edge is found in the other
+ component containing it.
+ ********************************************************************/
+
+int  _SPQRTree_AppendTree(SPQRTreeContext *context, SPQRTreeWorkspace *ws)
+{
+    int i, j, s, it, e, k, numNodes = 0, numSkeletonEdges = 0;
+
+    for (i = 1; i <= ws->numComps; i++)
+    {
+        s = ws->compSentinel[i];
+        ws->compNode[i] = -1;
+        if (ws->compMergedInto[i] != NIL || ws->entryNext[s] == s)
+            continue;
+
+        ws->compNode[i] = context->numNodes + numNodes++;
+        for (it = ws->entryNext[s]; it != s; it = ws->entryNext[it])
+            numSkeletonEdges++;
+    }
+
+    if (_SPQRTree_EnsureCapacity(context, numNodes, numSkeletonEdges) != OK)
+        return NOTOK;
+
+    context->treeFirstNode[context->numTrees++] = context->numNodes;
+
+    k = context->numSkeletonEdges;
+    for (i = 1; i <= ws->numComps; i++)
+    {
+        if (ws->compNode[i] < 0)
+            continue;
+
+        context->nodeType[context->numNodes] = ws->compType[i];
+        context->nodeFirstEdge[context->numNodes] = k;
+        context->numNodes++;
+
+        s = ws->compSentinel[i];
+        for (it = ws->entryNext[s]; it != s; it = ws->entryNext[it])
+        {
+            e = ws->entryEdge[it];
+            context->skeletonU[k] = ws->blockVertex[ws->src[e]];
+            context->skeletonV[k] = ws->blockVertex[ws->tgt[e]];
+            context->skeletonEdge[k] = ws->orig[e];
+            context->skeletonTwinNode[k] = -1;
+
+            if (ws->orig[e] == NIL)
+            {
+                j = _SPQRTree_FindComp(ws, ws->comp1[e]);
+                if (j == i)
+                    j = _SPQRTree_FindComp(ws, ws->comp2[e]);
+                if (j == NIL || j == i || ws->compNode[j] < 0)
+                    return NOTOK;
+                context->skeletonTwinNode[k] = ws->compNode[j];
+            }
+            k++;
+        }
+    }
+
+    context->numSkeletonEdges = k;
+    context->nodeFirstEdge[context->numNodes] = k;
+    context->treeFirstNode[context->numTrees] = context->numNodes;
+
+    return OK;
+}
+
+/********************************************************************
+ _SPQRTree_EnsureCapacity()
+
+ Makes room in the context for one more tree with the given numbers
+ of nodes and skeleton edges, doubling the arrays as needed.
+ ********************************************************************/
+
+int  _SPQRTree_EnsureCapacity(SPQRTreeContext *context, int numNodes, int numSkeletonEdges)
+{
+    int newCapacity;
+    void *p;
+
+    if (context->numTrees + 2 > context->treeCapacity)
+    {
+        newCapacity = 2*context->treeCapacity + 16;
+        if ((p = realloc(context->treeFirstNode, newCapacity*sizeof(int))) == NULL)
+            return NOTOK;
+        context->treeFirstNode = (int *) p;
+        context->treeCapacity = newCapacity;
+    }
+
+    if (context->numNodes + numNodes + 1 > context->nodeCapacity)
+    {
+        newCapacity = 2*(context->numNodes + numNodes) + 16;
+        if ((p = realloc(context->nodeType, newCapacity*sizeof(int))) == NULL)
+            return NOTOK;
+        context->nodeType = (int *) p;
+        if ((p = realloc(context->nodeFirstEdge, newCapacity*sizeof(int))) == NULL)
+            return NOTOK;
+        context->nodeFirstEdge = (int *) p;
+        context->nodeCapacity = newCapacity;
+    }
+
+    if (context->numSkeletonEdges + numSkeletonEdges > context->skeletonCapacity)
+    {
+        newCapacity = 2*(context->numSkeletonEdges + numSkeletonEdges) + 16;
+        if ((p = realloc(context->skeletonU, newCapacity*sizeof(int))) == NULL)
+            return NOTOK;
+        context->skeletonU = (int *) p;
+        if ((p = realloc(context->skeletonV, newCapacity*sizeof(int))) == NULL)
+            return NOTOK;
+        context->skeletonV = (int *) p;
+        if ((p = realloc(context->skeletonEdge, newCapacity*sizeof(int))) == NULL)
+            return NOTOK;
+        context->skeletonEdge = (int *) p;
+        if ((p = realloc(context->skeletonTwinNode, newCapacity*sizeof(int))) == NULL)
+            return NOTOK;
+        context->skeletonTwinNode = (int *) p;
+        context->skeletonCapacity = newCapacity;
+    }
+
+    if (context->numNodes == 0)
+        context->nodeFirstEdge[0] = 0;
+    context->treeFirstNode[context->numTrees] = context->numNodes;
+
+    return OK;
+}
+
+/********************************************************************
+ _SPQRTree_NewEdge()
+ Returns a new local edge directed from u to v.  The caller checks
+ numEdges against the capacity before the edges are used.
+ ********************************************************************/
+
+int  _SPQRTree_NewEdge(SPQRTreeWorkspace *ws, int u, int v)
+{
+    int e = ++ws->numEdges;
+
+    if (e > ws->edgeCapacity)
+        e = ws->edgeCapacity;
+
+    ws->src[e] = u;
+    ws->tgt[e] = v;
+    ws->type[e] = SPQR_UNSEEN;
+    ws->orig[e] = NIL;
+    ws->start[e] = 0;
+    ws->inAdj[e] = ws->inHigh[e] = NIL;
+    ws->comp1[e] = ws->comp2[e] = NIL;
+    ws->item1[e] = ws->item2[e] = NIL;
+
+    return e;
+}
+
+/********************************************************************
+ _SPQRTree_NewComp()
+ ********************************************************************/
+
+int  _SPQRTree_NewComp(SPQRTreeWorkspace *ws, int type)
+{
+    int c = ++ws->numComps, s = ++ws->numEntries;
+
+    ws->compType[c] = type;
+    ws->compSentinel[c] = s;
+    ws->compMergedInto[c] = NIL;
+    ws->entryEdge[s] = NIL;
+    ws->entryNext[s] = ws->entryPrev[s] = s;
+
+    return c;
+}
+
+/********************************************************************
+ _SPQRTree_AddToComp()
+ Appends edge e to component c and records the entry with the edge.
+ ********************************************************************/
+
+void _SPQRTree_AddToComp(SPQRTreeWorkspace *ws, int c, int e)
+{
+    int s = ws->compSentinel[c], item = ++ws->numEntries;
+
+    ws->entryEdge[item] = e;
+    ws->entryPrev[item] = ws->entryPrev[s];
+    ws->entryNext[item] = s;
+    ws->entryNext[ws->entryPrev[s]] = item;
+    ws->entryPrev[s] = item;
+
+    if (ws->comp1[e] == NIL)
+    {
+        ws->comp1[e] = c;
+        ws->item1[e] = item;
+    }
+    else
+    {
+        ws->comp2[e] = c;
+        ws->item2[e] = item;
+    }
+}
+
+/********************************************************************
+ _SPQRTree_FinishTricOrPoly()
+ Adds the virtual edge e to component c, which is a polygon if it is
+ a triangle and a triconnected component otherwise.
+ ********************************************************************/
+
+void _SPQRTree_FinishTricOrPoly(SPQRTreeWorkspace *ws, int c, int e)
+{
+    int s = ws->compSentinel[c], it, size = 0;
+
+    _SPQRTree_AddToComp(ws, c, e);
+    for (it = ws->entryNext[s]; it != s && size < 4; it = ws->entryNext[it])
+        size++;
+
+    ws->compType[c] = size >= 4 ? SPQR_TRICONN : SPQR_POLYGON;
+}
+
+/********************************************************************
+ _SPQRTree_DelAdj()
+ Removes the given node from the adjacency list of v.
+ ********************************************************************/
+
+void _SPQRTree_DelAdj(SPQRTreeWorkspace *ws, int v, int node)
+{
+    if (node == NIL)
+        return;
+
+    if (ws->adjPrev[node] == NIL)
+        ws->adjHead[v] = ws->adjNext[node];
+    else
+        ws->adjNext[ws->adjPrev[node]] = ws->adjNext[node];
+
+    if (ws->adjNext[node] == NIL)
+        ws->adjTail[v] = ws->adjPrev[node];
+    else
+        ws->adjPrev[ws->adjNext[node]] = ws->adjPrev[node];
+
+    ws->inAdj[ws->adjEdge[node]] = NIL;
+}
+
+/********************************************************************
+ _SPQRTree_DelHigh()
+ Removes the high point list entry of frond e, if it has one.
+ ********************************************************************/
+
+void _SPQRTree_DelHigh(SPQRTreeWorkspace *ws, int e)
+{
+    int node = ws->inHigh[e], w = ws->tgt[e];
+
+    if (node == NIL)
+        return;
+
+    if (ws->highPrev[node] == NIL)
+        ws->highHead[w] = ws->highNext[node];
+    else
+        ws->highNext[ws->highPrev[node]] = ws->highNext[node];
+
+    if (ws->highNext[node] == NIL)
+        ws->highTail[w] = ws->highPrev[node];
+    else
+        ws->highPrev[ws->highNext[node]] = ws->highPrev[node];
+
+    ws->inHigh[e] = NIL;
+}
+
+/********************************************************************
+ _SPQRTree_FindComp()
+ Returns the component into which component c has been merged.
+ ********************************************************************/
+
+int  _SPQRTree_FindComp(SPQRTreeWorkspace *ws, int c)
+{
+    int root = c, next;
+
+    if (c == NIL)
+        return NIL;
+
+    while (ws->compMergedInto[root] != NIL)
+        root = ws->compMergedInto[root];
+
+    while (c != root)
+    {
+        next = ws->compMergedInto[c];
+        ws->compMergedInto[c] = root;
+        c = next;
+    }
+
+    return root;
+}
+
+/********************************************************************
+ gp_SPQRTree_GetNumTrees()
+ Returns the number of SPQR trees obtained by gp_SPQRTree(), which is
+ the number of biconnected components with two or more edges.
+ ********************************************************************/
+
+int gp_SPQRTree_GetNumTrees(graphP theGraph)
+{
+    SPQRTreeContext *context = (SPQRTreeContext *) gp_GetExtension(theGraph, SPQRTREE_ID);
+    return context == NULL ? 0 : context->numTrees;
+}
+
+/********************************************************************
+ gp_SPQRTree_GetTreeNodes()
+ Gives the first node and the number of nodes of SPQR tree t.
+ The nodes of each tree are numbered consecutively.
+
+ Returns OK on success, NOTOK if there is no tree t
+ ********************************************************************/
+
+int gp_SPQRTree_GetTreeNodes(graphP theGraph, int t, int *pFirstNode, int *pNumNodes)
+{
+    SPQRTreeContext *context = (SPQRTreeContext *) gp_GetExtension(theGraph, SPQRTREE_ID);
+
+    if (context == NULL || t < 0 || t >= context->numTrees)
+        return NOTOK;
+
+    *pFirstNode = context->treeFirstNode[t];
+    *pNumNodes = context->treeFirstNode[t+1] - context->treeFirstNode[t];
+    return OK;
+}
+
+/********************************************************************
+ gp_SPQRTree_GetNumNodes()
+ Returns the total number of nodes in the SPQR trees.
+ ********************************************************************/
+
+int gp_SPQRTree_GetNumNodes(graphP theGraph)
+{
+    SPQRTreeContext *context = (SPQRTreeContext *) gp_GetExtension(theGraph, SPQRTREE_ID);
+    return context == NULL ? 0 : context->numNodes;
+}
+
+/********************************************************************
+ gp_SPQRTree_GetNodeType()
+ Returns SPQRTREE_SNODE, SPQRTREE_PNODE or SPQRTREE_RNODE, or NOTOK
+ if there is no node i.
+ ********************************************************************/
+
+int gp_SPQRTree_GetNodeType(graphP theGraph, int i)
+{
+    SPQRTreeContext *context = (SPQRTreeContext *) gp_GetExtension(theGraph, SPQRTREE_ID);
+
+    if (context == NULL || i < 0 || i >= context->numNodes)
+        return NOTOK;
+
+    return context->nodeType[i];
+}
+
+/********************************************************************
+ gp_SPQRTree_GetNumSkeletonEdges()
+ Returns the number of edges in the skeleton of node i, or 0 if there
+ is no node i.
+ ********************************************************************/
+
+int gp_SPQRTree_GetNumSkeletonEdges(graphP theGraph, int i)
+{
+    SPQRTreeContext *context = (SPQRTreeContext *) gp_GetExtension(theGraph, SPQRTREE_ID);
+
+    if (context == NULL || i < 0 || i >= context->numNodes)
+        return 0;
+
+    return context->nodeFirstEdge[i+1] - context->nodeFirstEdge[i];
+}
+
+/********************************************************************
+ gp_SPQRTree_GetSkeletonEdge()
+ Gives the endpoints u and v of skeleton edge j of node i.  If it is an
+ edge of the graph, then *pe receives the edge and *pAdjacentNode
+ receives -1.  If it is a virtual edge, then *pe receives NIL and
+ *pAdjacentNode receives the node whose skeleton contains the twin of
+ the virtual edge, i.e. the neighbor of node i in the SPQR tree.
+
+ Returns OK on success, NOTOK if there is no such skeleton edge
+ ********************************************************************/
+
+int gp_SPQRTree_GetSkeletonEdge(graphP theGraph, int i, int j, int *pu, int *pv, int *pe, int *pAdjacentNode)
+{
+    SPQRTreeContext *context = (SPQRTreeContext *) gp_GetExtension(theGraph, SPQRTREE_ID);
+    int k;
+
+    if (j < 0 || j >= gp_SPQRTree_GetNumSkeletonEdges(theGraph, i))
+        return NOTOK;
+
+    k = context->nodeFirstEdge[i] + j;
+    *pu = context->skeletonU[k];
+    *pv = context->skeletonV[k];
+    *pe = context->skeletonEdge[k];
+    *pAdjacentNode = context->skeletonTwinNode[k];
+    return OK;
+}
+
+/****************************************************************************
+ gp_SPQRTree_WriteTree()
+
+ Writes the SPQR trees to the named file, or to stdout or stderr.  The
+ first line gives the number of nodes and the number of trees as
+ SPQR=<nodes> T=<trees>.  The second line gives T: and the first node of
+ each tree, terminated by -1.  Each further line gives a node number, a
+ colon, the node type letter S, P or R and, for each skeleton edge, its
+ two endpoints and either the adjacent node, for a virtual edge, or -1.
+ The vertices are written in the manner of the adjacency list format.
+
+ Returns OK on success, NOTOK on failure
+ ****************************************************************************/
+
+int  gp_SPQRTree_WriteTree(graphP theGraph, char *theFileName)
+{
+     SPQRTreeContext *context = (SPQRTreeContext *) gp_GetExtension(theGraph, SPQRTREE_ID);
+     int zeroBasedOffset = (theGraph->internalFlags & FLAGS_ZEROBASEDIO) ? gp_GetFirstVertex(theGraph) : 0;
+     FILE *outfile;
+     int i, k;
+
+     if (context == NULL || theFileName == NULL)
+         return NOTOK;
+
+     if (strcmp(theFileName, "stdout") == 0)
+          outfile = stdout;
+     else if (strcmp(theFileName, "stderr") == 0)
+          outfile = stderr;
+     else outfile = fopen(theFileName, WRITETEXT);
+
+     if (outfile == NULL)
+         return NOTOK;
+
+     fprintf(outfile, "SPQR=%d T=%d\nT:", context->numNodes, context->numTrees);
+     for (i = 0; i < context->numTrees; i++)
+         fprintf(outfile, " %d", context->treeFirstNode[i]);
+     fprintf(outfile, " -1\n");
+
+     for (i = 0; i < context->numNodes; i++)
+     {
+         fprintf(outfile, "%d: %c", i,
+                 context->nodeType[i] == SPQRTREE_SNODE ? 'S' :
+                 context->nodeType[i] == SPQRTREE_PNODE ? 'P' : 'R');
+         for (k = context->nodeFirstEdge[i]; k < context->nodeFirstEdge[i+1]; k++)
+             fprintf(outfile, " %d %d %d",
+                     context->skeletonU[k] - zeroBasedOffset,
+                     context->skeletonV[k] - zeroBasedOffset,
+                     context->skeletonTwinNode[k]);
+         fprintf(outfile, "\n");
+     }
+
+     if (strcmp(theFileName, "stdout") == 0 || strcmp(theFileName, "stderr") == 0)
+         fflush(outfile);
+
+     else if (fclose(outfile) != 0)
+         return NOTOK;
+
+     return OK;
+}
+
+/********************************************************************
+ gp_SPQRTreeIntegrityCheck()
+
+ Checks that theGraph still has the edges of origGraph and that the
+ SPQR trees of theGraph are well formed: each edge of theGraph other
+ than a self-loop appears in exactly one skeleton with its endpoints,
+ the twin of each virtual edge is in the adjacent node and has the same
+ endpoints, the virtual edges connect the nodes of each tree into a
+ tree, each S-node skeleton is a cycle, each P-node skeleton is a bond,
+ each R-node skeleton is simple with minimum degree three, and no two
+ adjacent nodes are both S-nodes or both P-nodes.  The triconnectivity
+ of the R-node skeletons is not verified.
+
+ Returns OK if the checks pass, NOTOK otherwise
+ ********************************************************************/
+
+int gp_SPQRTreeIntegrityCheck(graphP theGraph, graphP origGraph)
+{
+    SPQRTreeContext *context = (SPQRTreeContext *) gp_GetExtension(theGraph, SPQRTREE_ID);
+    int numNodes, numSkel, *nodeOf = NULL, *listHead = NULL, *listNext = NULL, *partner = NULL;
+    int *vertexMark = NULL, *vertexDegree = NULL, *nodeMark = NULL, *edgeSeen = NULL, *slotNext = NULL;
+    int *neighborMark = NULL;
+    int i, j, k, kk, t, e, u, v, first, count, queueHead, queueTail, Result = OK;
+
+    if (theGraph == NULL || origGraph == NULL || context == NULL)
+        return NOTOK;
+
+    if (_TestSubgraph(theGraph, origGraph) != TRUE || _TestSubgraph(origGraph, theGraph) != TRUE)
+        return NOTOK;
+
+    numNodes = context->numNodes;
+    numSkel = context->numSkeletonEdges;
+
+    if ((nodeOf = (int *) malloc((numSkel+1)*sizeof(int))) == NULL ||
+        (listNext = (int *) malloc((numSkel+1)*sizeof(int))) == NULL ||
+        (partner = (int *) malloc((numSkel+1)*sizeof(int))) == NULL ||
+        (listHead = (int *) malloc((numNodes+1)*sizeof(int))) == NULL ||
+        (nodeMark = (int *) malloc((numNodes+1)*sizeof(int))) == NULL ||
+        (slotNext = (int *) malloc((2*numSkel+2)*sizeof(int))) == NULL ||
+        (vertexMark = (int *) calloc(gp_PrimaryVertexIndexBound(theGraph), sizeof(int))) == NULL ||
+        (vertexDegree = (int *) calloc(gp_PrimaryVertexIndexBound(theGraph), sizeof(int))) == NULL ||
+        (neighborMark = (int *) calloc(gp_PrimaryVertexIndexBound(theGraph), sizeof(int))) == NULL ||
+        (edgeSeen = (int *) calloc(gp_EdgeIndexBound(theGraph), sizeof(int))) == NULL)
+        Result = NOTOK;
+
+    // Each edge of the graph appears once, with its endpoints
+    for (i = 0; i < numNodes && Result == OK; i++)
+    {
+        for (k = context->nodeFirstEdge[i]; k < context->nodeFirstEdge[i+1]; k++)
+        {
+            nodeOf[k] = i;
+            partner[k] = -1;
+            if ((e = context->skeletonEdge[k]) == NIL)
+                continue;
+
+            u = gp_GetNeighbor(theGraph, e);
+            v = gp_GetNeighbor(theGraph, gp_GetTwinArc(theGraph, e));
+            if (e < gp_GetFirstEdge(theGraph) || e >= gp_EdgeInUseIndexBound(theGraph) ||
+                !gp_EdgeInUse(theGraph, e) || edgeSeen[e] ||
+                !((u == context->skeletonU[k] && v == context->skeletonV[k]) ||
+                  (v == context->skeletonU[k] && u == context->skeletonV[k])))
+                Result = NOTOK;
+            edgeSeen[e] = 1;
+        }
+    }
+
+    // The edges of the graph missing from the skeletons must be bridges, which
+    // is the case if and only if removing them increases the number of
+    // connected components by the number of edges removed
+    if (Result == OK)
+        Result = _SPQRTree_CheckMissingEdgesAreBridges(theGraph, edgeSeen, vertexMark);
+
+    // Pair each virtual edge with its twin.  The virtual edges of node i
+    // whose twin is in a later node j are listed with node j, then node j
+    // matches them with its own virtual edges.
+    for (i = 0; i < numNodes && Result == OK; i++)
+        listHead[i] = -1;
+
+    for (i = 0; i < numNodes && Result == OK; i++)
+    {
+        for (k = context->nodeFirstEdge[i]; k < context->nodeFirstEdge[i+1]; k++)
+        {
+            j = context->skeletonTwinNode[k];
+            if (context->skeletonEdge[k] != NIL)
+            {
+                if (j != -1)
+                    Result = NOTOK;
+                continue;
+            }
+            if (j < 0 || j >= numNodes || j == i)
+                Result = NOTOK;
+            else if (j > i)
+            {
+                listNext[k] = listHead[j];
+                listHead[j] = k;
+            }
+        }
+    }
+
+    for (i = 0; i < numNodes; i++)
+        nodeMark[i] = -1;
+
+    for (j = 0; j < numNodes && Result == OK; j++)
+    {
+        // nodeMark[i] gives the virtual edge of node j whose twin is in node i < j
+        for (k = context->nodeFirstEdge[j]; k < context->nodeFirstEdge[j+1]; k++)
+        {
+            i = context->skeletonTwinNode[k];
+            if (context->skeletonEdge[k] == NIL && i < j)
+            {
+                if (nodeMark[i] != -1)
+                    Result = NOTOK;
+                nodeMark[i] = k;
+            }
+        }
+
+        for (kk = listHead[j]; kk != -1 && Result == OK; kk = listNext[kk])
+        {
+            i = nodeOf[kk];
+            k = nodeMark[i];
+            if (k == -1 || partner[k] != -1 ||
+                !((context->skeletonU[k] == context->skeletonU[kk] && context->skeletonV[k] == context->skeletonV[kk]) ||
+                  (context->skeletonU[k] == context->skeletonV[kk] && context->skeletonV[k] == context->skeletonU[kk])))
+                Result = NOTOK;
+            else
+            {
+                partner[k] = kk;
+                partner[kk] = k;
+            }
+
+            // Adjacent nodes must not both be S-nodes or both be P-nodes
+            if (context->nodeType[i] == context->nodeType[j] && context->nodeType[i] != SPQRTREE_RNODE)
+                Result = NOTOK;
+        }
+
+        for (k = context->nodeFirstEdge[j]; k < context->nodeFirstEdge[j+1]; k++)
+        {
+            i = context->skeletonTwinNode[k];
+            if (context->skeletonEdge[k] == NIL && i < j)
+            {
+                if (partner[k] == -1)
+                    Result = NOTOK;
+                nodeMark[i] = -1;
+            }
+        }
+    }
+
+    // The virtual edges connect the nodes of each tree into a tree
+    for (i = 0; i < numNodes; i++)
+        nodeMark[i] = 0;
+
+    for (t = 0; t < context->numTrees && Result == OK; t++)
+    {
+        first = context->treeFirstNode[t];
+        count = context->treeFirstNode[t+1] - first;
+
+        // A breadth first search using listHead as the queue
+        queueHead = queueTail = 0;
+        listHead[queueTail++] = first;
+        nodeMark[first] = 1;
+        while (queueHead < queueTail)
+        {
+            i = listHead[queueHead++];
+            for (k = context->nodeFirstEdge[i]; k < context->nodeFirstEdge[i+1]; k++)
+            {
+                j = context->skeletonTwinNode[k];
+                if (j == -1)
+                    continue;
+                if (j < first || j >= first + count)
+                    Result = NOTOK;
+                else if (!nodeMark[j])
+                {
+                    nodeMark[j] = 1;
+                    listHead[queueTail++] = j;
+                }
+            }
+        }
+
+        if (queueTail != count)
+            Result = NOTOK;
+    }
+
+    // Check the skeleton of each node by the degrees of its vertices
+    for (i = 0; i < numNodes && Result == OK; i++)
+    {
+        int numVertices = 0, numEdges = context->nodeFirstEdge[i+1] - context->nodeFirstEdge[i];
+        int minDegree = numEdges, maxDegree = 0;
+
+        for (k = context->nodeFirstEdge[i]; k < context->nodeFirstEdge[i+1]; k++)
+        {
+            u = context->skeletonU[k];
+            v = context->skeletonV[k];
+            if (u == v || !gp_VertexInRange(theGraph, u) || !gp_VertexInRange(theGraph, v))
+            {
+                Result = NOTOK;
+                break;
+            }
+            if (vertexDegree[u]++ == 0)
+                numVertices++;
+            if (vertexDegree[v]++ == 0)
+                numVertices++;
+        }
+
+        for (k = context->nodeFirstEdge[i]; k < context->nodeFirstEdge[i+1] && Result == OK; k++)
+        {
+            u = context->skeletonU[k];
+            v = context->skeletonV[k];
+            if (vertexDegree[u] < minDegree) minDegree = vertexDegree[u];
+            if (vertexDegree[v] < minDegree) minDegree = vertexDegree[v];
+            if (vertexDegree[u] > maxDegree) maxDegree = vertexDegree[u];
+            if (vertexDegree[v] > maxDegree) maxDegree = vertexDegree[v];
+        }
+
+        switch (context->nodeType[i])
+        {
+            case SPQRTREE_PNODE :
+                if (numVertices != 2 || numEdges < 2)
+                    Result = NOTOK;
+                break;
+
+            case SPQRTREE_SNODE :
+                if (numVertices < 3 || numEdges != numVertices || minDegree != 2 || maxDegree != 2)
+                    Result = NOTOK;
+                break;
+
+            case SPQRTREE_RNODE :
+                if (numVertices < 4 || minDegree < 3)
+                    Result = NOTOK;
+                break;
+
+            default :
+                Result = NOTOK;
+                break;
+        }
+
+        // An S-node must be one cycle, not several, and an R-node must be simple
+        if (Result == OK && context->nodeType[i] != SPQRTREE_PNODE)
+            Result = _SPQRTree_CheckSkeleton(context, i, vertexMark, slotNext, neighborMark);
+
+        for (k = context->nodeFirstEdge[i]; k < context->nodeFirstEdge[i+1]; k++)
+        {
+            vertexDegree[context->skeletonU[k]] = 0;
+            vertexDegree[context->skeletonV[k]] = 0;
+        }
+    }
+
+    if (nodeOf != NULL) free(nodeOf);
+    if (listNext != NULL) free(listNext);
+    if (partner != NULL) free(partner);
+    if (listHead != NULL) free(listHead);
+    if (nodeMark != NULL) free(nodeMark);
+    if (vertexMark != NULL) free(vertexMark);
+    if (vertexDegree != NULL) free(vertexDegree);
+    if (edgeSeen != NULL) free(edgeSeen);
+    if (slotNext != NULL) free(slotNext);
+    if (neighborMark != NULL) free(neighborMark);
+
+    return Result;
+}
+
+/********************************************************************
+ _SPQRTree_CheckMissingEdgesAreBridges()
+
+ Counts the connected components of the graph with and without the
+ edges not marked in edgeSeen, using union-find over the parent array,
+ which must have room for the vertices and is left cleared.  Removing
+ a bridge leaves the other bridges as bridges and the other edges on
+ their cycles, so the count increases by one per edge removed if and
+ only if every edge removed is a bridge.  Self-loops are ignored.
+ ********************************************************************/
+
+int  _SPQRTree_CheckMissingEdgesAreBridges(graphP theGraph, int *edgeSeen, int *parent)
+{
+    int pass, v, e, u, w, numComponents[2], numMissing = 0;
+
+    for (pass = 0; pass < 2; pass++)
+    {
+        numComponents[pass] = theGraph->N;
+        for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
+            parent[v] = v;
+
+        for (e = gp_GetFirstEdge(theGraph); e < gp_EdgeInUseIndexBound(theGraph); e += 2)
+        {
+            if (!gp_EdgeInUse(theGraph, e))
+                continue;
+
+            u = gp_GetNeighbor(theGraph, e);
+            w = gp_GetNeighbor(theGraph, gp_GetTwinArc(theGraph, e));
+            if (u == w)
+                continue;
+
+            if (!edgeSeen[e])
+            {
+                if (pass == 1)
+                    continue;
+                numMissing++;
+            }
+
+            while (parent[u] != u)
+                u = parent[u] = parent[parent[u]];
+            while (parent[w] != w)
+                w = parent[w] = parent[parent[w]];
+            if (u != w)
+            {
+                parent[u] = w;
+                numComponents[pass]--;
+            }
+        }
+    }
+
+    for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
+        parent[v] = 0;
+
+    return numComponents[1] - numComponents[0] == numMissing ? OK : NOTOK;
+}
+
+/********************************************************************
+ _SPQRTree_CheckSkeleton()
+
+ Checks that the skeleton of S-node i is a single cycle, given that its
+ vertices have degree two, or that the skeleton of R-node i is simple.
+ The incidences of the skeleton are linked into lists from head, which
+ must be cleared on entry and is cleared on exit, using two slots of
+ slotNext per skeleton edge.  The mark array must be cleared on entry
+ and is cleared on exit.
+ ********************************************************************/
+
+int  _SPQRTree_CheckSkeleton(SPQRTreeContext *context, int i, int *head, int *slotNext, int *mark)
+{
+    int base = context->nodeFirstEdge[i], numEdges = context->nodeFirstEdge[i+1] - base;
+    int s, k, x, y, x0, prevEdge, steps, Result = OK;
+
+    for (s = 0; s < 2*numEdges; s++)
+    {
+        k = base + s/2;
+        x = (s & 1) ? context->skeletonV[k] : context->skeletonU[k];
+        slotNext[s] = head[x] - 1;
+        head[x] = s + 1;
+    }
+
+    if (context->nodeType[i] == SPQRTREE_SNODE)
+    {
+        // Walk around the cycle from the first vertex
+        x = x0 = context->skeletonU[base];
+        prevEdge = -1;
+        steps = 0;
+        do {
+            for (s = head[x] - 1; s >= 0 && base + s/2 == prevEdge; s = slotNext[s])
+                ;
+            if (s < 0)
+                break;
+            prevEdge = base + s/2;
+            x = (s & 1) ? context->skeletonU[prevEdge] : context->skeletonV[prevEdge];
+            steps++;
+        } while (x != x0 && steps <= numEdges);
+
+        if (steps != numEdges || x != x0)
+            Result = NOTOK;
+    }
+    else
+    {
+        // Each vertex marks its neighbors, and finding a mark means a multiple edge.
+        // The marks are offset by one so that a cleared mark is not a vertex.
+        for (k = base; k < base + numEdges && Result == OK; k++)
+        {
+            x = context->skeletonU[k];
+            for (s = head[x] - 1; s >= 0; s = slotNext[s])
+            {
+                y = (s & 1) ? context->skeletonU[base + s/2] : context->skeletonV[base + s/2];
+                if (mark[y] == x + 1)
+                    Result = NOTOK;
+                mark[y] = x + 1;
+            }
+            for (s = head[x] - 1; s >= 0; s = slotNext[s])
+                mark[(s & 1) ? context->skeletonU[base + s/2] : context->skeletonV[base + s/2]] = 0;
+            head[x] = 0;
+        }
+    }
+
+    for (k = base; k < base + numEdges; k++)
+        head[context->skeletonU[k]] = head[context->skeletonV[k]] = 0;
+
+    return Result;
+}
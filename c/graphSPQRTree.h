@@ -0,0 +1,87 @@
+#ifndef GRAPH_SPQRTREE_H
+#define GRAPH_SPQRTREE_H
+
+/*
+Planarity-Related Graph Algorithms Project
+Copyright (c) 1997-2012, John M. Boyer
+All rights reserved. Includes a reference implementation of the following:
+
+* John M. Boyer. "Subgraph Homeomorphism via the Edge Addition Planarity Algorithm".
+  Journal of Graph Algorithms and Applications, Vol. 16, no. 2, pp. 381-410, 2012.
+  http://www.jgaa.info/16/268.html
+
+* John M. Boyer. "A New Method for Efficiently Generating Planar Graph
+  Visibility Representations". In P. Eades and P. Healy, editors,
+  Proceedings of the 13th International Conference on Graph Drawing 2005,
+  Lecture Notes Comput. Sci., Volume 3843, pp. 508-511, Springer-Verlag, 2006.
+
+* John M. Boyer and Wendy J. Myrvold. "On the Cutting Edge: Simplified O(n)
+  Planarity by Edge Addition". Journal of Graph Algorithms and Applications,
+  Vol. 8, No. 3, pp. 241-273, 2004.
+  http://www.jgaa.info/08/91.html
+
+* John M. Boyer. "Simplified O(n) Algorithms for Planar Graph Embedding,
+  Kuratowski Subgraph Isolation, and Related Problems". Ph.D. Dissertation,
+  University of Victoria, 2001.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+  list of conditions and the following disclaimer in the documentation and/or
+  other materials provided with the distribution.
+
+* Neither the name of the Planarity-Related Graph Algorithms Project nor the names
+  of its contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "graphStructures.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SPQRTREE_NAME "SPQRTree"
+
+// Node types of the SPQR tree.  The skeleton of an S-node is a cycle, the
+// skeleton of a P-node is a bond of three or more edges joining two vertices,
+// and the skeleton of an R-node is a simple triconnected graph.
+#define SPQRTREE_SNODE      1
+#define SPQRTREE_PNODE      2
+#define SPQRTREE_RNODE      3
+
+int gp_AttachSPQRTree(graphP theGraph);
+int gp_DetachSPQRTree(graphP theGraph);
+
+int gp_SPQRTree(graphP theGraph);
+
+int gp_SPQRTree_GetNumTrees(graphP theGraph);
+int gp_SPQRTree_GetTreeNodes(graphP theGraph, int t, int *pFirstNode, int *pNumNodes);
+int gp_SPQRTree_GetNumNodes(graphP theGraph);
+int gp_SPQRTree_GetNodeType(graphP theGraph, int i);
+int gp_SPQRTree_GetNumSkeletonEdges(graphP theGraph, int i);
+int gp_SPQRTree_GetSkeletonEdge(graphP theGraph, int i, int j, int *pu, int *pv, int *pe, int *pAdjacentNode);
+int gp_SPQRTree_WriteTree(graphP theGraph, char *theFileName);
+
+int gp_SPQRTreeIntegrityCheck(graphP theGraph, graphP origGraph);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
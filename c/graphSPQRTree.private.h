@@ -0,0 +1,137 @@
+#ifndef GRAPH_SPQRTREE_PRIVATE_H
+#define GRAPH_SPQRTREE_PRIVATE_H
+
+/*
+Planarity-Related Graph Algorithms Project
+Copyright (c) 1997-2012, John M. Boyer
+All rights reserved. Includes a reference implementation of the following:
+
+* John M. Boyer. "Subgraph Homeomorphism via the Edge Addition Planarity Algorithm".
+  Journal of Graph Algorithms and Applications, Vol. 16, no. 2, pp. 381-410, 2012.
+  http://www.jgaa.info/16/268.html
+
+* John M. Boyer. "A New Method for Efficiently Generating Planar Graph
+  Visibility Representations". In P. Eades and P. Healy, editors,
+  Proceedings of the 13th International Conference on Graph Drawing 2005,
+  Lecture Notes Comput. Sci., Volume 3843, pp. 508-511, Springer-Verlag, 2006.
+
+* John M. Boyer and Wendy J. Myrvold. "On the Cutting Edge: Simplified O(n)
+  Planarity by Edge Addition". Journal of Graph Algorithms and Applications,
+  Vol. 8, No. 3, pp. 241-273, 2004.
+  http://www.jgaa.info/08/91.html
+
+* John M. Boyer. "Simplified O(n) Algorithms for Planar Graph Embedding,
+  Kuratowski Subgraph Isolation, and Related Problems". Ph.D. Dissertation,
+  University of Victoria, 2001.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+  list of conditions and the following disclaimer in the documentation and/or
+  other materials provided with the distribution.
+
+* Neither the name of the Planarity-Related Graph Algorithms Project nor the names
+  of its contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "graph.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct
+{
+    // Helps distinguish initialize from re-initialize
+    int initialized;
+
+    // The graph that this context augments
+    graphP theGraph;
+
+    // Overloaded function pointers
+    graphFunctionTable functions;
+
+    // The SPQR trees obtained by gp_SPQRTree(), one for each biconnected
+    // component having two or more edges.  The nodes of tree t are
+    // treeFirstNode[t] up to treeFirstNode[t+1]-1, and the skeleton edges
+    // of node i are in positions nodeFirstEdge[i] up to nodeFirstEdge[i+1]-1
+    // of the skeleton arrays.  A skeleton edge joins skeletonU and skeletonV.
+    // It is either the edge skeletonEdge of the graph, in which case its
+    // skeletonTwinNode is -1, or it is a virtual edge (skeletonEdge is NIL)
+    // whose twin virtual edge is in the skeleton of node skeletonTwinNode.
+    int numTrees, numNodes, numSkeletonEdges;
+    int treeCapacity, nodeCapacity, skeletonCapacity;
+    int *treeFirstNode;
+    int *nodeType, *nodeFirstEdge;
+    int *skeletonU, *skeletonV, *skeletonEdge, *skeletonTwinNode;
+
+} SPQRTreeContext;
+
+// Working storage of gp_SPQRTree().  The biconnected components are found
+// with the DFS tree and lowpoints of the graph, then each one is decomposed
+// into its triconnected components by a path search over local copies of
+// its vertices and edges, which are numbered from 1 so that NIL means none.
+typedef struct
+{
+    // Block structure, indexed by DFI: the block containing each vertex
+    // other than the block's root, and the vertex's number in that block.
+    // Block b has root vertex blockRoot[b]; its other vertices and its
+    // edges are bucketed by the First arrays.
+    int numBlocks;
+    int *blockOf, *localNum, *blockRoot;
+    int *blockVertexFirst, *blockVertices;
+    int *blockEdgeFirst, *blockEdges;
+
+    // Vertices of the block being decomposed, indexed by local number
+    int n;
+    int *blockVertex, *father, *treeArc, *degree;
+    int *lowpt1, *lowpt2, *nd, *newnum, *nodeAt;
+    int *adjHead, *adjTail, *highHead, *highTail;
+    int *curNode, *nextNode, *curEdge, *treeArcsLeft, *vertexStack;
+
+    // Edges of the block being decomposed, the real edges followed by the
+    // virtual edges created during the decomposition
+    int numEdges, edgeCapacity;
+    int *src, *tgt, *type, *orig, *start, *inAdj, *inHigh;
+    int *comp1, *item1, *comp2, *item2;
+
+    // Node pools of the adjacency lists (indexed by the edge first placed
+    // in the node) and of the high point lists (indexed by edge)
+    int *adjEdge, *adjNext, *adjPrev;
+    int *highVal, *highNext, *highPrev;
+
+    // Stacks of the path search
+    int tTop, eTop;
+    int *tstackH, *tstackA, *tstackB, *estack;
+
+    // Split components, each a circular list of entries around a sentinel
+    int numComps, numEntries;
+    int *compType, *compSentinel, *compMergedInto, *compNode;
+    int *entryEdge, *entryNext, *entryPrev;
+
+    // Scratch arrays for bucket sorting
+    int *bucketCount, *sortTemp, *sortKey;
+
+} SPQRTreeWorkspace;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
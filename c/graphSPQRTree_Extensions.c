@@ -0,0 +1,354 @@
+/*
+Planarity-Related Graph Algorithms Project
+Copyright (c) 1997-2012, John M. Boyer
+All rights reserved. Includes a reference implementation of the following:
+
+* John M. Boyer. "Subgraph Homeomorphism via the Edge Addition Planarity Algorithm".
+  Journal of Graph Algorithms and Applications, Vol. 16, no. 2, pp. 381-410, 2012.
+  http://www.jgaa.info/16/268.html
+
+* John M. Boyer. "A New Method for Efficiently Generating Planar Graph
+  Visibility Representations". In P. Eades and P. Healy, editors,
+  Proceedings of the 13th International Conference on Graph Drawing 2005,
+  Lecture Notes Comput. Sci., Volume 3843, pp. 508-511, Springer-Verlag, 2006.
+
+* John M. Boyer and Wendy J. Myrvold. "On the Cutting Edge: Simplified O(n)
+  Planarity by Edge Addition". Journal of Graph Algorithms and Applications,
+  Vol. 8, No. 3, pp. 241-273, 2004.
+  http://www.jgaa.info/08/91.html
+
+* John M. Boyer. "Simplified O(n) Algorithms for Planar Graph Embedding,
+  Kuratowski Subgraph Isolation, and Related Problems". Ph.D. Dissertation,
+  University of Victoria, 2001.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+  list of conditions and the following disclaimer in the documentation and/or
+  other materials provided with the distribution.
+
+* Neither the name of the Planarity-Related Graph Algorithms Project nor the names
+  of its contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdlib.h>
+
+#include "graphSPQRTree.private.h"
+#include "graphSPQRTree.h"
+
+/* Forward declarations of local functions */
+
+void _SPQRTree_ClearStructures(SPQRTreeContext *context);
+int  _SPQRTree_CreateStructures(SPQRTreeContext *context);
+int  _SPQRTree_InitStructures(SPQRTreeContext *context);
+
+/* Forward declarations of overloading functions */
+
+int  _SPQRTree_InitGraph(graphP theGraph, int N);
+void _SPQRTree_ReinitializeGraph(graphP theGraph);
+
+/* Forward declarations of functions used by the extension system */
+
+void *_SPQRTree_DupContext(void *pContext, void *theGraph);
+void _SPQRTree_FreeContext(void *);
+
+/****************************************************************************
+ * SPQRTREE_ID - the integer identifier for this extension, enabling this
+ * feature's extension context to be distinguished from other features'
+ * extension contexts that may be attached to a graph.
+ ****************************************************************************/
+
+const int SPQRTREE_ID = EXTENSIONID_SPQRTREE;
+
+/****************************************************************************
+ gp_AttachSPQRTree()
+
+ This function adjusts the graph data structure to attach the SPQR tree
+ (triconnected components) feature.
+
+ To activate this feature, call gp_SPQRTree().
+
+ This method may be called immediately after gp_New() in the case of
+ invoking gp_Read().  For generating graphs, gp_InitGraph() can be invoked
+ before or after this enabling method.  The SPQR trees are sized by the
+ number of edges, so they are allocated by gp_SPQRTree() rather than by
+ gp_InitGraph().
+
+ Returns OK for success, NOTOK for failure.
+ ****************************************************************************/
+
+int  gp_AttachSPQRTree(graphP theGraph)
+{
+     SPQRTreeContext *context = NULL;
+     int moduleID = SPQRTREE_ID;
+
+     // If the SPQR tree feature has already been attached to the graph,
+     // then there is no need to attach it again
+     gp_FindExtension(theGraph, SPQRTREE_ID, (void *)&context);
+     if (context != NULL)
+     {
+         return OK;
+     }
+
+     // Allocate a new extension context
+     context = (SPQRTreeContext *) malloc(sizeof(SPQRTreeContext));
+     if (context == NULL)
+     {
+         return NOTOK;
+     }
+
+     // First, tell the context that it is not initialized
+     context->initialized = 0;
+
+     // Save a pointer to theGraph in the context
+     context->theGraph = theGraph;
+
+     // Put the overload functions into the context function table.
+     // gp_AddExtension will overload the graph's functions with these, and
+     // return the base function pointers in the context function table
+     memset(&context->functions, 0, sizeof(graphFunctionTable));
+
+     context->functions.fpInitGraph = _SPQRTree_InitGraph;
+     context->functions.fpReinitializeGraph = _SPQRTree_ReinitializeGraph;
+
+     _SPQRTree_ClearStructures(context);
+
+     // Store the context, including the data structure and the
+     // function pointers, as an extension of the graph
+     if (gp_AddExtension(theGraph, &moduleID, (void *) context,
+                         _SPQRTree_DupContext, _SPQRTree_FreeContext,
+                         &context->functions) != OK)
+     {
+         _SPQRTree_FreeContext(context);
+         return NOTOK;
+     }
+
+     // Create the algorithm-specific structures if the size of the graph is known
+     if (theGraph->N > 0)
+     {
+         if (_SPQRTree_CreateStructures(context) != OK ||
+             _SPQRTree_InitStructures(context) != OK)
+         {
+             _SPQRTree_FreeContext(context);
+             return NOTOK;
+         }
+     }
+
+     return OK;
+}
+
+/********************************************************************
+ gp_DetachSPQRTree()
+ ********************************************************************/
+
+int gp_DetachSPQRTree(graphP theGraph)
+{
+    return gp_RemoveExtension(theGraph, SPQRTREE_ID);
+}
+
+/********************************************************************
+ _SPQRTree_ClearStructures()
+ ********************************************************************/
+
+void _SPQRTree_ClearStructures(SPQRTreeContext *context)
+{
+    if (!context->initialized)
+    {
+        // Before initialization, the pointers are stray, not NULL
+        // Once NULL or allocated, free() can do the job
+        context->treeFirstNode = NULL;
+        context->nodeType = NULL;
+        context->nodeFirstEdge = NULL;
+        context->skeletonU = NULL;
+        context->skeletonV = NULL;
+        context->skeletonEdge = NULL;
+        context->skeletonTwinNode = NULL;
+
+        context->initialized = 1;
+    }
+    else
+    {
+        if (context->treeFirstNode != NULL)
+        {
+            free(context->treeFirstNode);
+            context->treeFirstNode = NULL;
+        }
+        if (context->nodeType != NULL)
+        {
+            free(context->nodeType);
+            context->nodeType = NULL;
+        }
+        if (context->nodeFirstEdge != NULL)
+        {
+            free(context->nodeFirstEdge);
+            context->nodeFirstEdge = NULL;
+        }
+        if (context->skeletonU != NULL)
+        {
+            free(context->skeletonU);
+            context->skeletonU = NULL;
+        }
+        if (context->skeletonV != NULL)
+        {
+            free(context->skeletonV);
+            context->skeletonV = NULL;
+        }
+        if (context->skeletonEdge != NULL)
+        {
+            free(context->skeletonEdge);
+            context->skeletonEdge = NULL;
+        }
+        if (context->skeletonTwinNode != NULL)
+        {
+            free(context->skeletonTwinNode);
+            context->skeletonTwinNode = NULL;
+        }
+    }
+
+    context->numTrees = context->numNodes = context->numSkeletonEdges = 0;
+    context->treeCapacity = context->nodeCapacity = context->skeletonCapacity = 0;
+}
+
+/********************************************************************
+ _SPQRTree_CreateStructures()
+ The SPQR trees are allocated by gp_SPQRTree() once the number of
+ edges is known, so only the graph level is initialized here.
+ ********************************************************************/
+int  _SPQRTree_CreateStructures(SPQRTreeContext *context)
+{
+     if (context->theGraph->N <= 0)
+         return NOTOK;
+
+     _SPQRTree_ClearStructures(context);
+     return OK;
+}
+
+/********************************************************************
+ _SPQRTree_InitStructures()
+ ********************************************************************/
+int  _SPQRTree_InitStructures(SPQRTreeContext *context)
+{
+     return OK;
+}
+
+/********************************************************************
+ _SPQRTree_DupContext()
+ ********************************************************************/
+
+void *_SPQRTree_DupContext(void *pContext, void *pGraph)
+{
+     SPQRTreeContext *context = (SPQRTreeContext *) pContext;
+     SPQRTreeContext *newContext = (SPQRTreeContext *) malloc(sizeof(SPQRTreeContext));
+     graphP theGraph = (graphP) pGraph;
+
+     if (newContext != NULL)
+     {
+         *newContext = *context;
+         newContext->theGraph = theGraph;
+
+         newContext->initialized = 0;
+         _SPQRTree_ClearStructures(newContext);
+
+         // Copy the SPQR trees, if any
+         if (context->numTrees > 0)
+         {
+             int numTrees = context->numTrees, numNodes = context->numNodes;
+             int numSkeletonEdges = context->numSkeletonEdges;
+
+             if ((newContext->treeFirstNode = (int *) malloc((numTrees+1)*sizeof(int))) == NULL ||
+                 (newContext->nodeType = (int *) malloc(numNodes*sizeof(int))) == NULL ||
+                 (newContext->nodeFirstEdge = (int *) malloc((numNodes+1)*sizeof(int))) == NULL ||
+                 (newContext->skeletonU = (int *) malloc(numSkeletonEdges*sizeof(int))) == NULL ||
+                 (newContext->skeletonV = (int *) malloc(numSkeletonEdges*sizeof(int))) == NULL ||
+                 (newContext->skeletonEdge = (int *) malloc(numSkeletonEdges*sizeof(int))) == NULL ||
+                 (newContext->skeletonTwinNode = (int *) malloc(numSkeletonEdges*sizeof(int))) == NULL)
+             {
+                 _SPQRTree_FreeContext(newContext);
+                 return NULL;
+             }
+
+             memcpy(newContext->treeFirstNode, context->treeFirstNode, (numTrees+1)*sizeof(int));
+             memcpy(newContext->nodeType, context->nodeType, numNodes*sizeof(int));
+             memcpy(newContext->nodeFirstEdge, context->nodeFirstEdge, (numNodes+1)*sizeof(int));
+             memcpy(newContext->skeletonU, context->skeletonU, numSkeletonEdges*sizeof(int));
+             memcpy(newContext->skeletonV, context->skeletonV, numSkeletonEdges*sizeof(int));
+             memcpy(newContext->skeletonEdge, context->skeletonEdge, numSkeletonEdges*sizeof(int));
+             memcpy(newContext->skeletonTwinNode, context->skeletonTwinNode, numSkeletonEdges*sizeof(int));
+
+             newContext->numTrees = newContext->treeCapacity = numTrees;
+             newContext->numNodes = newContext->nodeCapacity = numNodes;
+             newContext->numSkeletonEdges = newContext->skeletonCapacity = numSkeletonEdges;
+         }
+     }
+
+     return newContext;
+}
+
+/********************************************************************
+ _SPQRTree_FreeContext()
+ ********************************************************************/
+
+void _SPQRTree_FreeContext(void *pContext)
+{
+     SPQRTreeContext *context = (SPQRTreeContext *) pContext;
+
+     _SPQRTree_ClearStructures(context);
+     free(pContext);
+}
+
+/********************************************************************
+ ********************************************************************/
+
+int  _SPQRTree_InitGraph(graphP theGraph, int N)
+{
+    SPQRTreeContext *context = NULL;
+    gp_FindExtension(theGraph, SPQRTREE_ID, (void *)&context);
+
+    if (context == NULL)
+        return NOTOK;
+
+    theGraph->N = N;
+    if (theGraph->arcCapacity == 0)
+        theGraph->arcCapacity = 2*DEFAULT_EDGE_LIMIT*N;
+
+    if (_SPQRTree_CreateStructures(context) != OK ||
+        _SPQRTree_InitStructures(context) != OK)
+        return NOTOK;
+
+    context->functions.fpInitGraph(theGraph, N);
+
+    return OK;
+}
+
+/********************************************************************
+ ********************************************************************/
+
+void _SPQRTree_ReinitializeGraph(graphP theGraph)
+{
+    SPQRTreeContext *context = (SPQRTreeContext *) gp_GetExtension(theGraph, SPQRTREE_ID);
+
+    if (context != NULL)
+    {
+        // Reinitialize the graph
+        context->functions.fpReinitializeGraph(theGraph);
+
+        // Discard the SPQR trees of the former graph
+        _SPQRTree_ClearStructures(context);
+    }
+}
@@ -0,0 +1,2129 @@
+/*
+Planarity-Related Graph Algorithms Project
+Copyright (c) 1997-2012, John M. Boyer
+All rights reserved. Includes a reference implementation of the following:
+
+* John M. Boyer. "Subgraph Homeomorphism via the Edge Addition Planarity Algorithm".
+  Journal of Graph Algorithms and Applications, Vol. 16, no. 2, pp. 381-410, 2012.
+  http://www.jgaa.info/16/268.html
+
+* John M. Boyer. "A New Method for Efficiently Generating Planar Graph
+  Visibility Representations". In P. Eades and P. Healy, editors,
+  Proceedings of the 13th International Conference on Graph Drawing 2005,
+  Lecture Notes Comput. Sci., Volume 3843, pp. 508-511, Springer-Verlag, 2006.
+
+* John M. Boyer and Wendy J. Myrvold. "On the Cutting Edge: Simplified O(n)
+  Planarity by Edge Addition". Journal of Graph Algorithms and Applications,
+  Vol. 8, No. 3, pp. 241-273, 2004.
+  http://www.jgaa.info/08/91.html
+
+* John M. Boyer. "Simplified O(n) Algorithms for Planar Graph Embedding,
+  Kuratowski Subgraph Isolation, and Related Problems". Ph.D. Dissertation,
+  University of Victoria, 2001.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+  list of conditions and the following disclaimer in the documentation and/or
+  other materials provided with the distribution.
+
+* Neither the name of the Planarity-Related Graph Algorithms Project nor the names
+  of its contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "graphToroidal.h"
+#include "graphToroidal.private.h"
+
+#include "graph.h"
+
+/* Private functions (exported to system) */
+
+int  _TestToroidality(graphP theGraph, ToroidalContext *context);
+int  _CheckToroidalityResult(graphP theGraph, int expectedResult);
+int  _CheckToroidalEmbedding(graphP theGraph);
+
+/* Private functions */
+
+int  _Toroidal_CreateWorkspace(ToroidalWorkspace *ws, int N, int *edgeList, int numEdges, int numThreads);
+void _Toroidal_FreeWorkspace(ToroidalWorkspace *ws);
+int  _Toroidal_NewSearch(ToroidalSearch *search, kuratowskiBridgesP kb, int Vsize);
+void _Toroidal_FreeSearch(ToroidalSearch *search);
+
+int  _Toroidal_Test(ToroidalWorkspace *ws);
+int  _Toroidal_IsolateObstruction(ToroidalWorkspace *ws);
+int  _Toroidal_ExtendSubgraph(ToroidalWorkspace *ws, int buildEmbedding);
+int  _Toroidal_TryCase(void *context, int threadNumber, int k);
+
+int  _Toroidal_BuildFaces(ToroidalSearch *search, int *rotations, int numBranch, int degree);
+int  _Toroidal_FindPlacements(ToroidalSearch *search);
+int  _Toroidal_FaceHasAttachments(ToroidalSearch *search, int b, int f);
+int  _Toroidal_AddPlacement(ToroidalSearch *search, int b, int f, int *choice);
+int  _Toroidal_TestPlacement(ToroidalSearch *search, int p);
+int  _Toroidal_LookupPattern(ToroidalSearch *search, int *key, int keyLength, int *pResult);
+int  _Toroidal_StorePattern(ToroidalSearch *search, int *key, int keyLength, int result);
+int  _Toroidal_HashPattern(int *key, int keyLength);
+int  _Toroidal_TestBridge(ToroidalSearch *search, int b, int *ranks, int numPoints);
+int  _Toroidal_EnsureBridgeGraph(ToroidalSearch *search, int numEdges);
+int  _Toroidal_EnsurePlacementCapacity(ToroidalSearch *search, int dataLength);
+
+int  _Toroidal_PlaceBridges(ToroidalSearch *search);
+int  _Toroidal_AssignBridge(ToroidalSearch *search, int b, int p);
+void _Toroidal_UndoTrail(ToroidalSearch *search, int trailSize);
+int  _Toroidal_Overlap(ToroidalSearch *search, int p1, int p2);
+
+int  _Toroidal_BuildEmbedding(ToroidalWorkspace *ws, ToroidalSearch *search);
+int  _Toroidal_EmbedBridge(ToroidalWorkspace *ws, ToroidalSearch *search, int b);
+int  _Toroidal_EmbedFace(ToroidalWorkspace *ws, ToroidalSearch *search, graphP diskGraph, int *diskEdges, int f, int *pNumCorners);
+int  _Toroidal_GetDiskEdge(graphP diskGraph, int e, int *diskEdges);
+int  _Toroidal_WriteEmbedding(ToroidalWorkspace *ws, graphP theGraph, int *edgeList, int numEdges);
+
+int  _Toroidal_CountFaces(graphP theGraph, FILE *outfile);
+
+/****************************************************************************
+ The labeled embeddings of K_{3,3} and K5 in the torus, up to reflection.
+ Each embedding is given by its rotation system, in which row i lists the
+ labels of the neighbors of the branch vertex labeled i in their cyclic
+ order around it.  For K_{3,3}, the labels 0 to 2 are on one side of the
+ bipartition.
+
+ The embeddings were obtained by an exhaustive enumeration of rotation
+ systems, keeping those with Euler characteristic 0.  A rotation system
+ and its reverse are the same embedding reflected, so only one of them,
+ the one in which the first neighbor of vertex 0 is the lesser of the
+ second and last, is kept.  The faces are obtained by tracing the walks
+ that leave each vertex by the arc that follows the arc on which they
+ arrived, which is the same rule used to trace the faces of the rotation
+ systems stored in the adjacency lists of a graph.  These faces are disks,
+ but their boundaries may visit a vertex more than once.
+ ****************************************************************************/
+
+#define TOROIDAL_NUMK33EMBEDDINGS 20
+#define TOROIDAL_NUMK5EMBEDDINGS  231
+
+static int Toroidal_K33Rotations[20][6][3] = {
+    { {3, 4, 5}, {3, 4, 5}, {3, 4, 5}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2} },
+    { {3, 4, 5}, {3, 4, 5}, {3, 4, 5}, {0, 2, 1}, {0, 2, 1}, {0, 2, 1} },
+    { {3, 4, 5}, {3, 4, 5}, {3, 5, 4}, {0, 1, 2}, {0, 1, 2}, {0, 2, 1} },
+    { {3, 4, 5}, {3, 4, 5}, {3, 5, 4}, {0, 1, 2}, {0, 2, 1}, {0, 1, 2} },
+    { {3, 4, 5}, {3, 4, 5}, {3, 5, 4}, {0, 1, 2}, {0, 2, 1}, {0, 2, 1} },
+    { {3, 4, 5}, {3, 4, 5}, {3, 5, 4}, {0, 2, 1}, {0, 1, 2}, {0, 1, 2} },
+    { {3, 4, 5}, {3, 4, 5}, {3, 5, 4}, {0, 2, 1}, {0, 1, 2}, {0, 2, 1} },
+    { {3, 4, 5}, {3, 4, 5}, {3, 5, 4}, {0, 2, 1}, {0, 2, 1}, {0, 1, 2} },
+    { {3, 4, 5}, {3, 5, 4}, {3, 4, 5}, {0, 1, 2}, {0, 1, 2}, {0, 2, 1} },
+    { {3, 4, 5}, {3, 5, 4}, {3, 4, 5}, {0, 1, 2}, {0, 2, 1}, {0, 1, 2} },
+    { {3, 4, 5}, {3, 5, 4}, {3, 4, 5}, {0, 1, 2}, {0, 2, 1}, {0, 2, 1} },
+    { {3, 4, 5}, {3, 5, 4}, {3, 4, 5}, {0, 2, 1}, {0, 1, 2}, {0, 1, 2} },
+    { {3, 4, 5}, {3, 5, 4}, {3, 4, 5}, {0, 2, 1}, {0, 1, 2}, {0, 2, 1} },
+    { {3, 4, 5}, {3, 5, 4}, {3, 4, 5}, {0, 2, 1}, {0, 2, 1}, {0, 1, 2} },
+    { {3, 4, 5}, {3, 5, 4}, {3, 5, 4}, {0, 1, 2}, {0, 1, 2}, {0, 2, 1} },
+    { {3, 4, 5}, {3, 5, 4}, {3, 5, 4}, {0, 1, 2}, {0, 2, 1}, {0, 1, 2} },
+    { {3, 4, 5}, {3, 5, 4}, {3, 5, 4}, {0, 1, 2}, {0, 2, 1}, {0, 2, 1} },
+    { {3, 4, 5}, {3, 5, 4}, {3, 5, 4}, {0, 2, 1}, {0, 1, 2}, {0, 1, 2} },
+    { {3, 4, 5}, {3, 5, 4}, {3, 5, 4}, {0, 2, 1}, {0, 1, 2}, {0, 2, 1} },
+    { {3, 4, 5}, {3, 5, 4}, {3, 5, 4}, {0, 2, 1}, {0, 2, 1}, {0, 1, 2} }
+};
+static int Toroidal_K5Rotations[231][5][4] = {
+    { {1, 2, 3, 4}, {0, 2, 3, 4}, {0, 1, 4, 3}, {0, 2, 1, 4}, {0, 3, 1, 2} },
+    { {1, 2, 3, 4}, {0, 2, 3, 4}, {0, 1, 4, 3}, {0, 2, 4, 1}, {0, 1, 3, 2} },
+    { {1, 2, 3, 4}, {0, 2, 3, 4}, {0, 3, 1, 4}, {0, 1, 2, 4}, {0, 3, 1, 2} },
+    { {1, 2, 3, 4}, {0, 2, 3, 4}, {0, 3, 1, 4}, {0, 4, 1, 2}, {0, 1, 3, 2} },
+    { {1, 2, 3, 4}, {0, 2, 3, 4}, {0, 4, 1, 3}, {0, 2, 1, 4}, {0, 3, 2, 1} },
+    { {1, 2, 3, 4}, {0, 2, 3, 4}, {0, 4, 1, 3}, {0, 2, 4, 1}, {0, 2, 1, 3} },
+    { {1, 2, 3, 4}, {0, 2, 3, 4}, {0, 4, 3, 1}, {0, 1, 2, 4}, {0, 3, 2, 1} },
+    { {1, 2, 3, 4}, {0, 2, 3, 4}, {0, 4, 3, 1}, {0, 4, 1, 2}, {0, 2, 1, 3} },
+    { {1, 2, 3, 4}, {0, 2, 4, 3}, {0, 1, 4, 3}, {0, 2, 1, 4}, {0, 3, 1, 2} },
+    { {1, 2, 3, 4}, {0, 2, 4, 3}, {0, 1, 4, 3}, {0, 2, 4, 1}, {0, 1, 3, 2} },
+    { {1, 2, 3, 4}, {0, 2, 4, 3}, {0, 3, 1, 4}, {0, 2, 1, 4}, {0, 3, 1, 2} },
+    { {1, 2, 3, 4}, {0, 2, 4, 3}, {0, 3, 1, 4}, {0, 4, 2, 1}, {0, 1, 3, 2} },
+    { {1, 2, 3, 4}, {0, 2, 4, 3}, {0, 3, 4, 1}, {0, 2, 1, 4}, {0, 3, 1, 2} },
+    { {1, 2, 3, 4}, {0, 2, 4, 3}, {0, 3, 4, 1}, {0, 4, 2, 1}, {0, 1, 2, 3} },
+    { {1, 2, 3, 4}, {0, 2, 4, 3}, {0, 4, 1, 3}, {0, 2, 1, 4}, {0, 3, 1, 2} },
+    { {1, 2, 3, 4}, {0, 2, 4, 3}, {0, 4, 1, 3}, {0, 2, 4, 1}, {0, 1, 2, 3} },
+    { {1, 2, 3, 4}, {0, 3, 2, 4}, {0, 3, 4, 1}, {0, 1, 2, 4}, {0, 3, 1, 2} },
+    { {1, 2, 3, 4}, {0, 3, 2, 4}, {0, 3, 4, 1}, {0, 1, 4, 2}, {0, 1, 2, 3} },
+    { {1, 2, 3, 4}, {0, 3, 2, 4}, {0, 4, 1, 3}, {0, 2, 1, 4}, {0, 1, 2, 3} },
+    { {1, 2, 3, 4}, {0, 3, 2, 4}, {0, 4, 1, 3}, {0, 2, 1, 4}, {0, 2, 1, 3} },
+    { {1, 2, 3, 4}, {0, 3, 2, 4}, {0, 4, 1, 3}, {0, 2, 1, 4}, {0, 3, 1, 2} },
+    { {1, 2, 3, 4}, {0, 3, 2, 4}, {0, 4, 1, 3}, {0, 2, 1, 4}, {0, 3, 2, 1} },
+    { {1, 2, 3, 4}, {0, 3, 2, 4}, {0, 4, 3, 1}, {0, 1, 2, 4}, {0, 3, 2, 1} },
+    { {1, 2, 3, 4}, {0, 3, 2, 4}, {0, 4, 3, 1}, {0, 1, 4, 2}, {0, 2, 1, 3} },
+    { {1, 2, 3, 4}, {0, 3, 4, 2}, {0, 1, 3, 4}, {0, 1, 2, 4}, {0, 3, 1, 2} },
+    { {1, 2, 3, 4}, {0, 3, 4, 2}, {0, 1, 3, 4}, {0, 1, 4, 2}, {0, 1, 2, 3} },
+    { {1, 2, 3, 4}, {0, 3, 4, 2}, {0, 1, 3, 4}, {0, 4, 1, 2}, {0, 1, 3, 2} },
+    { {1, 2, 3, 4}, {0, 3, 4, 2}, {0, 1, 4, 3}, {0, 1, 2, 4}, {0, 3, 2, 1} },
+    { {1, 2, 3, 4}, {0, 3, 4, 2}, {0, 1, 4, 3}, {0, 1, 4, 2}, {0, 2, 1, 3} },
+    { {1, 2, 3, 4}, {0, 3, 4, 2}, {0, 1, 4, 3}, {0, 2, 1, 4}, {0, 1, 2, 3} },
+    { {1, 2, 3, 4}, {0, 3, 4, 2}, {0, 1, 4, 3}, {0, 2, 1, 4}, {0, 2, 1, 3} },
+    { {1, 2, 3, 4}, {0, 3, 4, 2}, {0, 1, 4, 3}, {0, 2, 1, 4}, {0, 3, 1, 2} },
+    { {1, 2, 3, 4}, {0, 3, 4, 2}, {0, 1, 4, 3}, {0, 2, 1, 4}, {0, 3, 2, 1} },
+    { {1, 2, 3, 4}, {0, 3, 4, 2}, {0, 1, 4, 3}, {0, 2, 4, 1}, {0, 1, 3, 2} },
+    { {1, 2, 3, 4}, {0, 3, 4, 2}, {0, 1, 4, 3}, {0, 2, 4, 1}, {0, 2, 1, 3} },
+    { {1, 2, 3, 4}, {0, 3, 4, 2}, {0, 1, 4, 3}, {0, 2, 4, 1}, {0, 3, 2, 1} },
+    { {1, 2, 3, 4}, {0, 3, 4, 2}, {0, 1, 4, 3}, {0, 4, 1, 2}, {0, 2, 1, 3} },
+    { {1, 2, 3, 4}, {0, 4, 2, 3}, {0, 1, 4, 3}, {0, 1, 2, 4}, {0, 3, 2, 1} },
+    { {1, 2, 3, 4}, {0, 4, 2, 3}, {0, 1, 4, 3}, {0, 2, 1, 4}, {0, 3, 2, 1} },
+    { {1, 2, 3, 4}, {0, 4, 2, 3}, {0, 1, 4, 3}, {0, 2, 4, 1}, {0, 3, 2, 1} },
+    { {1, 2, 3, 4}, {0, 4, 2, 3}, {0, 3, 1, 4}, {0, 1, 2, 4}, {0, 3, 2, 1} },
+    { {1, 2, 3, 4}, {0, 4, 2, 3}, {0, 3, 1, 4}, {0, 2, 1, 4}, {0, 3, 2, 1} },
+    { {1, 2, 3, 4}, {0, 4, 2, 3}, {0, 3, 1, 4}, {0, 4, 1, 2}, {0, 3, 2, 1} },
+    { {1, 2, 3, 4}, {0, 4, 2, 3}, {0, 3, 1, 4}, {0, 4, 2, 1}, {0, 3, 2, 1} },
+    { {1, 2, 3, 4}, {0, 4, 2, 3}, {0, 3, 4, 1}, {0, 2, 1, 4}, {0, 3, 2, 1} },
+    { {1, 2, 3, 4}, {0, 4, 2, 3}, {0, 3, 4, 1}, {0, 4, 2, 1}, {0, 2, 3, 1} },
+    { {1, 2, 3, 4}, {0, 4, 2, 3}, {0, 4, 1, 3}, {0, 2, 1, 4}, {0, 3, 2, 1} },
+    { {1, 2, 3, 4}, {0, 4, 2, 3}, {0, 4, 1, 3}, {0, 2, 4, 1}, {0, 2, 3, 1} },
+    { {1, 2, 3, 4}, {0, 4, 2, 3}, {0, 4, 3, 1}, {0, 1, 2, 4}, {0, 3, 2, 1} },
+    { {1, 2, 3, 4}, {0, 4, 2, 3}, {0, 4, 3, 1}, {0, 4, 1, 2}, {0, 2, 3, 1} },
+    { {1, 2, 3, 4}, {0, 4, 3, 2}, {0, 1, 3, 4}, {0, 1, 2, 4}, {0, 3, 2, 1} },
+    { {1, 2, 3, 4}, {0, 4, 3, 2}, {0, 1, 3, 4}, {0, 1, 4, 2}, {0, 2, 3, 1} },
+    { {1, 2, 3, 4}, {0, 4, 3, 2}, {0, 1, 3, 4}, {0, 2, 1, 4}, {0, 2, 3, 1} },
+    { {1, 2, 3, 4}, {0, 4, 3, 2}, {0, 1, 3, 4}, {0, 2, 1, 4}, {0, 3, 1, 2} },
+    { {1, 2, 3, 4}, {0, 4, 3, 2}, {0, 1, 3, 4}, {0, 2, 1, 4}, {0, 3, 2, 1} },
+    { {1, 2, 3, 4}, {0, 4, 3, 2}, {0, 1, 3, 4}, {0, 4, 1, 2}, {0, 3, 2, 1} },
+    { {1, 2, 3, 4}, {0, 4, 3, 2}, {0, 1, 3, 4}, {0, 4, 2, 1}, {0, 1, 2, 3} },
+    { {1, 2, 3, 4}, {0, 4, 3, 2}, {0, 1, 3, 4}, {0, 4, 2, 1}, {0, 1, 3, 2} },
+    { {1, 2, 3, 4}, {0, 4, 3, 2}, {0, 1, 3, 4}, {0, 4, 2, 1}, {0, 2, 3, 1} },
+    { {1, 2, 3, 4}, {0, 4, 3, 2}, {0, 1, 3, 4}, {0, 4, 2, 1}, {0, 3, 2, 1} },
+    { {1, 2, 3, 4}, {0, 4, 3, 2}, {0, 1, 4, 3}, {0, 1, 2, 4}, {0, 3, 2, 1} },
+    { {1, 2, 3, 4}, {0, 4, 3, 2}, {0, 1, 4, 3}, {0, 1, 4, 2}, {0, 2, 3, 1} },
+    { {1, 2, 3, 4}, {0, 4, 3, 2}, {0, 1, 4, 3}, {0, 2, 1, 4}, {0, 2, 3, 1} },
+    { {1, 2, 3, 4}, {0, 4, 3, 2}, {0, 1, 4, 3}, {0, 2, 1, 4}, {0, 3, 1, 2} },
+    { {1, 2, 3, 4}, {0, 4, 3, 2}, {0, 1, 4, 3}, {0, 2, 1, 4}, {0, 3, 2, 1} },
+    { {1, 2, 3, 4}, {0, 4, 3, 2}, {0, 1, 4, 3}, {0, 2, 4, 1}, {0, 1, 2, 3} },
+    { {1, 2, 3, 4}, {0, 4, 3, 2}, {0, 1, 4, 3}, {0, 2, 4, 1}, {0, 1, 3, 2} },
+    { {1, 2, 3, 4}, {0, 4, 3, 2}, {0, 1, 4, 3}, {0, 2, 4, 1}, {0, 2, 3, 1} },
+    { {1, 2, 3, 4}, {0, 4, 3, 2}, {0, 1, 4, 3}, {0, 2, 4, 1}, {0, 3, 2, 1} },
+    { {1, 2, 3, 4}, {0, 4, 3, 2}, {0, 1, 4, 3}, {0, 4, 1, 2}, {0, 2, 3, 1} },
+    { {1, 2, 3, 4}, {0, 4, 3, 2}, {0, 3, 4, 1}, {0, 1, 2, 4}, {0, 3, 2, 1} },
+    { {1, 2, 3, 4}, {0, 4, 3, 2}, {0, 3, 4, 1}, {0, 1, 4, 2}, {0, 2, 3, 1} },
+    { {1, 2, 3, 4}, {0, 4, 3, 2}, {0, 4, 1, 3}, {0, 2, 1, 4}, {0, 2, 3, 1} },
+    { {1, 2, 3, 4}, {0, 4, 3, 2}, {0, 4, 1, 3}, {0, 2, 1, 4}, {0, 3, 1, 2} },
+    { {1, 2, 3, 4}, {0, 4, 3, 2}, {0, 4, 1, 3}, {0, 2, 1, 4}, {0, 3, 2, 1} },
+    { {1, 2, 3, 4}, {0, 4, 3, 2}, {0, 4, 3, 1}, {0, 1, 2, 4}, {0, 3, 2, 1} },
+    { {1, 2, 3, 4}, {0, 4, 3, 2}, {0, 4, 3, 1}, {0, 1, 4, 2}, {0, 2, 3, 1} },
+    { {1, 2, 4, 3}, {0, 2, 3, 4}, {0, 1, 3, 4}, {0, 1, 4, 2}, {0, 2, 3, 1} },
+    { {1, 2, 4, 3}, {0, 2, 3, 4}, {0, 1, 3, 4}, {0, 4, 1, 2}, {0, 2, 1, 3} },
+    { {1, 2, 4, 3}, {0, 2, 3, 4}, {0, 3, 1, 4}, {0, 1, 2, 4}, {0, 2, 3, 1} },
+    { {1, 2, 4, 3}, {0, 2, 3, 4}, {0, 3, 1, 4}, {0, 4, 1, 2}, {0, 2, 1, 3} },
+    { {1, 2, 4, 3}, {0, 2, 3, 4}, {0, 4, 1, 3}, {0, 1, 4, 2}, {0, 3, 2, 1} },
+    { {1, 2, 4, 3}, {0, 2, 3, 4}, {0, 4, 1, 3}, {0, 4, 1, 2}, {0, 2, 1, 3} },
+    { {1, 2, 4, 3}, {0, 2, 3, 4}, {0, 4, 3, 1}, {0, 1, 2, 4}, {0, 3, 2, 1} },
+    { {1, 2, 4, 3}, {0, 2, 3, 4}, {0, 4, 3, 1}, {0, 4, 1, 2}, {0, 2, 1, 3} },
+    { {1, 2, 4, 3}, {0, 2, 4, 3}, {0, 1, 3, 4}, {0, 1, 4, 2}, {0, 2, 3, 1} },
+    { {1, 2, 4, 3}, {0, 2, 4, 3}, {0, 1, 3, 4}, {0, 4, 1, 2}, {0, 2, 1, 3} },
+    { {1, 2, 4, 3}, {0, 2, 4, 3}, {0, 3, 1, 4}, {0, 2, 1, 4}, {0, 2, 3, 1} },
+    { {1, 2, 4, 3}, {0, 2, 4, 3}, {0, 3, 1, 4}, {0, 4, 2, 1}, {0, 2, 1, 3} },
+    { {1, 2, 4, 3}, {0, 2, 4, 3}, {0, 3, 4, 1}, {0, 2, 1, 4}, {0, 3, 1, 2} },
+    { {1, 2, 4, 3}, {0, 2, 4, 3}, {0, 3, 4, 1}, {0, 4, 2, 1}, {0, 1, 2, 3} },
+    { {1, 2, 4, 3}, {0, 2, 4, 3}, {0, 4, 1, 3}, {0, 1, 4, 2}, {0, 3, 1, 2} },
+    { {1, 2, 4, 3}, {0, 2, 4, 3}, {0, 4, 1, 3}, {0, 4, 1, 2}, {0, 1, 2, 3} },
+    { {1, 2, 4, 3}, {0, 3, 2, 4}, {0, 1, 3, 4}, {0, 4, 2, 1}, {0, 1, 2, 3} },
+    { {1, 2, 4, 3}, {0, 3, 2, 4}, {0, 1, 3, 4}, {0, 4, 2, 1}, {0, 2, 1, 3} },
+    { {1, 2, 4, 3}, {0, 3, 2, 4}, {0, 1, 3, 4}, {0, 4, 2, 1}, {0, 2, 3, 1} },
+    { {1, 2, 4, 3}, {0, 3, 2, 4}, {0, 3, 1, 4}, {0, 2, 4, 1}, {0, 2, 3, 1} },
+    { {1, 2, 4, 3}, {0, 3, 2, 4}, {0, 3, 1, 4}, {0, 4, 2, 1}, {0, 2, 1, 3} },
+    { {1, 2, 4, 3}, {0, 3, 2, 4}, {0, 3, 4, 1}, {0, 2, 4, 1}, {0, 3, 1, 2} },
+    { {1, 2, 4, 3}, {0, 3, 2, 4}, {0, 3, 4, 1}, {0, 4, 2, 1}, {0, 1, 2, 3} },
+    { {1, 2, 4, 3}, {0, 3, 2, 4}, {0, 4, 1, 3}, {0, 4, 2, 1}, {0, 1, 2, 3} },
+    { {1, 2, 4, 3}, {0, 3, 2, 4}, {0, 4, 1, 3}, {0, 4, 2, 1}, {0, 2, 1, 3} },
+    { {1, 2, 4, 3}, {0, 3, 2, 4}, {0, 4, 1, 3}, {0, 4, 2, 1}, {0, 3, 1, 2} },
+    { {1, 2, 4, 3}, {0, 3, 2, 4}, {0, 4, 1, 3}, {0, 4, 2, 1}, {0, 3, 2, 1} },
+    { {1, 2, 4, 3}, {0, 3, 2, 4}, {0, 4, 3, 1}, {0, 2, 4, 1}, {0, 3, 2, 1} },
+    { {1, 2, 4, 3}, {0, 3, 2, 4}, {0, 4, 3, 1}, {0, 4, 2, 1}, {0, 2, 1, 3} },
+    { {1, 2, 4, 3}, {0, 3, 4, 2}, {0, 1, 3, 4}, {0, 1, 2, 4}, {0, 2, 3, 1} },
+    { {1, 2, 4, 3}, {0, 3, 4, 2}, {0, 1, 3, 4}, {0, 1, 4, 2}, {0, 2, 3, 1} },
+    { {1, 2, 4, 3}, {0, 3, 4, 2}, {0, 1, 3, 4}, {0, 2, 4, 1}, {0, 1, 3, 2} },
+    { {1, 2, 4, 3}, {0, 3, 4, 2}, {0, 1, 3, 4}, {0, 2, 4, 1}, {0, 2, 1, 3} },
+    { {1, 2, 4, 3}, {0, 3, 4, 2}, {0, 1, 3, 4}, {0, 2, 4, 1}, {0, 2, 3, 1} },
+    { {1, 2, 4, 3}, {0, 3, 4, 2}, {0, 1, 3, 4}, {0, 2, 4, 1}, {0, 3, 1, 2} },
+    { {1, 2, 4, 3}, {0, 3, 4, 2}, {0, 1, 3, 4}, {0, 4, 1, 2}, {0, 2, 1, 3} },
+    { {1, 2, 4, 3}, {0, 3, 4, 2}, {0, 1, 3, 4}, {0, 4, 2, 1}, {0, 1, 2, 3} },
+    { {1, 2, 4, 3}, {0, 3, 4, 2}, {0, 1, 3, 4}, {0, 4, 2, 1}, {0, 2, 1, 3} },
+    { {1, 2, 4, 3}, {0, 3, 4, 2}, {0, 1, 3, 4}, {0, 4, 2, 1}, {0, 2, 3, 1} },
+    { {1, 2, 4, 3}, {0, 3, 4, 2}, {0, 1, 4, 3}, {0, 1, 2, 4}, {0, 3, 2, 1} },
+    { {1, 2, 4, 3}, {0, 3, 4, 2}, {0, 1, 4, 3}, {0, 1, 4, 2}, {0, 3, 2, 1} },
+    { {1, 2, 4, 3}, {0, 3, 4, 2}, {0, 1, 4, 3}, {0, 2, 4, 1}, {0, 1, 3, 2} },
+    { {1, 2, 4, 3}, {0, 3, 4, 2}, {0, 1, 4, 3}, {0, 2, 4, 1}, {0, 2, 1, 3} },
+    { {1, 2, 4, 3}, {0, 3, 4, 2}, {0, 1, 4, 3}, {0, 2, 4, 1}, {0, 3, 2, 1} },
+    { {1, 2, 4, 3}, {0, 3, 4, 2}, {0, 1, 4, 3}, {0, 4, 1, 2}, {0, 2, 1, 3} },
+    { {1, 2, 4, 3}, {0, 3, 4, 2}, {0, 1, 4, 3}, {0, 4, 2, 1}, {0, 1, 2, 3} },
+    { {1, 2, 4, 3}, {0, 3, 4, 2}, {0, 1, 4, 3}, {0, 4, 2, 1}, {0, 2, 1, 3} },
+    { {1, 2, 4, 3}, {0, 3, 4, 2}, {0, 1, 4, 3}, {0, 4, 2, 1}, {0, 3, 1, 2} },
+    { {1, 2, 4, 3}, {0, 3, 4, 2}, {0, 1, 4, 3}, {0, 4, 2, 1}, {0, 3, 2, 1} },
+    { {1, 2, 4, 3}, {0, 3, 4, 2}, {0, 3, 1, 4}, {0, 2, 4, 1}, {0, 2, 1, 3} },
+    { {1, 2, 4, 3}, {0, 3, 4, 2}, {0, 3, 1, 4}, {0, 4, 1, 2}, {0, 2, 1, 3} },
+    { {1, 2, 4, 3}, {0, 3, 4, 2}, {0, 3, 1, 4}, {0, 4, 2, 1}, {0, 2, 1, 3} },
+    { {1, 2, 4, 3}, {0, 3, 4, 2}, {0, 3, 4, 1}, {0, 2, 4, 1}, {0, 1, 3, 2} },
+    { {1, 2, 4, 3}, {0, 3, 4, 2}, {0, 3, 4, 1}, {0, 4, 2, 1}, {0, 1, 2, 3} },
+    { {1, 2, 4, 3}, {0, 3, 4, 2}, {0, 4, 3, 1}, {0, 2, 4, 1}, {0, 1, 3, 2} },
+    { {1, 2, 4, 3}, {0, 3, 4, 2}, {0, 4, 3, 1}, {0, 4, 2, 1}, {0, 1, 2, 3} },
+    { {1, 2, 4, 3}, {0, 4, 2, 3}, {0, 3, 1, 4}, {0, 1, 2, 4}, {0, 2, 1, 3} },
+    { {1, 2, 4, 3}, {0, 4, 2, 3}, {0, 3, 1, 4}, {0, 2, 1, 4}, {0, 2, 1, 3} },
+    { {1, 2, 4, 3}, {0, 4, 2, 3}, {0, 3, 1, 4}, {0, 4, 1, 2}, {0, 2, 1, 3} },
+    { {1, 2, 4, 3}, {0, 4, 2, 3}, {0, 3, 1, 4}, {0, 4, 2, 1}, {0, 2, 1, 3} },
+    { {1, 2, 4, 3}, {0, 4, 2, 3}, {0, 3, 4, 1}, {0, 2, 1, 4}, {0, 1, 3, 2} },
+    { {1, 2, 4, 3}, {0, 4, 2, 3}, {0, 3, 4, 1}, {0, 4, 2, 1}, {0, 1, 2, 3} },
+    { {1, 2, 4, 3}, {0, 4, 2, 3}, {0, 4, 3, 1}, {0, 1, 2, 4}, {0, 1, 3, 2} },
+    { {1, 2, 4, 3}, {0, 4, 2, 3}, {0, 4, 3, 1}, {0, 4, 1, 2}, {0, 1, 2, 3} },
+    { {1, 2, 4, 3}, {0, 4, 3, 2}, {0, 1, 3, 4}, {0, 1, 2, 4}, {0, 2, 1, 3} },
+    { {1, 2, 4, 3}, {0, 4, 3, 2}, {0, 1, 3, 4}, {0, 1, 4, 2}, {0, 2, 3, 1} },
+    { {1, 2, 4, 3}, {0, 4, 3, 2}, {0, 1, 3, 4}, {0, 2, 1, 4}, {0, 1, 3, 2} },
+    { {1, 2, 4, 3}, {0, 4, 3, 2}, {0, 1, 3, 4}, {0, 2, 1, 4}, {0, 2, 1, 3} },
+    { {1, 2, 4, 3}, {0, 4, 3, 2}, {0, 1, 3, 4}, {0, 2, 1, 4}, {0, 2, 3, 1} },
+    { {1, 2, 4, 3}, {0, 4, 3, 2}, {0, 1, 3, 4}, {0, 2, 1, 4}, {0, 3, 1, 2} },
+    { {1, 2, 4, 3}, {0, 4, 3, 2}, {0, 1, 3, 4}, {0, 4, 1, 2}, {0, 2, 1, 3} },
+    { {1, 2, 4, 3}, {0, 4, 3, 2}, {0, 1, 3, 4}, {0, 4, 2, 1}, {0, 1, 2, 3} },
+    { {1, 2, 4, 3}, {0, 4, 3, 2}, {0, 1, 3, 4}, {0, 4, 2, 1}, {0, 2, 1, 3} },
+    { {1, 2, 4, 3}, {0, 4, 3, 2}, {0, 1, 3, 4}, {0, 4, 2, 1}, {0, 2, 3, 1} },
+    { {1, 2, 4, 3}, {0, 4, 3, 2}, {0, 1, 4, 3}, {0, 1, 2, 4}, {0, 1, 3, 2} },
+    { {1, 2, 4, 3}, {0, 4, 3, 2}, {0, 1, 4, 3}, {0, 1, 4, 2}, {0, 3, 1, 2} },
+    { {1, 2, 4, 3}, {0, 4, 3, 2}, {0, 1, 4, 3}, {0, 4, 1, 2}, {0, 1, 2, 3} },
+    { {1, 3, 2, 4}, {0, 2, 3, 4}, {0, 1, 3, 4}, {0, 2, 4, 1}, {0, 2, 1, 3} },
+    { {1, 3, 2, 4}, {0, 2, 3, 4}, {0, 1, 3, 4}, {0, 4, 2, 1}, {0, 2, 3, 1} },
+    { {1, 3, 2, 4}, {0, 2, 3, 4}, {0, 1, 4, 3}, {0, 2, 4, 1}, {0, 1, 3, 2} },
+    { {1, 3, 2, 4}, {0, 2, 3, 4}, {0, 1, 4, 3}, {0, 4, 2, 1}, {0, 3, 1, 2} },
+    { {1, 3, 2, 4}, {0, 2, 3, 4}, {0, 3, 1, 4}, {0, 4, 1, 2}, {0, 1, 3, 2} },
+    { {1, 3, 2, 4}, {0, 2, 3, 4}, {0, 3, 1, 4}, {0, 4, 1, 2}, {0, 2, 1, 3} },
+    { {1, 3, 2, 4}, {0, 2, 3, 4}, {0, 3, 1, 4}, {0, 4, 1, 2}, {0, 2, 3, 1} },
+    { {1, 3, 2, 4}, {0, 2, 3, 4}, {0, 3, 1, 4}, {0, 4, 1, 2}, {0, 3, 1, 2} },
+    { {1, 3, 2, 4}, {0, 2, 4, 3}, {0, 1, 3, 4}, {0, 1, 2, 4}, {0, 2, 1, 3} },
+    { {1, 3, 2, 4}, {0, 2, 4, 3}, {0, 1, 3, 4}, {0, 1, 4, 2}, {0, 2, 3, 1} },
+    { {1, 3, 2, 4}, {0, 2, 4, 3}, {0, 1, 4, 3}, {0, 1, 2, 4}, {0, 1, 3, 2} },
+    { {1, 3, 2, 4}, {0, 2, 4, 3}, {0, 1, 4, 3}, {0, 1, 4, 2}, {0, 3, 1, 2} },
+    { {1, 3, 2, 4}, {0, 2, 4, 3}, {0, 3, 1, 4}, {0, 1, 4, 2}, {0, 1, 3, 2} },
+    { {1, 3, 2, 4}, {0, 2, 4, 3}, {0, 3, 1, 4}, {0, 1, 4, 2}, {0, 2, 1, 3} },
+    { {1, 3, 2, 4}, {0, 2, 4, 3}, {0, 3, 1, 4}, {0, 1, 4, 2}, {0, 2, 3, 1} },
+    { {1, 3, 2, 4}, {0, 2, 4, 3}, {0, 3, 1, 4}, {0, 1, 4, 2}, {0, 3, 1, 2} },
+    { {1, 3, 2, 4}, {0, 2, 4, 3}, {0, 3, 4, 1}, {0, 1, 4, 2}, {0, 1, 2, 3} },
+    { {1, 3, 2, 4}, {0, 2, 4, 3}, {0, 3, 4, 1}, {0, 1, 4, 2}, {0, 2, 3, 1} },
+    { {1, 3, 2, 4}, {0, 2, 4, 3}, {0, 3, 4, 1}, {0, 1, 4, 2}, {0, 3, 1, 2} },
+    { {1, 3, 2, 4}, {0, 2, 4, 3}, {0, 4, 1, 3}, {0, 1, 2, 4}, {0, 1, 2, 3} },
+    { {1, 3, 2, 4}, {0, 2, 4, 3}, {0, 4, 1, 3}, {0, 1, 4, 2}, {0, 3, 1, 2} },
+    { {1, 3, 2, 4}, {0, 3, 2, 4}, {0, 1, 3, 4}, {0, 2, 1, 4}, {0, 2, 1, 3} },
+    { {1, 3, 2, 4}, {0, 3, 2, 4}, {0, 1, 3, 4}, {0, 4, 2, 1}, {0, 2, 3, 1} },
+    { {1, 3, 2, 4}, {0, 3, 2, 4}, {0, 3, 1, 4}, {0, 1, 4, 2}, {0, 2, 1, 3} },
+    { {1, 3, 2, 4}, {0, 3, 2, 4}, {0, 3, 1, 4}, {0, 4, 1, 2}, {0, 2, 3, 1} },
+    { {1, 3, 2, 4}, {0, 3, 2, 4}, {0, 3, 4, 1}, {0, 1, 4, 2}, {0, 1, 2, 3} },
+    { {1, 3, 2, 4}, {0, 3, 2, 4}, {0, 3, 4, 1}, {0, 4, 1, 2}, {0, 3, 1, 2} },
+    { {1, 3, 2, 4}, {0, 3, 2, 4}, {0, 4, 1, 3}, {0, 2, 1, 4}, {0, 1, 2, 3} },
+    { {1, 3, 2, 4}, {0, 3, 2, 4}, {0, 4, 1, 3}, {0, 4, 2, 1}, {0, 3, 1, 2} },
+    { {1, 3, 2, 4}, {0, 3, 4, 2}, {0, 3, 1, 4}, {0, 1, 4, 2}, {0, 2, 1, 3} },
+    { {1, 3, 2, 4}, {0, 3, 4, 2}, {0, 3, 1, 4}, {0, 2, 1, 4}, {0, 2, 1, 3} },
+    { {1, 3, 2, 4}, {0, 3, 4, 2}, {0, 3, 1, 4}, {0, 2, 4, 1}, {0, 2, 1, 3} },
+    { {1, 3, 2, 4}, {0, 3, 4, 2}, {0, 3, 1, 4}, {0, 4, 1, 2}, {0, 2, 1, 3} },
+    { {1, 3, 2, 4}, {0, 3, 4, 2}, {0, 3, 4, 1}, {0, 1, 4, 2}, {0, 1, 2, 3} },
+    { {1, 3, 2, 4}, {0, 3, 4, 2}, {0, 3, 4, 1}, {0, 4, 1, 2}, {0, 1, 3, 2} },
+    { {1, 3, 2, 4}, {0, 3, 4, 2}, {0, 4, 3, 1}, {0, 2, 1, 4}, {0, 1, 2, 3} },
+    { {1, 3, 2, 4}, {0, 3, 4, 2}, {0, 4, 3, 1}, {0, 2, 4, 1}, {0, 1, 3, 2} },
+    { {1, 3, 2, 4}, {0, 4, 2, 3}, {0, 1, 3, 4}, {0, 1, 2, 4}, {0, 2, 3, 1} },
+    { {1, 3, 2, 4}, {0, 4, 2, 3}, {0, 1, 3, 4}, {0, 1, 4, 2}, {0, 2, 3, 1} },
+    { {1, 3, 2, 4}, {0, 4, 2, 3}, {0, 1, 3, 4}, {0, 2, 4, 1}, {0, 2, 3, 1} },
+    { {1, 3, 2, 4}, {0, 4, 2, 3}, {0, 1, 3, 4}, {0, 4, 2, 1}, {0, 2, 3, 1} },
+    { {1, 3, 2, 4}, {0, 4, 2, 3}, {0, 1, 4, 3}, {0, 1, 2, 4}, {0, 3, 2, 1} },
+    { {1, 3, 2, 4}, {0, 4, 2, 3}, {0, 1, 4, 3}, {0, 1, 4, 2}, {0, 3, 2, 1} },
+    { {1, 3, 2, 4}, {0, 4, 2, 3}, {0, 1, 4, 3}, {0, 2, 4, 1}, {0, 3, 2, 1} },
+    { {1, 3, 2, 4}, {0, 4, 2, 3}, {0, 1, 4, 3}, {0, 4, 2, 1}, {0, 3, 2, 1} },
+    { {1, 3, 2, 4}, {0, 4, 2, 3}, {0, 3, 1, 4}, {0, 1, 2, 4}, {0, 2, 1, 3} },
+    { {1, 3, 2, 4}, {0, 4, 2, 3}, {0, 3, 1, 4}, {0, 1, 2, 4}, {0, 2, 3, 1} },
+    { {1, 3, 2, 4}, {0, 4, 2, 3}, {0, 3, 1, 4}, {0, 1, 2, 4}, {0, 3, 2, 1} },
+    { {1, 3, 2, 4}, {0, 4, 2, 3}, {0, 3, 1, 4}, {0, 1, 4, 2}, {0, 2, 1, 3} },
+    { {1, 3, 2, 4}, {0, 4, 2, 3}, {0, 3, 1, 4}, {0, 1, 4, 2}, {0, 2, 3, 1} },
+    { {1, 3, 2, 4}, {0, 4, 2, 3}, {0, 3, 1, 4}, {0, 1, 4, 2}, {0, 3, 2, 1} },
+    { {1, 3, 2, 4}, {0, 4, 2, 3}, {0, 3, 1, 4}, {0, 4, 1, 2}, {0, 2, 1, 3} },
+    { {1, 3, 2, 4}, {0, 4, 2, 3}, {0, 3, 1, 4}, {0, 4, 1, 2}, {0, 2, 3, 1} },
+    { {1, 3, 2, 4}, {0, 4, 2, 3}, {0, 3, 1, 4}, {0, 4, 1, 2}, {0, 3, 2, 1} },
+    { {1, 3, 2, 4}, {0, 4, 2, 3}, {0, 3, 4, 1}, {0, 1, 4, 2}, {0, 1, 2, 3} },
+    { {1, 3, 2, 4}, {0, 4, 2, 3}, {0, 3, 4, 1}, {0, 1, 4, 2}, {0, 1, 3, 2} },
+    { {1, 3, 2, 4}, {0, 4, 2, 3}, {0, 3, 4, 1}, {0, 1, 4, 2}, {0, 2, 3, 1} },
+    { {1, 3, 2, 4}, {0, 4, 2, 3}, {0, 3, 4, 1}, {0, 1, 4, 2}, {0, 3, 2, 1} },
+    { {1, 3, 2, 4}, {0, 4, 2, 3}, {0, 4, 1, 3}, {0, 1, 2, 4}, {0, 2, 3, 1} },
+    { {1, 3, 2, 4}, {0, 4, 2, 3}, {0, 4, 1, 3}, {0, 1, 4, 2}, {0, 3, 2, 1} },
+    { {1, 3, 2, 4}, {0, 4, 2, 3}, {0, 4, 3, 1}, {0, 1, 2, 4}, {0, 1, 2, 3} },
+    { {1, 3, 2, 4}, {0, 4, 2, 3}, {0, 4, 3, 1}, {0, 1, 2, 4}, {0, 1, 3, 2} },
+    { {1, 3, 2, 4}, {0, 4, 2, 3}, {0, 4, 3, 1}, {0, 1, 2, 4}, {0, 2, 3, 1} },
+    { {1, 3, 2, 4}, {0, 4, 2, 3}, {0, 4, 3, 1}, {0, 1, 2, 4}, {0, 3, 2, 1} },
+    { {1, 3, 2, 4}, {0, 4, 3, 2}, {0, 1, 3, 4}, {0, 1, 4, 2}, {0, 2, 3, 1} },
+    { {1, 3, 2, 4}, {0, 4, 3, 2}, {0, 1, 3, 4}, {0, 2, 1, 4}, {0, 2, 3, 1} },
+    { {1, 3, 2, 4}, {0, 4, 3, 2}, {0, 1, 3, 4}, {0, 4, 2, 1}, {0, 2, 3, 1} },
+    { {1, 3, 2, 4}, {0, 4, 3, 2}, {0, 3, 1, 4}, {0, 1, 4, 2}, {0, 2, 3, 1} },
+    { {1, 3, 2, 4}, {0, 4, 3, 2}, {0, 3, 1, 4}, {0, 2, 1, 4}, {0, 2, 3, 1} },
+    { {1, 3, 2, 4}, {0, 4, 3, 2}, {0, 3, 1, 4}, {0, 2, 4, 1}, {0, 2, 3, 1} },
+    { {1, 3, 2, 4}, {0, 4, 3, 2}, {0, 3, 1, 4}, {0, 4, 1, 2}, {0, 2, 3, 1} },
+    { {1, 3, 2, 4}, {0, 4, 3, 2}, {0, 3, 4, 1}, {0, 1, 4, 2}, {0, 2, 3, 1} },
+    { {1, 3, 2, 4}, {0, 4, 3, 2}, {0, 3, 4, 1}, {0, 4, 1, 2}, {0, 3, 2, 1} },
+    { {1, 3, 2, 4}, {0, 4, 3, 2}, {0, 4, 1, 3}, {0, 2, 1, 4}, {0, 2, 3, 1} },
+    { {1, 3, 2, 4}, {0, 4, 3, 2}, {0, 4, 1, 3}, {0, 4, 2, 1}, {0, 3, 2, 1} },
+    { {1, 3, 2, 4}, {0, 4, 3, 2}, {0, 4, 3, 1}, {0, 2, 1, 4}, {0, 2, 3, 1} },
+    { {1, 3, 2, 4}, {0, 4, 3, 2}, {0, 4, 3, 1}, {0, 2, 4, 1}, {0, 3, 2, 1} }
+};
+
+/****************************************************************************
+ _TestToroidality()
+
+ The Walkdown has isolated a K5 or K_{3,3} homeomorph H in theGraph, so
+ the input graph recorded in the context is tested for an embedding in
+ the torus by trying to extend each embedding of H.
+
+ If the input graph is toroidal, then theGraph receives the edges of the
+ input graph, with adjacency lists ordered to give a torus embedding, and
+ OK is returned.  Otherwise, theGraph receives a minimal subgraph of the
+ input graph that does not embed in the torus, and NONEMBEDDABLE is
+ returned.
+
+ Returns NOTOK on internal error.
+ ****************************************************************************/
+
+int  _TestToroidality(graphP theGraph, ToroidalContext *context)
+{
+     ToroidalWorkspace ws;
+     int RetVal;
+
+     if (_Toroidal_CreateWorkspace(&ws, theGraph->N, context->edgeList, context->numEdges, 0) != OK)
+         return NOTOK;
+
+     // A graph embedded in the torus has at most 3N edges.
+     // Otherwise, the subgraph H isolated in theGraph is extended
+     if (ws.kb.M > 3*ws.kb.N)
+         RetVal = NONEMBEDDABLE;
+     else if (_KuratowskiBridges_GetSubgraph(&ws.kb, theGraph, FALSE) != OK)
+         RetVal = NOTOK;
+     else
+         RetVal = _Toroidal_ExtendSubgraph(&ws, TRUE);
+
+     if (RetVal == OK)
+     {
+         if (_Toroidal_WriteEmbedding(&ws, theGraph, context->edgeList, context->numEdges) != OK)
+             RetVal = NOTOK;
+     }
+     else if (RetVal == NONEMBEDDABLE)
+     {
+         if (_Toroidal_IsolateObstruction(&ws) != OK ||
+             _KuratowskiBridges_ReplaceEdges(theGraph, ws.kb.edges, ws.kb.M) != OK)
+             RetVal = NOTOK;
+     }
+
+     _Toroidal_FreeWorkspace(&ws);
+     return RetVal;
+}
+
+/****************************************************************************
+ _CheckToroidalityResult()
+
+ Tests the edges of theGraph for an embedding in the torus, for the
+ integrity checks of the results of gp_Embed().
+
+ Returns OK if the test result is the expectedResult, NOTOK otherwise
+ ****************************************************************************/
+
+int  _CheckToroidalityResult(graphP theGraph, int expectedResult)
+{
+     ToroidalWorkspace ws;
+     int *edgeList, numEdges = 0, EsizeOccupied, e, RetVal;
+
+     EsizeOccupied = gp_EdgeInUseIndexBound(theGraph);
+     if ((edgeList = (int *) malloc((EsizeOccupied+1) * sizeof(int))) == NULL)
+         return NOTOK;
+
+     for (e = gp_GetFirstEdge(theGraph); e < EsizeOccupied; e += 2)
+     {
+         if (gp_EdgeInUse(theGraph, e))
+         {
+             edgeList[2*numEdges] = gp_GetNeighbor(theGraph, gp_GetTwinArc(theGraph, e));
+             edgeList[2*numEdges+1] = gp_GetNeighbor(theGraph, e);
+             numEdges++;
+         }
+     }
+
+     RetVal = _Toroidal_CreateWorkspace(&ws, theGraph->N, edgeList, numEdges, 0);
+     free(edgeList);
+     if (RetVal != OK)
+         return NOTOK;
+
+     RetVal = _Toroidal_Test(&ws) == expectedResult ? OK : NOTOK;
+
+     _Toroidal_FreeWorkspace(&ws);
+     return RetVal;
+}
+
+/****************************************************************************
+ _CheckToroidalEmbedding()
+
+ Ensures the adjacency lists of theGraph give a torus embedding.  The
+ faces of the rotation system are traced, and each connected component
+ with c vertices, m edges and f faces has genus (2 - c + m - f)/2.  The
+ embedding is toroidal if the sum of the genera is at most one.
+
+ Returns OK if theGraph is embedded in the torus, NOTOK otherwise
+ ****************************************************************************/
+
+int  _CheckToroidalEmbedding(graphP theGraph)
+{
+     int *parent, v, e, u, w, numVertices = 0, numComponents = 0, numEdges = 0, numFaces;
+
+     parent = (int *) malloc(gp_PrimaryVertexIndexBound(theGraph) * sizeof(int));
+     if (parent == NULL)
+         return NOTOK;
+
+     // Find the connected components with a union-find forest
+     for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
+         parent[v] = v;
+
+     for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
+     {
+         e = gp_GetFirstArc(theGraph, v);
+         if (gp_IsArc(e))
+             numVertices++;
+
+         while (gp_IsArc(e))
+         {
+             numEdges++;
+             for (u = v; parent[u] != u; u = parent[u])
+                 ;
+             for (w = gp_GetNeighbor(theGraph, e); parent[w] != w; w = parent[w])
+                 ;
+             if (u != w)
+                 parent[u] = w;
+
+             e = gp_GetNextArc(theGraph, e);
+         }
+     }
+     numEdges /= 2;
+
+     for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
+     {
+         if (parent[v] == v && gp_IsArc(gp_GetFirstArc(theGraph, v)))
+             numComponents++;
+     }
+
+     free(parent);
+
+     if ((numFaces = _Toroidal_CountFaces(theGraph, NULL)) < 0)
+         return NOTOK;
+
+     return 2*numComponents - numVertices + numEdges - numFaces <= 2 ? OK : NOTOK;
+}
+
+/****************************************************************************
+ gp_Toroidal_WriteFaces()
+
+ Writes the faces of the embedding in theGraph, such as the torus
+ embedding obtained by gp_Embed() with EMBEDFLAGS_TOROIDAL, to the named
+ file, or to stdout or stderr.  The first line gives the number of faces
+ as F=<number>, and each further line gives a face number followed by
+ the vertices visited by the boundary walk of the face, terminated by NIL
+ in the manner of the adjacency list format.
+
+ Returns OK on success, NOTOK on failure
+ ****************************************************************************/
+
+int  gp_Toroidal_WriteFaces(graphP theGraph, char *theFileName)
+{
+     FILE *outfile;
+     int numFaces;
+
+     if (theGraph == NULL || theFileName == NULL)
+         return NOTOK;
+
+     if ((numFaces = _Toroidal_CountFaces(theGraph, NULL)) < 0)
+         return NOTOK;
+
+     if (strcmp(theFileName, "stdout") == 0)
+          outfile = stdout;
+     else if (strcmp(theFileName, "stderr") == 0)
+          outfile = stderr;
+     else outfile = fopen(theFileName, WRITETEXT);
+
+     if (outfile == NULL)
+         return NOTOK;
+
+     fprintf(outfile, "F=%d\n", numFaces);
+     _Toroidal_CountFaces(theGraph, outfile);
+
+     if (strcmp(theFileName, "stdout") == 0 || strcmp(theFileName, "stderr") == 0)
+         fflush(outfile);
+
+     else if (fclose(outfile) != 0)
+         return NOTOK;
+
+     return OK;
+}
+
+/****************************************************************************
+ _Toroidal_CountFaces()
+
+ Traces the faces of the rotation system given by the adjacency lists of
+ theGraph.  Each face is traced by leaving each vertex on the arc that
+ follows, in the adjacency list of the vertex, the twin of the arc on
+ which the vertex was entered.  If outfile is not NULL, then the boundary
+ walk of each face is written to it.
+
+ Returns the number of faces, or -1 on failure
+ ****************************************************************************/
+
+int  _Toroidal_CountFaces(graphP theGraph, FILE *outfile)
+{
+     int zeroBasedOffset = (theGraph->internalFlags & FLAGS_ZEROBASEDIO) ? gp_GetFirstVertex(theGraph) : 0;
+     int v, e, eFace, numFaces = 0;
+
+     for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
+     {
+         e = gp_GetFirstArc(theGraph, v);
+         while (gp_IsArc(e))
+         {
+             gp_ClearEdgeVisited(theGraph, e);
+             e = gp_GetNextArc(theGraph, e);
+         }
+     }
+
+     for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
+     {
+         e = gp_GetFirstArc(theGraph, v);
+         while (gp_IsArc(e))
+         {
+             if (!gp_GetEdgeVisited(theGraph, e))
+             {
+                 numFaces++;
+                 if (outfile != NULL)
+                     fprintf(outfile, "%d:", numFaces);
+
+                 eFace = e;
+                 do {
+                     if (gp_IsVirtualVertex(theGraph, gp_GetNeighbor(theGraph, eFace)))
+                         return -1;
+
+                     gp_SetEdgeVisited(theGraph, eFace);
+                     if (outfile != NULL)
+                         fprintf(outfile, " %d", gp_GetNeighbor(theGraph, gp_GetTwinArc(theGraph, eFace)) - zeroBasedOffset);
+
+                     eFace = gp_GetNextArcCircular(theGraph, gp_GetTwinArc(theGraph, eFace));
+                 } while (eFace != e);
+
+                 if (outfile != NULL)
+                     fprintf(outfile, " %d\n", (theGraph->internalFlags & FLAGS_ZEROBASEDIO) ? -1 : NIL);
+             }
+
+             e = gp_GetNextArc(theGraph, e);
+         }
+     }
+
+     return numFaces;
+}
+
+/****************************************************************************
+ _Toroidal_CreateWorkspace()
+
+ Copies the given edges, omitting loops, into a new workspace, with a
+ search of the embedding cases of H for each of numThreads threads, or
+ for one thread per processor if numThreads is not positive.
+ ****************************************************************************/
+
+int  _Toroidal_CreateWorkspace(ToroidalWorkspace *ws, int N, int *edgeList, int numEdges, int numThreads)
+{
+     int Vsize, M = 0, i, t;
+
+     memset(ws, 0, sizeof(ToroidalWorkspace));
+
+     for (i = 0; i < numEdges; i++)
+         if (edgeList[2*i] != edgeList[2*i+1])
+             M++;
+
+     if ((ws->testGraph = gp_New()) == NULL ||
+         gp_EnsureArcCapacity(ws->testGraph, 2*(M + 1)) != OK ||
+         gp_InitGraph(ws->testGraph, N) != OK ||
+         _KuratowskiBridges_New(&ws->kb, ws->testGraph, edgeList, numEdges) != OK)
+     {
+         _Toroidal_FreeWorkspace(ws);
+         return NOTOK;
+     }
+
+     Vsize = gp_PrimaryVertexIndexBound(ws->testGraph);
+     ws->numThreads = _KuratowskiBridges_GetNumThreads(&ws->kb, numThreads);
+
+     if ((ws->rotation = (int *) malloc((2*M+1) * sizeof(int))) == NULL ||
+         (ws->rotationSize = (int *) malloc((Vsize+1) * sizeof(int))) == NULL ||
+         (ws->cornerStart = (int *) malloc((2*M+1) * sizeof(int))) == NULL ||
+         (ws->cornerLength = (int *) malloc((2*M+1) * sizeof(int))) == NULL ||
+         (ws->corners = (int *) malloc((2*M+1) * sizeof(int))) == NULL ||
+         (ws->cornerOfArc = (int *) malloc((2*M+1) * sizeof(int))) == NULL ||
+         (ws->searches = (ToroidalSearch *) calloc(ws->numThreads, sizeof(ToroidalSearch))) == NULL)
+     {
+         _Toroidal_FreeWorkspace(ws);
+         return NOTOK;
+     }
+
+     for (t = 0; t < ws->numThreads; t++)
+     {
+         if (_Toroidal_NewSearch(&ws->searches[t], &ws->kb, Vsize) != OK)
+         {
+             _Toroidal_FreeWorkspace(ws);
+             return NOTOK;
+         }
+     }
+
+     return OK;
+}
+
+/****************************************************************************
+ _Toroidal_FreeWorkspace()
+ ****************************************************************************/
+
+void _Toroidal_FreeWorkspace(ToroidalWorkspace *ws)
+{
+     int t;
+
+     if (ws->searches != NULL)
+     {
+         for (t = 0; t < ws->numThreads; t++)
+             _Toroidal_FreeSearch(&ws->searches[t]);
+         free(ws->searches);
+     }
+
+     if (ws->rotation != NULL) free(ws->rotation);
+     if (ws->rotationSize != NULL) free(ws->rotationSize);
+     if (ws->cornerStart != NULL) free(ws->cornerStart);
+     if (ws->cornerLength != NULL) free(ws->cornerLength);
+     if (ws->corners != NULL) free(ws->corners);
+     if (ws->cornerOfArc != NULL) free(ws->cornerOfArc);
+
+     _KuratowskiBridges_Free(&ws->kb);
+     gp_Free(&ws->testGraph);
+
+     memset(ws, 0, sizeof(ToroidalWorkspace));
+}
+
+/****************************************************************************
+ _Toroidal_NewSearch()
+
+ Allocates the arrays of a search of the embedding cases of H in the
+ graph of kb.  The placement and pattern arrays are allocated as they
+ are needed, since they grow during the search.
+
+ Returns OK on success, NOTOK on allocation failure, in which case the
+         arrays allocated are freed
+ ****************************************************************************/
+
+int  _Toroidal_NewSearch(ToroidalSearch *search, kuratowskiBridgesP kb, int Vsize)
+{
+     int M = kb->M, NB = Vsize + M, i;
+
+     memset(search, 0, sizeof(ToroidalSearch));
+     search->kb = kb;
+
+     if ((search->localIndex = (int *) malloc((Vsize+1) * sizeof(int))) == NULL ||
+         (search->localVertex = (int *) malloc((2*M+1) * sizeof(int))) == NULL ||
+         (search->faceVertices = (int *) malloc((2*M+1) * sizeof(int))) == NULL ||
+         (search->faceEdges = (int *) malloc((2*M+1) * sizeof(int))) == NULL ||
+         (search->occurrenceHead = (int *) malloc((5*Vsize+1) * sizeof(int))) == NULL ||
+         (search->occurrenceNext = (int *) malloc((2*M+1) * sizeof(int))) == NULL ||
+         (search->bridgePlacements = (int *) malloc((NB+1) * sizeof(int))) == NULL ||
+         (search->numAvailable = (int *) malloc((NB+1) * sizeof(int))) == NULL ||
+         (search->assigned = (int *) malloc((NB+1) * sizeof(int))) == NULL ||
+         (search->levelBridge = (int *) malloc((NB+1) * sizeof(int))) == NULL ||
+         (search->levelNext = (int *) malloc((NB+1) * sizeof(int))) == NULL ||
+         (search->levelTrail = (int *) malloc((NB+1) * sizeof(int))) == NULL ||
+         (search->stamp = (int *) calloc(Vsize+1, sizeof(int))) == NULL ||
+         (search->scratch = (int *) malloc((4*M+2) * sizeof(int))) == NULL)
+     {
+         _Toroidal_FreeSearch(search);
+         return NOTOK;
+     }
+
+     for (i = 0; i < 5*Vsize; i++)
+         search->occurrenceHead[i] = -1;
+
+     return OK;
+}
+
+/****************************************************************************
+ _Toroidal_FreeSearch()
+ ****************************************************************************/
+
+void _Toroidal_FreeSearch(ToroidalSearch *search)
+{
+     if (search->localIndex != NULL) free(search->localIndex);
+     if (search->localVertex != NULL) free(search->localVertex);
+     if (search->faceVertices != NULL) free(search->faceVertices);
+     if (search->faceEdges != NULL) free(search->faceEdges);
+     if (search->occurrenceHead != NULL) free(search->occurrenceHead);
+     if (search->occurrenceNext != NULL) free(search->occurrenceNext);
+     if (search->bridgePlacements != NULL) free(search->bridgePlacements);
+     if (search->numAvailable != NULL) free(search->numAvailable);
+     if (search->assigned != NULL) free(search->assigned);
+     if (search->levelBridge != NULL) free(search->levelBridge);
+     if (search->levelNext != NULL) free(search->levelNext);
+     if (search->levelTrail != NULL) free(search->levelTrail);
+     if (search->stamp != NULL) free(search->stamp);
+     if (search->scratch != NULL) free(search->scratch);
+
+     if (search->placementBridge != NULL) free(search->placementBridge);
+     if (search->placementFace != NULL) free(search->placementFace);
+     if (search->placementStart != NULL) free(search->placementStart);
+     if (search->placementAvailable != NULL) free(search->placementAvailable);
+     if (search->placementTested != NULL) free(search->placementTested);
+     if (search->trail != NULL) free(search->trail);
+     if (search->placementData != NULL) free(search->placementData);
+
+     if (search->memoTable != NULL) free(search->memoTable);
+     if (search->memoResult != NULL) free(search->memoResult);
+     if (search->memoData != NULL) free(search->memoData);
+
+     gp_Free(&search->bridgeGraph);
+
+     memset(search, 0, sizeof(ToroidalSearch));
+}
+
+/****************************************************************************
+ _Toroidal_Test()
+
+ Tests the edges in the workspace for an embedding in the torus.  A
+ planarity test either shows the graph is planar or isolates the subgraph
+ H, which is then extended.
+
+ Returns OK if the graph is toroidal, NONEMBEDDABLE if not, and
+         NOTOK on internal error
+ ****************************************************************************/
+
+int  _Toroidal_Test(ToroidalWorkspace *ws)
+{
+     kuratowskiBridgesP kb = &ws->kb;
+     int i, RetVal;
+
+     if (kb->M > 3*kb->N)
+         return NONEMBEDDABLE;
+
+     gp_ReinitializeGraph(ws->testGraph);
+     for (i = 0; i < kb->M; i++)
+     {
+         if (gp_AddEdge(ws->testGraph, kb->edges[2*i], 0, kb->edges[2*i+1], 0) != OK)
+             return NOTOK;
+     }
+
+     RetVal = gp_Embed(ws->testGraph, EMBEDFLAGS_PLANAR);
+     if (RetVal != NONEMBEDDABLE)
+         return RetVal;
+
+     if (_KuratowskiBridges_GetSubgraph(kb, ws->testGraph, TRUE) != OK)
+         return NOTOK;
+
+     return _Toroidal_ExtendSubgraph(ws, FALSE);
+}
+
+/****************************************************************************
+ _Toroidal_IsolateObstruction()
+
+ The edges in the workspace do not form a toroidal graph, so each edge in
+ turn is deleted if the remaining edges still do not form a toroidal
+ graph.  The edges that remain in the workspace form a minimal subgraph
+ that does not embed in the torus.
+
+ Deleting an edge that is not in H leaves H a subgraph of the graph, so
+ H is extended again without another planarity test.  This keeps most of
+ the bridges of H, so most placements are found in the stored results.
+
+ Returns OK on success, NOTOK on internal error
+ ****************************************************************************/
+
+int  _Toroidal_IsolateObstruction(ToroidalWorkspace *ws)
+{
+     kuratowskiBridgesP kb = &ws->kb;
+     int i, RetVal;
+
+     for (i = kb->M-1; i >= 0; i--)
+     {
+         if (_KuratowskiBridges_RemoveEdge(kb, i) && kb->M <= 3*kb->N)
+              RetVal = _Toroidal_ExtendSubgraph(ws, FALSE);
+         else RetVal = _Toroidal_Test(ws);
+         if (RetVal == NOTOK)
+             return NOTOK;
+
+         // If the edge is needed, then restore it to position i
+         if (RetVal == OK)
+             _KuratowskiBridges_RestoreEdge(kb, i);
+     }
+
+     return OK;
+}
+
+/****************************************************************************
+ _Toroidal_ExtendSubgraph()
+
+ Finds the branch vertices, paths and bridges of H, then tries each
+ embedding of H in the torus until the bridges can be placed in its
+ faces.  The embeddings are tried by the threads of the workspace, each
+ with its own search, and the first that extends stops the others.  If
+ buildEmbedding is TRUE, then the rotation system of the torus embedding
+ of the whole graph is built in the workspace from the search of the
+ thread that found it.
+
+ Returns OK if some embedding of H extends to the whole graph,
+         NONEMBEDDABLE if none does, and NOTOK on internal error
+ ****************************************************************************/
+
+int  _Toroidal_ExtendSubgraph(ToroidalWorkspace *ws, int buildEmbedding)
+{
+     kuratowskiBridgesP kb = &ws->kb;
+     int numEmbeddings, foundBy, b, t, RetVal;
+
+     if (_KuratowskiBridges_FindBridges(kb) != OK)
+         return NOTOK;
+
+     // The bridge graphs are kept nonempty even if H has no bridges
+     for (t = 0; t < ws->numThreads; t++)
+     {
+         if (_Toroidal_EnsureBridgeGraph(&ws->searches[t], kb->maxBridgeEdges > 1 ? kb->maxBridgeEdges : 1) != OK)
+             return NOTOK;
+     }
+
+     // A bridge with at most one attachment that is not planar is a second
+     // obstruction to planarity that shares at most one vertex with H
+     for (b = 0; b < kb->numBridges; b++)
+     {
+         if (kb->attachStart[b+1] - kb->attachStart[b] < 2 &&
+             (RetVal = _Toroidal_TestBridge(&ws->searches[0], b, NULL, 0)) != OK)
+             return RetVal;
+     }
+
+     numEmbeddings = kb->isK5 ? TOROIDAL_NUMK5EMBEDDINGS
+                              : TOROIDAL_NUMK33EMBEDDINGS;
+
+     RetVal = _KuratowskiBridges_ExploreCases(ws, numEmbeddings, ws->numThreads, _Toroidal_TryCase, &foundBy);
+
+     if (RetVal == OK && buildEmbedding)
+         return _Toroidal_BuildEmbedding(ws, &ws->searches[foundBy]);
+
+     return RetVal;
+}
+
+/****************************************************************************
+ _Toroidal_TryCase()
+
+ Tries to extend embedding k of H with the search of the given thread.
+
+ Returns OK if the bridges can be placed in the faces of the embedding,
+         NONEMBEDDABLE if not, and NOTOK on internal error
+ ****************************************************************************/
+
+int  _Toroidal_TryCase(void *context, int threadNumber, int k)
+{
+     ToroidalWorkspace *ws = (ToroidalWorkspace *) context;
+     ToroidalSearch *search = &ws->searches[threadNumber];
+     int RetVal;
+
+     if (ws->kb.isK5)
+          RetVal = _Toroidal_BuildFaces(search, &Toroidal_K5Rotations[k][0][0], 5, 4);
+     else RetVal = _Toroidal_BuildFaces(search, &Toroidal_K33Rotations[k][0][0], 6, 3);
+
+     if (RetVal != OK)
+         return NOTOK;
+
+     if ((RetVal = _Toroidal_FindPlacements(search)) != OK)
+         return RetVal;
+
+     return _Toroidal_PlaceBridges(search);
+}
+
+/****************************************************************************
+ _Toroidal_BuildFaces()
+
+ Traces the faces of the embedding of H given by the rotation system of
+ the branch vertex labels, replacing each pair of consecutive branch
+ vertices with the path of H that joins them.  Each position of each face
+ records its vertex and the edge to the next position, and the positions
+ of each vertex in each face are linked into its occurrence list.
+
+ Returns OK on success, NOTOK if the rotation system is not a torus
+         embedding
+ ****************************************************************************/
+
+int  _Toroidal_BuildFaces(ToroidalSearch *search, int *rotations, int numBranch, int degree)
+{
+     kuratowskiBridgesP kb = search->kb;
+     int Vsize = kb->firstVertex + kb->N;
+     int visited[6][4];
+     int f, g, i, j, a, k, c, p, v, size = 0, length;
+
+     // Clear the occurrence lists of the faces of the prior embedding
+     for (f = 0; f < search->numFaces; f++)
+         for (g = search->faceStart[f]; g < search->faceStart[f] + search->faceLength[f]; g++)
+             search->occurrenceHead[f*Vsize + search->faceVertices[g]] = -1;
+
+     for (a = 0; a < numBranch; a++)
+         for (k = 0; k < degree; k++)
+             visited[a][k] = 0;
+
+     search->numFaces = 0;
+     for (a = 0; a < numBranch; a++)
+     {
+         for (k = 0; k < degree; k++)
+         {
+             if (visited[a][k])
+                 continue;
+
+             if ((f = search->numFaces++) == 5)
+                 return NOTOK;
+             search->faceStart[f] = size;
+
+             // Leave each branch vertex on the arc that follows the arc
+             // on which the branch vertex was entered
+             i = a;
+             j = k;
+             do {
+                 visited[i][j] = 1;
+                 c = rotations[i*degree + j];
+                 p = kb->pathIndex[i][c];
+                 length = kb->pathLength[p];
+
+                 // Add the path from branch vertex i, omitting branch vertex c
+                 for (g = 0; g < length-1; g++)
+                 {
+                     if (kb->pathVertices[kb->pathStart[p]] == kb->branch[i])
+                     {
+                         v = kb->pathVertices[kb->pathStart[p] + g];
+                         search->faceEdges[size] = kb->pathEdges[kb->pathStart[p] + g];
+                     }
+                     else
+                     {
+                         v = kb->pathVertices[kb->pathStart[p] + length-1 - g];
+                         search->faceEdges[size] = kb->pathEdges[kb->pathStart[p] + length-2 - g];
+                     }
+
+                     search->faceVertices[size] = v;
+                     search->occurrenceNext[size] = search->occurrenceHead[f*Vsize + v];
+                     search->occurrenceHead[f*Vsize + v] = size;
+                     size++;
+                 }
+
+                 for (j = 0; rotations[c*degree + j] != i; j++)
+                     ;
+                 j = (j+1) % degree;
+                 i = c;
+             } while (i != a || j != k);
+
+             search->faceLength[f] = size - search->faceStart[f];
+         }
+     }
+
+     return search->numFaces == (kb->isK5 ? 5 : 3) ? OK : NOTOK;
+}
+
+/****************************************************************************
+ _Toroidal_FindPlacements()
+
+ Finds the placements of each bridge with at least two attachments in the
+ faces of the embedding of H.  In each face that has all the attachments
+ of the bridge, each combination of a position for each end of the bridge
+ is a candidate placement.
+
+ Returns OK on success, NONEMBEDDABLE if a bridge has no placements, and
+         NOTOK on internal error
+ ****************************************************************************/
+
+int  _Toroidal_FindPlacements(ToroidalSearch *search)
+{
+     kuratowskiBridgesP kb = search->kb;
+     int Vsize = kb->firstVertex + kb->N;
+     int *choice = search->scratch;
+     int b, f, j, k;
+
+     search->numPlacements = 0;
+     search->placementDataSize = 0;
+
+     // Before testing any placements, check that every bridge has a face
+     // containing all of its attachments
+     for (b = 0; b < kb->numBridges; b++)
+     {
+         if (kb->attachStart[b+1] - kb->attachStart[b] < 2)
+             continue;
+
+         for (f = 0; f < search->numFaces; f++)
+             if (_Toroidal_FaceHasAttachments(search, b, f))
+                 break;
+
+         if (f == search->numFaces)
+             return NONEMBEDDABLE;
+     }
+
+     for (b = 0; b < kb->numBridges; b++)
+     {
+         search->bridgePlacements[b] = search->numPlacements;
+
+         if (kb->attachStart[b+1] - kb->attachStart[b] < 2)
+             continue;
+
+         k = kb->endStart[b+1] - kb->endStart[b];
+         for (f = 0; f < search->numFaces; f++)
+         {
+             if (!_Toroidal_FaceHasAttachments(search, b, f))
+                 continue;
+
+             // Step through the combinations like an odometer
+             for (j = 0; j < k; j++)
+                 choice[j] = search->occurrenceHead[f*Vsize + kb->endVertex[kb->endStart[b]+j]];
+
+             for (;;)
+             {
+                 if (_Toroidal_AddPlacement(search, b, f, choice) != OK)
+                     return NOTOK;
+
+                 for (j = 0; j < k; j++)
+                 {
+                     if ((choice[j] = search->occurrenceNext[choice[j]]) >= 0)
+                         break;
+                     choice[j] = search->occurrenceHead[f*Vsize + kb->endVertex[kb->endStart[b]+j]];
+                 }
+                 if (j == k)
+                     break;
+             }
+         }
+
+         if (search->numPlacements == search->bridgePlacements[b])
+             return NONEMBEDDABLE;
+     }
+
+     search->bridgePlacements[kb->numBridges] = search->numPlacements;
+     return OK;
+}
+
+/****************************************************************************
+ _Toroidal_FaceHasAttachments()
+
+ Returns TRUE if every attachment of bridge b occurs in face f, else FALSE
+ ****************************************************************************/
+
+int  _Toroidal_FaceHasAttachments(ToroidalSearch *search, int b, int f)
+{
+     kuratowskiBridgesP kb = search->kb;
+     int Vsize = kb->firstVertex + kb->N;
+     int i;
+
+     for (i = kb->attachStart[b]; i < kb->attachStart[b+1]; i++)
+     {
+         if (search->occurrenceHead[f*Vsize + kb->attachments[i]] < 0)
+             return FALSE;
+     }
+
+     return TRUE;
+}
+
+/****************************************************************************
+ _Toroidal_AddPlacement()
+
+ Adds the placement of bridge b in face f with the ends at the given
+ positions.  A bridge that is a single edge, or that has one vertex not in
+ H and so has an edge to each of its ends, is always planar together with
+ the face boundary.  The planarity of any other bridge together with the
+ face boundary is tested by _Toroidal_TestPlacement() when the search
+ first tries the placement, since most placements are removed by the
+ search before then.
+
+ Returns OK on success, NOTOK on internal error
+ ****************************************************************************/
+
+int  _Toroidal_AddPlacement(ToroidalSearch *search, int b, int f, int *choice)
+{
+     kuratowskiBridgesP kb = search->kb;
+     int k = kb->endStart[b+1] - kb->endStart[b];
+     int numEdges = kb->edgeStart[b+1] - kb->edgeStart[b];
+     int i, j, numPoints, *data, *points;
+
+     if (_Toroidal_EnsurePlacementCapacity(search, 2*k + 1) != OK)
+         return NOTOK;
+
+     search->placementBridge[search->numPlacements] = b;
+     search->placementFace[search->numPlacements] = f;
+     search->placementStart[search->numPlacements] = search->placementDataSize;
+     search->placementTested[search->numPlacements] = numEdges == 1 || numEdges == k;
+
+     data = search->placementData + search->placementDataSize;
+     points = data + k + 1;
+     for (j = 0; j < k; j++)
+         data[j] = choice[j] - search->faceStart[f];
+
+     // Insert each position into the ascending distinct positions
+     for (i = numPoints = 0; i < k; i++)
+     {
+         for (j = numPoints; j > 0 && points[j-1] > data[i]; j--)
+             ;
+         if (j > 0 && points[j-1] == data[i])
+             continue;
+
+         memmove(points + j + 1, points + j, (numPoints - j) * sizeof(int));
+         points[j] = data[i];
+         numPoints++;
+     }
+     data[k] = numPoints;
+
+     search->placementDataSize += k + 1 + numPoints;
+     search->numPlacements++;
+
+     return OK;
+}
+
+/****************************************************************************
+ _Toroidal_TestPlacement()
+
+ Tests whether the bridge of placement p is planar together with the
+ boundary of the face of the placement.
+
+ The test only depends on the pattern in which the ends meet the distinct
+ positions, which is given by the rank of the position of each end among
+ the distinct positions.  Rotating or reflecting the face boundary does
+ not change the result, so the pattern is normalized to the least of its
+ rotations and reflections.  The result of each test is kept for reuse,
+ keyed by the pattern and the edges of the bridge, with each end replaced
+ by its rank, so the results stay valid when the search is repeated for
+ another embedding or subgraph H, or after edges are deleted.
+
+ Returns OK if planar, NONEMBEDDABLE if not, NOTOK on internal error
+ ****************************************************************************/
+
+int  _Toroidal_TestPlacement(ToroidalSearch *search, int p)
+{
+     kuratowskiBridgesP kb = search->kb;
+     int b = search->placementBridge[p];
+     int k = kb->endStart[b+1] - kb->endStart[b];
+     int *pos = search->placementData + search->placementStart[p];
+     int numPoints = pos[k], *points = pos + k + 1;
+     int *ranks = search->scratch, *key = search->scratch + 2*kb->M;
+     int i, j, s, d, x, lo, hi, better, r, keyLength, RetVal;
+
+     for (j = 0; j < k; j++)
+     {
+         lo = 0;
+         hi = numPoints-1;
+         while (points[(lo+hi)/2] != pos[j])
+         {
+             if (points[(lo+hi)/2] < pos[j])
+                  lo = (lo+hi)/2 + 1;
+             else hi = (lo+hi)/2 - 1;
+         }
+         ranks[j] = key[j] = (lo+hi)/2;
+     }
+
+     // Normalize the pattern to the least of its rotations and reflections
+     for (s = 0; s < numPoints; s++)
+     {
+         for (d = 0; d < 2; d++)
+         {
+             better = FALSE;
+             for (j = 0; j < k; j++)
+             {
+                 r = d == 0 ? (ranks[j] - s + numPoints) % numPoints
+                            : (s - ranks[j] + numPoints) % numPoints;
+                 if (!better && r != key[j])
+                 {
+                     if (r > key[j])
+                         break;
+                     better = TRUE;
+                 }
+                 if (better)
+                     key[j] = r;
+             }
+         }
+     }
+
+     for (j = 0; j < k; j++)
+         ranks[j] = key[j];
+
+     key[0] = numPoints;
+     keyLength = 1;
+     for (i = kb->edgeStart[b], j = 0; i < kb->edgeStart[b+1]; i++)
+     {
+         for (d = 0; d < 2; d++)
+         {
+             x = kb->edges[2*kb->bridgeEdges[i]+d];
+             key[keyLength++] = kb->hDegree[x] > 0 ? -1 - ranks[j++] : x;
+         }
+     }
+
+     if (_Toroidal_LookupPattern(search, key, keyLength, &RetVal) != OK)
+     {
+         if ((RetVal = _Toroidal_TestBridge(search, b, ranks, numPoints)) == NOTOK ||
+             _Toroidal_StorePattern(search, key, keyLength, RetVal) != OK)
+             return NOTOK;
+     }
+
+     return RetVal;
+}
+
+/****************************************************************************
+ _Toroidal_HashPattern()
+ ****************************************************************************/
+
+int  _Toroidal_HashPattern(int *key, int keyLength)
+{
+     unsigned int h = 2166136261u;
+     int i;
+
+     for (i = 0; i < keyLength; i++)
+         h = (h ^ (unsigned int) key[i]) * 16777619u;
+
+     return (int) (h & 0x7FFFFFFF);
+}
+
+/****************************************************************************
+ _Toroidal_LookupPattern()
+
+ Returns OK and the stored result of the test of the pattern if there is
+         one, NOTOK otherwise
+ ****************************************************************************/
+
+int  _Toroidal_LookupPattern(ToroidalSearch *search, int *key, int keyLength, int *pResult)
+{
+     int slot, i, *stored;
+
+     if (search->memoCapacity == 0)
+         return NOTOK;
+
+     slot = _Toroidal_HashPattern(key, keyLength) & (search->memoCapacity-1);
+     while (search->memoTable[slot] >= 0)
+     {
+         stored = search->memoData + search->memoTable[slot];
+         for (i = 0; i < keyLength && stored[i] == key[i]; i++)
+             ;
+         if (i == keyLength && stored[-1] == keyLength)
+         {
+             *pResult = search->memoResult[slot];
+             return OK;
+         }
+         slot = (slot + 1) & (search->memoCapacity-1);
+     }
+
+     return NOTOK;
+}
+
+/****************************************************************************
+ _Toroidal_StorePattern()
+
+ Stores the result of the test of a pattern that is not yet stored,
+ doubling the hash table when it becomes half full.
+
+ Returns OK on success, NOTOK on allocation failure
+ ****************************************************************************/
+
+int  _Toroidal_StorePattern(ToroidalSearch *search, int *key, int keyLength, int result)
+{
+     int *newTable, *newResult, *newData, newCapacity, slot, i;
+
+     if (2*(search->memoSize+1) > search->memoCapacity)
+     {
+         newCapacity = search->memoCapacity == 0 ? 256 : 2*search->memoCapacity;
+         newTable = (int *) malloc(newCapacity * sizeof(int));
+         newResult = (int *) malloc(newCapacity * sizeof(int));
+         if (newTable == NULL || newResult == NULL)
+         {
+             free(newTable);
+             free(newResult);
+             return NOTOK;
+         }
+
+         for (slot = 0; slot < newCapacity; slot++)
+             newTable[slot] = -1;
+
+         // Each stored key is preceded by its length
+         for (i = 0; i < search->memoCapacity; i++)
+         {
+             if (search->memoTable[i] < 0)
+                 continue;
+             slot = _Toroidal_HashPattern(search->memoData + search->memoTable[i],
+                                          search->memoData[search->memoTable[i]-1]) & (newCapacity-1);
+             while (newTable[slot] >= 0)
+                 slot = (slot + 1) & (newCapacity-1);
+             newTable[slot] = search->memoTable[i];
+             newResult[slot] = search->memoResult[i];
+         }
+
+         free(search->memoTable);
+         free(search->memoResult);
+         search->memoTable = newTable;
+         search->memoResult = newResult;
+         search->memoCapacity = newCapacity;
+     }
+
+     if (search->memoDataSize + keyLength + 1 > search->memoDataCapacity)
+     {
+         newCapacity = 2*(search->memoDataCapacity + keyLength + 1);
+         if ((newData = (int *) realloc(search->memoData, newCapacity * sizeof(int))) == NULL)
+             return NOTOK;
+         search->memoData = newData;
+         search->memoDataCapacity = newCapacity;
+     }
+
+     search->memoData[search->memoDataSize++] = keyLength;
+     for (i = 0; i < keyLength; i++)
+         search->memoData[search->memoDataSize + i] = key[i];
+
+     slot = _Toroidal_HashPattern(key, keyLength) & (search->memoCapacity-1);
+     while (search->memoTable[slot] >= 0)
+         slot = (slot + 1) & (search->memoCapacity-1);
+     search->memoTable[slot] = search->memoDataSize;
+     search->memoResult[slot] = result;
+
+     search->memoDataSize += keyLength;
+     search->memoSize++;
+     return OK;
+}
+
+/****************************************************************************
+ _Toroidal_EnsurePlacementCapacity()
+
+ Ensures there is room for one more placement with the given data length.
+
+ Returns OK on success, NOTOK on allocation failure
+ ****************************************************************************/
+
+int  _Toroidal_EnsurePlacementCapacity(ToroidalSearch *search, int dataLength)
+{
+     int newCapacity, *p;
+
+     if (search->numPlacements == search->placementCapacity)
+     {
+         newCapacity = search->placementCapacity == 0 ? 64 : 2*search->placementCapacity;
+
+         if ((p = (int *) realloc(search->placementBridge, newCapacity * sizeof(int))) == NULL)
+             return NOTOK;
+         search->placementBridge = p;
+         if ((p = (int *) realloc(search->placementFace, newCapacity * sizeof(int))) == NULL)
+             return NOTOK;
+         search->placementFace = p;
+         if ((p = (int *) realloc(search->placementStart, newCapacity * sizeof(int))) == NULL)
+             return NOTOK;
+         search->placementStart = p;
+         if ((p = (int *) realloc(search->placementAvailable, newCapacity * sizeof(int))) == NULL)
+             return NOTOK;
+         search->placementAvailable = p;
+         if ((p = (int *) realloc(search->placementTested, newCapacity * sizeof(int))) == NULL)
+             return NOTOK;
+         search->placementTested = p;
+         if ((p = (int *) realloc(search->trail, newCapacity * sizeof(int))) == NULL)
+             return NOTOK;
+         search->trail = p;
+
+         search->placementCapacity = newCapacity;
+     }
+
+     if (search->placementDataSize + dataLength > search->placementDataCapacity)
+     {
+         newCapacity = 2*(search->placementDataCapacity + dataLength);
+         if ((p = (int *) realloc(search->placementData, newCapacity * sizeof(int))) == NULL)
+             return NOTOK;
+         search->placementData = p;
+         search->placementDataCapacity = newCapacity;
+     }
+
+     return OK;
+}
+
+/****************************************************************************
+ _Toroidal_TestBridge()
+
+ Tests the planarity of bridge b together with a cycle through the
+ distinct positions of its ends on a face boundary.  The ends of the
+ bridge are mapped to the vertices of the cycle by their ranks, and the
+ cycle is just an edge if there are two distinct positions.  If ranks is
+ NULL, then the bridge is tested by itself.
+
+ The test is run in the bridge graph, which is much smaller than the
+ graph being tested.  The cycle vertices come first, followed by the
+ other vertices of the bridge, and localVertex records the vertex of the
+ graph being tested that each of the latter represents.
+
+ Returns OK if planar, NONEMBEDDABLE if not, NOTOK on internal error
+ ****************************************************************************/
+
+int  _Toroidal_TestBridge(ToroidalSearch *search, int b, int *ranks, int numPoints)
+{
+     kuratowskiBridgesP kb = search->kb;
+     graphP bridgeGraph = search->bridgeGraph;
+     int first = gp_GetFirstVertex(bridgeGraph);
+     int i, j, e, x, endpoint[2], numEnds = 0;
+     int numVertices = ranks == NULL ? 0 : numPoints;
+
+     gp_ReinitializeGraph(bridgeGraph);
+
+     search->stampValue++;
+     for (i = kb->edgeStart[b]; i < kb->edgeStart[b+1]; i++)
+     {
+         e = kb->bridgeEdges[i];
+         for (j = 0; j < 2; j++)
+         {
+             x = kb->edges[2*e+j];
+             if (ranks != NULL && kb->hDegree[x] > 0)
+                 endpoint[j] = first + ranks[numEnds++];
+             else
+             {
+                 if (search->stamp[x] != search->stampValue)
+                 {
+                     search->stamp[x] = search->stampValue;
+                     search->localIndex[x] = first + numVertices;
+                     search->localVertex[numVertices++] = x;
+                 }
+                 endpoint[j] = search->localIndex[x];
+             }
+         }
+
+         if (gp_AddEdge(bridgeGraph, endpoint[0], 0, endpoint[1], 0) != OK)
+             return NOTOK;
+     }
+
+     if (ranks != NULL)
+     {
+         for (i = 0; i < (numPoints == 2 ? 1 : numPoints); i++)
+         {
+             if (gp_AddEdge(bridgeGraph, first + i, 0, first + (i+1) % numPoints, 0) != OK)
+                 return NOTOK;
+         }
+     }
+
+     return gp_Embed(bridgeGraph, EMBEDFLAGS_PLANAR);
+}
+
+/****************************************************************************
+ _Toroidal_EnsureBridgeGraph()
+
+ Ensures the bridge graph of the search can hold a bridge with the given
+ number of edges together with a cycle through the positions of its ends.  Each
+ edge has at most two vertices that are ends or vertices not in H, and
+ the cycle has at most one vertex and one edge for each end.
+
+ Returns OK on success, NOTOK on allocation failure
+ ****************************************************************************/
+
+int  _Toroidal_EnsureBridgeGraph(ToroidalSearch *search, int numEdges)
+{
+     if (search->bridgeGraph != NULL && search->bridgeGraph->N >= 2*numEdges)
+         return OK;
+
+     gp_Free(&search->bridgeGraph);
+     if ((search->bridgeGraph = gp_New()) == NULL)
+         return NOTOK;
+
+     if (gp_EnsureArcCapacity(search->bridgeGraph, 6*numEdges) != OK ||
+         gp_InitGraph(search->bridgeGraph, 2*numEdges) != OK)
+     {
+         gp_Free(&search->bridgeGraph);
+         return NOTOK;
+     }
+
+     return OK;
+}
+
+/****************************************************************************
+ _Toroidal_PlaceBridges()
+
+ Searches for an assignment of a placement to each bridge with at least
+ two attachments, such that no two bridges placed in the same face
+ overlap.  Since every face is a disk, the bridges placed in a face can be
+ embedded together if and only if they pairwise do not overlap, where the
+ positions of their ends are taken as distinct points on the boundary of
+ the disk.
+
+ The search is a backtracking search that always branches on a bridge
+ with the fewest available placements, and that removes each placement of
+ an unassigned bridge that would overlap a bridge just placed in the same
+ face.  A placement is tested for planarity when it is first tried, and
+ if the test fails, then it is removed for the rest of the search.
+
+ Returns OK if the bridges can be placed, NONEMBEDDABLE if not, and
+         NOTOK on internal error
+ ****************************************************************************/
+
+int  _Toroidal_PlaceBridges(ToroidalSearch *search)
+{
+     kuratowskiBridgesP kb = search->kb;
+     int b, p, level, best, RetVal;
+
+     for (b = 0; b < kb->numBridges; b++)
+     {
+         search->numAvailable[b] = search->bridgePlacements[b+1] - search->bridgePlacements[b];
+         search->assigned[b] = kb->attachStart[b+1] - kb->attachStart[b] < 2 ? -2 : -1;
+     }
+
+     for (p = 0; p < search->numPlacements; p++)
+         search->placementAvailable[p] = 1;
+
+     search->trailSize = 0;
+     level = 0;
+     for (;;)
+     {
+         // Choose the unassigned bridge with the fewest available placements
+         best = -1;
+         for (b = 0; b < kb->numBridges; b++)
+         {
+             if (search->assigned[b] == -1 &&
+                 (best < 0 || search->numAvailable[b] < search->numAvailable[best]))
+                 best = b;
+         }
+
+         if (best < 0)
+             return OK;
+
+         search->levelBridge[level] = best;
+         search->levelNext[level] = search->bridgePlacements[best];
+         search->levelTrail[level] = search->trailSize;
+
+         // Try the untried placements of the bridge at the current level,
+         // backtracking to prior levels when they are exhausted
+         for (;;)
+         {
+             b = search->levelBridge[level];
+             for (p = search->levelNext[level]; p < search->bridgePlacements[b+1]; p++)
+                 if (search->placementAvailable[p])
+                     break;
+
+             if (p == search->bridgePlacements[b+1])
+             {
+                 search->assigned[b] = -1;
+                 if (--level < 0)
+                     return NONEMBEDDABLE;
+                 _Toroidal_UndoTrail(search, search->levelTrail[level]);
+                 continue;
+             }
+
+             search->levelNext[level] = p+1;
+
+             if (!search->placementTested[p])
+             {
+                 if ((RetVal = _Toroidal_TestPlacement(search, p)) == NOTOK)
+                     return NOTOK;
+
+                 search->placementTested[p] = TRUE;
+                 if (RetVal != OK)
+                 {
+                     search->placementAvailable[p] = 0;
+                     search->numAvailable[b]--;
+                     continue;
+                 }
+             }
+
+             if (_Toroidal_AssignBridge(search, b, p) == OK)
+                 break;
+
+             _Toroidal_UndoTrail(search, search->levelTrail[level]);
+         }
+
+         level++;
+     }
+
+     return NOTOK;
+}
+
+/****************************************************************************
+ _Toroidal_AssignBridge()
+
+ Assigns placement p to bridge b, and removes each available placement
+ of an unassigned bridge that overlaps p in the same face, recording the
+ removals in the trail.
+
+ Returns OK if every unassigned bridge still has an available placement,
+         NONEMBEDDABLE otherwise
+ ****************************************************************************/
+
+int  _Toroidal_AssignBridge(ToroidalSearch *search, int b, int p)
+{
+     kuratowskiBridgesP kb = search->kb;
+     int b2, q;
+
+     search->assigned[b] = p;
+
+     for (b2 = 0; b2 < kb->numBridges; b2++)
+     {
+         if (search->assigned[b2] != -1)
+             continue;
+
+         for (q = search->bridgePlacements[b2]; q < search->bridgePlacements[b2+1]; q++)
+         {
+             if (!search->placementAvailable[q] || search->placementFace[q] != search->placementFace[p])
+                 continue;
+
+             if (_Toroidal_Overlap(search, p, q))
+             {
+                 search->placementAvailable[q] = 0;
+                 search->trail[search->trailSize++] = q;
+
+                 if (--search->numAvailable[b2] == 0)
+                     return NONEMBEDDABLE;
+             }
+         }
+     }
+
+     return OK;
+}
+
+/****************************************************************************
+ _Toroidal_UndoTrail()
+
+ Restores the placements removed since the trail had the given size.
+ ****************************************************************************/
+
+void _Toroidal_UndoTrail(ToroidalSearch *search, int trailSize)
+{
+     int q;
+
+     while (search->trailSize > trailSize)
+     {
+         q = search->trail[--search->trailSize];
+         search->placementAvailable[q] = 1;
+         search->numAvailable[search->placementBridge[q]]++;
+     }
+}
+
+/****************************************************************************
+ _Toroidal_Overlap()
+
+ Two bridges in a disk avoid each other if and only if the boundary
+ points of one bridge all lie in a single segment of the boundary between
+ two consecutive boundary points of the other bridge.  This tests the
+ positions of placement p2 against the segments determined by the
+ positions of placement p1, which are in the same face.
+
+ Returns TRUE if the placements overlap, FALSE otherwise
+ ****************************************************************************/
+
+int  _Toroidal_Overlap(ToroidalSearch *search, int p1, int p2)
+{
+     kuratowskiBridgesP kb = search->kb;
+     int k1 = kb->endStart[search->placementBridge[p1]+1] - kb->endStart[search->placementBridge[p1]];
+     int k2 = kb->endStart[search->placementBridge[p2]+1] - kb->endStart[search->placementBridge[p2]];
+     int *p = search->placementData + search->placementStart[p1] + k1 + 1;
+     int *q = search->placementData + search->placementStart[p2] + k2 + 1;
+     int k = p[-1], numQ = q[-1];
+     int i, lo, hi, seg1 = -2, seg2 = -2, s1, s2;
+
+     // Segment i is from p[i] to p[i+1], or from p[k-1] around to p[0].
+     // The candidate segments for p2 are seg1 and seg2, where -2 means
+     // any segment and -1 means none
+     for (i = 0; i < numQ; i++)
+     {
+         // Find the least lo such that q[i] <= p[lo], or k if there is none
+         lo = 0;
+         hi = k;
+         while (lo < hi)
+         {
+             if (p[(lo+hi)/2] < q[i])
+                  lo = (lo+hi)/2 + 1;
+             else hi = (lo+hi)/2;
+         }
+
+         // A position of p1 is in the two segments that it ends
+         if (lo < k && p[lo] == q[i])
+         {
+             s1 = (lo + k - 1) % k;
+             s2 = lo;
+         }
+         else s1 = s2 = (lo + k - 1) % k;
+
+         if (seg1 == -2)
+         {
+             seg1 = s1;
+             seg2 = s2;
+         }
+         else
+         {
+             if (seg1 != s1 && seg1 != s2)
+                 seg1 = -1;
+             if (seg2 != s1 && seg2 != s2)
+                 seg2 = -1;
+             if (seg1 == -1 && seg2 == -1)
+                 return TRUE;
+         }
+     }
+
+     return FALSE;
+}
+
+/****************************************************************************
+ _Toroidal_BuildEmbedding()
+
+ Builds the rotation system of a torus embedding of the workspace graph
+ from the embedding of H and the placements assigned to the bridges.
+ The rotation of each vertex lists the indices of its edges, in the order
+ in which they are to appear in its adjacency list.
+
+ The bridges with at most one attachment are embedded by themselves, and
+ at its attachment, the edges of each such bridge are kept together so
+ that the bridge sits in a single corner of a face.  The bridges placed
+ in each face are embedded together in a disk bounded by the face, which
+ gives the rotations of their other vertices and the sequence of edges
+ in each corner of the face.  The rotation of each vertex of H is then
+ assembled by walking around it through its edges in H and its corners.
+
+ Returns OK on success, NOTOK on internal error
+ ****************************************************************************/
+
+int  _Toroidal_BuildEmbedding(ToroidalWorkspace *ws, ToroidalSearch *search)
+{
+     kuratowskiBridgesP kb = search->kb;
+     int Vsize = kb->firstVertex + kb->N;
+     int numPositions = 2*kb->numHEdges;
+     int v, b, f, g, i, j, e, e0, side, numCorners = 0, maxLength = 0;
+     int *diskEdges;
+     graphP diskGraph;
+
+     for (v = 0; v < Vsize; v++)
+         ws->rotationSize[v] = 0;
+     for (g = 0; g < numPositions; g++)
+         ws->cornerLength[g] = 0;
+     for (e = 0; e < 2*kb->M; e++)
+         ws->cornerOfArc[e] = -1;
+
+     for (b = 0; b < kb->numBridges; b++)
+     {
+         if (search->assigned[b] == -2 && _Toroidal_EmbedBridge(ws, search, b) != OK)
+             return NOTOK;
+     }
+
+     // The disk graph of a face has a boundary vertex for each position
+     // and a vertex subdividing each boundary edge, a hub adjacent to all
+     // of them, and the vertices and edges of the bridges in the face
+     for (f = 0; f < search->numFaces; f++)
+         if (search->faceLength[f] > maxLength)
+             maxLength = search->faceLength[f];
+
+     if ((diskGraph = gp_New()) == NULL)
+         return NOTOK;
+
+     if (gp_EnsureArcCapacity(diskGraph, 2*(4*maxLength + kb->M)) != OK ||
+         gp_InitGraph(diskGraph, kb->N + 2*maxLength + 1) != OK ||
+         (diskEdges = (int *) malloc((4*maxLength + kb->M) * sizeof(int))) == NULL)
+     {
+         gp_Free(&diskGraph);
+         return NOTOK;
+     }
+
+     for (f = 0; f < search->numFaces; f++)
+     {
+         if (_Toroidal_EmbedFace(ws, search, diskGraph, diskEdges, f, &numCorners) != OK)
+             break;
+     }
+
+     free(diskEdges);
+     gp_Free(&diskGraph);
+     if (f < search->numFaces)
+         return NOTOK;
+
+     // The corner at each position follows the edge from the prior position
+     for (f = 0; f < search->numFaces; f++)
+     {
+         for (i = 0; i < search->faceLength[f]; i++)
+         {
+             g = search->faceStart[f] + i;
+             e = search->faceEdges[search->faceStart[f] + (i + search->faceLength[f] - 1) % search->faceLength[f]];
+             side = kb->edges[2*e] == search->faceVertices[g] ? 0 : 1;
+             ws->cornerOfArc[2*e + side] = g;
+         }
+     }
+
+     // Walk around each vertex of H, starting from one of its edges in H
+     for (v = kb->firstVertex; v < Vsize; v++)
+     {
+         if (kb->hDegree[v] == 0)
+             continue;
+
+         for (j = kb->adjStart[v]; kb->edgeBridge[kb->adjEdge[j]] != -1; j++)
+             ;
+
+         e = e0 = kb->adjEdge[j];
+         do {
+             g = ws->cornerOfArc[2*e + (kb->edges[2*e] == v ? 0 : 1)];
+             if (g < 0 || ws->rotationSize[v] + 1 + ws->cornerLength[g] > kb->adjStart[v+1] - kb->adjStart[v])
+                 return NOTOK;
+
+             ws->rotation[kb->adjStart[v] + ws->rotationSize[v]++] = e;
+             for (i = 0; i < ws->cornerLength[g]; i++)
+                 ws->rotation[kb->adjStart[v] + ws->rotationSize[v]++] = ws->corners[ws->cornerStart[g] + i];
+
+             e = search->faceEdges[g];
+         } while (e != e0);
+     }
+
+     // Every edge must appear in the rotations of both of its endpoints
+     for (v = kb->firstVertex; v < Vsize; v++)
+     {
+         if (ws->rotationSize[v] != kb->adjStart[v+1] - kb->adjStart[v])
+             return NOTOK;
+     }
+
+     return OK;
+}
+
+/****************************************************************************
+ _Toroidal_EmbedBridge()
+
+ Embeds a bridge with at most one attachment by itself, and appends the
+ rotation of each of its vertices, including its attachment, to the
+ rotation system.
+
+ Returns OK on success, NOTOK on internal error
+ ****************************************************************************/
+
+int  _Toroidal_EmbedBridge(ToroidalWorkspace *ws, ToroidalSearch *search, int b)
+{
+     kuratowskiBridgesP kb = search->kb;
+     graphP bridgeGraph = search->bridgeGraph;
+     int i, j, e, u, w, v;
+
+     if (_Toroidal_TestBridge(search, b, NULL, 0) != OK ||
+         gp_SortVertices(bridgeGraph) != OK)
+         return NOTOK;
+
+     search->stampValue++;
+     for (i = kb->edgeStart[b]; i < kb->edgeStart[b+1]; i++)
+     {
+         for (j = 0; j < 2; j++)
+         {
+             v = kb->edges[2*kb->bridgeEdges[i]+j];
+             if (search->stamp[v] == search->stampValue)
+                 continue;
+             search->stamp[v] = search->stampValue;
+
+             e = gp_GetFirstArc(bridgeGraph, search->localIndex[v]);
+             while (gp_IsArc(e))
+             {
+                 // Find the bridge edge that the arc represents
+                 w = search->localVertex[gp_GetNeighbor(bridgeGraph, e) - gp_GetFirstVertex(bridgeGraph)];
+                 u = _Toroidal_GetDiskEdge(bridgeGraph, e, kb->bridgeEdges + kb->edgeStart[b]);
+                 if (u < 0 || (kb->edges[2*u] != w && kb->edges[2*u+1] != w))
+                     return NOTOK;
+
+                 ws->rotation[kb->adjStart[v] + ws->rotationSize[v]++] = u;
+                 e = gp_GetNextArc(bridgeGraph, e);
+             }
+         }
+     }
+
+     return OK;
+}
+
+/****************************************************************************
+ _Toroidal_GetDiskEdge()
+
+ The edges added to a graph that has no edge holes occupy consecutive
+ edge records, which the embedder does not move, so an arc of the graph
+ identifies the edge that was added in the same order in diskEdges.
+
+ Returns the edge, or -1 if the arc is not one of the added edges
+ ****************************************************************************/
+
+int  _Toroidal_GetDiskEdge(graphP diskGraph, int e, int *diskEdges)
+{
+     int i = (e - gp_GetFirstEdge(diskGraph)) / 2;
+
+     return i >= 0 && i < diskGraph->M ? diskEdges[i] : -1;
+}
+
+/****************************************************************************
+ _Toroidal_EmbedFace()
+
+ Embeds the bridges placed in face f together in the disk graph of the
+ face.  The boundary vertex of each position is the boundary vertex with
+ twice the index of the position, counting from Vsize, and each end of a
+ bridge is joined to the boundary vertex of its position.
+
+ The hub is outside of the boundary cycle, so the rotation of each
+ boundary vertex is its prior subdividing vertex, then the edges in its
+ corner, then its next subdividing vertex, then the hub.  If the planar
+ embedding has the reverse orientation, then all rotations are read in
+ reverse.  The edges in the corner at each position are recorded, along
+ with the rotations of the vertices of the bridges that are not in H.
+
+ Returns OK on success, NOTOK on internal error
+ ****************************************************************************/
+
+int  _Toroidal_EmbedFace(ToroidalWorkspace *ws, ToroidalSearch *search, graphP diskGraph, int *diskEdges, int f, int *pNumCorners)
+{
+     kuratowskiBridgesP kb = search->kb;
+     int Vsize = kb->firstVertex + kb->N;
+     int L = search->faceLength[f], hub = Vsize + 2*L;
+     int b, i, j, e, g, v, x, arc, reversed, numEnds, numDiskEdges = 0, numBridges = 0;
+     int endpoint[2], *endPos;
+
+     for (i = 0; i < L; i++)
+         ws->cornerStart[search->faceStart[f] + i] = *pNumCorners;
+
+     for (b = 0; b < kb->numBridges; b++)
+         if (search->assigned[b] >= 0 && search->placementFace[search->assigned[b]] == f)
+             numBridges++;
+
+     if (numBridges == 0)
+         return OK;
+
+     gp_ReinitializeGraph(diskGraph);
+
+     for (i = 0; i < L; i++)
+     {
+         if (gp_AddEdge(diskGraph, Vsize + 2*i, 0, Vsize + 2*i+1, 0) != OK ||
+             gp_AddEdge(diskGraph, Vsize + 2*i+1, 0, Vsize + 2*((i+1) % L), 0) != OK ||
+             gp_AddEdge(diskGraph, hub, 0, Vsize + 2*i, 0) != OK ||
+             gp_AddEdge(diskGraph, hub, 0, Vsize + 2*i+1, 0) != OK)
+             return NOTOK;
+
+         for (j = 0; j < 4; j++)
+             diskEdges[numDiskEdges++] = -1;
+     }
+
+     for (b = 0; b < kb->numBridges; b++)
+     {
+         if (search->assigned[b] < 0 || search->placementFace[search->assigned[b]] != f)
+             continue;
+
+         endPos = search->placementData + search->placementStart[search->assigned[b]];
+         numEnds = 0;
+         for (i = kb->edgeStart[b]; i < kb->edgeStart[b+1]; i++)
+         {
+             e = kb->bridgeEdges[i];
+             for (j = 0; j < 2; j++)
+             {
+                 endpoint[j] = kb->edges[2*e+j];
+                 if (kb->hDegree[endpoint[j]] > 0)
+                     endpoint[j] = Vsize + 2*endPos[numEnds++];
+             }
+
+             if (gp_AddEdge(diskGraph, endpoint[0], 0, endpoint[1], 0) != OK)
+                 return NOTOK;
+             diskEdges[numDiskEdges++] = e;
+         }
+     }
+
+     if (gp_Embed(diskGraph, EMBEDFLAGS_PLANAR) != OK ||
+         gp_SortVertices(diskGraph) != OK)
+         return NOTOK;
+
+     // Determine the orientation from the rotation of the first boundary vertex
+     arc = gp_GetFirstArc(diskGraph, Vsize);
+     while (gp_IsArc(arc) && gp_GetNeighbor(diskGraph, arc) != Vsize + 2*L-1)
+         arc = gp_GetNextArc(diskGraph, arc);
+     if (!gp_IsArc(arc))
+         return NOTOK;
+
+     reversed = gp_GetNeighbor(diskGraph, gp_GetNextArcCircular(diskGraph, arc)) == hub;
+
+     // Record the edges between the prior and next subdividing vertices
+     for (i = 0; i < L; i++)
+     {
+         g = search->faceStart[f] + i;
+         v = Vsize + 2*i;
+         ws->cornerStart[g] = *pNumCorners;
+
+         arc = gp_GetFirstArc(diskGraph, v);
+         while (gp_IsArc(arc) && gp_GetNeighbor(diskGraph, arc) != Vsize + 2*((i+L-1) % L) + 1)
+             arc = gp_GetNextArc(diskGraph, arc);
+         if (!gp_IsArc(arc))
+             return NOTOK;
+
+         for (;;)
+         {
+             arc = reversed ? gp_GetPrevArcCircular(diskGraph, arc)
+                            : gp_GetNextArcCircular(diskGraph, arc);
+             if (gp_GetNeighbor(diskGraph, arc) == v+1)
+                 break;
+
+             if ((e = _Toroidal_GetDiskEdge(diskGraph, arc, diskEdges)) < 0)
+                 return NOTOK;
+             ws->corners[(*pNumCorners)++] = e;
+             ws->cornerLength[g]++;
+         }
+     }
+
+     // Record the rotations of the vertices of the bridges that are not in H
+     search->stampValue++;
+     for (b = 0; b < kb->numBridges; b++)
+     {
+         if (search->assigned[b] < 0 || search->placementFace[search->assigned[b]] != f)
+             continue;
+
+         for (i = kb->edgeStart[b]; i < kb->edgeStart[b+1]; i++)
+         {
+             for (j = 0; j < 2; j++)
+             {
+                 x = kb->edges[2*kb->bridgeEdges[i]+j];
+                 if (kb->hDegree[x] > 0 || search->stamp[x] == search->stampValue)
+                     continue;
+                 search->stamp[x] = search->stampValue;
+
+                 arc = gp_GetFirstArc(diskGraph, x);
+                 do {
+                     if ((e = _Toroidal_GetDiskEdge(diskGraph, arc, diskEdges)) < 0)
+                         return NOTOK;
+                     ws->rotation[kb->adjStart[x] + ws->rotationSize[x]++] = e;
+
+                     arc = reversed ? gp_GetPrevArcCircular(diskGraph, arc)
+                                    : gp_GetNextArcCircular(diskGraph, arc);
+                 } while (arc != gp_GetFirstArc(diskGraph, x));
+             }
+         }
+     }
+
+     return OK;
+}
+
+/****************************************************************************
+ _Toroidal_WriteEmbedding()
+
+ Deletes all edges of theGraph, then adds the edges of the input graph,
+ ordering the adjacency list of each vertex by the rotation system built
+ in the workspace.  The loops of the input graph are added last, each
+ with its two arcs together, which keeps the genus of the embedding.
+
+ Returns OK on success, NOTOK on internal error
+ ****************************************************************************/
+
+int  _Toroidal_WriteEmbedding(ToroidalWorkspace *ws, graphP theGraph, int *edgeList, int numEdges)
+{
+     kuratowskiBridgesP kb = &ws->kb;
+     int Vsize = kb->firstVertex + kb->N;
+     int *arcOf, v, i, e, arc, RetVal = OK;
+
+     if (_KuratowskiBridges_ReplaceEdges(theGraph, NULL, 0) != OK ||
+         (arcOf = (int *) malloc((kb->M+1) * sizeof(int))) == NULL)
+         return NOTOK;
+
+     // Adding an edge makes its arc first in the adjacency list of u
+     for (i = 0; i < kb->M && RetVal == OK; i++)
+     {
+         if (gp_AddEdge(theGraph, kb->edges[2*i], 0, kb->edges[2*i+1], 0) != OK)
+             RetVal = NOTOK;
+         else
+             arcOf[i] = gp_GetFirstArc(theGraph, kb->edges[2*i]);
+     }
+
+     for (v = gp_GetFirstVertex(theGraph); v < Vsize && RetVal == OK; v++)
+     {
+         for (i = 0; i < ws->rotationSize[v]; i++)
+         {
+             e = ws->rotation[kb->adjStart[v] + i];
+             arc = kb->edges[2*e] == v ? arcOf[e] : gp_GetTwinArc(theGraph, arcOf[e]);
+             gp_MoveArcToLast(theGraph, v, arc);
+         }
+     }
+
+     free(arcOf);
+
+     for (i = 0; i < numEdges && RetVal == OK; i++)
+     {
+         if (edgeList[2*i] == edgeList[2*i+1] &&
+             gp_AddEdge(theGraph, edgeList[2*i], 0, edgeList[2*i+1], 0) != OK)
+             RetVal = NOTOK;
+     }
+
+     return RetVal;
+}
@@ -0,0 +1,208 @@
+#ifndef GRAPH_TOROIDAL_PRIVATE_H
+#define GRAPH_TOROIDAL_PRIVATE_H
+
+/*
+Planarity-Related Graph Algorithms Project
+Copyright (c) 1997-2012, John M. Boyer
+All rights reserved. Includes a reference implementation of the following:
+
+* John M. Boyer. "Subgraph Homeomorphism via the Edge Addition Planarity Algorithm".
+  Journal of Graph Algorithms and Applications, Vol. 16, no. 2, pp. 381-410, 2012.
+  http://www.jgaa.info/16/268.html
+
+* John M. Boyer. "A New Method for Efficiently Generating Planar Graph
+  Visibility Representations". In P. Eades and P. Healy, editors,
+  Proceedings of the 13th International Conference on Graph Drawing 2005,
+  Lecture Notes Comput. Sci., Volume 3843, pp. 508-511, Springer-Verlag, 2006.
+
+* John M. Boyer and Wendy J. Myrvold. "On the Cutting Edge: Simplified O(n)
+  Planarity by Edge Addition". Journal of Graph Algorithms and Applications,
+  Vol. 8, No. 3, pp. 241-273, 2004.
+  http://www.jgaa.info/08/91.html
+
+* John M. Boyer. "Simplified O(n) Algorithms for Planar Graph Embedding,
+  Kuratowski Subgraph Isolation, and Related Problems". Ph.D. Dissertation,
+  University of Victoria, 2001.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+  list of conditions and the following disclaimer in the documentation and/or
+  other materials provided with the distribution.
+
+* Neither the name of the Planarity-Related Graph Algorithms Project nor the names
+  of its contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include "graph.h"
+#include "graphKuratowskiBridges.private.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Additional equipment for each EdgeRec: None
+   Additional equipment for each vertex: None
+
+   The toroidal embedding test runs the core planarity algorithm.  If the
+   graph is planar, then the result is a planar embedding.  Otherwise, the
+   core isolates a subgraph H homeomorphic to K5 or K_{3,3}, and the test
+   tries to extend each of the labeled torus embeddings of H (231 for K5
+   and 20 for K_{3,3}) to the whole graph.  Every face of these embeddings
+   is a disk, but its boundary is a closed walk that may visit a vertex
+   more than once, so each edge joining a bridge of H to H is placed at one
+   of the corners of the face at its endpoint in H.  An embedding of H
+   extends if and only if each bridge can be given a face and a corner for
+   each of its edges to H, such that the bridge is planar together with the
+   face boundary and no two bridges in the same face overlap.
+   For this, the edges of the input graph are recorded during embedding
+   initialization.
+ */
+
+typedef struct
+{
+    // Helps distinguish initialize from re-initialize
+    int initialized;
+
+    // The graph that this context augments
+    graphP theGraph;
+
+    // The endpoints (in DFI order) of each edge of the input graph, recorded
+    // by _Toroidal_EmbeddingInitialize(), and the number of edges
+    int *edgeList;
+    int numEdges;
+
+    // Set when the input graph was found to be nonplanar, in which case a
+    // successful test leaves a torus embedding, rather than a planar
+    // embedding, in the adjacency lists of theGraph
+    int nonplanar;
+
+    // Overloaded function pointers
+    graphFunctionTable functions;
+
+} ToroidalContext;
+
+/* The search of the embedding cases of H by one thread of the toroidal
+   embedding test.  The graph being tested, H and the bridges of H are in
+   the workspace, and the search of each thread has the arrays that change
+   from one case to the next: the faces of the embedding of H being
+   extended, the placements of the bridges in the faces, and the state of
+   the search, along with the results of the planarity tests of bridges,
+   which stay valid from one case to the next.
+ */
+
+typedef struct
+{
+    // The graph being tested, with H and its bridges
+    kuratowskiBridgesP kb;
+
+    // A graph without extensions that is used for the planarity tests of
+    // the bridges.  It holds one bridge at a time, with its vertices
+    // renumbered from the first vertex, so it is sized by the largest
+    // bridge rather than by the graph.  The bridge graph vertex of each
+    // vertex of the bridge is in localIndex, and localVertex maps the
+    // bridge graph vertices back
+    graphP bridgeGraph;
+    int *localIndex, *localVertex;
+
+    // The faces of the embedding of H being extended.  Each face is a closed
+    // walk, stored as its sequence of positions, each of which has a vertex
+    // and the edge to the vertex at the next position.  The positions of
+    // each vertex in each face are linked, starting from occurrenceHead
+    int numFaces;
+    int faceStart[5], faceLength[5];
+    int *faceVertices, *faceEdges;
+    int *occurrenceHead, *occurrenceNext;
+
+    // The placements of the bridges.  A placement of a bridge gives a face
+    // and a position in the face for each end of the bridge.  It is usable
+    // only if the bridge is planar together with the face boundary, and
+    // placementTested is set once this is known.  The placements of each
+    // bridge are contiguous, starting at bridgePlacements.  The data of
+    // each placement starts at placementData[placementStart[p]] and is the
+    // position of each end, then the number of distinct positions and the
+    // distinct positions in ascending order
+    int numPlacements, placementCapacity;
+    int *bridgePlacements;
+    int *placementBridge, *placementFace, *placementStart, *placementTested;
+    int placementDataSize, placementDataCapacity;
+    int *placementData;
+
+    // The results of the planarity tests of the placements, keyed by the
+    // edges of the bridge and the pattern in which the ends of the bridge
+    // meet the face boundary, which is unchanged by rotating or reflecting
+    // the boundary.  The keys are in memoData, each preceded by its length,
+    // and memoTable is an open addressing hash table of their locations
+    int memoSize, memoCapacity;
+    int *memoTable, *memoResult;
+    int memoDataSize, memoDataCapacity;
+    int *memoData;
+
+    // The search state: whether each placement is available, the number of
+    // available placements of each bridge, the placement assigned to each
+    // bridge or -1, the bridge and next placement to try at each search
+    // level, and a trail of removed placements so they can be restored
+    int *placementAvailable, *numAvailable, *assigned;
+    int *levelBridge, *levelNext, *levelTrail;
+    int *trail;
+    int trailSize;
+
+    // Vertex markings, and scratch space
+    int *stamp;
+    int stampValue;
+    int *scratch;
+
+} ToroidalSearch;
+
+/* The workspace used by the toroidal embedding test, which is sized by the
+   graph being tested, with N vertices starting from gp_GetFirstVertex().
+   It has the graph, H and the bridges of H, a search of the embedding
+   cases of H for each thread, and the rotation system of the result.
+ */
+
+typedef struct
+{
+    // The graph being tested, with H and its bridges
+    kuratowskiBridges kb;
+
+    // A graph without extensions, with the N vertices of the graph being
+    // tested, that is used for planarity tests
+    graphP testGraph;
+
+    // The searches of the embedding cases of H by each thread
+    int numThreads;
+    ToroidalSearch *searches;
+
+    // The rotation system of the embedding found, with the neighbors of each
+    // vertex stored starting at adjStart.  The neighbors of the vertices in
+    // H that are in the corner of a face at each position are stored in the
+    // corners array, and the corner that follows each edge of H at each of
+    // its endpoints is in cornerOfArc
+    int *rotation, *rotationSize;
+    int *cornerStart, *cornerLength, *corners;
+    int *cornerOfArc;
+
+} ToroidalWorkspace;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
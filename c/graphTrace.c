@@ -0,0 +1,261 @@
+/*
+Planarity-Related Graph Algorithms Project
+Copyright (c) 1997-2012, John M. Boyer
+All rights reserved. Includes a reference implementation of the following:
+
+* John M. Boyer. "Subgraph Homeomorphism via the Edge Addition Planarity Algorithm".
+  Journal of Graph Algorithms and Applications, Vol. 16, no. 2, pp. 381-410, 2012.
+  http://www.jgaa.info/16/268.html
+
+* John M. Boyer. "A New Method for Efficiently Generating Planar Graph
+  Visibility Representations". In P. Eades and P. Healy, editors,
+  Proceedings of the 13th International Conference on Graph Drawing 2005,
+  Lecture Notes Comput. Sci., Volume 3843, pp. 508-511, Springer-Verlag, 2006.
+
+* John M. Boyer and Wendy J. Myrvold. "On the Cutting Edge: Simplified O(n)
+  Planarity by Edge Addition". Journal of Graph Algorithms and Applications,
+  Vol. 8, No. 3, pp. 241-273, 2004.
+  http://www.jgaa.info/08/91.html
+
+* John M. Boyer. "Simplified O(n) Algorithms for Planar Graph Embedding,
+  Kuratowski Subgraph Isolation, and Related Problems". Ph.D. Dissertation,
+  University of Victoria, 2001.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+  list of conditions and the following disclaimer in the documentation and/or
+  other materials provided with the distribution.
+
+* Neither the name of the Planarity-Related Graph Algorithms Project nor the names
+  of its contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "graphTrace.private.h"
+#include "platformTime.h"
+
+/* One begin or end event in the ring buffer of a trace.  The timestamp
+   is in microseconds since the trace was attached. */
+
+typedef struct
+{
+    double timestamp;
+    int event, phase, vertex;
+} traceEventRec;
+
+/********************************************************************
+ The trace recorder of a graph (see graphTraceP in graphStructures.h)
+
+        events: the ring buffer of events
+        capacity: the number of events the ring buffer holds
+        next: the location in the ring buffer of the next event
+        numRecorded: the number of events recorded since the trace was
+                attached, of which only the last capacity are kept
+        start: the wall time at which the trace was attached
+*/
+
+struct graphTrace
+{
+    traceEventRec *events;
+    int capacity, next;
+    unsigned long numRecorded;
+    platform_walltime start;
+};
+
+/* The names of the events, as shown in a timeline viewer */
+
+static char *traceEventNames[TRACE_NUMEVENTS] = {
+    "Embed", "EmbeddingInitialize", "DFS", "SortVertices", "VertexStep",
+    "Walkup", "Walkdown", "MergeBicomps", "HandleBlockedBicomp",
+    "Reduction", "EmbedPostprocess"
+};
+
+/********************************************************************
+ gp_AttachTrace()
+
+ Attaches a trace recorder to theGraph, or empties the one already
+ attached.  While it is attached, gp_Embed() records the begin and end
+ of its initialization (including the DFS and vertex sort), each vertex
+ step and the Walkup and each Walkdown within it, each bicomp merge,
+ each blocked bicomp handled (which is where extension algorithms such
+ as the K_{3,3} and K_4 searches do their work), the reductions made by
+ those extensions, and the postprocessing.  The recorder keeps the last
+ capacity events, or TRACE_DEFAULTCAPACITY if capacity is not positive,
+ which is enough to see the slowest vertex steps of most runs.  Call
+ gp_WriteTrace() to save the events for a timeline viewer.
+
+ The trace is owned by theGraph, so gp_CopyGraph() and gp_DupGraph()
+ do not copy it, and gp_ReinitializeGraph() keeps its events, so that
+ one trace can span a series of embeddings of the graph.  Each event
+ takes 24 bytes.
+
+ Returns OK on success, NOTOK on allocation failure, in which case no
+         trace is attached
+ ********************************************************************/
+
+int  gp_AttachTrace(graphP theGraph, int capacity)
+{
+     if (theGraph == NULL)
+         return NOTOK;
+
+     gp_DetachTrace(theGraph);
+
+     if (capacity <= 0)
+         capacity = TRACE_DEFAULTCAPACITY;
+
+     if ((theGraph->trace = (graphTraceP) malloc(sizeof(struct graphTrace))) == NULL)
+         return NOTOK;
+
+     if ((theGraph->trace->events = (traceEventRec *) malloc(capacity * sizeof(traceEventRec))) == NULL)
+     {
+         free(theGraph->trace);
+         theGraph->trace = NULL;
+         return NOTOK;
+     }
+
+     theGraph->trace->capacity = capacity;
+     theGraph->trace->next = 0;
+     theGraph->trace->numRecorded = 0;
+     platform_GetWallTime(theGraph->trace->start);
+
+     return OK;
+}
+
+/********************************************************************
+ gp_DetachTrace()
+
+ Frees the trace recorder of theGraph, if any, along with its events.
+ ********************************************************************/
+
+void gp_DetachTrace(graphP theGraph)
+{
+     if (theGraph == NULL || theGraph->trace == NULL)
+         return;
+
+     free(theGraph->trace->events);
+     free(theGraph->trace);
+     theGraph->trace = NULL;
+}
+
+/********************************************************************
+ _TraceRecord()
+
+ Records the begin ('B') or end ('E') phase of the event for vertex v
+ in the ring buffer, overwriting the oldest event if the buffer is full.
+ The gp_TraceBegin() and gp_TraceEnd() macros call this only when a
+ trace is attached.
+ ********************************************************************/
+
+void _TraceRecord(graphP theGraph, int event, int phase, int v)
+{
+graphTraceP theTrace = theGraph->trace;
+traceEventRec *theEvent = theTrace->events + theTrace->next;
+platform_walltime now;
+
+     platform_GetWallTime(now);
+     theEvent->timestamp = platform_GetWallDuration(theTrace->start, now) * 1e6;
+     theEvent->event = event;
+     theEvent->phase = phase;
+     theEvent->vertex = v;
+
+     if (++theTrace->next == theTrace->capacity)
+         theTrace->next = 0;
+     theTrace->numRecorded++;
+}
+
+/********************************************************************
+ gp_WriteTrace()
+
+ Writes the events kept by the trace recorder of theGraph to the named
+ file in the Chrome trace event format, a JSON object whose traceEvents
+ array can be opened in chrome://tracing or the Perfetto UI.  Each event
+ that has a vertex carries its DFI as the argument v.
+
+ Once the ring buffer has wrapped, the oldest events kept may be the
+ ends of phases whose begins were overwritten, so those are skipped.
+ Phases still open at the last event, e.g. because an algorithm failed
+ partway, are closed at the time of the last event.
+
+ Returns OK on success, NOTOK if no trace is attached or if the file
+         cannot be written
+ ********************************************************************/
+
+int  gp_WriteTrace(graphP theGraph, char *FileName)
+{
+graphTraceP theTrace;
+traceEventRec *theEvent = NULL;
+FILE *Outfile;
+int  i, first, numEvents, depth = 0, numWritten = 0;
+
+     if (theGraph == NULL || (theTrace = theGraph->trace) == NULL || FileName == NULL)
+         return NOTOK;
+
+     if ((Outfile = fopen(FileName, "w")) == NULL)
+         return NOTOK;
+
+     if (theTrace->numRecorded > (unsigned long) theTrace->capacity)
+     {
+         first = theTrace->next;
+         numEvents = theTrace->capacity;
+     }
+     else
+     {
+         first = 0;
+         numEvents = theTrace->next;
+     }
+
+     fprintf(Outfile, "{\"traceEvents\":[");
+
+     for (i = 0; i < numEvents; i++)
+     {
+         theEvent = theTrace->events + (first + i) % theTrace->capacity;
+
+         if (theEvent->phase == 'E')
+         {
+             if (depth == 0)
+                 continue;
+             depth--;
+         }
+         else depth++;
+
+         fprintf(Outfile, "%s\n{\"name\":\"%s\",\"cat\":\"embed\",\"ph\":\"%c\",\"ts\":%.3lf,\"pid\":1,\"tid\":1",
+                 numWritten++ > 0 ? "," : "", traceEventNames[theEvent->event],
+                 theEvent->phase, theEvent->timestamp);
+
+         if (gp_IsVertex(theEvent->vertex))
+             fprintf(Outfile, ",\"args\":{\"v\":%d}", theEvent->vertex);
+
+         fprintf(Outfile, "}");
+     }
+
+     // An end event without a name closes the most recent open phase
+     for (; depth > 0; depth--)
+         fprintf(Outfile, ",\n{\"ph\":\"E\",\"ts\":%.3lf,\"pid\":1,\"tid\":1}", theEvent->timestamp);
+
+     fprintf(Outfile, "\n],\"displayTimeUnit\":\"ns\"}\n");
+
+     if (fclose(Outfile) != 0)
+         return NOTOK;
+
+     return OK;
+}
@@ -0,0 +1,1258 @@
+/*
+Planarity-Related Graph Algorithms Project
+Copyright (c) 1997-2012, John M. Boyer
+All rights reserved. Includes a reference implementation of the following:
+
+* John M. Boyer. "Subgraph Homeomorphism via the Edge Addition Planarity Algorithm".
+  Journal of Graph Algorithms and Applications, Vol. 16, no. 2, pp. 381-410, 2012.
+  http://www.jgaa.info/16/268.html
+
+* John M. Boyer. "A New Method for Efficiently Generating Planar Graph
+  Visibility Representations". In P. Eades and P. Healy, editors,
+  Proceedings of the 13th International Conference on Graph Drawing 2005,
+  Lecture Notes Comput. Sci., Volume 3843, pp. 508-511, Springer-Verlag, 2006.
+
+* John M. Boyer and Wendy J. Myrvold. "On the Cutting Edge: Simplified O(n)
+  Planarity by Edge Addition". Journal of Graph Algorithms and Applications,
+  Vol. 8, No. 3, pp. 241-273, 2004.
+  http://www.jgaa.info/08/91.html
+
+* John M. Boyer. "Simplified O(n) Algorithms for Planar Graph Embedding,
+  Kuratowski Subgraph Isolation, and Related Problems". Ph.D. Dissertation,
+  University of Victoria, 2001.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+  list of conditions and the following disclaimer in the documentation and/or
+  other materials provided with the distribution.
+
+* Neither the name of the Planarity-Related Graph Algorithms Project nor the names
+  of its contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "graph.h"
+#include "graphSPQRTree.h"
+
+/* Imported functions */
+
+extern void _EdgeIndexInsert(graphP theGraph, int e);
+extern void _EdgeIndexRemove(graphP theGraph, int e);
+extern int  _SuspendEdgeIndex(graphP theGraph);
+extern int  _RebuildEdgeIndex(graphP theGraph);
+
+/* Private functions, except exported within library */
+
+void _FreeTransaction(graphP theGraph);
+void _TransactionSaveVertex(graphP theGraph, int v);
+void _TransactionSaveEdge(graphP theGraph, int e);
+void _TransactionSaveArcLinks(graphP theGraph, int e);
+void _TransactionSaveArcAttachment(graphP theGraph, int v, int e, int link, int newArc);
+void _TransactionSaveEdgeHole(graphP theGraph);
+int  _TransactionSaveGraph(graphP theGraph);
+
+/* Private functions */
+
+int  _TransactionEnsureStamps(graphTransactionP theLog, int vertexBound, int edgeBound);
+int  _TransactionGrow(void **pArray, int *pCapacity, int entrySize);
+int  _IsArcAttached(graphP theGraph, int e);
+void _UpdateEdgeIndexForRollback(graphP theGraph, int remove);
+int  _MarkComponents(graphP theGraph, int *component, int *componentN, int *componentM, int *componentSimple);
+
+/* Working storage of gp_TestEdgeInsertions() for deciding candidates whose
+   endpoints are in a biconnected component by the SPQR tree of that block.
+
+        theGraph: a copy of the graph given, to which the SPQR trees are
+                attached
+        componentTree: for each connected component, the SPQR tree of the
+                component if it is a single biconnected block, or -1
+        nodeParent, nodeDepth: each SPQR tree rooted at its first node
+        nodeParentEdge, nodeChildEdge: the positions of the virtual edge
+                joining a node to its parent in the skeleton of the node
+                and in the skeleton of the parent
+        nodeNumVertices: the number of vertices of each skeleton, which
+                are numbered from 1 in the order the skeleton edges meet
+                them
+        vertexFirst, vertexNode, vertexLocal: for each vertex, the nodes
+                whose skeletons contain it and its number in each
+        skeleton, skeletonFaces: the planar embedding and faces of the
+                skeleton of each R-node, made when first needed
+        stamp, markU, markV, pathA, pathB, localNum, faceStamp: scratch
+                storage of the queries and of embedding the skeletons
+*/
+
+typedef struct
+{
+    graphP theGraph;
+    int numNodes, *componentTree;
+    int *nodeParent, *nodeDepth, *nodeParentEdge, *nodeChildEdge, *nodeNumVertices;
+    int *vertexFirst, *vertexNode, *vertexLocal;
+    graphP *skeleton;
+    embeddingFacesP *skeletonFaces;
+
+    int stamp, *markU, *markV, *pathA, *pathB, *localNum, *faceStamp;
+} edgeInsertionWorkspace;
+
+int  _EI_InitWorkspace(edgeInsertionWorkspace *ws, graphP theGraph, int *component, int *componentM);
+void _EI_FreeWorkspace(edgeInsertionWorkspace *ws);
+int  _EI_TestEdge(edgeInsertionWorkspace *ws, int u, int v, int *pResult);
+int  _EI_VirtualEdge(edgeInsertionWorkspace *ws, int i, int neighbor);
+int  _EI_LocalVertex(edgeInsertionWorkspace *ws, int i, int v);
+int  _EI_EmbedRNode(edgeInsertionWorkspace *ws, int i);
+int  _EI_Cofacial(edgeInsertionWorkspace *ws, int i, int x, int y, int *pCofacial);
+
+/********************************************************************
+ gp_BeginTransaction()
+
+ Begins a transaction on theGraph, so that gp_Rollback() can later put
+ theGraph back as it is now, or gp_CommitTransaction() can keep the
+ changes.  Transactions do not nest.
+
+ While the transaction is open, gp_AddEdge(), gp_AddEdges(),
+ gp_InsertEdge(), gp_DeleteEdge(), gp_HideEdge() and gp_RestoreEdge()
+ save each vertex record, edge record and edge hole they are about to
+ change, the first time they change it, so that rolling back takes
+ time proportional to the number of records changed.
+
+ The operations that rewrite the graph wholesale, which are gp_Embed(),
+ gp_CreateDFSTree(), gp_SortVertices(), gp_LowpointAndLeastAncestor(),
+ gp_ReinitializeGraph(), copying into theGraph, and vertex hiding,
+ identification and restoration, instead take a snapshot of the whole
+ graph the first time one of them runs in the transaction, after which
+ nothing more needs saving.  This covers the embedding state, such as
+ the vertex info, external face links and list collections.  The
+ snapshot graph is kept and reused by later transactions.  A graph with
+ extensions attached has its snapshot taken when the transaction begins,
+ since the log does not cover the data of extensions.
+
+ The arc capacity cannot grow within a transaction, so call
+ gp_EnsureArcCapacity() beforehand if edges are to be added.  Other
+ operations that change theGraph are not covered by the transaction.
+
+ The log and the per-record stamps that keep each record from being
+ saved twice are owned by theGraph and freed with it.
+
+ Returns OK on success, NOTOK if theGraph is not initialized, if a
+         transaction is already open, or on allocation failure
+ ********************************************************************/
+
+int  gp_BeginTransaction(graphP theGraph)
+{
+graphTransactionP theLog;
+
+     if (theGraph == NULL || theGraph->N == 0)
+         return NOTOK;
+
+     if (theGraph->transaction == NULL &&
+         (theGraph->transaction = (graphTransactionP) calloc(1, sizeof(graphTransaction))) == NULL)
+         return NOTOK;
+
+     theLog = theGraph->transaction;
+     if (theLog->open)
+         return NOTOK;
+
+     if (_TransactionEnsureStamps(theLog, gp_VertexIndexBound(theGraph), gp_EdgeIndexBound(theGraph)) != OK)
+         return NOTOK;
+
+     // A new transaction number makes all records unsaved; when the
+     // numbers run out, the stamps are cleared and numbering restarts
+     if (theLog->transactionNumber == 0x7FFFFFFF)
+     {
+         memset(theLog->vertexStamp, 0, theLog->vertexStampSize * sizeof(int));
+         memset(theLog->edgeStamp, 0, theLog->edgeStampSize * sizeof(int));
+         theLog->transactionNumber = 0;
+     }
+     theLog->transactionNumber++;
+
+     theLog->numSavedV = theLog->numSavedE = theLog->numSavedHoles = 0;
+     theLog->M = theGraph->M;
+     theLog->numHoles = theLog->leastNumHoles = sp_GetCurrentSize(theGraph->edgeHoles);
+
+     theLog->hasSnapshot = theLog->failed = FALSE;
+     theLog->open = theLog->logging = TRUE;
+
+     if (theGraph->extensions != NULL && _TransactionSaveGraph(theGraph) != OK)
+     {
+         theLog->open = theLog->logging = FALSE;
+         return NOTOK;
+     }
+
+     return OK;
+}
+
+/********************************************************************
+ gp_CommitTransaction()
+
+ Ends the open transaction on theGraph, keeping its changes.
+
+ Returns OK on success, NOTOK if no transaction is open
+ ********************************************************************/
+
+int  gp_CommitTransaction(graphP theGraph)
+{
+     if (theGraph == NULL || theGraph->transaction == NULL || !theGraph->transaction->open)
+         return NOTOK;
+
+     theGraph->transaction->open = theGraph->transaction->logging = FALSE;
+     return OK;
+}
+
+/********************************************************************
+ gp_Rollback()
+
+ Ends the open transaction on theGraph, undoing its changes.  If a
+ snapshot was taken, it is copied back first.  Then the records saved
+ before the snapshot, or all saved records if there was none, are put
+ back, along with the number of edges and the edge hole stack.
+
+ If an edge index is attached, then the edges of the saved arcs are
+ taken out of it before the records are put back and put into it
+ afterward, unless the snapshot was copied back, in which case the
+ index is rebuilt.
+
+ Returns OK on success, NOTOK if no transaction is open, if a record
+         could not be saved during the transaction, or if copying back
+         the snapshot fails.  The transaction is ended in any case.
+ ********************************************************************/
+
+int  gp_Rollback(graphP theGraph)
+{
+graphTransactionP theLog;
+int  k, indexSuspended = FALSE, Result = OK;
+
+     if (theGraph == NULL || (theLog = theGraph->transaction) == NULL || !theLog->open)
+         return NOTOK;
+
+     theLog->open = theLog->logging = FALSE;
+
+     if (theLog->failed)
+         return NOTOK;
+
+     if (theLog->hasSnapshot)
+     {
+         indexSuspended = _SuspendEdgeIndex(theGraph);
+         if (gp_CopyGraph(theGraph, theLog->snapshot) != OK)
+             Result = NOTOK;
+     }
+     else if (gp_EdgeIndexActive(theGraph))
+         _UpdateEdgeIndexForRollback(theGraph, TRUE);
+
+     // Each record was saved once, before its first change, so the order
+     // in which they are put back does not matter
+     for (k = 0; k < theLog->numSavedV; k++)
+          theGraph->V[theLog->savedV[k].v] = theLog->savedV[k].rec;
+
+     for (k = 0; k < theLog->numSavedE; k++)
+          theGraph->E[theLog->savedE[k].e] = theLog->savedE[k].rec;
+
+     for (k = 0; k < theLog->numSavedHoles; k++)
+          sp_Set(theGraph->edgeHoles, theLog->savedHoles[2*k], theLog->savedHoles[2*k+1]);
+
+     theGraph->M = theLog->M;
+     if (sp_SetCurrentSize(theGraph->edgeHoles, theLog->numHoles) != OK)
+         Result = NOTOK;
+
+     if (indexSuspended)
+     {
+         if (_RebuildEdgeIndex(theGraph) != OK)
+             Result = NOTOK;
+     }
+     else if (gp_EdgeIndexActive(theGraph))
+         _UpdateEdgeIndexForRollback(theGraph, FALSE);
+
+     return Result;
+}
+
+/********************************************************************
+ _UpdateEdgeIndexForRollback()
+
+ If remove is TRUE, takes out of the edge index the edge of each saved
+ arc that is in it, i.e. that is in use and attached to its adjacency
+ list, marking the edge in the stamps so it is handled once.  If remove
+ is FALSE, which is after the saved records are put back, puts each
+ marked edge back into the index if it is in use and attached.
+ ********************************************************************/
+
+void _UpdateEdgeIndexForRollback(graphP theGraph, int remove)
+{
+graphTransactionP theLog = theGraph->transaction;
+int  k, e, mark = -theLog->transactionNumber;
+
+     for (k = 0; k < theLog->numSavedE; k++)
+     {
+          e = theLog->savedE[k].e & ~1;
+
+          if (remove ? theLog->edgeStamp[e] == mark : theLog->edgeStamp[e] != mark)
+              continue;
+          theLog->edgeStamp[e] = remove ? mark : 0;
+
+          if (gp_EdgeInUse(theGraph, e) && _IsArcAttached(theGraph, e))
+          {
+              if (remove)
+                  _EdgeIndexRemove(theGraph, e);
+              else
+                  _EdgeIndexInsert(theGraph, e);
+          }
+     }
+}
+
+/********************************************************************
+ _IsArcAttached()
+
+ Returns TRUE if the arc e is in the adjacency list of the vertex it
+ leads from, FALSE if it has been detached, e.g. by gp_HideEdge()
+ ********************************************************************/
+
+int  _IsArcAttached(graphP theGraph, int e)
+{
+int  prevArc = gp_GetPrevArc(theGraph, e);
+
+     if (gp_IsArc(prevArc))
+         return gp_GetNextArc(theGraph, prevArc) == e ? TRUE : FALSE;
+
+     return gp_GetFirstArc(theGraph, gp_GetNeighbor(theGraph, gp_GetTwinArc(theGraph, e))) == e ? TRUE : FALSE;
+}
+
+/********************************************************************
+ _FreeTransaction()
+
+ Frees the undo log of theGraph, including its snapshot, if any.
+ ********************************************************************/
+
+void _FreeTransaction(graphP theGraph)
+{
+graphTransactionP theLog = theGraph->transaction;
+
+     if (theLog == NULL)
+         return;
+
+     if (theLog->savedV != NULL) free(theLog->savedV);
+     if (theLog->savedE != NULL) free(theLog->savedE);
+     if (theLog->savedHoles != NULL) free(theLog->savedHoles);
+     if (theLog->vertexStamp != NULL) free(theLog->vertexStamp);
+     if (theLog->edgeStamp != NULL) free(theLog->edgeStamp);
+     gp_Free(&theLog->snapshot);
+
+     free(theLog);
+     theGraph->transaction = NULL;
+}
+
+/********************************************************************
+ _TransactionEnsureStamps()
+
+ Ensures that the undo log has a stamp for each of vertexBound vertex
+ records and edgeBound edge records.  New stamps are zero, which is not
+ a transaction number.
+
+ Returns OK on success, NOTOK on allocation failure
+ ********************************************************************/
+
+int  _TransactionEnsureStamps(graphTransactionP theLog, int vertexBound, int edgeBound)
+{
+     if (theLog->vertexStampSize < vertexBound)
+     {
+         if (theLog->vertexStamp != NULL)
+             free(theLog->vertexStamp);
+         theLog->vertexStampSize = 0;
+         if ((theLog->vertexStamp = (int *) calloc(vertexBound, sizeof(int))) == NULL)
+             return NOTOK;
+         theLog->vertexStampSize = vertexBound;
+     }
+
+     if (theLog->edgeStampSize < edgeBound)
+     {
+         if (theLog->edgeStamp != NULL)
+             free(theLog->edgeStamp);
+         theLog->edgeStampSize = 0;
+         if ((theLog->edgeStamp = (int *) calloc(edgeBound, sizeof(int))) == NULL)
+             return NOTOK;
+         theLog->edgeStampSize = edgeBound;
+     }
+
+     return OK;
+}
+
+/********************************************************************
+ _TransactionGrow()
+
+ Doubles the capacity of one of the arrays of the undo log, whose
+ entries have the given size, starting from 64 entries.
+
+ Returns OK on success, NOTOK on allocation failure, in which case the
+         array is unchanged
+ ********************************************************************/
+
+int  _TransactionGrow(void **pArray, int *pCapacity, int entrySize)
+{
+int  newCapacity = *pCapacity > 0 ? 2 * *pCapacity : 64;
+void *newArray = realloc(*pArray, (size_t) newCapacity * entrySize);
+
+     if (newArray == NULL)
+         return NOTOK;
+
+     *pArray = newArray;
+     *pCapacity = newCapacity;
+     return OK;
+}
+
+/********************************************************************
+ _TransactionSaveVertex()
+ _TransactionSaveEdge()
+
+ Save the vertex record v or the edge record e in the undo log, unless
+ it was already saved in the current transaction.  If the log cannot
+ grow, the transaction is marked as failed.  The callers check
+ gp_TransactionLogging() first.
+ ********************************************************************/
+
+void _TransactionSaveVertex(graphP theGraph, int v)
+{
+graphTransactionP theLog = theGraph->transaction;
+
+     if (theLog->vertexStamp[v] == theLog->transactionNumber)
+         return;
+
+     if (theLog->numSavedV == theLog->savedVCapacity &&
+         _TransactionGrow((void **) &theLog->savedV, &theLog->savedVCapacity, sizeof(savedVertexRec)) != OK)
+     {
+         theLog->failed = TRUE;
+         return;
+     }
+
+     theLog->vertexStamp[v] = theLog->transactionNumber;
+     theLog->savedV[theLog->numSavedV].v = v;
+     theLog->savedV[theLog->numSavedV].rec = theGraph->V[v];
+     theLog->numSavedV++;
+}
+
+void _TransactionSaveEdge(graphP theGraph, int e)
+{
+graphTransactionP theLog = theGraph->transaction;
+
+     if (theLog->edgeStamp[e] == theLog->transactionNumber)
+         return;
+
+     if (theLog->numSavedE == theLog->savedECapacity &&
+         _TransactionGrow((void **) &theLog->savedE, &theLog->savedECapacity, sizeof(savedEdgeRec)) != OK)
+     {
+         theLog->failed = TRUE;
+         return;
+     }
+
+     theLog->edgeStamp[e] = theLog->transactionNumber;
+     theLog->savedE[theLog->numSavedE].e = e;
+     theLog->savedE[theLog->numSavedE].rec = theGraph->E[e];
+     theLog->numSavedE++;
+}
+
+/********************************************************************
+ _TransactionSaveArcLinks()
+
+ Saves what detaching or restoring the two arcs of the edge of e can
+ change: the two arcs, the arcs their links indicate, and the records
+ of the vertices they lead from.
+ ********************************************************************/
+
+void _TransactionSaveArcLinks(graphP theGraph, int e)
+{
+int  arc = e, i, link;
+
+     for (i = 0; i < 2; i++, arc = gp_GetTwinArc(theGraph, e))
+     {
+          _TransactionSaveEdge(theGraph, arc);
+          for (link = 0; link < 2; link++)
+               if (gp_IsArc(gp_GetAdjacentArc(theGraph, arc, link)))
+                   _TransactionSaveEdge(theGraph, gp_GetAdjacentArc(theGraph, arc, link));
+          _TransactionSaveVertex(theGraph, gp_GetNeighbor(theGraph, gp_GetTwinArc(theGraph, arc)));
+     }
+}
+
+/********************************************************************
+ _TransactionSaveArcAttachment()
+
+ Saves what gp_AttachArc(theGraph, v, e, link, newArc) changes: newArc,
+ the record of v, e if it is an arc, and the arc that will follow newArc
+ in the link direction.
+ ********************************************************************/
+
+void _TransactionSaveArcAttachment(graphP theGraph, int v, int e, int link, int newArc)
+{
+int  e2 = gp_IsArc(e) ? gp_GetAdjacentArc(theGraph, e, link) : gp_GetArc(theGraph, v, link);
+
+     _TransactionSaveEdge(theGraph, newArc);
+     _TransactionSaveVertex(theGraph, v);
+
+     if (gp_IsArc(e))
+         _TransactionSaveEdge(theGraph, e);
+     if (gp_IsArc(e2))
+         _TransactionSaveEdge(theGraph, e2);
+}
+
+/********************************************************************
+ _TransactionSaveEdgeHole()
+
+ Called before popping the edge hole stack.  The slots below the least
+ size the stack has had in the transaction are unchanged, and popping
+ below it exposes one more slot that a later push could overwrite, so
+ that slot is saved.
+ ********************************************************************/
+
+void _TransactionSaveEdgeHole(graphP theGraph)
+{
+graphTransactionP theLog = theGraph->transaction;
+int  slot = sp_GetCurrentSize(theGraph->edgeHoles) - 1;
+
+     if (slot < 0 || slot >= theLog->leastNumHoles)
+         return;
+
+     if (theLog->numSavedHoles == theLog->savedHolesCapacity &&
+         _TransactionGrow((void **) &theLog->savedHoles, &theLog->savedHolesCapacity, 2 * sizeof(int)) != OK)
+     {
+         theLog->failed = TRUE;
+         return;
+     }
+
+     theLog->savedHoles[2*theLog->numSavedHoles] = slot;
+     theLog->savedHoles[2*theLog->numSavedHoles+1] = sp_Get(theGraph->edgeHoles, slot);
+     theLog->numSavedHoles++;
+     theLog->leastNumHoles = slot;
+}
+
+/********************************************************************
+ _TransactionSaveGraph()
+
+ Called by the operations that rewrite theGraph wholesale when
+ gp_TransactionLogging() is true, i.e. before the first of them in an
+ open transaction.  Copies the whole graph into the snapshot, which is
+ allocated by the first transaction that needs it and reused after, then
+ stops the saving of records.
+
+ Returns OK on success, NOTOK on allocation failure, in which case the
+         transaction is marked as failed
+ ********************************************************************/
+
+int  _TransactionSaveGraph(graphP theGraph)
+{
+graphTransactionP theLog = theGraph->transaction;
+
+     if (theLog == NULL || !theLog->open || theLog->hasSnapshot)
+         return OK;
+
+     // A reused snapshot must match theGraph in size, since putting it back
+     // must not change the arc capacity of theGraph
+     if (theLog->snapshot != NULL &&
+         (theLog->snapshot->N != theGraph->N ||
+          theLog->snapshot->arcCapacity != theGraph->arcCapacity))
+         gp_Free(&theLog->snapshot);
+
+     if (theLog->snapshot == NULL)
+         theLog->snapshot = gp_DupGraph(theGraph);
+     else if (gp_CopyGraph(theLog->snapshot, theGraph) != OK)
+         gp_Free(&theLog->snapshot);
+
+     if (theLog->snapshot == NULL)
+     {
+         theLog->failed = TRUE;
+         return NOTOK;
+     }
+
+     theLog->hasSnapshot = TRUE;
+     theLog->logging = FALSE;
+     return OK;
+}
+
+/********************************************************************
+ gp_TestEdgeInsertions()
+
+ Determines, for each of numEdges candidate edges, edge k joining the
+ vertices edgeEnds[2k] and edgeEnds[2k+1], whether theGraph would stay
+ planar if that edge alone were added.  theGraph is not changed.
+
+ A copy of theGraph is embedded once.  A candidate keeps the graph
+ planar, with no further work, if its endpoints are equal, adjacent, in
+ different connected components, or on a common face of the embedding,
+ since the edge can then be drawn in that face.  A candidate whose
+ endpoints are in a simple connected component that is maximal planar,
+ with 3n-6 edges on n vertices, does not.
+
+ A candidate whose endpoints are in a connected component that is a
+ single biconnected block is decided by the SPQR tree of the block, which
+ is found for a third copy of theGraph when first needed.  The edge can
+ be added if and only if, in the skeleton of each R-node on the path of
+ the SPQR tree between the nodes containing its endpoints, the endpoint
+ or the virtual edge by which the path enters the node and the one by
+ which it leaves are on a common face.  This is the case of no crossings
+ in the edge insertion of Gutwenger, Mutzel and Weiskircher ("Inserting
+ an Edge into a Planar Graph", Algorithmica 41, 2005, pp. 289-308), and
+ it holds because the embedding of an R-node skeleton is unique up to
+ mirror image while the other nodes can be arranged as needed.
+
+ Each remaining candidate is added to a second copy of theGraph, which is
+ embedded within a transaction that is then rolled back, so that the copy
+ and the transaction's snapshot are reused from one candidate to the
+ next rather than being rebuilt from theGraph.
+
+ results: receives OK for each candidate that keeps the graph planar
+          and NONEMBEDDABLE for each that does not
+
+ Returns OK on success, NONEMBEDDABLE if theGraph is not planar, in
+         which case every result is NONEMBEDDABLE, or NOTOK if an
+         endpoint is not a vertex of theGraph or on allocation failure
+ ********************************************************************/
+
+int  gp_TestEdgeInsertions(graphP theGraph, int numEdges, int *edgeEnds, int *results)
+{
+graphP theEmbedding = NULL, workGraph = NULL;
+embeddingFacesP theFaces = NULL;
+int  *component = NULL, *componentN = NULL, *componentM = NULL, *componentSimple = NULL, *faceStamp = NULL;
+edgeInsertionWorkspace ws;
+int  k, u, v, c, e, f, arcCapacity, haveWorkspace = FALSE, Result = OK;
+
+     if (theGraph == NULL || theGraph->N == 0 || numEdges < 0 ||
+         (numEdges > 0 && (edgeEnds == NULL || results == NULL)))
+         return NOTOK;
+
+     for (k = 0; k < 2*numEdges; k++)
+          if (edgeEnds[k] < gp_GetFirstVertex(theGraph) || !gp_VertexInRange(theGraph, edgeEnds[k]))
+              return NOTOK;
+
+     // Make the two copies, each with room for one more edge
+     arcCapacity = 2 * (theGraph->M + 1);
+     if (arcCapacity < theGraph->arcCapacity)
+         arcCapacity = theGraph->arcCapacity;
+
+     if ((theEmbedding = gp_New()) == NULL || (workGraph = gp_New()) == NULL ||
+         gp_EnsureArcCapacity(theEmbedding, arcCapacity) != OK ||
+         gp_EnsureArcCapacity(workGraph, arcCapacity) != OK ||
+         gp_InitGraph(theEmbedding, theGraph->N) != OK ||
+         gp_InitGraph(workGraph, theGraph->N) != OK ||
+         gp_CopyAdjacencyLists(theEmbedding, theGraph) != OK ||
+         gp_CopyAdjacencyLists(workGraph, theGraph) != OK)
+         Result = NOTOK;
+
+     // Embed the first copy, with the vertex numbering of theGraph
+     if (Result == OK)
+     {
+         Result = gp_Embed(theEmbedding, EMBEDFLAGS_PLANAR);
+         if (Result == OK && (theEmbedding->internalFlags & FLAGS_SORTEDBYDFI))
+             Result = gp_SortVertices(theEmbedding);
+     }
+
+     if (Result == NONEMBEDDABLE)
+     {
+         for (k = 0; k < numEdges; k++)
+              results[k] = NONEMBEDDABLE;
+     }
+
+     if (Result == OK)
+     {
+         if ((theFaces = gp_NewFaces()) == NULL ||
+             gp_GetFaces(theEmbedding, theFaces) != OK ||
+             (component = (int *) malloc(gp_PrimaryVertexIndexBound(theGraph) * sizeof(int))) == NULL ||
+             (componentN = (int *) calloc(gp_PrimaryVertexIndexBound(theGraph), sizeof(int))) == NULL ||
+             (componentM = (int *) calloc(gp_PrimaryVertexIndexBound(theGraph), sizeof(int))) == NULL ||
+             (componentSimple = (int *) malloc(gp_PrimaryVertexIndexBound(theGraph) * sizeof(int))) == NULL ||
+             (faceStamp = (int *) malloc((theFaces->numFaces + 1) * sizeof(int))) == NULL ||
+             _MarkComponents(theEmbedding, component, componentN, componentM, componentSimple) != OK)
+             Result = NOTOK;
+     }
+
+     if (Result == OK)
+     {
+         for (f = 0; f < theFaces->numFaces; f++)
+              faceStamp[f] = -1;
+
+         for (k = 0; k < numEdges && Result == OK; k++)
+         {
+              u = edgeEnds[2*k];
+              v = edgeEnds[2*k+1];
+              c = component[u];
+
+              results[k] = NOTOK;
+
+              if (u == v || c != component[v] || gp_IsNeighbor(theEmbedding, u, v))
+                  results[k] = OK;
+              else
+              {
+                  // Mark the faces of u, then look for one among the faces of v
+                  e = gp_GetFirstArc(theEmbedding, u);
+                  while (gp_IsArc(e))
+                  {
+                      faceStamp[theFaces->arcFace[e]] = k;
+                      e = gp_GetNextArc(theEmbedding, e);
+                  }
+
+                  e = gp_GetFirstArc(theEmbedding, v);
+                  while (gp_IsArc(e) && results[k] != OK)
+                  {
+                      if (faceStamp[theFaces->arcFace[e]] == k)
+                          results[k] = OK;
+                      e = gp_GetNextArc(theEmbedding, e);
+                  }
+              }
+
+              if (results[k] == OK)
+                  continue;
+
+              if (componentSimple[c] && componentN[c] >= 3 && componentM[c] == 3 * componentN[c] - 6)
+              {
+                  results[k] = NONEMBEDDABLE;
+                  continue;
+              }
+
+              // Decide a candidate in a biconnected component by its SPQR tree
+              if (!haveWorkspace)
+              {
+                  haveWorkspace = TRUE;
+                  if (_EI_InitWorkspace(&ws, theGraph, component, componentM) != OK)
+                  {
+                      Result = NOTOK;
+                      break;
+                  }
+              }
+
+              if (ws.componentTree[c] >= 0)
+              {
+                  if (_EI_TestEdge(&ws, u, v, &results[k]) != OK)
+                      Result = NOTOK;
+                  continue;
+              }
+
+              // Otherwise, embed the second copy with the edge added, then undo both
+              if (gp_BeginTransaction(workGraph) != OK)
+              {
+                  Result = NOTOK;
+                  break;
+              }
+
+              results[k] = gp_AddEdge(workGraph, u, 0, v, 0);
+              if (results[k] == OK)
+                  results[k] = gp_Embed(workGraph, EMBEDFLAGS_PLANAR);
+
+              if (gp_Rollback(workGraph) != OK || (results[k] != OK && results[k] != NONEMBEDDABLE))
+                  Result = NOTOK;
+         }
+     }
+
+     gp_Free(&theEmbedding);
+     gp_Free(&workGraph);
+     gp_FreeFaces(&theFaces);
+     if (component != NULL) free(component);
+     if (componentN != NULL) free(componentN);
+     if (componentM != NULL) free(componentM);
+     if (componentSimple != NULL) free(componentSimple);
+     if (faceStamp != NULL) free(faceStamp);
+     if (haveWorkspace) _EI_FreeWorkspace(&ws);
+
+     return Result;
+}
+
+/********************************************************************
+ _MarkComponents()
+
+ Numbers the connected components of theGraph from 0 and gives, for
+ each vertex, the component that contains it, and for each component,
+ its numbers of vertices and edges and whether it is simple, i.e. has
+ no loops or parallel edges.  Each component is searched breadth first,
+ and a vertex stamps its neighbors so that a neighbor seen twice shows a
+ parallel edge.
+
+ Returns OK on success, NOTOK on allocation failure
+ ********************************************************************/
+
+int  _MarkComponents(graphP theGraph, int *component, int *componentN, int *componentM, int *componentSimple)
+{
+int  *queue, *neighborStamp, head, tail, numComponents = 0, v, w, x, e;
+
+     if ((queue = (int *) malloc(gp_PrimaryVertexIndexBound(theGraph) * sizeof(int))) == NULL)
+         return NOTOK;
+     if ((neighborStamp = (int *) malloc(gp_PrimaryVertexIndexBound(theGraph) * sizeof(int))) == NULL)
+     {
+         free(queue);
+         return NOTOK;
+     }
+
+     for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
+     {
+          component[v] = -1;
+          neighborStamp[v] = NIL;
+     }
+
+     for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
+     {
+          if (component[v] != -1)
+              continue;
+
+          componentN[numComponents] = componentM[numComponents] = 0;
+          componentSimple[numComponents] = TRUE;
+
+          head = tail = 0;
+          queue[tail++] = v;
+          component[v] = numComponents;
+
+          while (head < tail)
+          {
+              w = queue[head++];
+              componentN[numComponents]++;
+
+              e = gp_GetFirstArc(theGraph, w);
+              while (gp_IsArc(e))
+              {
+                  x = gp_GetNeighbor(theGraph, e);
+
+                  // Each edge is seen from both ends, so count its even arc
+                  if ((e & 1) == 0)
+                      componentM[numComponents]++;
+
+                  if (x == w || neighborStamp[x] == w)
+                      componentSimple[numComponents] = FALSE;
+                  neighborStamp[x] = w;
+
+                  if (component[x] == -1)
+                  {
+                      component[x] = numComponents;
+                      queue[tail++] = x;
+                  }
+
+                  e = gp_GetNextArc(theGraph, e);
+              }
+          }
+
+          numComponents++;
+     }
+
+     free(queue);
+     free(neighborStamp);
+     return OK;
+}
+
+/********************************************************************
+ _EI_InitWorkspace()
+
+ Finds the SPQR trees of a copy of theGraph, roots each tree at its first
+ node, notes the nodes containing each vertex, and gives the tree of each
+ connected component of theGraph, numbered as given by _MarkComponents(),
+ that is a single biconnected block, i.e. whose tree has all of the
+ componentM[c] edges of the component.
+
+ Returns OK on success, NOTOK on failure, in which case ws is still to
+         be freed by _EI_FreeWorkspace()
+ ********************************************************************/
+
+int  _EI_InitWorkspace(edgeInsertionWorkspace *ws, graphP theGraph, int *component, int *componentM)
+{
+int  vertexBound = gp_PrimaryVertexIndexBound(theGraph);
+int  numTrees, numSkel = 0, t, first, count, i, j, k, head, tail, numReal, n, pass, x;
+int  ends[2], e, adjacent;
+
+     memset(ws, 0, sizeof(edgeInsertionWorkspace));
+
+     if ((ws->theGraph = gp_New()) == NULL ||
+         gp_EnsureArcCapacity(ws->theGraph, theGraph->arcCapacity) != OK ||
+         gp_InitGraph(ws->theGraph, theGraph->N) != OK ||
+         gp_CopyAdjacencyLists(ws->theGraph, theGraph) != OK ||
+         gp_SPQRTree(ws->theGraph) != OK)
+         return NOTOK;
+
+     numTrees = gp_SPQRTree_GetNumTrees(ws->theGraph);
+     ws->numNodes = gp_SPQRTree_GetNumNodes(ws->theGraph);
+     for (i = 0; i < ws->numNodes; i++)
+          numSkel += gp_SPQRTree_GetNumSkeletonEdges(ws->theGraph, i);
+
+     if ((ws->componentTree = (int *) malloc(vertexBound * sizeof(int))) == NULL ||
+         (ws->nodeParent = (int *) malloc((ws->numNodes + 1) * sizeof(int))) == NULL ||
+         (ws->nodeDepth = (int *) malloc((ws->numNodes + 1) * sizeof(int))) == NULL ||
+         (ws->nodeParentEdge = (int *) malloc((ws->numNodes + 1) * sizeof(int))) == NULL ||
+         (ws->nodeChildEdge = (int *) malloc((ws->numNodes + 1) * sizeof(int))) == NULL ||
+         (ws->nodeNumVertices = (int *) calloc(ws->numNodes + 1, sizeof(int))) == NULL ||
+         (ws->vertexFirst = (int *) calloc(vertexBound + 1, sizeof(int))) == NULL ||
+         (ws->vertexNode = (int *) malloc((2*numSkel + 1) * sizeof(int))) == NULL ||
+         (ws->vertexLocal = (int *) malloc((2*numSkel + 1) * sizeof(int))) == NULL ||
+         (ws->skeleton = (graphP *) calloc(ws->numNodes + 1, sizeof(graphP))) == NULL ||
+         (ws->skeletonFaces = (embeddingFacesP *) calloc(ws->numNodes + 1, sizeof(embeddingFacesP))) == NULL ||
+         (ws->markU = (int *) calloc(ws->numNodes + 1, sizeof(int))) == NULL ||
+         (ws->markV = (int *) calloc(ws->numNodes + 1, sizeof(int))) == NULL ||
+         (ws->pathA = (int *) malloc((ws->numNodes + 1) * sizeof(int))) == NULL ||
+         (ws->pathB = (int *) malloc((ws->numNodes + 1) * sizeof(int))) == NULL ||
+         (ws->localNum = (int *) calloc(vertexBound, sizeof(int))) == NULL ||
+         (ws->faceStamp = (int *) calloc(2*numSkel + 2, sizeof(int))) == NULL)
+         return NOTOK;
+
+     // Count the nodes containing each vertex in the first pass, then list
+     // them with the number of the vertex in each.  localNum[x] is the node
+     // in which x was last met, plus one.
+     for (pass = 0; pass < 2; pass++)
+     {
+          memset(ws->localNum, 0, vertexBound * sizeof(int));
+          for (i = 0; i < ws->numNodes; i++)
+          {
+               n = 0;
+               for (j = 0; j < gp_SPQRTree_GetNumSkeletonEdges(ws->theGraph, i); j++)
+               {
+                    gp_SPQRTree_GetSkeletonEdge(ws->theGraph, i, j, &ends[0], &ends[1], &e, &adjacent);
+                    for (k = 0; k < 2; k++)
+                    {
+                         x = ends[k];
+                         if (ws->localNum[x] == i + 1)
+                             continue;
+                         ws->localNum[x] = i + 1;
+                         n++;
+                         if (pass == 0)
+                             ws->vertexFirst[x+1]++;
+                         else
+                         {
+                             ws->vertexNode[ws->vertexFirst[x]] = i;
+                             ws->vertexLocal[ws->vertexFirst[x]++] = n;
+                         }
+                    }
+               }
+               ws->nodeNumVertices[i] = n;
+          }
+
+          // Turn the counts into starting positions, which the second pass
+          // advances to the end of each list, so shift them back after
+          if (pass == 0)
+          {
+              for (x = 1; x <= vertexBound; x++)
+                   ws->vertexFirst[x] += ws->vertexFirst[x-1];
+          }
+          else
+          {
+              for (x = vertexBound; x > 0; x--)
+                   ws->vertexFirst[x] = ws->vertexFirst[x-1];
+              ws->vertexFirst[0] = 0;
+          }
+     }
+     memset(ws->localNum, 0, vertexBound * sizeof(int));
+
+     // Root each tree at its first node by a breadth first search, using
+     // pathA as the queue, and count the edges of the graph in the tree
+     for (x = 0; x < vertexBound; x++)
+          ws->componentTree[x] = -1;
+
+     for (t = 0; t < numTrees; t++)
+     {
+          gp_SPQRTree_GetTreeNodes(ws->theGraph, t, &first, &count);
+          ws->nodeParent[first] = -1;
+          ws->nodeDepth[first] = 0;
+          ws->nodeParentEdge[first] = ws->nodeChildEdge[first] = -1;
+          ws->pathA[0] = first;
+          head = 0;
+          tail = 1;
+          numReal = 0;
+
+          while (head < tail)
+          {
+               i = ws->pathA[head++];
+               for (j = 0; j < gp_SPQRTree_GetNumSkeletonEdges(ws->theGraph, i); j++)
+               {
+                    gp_SPQRTree_GetSkeletonEdge(ws->theGraph, i, j, &ends[0], &ends[1], &e, &adjacent);
+                    if (adjacent < 0)
+                        numReal++;
+                    else if (adjacent == ws->nodeParent[i])
+                        ws->nodeParentEdge[i] = j;
+                    else
+                    {
+                        ws->nodeParent[adjacent] = i;
+                        ws->nodeDepth[adjacent] = ws->nodeDepth[i] + 1;
+                        ws->nodeChildEdge[adjacent] = j;
+                        ws->pathA[tail++] = adjacent;
+                    }
+               }
+          }
+
+          gp_SPQRTree_GetSkeletonEdge(ws->theGraph, first, 0, &ends[0], &ends[1], &e, &adjacent);
+          if (numReal == componentM[component[ends[0]]])
+              ws->componentTree[component[ends[0]]] = t;
+     }
+
+     return OK;
+}
+
+/********************************************************************
+ _EI_FreeWorkspace()
+ ********************************************************************/
+
+void _EI_FreeWorkspace(edgeInsertionWorkspace *ws)
+{
+int  i;
+
+     if (ws->skeleton != NULL)
+     {
+         for (i = 0; i < ws->numNodes; i++)
+              gp_Free(&ws->skeleton[i]);
+         free(ws->skeleton);
+     }
+
+     if (ws->skeletonFaces != NULL)
+     {
+         for (i = 0; i < ws->numNodes; i++)
+              gp_FreeFaces(&ws->skeletonFaces[i]);
+         free(ws->skeletonFaces);
+     }
+
+     gp_Free(&ws->theGraph);
+
+     if (ws->componentTree != NULL) free(ws->componentTree);
+     if (ws->nodeParent != NULL) free(ws->nodeParent);
+     if (ws->nodeDepth != NULL) free(ws->nodeDepth);
+     if (ws->nodeParentEdge != NULL) free(ws->nodeParentEdge);
+     if (ws->nodeChildEdge != NULL) free(ws->nodeChildEdge);
+     if (ws->nodeNumVertices != NULL) free(ws->nodeNumVertices);
+     if (ws->vertexFirst != NULL) free(ws->vertexFirst);
+     if (ws->vertexNode != NULL) free(ws->vertexNode);
+     if (ws->vertexLocal != NULL) free(ws->vertexLocal);
+     if (ws->markU != NULL) free(ws->markU);
+     if (ws->markV != NULL) free(ws->markV);
+     if (ws->pathA != NULL) free(ws->pathA);
+     if (ws->pathB != NULL) free(ws->pathB);
+     if (ws->localNum != NULL) free(ws->localNum);
+     if (ws->faceStamp != NULL) free(ws->faceStamp);
+
+     memset(ws, 0, sizeof(edgeInsertionWorkspace));
+}
+
+/********************************************************************
+ _EI_TestEdge()
+
+ Decides whether the distinct, nonadjacent vertices u and v, which are
+ in a connected component having an SPQR tree, can be joined by an edge
+ without losing planarity.  The nodes containing u, and those containing
+ v, form subtrees, so the path of the tree between a node containing u
+ and one containing v begins with nodes containing u and ends with nodes
+ containing v.  If some node contains both, then u and v must be on a
+ common face of it.  Otherwise, the part of the path from the last node
+ containing u to the first containing v is followed, and in each R-node
+ of it, an element is u, v or the virtual edge to the next or previous
+ node of the path, and the element by which the path enters must be on a
+ common face with the one by which it leaves.  An element is given as a
+ vertex number in the skeleton or, for skeleton edge j, as -(j+1).
+
+ Returns OK with *pResult set to OK or NONEMBEDDABLE, or NOTOK on failure
+ ********************************************************************/
+
+int  _EI_TestEdge(edgeInsertionWorkspace *ws, int u, int v, int *pResult)
+{
+int  lenA = 0, lenB = 0, a, b, len, p, q, index, i, entry, exit, cofacial = TRUE, k;
+
+     ws->stamp++;
+     for (k = ws->vertexFirst[u]; k < ws->vertexFirst[u+1]; k++)
+          ws->markU[ws->vertexNode[k]] = ws->stamp;
+     for (k = ws->vertexFirst[v]; k < ws->vertexFirst[v+1]; k++)
+          ws->markV[ws->vertexNode[k]] = ws->stamp;
+
+     // Find the path from a node containing u to one containing v, with
+     // the part from a up to the common ancestor in pathA and the part
+     // from b in pathB, then append pathB reversed to pathA
+     a = ws->vertexNode[ws->vertexFirst[u]];
+     b = ws->vertexNode[ws->vertexFirst[v]];
+     while (ws->nodeDepth[a] > ws->nodeDepth[b])
+     {
+          ws->pathA[lenA++] = a;
+          a = ws->nodeParent[a];
+     }
+     while (ws->nodeDepth[b] > ws->nodeDepth[a])
+     {
+          ws->pathB[lenB++] = b;
+          b = ws->nodeParent[b];
+     }
+     while (a != b)
+     {
+          ws->pathA[lenA++] = a;
+          a = ws->nodeParent[a];
+          ws->pathB[lenB++] = b;
+          b = ws->nodeParent[b];
+     }
+     ws->pathA[lenA++] = a;
+     len = lenA;
+     while (lenB > 0)
+          ws->pathA[len++] = ws->pathB[--lenB];
+
+     // Find the last node containing u and the first containing v
+     for (p = 0; p+1 < len && ws->markU[ws->pathA[p+1]] == ws->stamp; p++)
+          ;
+     for (q = len-1; q > 0 && ws->markV[ws->pathA[q-1]] == ws->stamp; q--)
+          ;
+
+     if (q <= p)
+     {
+         i = ws->pathA[q];
+         if (gp_SPQRTree_GetNodeType(ws->theGraph, i) == SPQRTREE_RNODE &&
+             _EI_Cofacial(ws, i, _EI_LocalVertex(ws, i, u), _EI_LocalVertex(ws, i, v), &cofacial) != OK)
+             return NOTOK;
+     }
+     else
+     {
+         for (index = p; index <= q && cofacial; index++)
+         {
+              i = ws->pathA[index];
+              if (gp_SPQRTree_GetNodeType(ws->theGraph, i) != SPQRTREE_RNODE)
+                  continue;
+
+              entry = index == p ? _EI_LocalVertex(ws, i, u) : -(_EI_VirtualEdge(ws, i, ws->pathA[index-1]) + 1);
+              exit = index == q ? _EI_LocalVertex(ws, i, v) : -(_EI_VirtualEdge(ws, i, ws->pathA[index+1]) + 1);
+
+              if (_EI_Cofacial(ws, i, entry, exit, &cofacial) != OK)
+                  return NOTOK;
+         }
+     }
+
+     *pResult = cofacial ? OK : NONEMBEDDABLE;
+     return OK;
+}
+
+/********************************************************************
+ _EI_VirtualEdge()
+ Returns the position in the skeleton of node i of the virtual edge
+ joining it to the neighboring node of the SPQR tree
+ ********************************************************************/
+
+int  _EI_VirtualEdge(edgeInsertionWorkspace *ws, int i, int neighbor)
+{
+     return ws->nodeParent[neighbor] == i ? ws->nodeChildEdge[neighbor] : ws->nodeParentEdge[i];
+}
+
+/********************************************************************
+ _EI_LocalVertex()
+ Returns the number of vertex v in the skeleton of node i, or NIL if the
+ skeleton does not contain v
+ ********************************************************************/
+
+int  _EI_LocalVertex(edgeInsertionWorkspace *ws, int i, int v)
+{
+int  k;
+
+     for (k = ws->vertexFirst[v]; k < ws->vertexFirst[v+1]; k++)
+          if (ws->vertexNode[k] == i)
+              return ws->vertexLocal[k];
+
+     return NIL;
+}
+
+/********************************************************************
+ _EI_EmbedRNode()
+
+ Embeds the skeleton of R-node i as a graph whose vertices are numbered
+ as in vertexLocal and whose edge j is skeleton edge j, and finds its
+ faces.  The skeleton is a minor of the planar graph, so it is planar.
+
+ Returns OK on success, NOTOK on failure
+ ********************************************************************/
+
+int  _EI_EmbedRNode(edgeInsertionWorkspace *ws, int i)
+{
+graphP theSkeleton;
+int  m = gp_SPQRTree_GetNumSkeletonEdges(ws->theGraph, i), n = 0, j, k, e, adjacent, ends[2];
+int  Result = OK;
+
+     if ((theSkeleton = ws->skeleton[i] = gp_New()) == NULL ||
+         gp_EnsureArcCapacity(theSkeleton, 2*m) != OK ||
+         gp_InitGraph(theSkeleton, ws->nodeNumVertices[i]) != OK)
+         return NOTOK;
+
+     // Number the vertices in the order met, as _EI_InitWorkspace() did
+     for (j = 0; j < m && Result == OK; j++)
+     {
+          gp_SPQRTree_GetSkeletonEdge(ws->theGraph, i, j, &ends[0], &ends[1], &e, &adjacent);
+          for (k = 0; k < 2; k++)
+               if (ws->localNum[ends[k]] == 0)
+                   ws->localNum[ends[k]] = ++n;
+
+          if (gp_AddEdge(theSkeleton, ws->localNum[ends[0]], 0, ws->localNum[ends[1]], 0) != OK)
+              Result = NOTOK;
+     }
+
+     for (j = 0; j < m; j++)
+     {
+          gp_SPQRTree_GetSkeletonEdge(ws->theGraph, i, j, &ends[0], &ends[1], &e, &adjacent);
+          ws->localNum[ends[0]] = ws->localNum[ends[1]] = 0;
+     }
+
+     if (Result == OK && gp_Embed(theSkeleton, EMBEDFLAGS_PLANAR) != OK)
+         Result = NOTOK;
+
+     if (Result == OK && (theSkeleton->internalFlags & FLAGS_SORTEDBYDFI))
+         Result = gp_SortVertices(theSkeleton);
+
+     if (Result == OK &&
+         ((ws->skeletonFaces[i] = gp_NewFaces()) == NULL ||
+          gp_GetFaces(theSkeleton, ws->skeletonFaces[i]) != OK))
+         Result = NOTOK;
+
+     return Result;
+}
+
+/********************************************************************
+ _EI_Cofacial()
+
+ Determines whether the elements x and y of the skeleton of R-node i,
+ each a vertex number or -(j+1) for skeleton edge j, are on a common
+ face of the embedding of the skeleton, by stamping the faces of x and
+ looking for a stamped face of y.
+
+ Returns OK with *pCofacial set, or NOTOK on failure
+ ********************************************************************/
+
+int  _EI_Cofacial(edgeInsertionWorkspace *ws, int i, int x, int y, int *pCofacial)
+{
+graphP theSkeleton;
+int  *arcFace, element, pass, e;
+
+     if (x == NIL || y == NIL)
+         return NOTOK;
+
+     if (ws->skeletonFaces[i] == NULL && _EI_EmbedRNode(ws, i) != OK)
+         return NOTOK;
+
+     theSkeleton = ws->skeleton[i];
+     arcFace = ws->skeletonFaces[i]->arcFace;
+     ws->stamp++;
+     *pCofacial = FALSE;
+
+     for (pass = 0; pass < 2 && !*pCofacial; pass++)
+     {
+          element = pass == 0 ? x : y;
+
+          if (element < 0)
+          {
+              e = gp_GetFirstEdge(theSkeleton) + 2 * (-element - 1);
+              if (pass == 0)
+                  ws->faceStamp[arcFace[e]] = ws->faceStamp[arcFace[gp_GetTwinArc(theSkeleton, e)]] = ws->stamp;
+              else
+                  *pCofacial = ws->faceStamp[arcFace[e]] == ws->stamp ||
+                               ws->faceStamp[arcFace[gp_GetTwinArc(theSkeleton, e)]] == ws->stamp;
+              continue;
+          }
+
+          e = gp_GetFirstArc(theSkeleton, element);
+          while (gp_IsArc(e) && !*pCofacial)
+          {
+              if (pass == 0)
+                  ws->faceStamp[arcFace[e]] = ws->stamp;
+              else if (ws->faceStamp[arcFace[e]] == ws->stamp)
+                  *pCofacial = TRUE;
+              e = gp_GetNextArc(theSkeleton, e);
+          }
+     }
+
+     return OK;
+}
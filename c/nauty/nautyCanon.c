@@ -0,0 +1,138 @@
+/*
+Planarity-Related Graph Algorithms Project
+Copyright (c) 1997-2010, John M. Boyer
+All rights reserved. Includes a reference implementation of the following:
+
+* John M. Boyer. "Simplified O(n) Algorithms for Planar Graph Embedding,
+  Kuratowski Subgraph Isolation, and Related Problems". Ph.D. Dissertation,
+  University of Victoria, 2001.
+
+* John M. Boyer and Wendy J. Myrvold. "On the Cutting Edge: Simplified O(n)
+  Planarity by Edge Addition". Journal of Graph Algorithms and Applications,
+  Vol. 8, No. 3, pp. 241-273, 2004.
+
+* John M. Boyer. "A New Method for Efficiently Generating Planar Graph
+  Visibility Representations". In P. Eades and P. Healy, editors,
+  Proceedings of the 13th International Conference on Graph Drawing 2005,
+  Lecture Notes Comput. Sci., Volume 3843, pp. 508-511, Springer-Verlag, 2006.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+  list of conditions and the following disclaimer in the documentation and/or
+  other materials provided with the distribution.
+
+* Neither the name of the Planarity-Related Graph Algorithms Project nor the names
+  of its contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/***********************************************************************
+ This file contains functions that connect McKay's nauty program with
+ planarity-related graph algorithm implementations, so that the
+ canonical labelling of nauty can be compared with the planar canonical
+ code of the graph library.
+ ***********************************************************************/
+
+#define EXTDEFS
+#include "naututil.h"
+
+#include "../graph.h"
+
+#include "nautyCanon.h"
+
+/***********************************************************************
+ nauty_GetMaxN()
+
+ Returns the largest number of vertices that nauty is compiled to handle
+ ***********************************************************************/
+
+int nauty_GetMaxN(void)
+{
+	return MAXN;
+}
+
+/***********************************************************************
+ nauty_CanonicalLabel()
+
+ Converts theGraph to the adjacency matrix form of nauty, which merges
+ multiple edges, and obtains its canonical labelling.  If canonLabel is
+ not NULL, then canonLabel[i] receives the vertex of theGraph that is
+ placed at position i by the canonical labelling.
+
+ The adjacency matrices and options belong to the call, and the
+ workspaces of the nauty() search are thread-local, so distinct threads
+ may call this function at the same time.
+
+ Returns OK on success, NOTOK if theGraph has more than MAXN vertices,
+ on allocation failure, or if nauty reports an error
+ ***********************************************************************/
+
+int nauty_CanonicalLabel(graphP theGraph, int *canonLabel)
+{
+	graph *g = NULL, *gcan = NULL;
+	DEFAULTOPTIONS(options);
+	nvector lab[MAXN], ptn[MAXN], orbits[MAXN];
+	setword workspace[50*MAXM];
+	statsblk stats;
+	int n = theGraph->N, m = (n + WORDSIZE - 1) / WORDSIZE;
+	int first = gp_GetFirstVertex(theGraph), EsizeOccupied, e, u, v, i;
+
+	if (n < 1 || n > MAXN)
+		return NOTOK;
+
+	if ((g = (graph *) malloc(n * m * sizeof(graph))) == NULL ||
+		(gcan = (graph *) malloc(n * m * sizeof(graph))) == NULL)
+	{
+		if (g != NULL) free(g);
+		return NOTOK;
+	}
+
+	for (i = 0; i < n; i++)
+		EMPTYSET(GRAPHROW(g, i, m), m);
+
+	EsizeOccupied = gp_EdgeInUseIndexBound(theGraph);
+	for (e = gp_GetFirstEdge(theGraph); e < EsizeOccupied; e += 2)
+	{
+		if (!gp_EdgeInUse(theGraph, e))
+			continue;
+
+		u = gp_GetNeighbor(theGraph, gp_GetTwinArc(theGraph, e)) - first;
+		v = gp_GetNeighbor(theGraph, e) - first;
+		ADDELEMENT(GRAPHROW(g, u, m), v);
+		ADDELEMENT(GRAPHROW(g, v, m), u);
+	}
+
+	options.writemarkers = FALSE;
+	options.writeautoms = FALSE;
+	options.getcanon = TRUE;
+
+	nauty(g, lab, ptn, NILSET, orbits, &options, &stats, workspace, 50*MAXM, m, n, gcan);
+
+	free(g);
+	free(gcan);
+
+	if (stats.errstatus != 0)
+		return NOTOK;
+
+	if (canonLabel != NULL)
+		for (i = 0; i < n; i++)
+			canonLabel[i] = lab[i] + first;
+
+	return OK;
+}
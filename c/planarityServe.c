@@ -0,0 +1,830 @@
+/*
+Planarity-Related Graph Algorithms Project
+Copyright (c) 1997-2012, John M. Boyer
+All rights reserved. Includes a reference implementation of the following:
+
+* John M. Boyer. "Subgraph Homeomorphism via the Edge Addition Planarity Algorithm".
+  Journal of Graph Algorithms and Applications, Vol. 16, no. 2, pp. 381-410, 2012.
+  http://www.jgaa.info/16/268.html
+
+* John M. Boyer. "A New Method for Efficiently Generating Planar Graph
+  Visibility Representations". In P. Eades and P. Healy, editors,
+  Proceedings of the 13th International Conference on Graph Drawing 2005,
+  Lecture Notes Comput. Sci., Volume 3843, pp. 508-511, Springer-Verlag, 2006.
+
+* John M. Boyer and Wendy J. Myrvold. "On the Cutting Edge: Simplified O(n)
+  Planarity by Edge Addition". Journal of Graph Algorithms and Applications,
+  Vol. 8, No. 3, pp. 241-273, 2004.
+  http://www.jgaa.info/08/91.html
+
+* John M. Boyer. "Simplified O(n) Algorithms for Planar Graph Embedding,
+  Kuratowski Subgraph Isolation, and Related Problems". Ph.D. Dissertation,
+  University of Victoria, 2001.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+  list of conditions and the following disclaimer in the documentation and/or
+  other materials provided with the distribution.
+
+* Neither the name of the Planarity-Related Graph Algorithms Project nor the names
+  of its contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "planarity.h"
+
+#ifdef WIN32
+#include <io.h>
+#include <fcntl.h>
+#else
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#endif
+
+/****************************************************************************
+ Service mode
+
+ 'planarity -serve [-q] [S]' runs the embedding algorithms on graphs that
+ are sent in binary frames, either on stdin and stdout or, if the path S
+ of a UNIX domain socket is given, on each connection made to S in turn.
+ Every integer in a frame is a 32-bit little-endian integer.
+
+ A request frame consists of
+     4 bytes: the command C, which is one of the characters in
+              SERVE_COMMANDS or 'x' to stop the server, the flags, and
+              two zero bytes
+     N, M:    the number of vertices and the number of edges
+     2M ints: the endpoints of each edge, with vertices numbered 0 to N-1
+ Loops and duplicate edges are ignored.
+
+ A response frame consists of
+     4 bytes: 'O' for OK, 'N' for NONEMBEDDABLE or 'X' for an error,
+              followed by three zero bytes
+     L:       the number of integers that follow
+     L ints:  the certificate, if the SERVE_CERTIFICATE flag was given
+ For an OK result of -p, -d or -o, the certificate is the embedding: the
+ degree of each vertex in order, followed by its neighbors in rotation
+ order.  For a NONEMBEDDABLE result other than of -d, it is the endpoints
+ of each edge of the obstruction, i.e. the Kuratowski subgraph, the
+ outerplanarity obstruction, or the homeomorph found by -2, -3, -4 or -5.
+ Otherwise, L is zero.
+
+ Graphs are kept in a pool with one graph per command and size class,
+ where the size class of a request is the least power of two that is at
+ least N.  A request is served by reinitializing the pool graph, which
+ has the algorithm extension already attached, and adding the edges in
+ one batch.  The vertices above N remain isolated, which does not change
+ the result.  So memory is allocated and extensions are attached once per
+ class rather than once per request, and no files are involved.
+
+ 'planarity -serveload [-q] C K N M S' is a load generator that sends K
+ random graphs with N vertices and M edges to the server at S, one at a
+ time, reports the round trip latencies, and checks each result and
+ certificate against running the algorithm in-process.
+ ****************************************************************************/
+
+#define SERVE_COMMANDS      "pdo2345"
+#define SERVE_NUMCOMMANDS   7
+#define SERVE_NUMCLASSES    27
+#define SERVE_MAXVERTICES   (1 << (SERVE_NUMCLASSES-1))
+#define SERVE_MAXEDGES      (1 << 26)
+
+#define SERVE_CERTIFICATE   1
+
+#define SERVE_RESULT_OK             'O'
+#define SERVE_RESULT_NONEMBEDDABLE  'N'
+#define SERVE_RESULT_ERROR          'X'
+
+typedef struct
+{
+	graphP pool[SERVE_NUMCOMMANDS][SERVE_NUMCLASSES];
+	int *ints, intsCapacity;
+	unsigned char *bytes;
+} serveContext;
+
+typedef serveContext * serveContextP;
+
+int  ServeStream(serveContextP context, FILE *infile, FILE *outfile, int *pStop);
+int  ServeRequest(serveContextP context, char command, int flags, int N, int M, int *pNumInts);
+graphP ServeGetPoolGraph(serveContextP context, char command, int N, int M);
+int  ServeEnsureCapacity(serveContextP context, int numInts);
+void ServeFreeContext(serveContextP context);
+int  ServeReadInts(serveContextP context, FILE *infile, int *values, int numInts);
+int  ServeEncodeInts(unsigned char *bytes, int *values, int numInts);
+int  ServeWriteResponse(serveContextP context, FILE *outfile, char result, int *values, int numInts);
+
+int  ServeCheckResponse(graphP origGraph, char command, int expectedResult, char result, int *values, int numInts);
+int  ServeCompareLatencies(const void *a, const void *b);
+
+#ifndef WIN32
+int  ServeSocketAddress(char *socketName, struct sockaddr_un *pAddress);
+#endif
+
+/****************************************************************************
+ ServeGraphs()
+ Serves requests on stdin and stdout if socketName is NULL, or else on the
+ connections to the UNIX domain socket socketName, until a request to stop
+ is received or, for stdin, until the end of input.
+ Returns OK, or NOTOK if the socket could not be served or if a frame on
+ stdin was malformed.
+ ****************************************************************************/
+
+int  ServeGraphs(char *socketName)
+{
+serveContext context;
+int  Result = OK, stop = FALSE;
+#ifndef WIN32
+struct sockaddr_un address;
+int  listener, connection;
+FILE *infile, *outfile;
+#endif
+
+	memset(&context, 0, sizeof(serveContext));
+	if (ServeEnsureCapacity(&context, 64) != OK)
+		return NOTOK;
+
+	if (socketName == NULL)
+	{
+#ifdef WIN32
+		_setmode(_fileno(stdin), _O_BINARY);
+		_setmode(_fileno(stdout), _O_BINARY);
+#endif
+		Result = ServeStream(&context, stdin, stdout, &stop);
+	}
+	else
+	{
+#ifdef WIN32
+		ErrorMessage("Serving on a UNIX domain socket is not supported on this platform.\n");
+		Result = NOTOK;
+#else
+		// A client that disconnects before its response is written must
+		// not terminate the server
+		signal(SIGPIPE, SIG_IGN);
+
+		if (ServeSocketAddress(socketName, &address) != OK ||
+			(listener = socket(AF_UNIX, SOCK_STREAM, 0)) < 0)
+		{
+			ErrorMessage("Unable to create the socket.\n");
+			ServeFreeContext(&context);
+			return NOTOK;
+		}
+
+		unlink(socketName);
+		if (bind(listener, (struct sockaddr *) &address, sizeof(address)) != 0 ||
+			listen(listener, 16) != 0)
+		{
+			ErrorMessage("Unable to listen on the socket.\n");
+			Result = NOTOK;
+		}
+		else
+		{
+			sprintf(Line, "Serving on %s\n", socketName);
+			Message(Line);
+			FlushConsole(stdout);
+		}
+
+		// Each connection is served until the client closes it; a
+		// malformed frame ends only the connection it arrived on
+		while (Result == OK && !stop)
+		{
+			if ((connection = accept(listener, NULL, NULL)) < 0)
+			{
+				if (errno != EINTR)
+					Result = NOTOK;
+				continue;
+			}
+
+			infile = fdopen(connection, "rb");
+			outfile = infile == NULL ? NULL : fdopen(dup(connection), "wb");
+
+			if (outfile != NULL)
+				ServeStream(&context, infile, outfile, &stop);
+
+			if (infile != NULL)
+				fclose(infile);
+			else
+				close(connection);
+			if (outfile != NULL)
+				fclose(outfile);
+		}
+
+		close(listener);
+		unlink(socketName);
+#endif
+	}
+
+	ServeFreeContext(&context);
+	return Result;
+}
+
+/****************************************************************************
+ ServeStream()
+ Serves the request frames read from infile, writing a response frame to
+ outfile for each, until the end of infile or a request to stop, which
+ sets *pStop to TRUE.
+ Returns OK at the end of infile or on a request to stop, NOTOK if a frame
+ was malformed such that the next frame cannot be found, or on an I/O error.
+ ****************************************************************************/
+
+int  ServeStream(serveContextP context, FILE *infile, FILE *outfile, int *pStop)
+{
+unsigned char header[4];
+int  sizes[2], N, M, k, numInts, Result;
+char command;
+
+	while (!*pStop)
+	{
+		if (fread(header, 1, 4, infile) != 4)
+			return OK;
+
+		command = (char) header[0];
+		if (command == 'x')
+		{
+			*pStop = TRUE;
+			return ServeWriteResponse(context, outfile, SERVE_RESULT_OK, NULL, 0);
+		}
+
+		if (ServeReadInts(context, infile, sizes, 2) != OK)
+			return NOTOK;
+
+		// If the sizes are unusable, then the end of the frame is unknown
+		N = sizes[0];
+		M = sizes[1];
+		if (N < 1 || N > SERVE_MAXVERTICES || M < 0 || M > SERVE_MAXEDGES ||
+			ServeEnsureCapacity(context, N + 2*M + 1) != OK)
+		{
+			ServeWriteResponse(context, outfile, SERVE_RESULT_ERROR, NULL, 0);
+			return NOTOK;
+		}
+
+		if (ServeReadInts(context, infile, context->ints, 2*M) != OK)
+			return NOTOK;
+
+		Result = command != 0 && strchr(SERVE_COMMANDS, command) != NULL ? OK : NOTOK;
+		for (k = 0; k < 2*M && Result == OK; k++)
+		{
+			if (context->ints[k] < 0 || context->ints[k] >= N)
+				Result = NOTOK;
+		}
+
+		numInts = 0;
+		if (Result == OK)
+			Result = ServeRequest(context, command, header[1], N, M, &numInts);
+
+		if (ServeWriteResponse(context, outfile,
+				Result == OK ? SERVE_RESULT_OK : (Result == NONEMBEDDABLE ? SERVE_RESULT_NONEMBEDDABLE : SERVE_RESULT_ERROR),
+				context->ints, Result == NOTOK ? 0 : numInts) != OK)
+			return NOTOK;
+	}
+
+	return OK;
+}
+
+/****************************************************************************
+ ServeRequest()
+ Runs the algorithm given by the command on the graph with N vertices whose
+ M edges have their endpoints in context->ints, numbered from 0, using a
+ graph from the pool.
+ If the flags request a certificate, then it is stored in context->ints,
+ replacing the edges, and its length is stored in *pNumInts.
+ Returns the result of gp_Embed(), or NOTOK on failure.
+ ****************************************************************************/
+
+int  ServeRequest(serveContextP context, char command, int flags, int N, int M, int *pNumInts)
+{
+graphP theGraph;
+int  *values = context->ints, first, v, e, k, degree, numInts = 0, Result;
+
+	*pNumInts = 0;
+	if ((theGraph = ServeGetPoolGraph(context, command, N, M)) == NULL)
+		return NOTOK;
+
+	first = gp_GetFirstVertex(theGraph);
+	for (k = 0; k < 2*M; k++)
+		values[k] += first;
+
+	if (gp_AddEdges(theGraph, M, values, ADDEDGES_SKIPLOOPS | ADDEDGES_SKIPDUPLICATES) != OK)
+		return NOTOK;
+
+	// Restore the original vertex numbering after embedding, as for -s
+	Result = gp_Embed(theGraph, GetEmbedFlags(command));
+	if (Result == NOTOK || gp_SortVertices(theGraph) != OK)
+		return NOTOK;
+
+	if (!(flags & SERVE_CERTIFICATE))
+		return Result;
+
+	// The embedding: each degree followed by the neighbors in rotation order
+	if (Result == OK && strchr("pdo", command) != NULL)
+	{
+		for (v = first; v < first + N; v++)
+		{
+			if (gp_GetNeighbors(theGraph, v, values + numInts + 1,
+					context->intsCapacity - numInts - 1, &degree) != OK)
+				return NOTOK;
+
+			values[numInts] = degree;
+			for (k = 1; k <= degree; k++)
+				values[numInts + k] -= first;
+			numInts += degree + 1;
+		}
+	}
+
+	// The obstruction: the endpoints of each edge remaining in the graph.
+	// As for -s, there is none for -d.
+	else if (Result == NONEMBEDDABLE && command != 'd')
+	{
+		for (e = gp_GetFirstEdge(theGraph); e < gp_EdgeInUseIndexBound(theGraph); e += 2)
+		{
+			if (gp_EdgeInUse(theGraph, e))
+			{
+				values[numInts++] = gp_GetNeighbor(theGraph, gp_GetTwinArc(theGraph, e)) - first;
+				values[numInts++] = gp_GetNeighbor(theGraph, e) - first;
+			}
+		}
+	}
+
+	*pNumInts = numInts;
+	return Result;
+}
+
+/****************************************************************************
+ ServeGetPoolGraph()
+ Returns the pool graph for the command and the size class of N, with no
+ edges and an arc capacity of at least 2M, making it if needed.
+ Returns NULL on allocation failure.
+ ****************************************************************************/
+
+graphP ServeGetPoolGraph(serveContextP context, char command, int N, int M)
+{
+graphP *pGraph;
+int  sizeClass = 0, arcCapacity;
+
+	while ((1 << sizeClass) < N)
+		sizeClass++;
+
+	pGraph = &context->pool[strchr(SERVE_COMMANDS, command) - SERVE_COMMANDS][sizeClass];
+
+	// A graph whose arc capacity is too small is replaced rather than grown,
+	// since not all extensions support growing the arc capacity
+	if (*pGraph != NULL && gp_GetArcCapacity(*pGraph) < 2*M)
+		gp_Free(pGraph);
+
+	if (*pGraph != NULL)
+	{
+		gp_ReinitializeGraph(*pGraph);
+		return *pGraph;
+	}
+
+	// The default capacity suffices for planar graphs, and it is doubled
+	// as needed for denser graphs so that replacements are infrequent
+	arcCapacity = 2 * DEFAULT_EDGE_LIMIT * (1 << sizeClass);
+	while (arcCapacity < 2*M)
+		arcCapacity *= 2;
+
+	if ((*pGraph = gp_New()) == NULL ||
+		gp_EnsureArcCapacity(*pGraph, arcCapacity) != OK ||
+		gp_InitGraph(*pGraph, 1 << sizeClass) != OK)
+	{
+		gp_Free(pGraph);
+		return NULL;
+	}
+
+	AttachAlgorithm(*pGraph, command);
+	return *pGraph;
+}
+
+/****************************************************************************
+ ServeEnsureCapacity()
+ Ensures that context->ints can hold numInts integers, and that
+ context->bytes can hold a frame with that many integers.
+ Returns OK, or NOTOK on allocation failure.
+ ****************************************************************************/
+
+int  ServeEnsureCapacity(serveContextP context, int numInts)
+{
+	if (context->intsCapacity >= numInts)
+		return OK;
+
+	if (context->ints != NULL)
+		free(context->ints);
+	if (context->bytes != NULL)
+		free(context->bytes);
+
+	context->ints = (int *) malloc(numInts * sizeof(int));
+	context->bytes = (unsigned char *) malloc(4 * (numInts + 2));
+	context->intsCapacity = context->ints != NULL && context->bytes != NULL ? numInts : 0;
+
+	return context->intsCapacity > 0 ? OK : NOTOK;
+}
+
+/****************************************************************************
+ ServeFreeContext()
+ ****************************************************************************/
+
+void ServeFreeContext(serveContextP context)
+{
+int  c, sizeClass;
+
+	for (c = 0; c < SERVE_NUMCOMMANDS; c++)
+		for (sizeClass = 0; sizeClass < SERVE_NUMCLASSES; sizeClass++)
+			gp_Free(&context->pool[c][sizeClass]);
+
+	if (context->ints != NULL)
+		free(context->ints);
+	if (context->bytes != NULL)
+		free(context->bytes);
+
+	memset(context, 0, sizeof(serveContext));
+}
+
+/****************************************************************************
+ ServeReadInts()
+ Reads numInts 32-bit little-endian integers from infile into values,
+ which must be able to hold them, as must context->bytes.
+ Returns OK, or NOTOK if infile ends first.
+ ****************************************************************************/
+
+int  ServeReadInts(serveContextP context, FILE *infile, int *values, int numInts)
+{
+unsigned char *bytes = context->bytes;
+int  k;
+
+	if (numInts > 0 && fread(bytes, 4, numInts, infile) != (size_t) numInts)
+		return NOTOK;
+
+	for (k = 0; k < numInts; k++, bytes += 4)
+		values[k] = (int) ((unsigned) bytes[0] | (unsigned) bytes[1] << 8 |
+				           (unsigned) bytes[2] << 16 | (unsigned) bytes[3] << 24);
+
+	return OK;
+}
+
+/****************************************************************************
+ ServeEncodeInts()
+ Stores numInts integers from values in bytes as 32-bit little-endian
+ integers.  Returns the number of bytes stored.
+ ****************************************************************************/
+
+int  ServeEncodeInts(unsigned char *bytes, int *values, int numInts)
+{
+int  k;
+
+	for (k = 0; k < numInts; k++, bytes += 4)
+	{
+		bytes[0] = (unsigned char) (values[k] & 0xFF);
+		bytes[1] = (unsigned char) ((values[k] >> 8) & 0xFF);
+		bytes[2] = (unsigned char) ((values[k] >> 16) & 0xFF);
+		bytes[3] = (unsigned char) ((values[k] >> 24) & 0xFF);
+	}
+
+	return 4 * numInts;
+}
+
+/****************************************************************************
+ ServeWriteResponse()
+ Writes a response frame with the result character and the numInts
+ integers in values to outfile, then flushes it.
+ Returns OK, or NOTOK on a write error.
+ ****************************************************************************/
+
+int  ServeWriteResponse(serveContextP context, FILE *outfile, char result, int *values, int numInts)
+{
+unsigned char *bytes = context->bytes;
+int  numBytes = 4;
+
+	bytes[0] = (unsigned char) result;
+	bytes[1] = bytes[2] = bytes[3] = 0;
+	numBytes += ServeEncodeInts(bytes + numBytes, &numInts, 1);
+	numBytes += ServeEncodeInts(bytes + numBytes, values, numInts);
+
+	if (fwrite(bytes, 1, numBytes, outfile) != (size_t) numBytes || fflush(outfile) != 0)
+		return NOTOK;
+
+	return OK;
+}
+
+/****************************************************************************
+ ServeLoadTest()
+ Connects to the server on the UNIX domain socket socketName and sends it
+ numRequests random graphs with N vertices and M edges, made as for -r,
+ one request at a time and each with a certificate requested.
+ The latency of a request is measured from the start of sending it to the
+ end of receiving its response.  Making each graph, and checking each
+ response against running the algorithm in-process, are not timed.
+ Returns OK if every response was correct, NOTOK otherwise.
+ ****************************************************************************/
+
+int  ServeLoadTest(char command, int numRequests, int N, int M, char *socketName)
+{
+#ifdef WIN32
+	ErrorMessage("The load generator requires UNIX domain sockets, which are not supported on this platform.\n");
+	return NOTOK;
+#else
+serveContext context;
+struct sockaddr_un address;
+graphP origGraph = NULL, theGraph = NULL;
+platform_walltime start, end;
+double *latencies = NULL, totalLatency = 0.0;
+unsigned char header[4];
+int  connection = -1, K, e, first, sizes[2], numEdges, numBytes, numInts;
+int  expectedResult, numNonembeddable = 0, Result = OK;
+FILE *infile = NULL, *outfile = NULL;
+
+	// The random graphs are simple, so M cannot exceed N(N-1)/2
+	if (command == 0 || strchr(SERVE_COMMANDS, command) == NULL || numRequests < 1 ||
+		N < 1 || N > SERVE_MAXVERTICES || M < 0 || M > SERVE_MAXEDGES ||
+		(double) M > (double) N * (N-1) / 2)
+	{
+		ErrorMessage("Invalid load test parameters.\n");
+		return NOTOK;
+	}
+
+	memset(&context, 0, sizeof(serveContext));
+	if (ServeEnsureCapacity(&context, N + 2*M + 1) != OK ||
+		(latencies = (double *) malloc(numRequests * sizeof(double))) == NULL)
+	{
+		ErrorMessage("Unable to allocate memory for the load test.\n");
+		ServeFreeContext(&context);
+		return NOTOK;
+	}
+
+	if (ServeSocketAddress(socketName, &address) != OK ||
+		(connection = socket(AF_UNIX, SOCK_STREAM, 0)) < 0 ||
+		connect(connection, (struct sockaddr *) &address, sizeof(address)) != 0 ||
+		(infile = fdopen(connection, "rb")) == NULL ||
+		(outfile = fdopen(dup(connection), "wb")) == NULL)
+	{
+		ErrorMessage("Unable to connect to the server.\n");
+		Result = NOTOK;
+	}
+
+	srand(time(NULL));
+
+	for (K = 0; K < numRequests && Result == OK; K++)
+	{
+		// Make the graph, and the result expected from the server
+		gp_Free(&origGraph);
+		gp_Free(&theGraph);
+
+		if ((origGraph = gp_New()) == NULL ||
+			gp_EnsureArcCapacity(origGraph, 2*M > 2*DEFAULT_EDGE_LIMIT*N ? 2*M : 2*DEFAULT_EDGE_LIMIT*N) != OK ||
+			gp_InitGraph(origGraph, N) != OK)
+		{
+			ErrorMessage("Unable to create the graph.\n");
+			Result = NOTOK;
+			break;
+		}
+
+		AttachAlgorithm(origGraph, command);
+
+		if (gp_CreateRandomGraphEx(origGraph, M) != OK ||
+			(theGraph = gp_DupGraph(origGraph)) == NULL)
+		{
+			ErrorMessage("Unable to create the graph.\n");
+			Result = NOTOK;
+			break;
+		}
+
+		expectedResult = gp_Embed(theGraph, GetEmbedFlags(command));
+
+		// Encode the request frame
+		first = gp_GetFirstVertex(origGraph);
+		numEdges = 0;
+		for (e = gp_GetFirstEdge(origGraph); e < gp_EdgeInUseIndexBound(origGraph); e += 2)
+		{
+			if (gp_EdgeInUse(origGraph, e))
+			{
+				context.ints[2*numEdges] = gp_GetNeighbor(origGraph, gp_GetTwinArc(origGraph, e)) - first;
+				context.ints[2*numEdges+1] = gp_GetNeighbor(origGraph, e) - first;
+				numEdges++;
+			}
+		}
+
+		context.bytes[0] = (unsigned char) command;
+		context.bytes[1] = SERVE_CERTIFICATE;
+		context.bytes[2] = context.bytes[3] = 0;
+		sizes[0] = N;
+		sizes[1] = numEdges;
+		numBytes = 4;
+		numBytes += ServeEncodeInts(context.bytes + numBytes, sizes, 2);
+		numBytes += ServeEncodeInts(context.bytes + numBytes, context.ints, 2*numEdges);
+
+		// Send the request and receive the response
+		platform_GetWallTime(start);
+		if (fwrite(context.bytes, 1, numBytes, outfile) != (size_t) numBytes || fflush(outfile) != 0 ||
+			fread(header, 1, 4, infile) != 4 ||
+			ServeReadInts(&context, infile, &numInts, 1) != OK ||
+			numInts < 0 || numInts > context.intsCapacity ||
+			ServeReadInts(&context, infile, context.ints, numInts) != OK)
+		{
+			ErrorMessage("The server did not respond.\n");
+			Result = NOTOK;
+			break;
+		}
+		platform_GetWallTime(end);
+
+		latencies[K] = platform_GetWallDuration(start, end);
+		totalLatency += latencies[K];
+
+		if (ServeCheckResponse(origGraph, command, expectedResult, (char) header[0], context.ints, numInts) != OK)
+		{
+			sprintf(Line, "The response to request %d was incorrect.\n", K+1);
+			ErrorMessage(Line);
+			Result = NOTOK;
+			break;
+		}
+
+		if (expectedResult == NONEMBEDDABLE)
+			numNonembeddable++;
+	}
+
+	if (Result == OK)
+	{
+		qsort(latencies, numRequests, sizeof(double), ServeCompareLatencies);
+
+		sprintf(Line, "Served %d requests with %d vertices and %d edges (%d OK, %d NONEMBEDDABLE) at %.1lf requests per second.\n",
+				numRequests, N, M, numRequests - numNonembeddable, numNonembeddable,
+				totalLatency > 0.0 ? numRequests / totalLatency : 0.0);
+		Message(Line);
+		sprintf(Line, "Latency in milliseconds: mean %.3lf, p50 %.3lf, p90 %.3lf, p99 %.3lf, max %.3lf.\n",
+				1000.0 * totalLatency / numRequests,
+				1000.0 * latencies[(int) (0.50 * (numRequests-1))],
+				1000.0 * latencies[(int) (0.90 * (numRequests-1))],
+				1000.0 * latencies[(int) (0.99 * (numRequests-1))],
+				1000.0 * latencies[numRequests-1]);
+		Message(Line);
+		Message("All results and certificates were verified.\n");
+	}
+
+	gp_Free(&origGraph);
+	gp_Free(&theGraph);
+	if (infile != NULL)
+		fclose(infile);
+	else if (connection >= 0)
+		close(connection);
+	if (outfile != NULL)
+		fclose(outfile);
+	free(latencies);
+	ServeFreeContext(&context);
+
+	return Result;
+#endif
+}
+
+/****************************************************************************
+ ServeCheckResponse()
+ Checks the response with the given result character and certificate to a
+ request for the command on origGraph, given the result of running the
+ algorithm in-process.
+ An embedding certificate must have exactly the edges of origGraph, and its
+ rotations must form as many faces as Euler's formula requires of a planar
+ embedding.  An obstruction certificate must consist of edges of origGraph;
+ it need not equal the in-process obstruction since the server graph has
+ its edges in a different order.
+ Returns OK if the response is correct, NOTOK otherwise.
+ ****************************************************************************/
+
+int  ServeCheckResponse(graphP origGraph, char command, int expectedResult, char result, int *values, int numInts)
+{
+graphP checkGraph = NULL;
+embeddingFacesP theFaces = NULL;
+int  *offsets = NULL, first = gp_GetFirstVertex(origGraph), N = origGraph->N;
+int  v, e, k, pos, degree, numArcs, numComponents, numEdgeComponents, Result = OK;
+
+	if (result != (expectedResult == OK ? SERVE_RESULT_OK :
+			(expectedResult == NONEMBEDDABLE ? SERVE_RESULT_NONEMBEDDABLE : SERVE_RESULT_ERROR)))
+		return NOTOK;
+
+	if (expectedResult == OK && strchr("pdo", command) != NULL)
+	{
+		// Compact the neighbor lists in place and build their offsets
+		if ((offsets = (int *) malloc((N+1) * sizeof(int))) == NULL)
+			return NOTOK;
+
+		for (v = 0, pos = 0, numArcs = 0; v < N && Result == OK; v++)
+		{
+			offsets[v] = numArcs;
+			degree = pos < numInts ? values[pos++] : -1;
+			if (degree < 0 || degree > numInts - pos)
+				Result = NOTOK;
+			else
+			{
+				for (k = 0; k < degree; k++)
+					values[numArcs++] = values[pos++];
+			}
+		}
+		offsets[N] = numArcs;
+
+		if (Result != OK || pos != numInts || numArcs != 2*origGraph->M ||
+			(checkGraph = gp_New()) == NULL ||
+			gp_InitGraphFromCSR(checkGraph, N, offsets, values) != OK ||
+			checkGraph->M != origGraph->M)
+			Result = NOTOK;
+
+		for (e = gp_GetFirstEdge(origGraph); Result == OK && e < gp_EdgeInUseIndexBound(origGraph); e += 2)
+		{
+			if (gp_EdgeInUse(origGraph, e) &&
+				!gp_IsNeighbor(checkGraph, gp_GetNeighbor(origGraph, gp_GetTwinArc(origGraph, e)), gp_GetNeighbor(origGraph, e)))
+				Result = NOTOK;
+		}
+
+		// With C components, of which C' have edges, V - E + F = C + C'
+		// counting the outer face of each component with edges once
+		if (Result == OK &&
+			((theFaces = gp_NewFaces()) == NULL ||
+			 gp_GetFaces(checkGraph, theFaces) != OK ||
+			 gp_CreateDFSTree(checkGraph) != OK))
+			Result = NOTOK;
+
+		if (Result == OK)
+		{
+			numComponents = numEdgeComponents = 0;
+			for (v = gp_GetFirstVertex(checkGraph); gp_VertexInRange(checkGraph, v); v++)
+			{
+				if (gp_IsDFSTreeRoot(checkGraph, v))
+				{
+					numComponents++;
+					if (gp_IsArc(gp_GetFirstArc(checkGraph, v)))
+						numEdgeComponents++;
+				}
+			}
+
+			if (N - checkGraph->M + theFaces->numFaces != numComponents + numEdgeComponents)
+				Result = NOTOK;
+		}
+
+		gp_FreeFaces(&theFaces);
+		gp_Free(&checkGraph);
+		free(offsets);
+	}
+
+	else if (expectedResult == NONEMBEDDABLE && command != 'd')
+	{
+		if (numInts == 0 || numInts % 2 != 0)
+			return NOTOK;
+
+		for (k = 0; k < numInts; k += 2)
+		{
+			if (values[k] < 0 || values[k] >= N || values[k+1] < 0 || values[k+1] >= N ||
+				!gp_IsNeighbor(origGraph, values[k] + first, values[k+1] + first))
+				return NOTOK;
+		}
+	}
+
+	else if (numInts != 0)
+		Result = NOTOK;
+
+	return Result;
+}
+
+/****************************************************************************
+ ServeCompareLatencies()
+ The qsort() comparison function for sorting latencies in ascending order.
+ ****************************************************************************/
+
+int  ServeCompareLatencies(const void *a, const void *b)
+{
+double x = *(const double *) a, y = *(const double *) b;
+
+	return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+#ifndef WIN32
+/****************************************************************************
+ ServeSocketAddress()
+ Fills *pAddress with the address of the UNIX domain socket socketName.
+ Returns OK, or NOTOK if the name is too long.
+ ****************************************************************************/
+
+int  ServeSocketAddress(char *socketName, struct sockaddr_un *pAddress)
+{
+	if (strlen(socketName) >= sizeof(pAddress->sun_path))
+		return NOTOK;
+
+	memset(pAddress, 0, sizeof(struct sockaddr_un));
+	pAddress->sun_family = AF_UNIX;
+	strcpy(pAddress->sun_path, socketName);
+
+	return OK;
+}
+#endif
@@ -1,227 +1,1588 @@
-/*
-Planarity-Related Graph Algorithms Project
-Copyright (c) 1997-2012, John M. Boyer
-All rights reserved. Includes a reference implementation of the following:
-
-* John M. Boyer. "Subgraph Homeomorphism via the Edge Addition Planarity Algorithm".
-  Journal of Graph Algorithms and Applications, Vol. 16, no. 2, pp. 381-410, 2012.
-  http://www.jgaa.info/16/268.html
-
-* John M. Boyer. "A New Method for Efficiently Generating Planar Graph
-  Visibility Representations". In P. Eades and P. Healy, editors,
-  Proceedings of the 13th International Conference on Graph Drawing 2005,
-  Lecture Notes Comput. Sci., Volume 3843, pp. 508-511, Springer-Verlag, 2006.
-
-* John M. Boyer and Wendy J. Myrvold. "On the Cutting Edge: Simplified O(n)
-  Planarity by Edge Addition". Journal of Graph Algorithms and Applications,
-  Vol. 8, No. 3, pp. 241-273, 2004.
-  http://www.jgaa.info/08/91.html
-
-* John M. Boyer. "Simplified O(n) Algorithms for Planar Graph Embedding,
-  Kuratowski Subgraph Isolation, and Related Problems". Ph.D. Dissertation,
-  University of Victoria, 2001.
-
-Redistribution and use in source and binary forms, with or without modification,
-are permitted provided that the following conditions are met:
-
-* Redistributions of source code must retain the above copyright notice, this
-  list of conditions and the following disclaimer.
-
-* Redistributions in binary form must reproduce the above copyright notice, this
-  list of conditions and the following disclaimer in the documentation and/or
-  other materials provided with the distribution.
-
-* Neither the name of the Planarity-Related Graph Algorithms Project nor the names
-  of its contributors may be used to endorse or promote products derived from this
-  software without specific prior written permission.
-
-THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
-AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
-IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
-DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
-ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
-(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
-LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
-ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
-(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
-SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
-*/
-
-#include "planarity.h"
-
-/****************************************************************************
- SpecificGraph()
- ****************************************************************************/
-
-int SpecificGraph(char command, char *infileName, char *outfileName, char *outfile2Name)
-{
-graphP theGraph, origGraph;
-platform_time start, end;
-int Result;
-
-    // Get the filename of the graph to test
-    if ((infileName = ConstructInputFilename(infileName)) == NULL)
-	    return NOTOK;
-
-    // Create the graph and, if needed, attach the correct algorithm to it
-    theGraph = gp_New();
-
-	switch (command)
-	{
-		case 'd' : gp_AttachDrawPlanar(theGraph); break;
-		case '2' : gp_AttachK23Search(theGraph); break;
-		case '3' : gp_AttachK33Search(theGraph); break;
-		case '4' : gp_AttachK4Search(theGraph); break;
-		case 'c' : gp_AttachColorVertices(theGraph); break;
-	}
-
-    // Read the graph into memory
-	Result = gp_Read(theGraph, infileName);
-	if (Result == NONEMBEDDABLE)
-	{
-		Message("The graph contains too many edges.\n");
-		// Some of the algorithms will still run correctly with some edges removed.
-		if (strchr("pdo234", command))
-		{
-			Message("Some edges were removed, but the algorithm will still run correctly.\n");
-			Result = OK;
-		}
-	}
-
-	// If there was an unrecoverable error, report it
-	if (Result != OK)
-		ErrorMessage("Failed to read graph\n");
-
-	// Otherwise, call the correct algorithm on it
-	else
-	{
-		// Copy the graph for integrity checking
-        origGraph = gp_DupGraph(theGraph);
-
-        // Run the algorithm
-        if (strchr("pdo234", command))
-        {
-    		int embedFlags = GetEmbedFlags(command);
-	        platform_GetTime(start);
-
-//	        gp_CreateDFSTree(theGraph);
-//	        gp_SortVertices(theGraph);
-//			gp_Write(theGraph, "debug.before.txt", WRITE_DEBUGINFO);
-//	        gp_SortVertices(theGraph);
-
-			Result = gp_Embed(theGraph, embedFlags);
-	        platform_GetTime(end);
-	        Result = gp_TestEmbedResultIntegrity(theGraph, origGraph, Result);
-        }
-        else
-        {
-	        platform_GetTime(start);
-        	if (command == 'c')
-        	{
-    			if ((Result = gp_ColorVertices(theGraph)) == OK)
-    				 Result = gp_ColorVerticesIntegrityCheck(theGraph, origGraph);
-        	}
-        	else
-    			Result = NOTOK;
-   	        platform_GetTime(end);
-        }
-
-        // Write what the algorithm determined and how long it took
-        WriteAlgorithmResults(theGraph, Result, command, start, end, infileName);
-
-        // Free the graph obtained for integrity checking.
-        gp_Free(&origGraph);
-	}
-
-	// Report an error, if there was one, free the graph, and return
-	if (Result != OK && Result != NONEMBEDDABLE)
-	{
-		ErrorMessage("AN ERROR HAS BEEN DETECTED\n");
-		Result = NOTOK;
-//		gp_Write(theGraph, "debug.after.txt", WRITE_DEBUGINFO);
-	}
-
-	// Provide the output file(s)
-	else
-	{
-        // Restore the vertex ordering of the original graph (undo DFS numbering)
-        if (strchr("pdo234", command))
-            gp_SortVertices(theGraph);
-
-        // Determine the name of the primary output file
-        outfileName = ConstructPrimaryOutputFilename(infileName, outfileName, command);
-
-        // For some algorithms, the primary output file is not always written
-        if ((strchr("pdo", command) && Result == NONEMBEDDABLE) ||
-        	(strchr("234", command) && Result == OK))
-        {
-        	// Do not write the file
-        }
-
-        // Write the primary output file, if appropriate to do so
-        else
-        {
-			gp_Write(theGraph, outfileName, WRITE_ADJLIST);
-        }
-
-        // NOW WE WANT TO WRITE THE SECONDARY OUTPUT FILE
-
-		// When called from the menu system, we want to write the planar or outerplanar
-		// obstruction, if one exists. For planar graph drawing, we want the character
-        // art rendition.  An empty but non-NULL string is passed to indicate the necessity
-        // of selecting a default name for the second output file.
-		if (outfile2Name != NULL)
-		{
-			if ((command == 'p' || command == 'o') && Result == NONEMBEDDABLE)
-			{
-				// By default, use the same name as the primary output filename
-				if (strlen(outfile2Name) == 0)
-				    outfile2Name = outfileName;
-				gp_Write(theGraph, outfile2Name, WRITE_ADJLIST);
-			}
-			else if (command == 'd' && Result == OK)
-			{
-				// By default, add ".render.txt" to the primary output filename
-				if (strlen(outfile2Name) == 0)
-   				    strcat((outfile2Name = outfileName), ".render.txt");
-				gp_DrawPlanar_RenderToFile(theGraph, outfile2Name);
-			}
-		}
-	}
-
-	// Free the graph
-	gp_Free(&theGraph);
-
-	// Flush any remaining message content to the user, and return the result
-    FlushConsole(stdout);
-	return Result;
-}
-
-/****************************************************************************
- WriteAlgorithmResults()
- ****************************************************************************/
-
-void WriteAlgorithmResults(graphP theGraph, int Result, char command, platform_time start, platform_time end, char *infileName)
-{
-	if (infileName)
-		 sprintf(Line, "The graph '%s' ", infileName);
-	else sprintf(Line, "The graph ");
-	Message(Line);
-
-	switch (command)
-	{
-		case 'p' : sprintf(Line, "is%s planar.\n", Result==OK ? "" : " not"); break;
-		case 'd' : sprintf(Line, "is%s planar.\n", Result==OK ? "" : " not"); break;
-		case 'o' : sprintf(Line, "is%s outerplanar.\n", Result==OK ? "" : " not"); break;
-		case '2' : sprintf(Line, "has %s subgraph homeomorphic to K_{2,3}.\n", Result==OK ? "no" : "a"); break;
-		case '3' : sprintf(Line, "has %s subgraph homeomorphic to K_{3,3}.\n", Result==OK ? "no" : "a"); break;
-		case '4' : sprintf(Line, "has %s subgraph homeomorphic to K_4.\n", Result==OK ? "no" : "a"); break;
-		case 'c' : sprintf(Line, "has been %d-colored.\n", gp_GetNumColorsUsed(theGraph)); break;
-		default  : sprintf(Line, "nas not been processed due to unrecognized command.\n"); break;
-	}
-	Message(Line);
-
-	sprintf(Line, "Algorithm '%s' executed in %.3lf seconds.\n",
-			GetAlgorithmName(command), platform_GetDuration(start,end));
-	Message(Line);
-}
+/*
+Planarity-Related Graph Algorithms Project
+Copyright (c) 1997-2012, John M. Boyer
+All rights reserved. Includes a reference implementation of the following:
+
+* John M. Boyer. "Subgraph Homeomorphism via the Edge Addition Planarity Algorithm".
+  Journal of Graph Algorithms and Applications, Vol. 16, no. 2, pp. 381-410, 2012.
+  http://www.jgaa.info/16/268.html
+
+* John M. Boyer. "A New Method for Efficiently Generating Planar Graph
+  Visibility Representations". In P. Eades and P. Healy, editors,
+  Proceedings of the 13th International Conference on Graph Drawing 2005,
+  Lecture Notes Comput. Sci., Volume 3843, pp. 508-511, Springer-Verlag, 2006.
+
+* John M. Boyer and Wendy J. Myrvold. "On the Cutting Edge: Simplified O(n)
+  Planarity by Edge Addition". Journal of Graph Algorithms and Applications,
+  Vol. 8, No. 3, pp. 241-273, 2004.
+  http://www.jgaa.info/08/91.html
+
+* John M. Boyer. "Simplified O(n) Algorithms for Planar Graph Embedding,
+  Kuratowski Subgraph Isolation, and Related Problems". Ph.D. Dissertation,
+  University of Victoria, 2001.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+  list of conditions and the following disclaimer in the documentation and/or
+  other materials provided with the distribution.
+
+* Neither the name of the Planarity-Related Graph Algorithms Project nor the names
+  of its contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "planarity.h"
+#include "nauty/nautyCanon.h"
+
+/****************************************************************************
+ SpecificGraph()
+ ****************************************************************************/
+
+int SpecificGraph(char command, char *infileName, char *outfileName, char *outfile2Name)
+{
+graphP theGraph, origGraph, theK23Graph=NULL;
+platform_time start, end;
+int Result, K23Result=OK, K4Result=OK;
+
+    // Get the filename of the graph to test
+    if ((infileName = ConstructInputFilename(infileName)) == NULL)
+	    return NOTOK;
+
+    // Create the graph and, if needed, attach the correct algorithm to it
+    theGraph = gp_New();
+
+	switch (command)
+	{
+		case 'd' : gp_AttachDrawPlanar(theGraph); break;
+		case '2' : gp_AttachK23Search(theGraph); break;
+		case '3' : gp_AttachK33Search(theGraph); break;
+		case '4' : gp_AttachK4Search(theGraph); break;
+		case 'f' : gp_AttachK4Search(theGraph); break;
+		case '5' : gp_AttachK5Search(theGraph); break;
+		case 'm' : gp_AttachMaxPlanarSubgraph(theGraph); break;
+		case 'j' : gp_AttachProjectivePlanarity(theGraph); break;
+		case 't' : gp_AttachToroidal(theGraph); break;
+		case 'c' : gp_AttachColorVertices(theGraph); break;
+		case 'e' : gp_AttachSPQRTree(theGraph); break;
+	}
+
+    // Read the graph into memory
+	Result = gp_Read(theGraph, infileName);
+	if (Result == NONEMBEDDABLE)
+	{
+		Message("The graph contains too many edges.\n");
+		// Some of the algorithms will still run correctly with some edges removed.
+		if (strchr("pdo2345f", command))
+		{
+			Message("Some edges were removed, but the algorithm will still run correctly.\n");
+			Result = OK;
+		}
+	}
+
+	// If there was an unrecoverable error, report it
+	if (Result != OK)
+		ErrorMessage("Failed to read graph\n");
+
+	// Otherwise, call the correct algorithm on it
+	else
+	{
+		// Copy the graph for integrity checking
+        origGraph = gp_DupGraph(theGraph);
+
+        // Run the algorithm
+        if (strchr("pdo2345mjt", command))
+        {
+    		int embedFlags = GetEmbedFlags(command);
+	        platform_GetTime(start);
+
+//	        gp_CreateDFSTree(theGraph);
+//	        gp_SortVertices(theGraph);
+//			gp_Write(theGraph, "debug.before.txt", WRITE_DEBUGINFO);
+//	        gp_SortVertices(theGraph);
+
+			Result = gp_Embed(theGraph, embedFlags);
+	        platform_GetTime(end);
+	        Result = gp_TestEmbedResultIntegrity(theGraph, origGraph, Result);
+        }
+        else if (command == 'f')
+        {
+        	// The K_{2,3} homeomorph, if any, is put in a second graph
+        	theK23Graph = gp_New();
+        	if (gp_AttachK23Search(theK23Graph) != OK ||
+        		gp_InitGraph(theK23Graph, theGraph->N) != OK)
+        		Result = NOTOK;
+        	else
+        	{
+    	        platform_GetTime(start);
+    	        if (gp_K4Search_SearchForK23AndK4(theGraph, theK23Graph, &Result, &K23Result, &K4Result) != OK)
+    	        	Result = NOTOK;
+    	        platform_GetTime(end);
+        	}
+
+        	if (Result != NOTOK)
+        	{
+        		if (gp_TestEmbedResultIntegrity(theGraph, origGraph, K4Result) != K4Result ||
+        			(K23Result == NONEMBEDDABLE &&
+        			 gp_TestEmbedResultIntegrity(theK23Graph, origGraph, K23Result) != K23Result))
+        			Result = NOTOK;
+        	}
+        }
+        else
+        {
+	        platform_GetTime(start);
+        	if (command == 'c')
+        	{
+    			if ((Result = gp_ColorVertices(theGraph)) == OK)
+    				 Result = gp_ColorVerticesIntegrityCheck(theGraph, origGraph);
+        	}
+        	else if (command == 'e')
+        	{
+    			if ((Result = gp_SPQRTree(theGraph)) == OK)
+    				 Result = gp_SPQRTreeIntegrityCheck(theGraph, origGraph);
+        	}
+        	else
+    			Result = NOTOK;
+   	        platform_GetTime(end);
+        }
+
+        // Write what the algorithm determined and how long it took, unless
+        // an error means that nothing was determined
+        if (Result == OK || Result == NONEMBEDDABLE)
+        {
+        	WriteAlgorithmResults(theGraph, Result, command, start, end, infileName);
+        	if (command == 'f')
+        	{
+        		sprintf(Line, "It has %s subgraph homeomorphic to K_{2,3} and %s subgraph homeomorphic to K_4.\n",
+        				K23Result == OK ? "no" : "a", K4Result == OK ? "no" : "a");
+        		Message(Line);
+        	}
+        }
+
+        // Free the graph obtained for integrity checking.
+        gp_Free(&origGraph);
+	}
+
+	// Report an error, if there was one, free the graph, and return
+	if (Result != OK && Result != NONEMBEDDABLE)
+	{
+		ErrorMessage("AN ERROR HAS BEEN DETECTED\n");
+		Result = NOTOK;
+//		gp_Write(theGraph, "debug.after.txt", WRITE_DEBUGINFO);
+	}
+
+	// Provide the output file(s)
+	else
+	{
+        // Restore the vertex ordering of the original graph (undo DFS numbering)
+        if (strchr("pdo2345mjt", command))
+            gp_SortVertices(theGraph);
+
+        // Determine the name of the primary output file
+        outfileName = ConstructPrimaryOutputFilename(infileName, outfileName, command);
+
+        // For some algorithms, the primary output file is not always written
+        if ((strchr("pdo", command) && Result == NONEMBEDDABLE) ||
+        	(strchr("2345", command) && Result == OK) ||
+        	(command == 'f' && K4Result == OK))
+        {
+        	// Do not write the file
+        }
+
+        // The primary output of the SPQR tree algorithm is the tree, not the graph
+        else if (command == 'e')
+        {
+			gp_SPQRTree_WriteTree(theGraph, outfileName);
+        }
+
+        // Write the primary output file, if appropriate to do so
+        else
+        {
+			gp_Write(theGraph, outfileName, WRITE_ADJLIST);
+        }
+
+        // NOW WE WANT TO WRITE THE SECONDARY OUTPUT FILE
+
+		// When called from the menu system, we want to write the planar or outerplanar
+		// obstruction, if one exists. For planar graph drawing, we want the character
+        // art rendition.  An empty but non-NULL string is passed to indicate the necessity
+        // of selecting a default name for the second output file.
+		if (outfile2Name != NULL)
+		{
+			if ((command == 'p' || command == 'o') && Result == NONEMBEDDABLE)
+			{
+				// By default, use the same name as the primary output filename
+				if (strlen(outfile2Name) == 0)
+				    outfile2Name = outfileName;
+				gp_Write(theGraph, outfile2Name, WRITE_ADJLIST);
+			}
+			else if (command == 'd' && Result == OK)
+			{
+				// By default, add ".render.txt" to the primary output filename
+				if (strlen(outfile2Name) == 0)
+   				    strcat((outfile2Name = outfileName), ".render.txt");
+				gp_DrawPlanar_RenderToFile(theGraph, outfile2Name);
+			}
+			else if (command == 't' && Result == OK)
+			{
+				// By default, add ".faces.txt" to the primary output filename
+				if (strlen(outfile2Name) == 0)
+   				    strcat((outfile2Name = outfileName), ".faces.txt");
+				gp_Toroidal_WriteFaces(theGraph, outfile2Name);
+			}
+			else if (command == '4' && Result == OK)
+			{
+				// By default, add ".sptree.txt" to the primary output filename
+				if (strlen(outfile2Name) == 0)
+   				    strcat((outfile2Name = outfileName), ".sptree.txt");
+				gp_K4Search_WriteSPTree(theGraph, outfile2Name);
+			}
+			else if (command == 'f' && K23Result == NONEMBEDDABLE)
+			{
+				// By default, add ".K23.txt" to the primary output filename
+				if (strlen(outfile2Name) == 0)
+   				    strcat((outfile2Name = outfileName), ".K23.txt");
+				gp_Write(theK23Graph, outfile2Name, WRITE_ADJLIST);
+			}
+		}
+	}
+
+	// Free the graph(s)
+	gp_Free(&theGraph);
+	gp_Free(&theK23Graph);
+
+	// Flush any remaining message content to the user, and return the result
+    FlushConsole(stdout);
+	return Result;
+}
+
+/****************************************************************************
+ BenchmarkGraph()
+ Reads the named graph and runs the benchmark selected by the command on it
+ the given number of times.  An algorithm command times that algorithm, and
+ the other commands each time one feature (see 'planarity -h -menu').
+ ****************************************************************************/
+
+int BenchmarkGraph(char command, char *infileName, int numRuns)
+{
+graphP origGraph;
+int Result;
+
+    if (!strchr("pdo2345mjtebfkuzxlnhiw", command) || numRuns < 1)
+    {
+    	ErrorMessage("Benchmarking is not supported for this command.\n");
+    	return NOTOK;
+    }
+
+    // Get the filename of the graph to test
+    if ((infileName = ConstructInputFilename(infileName)) == NULL)
+	    return NOTOK;
+
+    // Create the graph, attach the algorithm, and read the graph.
+    // The I/O benchmark uses the drawing so that extension data is written.
+    origGraph = gp_New();
+    AttachAlgorithm(origGraph, command == 'b' ? '3' : command == 'w' ? 'd' : command);
+	if (gp_Read(origGraph, infileName) != OK)
+	{
+		ErrorMessage("Failed to read graph\n");
+		gp_Free(&origGraph);
+		return NOTOK;
+	}
+
+	switch (command)
+	{
+		case 'b' : Result = BenchmarkK33SearchInBlocks(origGraph, numRuns); break;
+		case 'f' : Result = BenchmarkK23AndK4Search(origGraph, numRuns); break;
+		case 'k' : Result = BenchmarkPlanarCanonicalCode(origGraph, numRuns); break;
+		case 'u' : Result = BenchmarkDualGraph(origGraph, numRuns); break;
+		case 'z' : Result = BenchmarkCompressedEmbedding(origGraph, numRuns); break;
+		case 'x' : Result = BenchmarkCSR(origGraph, numRuns); break;
+		case 'l' : Result = BenchmarkAddEdges(origGraph, numRuns); break;
+		case 'n' : Result = BenchmarkEdgeIndex(origGraph, numRuns); break;
+		case 'h' : Result = BenchmarkConcurrentQueries(origGraph, numRuns); break;
+		case 'i' : Result = BenchmarkEdgeInsertions(origGraph, numRuns); break;
+		case 'w' : Result = BenchmarkGraphIO(origGraph, infileName, numRuns); break;
+		default  : Result = BenchmarkAlgorithm(origGraph, command, numRuns); break;
+	}
+
+	if (Result != OK && Result != NONEMBEDDABLE)
+		ErrorMessage("AN ERROR HAS BEEN DETECTED\n");
+
+	gp_Free(&origGraph);
+
+    FlushConsole(stdout);
+	return Result;
+}
+
+/****************************************************************************
+ BenchmarkAlgorithm()
+ Times the given number of runs of the algorithm given by the command on
+ fresh copies of origGraph, and checks the integrity of the last result.
+ ****************************************************************************/
+
+int BenchmarkAlgorithm(graphP origGraph, char command, int numRuns)
+{
+graphP theGraph=NULL;
+platform_time start, end;
+double embedTime = 0.0;
+int Result = OK, K;
+
+	// Time the algorithm, excluding the time to copy the graph
+	for (K = 0; K < numRuns && Result != NOTOK; K++)
+	{
+		gp_Free(&theGraph);
+		if ((theGraph = gp_DupGraph(origGraph)) == NULL)
+			Result = NOTOK;
+		else
+		{
+			platform_GetTime(start);
+			if (command == 'e')
+				Result = gp_SPQRTree(theGraph);
+			else
+				Result = gp_Embed(theGraph, GetEmbedFlags(command));
+			platform_GetTime(end);
+			embedTime += platform_GetDuration(start, end);
+		}
+	}
+
+	if (Result != NOTOK)
+	{
+		if (command == 'e')
+			Result = gp_SPQRTreeIntegrityCheck(theGraph, origGraph);
+		else
+			Result = gp_TestEmbedResultIntegrity(theGraph, origGraph, Result);
+	}
+
+	sprintf(Line, "Algorithm '%s' executed %d times in %.3lf seconds.\n",
+			GetAlgorithmName(command), numRuns, embedTime);
+	Message(Line);
+
+	gp_Free(&theGraph);
+	return Result;
+}
+
+/****************************************************************************
+ BenchmarkEmbedding()
+ Returns a planar embedding of a copy of origGraph, with the vertex numbering
+ of origGraph, for the benchmarks of features that work on an embedding.
+ *pResult receives OK, or NONEMBEDDABLE if origGraph is not planar, which is
+ reported, or NOTOK on error.  NULL is returned unless *pResult is OK.
+ ****************************************************************************/
+
+graphP BenchmarkEmbedding(graphP origGraph, int *pResult)
+{
+graphP theEmbedding;
+
+	if ((theEmbedding = gp_DupGraph(origGraph)) == NULL)
+		*pResult = NOTOK;
+	else if ((*pResult = gp_Embed(theEmbedding, EMBEDFLAGS_PLANAR)) == OK)
+		*pResult = gp_SortVertices(theEmbedding);
+
+	if (*pResult == NONEMBEDDABLE)
+		Message("The graph is not planar, so it has no embedding to benchmark.\n");
+
+	if (*pResult != OK)
+		gp_Free(&theEmbedding);
+
+	return theEmbedding;
+}
+
+/****************************************************************************
+ BenchmarkDualGraph()
+ Times the given number of runs of gp_BuildDualGraph() on a planar embedding
+ of origGraph.
+ ****************************************************************************/
+
+int BenchmarkDualGraph(graphP origGraph, int numRuns)
+{
+graphP theEmbedding, dualGraph=NULL;
+platform_time start, end;
+double dualTime = 0.0;
+int Result, K;
+
+	if ((theEmbedding = BenchmarkEmbedding(origGraph, &Result)) != NULL &&
+		(dualGraph = gp_New()) == NULL)
+		Result = NOTOK;
+
+	for (K = 0; K < numRuns && Result == OK; K++)
+	{
+		platform_GetTime(start);
+		Result = gp_BuildDualGraph(theEmbedding, dualGraph, NULL);
+		platform_GetTime(end);
+		dualTime += platform_GetDuration(start, end);
+	}
+
+	if (Result == OK)
+	{
+		sprintf(Line, "Planar dual with %d vertices and %d edges built %d times in %.3lf seconds.\n",
+				dualGraph->N, dualGraph->M, numRuns, dualTime);
+		Message(Line);
+	}
+
+	gp_Free(&dualGraph);
+	gp_Free(&theEmbedding);
+	return Result;
+}
+
+/****************************************************************************
+ BenchmarkCompressedEmbedding()
+ Times the given number of runs of gp_CompressEmbedding() on a planar
+ embedding of origGraph, then the same number of runs of decompressing the
+ result, and checks that the decompressed embedding is one of origGraph.
+ ****************************************************************************/
+
+int BenchmarkCompressedEmbedding(graphP origGraph, int numRuns)
+{
+graphP theEmbedding, decodedGraph=NULL;
+compressedEmbeddingP theCode=NULL;
+platform_time start, end;
+double encodeTime = 0.0, decodeTime = 0.0;
+int Result, K, offset;
+
+	if ((theEmbedding = BenchmarkEmbedding(origGraph, &Result)) != NULL &&
+		(theCode = gp_NewCompressedEmbedding()) == NULL)
+		Result = NOTOK;
+
+	for (K = 0; K < numRuns && Result == OK; K++)
+	{
+		theCode->length = 0;
+		platform_GetTime(start);
+		Result = gp_CompressEmbedding(theEmbedding, COMPRESS_KEEPLABELS, theCode);
+		platform_GetTime(end);
+		encodeTime += platform_GetDuration(start, end);
+	}
+
+	for (K = 0; K < numRuns && Result == OK; K++)
+	{
+		gp_Free(&decodedGraph);
+		offset = 0;
+		if ((decodedGraph = gp_New()) == NULL)
+			Result = NOTOK;
+		else
+		{
+			platform_GetTime(start);
+			Result = gp_DecompressEmbedding(decodedGraph, theCode, &offset);
+			platform_GetTime(end);
+			decodeTime += platform_GetDuration(start, end);
+		}
+	}
+
+	if (Result == OK)
+		Result = gp_TestEmbedResultIntegrity(decodedGraph, origGraph, OK);
+
+	if (Result == OK)
+	{
+		sprintf(Line, "Embedding compressed to %d bytes (%.2lf bits per edge) %d times in %.3lf seconds (%.2lf MB/s).\n",
+				theCode->length, theEmbedding->M > 0 ? 8.0 * theCode->length / theEmbedding->M : 0.0,
+				numRuns, encodeTime, encodeTime > 0.0 ? numRuns * theCode->length / encodeTime / 1e6 : 0.0);
+		Message(Line);
+		sprintf(Line, "Embedding decompressed %d times in %.3lf seconds (%.2lf MB/s).\n",
+				numRuns, decodeTime, decodeTime > 0.0 ? numRuns * theCode->length / decodeTime / 1e6 : 0.0);
+		Message(Line);
+	}
+
+	gp_FreeCompressedEmbedding(&theCode);
+	gp_Free(&decodedGraph);
+	gp_Free(&theEmbedding);
+	return Result;
+}
+
+/****************************************************************************
+ BenchmarkCSR()
+ Times the given number of runs of exporting a planar embedding of origGraph
+ to compressed sparse row form, then the same number of runs of importing
+ the rows into a new graph, and checks that the import exports the same rows.
+ ****************************************************************************/
+
+int BenchmarkCSR(graphP origGraph, int numRuns)
+{
+graphP theEmbedding, importedGraph=NULL;
+adjacencyCSRP theCSR=NULL, importedCSR=NULL;
+platform_time start, end;
+double exportTime = 0.0, importTime = 0.0, csrBytes;
+int Result, K;
+
+	if ((theEmbedding = BenchmarkEmbedding(origGraph, &Result)) != NULL &&
+		((theCSR = gp_NewCSR()) == NULL || (importedCSR = gp_NewCSR()) == NULL))
+		Result = NOTOK;
+
+	for (K = 0; K < numRuns && Result == OK; K++)
+	{
+		platform_GetTime(start);
+		Result = gp_ExportCSR(theEmbedding, CSR_ORIGINALLABELS, theCSR);
+		platform_GetTime(end);
+		exportTime += platform_GetDuration(start, end);
+	}
+
+	for (K = 0; K < numRuns && Result == OK; K++)
+	{
+		gp_Free(&importedGraph);
+		if ((importedGraph = gp_New()) == NULL)
+			Result = NOTOK;
+		else
+		{
+			platform_GetTime(start);
+			Result = gp_InitGraphFromCSR(importedGraph, theCSR->N, theCSR->offsets, theCSR->neighbors);
+			platform_GetTime(end);
+			importTime += platform_GetDuration(start, end);
+		}
+	}
+
+	if (Result == OK && (gp_ExportCSR(importedGraph, 0, importedCSR) != OK ||
+			importedCSR->numArcs != theCSR->numArcs ||
+			memcmp(importedCSR->neighbors, theCSR->neighbors, theCSR->numArcs * sizeof(int)) != 0))
+		Result = NOTOK;
+
+	if (Result == OK)
+	{
+		csrBytes = (double) numRuns * (theCSR->N + 1 + theCSR->numArcs) * sizeof(int);
+		sprintf(Line, "Compressed sparse row form exported %d times in %.3lf seconds (%.2lf MB/s).\n",
+				numRuns, exportTime, exportTime > 0.0 ? csrBytes / exportTime / 1e6 : 0.0);
+		Message(Line);
+		sprintf(Line, "Compressed sparse row form imported %d times in %.3lf seconds (%.2lf MB/s).\n",
+				numRuns, importTime, importTime > 0.0 ? csrBytes / importTime / 1e6 : 0.0);
+		Message(Line);
+	}
+
+	gp_FreeCSR(&theCSR);
+	gp_FreeCSR(&importedCSR);
+	gp_Free(&importedGraph);
+	gp_Free(&theEmbedding);
+	return Result;
+}
+
+/****************************************************************************
+ BenchmarkAddEdges()
+ Times the given number of runs of loading the edges of origGraph into an
+ empty graph as a batch with gp_AddEdges(), then the same number of runs of
+ loading them one at a time with gp_AddEdge().
+ ****************************************************************************/
+
+int BenchmarkAddEdges(graphP origGraph, int numRuns)
+{
+graphP theGraph=NULL;
+platform_time start, end;
+double batchTime = 0.0, singleTime = 0.0;
+int Result = OK, K, e, numEdges = 0, *edgeEnds;
+
+	if ((edgeEnds = (int *) malloc((2*origGraph->M+1) * sizeof(int))) == NULL)
+		return NOTOK;
+
+	for (e = gp_GetFirstEdge(origGraph); e < gp_EdgeInUseIndexBound(origGraph); e += 2)
+	{
+		if (gp_EdgeInUse(origGraph, e))
+		{
+			edgeEnds[2*numEdges] = gp_GetNeighbor(origGraph, gp_GetTwinArc(origGraph, e));
+			edgeEnds[2*numEdges+1] = gp_GetNeighbor(origGraph, e);
+			numEdges++;
+		}
+	}
+
+	for (K = 0; K < 2*numRuns && Result == OK; K++)
+	{
+		gp_Free(&theGraph);
+		if ((theGraph = gp_New()) == NULL ||
+			gp_EnsureArcCapacity(theGraph, gp_GetArcCapacity(origGraph)) != OK ||
+			gp_InitGraph(theGraph, origGraph->N) != OK)
+			Result = NOTOK;
+		else if (K < numRuns)
+		{
+			platform_GetTime(start);
+			Result = gp_AddEdges(theGraph, numEdges, edgeEnds, 0);
+			platform_GetTime(end);
+			batchTime += platform_GetDuration(start, end);
+		}
+		else
+		{
+			platform_GetTime(start);
+			for (e = 0; e < numEdges && Result == OK; e++)
+				Result = gp_AddEdge(theGraph, edgeEnds[2*e], 0, edgeEnds[2*e+1], 0);
+			platform_GetTime(end);
+			singleTime += platform_GetDuration(start, end);
+		}
+	}
+
+	if (Result == OK)
+	{
+		sprintf(Line, "Edges loaded %d times in %.3lf seconds (%.2lf million edges/s), versus %.3lf seconds one at a time.\n",
+				numRuns, batchTime, batchTime > 0.0 ? numRuns * (double) numEdges / batchTime / 1e6 : 0.0, singleTime);
+		Message(Line);
+	}
+
+	free(edgeEnds);
+	gp_Free(&theGraph);
+	return Result;
+}
+
+/****************************************************************************
+ BenchmarkEdgeIndex()
+ Times the given number of runs of neighbor queries about origGraph by
+ walking adjacency lists, then with an edge index attached, and checks that
+ the answers agree.  Each edge is queried from both endpoints, which costs
+ the most on graphs with high degree hubs, and each endpoint is also paired
+ with a vertex that is usually not adjacent to it.
+ ****************************************************************************/
+
+int BenchmarkEdgeIndex(graphP origGraph, int numRuns)
+{
+platform_time start, end;
+double walkTime = 0.0, indexTime = 0.0, attachTime = 0.0;
+int Result = OK, K, e, u, v, numHits, walkHits = 0, indexHits = 0;
+
+	for (K = 0; K < 2*numRuns && Result == OK; K++)
+	{
+		if (K == numRuns)
+		{
+			platform_GetTime(start);
+			Result = gp_AttachEdgeIndex(origGraph);
+			platform_GetTime(end);
+			attachTime = platform_GetDuration(start, end);
+			if (Result != OK)
+				break;
+		}
+
+		platform_GetTime(start);
+		for (e = gp_GetFirstEdge(origGraph); e < gp_EdgeInUseIndexBound(origGraph); e += 2)
+		{
+			if (gp_EdgeInUse(origGraph, e))
+			{
+				u = gp_GetNeighbor(origGraph, gp_GetTwinArc(origGraph, e));
+				v = gp_GetNeighbor(origGraph, e);
+				numHits = gp_IsNeighbor(origGraph, u, v) + gp_IsNeighbor(origGraph, v, u) +
+						  gp_IsNeighbor(origGraph, u, gp_GetFirstVertex(origGraph) + (e/2 + v) % origGraph->N) +
+						  gp_IsNeighbor(origGraph, v, gp_GetFirstVertex(origGraph) + (e/2 + u) % origGraph->N);
+				if (K < numRuns)
+					walkHits += numHits;
+				else
+					indexHits += numHits;
+			}
+		}
+		platform_GetTime(end);
+		if (K < numRuns)
+			walkTime += platform_GetDuration(start, end);
+		else
+			indexTime += platform_GetDuration(start, end);
+	}
+	gp_DetachEdgeIndex(origGraph);
+
+	if (Result == OK && walkHits != indexHits)
+	{
+		ErrorMessage("Neighbor queries with the edge index gave different answers.\n");
+		Result = NOTOK;
+	}
+
+	if (Result == OK)
+	{
+		sprintf(Line, "Neighbor queries made %d times in %.3lf seconds by walking adjacency lists, versus %.3lf seconds with an edge index (%.2lfx; index built in %.3lf seconds).\n",
+				numRuns, walkTime, indexTime, indexTime > 0.0 ? walkTime / indexTime : 0.0, attachTime);
+		Message(Line);
+	}
+
+	return Result;
+}
+
+/****************************************************************************
+ BenchmarkK23AndK4Search()
+ Times the given number of runs of the outerplanarity, K_{2,3} and K_4
+ algorithms on fresh copies of origGraph, then the same number of runs of
+ gp_K4Search_SearchForK23AndK4(), checks that the results agree, and
+ reports the speedup.  origGraph must have the K_4 search attached.
+ ****************************************************************************/
+
+int BenchmarkK23AndK4Search(graphP origGraph, int numRuns)
+{
+graphP theGraph=NULL, theK23Graph=NULL, templateGraph;
+platform_time start, end;
+double separateTime = 0.0, fusedTime = 0.0;
+char *commands = "o24";
+int Result = OK, results[3], fusedResults[3], i, K;
+
+	// Time each algorithm separately, excluding the time to copy the graph
+	for (i = 0; i < 3 && Result != NOTOK; i++)
+	{
+		templateGraph = gp_New();
+		AttachAlgorithm(templateGraph, commands[i]);
+		if (gp_EnsureArcCapacity(templateGraph, origGraph->arcCapacity) != OK ||
+			gp_InitGraph(templateGraph, origGraph->N) != OK ||
+			gp_CopyAdjacencyLists(templateGraph, origGraph) != OK)
+			Result = NOTOK;
+
+		for (K = 0; K < numRuns && Result != NOTOK; K++)
+		{
+			gp_Free(&theGraph);
+			if ((theGraph = gp_DupGraph(templateGraph)) == NULL)
+				Result = NOTOK;
+			else
+			{
+				platform_GetTime(start);
+				results[i] = gp_Embed(theGraph, GetEmbedFlags(commands[i]));
+				platform_GetTime(end);
+				separateTime += platform_GetDuration(start, end);
+
+				if (results[i] != OK && results[i] != NONEMBEDDABLE)
+					Result = NOTOK;
+			}
+		}
+
+		gp_Free(&templateGraph);
+	}
+
+	sprintf(Line, "Algorithms '%s', '%s' and '%s' executed %d times in %.3lf seconds.\n",
+			GetAlgorithmName('o'), GetAlgorithmName('2'), GetAlgorithmName('4'),
+			numRuns, separateTime);
+	Message(Line);
+
+	// Time the combined search
+	theK23Graph = gp_New();
+	if (gp_AttachK23Search(theK23Graph) != OK ||
+		gp_InitGraph(theK23Graph, origGraph->N) != OK)
+		Result = NOTOK;
+
+	for (K = 0; K < numRuns && Result != NOTOK; K++)
+	{
+		gp_Free(&theGraph);
+		if ((theGraph = gp_DupGraph(origGraph)) == NULL)
+			Result = NOTOK;
+		else
+		{
+			platform_GetTime(start);
+			if (gp_K4Search_SearchForK23AndK4(theGraph, theK23Graph,
+					&fusedResults[0], &fusedResults[1], &fusedResults[2]) != OK)
+				Result = NOTOK;
+			platform_GetTime(end);
+			fusedTime += platform_GetDuration(start, end);
+		}
+	}
+
+	if (Result != NOTOK)
+	{
+		if (fusedResults[0] != results[0] || fusedResults[1] != results[1] || fusedResults[2] != results[2])
+		{
+			ErrorMessage("The combined search obtained a different result.\n");
+			Result = NOTOK;
+		}
+		else if (gp_TestEmbedResultIntegrity(theGraph, origGraph, fusedResults[2]) != fusedResults[2] ||
+				 (fusedResults[1] == NONEMBEDDABLE &&
+				  gp_TestEmbedResultIntegrity(theK23Graph, origGraph, fusedResults[1]) != fusedResults[1]))
+			Result = NOTOK;
+		else
+		{
+			sprintf(Line, "Algorithm '%s' executed %d times in %.3lf seconds (speedup %.2lf).\n",
+					GetAlgorithmName('f'), numRuns, fusedTime,
+					fusedTime > 0.0 ? separateTime / fusedTime : 0.0);
+			Message(Line);
+			Result = fusedResults[0];
+		}
+	}
+
+	gp_Free(&theGraph);
+	gp_Free(&theK23Graph);
+
+	return Result;
+}
+
+/****************************************************************************
+ BenchmarkK33SearchInBlocks()
+ Times the given number of runs of the K_{3,3} search on fresh copies of
+ origGraph, which must have the K_{3,3} search attached, then the same
+ number of runs of gp_K33Search_SearchInBlocks(), first with one thread
+ and then with one thread per processor.  The elapsed real time of each
+ is reported with its speedup.  Each result is checked for integrity.
+ The two searches may disagree, because the K_{3,3} search can miss a
+ K_{3,3} homeomorph depending on the vertex order.  That is reported but
+ is not treated as an error.
+ ****************************************************************************/
+
+int BenchmarkK33SearchInBlocks(graphP origGraph, int numRuns)
+{
+graphP theGraph=NULL;
+platform_walltime start, end;
+double k33Time = 0.0, blockTime, singleTime = 0.0;
+int Result = OK, k33Result = OK, blockResult = OK, numThreads, numProcessors = platform_GetNumProcessors(), K;
+
+	for (K = 0; K < numRuns && Result == OK; K++)
+	{
+		gp_Free(&theGraph);
+		if ((theGraph = gp_DupGraph(origGraph)) == NULL)
+			Result = NOTOK;
+		else
+		{
+			platform_GetWallTime(start);
+			k33Result = gp_Embed(theGraph, EMBEDFLAGS_SEARCHFORK33);
+			platform_GetWallTime(end);
+			k33Time += platform_GetWallDuration(start, end);
+
+			if (gp_TestEmbedResultIntegrity(theGraph, origGraph, k33Result) != k33Result)
+				Result = NOTOK;
+		}
+	}
+
+	if (Result == OK)
+	{
+		sprintf(Line, "Algorithm '%s' executed %d times in %.3lf seconds (%s a K_{3,3}).\n",
+				GetAlgorithmName('3'), numRuns, k33Time,
+				k33Result == NONEMBEDDABLE ? "found" : "did not find");
+		Message(Line);
+	}
+
+	for (numThreads = 1; Result == OK; numThreads = numProcessors)
+	{
+		blockTime = 0.0;
+		for (K = 0; K < numRuns && Result == OK; K++)
+		{
+			gp_Free(&theGraph);
+			if ((theGraph = gp_DupGraph(origGraph)) == NULL)
+				Result = NOTOK;
+			else
+			{
+				platform_GetWallTime(start);
+				blockResult = gp_K33Search_SearchInBlocks(theGraph, numThreads);
+				platform_GetWallTime(end);
+				blockTime += platform_GetWallDuration(start, end);
+
+				if (blockResult == NOTOK ||
+					gp_TestEmbedResultIntegrity(theGraph, origGraph, blockResult) != blockResult)
+				{
+					ErrorMessage("The search by biconnected components failed its integrity check.\n");
+					Result = NOTOK;
+				}
+			}
+		}
+
+		if (Result != OK)
+			break;
+
+		if (numThreads == 1)
+			singleTime = blockTime;
+
+		sprintf(Line, "Search by biconnected components with %d thread%s executed %d times in %.3lf seconds (%s a K_{3,3}, speedup %.2lf).\n",
+				numThreads, numThreads > 1 ? "s" : "", numRuns, blockTime,
+				blockResult == NONEMBEDDABLE ? "found" : "did not find",
+				blockTime > 0.0 ? (numThreads == 1 ? k33Time : singleTime) / blockTime : 0.0);
+		Message(Line);
+
+		if (blockResult != k33Result)
+			Message("The search by biconnected components obtained a different result from the K_{3,3} search.\n");
+
+		if (numThreads >= numProcessors)
+			break;
+	}
+
+	gp_Free(&theGraph);
+	return Result == OK ? k33Result : NOTOK;
+}
+
+/****************************************************************************
+ BenchmarkConcurrentQueries()
+ Times read-only queries about a planar embedding of origGraph made by 1, 2,
+ 4 and 8 threads that share it without locking.  The vertices are divided into one block
+ per thread, and for each vertex in its block, a thread obtains the
+ neighbors in rotation order and walks the face of each arc, as far as its
+ scratch array of QUERYFACEMAXARCS arcs allows.  Each number of threads
+ makes the same queries numRuns times, and the totals of the answers must
+ agree with those of one thread.  The elapsed real time is reported, along
+ with the speedup over one thread, which depends on the number of
+ processors available.
+ ****************************************************************************/
+
+#define QUERYTHREADS_MAX 8
+#define QUERYFACEMAXARCS 64
+
+typedef struct
+{
+	constGraphP theEmbedding;
+	int firstVertex, lastVertex, numRuns, Result;
+	long answerTotal;
+} queryBenchmarkWork;
+
+platform_ThreadReturn BenchmarkQueryThread(void *work);
+
+int BenchmarkConcurrentQueries(graphP origGraph, int numRuns)
+{
+graphP theEmbedding;
+queryBenchmarkWork work[QUERYTHREADS_MAX];
+platform_thread threads[QUERYTHREADS_MAX];
+platform_walltime start, end;
+double elapsed, singleElapsed = 0.0, numQueries;
+long answerTotal, singleAnswerTotal = 0;
+int Result, numThreads, numStarted, t;
+
+	if ((theEmbedding = BenchmarkEmbedding(origGraph, &Result)) == NULL)
+		return Result;
+
+	// One neighbor query per vertex and one face walk per arc
+	numQueries = (double) numRuns * (theEmbedding->N + 2.0 * theEmbedding->M);
+
+	for (numThreads = 1; numThreads <= QUERYTHREADS_MAX && Result == OK; numThreads *= 2)
+	{
+		for (t = 0; t < numThreads; t++)
+		{
+			work[t].theEmbedding = theEmbedding;
+			work[t].firstVertex = gp_GetFirstVertex(theEmbedding) + (int) ((long) t * theEmbedding->N / numThreads);
+			work[t].lastVertex = gp_GetFirstVertex(theEmbedding) + (int) ((long) (t+1) * theEmbedding->N / numThreads) - 1;
+			work[t].numRuns = numRuns;
+			work[t].Result = OK;
+			work[t].answerTotal = 0;
+		}
+
+		platform_GetWallTime(start);
+		for (numStarted = 0; numStarted < numThreads; numStarted++)
+		{
+			if (!platform_StartThread(threads[numStarted], BenchmarkQueryThread, &work[numStarted]))
+			{
+				Result = NOTOK;
+				break;
+			}
+		}
+		for (t = 0; t < numStarted; t++)
+			platform_JoinThread(threads[t]);
+		platform_GetWallTime(end);
+		elapsed = platform_GetWallDuration(start, end);
+
+		answerTotal = 0;
+		for (t = 0; t < numStarted; t++)
+		{
+			if (work[t].Result != OK)
+				Result = NOTOK;
+			answerTotal += work[t].answerTotal;
+		}
+
+		if (Result != OK)
+			break;
+
+		if (numThreads == 1)
+		{
+			singleElapsed = elapsed;
+			singleAnswerTotal = answerTotal;
+		}
+		else if (answerTotal != singleAnswerTotal)
+		{
+			ErrorMessage("Concurrent queries about the embedding gave different answers.\n");
+			Result = NOTOK;
+			break;
+		}
+
+		sprintf(Line, "Read-only queries about the embedding made %d times by %d thread%s in %.3lf seconds (%.2lf million queries/s, %.2lfx).\n",
+				numRuns, numThreads, numThreads > 1 ? "s" : "", elapsed,
+				elapsed > 0.0 ? numQueries / elapsed / 1e6 : 0.0,
+				elapsed > 0.0 ? singleElapsed / elapsed : 0.0);
+		Message(Line);
+	}
+
+	gp_Free(&theEmbedding);
+	return Result;
+}
+
+platform_ThreadReturn BenchmarkQueryThread(void *workP)
+{
+queryBenchmarkWork *work = (queryBenchmarkWork *) workP;
+constGraphP theEmbedding = work->theEmbedding;
+int faceArcs[QUERYFACEMAXARCS], *neighbors, maxNeighbors, numNeighbors, numArcs, v, e, i, K;
+long answerTotal = 0;
+
+	// No vertex has more edge records than there are arcs
+	maxNeighbors = 2 * theEmbedding->M + 1;
+	if ((neighbors = (int *) malloc(maxNeighbors * sizeof(int))) == NULL)
+	{
+		work->Result = NOTOK;
+		return platform_ThreadReturnValue;
+	}
+
+	for (K = 0; K < work->numRuns && work->Result == OK; K++)
+	{
+		for (v = work->firstVertex; v <= work->lastVertex; v++)
+		{
+			if (gp_GetNeighbors(theEmbedding, v, neighbors, maxNeighbors, &numNeighbors) != OK)
+			{
+				work->Result = NOTOK;
+				break;
+			}
+
+			for (i = 0; i < numNeighbors; i++)
+				answerTotal += neighbors[i];
+
+			e = gp_GetFirstArc(theEmbedding, v);
+			while (gp_IsArc(e))
+			{
+				// A face longer than the scratch array is walked only partially
+				gp_WalkFace(theEmbedding, e, faceArcs, QUERYFACEMAXARCS, &numArcs);
+				answerTotal += numArcs + faceArcs[numArcs-1];
+				e = gp_GetNextArc(theEmbedding, e);
+			}
+		}
+	}
+
+	free(neighbors);
+	work->answerTotal = answerTotal;
+	return platform_ThreadReturnValue;
+}
+
+/****************************************************************************
+ BenchmarkGraphIO()
+ Times the given number of runs of writing a planar drawing of origGraph,
+ which has the drawing extension attached, with gp_Write() to a file beside
+ the input file and with gp_WriteToBuffer(), and of reading it back with
+ gp_Read() and gp_ReadFromBuffer(), so the drawing data is written and read
+ too.  Both graphs read must write the same text as the buffer.  To compare
+ with file I/O on tmpfs, put the input file there.
+ ****************************************************************************/
+
+int BenchmarkGraphIO(graphP origGraph, char *infileName, int numRuns)
+{
+graphP theEmbedding, theGraph=NULL;
+char *ioFileName, *buffer=NULL, *rereadBuffer=NULL;
+long bufferSize = 0, rereadSize;
+platform_time start, end;
+double writeFileTime = 0.0, writeBufferTime = 0.0, readFileTime = 0.0, readBufferTime = 0.0;
+int Result, K, pass;
+
+	// Write the drawing with the vertex numbering of the input graph
+	if ((theEmbedding = gp_DupGraph(origGraph)) == NULL)
+		return NOTOK;
+	if ((Result = gp_Embed(theEmbedding, EMBEDFLAGS_DRAWPLANAR)) == OK)
+		Result = gp_SortVertices(theEmbedding);
+	if (Result == NONEMBEDDABLE)
+		Message("The graph is not planar, so it has no embedding to benchmark.\n");
+
+	if (Result != OK || (ioFileName = (char *) malloc(strlen(infileName) + 16)) == NULL)
+	{
+		gp_Free(&theEmbedding);
+		return Result == OK ? NOTOK : Result;
+	}
+	sprintf(ioFileName, "%s.iobench.txt", infileName);
+
+	for (K = 0; K < numRuns && Result == OK; K++)
+	{
+		platform_GetTime(start);
+		Result = gp_Write(theEmbedding, ioFileName, WRITE_ADJLIST);
+		platform_GetTime(end);
+		writeFileTime += platform_GetDuration(start, end);
+	}
+
+	for (K = 0; K < numRuns && Result == OK; K++)
+	{
+		if (buffer != NULL)
+			free(buffer);
+		buffer = NULL;
+
+		platform_GetTime(start);
+		Result = gp_WriteToBuffer(theEmbedding, &buffer, &bufferSize, WRITE_ADJLIST);
+		platform_GetTime(end);
+		writeBufferTime += platform_GetDuration(start, end);
+	}
+
+	// Read back from the file in the first pass and from the buffer in the
+	// second, and check that what was read writes the same text again
+	for (pass = 0; pass < 2 && Result == OK; pass++)
+	{
+		for (K = 0; K < numRuns && Result == OK; K++)
+		{
+			gp_Free(&theGraph);
+			if ((theGraph = gp_New()) == NULL)
+			{
+				Result = NOTOK;
+				break;
+			}
+			gp_AttachDrawPlanar(theGraph);
+
+			platform_GetTime(start);
+			Result = pass == 0 ? gp_Read(theGraph, ioFileName) : gp_ReadFromBuffer(theGraph, buffer);
+			platform_GetTime(end);
+			if (pass == 0)
+				readFileTime += platform_GetDuration(start, end);
+			else
+				readBufferTime += platform_GetDuration(start, end);
+		}
+
+		if (Result == OK)
+			Result = gp_WriteToBuffer(theGraph, &rereadBuffer, &rereadSize, WRITE_ADJLIST);
+
+		if (Result == OK && (rereadSize != bufferSize || memcmp(rereadBuffer, buffer, bufferSize) != 0))
+		{
+			ErrorMessage(pass == 0 ? "The graph read from the file differs from the one written.\n"
+			                       : "The graph read from the buffer differs from the one written.\n");
+			Result = NOTOK;
+		}
+
+		if (rereadBuffer != NULL)
+			free(rereadBuffer);
+		rereadBuffer = NULL;
+	}
+
+	if (Result == OK)
+	{
+		sprintf(Line, "Embedding of %ld bytes written %d times in %.3lf seconds to a file, versus %.3lf seconds to a buffer (%.2lfx).\n",
+				bufferSize, numRuns, writeFileTime, writeBufferTime,
+				writeBufferTime > 0.0 ? writeFileTime / writeBufferTime : 0.0);
+		Message(Line);
+		sprintf(Line, "Embedding read %d times in %.3lf seconds from a file, versus %.3lf seconds from a buffer (%.2lfx).\n",
+				numRuns, readFileTime, readBufferTime,
+				readBufferTime > 0.0 ? readFileTime / readBufferTime : 0.0);
+		Message(Line);
+	}
+
+	remove(ioFileName);
+	free(ioFileName);
+	if (buffer != NULL)
+		free(buffer);
+	gp_Free(&theGraph);
+	gp_Free(&theEmbedding);
+
+	return Result;
+}
+
+/****************************************************************************
+ BenchmarkEdgeInsertions()
+ Times the given number of runs of gp_TestEdgeInsertions() on origGraph,
+ if it is planar, for a fixed set of candidate edges, then the same
+ number of runs of adding each candidate alone to a fresh copy of origGraph
+ and embedding it, checks that the answers agree, and reports the speedup.
+ Half of the candidates join two neighbors of a vertex and the rest join
+ vertices spread over the numbering.
+ ****************************************************************************/
+
+#define EDGEINSERTIONCANDIDATES 64
+
+int BenchmarkEdgeInsertions(graphP origGraph, int numRuns)
+{
+graphP theGraph=NULL;
+int edgeEnds[2*EDGEINSERTIONCANDIDATES], results[EDGEINSERTIONCANDIDATES];
+int K, k, u, v, e, N = origGraph->N, numPlanar = 0, Result;
+platform_time start, end;
+double batchTime = 0.0, singleTime = 0.0;
+
+	// The candidates are only tested against a planar graph
+	if ((theGraph = BenchmarkEmbedding(origGraph, &Result)) == NULL)
+		return Result;
+	gp_Free(&theGraph);
+
+	for (k = 0; k < EDGEINSERTIONCANDIDATES; k++)
+	{
+		u = gp_GetFirstVertex(origGraph) + (int) ((k * 7919L) % N);
+		v = gp_GetFirstVertex(origGraph) + (int) ((k * 104729L + N/2) % N);
+		if (k % 2 == 0 && gp_IsArc(e = gp_GetFirstArc(origGraph, u)))
+		{
+			v = gp_GetNeighbor(origGraph, gp_GetLastArc(origGraph, u));
+			u = gp_GetNeighbor(origGraph, e);
+		}
+		edgeEnds[2*k] = u;
+		edgeEnds[2*k+1] = v;
+	}
+
+	for (K = 0; K < numRuns && Result == OK; K++)
+	{
+		platform_GetTime(start);
+		Result = gp_TestEdgeInsertions(origGraph, EDGEINSERTIONCANDIDATES, edgeEnds, results);
+		platform_GetTime(end);
+		batchTime += platform_GetDuration(start, end);
+	}
+
+	for (K = 0; K < numRuns && Result == OK; K++)
+	{
+		numPlanar = 0;
+		platform_GetTime(start);
+		for (k = 0; k < EDGEINSERTIONCANDIDATES && Result == OK; k++)
+		{
+			u = edgeEnds[2*k];
+			v = edgeEnds[2*k+1];
+
+			// A loop or a parallel edge does not change planarity
+			if (u == v || gp_IsNeighbor(origGraph, u, v))
+			{
+				Result = OK;
+			}
+			else
+			{
+				if ((theGraph = gp_New()) == NULL ||
+					gp_EnsureArcCapacity(theGraph, 2 * (origGraph->M + 1) > origGraph->arcCapacity ?
+							                       2 * (origGraph->M + 1) : origGraph->arcCapacity) != OK ||
+					gp_InitGraph(theGraph, N) != OK ||
+					gp_CopyAdjacencyLists(theGraph, origGraph) != OK ||
+					gp_AddEdge(theGraph, u, 0, v, 0) != OK)
+					Result = NOTOK;
+				else
+					Result = gp_Embed(theGraph, EMBEDFLAGS_PLANAR);
+				gp_Free(&theGraph);
+			}
+
+			if (Result == OK)
+				numPlanar++;
+			if (Result != NOTOK && Result != results[k])
+			{
+				ErrorMessage("Testing edge insertions together gave a different answer.\n");
+				Result = NOTOK;
+			}
+			else if (Result == NONEMBEDDABLE)
+				Result = OK;
+		}
+		platform_GetTime(end);
+		singleTime += platform_GetDuration(start, end);
+	}
+
+	if (Result == OK)
+	{
+		sprintf(Line, "Edge insertions tested %d times for %d candidate edges (%d keep the graph planar) in %.3lf seconds, versus %.3lf seconds embedding a copy for each (%.2lfx).\n",
+				numRuns, EDGEINSERTIONCANDIDATES, numPlanar, batchTime, singleTime,
+				batchTime > 0.0 ? singleTime / batchTime : 0.0);
+		Message(Line);
+	}
+
+	return Result;
+}
+
+/****************************************************************************
+ BenchmarkPlanarCanonicalCode()
+ Times the given number of runs of gp_PlanarCanonicalCode() on origGraph,
+ checks that a randomly relabelled copy of origGraph gets the same code,
+ then times the same number of runs of the canonical labelling of nauty,
+ which is limited to graphs with at most nauty_GetMaxN() vertices.
+ ****************************************************************************/
+
+int BenchmarkPlanarCanonicalCode(graphP origGraph, int numRuns)
+{
+graphP relabeledGraph=NULL;
+planarCanonicalCodeP theCode, relabeledCode;
+platform_time start, end;
+double codeTime = 0.0, nautyTime = 0.0;
+int *perm=NULL, Result = OK, N = origGraph->N, EsizeOccupied, e, u, v, t, K;
+
+	theCode = gp_NewCanonicalCode();
+	relabeledCode = gp_NewCanonicalCode();
+	if (theCode == NULL || relabeledCode == NULL)
+		Result = NOTOK;
+
+	for (K = 0; K < numRuns && Result == OK; K++)
+	{
+		platform_GetTime(start);
+		Result = gp_PlanarCanonicalCode(origGraph, theCode);
+		platform_GetTime(end);
+		codeTime += platform_GetDuration(start, end);
+	}
+
+	if (Result == NONEMBEDDABLE)
+		Message("The graph is not planar, so it has no planar canonical code.\n");
+
+	if (Result == OK)
+	{
+		sprintf(Line, "Algorithm '%s' executed %d times in %.3lf seconds, giving a code of %d bytes.\n",
+				GetAlgorithmName('k'), numRuns, codeTime, theCode->codeLength);
+		Message(Line);
+
+		// Relabel the vertices with a random permutation
+		if ((perm = (int *) malloc((N+1) * sizeof(int))) == NULL ||
+			(relabeledGraph = gp_New()) == NULL ||
+			(origGraph->M > 0 && gp_EnsureArcCapacity(relabeledGraph, 2*origGraph->M) != OK) ||
+			gp_InitGraph(relabeledGraph, N) != OK)
+			Result = NOTOK;
+	}
+
+	if (Result == OK)
+	{
+		for (u = 0; u <= N; u++)
+			perm[u] = u;
+		for (u = N; u > 1; u--)
+		{
+			v = 1 + rand() % u;
+			t = perm[u]; perm[u] = perm[v]; perm[v] = t;
+		}
+
+		EsizeOccupied = gp_EdgeInUseIndexBound(origGraph);
+		for (e = gp_GetFirstEdge(origGraph); e < EsizeOccupied && Result == OK; e += 2)
+		{
+			if (gp_EdgeInUse(origGraph, e))
+				Result = gp_AddEdge(relabeledGraph, perm[gp_GetNeighbor(origGraph, gp_GetTwinArc(origGraph, e))], 0,
+													perm[gp_GetNeighbor(origGraph, e)], 0);
+		}
+
+		if (Result == OK)
+			Result = gp_PlanarCanonicalCode(relabeledGraph, relabeledCode);
+
+		if (Result == OK && (relabeledCode->codeLength != theCode->codeLength ||
+			memcmp(relabeledCode->code, theCode->code, theCode->codeLength) != 0))
+		{
+			ErrorMessage("A relabelled copy of the graph obtained a different canonical code.\n");
+			Result = NOTOK;
+		}
+	}
+
+	// Time the canonical labelling of nauty
+	if (Result == OK)
+	{
+		if (N > nauty_GetMaxN())
+		{
+			sprintf(Line, "The canonical labelling of nauty was not run because it is limited to %d vertices.\n",
+					nauty_GetMaxN());
+			Message(Line);
+		}
+		else
+		{
+			for (K = 0; K < numRuns && Result == OK; K++)
+			{
+				platform_GetTime(start);
+				Result = nauty_CanonicalLabel(origGraph, NULL);
+				platform_GetTime(end);
+				nautyTime += platform_GetDuration(start, end);
+			}
+
+			if (Result == OK)
+			{
+				sprintf(Line, "Canonical labelling by nauty executed %d times in %.3lf seconds (speedup %.2lf).\n",
+						numRuns, nautyTime, codeTime > 0.0 ? nautyTime / codeTime : 0.0);
+				Message(Line);
+			}
+		}
+	}
+
+	if (perm != NULL)
+		free(perm);
+	gp_Free(&relabeledGraph);
+	gp_FreeCanonicalCode(&theCode);
+	gp_FreeCanonicalCode(&relabeledCode);
+
+	return Result;
+}
+
+/****************************************************************************
+ TraceGraph()
+ Runs the embedding algorithm given by the command on the named graph with
+ a trace recorder attached, checks the result, and writes the timeline of
+ the embedding phases to traceFileName in the Chrome trace event format,
+ so that the slow vertex steps of a pathological input can be inspected
+ in chrome://tracing or the Perfetto UI.
+ ****************************************************************************/
+
+int TraceGraph(char command, char *infileName, char *traceFileName)
+{
+graphP theGraph, origGraph;
+platform_time start, end;
+int Result, capacity;
+
+    if (!strchr("pdo2345mjt", command))
+    {
+    	ErrorMessage("Tracing is only supported for the embedding algorithms.\n");
+    	return NOTOK;
+    }
+
+    // Get the filename of the graph to trace
+    if ((infileName = ConstructInputFilename(infileName)) == NULL)
+	    return NOTOK;
+
+    // Create the graph, attach the algorithm, and read the graph
+    origGraph = gp_New();
+    AttachAlgorithm(origGraph, command);
+	if (gp_Read(origGraph, infileName) != OK)
+	{
+		ErrorMessage("Failed to read graph\n");
+		gp_Free(&origGraph);
+		return NOTOK;
+	}
+
+	// Embed a copy with the trace attached, so the copy is not traced.  About a
+	// dozen events per vertex are recorded for core planarity, so that many are
+	// kept in order to see the whole run rather than only its last steps.
+	capacity = 12 * origGraph->N;
+	if ((theGraph = gp_DupGraph(origGraph)) == NULL ||
+		gp_AttachTrace(theGraph, capacity > TRACE_DEFAULTCAPACITY ? capacity : 0) != OK)
+	{
+		ErrorMessage("Failed to create the graph to trace\n");
+		gp_Free(&theGraph);
+		gp_Free(&origGraph);
+		return NOTOK;
+	}
+
+	platform_GetTime(start);
+	Result = gp_Embed(theGraph, GetEmbedFlags(command));
+	platform_GetTime(end);
+
+	Result = gp_TestEmbedResultIntegrity(theGraph, origGraph, Result);
+
+	if (Result == NOTOK)
+		ErrorMessage("Failed to embed the graph or to verify the result.\n");
+
+	if (gp_WriteTrace(theGraph, traceFileName) != OK)
+	{
+		ErrorMessage("Failed to write the trace file\n");
+		Result = NOTOK;
+	}
+	else
+	{
+		sprintf(Line, "Algorithm '%s' traced in %.3lf seconds; trace written to %s.\n",
+				GetAlgorithmName(command), platform_GetDuration(start, end), traceFileName);
+		Message(Line);
+	}
+
+	gp_Free(&theGraph);
+	gp_Free(&origGraph);
+    FlushConsole(stdout);
+
+	return Result;
+}
+
+/****************************************************************************
+ PartitionGraph()
+ Embeds the named graph and, if it is planar, partitions its vertices into
+ numParts parts with gp_PlanarPartition().  Reports the time taken, the
+ number of separator vertices found by the recursive bisection, the sizes
+ of the smallest and largest parts and the number of edges cut.  If
+ outfileName is given, then it receives one line per vertex giving the
+ vertex and its part.
+ ****************************************************************************/
+
+int PartitionGraph(int numParts, char *infileName, char *outfileName)
+{
+graphP theGraph;
+platform_time start, end;
+int *vertexPart=NULL, *partSize=NULL;
+int Result, v, e, K, numSeparator=0, minPart, maxPart, edgeCut=0;
+FILE *outfile;
+
+    if (numParts < 1)
+    {
+    	ErrorMessage("The number of parts must be at least 1.\n");
+    	return NOTOK;
+    }
+
+    // Get the filename of the graph to partition
+    if ((infileName = ConstructInputFilename(infileName)) == NULL)
+	    return NOTOK;
+
+    theGraph = gp_New();
+	if (gp_Read(theGraph, infileName) != OK)
+	{
+		ErrorMessage("Failed to read graph\n");
+		gp_Free(&theGraph);
+		return NOTOK;
+	}
+
+	// The partitioner works on the planar embedding, which is put back
+	// into the original vertex order so the part ids can be reported
+	Result = gp_Embed(theGraph, EMBEDFLAGS_PLANAR);
+	if (Result == NONEMBEDDABLE)
+		ErrorMessage("The graph is not planar, so it cannot be partitioned.\n");
+	else if (Result == OK)
+		Result = gp_SortVertices(theGraph);
+
+	if (Result == OK)
+	{
+		vertexPart = (int *) malloc((theGraph->N+1) * sizeof(int));
+		partSize = (int *) calloc(numParts, sizeof(int));
+		if (vertexPart == NULL || partSize == NULL)
+			Result = NOTOK;
+	}
+
+	if (Result == OK)
+	{
+		platform_GetTime(start);
+		Result = gp_PlanarPartition(theGraph, numParts, vertexPart, &numSeparator, 0);
+		platform_GetTime(end);
+	}
+
+	if (Result == OK)
+	{
+		for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
+		{
+			partSize[vertexPart[v]]++;
+			e = gp_GetFirstArc(theGraph, v);
+			while (gp_IsArc(e))
+			{
+				if (vertexPart[gp_GetNeighbor(theGraph, e)] != vertexPart[v])
+					edgeCut++;
+				e = gp_GetNextArc(theGraph, e);
+			}
+		}
+		edgeCut /= 2;
+
+		minPart = maxPart = partSize[0];
+		for (K = 1; K < numParts; K++)
+		{
+			if (minPart > partSize[K])
+				minPart = partSize[K];
+			if (maxPart < partSize[K])
+				maxPart = partSize[K];
+		}
+
+		sprintf(Line, "Partitioned %d vertices into %d parts in %.3lf seconds.\n",
+				theGraph->N, numParts, platform_GetDuration(start, end));
+		Message(Line);
+		sprintf(Line, "Separator vertices %d, part sizes %d to %d, edge cut %d of %d edges.\n",
+				numSeparator, minPart, maxPart, edgeCut, theGraph->M);
+		Message(Line);
+
+		if (outfileName != NULL)
+		{
+			if ((outfile = fopen(outfileName, "wt")) == NULL)
+				Result = NOTOK;
+			else
+			{
+				for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
+					fprintf(outfile, "%d: %d\n", v, vertexPart[v]);
+				fclose(outfile);
+			}
+		}
+	}
+
+	if (Result != OK && Result != NONEMBEDDABLE)
+		ErrorMessage("AN ERROR HAS BEEN DETECTED\n");
+
+	free(vertexPart);
+	free(partSize);
+	gp_Free(&theGraph);
+
+    FlushConsole(stdout);
+	return Result;
+}
+
+/****************************************************************************
+ WriteAlgorithmResults()
+ ****************************************************************************/
+
+void WriteAlgorithmResults(graphP theGraph, int Result, char command, platform_time start, platform_time end, char *infileName)
+{
+	if (infileName)
+		 sprintf(Line, "The graph '%s' ", infileName);
+	else sprintf(Line, "The graph ");
+	Message(Line);
+
+	switch (command)
+	{
+		case 'p' : sprintf(Line, "is%s planar.\n", Result==OK ? "" : " not"); break;
+		case 'd' : sprintf(Line, "is%s planar.\n", Result==OK ? "" : " not"); break;
+		case 'o' : sprintf(Line, "is%s outerplanar.\n", Result==OK ? "" : " not"); break;
+		case 'f' : sprintf(Line, "is%s outerplanar.\n", Result==OK ? "" : " not"); break;
+		case '2' : sprintf(Line, "has %s subgraph homeomorphic to K_{2,3}.\n", Result==OK ? "no" : "a"); break;
+		case '3' : sprintf(Line, "has %s subgraph homeomorphic to K_{3,3}.\n", Result==OK ? "no" : "a"); break;
+		case '4' : sprintf(Line, "has %s subgraph homeomorphic to K_4.\n", Result==OK ? "no" : "a"); break;
+		case '5' : sprintf(Line, "has %s subgraph homeomorphic to K_5.\n", Result==OK ? "no" : "a"); break;
+		case 'm' : if (Result==OK)
+					   sprintf(Line, "is planar.\n");
+				   else sprintf(Line, "is not planar, and %d edges are not in its maximal planar subgraph.\n",
+						   gp_MaxPlanarSubgraph_GetNumDeletedEdges(theGraph));
+				   break;
+		case 'j' : sprintf(Line, "is%s projective planar.\n", Result==OK ? "" : " not"); break;
+		case 't' : sprintf(Line, "is%s toroidal.\n", Result==OK ? "" : " not"); break;
+		case 'c' : sprintf(Line, "has been %d-colored.\n", gp_GetNumColorsUsed(theGraph)); break;
+		case 'e' : sprintf(Line, "has %d SPQR tree nodes in %d SPQR trees.\n",
+						   gp_SPQRTree_GetNumNodes(theGraph), gp_SPQRTree_GetNumTrees(theGraph)); break;
+		default  : sprintf(Line, "nas not been processed due to unrecognized command.\n"); break;
+	}
+	Message(Line);
+
+	sprintf(Line, "Algorithm '%s' executed in %.3lf seconds.\n",
+			GetAlgorithmName(command), platform_GetDuration(start,end));
+	Message(Line);
+}
@@ -0,0 +1,123 @@
+#ifndef PLATFORM_THREAD
+#define PLATFORM_THREAD
+
+/*
+Planarity-Related Graph Algorithms Project
+Copyright (c) 1997-2012, John M. Boyer
+All rights reserved. Includes a reference implementation of the following:
+
+* John M. Boyer. "Subgraph Homeomorphism via the Edge Addition Planarity Algorithm".
+  Journal of Graph Algorithms and Applications, Vol. 16, no. 2, pp. 381-410, 2012.
+  http://www.jgaa.info/16/268.html
+
+* John M. Boyer. "A New Method for Efficiently Generating Planar Graph
+  Visibility Representations". In P. Eades and P. Healy, editors,
+  Proceedings of the 13th International Conference on Graph Drawing 2005,
+  Lecture Notes Comput. Sci., Volume 3843, pp. 508-511, Springer-Verlag, 2006.
+
+* John M. Boyer and Wendy J. Myrvold. "On the Cutting Edge: Simplified O(n)
+  Planarity by Edge Addition". Journal of Graph Algorithms and Applications,
+  Vol. 8, No. 3, pp. 241-273, 2004.
+  http://www.jgaa.info/08/91.html
+
+* John M. Boyer. "Simplified O(n) Algorithms for Planar Graph Embedding,
+  Kuratowski Subgraph Isolation, and Related Problems". Ph.D. Dissertation,
+  University of Victoria, 2001.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+  list of conditions and the following disclaimer in the documentation and/or
+  other materials provided with the distribution.
+
+* Neither the name of the Planarity-Related Graph Algorithms Project nor the names
+  of its contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/* Minimal portability layer for the few places where threads are needed:
+   thread-local storage for the scratch buffers of the application drivers,
+   the ability to start and join worker threads, and atomic access to an
+   int shared by the threads, such as a flag telling them to stop or a
+   counter from which they take work.  Graphs are independent, so distinct
+   graphs can be processed by distinct threads without synchronization,
+   which is how the library's parallel searches divide their work. */
+
+#ifdef WIN32
+
+#include <windows.h>
+#include <winbase.h>
+
+#define platform_ThreadLocal __declspec(thread)
+
+#define platform_thread HANDLE
+#define platform_ThreadReturn DWORD WINAPI
+#define platform_ThreadReturnValue 0
+
+#define platform_StartThread(threadVar, threadFunction, threadArg) \
+		((threadVar = CreateThread(NULL, 0, threadFunction, threadArg, 0, NULL)) != NULL)
+#define platform_JoinThread(threadVar) \
+		(WaitForSingleObject(threadVar, INFINITE), CloseHandle(threadVar))
+
+#define platform_AtomicGet(var) \
+		((int) InterlockedCompareExchange((volatile LONG *) &(var), 0, 0))
+#define platform_AtomicSet(var, value) \
+		InterlockedExchange((volatile LONG *) &(var), (LONG) (value))
+#define platform_AtomicIncrement(var) \
+		((int) InterlockedIncrement((volatile LONG *) &(var)) - 1)
+#define platform_AtomicCompareAndSet(var, oldValue, newValue) \
+		(InterlockedCompareExchange((volatile LONG *) &(var), (LONG) (newValue), (LONG) (oldValue)) == (LONG) (oldValue))
+
+static __inline int platform_GetNumProcessors(void)
+{
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	return (int) info.dwNumberOfProcessors;
+}
+
+#else
+
+#include <pthread.h>
+#include <unistd.h>
+
+#define platform_ThreadLocal __thread
+
+#define platform_thread pthread_t
+#define platform_ThreadReturn void *
+#define platform_ThreadReturnValue NULL
+
+#define platform_StartThread(threadVar, threadFunction, threadArg) \
+		(pthread_create(&threadVar, NULL, threadFunction, threadArg) == 0)
+#define platform_JoinThread(threadVar) \
+		pthread_join(threadVar, NULL)
+
+#define platform_AtomicGet(var) \
+		__atomic_load_n(&(var), __ATOMIC_SEQ_CST)
+#define platform_AtomicSet(var, value) \
+		__atomic_store_n(&(var), value, __ATOMIC_SEQ_CST)
+#define platform_AtomicIncrement(var) \
+		__atomic_fetch_add(&(var), 1, __ATOMIC_SEQ_CST)
+#define platform_AtomicCompareAndSet(var, oldValue, newValue) \
+		__sync_bool_compare_and_swap(&(var), oldValue, newValue)
+
+#define platform_GetNumProcessors() \
+		((int) sysconf(_SC_NPROCESSORS_ONLN))
+
+#endif
+
+#endif
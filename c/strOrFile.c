@@ -0,0 +1,409 @@
+/*
+Planarity-Related Graph Algorithms Project
+Copyright (c) 1997-2012, John M. Boyer
+All rights reserved. Includes a reference implementation of the following:
+
+* John M. Boyer. "Subgraph Homeomorphism via the Edge Addition Planarity Algorithm".
+  Journal of Graph Algorithms and Applications, Vol. 16, no. 2, pp. 381-410, 2012.
+  http://www.jgaa.info/16/268.html
+
+* John M. Boyer. "A New Method for Efficiently Generating Planar Graph
+  Visibility Representations". In P. Eades and P. Healy, editors,
+  Proceedings of the 13th International Conference on Graph Drawing 2005,
+  Lecture Notes Comput. Sci., Volume 3843, pp. 508-511, Springer-Verlag, 2006.
+
+* John M. Boyer and Wendy J. Myrvold. "On the Cutting Edge: Simplified O(n)
+  Planarity by Edge Addition". Journal of Graph Algorithms and Applications,
+  Vol. 8, No. 3, pp. 241-273, 2004.
+  http://www.jgaa.info/08/91.html
+
+* John M. Boyer. "Simplified O(n) Algorithms for Planar Graph Embedding,
+  Kuratowski Subgraph Isolation, and Related Problems". Ph.D. Dissertation,
+  University of Victoria, 2001.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+  list of conditions and the following disclaimer in the documentation and/or
+  other materials provided with the distribution.
+
+* Neither the name of the Planarity-Related Graph Algorithms Project nor the names
+  of its contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include "appconst.h"
+#include "strOrFile.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <ctype.h>
+
+int  _sf_EnsureCapacity(strOrFileP theStrOrFile, long requiredCapacity);
+
+/********************************************************************
+ sf_NewFile(), sf_NewReadString(), sf_NewWriteString()
+ Make a stream on an open file, on a null-terminated string to be read
+ in place, or on a new string to be written, whose buffer initially
+ has the given capacity and grows as needed.
+ The file and a string to be read remain owned by the caller.
+ Return NULL on allocation failure.
+ ********************************************************************/
+
+strOrFileP sf_NewFile(FILE *pFile)
+{
+strOrFileP theStrOrFile;
+
+     if (pFile == NULL)
+         return NULL;
+
+     theStrOrFile = (strOrFileP) calloc(1, sizeof(strOrFile));
+     if (theStrOrFile != NULL)
+         theStrOrFile->pFile = pFile;
+
+     return theStrOrFile;
+}
+
+strOrFileP sf_NewReadString(char *theStr)
+{
+strOrFileP theStrOrFile;
+
+     if (theStr == NULL)
+         return NULL;
+
+     theStrOrFile = (strOrFileP) calloc(1, sizeof(strOrFile));
+     if (theStrOrFile != NULL)
+         theStrOrFile->theStr = theStr;
+
+     return theStrOrFile;
+}
+
+strOrFileP sf_NewWriteString(long initialCapacity)
+{
+strOrFileP theStrOrFile;
+
+     theStrOrFile = (strOrFileP) calloc(1, sizeof(strOrFile));
+     if (theStrOrFile != NULL &&
+         _sf_EnsureCapacity(theStrOrFile, initialCapacity > 0 ? initialCapacity : 64) != OK)
+         sf_Free(&theStrOrFile);
+
+     return theStrOrFile;
+}
+
+/********************************************************************
+ sf_Free()
+ Frees the stream, and the string it was writing unless the string
+ was taken with sf_TakeString().  A file is not closed.
+ ********************************************************************/
+
+void sf_Free(strOrFileP *pStrOrFile)
+{
+     if (pStrOrFile == NULL || *pStrOrFile == NULL)
+         return;
+
+     if ((*pStrOrFile)->capacity > 0 && (*pStrOrFile)->theStr != NULL)
+         free((*pStrOrFile)->theStr);
+
+     free(*pStrOrFile);
+     *pStrOrFile = NULL;
+}
+
+/********************************************************************
+ sf_TakeString()
+ Transfers ownership of the null-terminated string written by the
+ stream to the caller, who must free() it, and stores its length in
+ *pSize.  The stream is left empty.
+ Returns NULL if the stream does not write a string.
+ ********************************************************************/
+
+char *sf_TakeString(strOrFileP theStrOrFile, long *pSize)
+{
+char *theStr;
+
+     if (theStrOrFile == NULL || theStrOrFile->capacity == 0)
+         return NULL;
+
+     theStr = theStrOrFile->theStr;
+     if (pSize != NULL)
+         *pSize = theStrOrFile->size;
+
+     theStrOrFile->theStr = NULL;
+     theStrOrFile->size = theStrOrFile->capacity = 0;
+
+     return theStr;
+}
+
+/********************************************************************
+ _sf_EnsureCapacity()
+ Grows the buffer of a string being written, at least doubling it,
+ so that it can hold requiredCapacity characters.
+ Returns OK, or NOTOK on allocation failure.
+ ********************************************************************/
+
+int  _sf_EnsureCapacity(strOrFileP theStrOrFile, long requiredCapacity)
+{
+char *newStr;
+long newCapacity;
+
+     if (requiredCapacity <= theStrOrFile->capacity)
+         return OK;
+
+     newCapacity = 2 * theStrOrFile->capacity;
+     if (newCapacity < requiredCapacity)
+         newCapacity = requiredCapacity;
+
+     if ((newStr = (char *) realloc(theStrOrFile->theStr, newCapacity)) == NULL)
+         return NOTOK;
+
+     if (theStrOrFile->capacity == 0)
+         newStr[0] = '\0';
+
+     theStrOrFile->theStr = newStr;
+     theStrOrFile->capacity = newCapacity;
+     return OK;
+}
+
+/********************************************************************
+ sf_getc(), sf_ungetc()
+ As fgetc() and ungetc(), with the end of a string being EOF.  Only
+ the character most recently read can be pushed back onto a string.
+ ********************************************************************/
+
+int  sf_getc(strOrFileP theStrOrFile)
+{
+int  ch;
+
+     if (theStrOrFile->pFile != NULL)
+         return fgetc(theStrOrFile->pFile);
+
+     if ((ch = (unsigned char) theStrOrFile->theStr[theStrOrFile->pos]) == '\0')
+         return EOF;
+
+     theStrOrFile->pos++;
+     return ch;
+}
+
+int  sf_ungetc(int ch, strOrFileP theStrOrFile)
+{
+     if (theStrOrFile->pFile != NULL)
+         return ungetc(ch, theStrOrFile->pFile);
+
+     if (ch == EOF || theStrOrFile->pos == 0)
+         return EOF;
+
+     theStrOrFile->pos--;
+     return ch;
+}
+
+/********************************************************************
+ sf_ReadInt()
+ As fscanf() with " %d", skips white space, then reads an integer.
+ Returns OK, or NOTOK if no integer was read.
+ ********************************************************************/
+
+int  sf_ReadInt(strOrFileP theStrOrFile, int *pValue)
+{
+char *start, *end;
+
+     if (theStrOrFile->pFile != NULL)
+         return fscanf(theStrOrFile->pFile, " %d", pValue) == 1 ? OK : NOTOK;
+
+     start = theStrOrFile->theStr + theStrOrFile->pos;
+     *pValue = (int) strtol(start, &end, 10);
+     if (end == start)
+         return NOTOK;
+
+     theStrOrFile->pos += (long) (end - start);
+     return OK;
+}
+
+/********************************************************************
+ sf_ReadDigit()
+ As fscanf() with " %1d", skips white space, then reads one digit.
+ Returns OK, or NOTOK if no digit was read.
+ ********************************************************************/
+
+int  sf_ReadDigit(strOrFileP theStrOrFile, int *pValue)
+{
+int  ch;
+
+     if (theStrOrFile->pFile != NULL)
+         return fscanf(theStrOrFile->pFile, " %1d", pValue) == 1 ? OK : NOTOK;
+
+     sf_SkipWhitespace(theStrOrFile);
+     ch = (unsigned char) theStrOrFile->theStr[theStrOrFile->pos];
+     if (!isdigit(ch))
+         return NOTOK;
+
+     *pValue = ch - '0';
+     theStrOrFile->pos++;
+     return OK;
+}
+
+/********************************************************************
+ sf_SkipWhitespace()
+ As fscanf() with " ", skips white space.
+ ********************************************************************/
+
+void sf_SkipWhitespace(strOrFileP theStrOrFile)
+{
+     if (theStrOrFile->pFile != NULL)
+     {
+         if (fscanf(theStrOrFile->pFile, " ") < 0)
+             return;
+     }
+     else
+     {
+         while (isspace((unsigned char) theStrOrFile->theStr[theStrOrFile->pos]))
+             theStrOrFile->pos++;
+     }
+}
+
+/********************************************************************
+ sf_fgets()
+ As fgets(), reads a line, including its newline if there is room,
+ into line, which can hold maxLength characters including the null.
+ Returns line, or NULL at the end of the stream.
+ ********************************************************************/
+
+char *sf_fgets(char *line, int maxLength, strOrFileP theStrOrFile)
+{
+char *theStr;
+int  k = 0;
+
+     if (theStrOrFile->pFile != NULL)
+         return fgets(line, maxLength, theStrOrFile->pFile);
+
+     theStr = theStrOrFile->theStr + theStrOrFile->pos;
+     if (*theStr == '\0' || maxLength < 2)
+         return NULL;
+
+     while (k < maxLength-1 && theStr[k] != '\0')
+     {
+         line[k] = theStr[k];
+         if (theStr[k++] == '\n')
+             break;
+     }
+
+     line[k] = '\0';
+     theStrOrFile->pos += k;
+     return line;
+}
+
+/********************************************************************
+ sf_printf()
+ As fprintf(), appending to a string being written.
+ Returns OK, or NOTOK on a write error or allocation failure.
+ ********************************************************************/
+
+int  sf_printf(strOrFileP theStrOrFile, char *format, ...)
+{
+va_list args;
+int  length;
+
+     va_start(args, format);
+     if (theStrOrFile->pFile != NULL)
+         length = vfprintf(theStrOrFile->pFile, format, args);
+     else
+         length = vsnprintf(theStrOrFile->theStr + theStrOrFile->size,
+                            theStrOrFile->capacity - theStrOrFile->size, format, args);
+     va_end(args);
+
+     if (length < 0)
+         return NOTOK;
+
+     if (theStrOrFile->pFile != NULL)
+         return OK;
+
+     // If the string did not fit, then grow the buffer and format it again
+     if (theStrOrFile->size + length >= theStrOrFile->capacity)
+     {
+         if (_sf_EnsureCapacity(theStrOrFile, theStrOrFile->size + length + 1) != OK)
+             return NOTOK;
+
+         va_start(args, format);
+         length = vsnprintf(theStrOrFile->theStr + theStrOrFile->size,
+                            theStrOrFile->capacity - theStrOrFile->size, format, args);
+         va_end(args);
+
+         if (length < 0)
+             return NOTOK;
+     }
+
+     theStrOrFile->size += length;
+     return OK;
+}
+
+/********************************************************************
+ sf_WriteInt()
+ Writes the prefix character, the integer in decimal, then the suffix
+ character, omitting either character if it is '\0'.  This is how the
+ adjacency lists are written, so it avoids the cost of formatting each
+ neighbor with fprintf() or vsnprintf().
+ Returns OK, or NOTOK on a write error or allocation failure.
+ ********************************************************************/
+
+int  sf_WriteInt(strOrFileP theStrOrFile, char prefix, int value, char suffix)
+{
+char text[16], *theText = text + sizeof(text);
+unsigned int magnitude;
+long length;
+
+     // Format from the end of the text backward
+     if (suffix != '\0')
+         *--theText = suffix;
+
+     magnitude = value < 0 ? 0U - (unsigned int) value : (unsigned int) value;
+     do {
+         *--theText = (char) ('0' + magnitude % 10);
+         magnitude /= 10;
+     } while (magnitude > 0);
+
+     if (value < 0)
+         *--theText = '-';
+     if (prefix != '\0')
+         *--theText = prefix;
+
+     length = (long) (text + sizeof(text) - theText);
+     return sf_write(theStrOrFile, theText, length);
+}
+
+/********************************************************************
+ sf_write()
+ As fwrite() of size characters from data, appending to a string
+ being written.
+ Returns OK, or NOTOK on a write error or allocation failure.
+ ********************************************************************/
+
+int  sf_write(strOrFileP theStrOrFile, char *data, long size)
+{
+     if (size <= 0)
+         return OK;
+
+     if (theStrOrFile->pFile != NULL)
+         return fwrite(data, size, 1, theStrOrFile->pFile) == 1 ? OK : NOTOK;
+
+     if (_sf_EnsureCapacity(theStrOrFile, theStrOrFile->size + size + 1) != OK)
+         return NOTOK;
+
+     memcpy(theStrOrFile->theStr + theStrOrFile->size, data, size);
+     theStrOrFile->size += size;
+     theStrOrFile->theStr[theStrOrFile->size] = '\0';
+     return OK;
+}
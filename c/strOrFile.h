@@ -0,0 +1,106 @@
+/*
+Planarity-Related Graph Algorithms Project
+Copyright (c) 1997-2012, John M. Boyer
+All rights reserved. Includes a reference implementation of the following:
+
+* John M. Boyer. "Subgraph Homeomorphism via the Edge Addition Planarity Algorithm".
+  Journal of Graph Algorithms and Applications, Vol. 16, no. 2, pp. 381-410, 2012.
+  http://www.jgaa.info/16/268.html
+
+* John M. Boyer. "A New Method for Efficiently Generating Planar Graph
+  Visibility Representations". In P. Eades and P. Healy, editors,
+  Proceedings of the 13th International Conference on Graph Drawing 2005,
+  Lecture Notes Comput. Sci., Volume 3843, pp. 508-511, Springer-Verlag, 2006.
+
+* John M. Boyer and Wendy J. Myrvold. "On the Cutting Edge: Simplified O(n)
+  Planarity by Edge Addition". Journal of Graph Algorithms and Applications,
+  Vol. 8, No. 3, pp. 241-273, 2004.
+  http://www.jgaa.info/08/91.html
+
+* John M. Boyer. "Simplified O(n) Algorithms for Planar Graph Embedding,
+  Kuratowski Subgraph Isolation, and Related Problems". Ph.D. Dissertation,
+  University of Victoria, 2001.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+  list of conditions and the following disclaimer in the documentation and/or
+  other materials provided with the distribution.
+
+* Neither the name of the Planarity-Related Graph Algorithms Project nor the names
+  of its contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#ifndef STRORFILE_H
+#define STRORFILE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdio.h>
+
+/********************************************************************
+ strOrFile
+
+ A character stream that is either a FILE or a string in memory, so
+ that the graph readers and writers, and the read and write
+ postprocessing of extensions, work the same way on both.
+
+ pFile: the file, or NULL for a string
+ theStr: for reading, the caller's null-terminated string, which is
+         read in place; for writing, a buffer owned by the stream that
+         is kept null-terminated
+ pos: for reading, the position of the next character in theStr
+ size, capacity: for writing, the length of the string written and
+         the size of the buffer holding it
+ ********************************************************************/
+
+typedef struct
+{
+        FILE *pFile;
+        char *theStr;
+        long pos, size, capacity;
+} strOrFile;
+
+typedef strOrFile * strOrFileP;
+
+strOrFileP sf_NewFile(FILE *pFile);
+strOrFileP sf_NewReadString(char *theStr);
+strOrFileP sf_NewWriteString(long initialCapacity);
+void       sf_Free(strOrFileP *pStrOrFile);
+char      *sf_TakeString(strOrFileP theStrOrFile, long *pSize);
+
+int   sf_getc(strOrFileP theStrOrFile);
+int   sf_ungetc(int ch, strOrFileP theStrOrFile);
+int   sf_ReadInt(strOrFileP theStrOrFile, int *pValue);
+int   sf_ReadDigit(strOrFileP theStrOrFile, int *pValue);
+void  sf_SkipWhitespace(strOrFileP theStrOrFile);
+char *sf_fgets(char *line, int maxLength, strOrFileP theStrOrFile);
+
+int   sf_printf(strOrFileP theStrOrFile, char *format, ...);
+int   sf_WriteInt(strOrFileP theStrOrFile, char prefix, int value, char suffix);
+int   sf_write(strOrFileP theStrOrFile, char *data, long size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif